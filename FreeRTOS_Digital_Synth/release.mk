@@ -0,0 +1,153 @@
+################################################################################
+# Release build, the one that ships: make -f release.mk
+#
+# The engine (src/*.c, src/*.S) is built for speed with link-time optimization, so the
+# render loop can inline across modules; the FreeRTOS kernel for speed without it, its
+# port has naked functions; the rest of ASF, board and peripheral setup run once at
+# start-up, for size. Every function and object gets its own section and the link keeps
+# only what is reached. Atmel Studio's Release configuration has one optimization level
+# for every file, hence this makefile; Debug/Makefile is the one Studio generates.
+#
+# After the link the soft-float guard runs on the .lss and .map (tools/check_float.py),
+# then tools/size_report.py prints flash and RAM and their change from the Debug build.
+#
+#   make -f release.mk              Release/FreeRTOS_Digital_Synth.elf, .hex, .bin
+#   make -f release.mk BENCH=1      the same with SYNTH_BENCHMARK, Release/..._bench.elf;
+#                                   flash it and the figures print on the EDBG console
+#   make -f release.mk clean
+#
+# The arm-none-eabi toolchain and python3 must be on the PATH; CROSS sets another prefix.
+################################################################################
+
+CROSS ?= arm-none-eabi-
+CC := $(CROSS)gcc
+OBJCOPY := $(CROSS)objcopy
+OBJDUMP := $(CROSS)objdump
+SIZE := $(CROSS)size
+PYTHON ?= python3
+
+BENCH ?= 0
+OUT := Release
+NAME := FreeRTOS_Digital_Synth$(if $(filter 1,$(BENCH)),_bench)
+ELF := $(OUT)/$(NAME).elf
+OBJ := $(OUT)/$(NAME)
+REFERENCE := Debug/FreeRTOS_Digital_Synth.elf
+
+LINKER_SCRIPT := src/ASF/sam0/utils/linker_scripts/samd21/gcc/samd21j18a_flash.ld
+
+ENGINE_SRCS := $(wildcard src/*.c)
+ENGINE_ASM := $(wildcard src/*.S)
+
+KERNEL_SRCS := \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/croutine.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/list.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/queue.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/stream_buffer.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/tasks.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/timers.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/portable/GCC/ARM_CM0/port.c \
+	src/ASF/thirdparty/freertos/freertos-7.4.2/Source/portable/MemMang/heap_1.c
+
+ASF_SRCS := \
+	src/ASF/common/utils/interrupt/interrupt_sam_nvic.c \
+	src/ASF/sam0/boards/samd21_xplained_pro/board_init.c \
+	src/ASF/sam0/drivers/port/port.c \
+	src/ASF/sam0/drivers/sercom/sercom.c \
+	src/ASF/sam0/drivers/sercom/sercom_interrupt.c \
+	src/ASF/sam0/drivers/sercom/spi/spi.c \
+	src/ASF/sam0/drivers/sercom/usart/usart.c \
+	src/ASF/sam0/drivers/sercom/usart/usart_interrupt.c \
+	src/ASF/sam0/drivers/system/clock/clock_samd21_r21_da/clock.c \
+	src/ASF/sam0/drivers/system/clock/clock_samd21_r21_da/gclk.c \
+	src/ASF/sam0/drivers/system/interrupt/system_interrupt.c \
+	src/ASF/sam0/drivers/system/pinmux/pinmux.c \
+	src/ASF/sam0/drivers/system/system.c \
+	src/ASF/sam0/utils/cmsis/samd21/source/gcc/startup_samd21.c \
+	src/ASF/sam0/utils/cmsis/samd21/source/system_samd21.c \
+	src/ASF/sam0/utils/stdio/read.c \
+	src/ASF/sam0/utils/stdio/write.c \
+	src/ASF/sam0/utils/syscalls/gcc/syscalls.c
+
+DEFS := -DNDEBUG -DBOARD=SAMD21_XPLAINED_PRO -D__SAMD21J18A__ -DARM_MATH_CM0PLUS=true \
+	-DUSART_CALLBACK_MODE=true -D__FREERTOS__ -DSPI_CALLBACK_MODE=false \
+	$(if $(filter 1,$(BENCH)),-DSYNTH_BENCHMARK=1)
+
+INCLUDES := -Isrc -Isrc/config \
+	-Isrc/ASF/common/boards \
+	-Isrc/ASF/common/services/ioport \
+	-Isrc/ASF/common/services/serial \
+	-Isrc/ASF/common/utils \
+	-Isrc/ASF/sam0/boards \
+	-Isrc/ASF/sam0/boards/samd21_xplained_pro \
+	-Isrc/ASF/sam0/drivers/port \
+	-Isrc/ASF/sam0/drivers/sercom \
+	-Isrc/ASF/sam0/drivers/sercom/spi \
+	-Isrc/ASF/sam0/drivers/sercom/usart \
+	-Isrc/ASF/sam0/drivers/system \
+	-Isrc/ASF/sam0/drivers/system/clock \
+	-Isrc/ASF/sam0/drivers/system/clock/clock_samd21_r21_da \
+	-Isrc/ASF/sam0/drivers/system/interrupt \
+	-Isrc/ASF/sam0/drivers/system/interrupt/system_interrupt_samd21 \
+	-Isrc/ASF/sam0/drivers/system/pinmux \
+	-Isrc/ASF/sam0/drivers/system/power \
+	-Isrc/ASF/sam0/drivers/system/power/power_sam_d_r \
+	-Isrc/ASF/sam0/drivers/system/reset \
+	-Isrc/ASF/sam0/drivers/system/reset/reset_sam_d_r \
+	-Isrc/ASF/sam0/utils \
+	-Isrc/ASF/sam0/utils/cmsis/samd21/include \
+	-Isrc/ASF/sam0/utils/cmsis/samd21/source \
+	-Isrc/ASF/sam0/utils/header_files \
+	-Isrc/ASF/sam0/utils/preprocessor \
+	-Isrc/ASF/sam0/utils/stdio/stdio_serial \
+	-Isrc/ASF/thirdparty/CMSIS/Include \
+	-Isrc/ASF/thirdparty/freertos/freertos-7.4.2/Source/include \
+	-Isrc/ASF/thirdparty/freertos/freertos-7.4.2/Source/portable/GCC/ARM_CM0
+
+ARCH := -mthumb -mcpu=cortex-m0plus
+CFLAGS := $(ARCH) $(DEFS) $(INCLUDES) -std=gnu99 -g3 -ffunction-sections -fdata-sections -mlong-calls \
+	-pipe -fno-strict-aliasing -Wall -Wstrict-prototypes -Wmissing-prototypes -Werror-implicit-function-declaration \
+	-Wpointer-arith -Wformat=2 -Wundef -Wshadow -Wbad-function-cast -Wwrite-strings -Wsign-compare \
+	-Wmissing-declarations -Wredundant-decls -Wnested-externs -Wunreachable-code -Wcast-align \
+	--param max-inline-insns-single=500 -MD -MP
+ENGINE_CFLAGS := -O2 -flto
+KERNEL_CFLAGS := -O2
+ASF_CFLAGS := -Os
+
+LDFLAGS := $(ARCH) -O2 -flto -g3 --specs=nano.specs -Wl,--gc-sections -Wl,--entry=Reset_Handler -Wl,--cref \
+	-Wl,-Map=$(OUT)/$(NAME).map -T$(LINKER_SCRIPT) -Lsrc/ASF/thirdparty/CMSIS/Lib/GCC
+LIBS := -Wl,--start-group -larm_cortexM0l_math -lm -Wl,--end-group
+
+ENGINE_OBJS := $(patsubst src/%.c,$(OBJ)/%.o,$(ENGINE_SRCS)) $(patsubst src/%.S,$(OBJ)/%.o,$(ENGINE_ASM))
+KERNEL_OBJS := $(patsubst src/%.c,$(OBJ)/%.o,$(KERNEL_SRCS))
+ASF_OBJS := $(patsubst src/%.c,$(OBJ)/%.o,$(ASF_SRCS))
+OBJS := $(ENGINE_OBJS) $(KERNEL_OBJS) $(ASF_OBJS)
+
+.PHONY: all clean
+
+all: $(ELF)
+	$(OBJCOPY) -O ihex -R .eeprom -R .fuse -R .lock -R .signature $(ELF) $(OUT)/$(NAME).hex
+	$(OBJCOPY) -O binary $(ELF) $(OUT)/$(NAME).bin
+	$(OBJDUMP) -h -S $(ELF) > $(OUT)/$(NAME).lss
+	$(PYTHON) tools/check_float.py $(OUT)/$(NAME).lss
+	$(PYTHON) tools/size_report.py --size $(SIZE) $(ELF) $(REFERENCE)
+
+$(ELF): $(OBJS) $(LINKER_SCRIPT)
+	$(CC) $(LDFLAGS) -o $@ $(OBJS) $(LIBS)
+
+$(ENGINE_OBJS): CFLAGS += $(ENGINE_CFLAGS)
+$(KERNEL_OBJS): CFLAGS += $(KERNEL_CFLAGS)
+$(ASF_OBJS): CFLAGS += $(ASF_CFLAGS)
+
+# the benchmark build keeps its objects apart, under its own name
+$(OBJ)/%.o: src/%.c release.mk
+	@mkdir -p $(dir $@)
+	$(CC) $(CFLAGS) -c -o $@ $<
+
+$(OBJ)/%.o: src/%.S release.mk
+	@mkdir -p $(dir $@)
+	$(CC) $(CFLAGS) -x assembler-with-cpp -c -o $@ $<
+
+clean:
+	rm -rf $(OUT)
+
+-include $(OBJS:.o=.d)
@@ -474,6 +474,22 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )
 #endif
 
+#ifndef traceTASK_NOTIFY_GIVE
+	#define traceTASK_NOTIFY_GIVE( pxTCB )
+#endif
+
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR( pxTCB )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+	#define traceTASK_NOTIFY_TAKE()
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK()
+#endif
+
 #ifndef traceTASK_INCREMENT_TICK
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
@@ -568,6 +584,10 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 0
+#endif
+
 /* For backward compatability. */
 #define eTaskStateGet eTaskGetState
 
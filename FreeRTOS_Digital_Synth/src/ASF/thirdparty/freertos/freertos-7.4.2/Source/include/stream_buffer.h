@@ -0,0 +1,204 @@
+/*
+    Stream buffers for FreeRTOS V7.4.2.
+
+    An addition to the kernel in this tree, not part of the FreeRTOS V7.4.2
+    distribution.  The API follows the stream buffers of later FreeRTOS
+    versions, in the naming of this version.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include stream_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A stream buffer passes a stream of bytes from one writer, a task or an
+ * interrupt, to one reader, a task or an interrupt.  Data is copied in and
+ * out with memcpy(), any number of bytes per call, instead of one queue item
+ * at a time.  A reader blocked on an empty buffer is unblocked once the
+ * trigger level is reached, a writer blocked on a full buffer once any space
+ * is freed.
+ *
+ * There is no locking between writers or between readers: with more than one
+ * of either, the calls on that side must be serialised by the application.
+ *
+ * Blocking uses the blocked task's notification (see ulTaskNotifyTake() in
+ * task.h), so configUSE_TASK_NOTIFICATIONS must be 1, and a task that blocks
+ * on a stream buffer must not also use its notification for something else.
+ *
+ * Buffers are created statically, the storage and the control structure are
+ * given by the application.
+ */
+typedef void * xStreamBufferHandle;
+
+/*
+ * The control structure, only declared here so it can be allocated
+ * statically.  Its members must only be accessed through the API below.
+ */
+typedef struct xSTREAM_BUFFER
+{
+	volatile size_t xTail;					/*< Index of the next byte to read.  Only the reader writes it. */
+	volatile size_t xHead;					/*< Index of the next byte to write.  Only the writer writes it. */
+	size_t xLength;							/*< Size of the storage area, one byte more than the buffer holds. */
+	size_t xTriggerLevelBytes;				/*< Bytes that must be in the buffer before a blocked reader is unblocked. */
+	volatile xTaskHandle xTaskWaitingToReceive;	/*< The reader, while it is blocked. */
+	volatile xTaskHandle xTaskWaitingToSend;	/*< The writer, while it is blocked. */
+	unsigned char *pucBuffer;				/*< The storage area. */
+} xStaticStreamBuffer;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes,
+												size_t xTriggerLevelBytes,
+												unsigned char *pucStreamBufferStorageArea,
+												xStaticStreamBuffer *pxStaticStreamBuffer );</pre>
+ *
+ * Creates a stream buffer in memory given by the caller.
+ *
+ * @param xBufferSizeBytes The number of bytes the buffer holds.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the buffer
+ * before a reader blocked on it is unblocked.  0 is taken as 1, a value above
+ * xBufferSizeBytes as xBufferSizeBytes.
+ *
+ * @param pucStreamBufferStorageArea At least xBufferSizeBytes + 1 bytes.
+ *
+ * @param pxStaticStreamBuffer Holds the buffer's control structure.
+ *
+ * @return The handle of the buffer.
+ *
+ * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
+ * \ingroup StreamBufferManagement
+ */
+xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, unsigned char *pucStreamBufferStorageArea, xStaticStreamBuffer *pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer,
+						   const void *pvTxData,
+						   size_t xDataLengthBytes,
+						   portTickType xTicksToWait );</pre>
+ *
+ * Copies bytes into a stream buffer, from a task.  Waits at most
+ * xTicksToWait for there to be room for all of them, then writes as many as
+ * fit.
+ *
+ * @return The number of bytes written.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer,
+								  const void *pvTxData,
+								  size_t xDataLengthBytes,
+								  signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xStreamBufferSend() that can be called from an interrupt
+ * service routine.  Never blocks, writes as many bytes as fit.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the write unblocked a
+ * reader of a higher priority than the task interrupted.
+ *
+ * @return The number of bytes written.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer,
+							  void *pvRxData,
+							  size_t xBufferLengthBytes,
+							  portTickType xTicksToWait );</pre>
+ *
+ * Copies bytes out of a stream buffer, from a task.  If the buffer is empty
+ * waits at most xTicksToWait for the trigger level to be reached, then reads
+ * as many bytes as there are, up to xBufferLengthBytes.
+ *
+ * @return The number of bytes read, 0 if the wait timed out.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer,
+									 void *pvRxData,
+									 size_t xBufferLengthBytes,
+									 signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xStreamBufferReceive() that can be called from an interrupt
+ * service routine.  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the read unblocked a
+ * writer of a higher priority than the task interrupted.
+ *
+ * @return The number of bytes read.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer );</pre>
+ *
+ * @return The number of bytes that can be read.
+ *
+ * \defgroup xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer );</pre>
+ *
+ * @return The number of bytes that can be written.
+ *
+ * \defgroup xStreamBufferSpacesAvailable xStreamBufferSpacesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer. h
+ * <pre>portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer );</pre>
+ *
+ * Empties a stream buffer.
+ *
+ * @return pdFAIL, leaving the buffer as it was, if a task is blocked on it,
+ * otherwise pdPASS.
+ *
+ * \defgroup xStreamBufferReset xStreamBufferReset
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
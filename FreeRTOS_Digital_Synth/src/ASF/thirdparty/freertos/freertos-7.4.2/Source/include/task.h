@@ -807,6 +807,69 @@ void vTaskResume( xTaskHandle xTaskToResume ) PRIVILEGED_FUNCTION;
  */
 portBASE_TYPE xTaskResumeFromISR( xTaskHandle xTaskToResume ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</pre>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * Every task has a notification count in its TCB.  xTaskNotifyGive()
+ * increments the count of xTaskToNotify and, if that task is blocked in
+ * ulTaskNotifyTake(), unblocks it.  Used this way the count is a light weight
+ * binary or counting semaphore private to one task, without a queue object
+ * and without the queue's copy and event list handling.  Backported from
+ * later FreeRTOS versions, with the same names and semantics.
+ *
+ * @param xTaskToNotify Handle of the task being notified.
+ *
+ * @return Always pdPASS.
+ *
+ * \defgroup xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xTaskNotifyGive() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xTaskToNotify Handle of the task being notified.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the notification
+ * unblocked a task of a higher priority than the one interrupted, in which
+ * case a context switch should be requested before the interrupt exits.
+ *
+ * \defgroup vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</pre>
+ *
+ * Waits, for at most xTicksToWait, for the calling task's notification
+ * count to be non-zero.  Must not be called with the scheduler suspended.
+ *
+ * @param xClearCountOnExit pdTRUE zeroes the count on exit, so it behaves as
+ * a binary semaphore; pdFALSE decrements it, so it behaves as a counting
+ * semaphore.
+ *
+ * @param xTicksToWait Maximum time to block while the count is zero,
+ * portMAX_DELAY to block indefinitely when INCLUDE_vTaskSuspend is 1.
+ *
+ * @return The count before it was cleared or decremented, zero if the wait
+ * timed out.
+ *
+ * \defgroup ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER CONTROL
  *----------------------------------------------------------*/
@@ -255,15 +255,37 @@ void vPortExitCritical( void )
 
 void xPortPendSVHandler( void )
 {
-	/* This is a naked function. */
+	/* This is a naked function.
+
+	vTaskSwitchContext() is called before anything is saved: R4-R11 are callee
+	saved, so they still hold the interrupted task's values when it returns.
+	If the same task was selected again, which is what most tick interrupts and
+	yields with nothing else ready come down to, the handler returns without
+	touching the task stack.  Otherwise R4-R11 are stored below the frame the
+	hardware stacked and the new task's are loaded as before.
+
+	The stack overflow checks in vTaskSwitchContext() therefore see the
+	outgoing stack before R4-R11 are pushed onto it.  An overflow by those 32
+	bytes is still caught, one switch later: method 2 finds its fill pattern
+	overwritten, method 1 the top of stack saved here. */
 
 	__asm volatile
 	(
-	"	mrs r0, psp							\n"
-	"										\n"
 	"	ldr	r3, pxCurrentTCBConst			\n" /* Get the location of the current TCB. */
-	"	ldr	r2, [r3]						\n"
+	"	ldr	r2, [r3]						\n" /* r2 holds the TCB switched out. */
+	"										\n"
+	"	push {r2, r14}						\n"
+	"	cpsid i								\n"
+	"	bl vTaskSwitchContext				\n"
+	"	cpsie i								\n"
+	"	pop {r2, r3}						\n" /* lr goes in r3. */
+	"										\n"
+	"	ldr	r1, pxCurrentTCBConst			\n"
+	"	ldr	r1, [r1]						\n" /* r1 holds the TCB switched in. */
+	"	cmp r1, r2							\n"
+	"	beq 1f								\n" /* Same task, nothing to save or restore. */
 	"										\n"
+	"	mrs r0, psp							\n"
 	"	sub r0, r0, #32						\n" /* Make space for the remaining low registers. */
 	"	str r0, [r2]						\n" /* Save the new top of stack. */
 	"	stmia r0!, {r4-r7}					\n" /* Store the low registers that are not saved automatically. */
@@ -273,13 +295,6 @@ void xPortPendSVHandler( void )
 	" 	mov r7, r11							\n"
 	" 	stmia r0!, {r4-r7}              	\n"
 	"										\n"
-	"	push {r3, r14}						\n"
-	"	cpsid i								\n"
-	"	bl vTaskSwitchContext				\n"
-	"	cpsie i								\n"
-	"	pop {r2, r3}						\n" /* lr goes in r3. r2 now holds tcb pointer. */
-	"										\n"
-	"	ldr r1, [r2]						\n"
 	"	ldr r0, [r1]						\n" /* The first item in pxCurrentTCB is the task top of stack. */
 	"	add r0, r0, #16						\n" /* Move to the high registers. */
 	"	ldmia r0!, {r4-r7}					\n" /* Pop the high registers. */
@@ -293,7 +308,7 @@ void xPortPendSVHandler( void )
 	"	sub r0, r0, #32						\n" /* Go back for the low registers that are not automatically restored. */
 	" 	ldmia r0!, {r4-r7}              	\n" /* Pop low registers.  */
 	"										\n"
-	"	bx r3								\n"
+	"1:	bx r3								\n"
 	"										\n"
 	"	.align 2							\n"
 	"pxCurrentTCBConst: .word pxCurrentTCB	  "
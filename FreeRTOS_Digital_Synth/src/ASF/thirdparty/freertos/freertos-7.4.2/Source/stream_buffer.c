@@ -0,0 +1,420 @@
+/*
+    Stream buffers for FreeRTOS V7.4.2.
+
+    An addition to the kernel in this tree, not part of the FreeRTOS V7.4.2
+    distribution.  See include/stream_buffer.h for the API.
+
+    1 tab == 4 spaces!
+*/
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "include/FreeRTOS.h"
+#include "include/task.h"
+#include "include/stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use stream buffers.
+#endif
+
+/*
+ * The storage is a ring of xLength bytes with one always left free, so the
+ * buffer is empty when the head and the tail are equal.  The writer copies its
+ * bytes in before it moves the head and the reader copies them out before it
+ * moves the tail, so the only state the two sides share is the pair of
+ * indexes and the waiting task handles, and those are only changed with
+ * interrupts masked.
+ */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Bytes in the buffer, that can be read.
+ */
+static size_t prvBytesInBuffer( const xStaticStreamBuffer * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies up to xCount bytes in at the head, as many as fit, without moving
+ * the head.  Returns the number of bytes copied.
+ */
+static size_t prvWriteBytes( xStaticStreamBuffer * const pxStreamBuffer, const unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies up to xCount bytes out from the tail, as many as there are, without
+ * moving the tail.  Returns the number of bytes copied.
+ */
+static size_t prvReadBytes( const xStaticStreamBuffer * const pxStreamBuffer, unsigned char *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves an index on by xCount bytes, wrapping at the end of the storage.
+ */
+static size_t prvAdvance( const xStaticStreamBuffer * const pxStreamBuffer, size_t xIndex, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, unsigned char *pucStreamBufferStorageArea, xStaticStreamBuffer *pxStaticStreamBuffer )
+{
+	configASSERT( pucStreamBufferStorageArea );
+	configASSERT( pxStaticStreamBuffer );
+	configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+	else if( xTriggerLevelBytes > xBufferSizeBytes )
+	{
+		xTriggerLevelBytes = xBufferSizeBytes;
+	}
+
+	pxStaticStreamBuffer->xTail = ( size_t ) 0;
+	pxStaticStreamBuffer->xHead = ( size_t ) 0;
+	pxStaticStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+	pxStaticStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	pxStaticStreamBuffer->xTaskWaitingToReceive = NULL;
+	pxStaticStreamBuffer->xTaskWaitingToSend = NULL;
+	pxStaticStreamBuffer->pucBuffer = pucStreamBufferStorageArea;
+
+	return ( xStreamBufferHandle ) pxStaticStreamBuffer;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xStaticStreamBuffer * const pxStreamBuffer = ( xStaticStreamBuffer * ) xStreamBuffer;
+xTimeOutType xTimeOut;
+size_t xSpace, xWanted, xWritten;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	/* Never wait for more room than the buffer has. */
+	xWanted = xDataLengthBytes;
+	if( xWanted > pxStreamBuffer->xLength - ( size_t ) 1 )
+	{
+		xWanted = pxStreamBuffer->xLength - ( size_t ) 1;
+	}
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			/* The reader cannot free space between the check and the
+			registration, so its notification cannot be missed. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( xStreamBuffer );
+
+				if( xSpace < xWanted )
+				{
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xSpace >= xWanted )
+			{
+				break;
+			}
+
+			( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				break;
+			}
+		}
+	}
+
+	xWritten = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes );
+
+	if( xWritten != ( size_t ) 0 )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxStreamBuffer->xHead = prvAdvance( pxStreamBuffer, pxStreamBuffer->xHead, xWritten );
+
+			if( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) && ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) )
+			{
+				( void ) xTaskNotifyGive( pxStreamBuffer->xTaskWaitingToReceive );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xStaticStreamBuffer * const pxStreamBuffer = ( xStaticStreamBuffer * ) xStreamBuffer;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+xTaskHandle xReader = NULL;
+size_t xWritten;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	xWritten = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes );
+
+	if( xWritten != ( size_t ) 0 )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxStreamBuffer->xHead = prvAdvance( pxStreamBuffer, pxStreamBuffer->xHead, xWritten );
+
+			if( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) && ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) )
+			{
+				xReader = pxStreamBuffer->xTaskWaitingToReceive;
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		/* The port's interrupt mask does not nest, so the notification, which
+		masks interrupts itself, is given after the mask is cleared. */
+		if( xReader != NULL )
+		{
+			vTaskNotifyGiveFromISR( xReader, pxHigherPriorityTaskWoken );
+		}
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xStaticStreamBuffer * const pxStreamBuffer = ( xStaticStreamBuffer * ) xStreamBuffer;
+xTimeOutType xTimeOut;
+size_t xAvailable, xRead;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			/* Only an empty buffer is waited on, the writer then wakes the
+			reader once the trigger level is reached. */
+			taskENTER_CRITICAL();
+			{
+				xAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xAvailable == ( size_t ) 0 )
+				{
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xAvailable != ( size_t ) 0 )
+			{
+				break;
+			}
+
+			( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				break;
+			}
+		}
+	}
+
+	xRead = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+
+	if( xRead != ( size_t ) 0 )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxStreamBuffer->xTail = prvAdvance( pxStreamBuffer, pxStreamBuffer->xTail, xRead );
+
+			if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+			{
+				( void ) xTaskNotifyGive( pxStreamBuffer->xTaskWaitingToSend );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	return xRead;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xStaticStreamBuffer * const pxStreamBuffer = ( xStaticStreamBuffer * ) xStreamBuffer;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+xTaskHandle xWriter = NULL;
+size_t xRead;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	xRead = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+
+	if( xRead != ( size_t ) 0 )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxStreamBuffer->xTail = prvAdvance( pxStreamBuffer, pxStreamBuffer->xTail, xRead );
+			xWriter = pxStreamBuffer->xTaskWaitingToSend;
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xWriter != NULL )
+		{
+			vTaskNotifyGiveFromISR( xWriter, pxHigherPriorityTaskWoken );
+		}
+	}
+
+	return xRead;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+
+	return prvBytesInBuffer( ( xStaticStreamBuffer * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+xStaticStreamBuffer * const pxStreamBuffer = ( xStaticStreamBuffer * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	return ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xStaticStreamBuffer * const pxStreamBuffer = ( xStaticStreamBuffer * ) xStreamBuffer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxStreamBuffer );
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+		{
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const xStaticStreamBuffer * const pxStreamBuffer )
+{
+size_t xCount;
+
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead - pxStreamBuffer->xTail;
+
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes( xStaticStreamBuffer * const pxStreamBuffer, const unsigned char *pucData, size_t xCount )
+{
+size_t xHead, xFirst, xSpace;
+
+	xSpace = xStreamBufferSpacesAvailable( ( xStreamBufferHandle ) pxStreamBuffer );
+
+	if( xCount > xSpace )
+	{
+		xCount = xSpace;
+	}
+
+	/* Up to the end of the storage, then the rest from the start. */
+	xHead = pxStreamBuffer->xHead;
+	xFirst = pxStreamBuffer->xLength - xHead;
+
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	memcpy( &( pxStreamBuffer->pucBuffer[ xHead ] ), pucData, xFirst );
+
+	if( xCount > xFirst )
+	{
+		memcpy( pxStreamBuffer->pucBuffer, &( pucData[ xFirst ] ), xCount - xFirst );
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes( const xStaticStreamBuffer * const pxStreamBuffer, unsigned char *pucData, size_t xCount )
+{
+size_t xTail, xFirst, xAvailable;
+
+	xAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( xCount > xAvailable )
+	{
+		xCount = xAvailable;
+	}
+
+	xTail = pxStreamBuffer->xTail;
+	xFirst = pxStreamBuffer->xLength - xTail;
+
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	memcpy( pucData, &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirst );
+
+	if( xCount > xFirst )
+	{
+		memcpy( &( pucData[ xFirst ] ), pxStreamBuffer->pucBuffer, xCount - xFirst );
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAdvance( const xStaticStreamBuffer * const pxStreamBuffer, size_t xIndex, size_t xCount )
+{
+	xIndex += xCount;
+
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
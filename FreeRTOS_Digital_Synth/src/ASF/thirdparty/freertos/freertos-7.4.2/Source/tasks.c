@@ -146,8 +146,17 @@ typedef struct tskTaskControlBlock
 		unsigned long ulRunTimeCounter;			/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The notification count given by xTaskNotifyGive() and taken by ulTaskNotifyTake(). */
+		volatile unsigned char ucNotifyState;	/*< Whether the task is blocked in ulTaskNotifyTake(). */
+	#endif
+
 } tskTCB;
 
+/* Values for ucNotifyState. */
+#define taskNOT_WAITING_NOTIFICATION	( ( unsigned char ) 0 )
+#define taskWAITING_NOTIFICATION		( ( unsigned char ) 1 )
+
 
 /*
  * Some kernel aware debuggers require the data the debugger needs access to to
@@ -1984,6 +1993,174 @@ portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	portTickType xTimeToWake;
+	unsigned long ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					traceTASK_NOTIFY_TAKE_BLOCK();
+
+					/* The task is not placed on an event list, the notifying
+					code finds it through its handle.  Remove it from the ready
+					list before adding it to the blocked list as the same list
+					item is used for both lists. */
+					if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+					{
+						portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+					}
+
+					#if ( INCLUDE_vTaskSuspend == 1 )
+					{
+						if( xTicksToWait == portMAX_DELAY )
+						{
+							/* Block indefinitely, not woken by a timing event. */
+							vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+						}
+						else
+						{
+							xTimeToWake = xTickCount + xTicksToWait;
+							prvAddCurrentTaskToDelayedList( xTimeToWake );
+						}
+					}
+					#else /* INCLUDE_vTaskSuspend */
+					{
+						xTimeToWake = xTickCount + xTicksToWait;
+						prvAddCurrentTaskToDelayedList( xTimeToWake );
+					}
+					#endif /* INCLUDE_vTaskSuspend */
+
+					/* The yield is pended until the critical section is left. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_TAKE();
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue = ulReturn - 1UL;
+				}
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify )
+	{
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		taskENTER_CRITICAL();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			( pxTCB->ulNotifiedValue )++;
+
+			traceTASK_NOTIFY_GIVE( pxTCB );
+
+			/* If the task was blocked waiting for a notification it is not
+			on an event list, only on the delayed or suspended list. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				uxListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyQueue( pxTCB );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			( pxTCB->ulNotifiedValue )++;
+
+			traceTASK_NOTIFY_GIVE_FROM_ISR( pxTCB );
+
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					uxListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyQueue( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					the task until the scheduler is resumed. */
+					vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -2258,6 +2435,13 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 	listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxPriority );
 	listSET_LIST_ITEM_OWNER( &( pxTCB->xEventListItem ), pxTCB );
 
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+	}
+	#endif /* configUSE_TASK_NOTIFICATIONS */
+
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 	{
 		pxTCB->uxCriticalNesting = ( unsigned portBASE_TYPE ) 0U;
@@ -0,0 +1,175 @@
+/*************************************************************************************************
+                                        --ARPEGGIATOR--
+
+	A pattern position p over count notes and octaves is note p % count of the sorted or
+	played list, p / count octaves up; up-down turns at both ends without repeating them.
+	The lists are short, an insert or removal shifts at most SYNTH_ARP_NOTES bytes.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "arpeggiator.h"
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void arp_remove( uint8_t *list, int count, uint8_t note );
+static int16_t arp_next( struct arp *arp, uint8_t *velocity );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void arp_init( struct arp *arp )
+{
+	arp->count = 0;
+	arp->sounding = ARP_NONE;
+	arp->random = 0x9E3779B9;
+	arp_set(arp, ARP_OFF, 6, 1);
+	arp_restart(arp);
+}
+
+void arp_set( struct arp *arp, enum arp_mode mode, uint8_t division, uint8_t octaves )
+{
+	//a new division or octave range takes effect at the next step
+	arp->mode = (mode < ARP_MODE_COUNT) ? (uint8_t) mode : ARP_OFF;
+	arp->division = division ? division : 1;
+	arp->octaves = octaves ? octaves : 1;
+
+	//switched off it forgets its keys, their note-offs no longer reach it
+	if(arp->mode == ARP_OFF) arp->count = 0;
+}
+
+void arp_restart( struct arp *arp )
+{
+	//the next clock is the first step of the pattern
+	arp->clock = 0;
+	arp->step = ARP_NONE;
+	arp->direction = 1;
+}
+
+void arp_note_on( struct arp *arp, uint8_t note, uint8_t velocity )
+{
+	int i;
+
+	note &= 0x7F;
+	if(arp->count == 0) arp_restart(arp);
+	for(i=0; i<arp->count; i++) if(arp->played[i] == note) return;
+	if(arp->count == SYNTH_ARP_NOTES) return;
+
+	arp->velocity[note] = velocity & 0x7F;
+	arp->played[arp->count] = note;
+
+	for(i=arp->count; (i > 0) && (arp->sorted[i - 1] > note); i--) arp->sorted[i] = arp->sorted[i - 1];
+	arp->sorted[i] = note;
+	arp->count++;
+}
+
+bool arp_note_off( struct arp *arp, uint8_t note )
+{
+	//false for a key the arpeggiator does not hold
+	int i;
+
+	note &= 0x7F;
+	for(i=0; i<arp->count; i++) if(arp->played[i] == note) break;
+	if(i == arp->count) return false;
+
+	arp_remove(arp->played, arp->count, note);
+	arp_remove(arp->sorted, arp->count, note);
+	arp->count--;
+	return true;
+}
+
+bool arp_clock( struct arp *arp, struct arp_step *step )
+{
+	//true when the step asks for a note off or on
+	step->off = ARP_NONE;
+	step->on = ARP_NONE;
+
+	if(arp->mode == ARP_OFF) return false;
+
+	//half the step sounds, at least one clock, and never into the next step
+	if((arp->sounding != ARP_NONE) && ((arp->clock == 0) || (arp->clock >= (arp->division + 1) / 2) || (arp->count == 0)))
+	{
+		step->off = arp->sounding;
+		arp->sounding = ARP_NONE;
+	}
+
+	if((arp->clock == 0) && (arp->count != 0))
+	{
+		step->on = arp_next(arp, &step->velocity);
+		arp->sounding = step->on;
+	}
+
+	if(arp->count != 0) arp->clock = (arp->clock + 1 >= arp->division) ? 0 : arp->clock + 1;
+	return (step->off != ARP_NONE) || (step->on != ARP_NONE);
+}
+
+int16_t arp_release( struct arp *arp )
+{
+	//the sounding note for the caller to release, when the arpeggiator is switched off
+	int16_t note = arp->sounding;
+
+	arp->sounding = ARP_NONE;
+	return note;
+}
+
+static void arp_remove( uint8_t *list, int count, uint8_t note )
+{
+	int i;
+
+	for(i=0; (i < count) && (list[i] != note); i++);
+	for(; i < count - 1; i++) list[i] = list[i + 1];
+}
+
+static int16_t arp_next( struct arp *arp, uint8_t *velocity )
+{
+	//advances the pattern position, returns the note at it with the velocity it was played
+	//with; octaves above the top key fold back down
+	int length = arp->count * arp->octaves;
+	int note;
+	int p;
+
+	if(arp->step == ARP_NONE)
+	{
+		arp->step = (arp->mode == ARP_DOWN) ? length - 1 : 0;
+		arp->direction = 1;
+	}
+	else if(arp->mode == ARP_DOWN)
+	{
+		arp->step = (arp->step <= 0) ? length - 1 : arp->step - 1;
+	}
+	else if(arp->mode == ARP_RANDOM)
+	{
+		//one xorshift step, a pick of length - 1 that skips the last position
+		arp->random ^= arp->random << 13;
+		arp->random ^= arp->random >> 17;
+		arp->random ^= arp->random << 5;
+		if(length < 2) arp->step = 0;
+		else
+		{
+			p = (int) (((uint64_t) arp->random * (uint32_t) (length - 1)) >> 32);
+			arp->step = (p >= arp->step) ? p + 1 : p;
+		}
+	}
+	else if(arp->mode == ARP_UP_DOWN)
+	{
+		if(length < 2) arp->step = 0;
+		else
+		{
+			if((arp->step + arp->direction >= length) || (arp->step + arp->direction < 0)) arp->direction = -arp->direction;
+			arp->step += arp->direction;
+		}
+	}
+	else
+	{
+		arp->step = (arp->step + 1 >= length) ? 0 : arp->step + 1;
+	}
+
+	//notes released since the last step can leave the position past the end
+	if(arp->step >= length) arp->step = 0;
+	p = arp->step;
+
+	note = (arp->mode == ARP_PLAYED) ? arp->played[p % arp->count] : arp->sorted[p % arp->count];
+	*velocity = arp->velocity[note];
+	note += 12 * (p / arp->count);
+	while(note > 127) note -= 12;
+	return (int16_t) note;
+}
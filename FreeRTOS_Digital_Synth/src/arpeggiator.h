@@ -0,0 +1,69 @@
+/*************************************************************************************************
+                                        --ARPEGGIATOR--
+
+	Plays the notes held on one channel one after the other, stepping on MIDI clocks: a
+	step every 'division' clocks (6 is a sixteenth note), each note sounding for half of
+	its step. The held notes are kept sorted by pitch and in the order they were played,
+	up to SYNTH_ARP_NOTES; with octaves above 1 the pattern repeats that many octaves up
+	before it starts over. The random pattern picks any position of the same range, never
+	the same one twice in a row.
+
+	arp_clock() is called once per clock and says which note to release and which to start,
+	the engine plays them. Releasing the last key stops the pattern, the next key starts it
+	from the beginning again, on the next clock.
+
+*************************************************************************************************/
+
+#ifndef ARPEGGIATOR_H_INCLUDED
+#define ARPEGGIATOR_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define ARP_NONE				(	-1	)
+
+/********   TYPE DEFS  **********/
+enum arp_mode{
+	ARP_OFF,
+	ARP_UP,
+	ARP_DOWN,
+	ARP_UP_DOWN,
+	ARP_PLAYED,
+	ARP_RANDOM,
+	ARP_MODE_COUNT
+};
+
+struct arp{
+	uint8_t sorted[SYNTH_ARP_NOTES];
+	uint8_t played[SYNTH_ARP_NOTES];
+	uint8_t velocity[128];
+	uint8_t count;
+	uint8_t mode;
+	uint8_t division;		//clocks per step
+	uint8_t octaves;
+	uint8_t clock;			//clocks into the current step
+	int16_t step;			//position in the pattern, ARP_NONE before the first step
+	int8_t direction;		//of the up-down pattern
+	int16_t sounding;		//note started by the last step, ARP_NONE when released
+	uint32_t random;		//xorshift state of the random pattern
+};
+
+//what one clock asks for, ARP_NONE for nothing
+struct arp_step{
+	int16_t off;
+	int16_t on;
+	uint8_t velocity;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void arp_init( struct arp *arp );
+void arp_set( struct arp *arp, enum arp_mode mode, uint8_t division, uint8_t octaves );
+void arp_restart( struct arp *arp );
+void arp_note_on( struct arp *arp, uint8_t note, uint8_t velocity );
+bool arp_note_off( struct arp *arp, uint8_t note );
+bool arp_clock( struct arp *arp, struct arp_step *step );
+int16_t arp_release( struct arp *arp );
+
+#endif /* ARPEGGIATOR_H_INCLUDED */
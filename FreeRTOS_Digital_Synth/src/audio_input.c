@@ -0,0 +1,194 @@
+/*************************************************************************************************
+                                         --AUDIO INPUT--
+
+	The ADC runs from OSC8M on generator 2 divided by 4, 2 MHz: a 12-bit conversion with its
+	sampling time is done in about 4 us, well inside a sample period at 48 kHz. The
+	reference is half of VDDANA at a gain of one half, so 0 to VDDANA is the full 12 bits
+	and midscale is the input's bias; the result less midscale is already in DAC units.
+
+	The MCP4821 output takes one clock tick per word, so with two channels every sample
+	period has two conversions; a block of the ring holds them all and the pair is averaged
+	on the way out.
+
+	Each descriptor of the ring ends its block with an interrupt, which only counts it. The
+	ring is one block longer than the output's, the renderer can lag that far before the DMA
+	writes over a block it has not taken yet.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "audio_input.h"
+#include "dac_dma.h"
+#include "sample_clock.h"
+#include "synth_engine.h"
+
+#if SYNTH_AUDIO_INPUT
+
+/**********  DEFINE  ************/
+#define INPUT_BLOCKS			(	SYNTH_OUTPUT_FRAMES + 1	)
+#define INPUT_SAMPLE_LENGTH		(	2	) //half ADC clocks of sampling, beyond the first
+
+//conversions per sample, one per sample clock tick
+#if SYNTH_OUTPUT_DMA && (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_MCP4821)
+#  define INPUT_TICKS			(	SYNTH_OUTPUT_CHANNELS	)
+#else
+#  define INPUT_TICKS			(	1	)
+#endif
+
+#define INPUT_BLOCK_LENGTH		(	SYNTH_BLOCK_SIZE * INPUT_TICKS	)
+
+
+/*******   GLOBAL VARS  *********/
+//PORT pin of each ADC input, AIN0 to AIN19
+static const uint8_t input_ain_pin[] = {
+	PIN_PA02, PIN_PA03, PIN_PB08, PIN_PB09, PIN_PA04, PIN_PA05, PIN_PA06, PIN_PA07,
+	PIN_PB00, PIN_PB01, PIN_PB02, PIN_PB03, PIN_PB04, PIN_PB05, PIN_PB06, PIN_PB07,
+	PIN_PA08, PIN_PA09, PIN_PA10, PIN_PA11,
+};
+
+//linked descriptors for the blocks after the first, which is in the DMAC base section
+SYNTH_DMA_DESCRIPTOR static DmacDescriptor input_chain[INPUT_BLOCKS - 1];
+
+SYNTH_AUDIO_BUFFER static uint16_t input_ring[INPUT_BLOCKS][INPUT_BLOCK_LENGTH];
+static int16_t input_samples[SYNTH_BLOCK_SIZE];
+static volatile uint32_t input_written;
+static uint32_t input_read;
+static uint32_t input_overrun_count;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void audio_input_block_done( void );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void adc_sync( void )
+{
+	while(ADC->STATUS.reg & ADC_STATUS_SYNCBUSY);
+}
+
+static DmacDescriptor *input_descriptor( int n )
+{
+	return (n == 0) ? dac_dma_base_descriptor(AUDIO_INPUT_DMA_CHANNEL) : &input_chain[n - 1];
+}
+
+void audio_input_init( void )
+{
+	struct system_pinmux_config pin_conf;
+	struct system_gclk_chan_config gclk_chan_conf;
+	DmacDescriptor *desc;
+	uint32_t linearity;
+	uint32_t bias;
+	irqflags_t flags;
+	uint8_t chid;
+	int n;
+
+	//function B is the analog one on every ADC pin
+	system_pinmux_get_config_defaults(&pin_conf);
+	pin_conf.mux_position = 1;
+	pin_conf.input_pull = SYSTEM_PINMUX_PIN_PULL_NONE;
+	system_pinmux_pin_set_config(input_ain_pin[SYNTH_AUDIO_INPUT_AIN], &pin_conf);
+
+	PM->APBCMASK.reg |= PM_APBCMASK_ADC;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
+	system_gclk_chan_set_config(ADC_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(ADC_GCLK_ID);
+
+	ADC->CTRLA.reg = ADC_CTRLA_SWRST;
+	adc_sync();
+	while(ADC->CTRLA.reg & ADC_CTRLA_SWRST);
+
+	//factory calibration from the NVM software calibration area
+	linearity = (*(uint32_t *) ADC_FUSES_LINEARITY_0_ADDR & ADC_FUSES_LINEARITY_0_Msk) >> ADC_FUSES_LINEARITY_0_Pos;
+	linearity |= ((*(uint32_t *) ADC_FUSES_LINEARITY_1_ADDR & ADC_FUSES_LINEARITY_1_Msk) >> ADC_FUSES_LINEARITY_1_Pos) << 5;
+	bias = (*(uint32_t *) ADC_FUSES_BIASCAL_ADDR & ADC_FUSES_BIASCAL_Msk) >> ADC_FUSES_BIASCAL_Pos;
+	ADC->CALIB.reg = ADC_CALIB_BIAS_CAL(bias) | ADC_CALIB_LINEARITY_CAL(linearity);
+
+	ADC->REFCTRL.reg = ADC_REFCTRL_REFSEL_INTVCC1;
+	ADC->SAMPCTRL.reg = ADC_SAMPCTRL_SAMPLEN(INPUT_SAMPLE_LENGTH);
+	ADC->CTRLB.reg = ADC_CTRLB_PRESCALER_DIV4 | ADC_CTRLB_RESSEL_12BIT;
+	adc_sync();
+	ADC->INPUTCTRL.reg = ADC_INPUTCTRL_MUXPOS(SYNTH_AUDIO_INPUT_AIN) | ADC_INPUTCTRL_MUXNEG_GND | ADC_INPUTCTRL_GAIN_DIV2;
+	adc_sync();
+	ADC->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+	ADC->INTFLAG.reg = ADC_INTFLAG_MASK;
+
+	//a ring of blocks, each one counted by the interrupt at its end
+	for(n=0; n<INPUT_BLOCKS; n++)
+	{
+		desc = input_descriptor(n);
+		desc->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC | DMAC_BTCTRL_BLOCKACT_INT;
+		desc->BTCNT.reg = INPUT_BLOCK_LENGTH;
+		desc->SRCADDR.reg = (uint32_t) &ADC->RESULT.reg;
+		desc->DSTADDR.reg = (uint32_t) input_ring[n] + sizeof(input_ring[n]);
+		desc->DESCADDR.reg = (uint32_t) input_descriptor((n + 1) % INPUT_BLOCKS);
+	}
+
+	input_written = 0;
+	input_read = 0;
+	input_overrun_count = 0;
+
+	//the output's channel runs already and its interrupt selects channels too
+	dac_dma_controller_init();
+	dac_dma_attach_channel(AUDIO_INPUT_DMA_CHANNEL, audio_input_block_done);
+	flags = cpu_irq_save();
+	chid = DMAC->CHID.reg;
+	DMAC->CHID.reg = DMAC_CHID_ID(AUDIO_INPUT_DMA_CHANNEL);
+	DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+	DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(ADC_DMAC_ID_RESRDY) | DMAC_CHCTRLB_TRIGACT_BEAT;
+	DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+	DMAC->CHID.reg = chid;
+	cpu_irq_restore(flags);
+
+	ADC->CTRLA.reg = ADC_CTRLA_ENABLE;
+	adc_sync();
+	sample_clock_route_event(EVSYS_ID_USER_ADC_START);
+}
+
+const int16_t *audio_input_block( void )
+{
+	//the next block in capture order as signed samples, NULL if it is not complete yet
+	uint32_t written = input_written;
+	const uint16_t *raw;
+	int32_t sum;
+	int i;
+	int t;
+
+	if(written == input_read) return NULL;
+
+	if(written - input_read >= INPUT_BLOCKS)
+	{
+		input_read = written - 1;
+		input_overrun_count++;
+	}
+
+	raw = input_ring[input_read % INPUT_BLOCKS];
+	input_read++;
+
+	for(i=0; i<SYNTH_BLOCK_SIZE; i++)
+	{
+		sum = 0;
+		for(t=0; t<INPUT_TICKS; t++) sum += raw[i * INPUT_TICKS + t];
+		input_samples[i] = (int16_t) (sum / INPUT_TICKS - DAC_MIDSCALE);
+	}
+
+	return input_samples;
+}
+
+uint32_t audio_input_overruns( void )
+{
+	return input_overrun_count;
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+SYNTH_RAM_CODE static void audio_input_block_done( void )
+{
+	//the channel is already selected
+	DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+	input_written++;
+}
+
+#endif /* SYNTH_AUDIO_INPUT */
@@ -0,0 +1,32 @@
+/*************************************************************************************************
+                                         --AUDIO INPUT--
+
+	External audio into the render pipeline, so the board works as an effects processor. The
+	sample clock's overflow event starts an ADC conversion on SYNTH_AUDIO_INPUT_AIN at the
+	same instant it clocks an output sample out, and a DMA channel copies each result into a
+	ring of SYNTH_BLOCK_SIZE sample blocks. Input and output run off the one timer, so they
+	never drift apart and nothing has to be resampled.
+
+	audio_input_block() hands the renderer the blocks in the order they were captured, as
+	signed samples in DAC units (see synth_set_input()), and NULL while no block is complete
+	yet, at start-up. If the renderer falls a whole ring behind it skips to the newest block
+	and counts an overrun. Otherwise the delay from input to output is fixed, the output
+	ring's plus one or two blocks.
+
+	Call audio_input_init() once the output has started the sample clock: it routes the
+	overflow event, which sample_clock_init() clears.
+
+*************************************************************************************************/
+
+#ifndef AUDIO_INPUT_H_INCLUDED
+#define AUDIO_INPUT_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void audio_input_init( void );
+const int16_t *audio_input_block( void );
+uint32_t audio_input_overruns( void );
+
+#endif /* AUDIO_INPUT_H_INCLUDED */
@@ -0,0 +1,67 @@
+/*************************************************************************************************
+                                        --AUDIO OUTPUT--
+
+	Output backends behind one interface, so a board picks its converter with
+	SYNTH_OUTPUT_BACKEND instead of a fork of main.c. Every backend plays the same ring of
+	frames through the DMA ring in dac_dma.c and calls the frame-played callback from the
+	DMAC interrupt as each frame finishes:
+
+		init		configures the peripheral and builds the ring over the frame pool
+		start		starts output at the sample rate, also the pacing clock where the
+					backend needs one
+		set_rate	changes the rate of a running output
+		submit		converts a rendered block of DAC codes into a frame of output words, the
+					one place the engine's format becomes the converter's (sample_format.h)
+		conceal		the underrun handler, overwrites a frame that was not refilled in time
+					according to SYNTH_UNDERRUN_POLICY, continuing from the frame just played
+		prime		writes one code straight to the converter between init and start, false
+					when it did not take it; NULL for an output that needs no start-up ramp
+
+	MCP4821 (EXT1 SPI, an MCP4822 with SYNTH_STEREO): one DMA block per word, paced by the
+	sample clock. Internal DAC (PA02, 10-bit, mono only): converts on the sample clock
+	overflow through the event system, the DMA refills its data buffer in between. I2S (SCK
+	PA10, FS PA11, SD PA19, MCK PA09): 16-bit samples in two slots, paced by its own clocks
+	from the FDPLL, exact at 44.1 and 48 kHz.
+
+	SYNTH_OUTPUT_DMA off keeps the CPU-written MCP4821 path in main.c, which only uses
+	mcp4821_spi_init(), the inline mcp4821_spi_write() (mcp4821_spi.h) and the MCP4821's
+	prime.
+
+*************************************************************************************************/
+
+#ifndef AUDIO_OUTPUT_H_INCLUDED
+#define AUDIO_OUTPUT_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "dac_dma.h"
+
+/**********  DEFINE  ************/
+#if (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_INTERNAL_DAC)
+#  define AUDIO_OUTPUT_DEFAULT		audio_output_dac
+#elif (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_I2S)
+#  define AUDIO_OUTPUT_DEFAULT		audio_output_i2s
+#else
+#  define AUDIO_OUTPUT_DEFAULT		audio_output_mcp4821
+#endif
+
+/********   TYPE DEFS  **********/
+struct audio_output{
+	const char *name;
+	void (*init)( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played );
+	void (*start)( uint32_t sample_rate );
+	void (*set_rate)( uint32_t sample_rate );
+	void (*submit)( uint16_t *frame, const uint16_t *samples );
+	void (*conceal)( uint16_t *frame, const uint16_t *played_frame );
+	bool (*prime)( uint16_t code );
+};
+
+/*******   GLOBAL VARS  *********/
+extern const struct audio_output audio_output_mcp4821;
+extern const struct audio_output audio_output_dac;
+extern const struct audio_output audio_output_i2s;
+
+/****** FUNCTION PROTOTYPES  ****/
+void mcp4821_spi_init( void );
+
+#endif /* AUDIO_OUTPUT_H_INCLUDED */
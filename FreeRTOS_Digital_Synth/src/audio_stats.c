@@ -0,0 +1,100 @@
+/*************************************************************************************************
+                                         --AUDIO STATS--
+
+	Every counter has a single writer: block timing and late blocks come from the rendering
+	task, underruns and overruns from the output stage. Readers take a copy field by field, a torn read only
+	mixes figures from neighbouring blocks.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "audio_stats.h"
+
+
+/*******   GLOBAL VARS  *********/
+static volatile struct audio_stats audio_stats;
+
+//running average, kept with AUDIO_STATS_AVG_SHIFT extra fraction bits
+static uint32_t avg_acc;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void audio_stats_init( uint32_t cpu_hz, uint32_t sample_rate )
+{
+	audio_stats_set_rate(cpu_hz, sample_rate);
+	audio_stats.last_cycles = 0;
+	audio_stats.peak_cycles = 0;
+	audio_stats.avg_cycles = 0;
+	audio_stats.blocks = 0;
+	audio_stats.underruns = 0;
+	audio_stats.overruns = 0;
+	audio_stats.late = 0;
+	avg_acc = 0;
+}
+
+void audio_stats_set_rate( uint32_t cpu_hz, uint32_t sample_rate )
+{
+	//block period in CPU cycles, the counters carry on
+	audio_stats.budget_cycles = (uint32_t) (((uint64_t) cpu_hz * SYNTH_BLOCK_SIZE) / sample_rate);
+}
+
+void audio_stats_block( uint32_t cycles )
+{
+	//called by the renderer once per block with the cycles the block took
+	if(audio_stats.blocks == 0) avg_acc = cycles << AUDIO_STATS_AVG_SHIFT;
+	else avg_acc += cycles - (avg_acc >> AUDIO_STATS_AVG_SHIFT);
+
+	audio_stats.last_cycles = cycles;
+	audio_stats.avg_cycles = avg_acc >> AUDIO_STATS_AVG_SHIFT;
+	if(cycles > audio_stats.peak_cycles) audio_stats.peak_cycles = cycles;
+	audio_stats.blocks++;
+}
+
+void audio_stats_underrun( void )
+{
+	audio_stats.underruns++;
+}
+
+void audio_stats_overrun( void )
+{
+	audio_stats.overruns++;
+}
+
+void audio_stats_late( void )
+{
+	audio_stats.late++;
+}
+
+void audio_stats_get( struct audio_stats *stats )
+{
+	stats->budget_cycles = audio_stats.budget_cycles;
+	stats->last_cycles = audio_stats.last_cycles;
+	stats->peak_cycles = audio_stats.peak_cycles;
+	stats->avg_cycles = audio_stats.avg_cycles;
+	stats->blocks = audio_stats.blocks;
+	stats->underruns = audio_stats.underruns;
+	stats->overruns = audio_stats.overruns;
+	stats->late = audio_stats.late;
+}
+
+void audio_stats_reset_peak( void )
+{
+	audio_stats.peak_cycles = 0;
+}
+
+uint16_t audio_stats_load( uint32_t cycles )
+{
+	//share of the block period in per mille, saturates at 9999 so the product stays in 32 bits
+	uint32_t budget = audio_stats.budget_cycles;
+
+	if(budget == 0) return 0;
+	if(cycles >= budget * 10) return 9999;
+
+	return (uint16_t) ((cycles * 1000) / budget);
+}
+
+uint32_t audio_stats_budget( void )
+{
+	//block period in CPU cycles
+	return audio_stats.budget_cycles;
+}
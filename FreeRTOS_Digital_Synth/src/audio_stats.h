@@ -0,0 +1,45 @@
+/*************************************************************************************************
+                                         --AUDIO STATS--
+
+	Render timing and deadline bookkeeping for the audio pipeline. The renderer reports how
+	many cycles each block took, the output stage reports frames it had to play before they
+	were rendered (underrun) and frames the renderer could not hand over (overrun). Load is
+	given in per mille of the block period, so 1000 means the render took a whole block.
+
+*************************************************************************************************/
+
+#ifndef AUDIO_STATS_H_INCLUDED
+#define AUDIO_STATS_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//weight of the newest block in the running average, 1 / 2^AUDIO_STATS_AVG_SHIFT
+#define AUDIO_STATS_AVG_SHIFT	(	4	)
+
+/********   TYPE DEFS  **********/
+struct audio_stats{
+	uint32_t budget_cycles;
+	uint32_t last_cycles;
+	uint32_t peak_cycles;
+	uint32_t avg_cycles;
+	uint32_t blocks;
+	uint32_t underruns;
+	uint32_t overruns;
+	uint32_t late;			//blocks that cut deferrable work to make their deadline
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void audio_stats_init( uint32_t cpu_hz, uint32_t sample_rate );
+void audio_stats_set_rate( uint32_t cpu_hz, uint32_t sample_rate );
+void audio_stats_block( uint32_t cycles );
+void audio_stats_underrun( void );
+void audio_stats_overrun( void );
+void audio_stats_late( void );
+void audio_stats_get( struct audio_stats *stats );
+void audio_stats_reset_peak( void );
+uint16_t audio_stats_load( uint32_t cycles );
+uint32_t audio_stats_budget( void );
+
+#endif /* AUDIO_STATS_H_INCLUDED */
@@ -0,0 +1,111 @@
+/*************************************************************************************************
+                                          --AUDIO TAP--
+
+	The render task runs above the console's task and never blocks inside a block, so when
+	the console arms or dumps, no block is half rendered: a slot handed out has been filled
+	by the time anyone else looks at it. That is why the slots are counted as they are
+	handed out and none of this needs a lock.
+
+	The capture stops when the buffer is full rather than going round, a burst is the
+	blocks right after arming, which is where the interesting note usually is.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include <string.h>
+#include "conf_synth.h"
+#include "audio_tap.h"
+#include "debug_uart.h"
+#include "synth_engine.h"
+
+#if SYNTH_AUDIO_TAP
+
+/****** FUNCTION PROTOTYPES  ****/
+static void audio_tap_put( const void *data, uint16_t length, uint16_t *sum );
+
+
+/*******   GLOBAL VARS  *********/
+static uint16_t audio_tap_buffer[SYNTH_AUDIO_TAP_BLOCKS][SYNTH_FRAME_WORDS];
+static volatile uint16_t audio_tap_blocks;
+static volatile uint16_t audio_tap_decimation;		//0 while disarmed
+static uint16_t audio_tap_skip;
+static uint32_t audio_tap_rate;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void audio_tap_arm( uint16_t decimation )
+{
+	//starts a new capture of every decimation-th block
+	audio_tap_decimation = 0;
+	audio_tap_blocks = 0;
+	audio_tap_skip = 0;
+	audio_tap_rate = synth_sample_rate();
+	audio_tap_decimation = decimation;
+}
+
+uint16_t *audio_tap_slot( void )
+{
+	//capture buffer to render the next block into, NULL when it is not captured
+	if(audio_tap_decimation == 0 || audio_tap_blocks == SYNTH_AUDIO_TAP_BLOCKS) return NULL;
+	if(audio_tap_skip != 0)
+	{
+		audio_tap_skip--;
+		return NULL;
+	}
+
+	audio_tap_skip = audio_tap_decimation - 1;
+	return audio_tap_buffer[audio_tap_blocks++];
+}
+
+void audio_tap_copy( uint16_t *slot, const uint16_t *block )
+{
+	memcpy(slot, block, SYNTH_FRAME_WORDS * sizeof(uint16_t));
+}
+
+uint16_t audio_tap_captured( void )
+{
+	return audio_tap_blocks;
+}
+
+static void audio_tap_put( const void *data, uint16_t length, uint16_t *sum )
+{
+	const uint8_t *bytes = (const uint8_t *) data;
+	uint16_t i;
+
+	for(i=0; i<length; i++) *sum += bytes[i];
+	debug_uart_write_wait(data, length);
+}
+
+void audio_tap_dump( void )
+{
+	//disarms and writes the capture to the EDBG port in the format in audio_tap.h
+	uint8_t head[2];
+	uint16_t block_size = SYNTH_BLOCK_SIZE;
+	uint16_t decimation = audio_tap_decimation;
+	uint16_t blocks;
+	uint16_t sum = 0;
+	uint16_t check;
+	uint16_t i;
+
+	if(stdio_base == NULL) return;
+
+	audio_tap_decimation = 0;
+	blocks = audio_tap_blocks;
+
+	audio_tap_put("ATAP", 4, &sum);
+	sum = 0;
+	head[0] = AUDIO_TAP_VERSION;
+	head[1] = SYNTH_OUTPUT_CHANNELS;
+	audio_tap_put(head, sizeof(head), &sum);
+	audio_tap_put(&block_size, sizeof(block_size), &sum);
+	audio_tap_put(&audio_tap_rate, sizeof(audio_tap_rate), &sum);
+	audio_tap_put(&decimation, sizeof(decimation), &sum);
+	audio_tap_put(&blocks, sizeof(blocks), &sum);
+
+	for(i=0; i<blocks; i++) audio_tap_put(audio_tap_buffer[i], SYNTH_FRAME_WORDS * sizeof(uint16_t), &sum);
+	check = sum;
+	audio_tap_put(&check, sizeof(check), &sum);
+}
+
+#endif /* SYNTH_AUDIO_TAP */
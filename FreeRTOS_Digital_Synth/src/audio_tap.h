@@ -0,0 +1,41 @@
+/*************************************************************************************************
+                                          --AUDIO TAP--
+
+	Captures the rendered master bus for offline analysis. With SYNTH_AUDIO_TAP set, the
+	":tap <n>" console command arms a capture of SYNTH_AUDIO_TAP_BLOCKS blocks, every n-th
+	block rendered from then on, 1 for a gapless burst. The 'a' console command writes what
+	has been captured to the EDBG port and disarms; tools/audio_tap.py turns it into a WAV.
+
+	Nothing is sent while capturing, the 115200 baud line carries about a third of one
+	channel at the lowest rate, so the capture is dumped after it is complete. The render task asks
+	audio_tap_slot() for a place to render each block: the DMA path renders straight into
+	the capture buffer and the output stage reads the block from there, the CPU path
+	renders into its frame and audio_tap_copy() copies one block of words into the slot.
+	Either way the render task's only extra work is a pointer check per block.
+
+	The dump is binary, little-endian:
+
+		"ATAP", version, output channels, block size (2)
+		sample rate at the start of the capture in Hz (4), decimation (2), blocks (2)
+		the blocks, oldest first, as rendered: DAC codes around 2048, channels interleaved
+		sum of every byte from the version on (2)
+
+*************************************************************************************************/
+
+#ifndef AUDIO_TAP_H_INCLUDED
+#define AUDIO_TAP_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define AUDIO_TAP_VERSION			(	1	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void audio_tap_arm( uint16_t decimation );
+uint16_t *audio_tap_slot( void );
+void audio_tap_copy( uint16_t *slot, const uint16_t *block );
+uint16_t audio_tap_captured( void );
+void audio_tap_dump( void );
+
+#endif /* AUDIO_TAP_H_INCLUDED */
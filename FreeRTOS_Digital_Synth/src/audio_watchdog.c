@@ -0,0 +1,204 @@
+/*************************************************************************************************
+                                        --AUDIO WATCHDOG--
+
+	The period and the early warning offset are both 8 << n cycles of the WDT clock; the
+	settings are the smallest that cover the configured times. A CLEAR written while the
+	previous one is still synchronizing would stall the bus for several WDT clocks, so a
+	kick during that window is skipped, the next block's does it.
+
+	The record lives in .noinit, which the linker script places after .bss, out of the
+	range Reset_Handler zeroes. A magic word and its complement tell it from the random
+	contents after power-up.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "audio_watchdog.h"
+#include "audio_stats.h"
+#include "synth_engine.h"
+#include "trace_log.h"
+
+
+/**********  DEFINE  ************/
+#define WATCHDOG_GCLK_GENERATOR	GCLK_GENERATOR_5
+#define WATCHDOG_CLOCK_HZ		(	1024	)
+#define WATCHDOG_MAGIC			(	0x57444F47u	)	//"WDOG"
+
+
+/********   TYPE DEFS  **********/
+struct watchdog_record{
+	uint32_t magic;
+	uint32_t bites;					//warnings since power-up
+	bool pending;					//not reported yet
+	uint32_t pc;
+	uint32_t lr;
+	uint32_t tick;
+	uint32_t render_time;
+	uint32_t underruns;
+	char task[configMAX_TASK_NAME_LEN];
+	int log_count;
+	const char *log_fmt[TRACE_LOG_SIZE];
+	uint32_t log_arg[TRACE_LOG_SIZE];
+	uint32_t check;					//~magic
+};
+
+
+/*******   GLOBAL VARS  *********/
+static struct watchdog_record watchdog_record __attribute__((section(".noinit")));
+static bool watchdog_running;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+void WDT_Handler( void ) __attribute__((naked));
+void audio_watchdog_warning( const uint32_t *frame );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint8_t watchdog_setting( uint32_t ms )
+{
+	//smallest n with 8 << n WDT cycles lasting at least 'ms', 11 at most
+	uint8_t n = 0;
+
+	while((n < 11) && ((((uint32_t) 8 << n) * 1000) / WATCHDOG_CLOCK_HZ < ms)) n++;
+
+	return n;
+}
+
+static void watchdog_sync( void )
+{
+	while(WDT->STATUS.reg & WDT_STATUS_SYNCBUSY);
+}
+
+static bool watchdog_record_valid( void )
+{
+	return (watchdog_record.magic == WATCHDOG_MAGIC) && (watchdog_record.check == ~WATCHDOG_MAGIC);
+}
+
+void audio_watchdog_init( void )
+{
+	//once the output runs, it kicks from then on
+	struct system_gclk_gen_config gclock_gen_conf;
+	struct system_gclk_chan_config gclk_chan_conf;
+
+	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
+	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_ULP32K;
+	gclock_gen_conf.division_factor = 32;
+	system_gclk_gen_set_config(WATCHDOG_GCLK_GENERATOR, &gclock_gen_conf);
+	system_gclk_gen_enable(WATCHDOG_GCLK_GENERATOR);
+
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = WATCHDOG_GCLK_GENERATOR;
+	system_gclk_chan_set_config(WDT_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(WDT_GCLK_ID);
+
+	if(watchdog_record_valid() == false)
+	{
+		watchdog_record.bites = 0;
+		watchdog_record.pending = false;
+	}
+
+	watchdog_sync();
+	WDT->CTRL.reg = 0;
+	watchdog_sync();
+	WDT->CONFIG.reg = WDT_CONFIG_PER(watchdog_setting(SYNTH_WATCHDOG_TIMEOUT_MS));
+	WDT->EWCTRL.reg = WDT_EWCTRL_EWOFFSET(watchdog_setting(SYNTH_WATCHDOG_WARNING_MS));
+	WDT->INTFLAG.reg = WDT_INTFLAG_EW;
+	WDT->INTENSET.reg = WDT_INTENSET_EW;
+	system_interrupt_enable(SYSTEM_INTERRUPT_MODULE_WDT);
+
+	WDT->CTRL.reg = WDT_CTRL_ENABLE;
+	watchdog_sync();
+	watchdog_running = true;
+}
+
+SYNTH_RAM_CODE void audio_watchdog_kick( void )
+{
+	//output interrupt, the next block was rendered in time
+	if(watchdog_running == false) return;
+	if(WDT->STATUS.reg & WDT_STATUS_SYNCBUSY) return;
+
+	WDT->CLEAR.reg = WDT_CLEAR_CLEAR_KEY;
+}
+
+bool audio_watchdog_report( void )
+{
+	//start-up, before the scheduler: the post-mortem of the warning that reset the board
+	int i;
+
+	if((watchdog_record_valid() == false) || (watchdog_record.pending == false)) return false;
+	watchdog_record.pending = false;
+
+	printf("watchdog: audio stalled, reset %lu since power-up\r\n", (unsigned long) watchdog_record.bites);
+	printf("watchdog: task %s, pc 0x%08lx, lr 0x%08lx, tick %lu\r\n", watchdog_record.task,
+		(unsigned long) watchdog_record.pc, (unsigned long) watchdog_record.lr, (unsigned long) watchdog_record.tick);
+	printf("watchdog: render time %lu, %lu underruns\r\n", (unsigned long) watchdog_record.render_time,
+		(unsigned long) watchdog_record.underruns);
+
+	//same firmware, so the format strings are still where the records point
+	for(i=0; i<watchdog_record.log_count; i++)
+	{
+		printf("watchdog: log ");
+		printf(watchdog_record.log_fmt[i], watchdog_record.log_arg[i]);
+	}
+
+	return true;
+}
+
+void audio_watchdog_warning( const uint32_t *frame )
+{
+	//early warning, with the exception frame of whatever it interrupted: R0-R3, R12, LR, PC,
+	//xPSR
+	struct audio_stats stats;
+	const signed char *name;
+	int i;
+
+	if(watchdog_record_valid() == false) watchdog_record.bites = 0;
+
+	watchdog_record.bites++;
+	watchdog_record.pc = frame[6];
+	watchdog_record.lr = frame[5];
+	watchdog_record.tick = xTaskGetTickCountFromISR();
+	watchdog_record.render_time = synth_render_time();
+	audio_stats_get(&stats);
+	watchdog_record.underruns = stats.underruns;
+
+	name = pcTaskGetTaskName(NULL);
+	for(i=0; i<configMAX_TASK_NAME_LEN - 1 && name[i] != '\0'; i++) watchdog_record.task[i] = (char) name[i];
+	watchdog_record.task[i] = '\0';
+
+	watchdog_record.log_count = trace_log_snapshot(watchdog_record.log_fmt, watchdog_record.log_arg, TRACE_LOG_SIZE);
+
+	watchdog_record.pending = true;
+	watchdog_record.magic = WATCHDOG_MAGIC;
+	watchdog_record.check = ~WATCHDOG_MAGIC;
+
+	//no need to wait out the rest of the timeout
+	NVIC_SystemReset();
+}
+
+
+/******  INTERRUPT HANDLERS   *******/
+void WDT_Handler( void )
+{
+	//passes the stacked frame to audio_watchdog_warning(), from the PSP when a task was
+	//interrupted, the MSP when an interrupt was
+	__asm volatile
+	(
+	"	movs r0, #4							\n"
+	"	mov r1, lr							\n"
+	"	tst r0, r1							\n"
+	"	beq 1f								\n"
+	"	mrs r0, psp							\n"
+	"	b 2f								\n"
+	"1:	mrs r0, msp							\n"
+	"2:	ldr r1, 3f							\n" /* A plain b may not reach, it has no veneer. */
+	"	bx r1								\n"
+	"										\n"
+	"	.align 2							\n"
+	"3:	.word audio_watchdog_warning		  "
+	);
+}
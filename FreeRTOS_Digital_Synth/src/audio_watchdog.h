@@ -0,0 +1,33 @@
+/*************************************************************************************************
+                                        --AUDIO WATCHDOG--
+
+	The WDT supervises the audio path itself: the output stage kicks it each time the next
+	block was rendered in time, and nothing else does. If the renderer stalls (a hang, an
+	interrupt storm, a task that never yields) the output keeps playing concealed frames,
+	the kicks stop and the WDT resets the board.
+
+	Half way through the timeout the early warning interrupt saves a post-mortem to RAM the
+	start-up code does not clear: the interrupted PC and LR, the running task, the render
+	time and underruns, and every trace log record not printed yet. It then resets at once
+	rather than waiting for the rest of the timeout. audio_watchdog_report() prints that
+	record once after the reset.
+
+	The WDT runs from GCLK_GENERATOR_5 on OSCULP32K divided to 1.024 kHz, so clock scaling
+	and the DFLL do not move its timeout. Its interrupt runs at SYNTH_IRQ_LEVEL_OUTPUT; a
+	hang inside an output interrupt still resets the board but leaves no record.
+
+*************************************************************************************************/
+
+#ifndef AUDIO_WATCHDOG_H_INCLUDED
+#define AUDIO_WATCHDOG_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void audio_watchdog_init( void );
+void audio_watchdog_kick( void );
+bool audio_watchdog_report( void );
+
+#endif /* AUDIO_WATCHDOG_H_INCLUDED */
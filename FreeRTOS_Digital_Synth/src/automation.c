@@ -0,0 +1,112 @@
+/*************************************************************************************************
+                                         --AUTOMATION--
+
+	A take is one array sorted by clock. Recording inserts at the current clock after the
+	events already there, so a take started mid-loop still ends up in loop order; an insert
+	shifts at most SYNTH_AUTOMATION_EVENTS entries, at the rate controllers arrive. Playback
+	keeps an index that skips whatever lies before the current clock, which is how it picks
+	up where a take ended.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "automation.h"
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void automation_init( struct automation *automation, uint16_t length )
+{
+	automation->count = 0;
+	automation->dropped = 0;
+	automation->length = length ? length : 1;
+	automation->mode = AUTOMATION_OFF;
+	automation_restart(automation);
+}
+
+void automation_set_mode( struct automation *automation, enum automation_mode mode )
+{
+	//recording replaces the take, from the clock it is at for one loop
+	if(mode >= AUTOMATION_MODE_COUNT) mode = AUTOMATION_OFF;
+	if((mode == AUTOMATION_RECORD) && (automation->mode != AUTOMATION_RECORD))
+	{
+		automation->count = 0;
+		automation->dropped = 0;
+		automation->recorded = 0;
+	}
+	automation->next = 0;
+	automation->mode = (uint8_t) mode;
+}
+
+void automation_restart( struct automation *automation )
+{
+	//the next clock is the first of the loop
+	automation->clock = automation->length - 1;
+	automation->next = 0;
+}
+
+bool automation_record( struct automation *automation, uint8_t channel, uint8_t controller, uint8_t value )
+{
+	//false when not recording or the take is full
+	struct automation_event *events = automation->events;
+	uint16_t clock = automation->clock;
+	int i;
+	int k;
+
+	if(automation->mode != AUTOMATION_RECORD) return false;
+
+	for(i=automation->count; (i > 0) && (events[i - 1].clock > clock); i--);
+
+	//the same controller once more within the clock only moves its value
+	for(k=i - 1; (k >= 0) && (events[k].clock == clock); k--)
+	{
+		if((events[k].channel == channel) && (events[k].controller == controller))
+		{
+			events[k].value = value;
+			return true;
+		}
+	}
+
+	if(automation->count == SYNTH_AUTOMATION_EVENTS)
+	{
+		automation->dropped++;
+		return false;
+	}
+
+	for(k=automation->count; k>i; k--) events[k] = events[k - 1];
+	events[i].clock = clock;
+	events[i].channel = channel;
+	events[i].controller = controller;
+	events[i].value = value;
+	automation->count++;
+	return true;
+}
+
+void automation_clock( struct automation *automation )
+{
+	//one clock on, a take that has gone round once plays from here
+	if(++automation->clock >= automation->length)
+	{
+		automation->clock = 0;
+		automation->next = 0;
+	}
+
+	if((automation->mode == AUTOMATION_RECORD) && (++automation->recorded >= automation->length))
+	{
+		automation->mode = AUTOMATION_PLAY;
+		automation->next = 0;
+	}
+}
+
+bool automation_next( struct automation *automation, struct automation_event *event )
+{
+	//the events due at the current clock, one per call
+	const struct automation_event *events = automation->events;
+
+	if(automation->mode != AUTOMATION_PLAY) return false;
+
+	while((automation->next < automation->count) && (events[automation->next].clock < automation->clock)) automation->next++;
+	if((automation->next == automation->count) || (events[automation->next].clock != automation->clock)) return false;
+
+	*event = events[automation->next++];
+	return true;
+}
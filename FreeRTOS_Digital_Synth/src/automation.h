@@ -0,0 +1,65 @@
+/*************************************************************************************************
+                                         --AUTOMATION--
+
+	Records the motion of the mapped controllers, from MIDI or the panel knobs, as a loop of
+	timed control changes and plays it back on the engine's clock, so a sweep turned once
+	keeps moving with nothing else connected. A take starts when CC 84 goes to record and
+	lasts one loop of SYNTH_AUTOMATION_CLOCKS clocks, 192 being two bars of 4/4; it then
+	plays back, in step with the arpeggiator and the patterns, until CC 84 turns it off or
+	starts a new take over the old one.
+
+	Events are stamped with the clock they arrived after and replayed at it, so a take is
+	quantised to a clock, 1/24 of a beat. A controller moved several times within one clock
+	keeps only its last value there, which holds a fast knob sweep to one event per clock.
+	The take lives in SYNTH_AUTOMATION_EVENTS slots of RAM; once they are full the rest of
+	the take is dropped and counted. Playback goes back through synth_control_change(), so
+	the controller map and the smoothing of the parameters apply as they did when it was
+	played.
+
+	automation_clock() is called once per clock and automation_next() then hands out the
+	events due at it, like arp_clock() and pattern_clock().
+
+*************************************************************************************************/
+
+#ifndef AUTOMATION_H_INCLUDED
+#define AUTOMATION_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/********   TYPE DEFS  **********/
+enum automation_mode{
+	AUTOMATION_OFF,
+	AUTOMATION_PLAY,
+	AUTOMATION_RECORD,
+	AUTOMATION_MODE_COUNT
+};
+
+struct automation_event{
+	uint16_t clock;			//into the loop
+	uint8_t channel;
+	uint8_t controller;
+	uint8_t value;
+};
+
+struct automation{
+	struct automation_event events[SYNTH_AUTOMATION_EVENTS];
+	uint16_t count;			//sorted by clock, in the order they came within one
+	uint16_t next;			//the next one to play
+	uint16_t length;		//clocks in the loop
+	uint16_t clock;			//of the last clock
+	uint16_t recorded;		//clocks the take has run
+	uint16_t dropped;		//events a full take had no room for
+	uint8_t mode;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void automation_init( struct automation *automation, uint16_t length );
+void automation_set_mode( struct automation *automation, enum automation_mode mode );
+void automation_restart( struct automation *automation );
+bool automation_record( struct automation *automation, uint8_t channel, uint8_t controller, uint8_t value );
+void automation_clock( struct automation *automation );
+bool automation_next( struct automation *automation, struct automation_event *event );
+
+#endif /* AUTOMATION_H_INCLUDED */
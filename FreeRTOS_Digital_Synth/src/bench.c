@@ -0,0 +1,318 @@
+/*************************************************************************************************
+                                         --BENCHMARK--
+
+	The oscillator figures come from whole blocks with every voice slot sounding one
+	waveform, less the same blocks with no voices; what is left is the oscillator, its gain
+	ramp and the envelope tick of each voice. The mixer figure is that empty block: control
+	tick, mix clear and master gain with the filter off. Filter and envelope are timed on
+	their own, and so is the step to DAC codes in C and in assembly or with SSAT, whichever the
+	part builds.
+
+	The flash figures render the saw voices once per NVM read mode with the cache on and
+	off, whole blocks this time; the tables are read from flash, whatever runs from SRAM.
+	The controller is put back as flash_setup() left it.
+
+	The replay figures are the recorder's take through the whole engine from the default
+	patch, each block timed on its own with the events due in it queued for their samples
+	first, then blocks until the last voice has released. Decoding the take is left out of
+	the times. The checksum is a hash of every frame rendered: two builds that render the
+	take alike give the same one, whatever their timing.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include "bench.h"
+#include "synth_engine.h"
+#include "cycle_counter.h"
+#include "recorder.h"
+#include "dac_codes.h"
+
+
+/**********  DEFINE  ************/
+#define BENCH_SAMPLES		(	BENCH_BLOCKS * SYNTH_BLOCK_SIZE	)
+
+//sustain at full level, so the voices never go quiet and skip their loop
+#define BENCH_NOTE			(	60	)
+#define BENCH_VELOCITY		(	127	)
+
+//DRUM voices only play the kit: kick, snare, crash and ride, then the toms, all of them
+//ringing for longer than the figure takes
+#define BENCH_DRUMS			(	8	)
+
+#define BENCH_REPLAY_BATCH	(	8	)
+#define BENCH_TAIL_SECONDS	(	10	)	//of release after the take's last event, at most
+#define BENCH_HASH_BASIS	(	2166136261u	)	//FNV-1a
+#define BENCH_HASH_PRIME	(	16777619u	)
+
+
+/*******   GLOBAL VARS  *********/
+static uint16_t bench_frame[SYNTH_FRAME_WORDS];
+static int32_t bench_buffer[SYNTH_CONTROL_PERIOD];
+
+static const char *const wave_names[WAVE_TYPE_COUNT] = { "square", "saw", "tri", "square blep", "saw blep", "fm", "sine", "noise", "sample", "stream", "pluck", "organ", "sync", "ring", "supersaw", "morph", "drum", "grain" };
+static const uint8_t bench_drums[BENCH_DRUMS] = { 36, 38, 49, 51, 41, 45, 48, 50 };
+static const char *const readmode_names[4] = { "no miss penalty", "low power", "deterministic", "reserved" };
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void bench_setup( int voices, enum wave_type wave, uint8_t filter_mode )
+{
+	int j;
+
+	synth_init();
+	synth_set_envelope(0, 0, 100, 0);
+	synth_set_filter(filter_mode, SYNTH_FILTER_CUTOFF_HZ, SYNTH_FILTER_RESONANCE);
+	synth_program_change(0, (uint8_t) wave);
+
+	for(j=0; j<voices; j++) synth_note_on(0, (wave == DRUM) ? bench_drums[j % BENCH_DRUMS] : (uint8_t) (BENCH_NOTE + 4 * j), BENCH_VELOCITY);
+
+	//one block to get through the attack
+	synth_render_block(bench_frame);
+}
+
+static uint32_t bench_blocks( void )
+{
+	//cycles for BENCH_BLOCKS blocks with nothing else running
+	irqflags_t flags;
+	uint32_t start;
+	uint32_t cycles;
+	int n;
+
+	flags = cpu_irq_save();
+	start = cycle_counter_read();
+	for(n=0; n<BENCH_BLOCKS; n++) synth_render_block(bench_frame);
+	cycles = cycle_counter_read() - start;
+	cpu_irq_restore(flags);
+
+	return cycles;
+}
+
+static uint32_t bench_filter( void )
+{
+	struct svf filter;
+	irqflags_t flags;
+	uint32_t start;
+	uint32_t cycles;
+	int n;
+	int i;
+
+	svf_init(&filter);
+	filter.mode = SVF_LOWPASS;
+	svf_set_cutoff(&filter, note_phase_increment(BENCH_NOTE));
+	svf_set_resonance(&filter, 64);
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++) bench_buffer[i] = (i & 1) ? 1000 : -1000;
+
+	flags = cpu_irq_save();
+	start = cycle_counter_read();
+	for(n=0; n<BENCH_SAMPLES / SYNTH_CONTROL_PERIOD; n++) svf_process(&filter, bench_buffer, SYNTH_CONTROL_PERIOD);
+	cycles = cycle_counter_read() - start;
+	cpu_irq_restore(flags);
+
+	return cycles;
+}
+
+static uint32_t bench_envelope( void )
+{
+	//one envelope tick per voice every control period, cycling through the stages
+	struct env_params params;
+	irqflags_t flags;
+	uint32_t start;
+	uint32_t cycles;
+	uint8_t stage = ENV_ATTACK;
+	int32_t level = 0;
+	int n;
+
+	params.attack_rate = env_rate_from_ms(10, synth_sample_rate());
+	params.decay_rate = env_rate_from_ms(10, synth_sample_rate());
+	params.sustain_level = ENV_FULL / 2;
+	params.release_rate = env_rate_from_ms(10, synth_sample_rate());
+
+	flags = cpu_irq_save();
+	start = cycle_counter_read();
+	for(n=0; n<BENCH_SAMPLES / SYNTH_CONTROL_PERIOD; n++)
+	{
+		level = env_advance(&stage, level, &params);
+		if(stage == ENV_SUSTAIN) stage = ENV_RELEASE;
+		else if(stage == ENV_IDLE) stage = ENV_ATTACK;
+	}
+	cycles = cycle_counter_read() - start;
+	cpu_irq_restore(flags);
+
+	return cycles;
+}
+
+static uint32_t bench_codes( void (*codes)( const int32_t *mix, uint16_t *out, int stride, int count ) )
+{
+	//a period of the mix to DAC codes, a quarter of the samples clamped either way
+	irqflags_t flags;
+	uint32_t start;
+	uint32_t cycles;
+	int n;
+	int i;
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++) bench_buffer[i] = ((i & 3) == 0) ? 5000 : (((i & 3) == 1) ? -5000 : i * 100 - 800);
+
+	flags = cpu_irq_save();
+	start = cycle_counter_read();
+	for(n=0; n<BENCH_SAMPLES / SYNTH_CONTROL_PERIOD; n++) codes(bench_buffer, bench_frame, SYNTH_OUTPUT_CHANNELS, SYNTH_CONTROL_PERIOD);
+	cycles = cycle_counter_read() - start;
+	cpu_irq_restore(flags);
+
+	return cycles;
+}
+
+static void bench_flash( void )
+{
+	uint32_t ctrlb = NVMCTRL->CTRLB.reg;
+	uint32_t cycles;
+	uint32_t per_sample;
+	int mode;
+	int cache;
+
+	for(mode=0; mode<3; mode++)
+	{
+		for(cache=1; cache>=0; cache--)
+		{
+			NVMCTRL->CTRLB.reg = (ctrlb & ~(NVMCTRL_CTRLB_READMODE_Msk | NVMCTRL_CTRLB_CACHEDIS)) |
+				NVMCTRL_CTRLB_READMODE(mode) | (cache ? 0 : NVMCTRL_CTRLB_CACHEDIS);
+
+			bench_setup(SYNTH_MAX_VOICES, SAW, SVF_OFF);
+			cycles = bench_blocks();
+			per_sample = (cycles * 100u) / BENCH_SAMPLES;
+
+			printf("flash %-15s cache %-3s %5lu.%02lu cyc/sample\r\n", readmode_names[mode], cache ? "on" : "off",
+				(unsigned long) (per_sample / 100), (unsigned long) (per_sample % 100));
+		}
+	}
+
+	NVMCTRL->CTRLB.reg = ctrlb;
+}
+
+#if SYNTH_RECORDER
+static void bench_replay( void )
+{
+	struct midi_event events[BENCH_REPLAY_BATCH];
+	uint32_t times[BENCH_REPLAY_BATCH];
+	uint32_t budget = (system_cpu_clock_get_hz() / synth_sample_rate()) * SYNTH_BLOCK_SIZE;
+	uint32_t tail = (synth_sample_rate() * BENCH_TAIL_SECONDS) / SYNTH_BLOCK_SIZE;
+	uint32_t hash = BENCH_HASH_BASIS;
+	uint64_t total = 0;
+	uint32_t peak = 0;
+	uint32_t peak_block = 0;
+	uint32_t blocks = 0;
+	uint32_t voice_sum = 0;
+	uint32_t dropped = 0;
+	uint32_t start;
+	uint32_t cycles;
+	irqflags_t flags;
+	int voices_peak = 0;
+	int count;
+	int i;
+
+	recorder_init();
+	synth_init();
+	if(recorder_replay_start() == false)
+	{
+		printf("replay: no take recorded\r\n");
+		return;
+	}
+
+	while(recorder_replaying() || ((tail > 0) && (synth_voice_count() > 0)))
+	{
+		if(recorder_replaying() == false) tail--;
+
+		//the events due by the end of this block
+		do
+		{
+			count = recorder_replay(synth_render_time() + SYNTH_BLOCK_SIZE - 1, events, times, BENCH_REPLAY_BATCH);
+			for(i=0; i<count; i++) if(synth_post_event_at(&events[i], times[i]) == false) dropped++;
+		} while(count == BENCH_REPLAY_BATCH);
+
+		flags = cpu_irq_save();
+		start = cycle_counter_read();
+		synth_render_block(bench_frame);
+		cycles = cycle_counter_read() - start;
+		cpu_irq_restore(flags);
+
+		total += cycles;
+		if(cycles > peak)
+		{
+			peak = cycles;
+			peak_block = blocks;
+		}
+		voice_sum += (uint32_t) synth_voice_count();
+		if(synth_voice_count() > voices_peak) voices_peak = synth_voice_count();
+		for(i=0; i<SYNTH_FRAME_WORDS; i++) hash = (hash ^ bench_frame[i]) * BENCH_HASH_PRIME;
+		blocks++;
+	}
+	if(blocks == 0) return;
+
+	printf("replay: %lu events, %lu blocks, %lu dropped\r\n", (unsigned long) recorder_take_events(), (unsigned long) blocks,
+		(unsigned long) dropped);
+	printf("replay: %lu cycles, avg %lu per block, peak %lu at block %lu, %lu per mille of the budget\r\n",
+		(unsigned long) total, (unsigned long) (total / blocks), (unsigned long) peak, (unsigned long) peak_block,
+		(unsigned long) (((uint64_t) peak * 1000) / budget));
+	printf("replay: voices avg %lu.%02lu, peak %d; checksum %08lx\r\n", (unsigned long) (voice_sum / blocks),
+		(unsigned long) (((voice_sum % blocks) * 100) / blocks), voices_peak, (unsigned long) hash);
+}
+#endif
+
+static void bench_print( const char *name, uint32_t cycles, int voices )
+{
+	//cycles per sample with two decimals, integer only
+	uint32_t per_sample = (cycles * 100u) / BENCH_SAMPLES;
+
+	printf("%-12s %5lu.%02lu cyc/sample", name, (unsigned long) (per_sample / 100), (unsigned long) (per_sample % 100));
+	if(voices > 1)
+	{
+		per_sample /= voices;
+		printf("  %5lu.%02lu cyc/sample/voice", (unsigned long) (per_sample / 100), (unsigned long) (per_sample % 100));
+	}
+	printf("\r\n");
+}
+
+void bench_run( void )
+{
+	uint32_t budget = system_cpu_clock_get_hz() / synth_sample_rate();
+	uint32_t baseline;
+	uint32_t cycles;
+	int wave;
+
+	cycle_counter_init();
+
+	printf("bench: %lu Hz CPU, %lu flash wait states, %s read mode, cache %s, %lu Hz audio (%lu cyc/sample budget)\r\n",
+		(unsigned long) system_cpu_clock_get_hz(), (unsigned long) NVMCTRL->CTRLB.bit.RWS,
+		readmode_names[NVMCTRL->CTRLB.bit.READMODE & 3], NVMCTRL->CTRLB.bit.CACHEDIS ? "off" : "on",
+		(unsigned long) synth_sample_rate(), (unsigned long) budget);
+	printf("bench: %d samples per kernel, %d voices, block %d, control period %d\r\n",
+		BENCH_SAMPLES, SYNTH_MAX_VOICES, SYNTH_BLOCK_SIZE, SYNTH_CONTROL_PERIOD);
+
+	bench_setup(0, SQUARE, SVF_OFF);
+	baseline = bench_blocks();
+	bench_print("mixer", baseline, 1);
+
+	for(wave=SQUARE; wave<WAVE_TYPE_COUNT; wave++)
+	{
+		bench_setup(SYNTH_MAX_VOICES, (enum wave_type) wave, SVF_OFF);
+		cycles = bench_blocks();
+		bench_print(wave_names[wave], (cycles > baseline) ? cycles - baseline : 0, SYNTH_MAX_VOICES);
+	}
+
+	bench_print("filter", bench_filter(), 1);
+	bench_print("envelope", bench_envelope(), 1);
+	bench_print("codes C", bench_codes(dac_codes_c), 1);
+#if SYNTH_MIX_ASM
+	bench_print("codes asm", bench_codes(dac_codes_m0), 1);
+#endif
+#if SYNTH_MIX_SSAT
+	bench_print("codes ssat", bench_codes(dac_codes_ssat), 1);
+#endif
+	bench_flash();
+#if SYNTH_RECORDER
+	bench_replay();
+#endif
+
+	printf("bench: done\r\n");
+}
@@ -0,0 +1,28 @@
+/*************************************************************************************************
+                                         --BENCHMARK--
+
+	On-target timing of the render kernels, built instead of the synth when SYNTH_BENCHMARK
+	is set. Every kernel runs for BENCH_BLOCKS blocks with interrupts off and is timed with
+	the TC4/TC5 cycle counter, so the figures include the real flash wait states. Results go
+	to the EDBG console as cycles per sample and cycles per sample per voice.
+
+	With SYNTH_RECORDER, the recorder's last take then renders block after block with no
+	regard for real time, for the end-to-end figures to track from release to release:
+	total and peak block cycles, voice counts and a checksum of the output.
+
+*************************************************************************************************/
+
+#ifndef BENCH_H_INCLUDED
+#define BENCH_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//blocks rendered per measurement
+#define BENCH_BLOCKS		(	64	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void bench_run( void );
+
+#endif /* BENCH_H_INCLUDED */
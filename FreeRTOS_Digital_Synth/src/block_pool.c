@@ -0,0 +1,74 @@
+/*************************************************************************************************
+                                         --BLOCK POOL--
+
+	The free list is a stack, the block given back last goes out first. A pool initialized
+	again, when its owner starts over, takes all its blocks back and keeps its place in the
+	list rather than joining it twice.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "block_pool.h"
+
+
+/*******   GLOBAL VARS  *********/
+static struct block_pool *pools;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void block_pool_init( struct block_pool *pool, const char *name, void *storage, uint32_t size, uint16_t blocks )
+{
+	//'storage' holds 'blocks' blocks of 'size' bytes, a multiple of the pointer size
+	uint8_t *block = (uint8_t *) storage + (uint32_t) blocks * size;
+	struct block_pool *p;
+
+	pool->free = NULL;
+	while(block != (uint8_t *) storage)
+	{
+		block -= size;
+		*(void **) block = pool->free;
+		pool->free = block;
+	}
+
+	pool->name = name;
+	pool->size = size;
+	pool->blocks = blocks;
+	pool->used = 0;
+	pool->high_water = 0;
+	pool->misses = 0;
+
+	for(p=pools; p!=NULL; p=p->next) if(p == pool) return;
+	pool->next = pools;
+	pools = pool;
+}
+
+void *block_pool_get( struct block_pool *pool )
+{
+	//NULL with every block out
+	void *block = pool->free;
+
+	if(block == NULL)
+	{
+		pool->misses++;
+		return NULL;
+	}
+
+	pool->free = *(void **) block;
+	pool->used++;
+	if(pool->used > pool->high_water) pool->high_water = pool->used;
+	return block;
+}
+
+void block_pool_put( struct block_pool *pool, void *block )
+{
+	*(void **) block = pool->free;
+	pool->free = block;
+	pool->used--;
+}
+
+const struct block_pool *block_pool_first( void )
+{
+	//the rest follow through ->next
+	return pools;
+}
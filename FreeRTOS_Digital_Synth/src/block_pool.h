@@ -0,0 +1,44 @@
+/*************************************************************************************************
+                                         --BLOCK POOL--
+
+	Fixed-size block allocator for buffers that come and go at run time, like the PLUCK
+	voices' delay lines. The owner hands over the storage, a static array of its blocks,
+	and the pool threads its free list through the free blocks themselves: taking and
+	giving back a block is a pointer swap either way, no search, no fragmentation, and no
+	trip to the FreeRTOS heap, which only ever hands out and never takes back.
+
+	Each pool counts the blocks out now, the most ever out at once, and the requests that
+	found it empty; block_pool_first() walks every pool initialized, for the console's
+	stats. A high water mark well under the count is RAM to give back, misses are where
+	the owner had to make do.
+
+	A pool belongs to one task, or to code that already runs under a critical section;
+	nothing here locks. Blocks are at least a pointer in size and keep the storage's
+	alignment, so a block of a struct or of 32-bit words is aligned like one.
+
+*************************************************************************************************/
+
+#ifndef BLOCK_POOL_H_INCLUDED
+#define BLOCK_POOL_H_INCLUDED
+
+#include <stdint.h>
+
+/********   TYPE DEFS  **********/
+struct block_pool{
+	void *free;					//first free block, each holds the next
+	const char *name;
+	struct block_pool *next;	//in the list of every pool
+	uint32_t size;				//bytes a block
+	uint16_t blocks;
+	uint16_t used;
+	uint16_t high_water;
+	uint16_t misses;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void block_pool_init( struct block_pool *pool, const char *name, void *storage, uint32_t size, uint16_t blocks );
+void *block_pool_get( struct block_pool *pool );
+void block_pool_put( struct block_pool *pool, void *block );
+const struct block_pool *block_pool_first( void );
+
+#endif /* BLOCK_POOL_H_INCLUDED */
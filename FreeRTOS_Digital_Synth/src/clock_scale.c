@@ -0,0 +1,107 @@
+/*************************************************************************************************
+                                        --CLOCK SCALING--
+
+	Going down needs a quiet patch and room to spare: few enough voices, and the load times
+	the clock ratio under SYNTH_CLOCK_SCALE_DOWN for SYNTH_CLOCK_SCALE_HOLD blocks in a row, so
+	a held chord's release does not bounce the clock. Going up is immediate, before a block
+	with any events waiting (a note-on would otherwise render its first block at 8 MHz), or
+	after a slow block over SYNTH_CLOCK_SCALE_UP or with more voices sounding.
+
+	The switch itself is one GENCTRL write, SysTick is reloaded for the new tick length in
+	the same critical section. Flash keeps the wait states set for 48 MHz.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "clock_scale.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "synth_engine.h"
+#include "tickless_idle.h"
+
+
+/*******   GLOBAL VARS  *********/
+static bool clock_slow;
+static uint16_t clock_calm;
+
+//fast over slow clock, for the load a block would have at 8 MHz
+static uint32_t clock_ratio;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void clock_scale_set( bool slow );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void clock_scale_init( void )
+{
+	//generator 4 at the DFLL rate for the peripherals that must not slow down, called once
+	//the DFLL runs and before any of them is set up
+	struct system_gclk_gen_config gclock_gen_conf;
+	uint32_t slow_hz;
+
+	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
+	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_DFLL;
+	gclock_gen_conf.division_factor = 1;
+	system_gclk_gen_set_config(SYNTH_FIXED_GCLK, &gclock_gen_conf);
+	system_gclk_gen_enable(SYNTH_FIXED_GCLK);
+
+	slow_hz = system_clock_source_get_hz(SYSTEM_CLOCK_SOURCE_OSC8M);
+	clock_ratio = (system_gclk_gen_get_hz(SYNTH_FIXED_GCLK) + slow_hz / 2) / slow_hz;
+	clock_slow = false;
+	clock_calm = 0;
+}
+
+bool clock_scale_before( void )
+{
+	if(!clock_slow || !synth_events_pending()) return false;
+
+	clock_scale_set(false);
+	return true;
+}
+
+bool clock_scale_after( uint16_t load )
+{
+	bool quiet = synth_voice_count() <= SYNTH_CLOCK_SCALE_VOICES;
+
+	if(clock_slow)
+	{
+		if(quiet && (load <= SYNTH_CLOCK_SCALE_UP)) return false;
+
+		clock_scale_set(false);
+		return true;
+	}
+
+	if(!quiet || ((uint32_t) load * clock_ratio >= SYNTH_CLOCK_SCALE_DOWN))
+	{
+		clock_calm = 0;
+		return false;
+	}
+
+	if(++clock_calm < SYNTH_CLOCK_SCALE_HOLD) return false;
+
+	clock_scale_set(true);
+	return true;
+}
+
+bool clock_scale_slow( void )
+{
+	return clock_slow;
+}
+
+static void clock_scale_set( bool slow )
+{
+	struct system_gclk_gen_config gclock_gen_conf;
+
+	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
+	gclock_gen_conf.source_clock = slow ? SYSTEM_CLOCK_SOURCE_OSC8M : SYSTEM_CLOCK_SOURCE_DFLL;
+	gclock_gen_conf.division_factor = 1;
+
+	taskENTER_CRITICAL();
+	system_gclk_gen_set_config(GCLK_GENERATOR_0, &gclock_gen_conf);
+	tickless_idle_set_clock(system_cpu_clock_get_hz());
+	taskEXIT_CRITICAL();
+
+	clock_slow = slow;
+	clock_calm = 0;
+}
@@ -0,0 +1,27 @@
+/*************************************************************************************************
+                                        --CLOCK SCALING--
+
+	Runs the CPU from OSC8M instead of the 48 MHz DFLL while the synth has little to do.
+	Only GCLK generator 0 switches; the DFLL keeps running for generator 4 (SYNTH_FIXED_GCLK),
+	which clocks the SPI ports, the DAC and the run-time stats, and the TC3 sample clock and
+	the UARTs are on OSC8M throughout, so none of them see the change.
+
+	The render task calls clock_scale_before() ahead of each block and clock_scale_after()
+	with the block's load; both switch only there, between blocks. Either returns true when
+	the clock changed, the caller then re-derives whatever it keeps in CPU cycles.
+
+*************************************************************************************************/
+
+#ifndef CLOCK_SCALE_H_INCLUDED
+#define CLOCK_SCALE_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void clock_scale_init( void );
+bool clock_scale_before( void );
+bool clock_scale_after( uint16_t load );
+bool clock_scale_slow( void );
+
+#endif /* CLOCK_SCALE_H_INCLUDED */
@@ -0,0 +1,82 @@
+/*************************************************************************************************
+                                        --PART PROFILES--
+
+	What the engine's defaults scale with, one profile per SAM0 family, picked from the
+	device macro the project defines (__SAMD21J18A__ for the Xplained Pro). conf_synth.h
+	takes its polyphony, delay line and kernel choices from here, so moving to another part
+	is its device macro and, for main.c, a board bring-up; any option can still be set
+	outright with -D.
+
+		SAMD21, SAMC21, SAML21	Cortex-M0+ at 48 MHz, 32 KB SRAM: no divider, no SSAT, no FPU
+		SAMD51, SAME5x			Cortex-M4F at 120 MHz, 128 to 256 KB SRAM: hardware divide,
+								SSAT and the DSP extension, single precision FPU
+
+	The core's features come from the compiler (the ACLE __ARM_FEATURE_ macros and __ARM_FP),
+	not from the part, so they follow -mcpu; a host build has none of them and takes the
+	profile of the part it names, the SAMD21 when it names none.
+
+	SYNTH_PART_BOARD says whether main.c has the clock, DMAC and TC set-up for the family;
+	the engine sources build for any of them.
+
+*************************************************************************************************/
+
+#ifndef CONF_PART_H_INCLUDED
+#define CONF_PART_H_INCLUDED
+
+#if defined(__SAMD51G18A__) || defined(__SAMD51G19A__) || defined(__SAMD51J18A__) || defined(__SAMD51J19A__) || \
+	defined(__SAMD51J20A__) || defined(__SAMD51N19A__) || defined(__SAMD51N20A__) || defined(__SAMD51P19A__) || \
+	defined(__SAMD51P20A__) || defined(__SAME51J18A__) || defined(__SAME51J19A__) || defined(__SAME51J20A__) || \
+	defined(__SAME51N19A__) || defined(__SAME51N20A__) || defined(__SAME53J18A__) || defined(__SAME53J19A__) || \
+	defined(__SAME53J20A__) || defined(__SAME53N19A__) || defined(__SAME53N20A__) || defined(__SAME54N19A__) || \
+	defined(__SAME54N20A__) || defined(__SAME54P19A__) || defined(__SAME54P20A__)
+#  define SYNTH_PART_NAME			"SAMD51"
+#  define SYNTH_PART_VOICES			(	16	)
+#  define SYNTH_PART_DELAY_SAMPLES	(	16384	)
+#  define SYNTH_PART_REVERB_SAMPLES	(	8192	)
+#  define SYNTH_PART_GRAINS			(	32	)
+#  define SYNTH_PART_BOARD			0
+#elif defined(__SAMC21E18A__) || defined(__SAMC21G18A__) || defined(__SAMC21J18A__)
+#  define SYNTH_PART_NAME			"SAMC21"
+#  define SYNTH_PART_VOICES			(	4	)
+#  define SYNTH_PART_DELAY_SAMPLES	(	4096	)
+#  define SYNTH_PART_REVERB_SAMPLES	(	1280	)
+#  define SYNTH_PART_GRAINS			(	12	)
+#  define SYNTH_PART_BOARD			1
+#elif defined(__SAML21E18B__) || defined(__SAML21G18B__) || defined(__SAML21J18B__)
+#  define SYNTH_PART_NAME			"SAML21"
+#  define SYNTH_PART_VOICES			(	4	)
+#  define SYNTH_PART_DELAY_SAMPLES	(	4096	)
+#  define SYNTH_PART_REVERB_SAMPLES	(	1280	)
+#  define SYNTH_PART_GRAINS			(	12	)
+#  define SYNTH_PART_BOARD			1
+#else
+#  define SYNTH_PART_NAME			"SAMD21"
+#  define SYNTH_PART_VOICES			(	4	)
+#  define SYNTH_PART_DELAY_SAMPLES	(	4096	)
+#  define SYNTH_PART_REVERB_SAMPLES	(	1280	)
+#  define SYNTH_PART_GRAINS			(	12	)
+#  define SYNTH_PART_BOARD			1
+#endif
+
+//a UDIV/SDIV instruction: '/' is a couple of cycles rather than a libgcc loop
+#if defined(__ARM_FEATURE_IDIV) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#  define SYNTH_PART_DIVIDE			1
+#else
+#  define SYNTH_PART_DIVIDE			0
+#endif
+
+//SSAT and the packed 16-bit DSP instructions
+#if defined(__ARM_FEATURE_SAT) && defined(__ARM_FEATURE_DSP)
+#  define SYNTH_PART_DSP			1
+#else
+#  define SYNTH_PART_DSP			0
+#endif
+
+//a single precision FPU in use, hard or softfp ABI
+#if defined(__ARM_FP) && (__ARM_FP & 4)
+#  define SYNTH_PART_FPU			1
+#else
+#  define SYNTH_PART_FPU			0
+#endif
+
+#endif /* CONF_PART_H_INCLUDED */
@@ -0,0 +1,1409 @@
+/*************************************************************************************************
+                                     --SYNTH CONFIGURATION--
+
+	Compile-time options for the synthesis engine and the audio output pipeline.
+
+*************************************************************************************************/
+
+#ifndef CONF_SYNTH_H_INCLUDED
+#define CONF_SYNTH_H_INCLUDED
+
+#include "conf_part.h"
+
+//output sample rate at start-up, paced by the TC3 sample clock; the console can switch it
+//at run time within SYNTH_SAMPLE_RATE_MIN..SYNTH_SAMPLE_RATE_MAX
+#ifndef SYNTH_SAMPLE_RATE
+#  define SYNTH_SAMPLE_RATE			(	20000	)
+#endif
+
+#define SYNTH_SAMPLE_RATE_MIN		(	8000	)
+#define SYNTH_SAMPLE_RATE_MAX		(	48000	)
+
+//output latency profile, picks the block size and frame counts below unless they are set
+//explicitly: low 3 x 16 samples (2.4 ms), normal 4 x 32 (6.4 ms), safe 3 x 64 (9.6 ms)
+#define SYNTH_LATENCY_LOW			0
+#define SYNTH_LATENCY_NORMAL		1
+#define SYNTH_LATENCY_SAFE			2
+
+#ifndef SYNTH_LATENCY_PROFILE
+#  define SYNTH_LATENCY_PROFILE		SYNTH_LATENCY_NORMAL
+#endif
+
+#if (SYNTH_LATENCY_PROFILE == SYNTH_LATENCY_LOW)
+#  define SYNTH_PROFILE_BLOCK		(	16	)
+#  define SYNTH_PROFILE_FRAMES		(	3	)
+#elif (SYNTH_LATENCY_PROFILE == SYNTH_LATENCY_SAFE)
+#  define SYNTH_PROFILE_BLOCK		(	64	)
+#  define SYNTH_PROFILE_FRAMES		(	3	)
+#else
+#  define SYNTH_PROFILE_BLOCK		(	32	)
+#  define SYNTH_PROFILE_FRAMES		(	4	)
+#endif
+
+//number of samples rendered per call of the block renderer
+#ifndef SYNTH_BLOCK_SIZE
+#  define SYNTH_BLOCK_SIZE			SYNTH_PROFILE_BLOCK
+#endif
+
+//samples per control tick (events, envelopes, smoothing), must divide SYNTH_BLOCK_SIZE
+#ifndef SYNTH_CONTROL_PERIOD
+#  define SYNTH_CONTROL_PERIOD		(	16	)
+#endif
+
+//MIDI events buffered between the event task and the control tick, power of two
+#ifndef SYNTH_EVENT_QUEUE_SIZE
+#  define SYNTH_EVENT_QUEUE_SIZE	(	32	)
+#endif
+
+//MIDI realtime bytes the RX interrupt may queue ahead of the renderer, a block's worth of
+//clocks at any sane tempo
+#ifndef SYNTH_REALTIME_QUEUE_SIZE
+#  define SYNTH_REALTIME_QUEUE_SIZE	(	16	)
+#endif
+
+//Note Ons from the MIDI UART's RX interrupt straight to the renderer, which starts them at its
+//next control tick instead of one output latency after they arrived: at most a block late,
+//not sample-accurate. For percussion; needs an interrupt per byte, SYNTH_MIDI_RX_DMA 0
+#ifndef SYNTH_FAST_NOTE_ON
+#  define SYNTH_FAST_NOTE_ON		0
+#endif
+
+//Note Ons the RX interrupt may queue ahead of the renderer, power of two
+#ifndef SYNTH_FAST_NOTE_QUEUE_SIZE
+#  define SYNTH_FAST_NOTE_QUEUE_SIZE	(	8	)
+#endif
+
+//stereo output on an MCP4822, left on DAC A and right on DAC B, each voice panned by its
+//channel's CC 10; frames interleave left and right, so they hold SYNTH_FRAME_WORDS words
+#ifndef SYNTH_STEREO
+#  define SYNTH_STEREO				0
+#endif
+
+#if SYNTH_STEREO
+#  define SYNTH_OUTPUT_CHANNELS		(	2	)
+#else
+#  define SYNTH_OUTPUT_CHANNELS		(	1	)
+#endif
+
+#define SYNTH_FRAME_WORDS			(	SYNTH_BLOCK_SIZE * SYNTH_OUTPUT_CHANNELS	)
+
+//frames allocated for the output pipeline, the most that can be in flight
+#ifndef SYNTH_OUTPUT_FRAMES
+#  define SYNTH_OUTPUT_FRAMES		(	SYNTH_PROFILE_FRAMES + 2	)
+#endif
+
+//frames in flight at start-up, the console can change it at run time; latency is this many blocks
+#ifndef SYNTH_OUTPUT_FRAMES_ACTIVE
+#  define SYNTH_OUTPUT_FRAMES_ACTIVE	SYNTH_PROFILE_FRAMES
+#endif
+
+//NVIC levels, from 0, the most urgent, to 3, which FreeRTOS keeps for SysTick and PendSV: the
+//output's DMA and sample clock interrupts, the MIDI inputs' and the EDBG console's; main.c sets
+//them all before the scheduler starts and checks them, see its priority plan
+#ifndef SYNTH_IRQ_LEVEL_OUTPUT
+#  define SYNTH_IRQ_LEVEL_OUTPUT	(	0	)
+#endif
+
+#ifndef SYNTH_IRQ_LEVEL_INPUT
+#  define SYNTH_IRQ_LEVEL_INPUT		(	1	)
+#endif
+
+#ifndef SYNTH_IRQ_LEVEL_CONSOLE
+#  define SYNTH_IRQ_LEVEL_CONSOLE	(	2	)
+#endif
+
+//number of voice slots in the engine, 4 on the M0+ parts and 16 on the M4F ones
+#ifndef SYNTH_MAX_VOICES
+#  define SYNTH_MAX_VOICES			SYNTH_PART_VOICES
+#endif
+
+//master gain applied to the voice mix, Q8 (256 = unity), 0..SYNTH_MASTER_GAIN_MAX
+//default leaves room for half the voices at full level before the mixer saturates
+#ifndef SYNTH_MASTER_GAIN
+#  define SYNTH_MASTER_GAIN			(	512 / SYNTH_MAX_VOICES	)
+#endif
+
+#define SYNTH_MASTER_GAIN_MAX		(	1023	)
+
+//CC map slots beyond the one full-range slot each parameter has, for mappings scaled to a
+//narrower or inverted range
+#ifndef SYNTH_CC_SCALED_SLOTS
+#  define SYNTH_CC_SCALED_SLOTS		(	16	)
+#endif
+
+//controller driven levels (master gain, channel volume, pulse width, cutoff) close 1/2^n of the
+//way to a new setting per control tick, so a knob sweep ramps instead of stepping
+#ifndef SYNTH_SMOOTH_SHIFT
+#  define SYNTH_SMOOTH_SHIFT		(	3	)
+#endif
+
+//requantization of the mix to DAC codes after the master gain: plain truncation, TPDF dither,
+//or TPDF dither with first-order noise shaping, which moves the noise floor up towards fs/2
+#define SYNTH_DITHER_OFF			0
+#define SYNTH_DITHER_TPDF			1
+#define SYNTH_DITHER_SHAPED			2
+
+#ifndef SYNTH_DITHER
+#  define SYNTH_DITHER				SYNTH_DITHER_OFF
+#endif
+
+//build the band-limited wavetables into flash (12 KB); without them square and saw fall
+//back to the PolyBLEP oscillators and triangle to the naive shape
+#ifndef SYNTH_WAVETABLES
+#  define SYNTH_WAVETABLES			1
+#endif
+
+//oscillator quality levels: truncated table reads and naive steps, PolyBLEP corrected steps
+//on SQUARE_BLEP and SAW_BLEP, and linear interpolation between wavetable and sine entries on
+//top of that; each level costs a few cycles per sample more than the one before. The last
+//renders SQUARE_BLEP, SAW_BLEP and SYNC at twice the sample rate through a half-band
+//decimator, about twice their cost plus the decimator's once for all such voices
+#define SYNTH_OSC_TRUNCATE			0
+#define SYNTH_OSC_BANDLIMITED		1
+#define SYNTH_OSC_INTERPOLATED		2
+#define SYNTH_OSC_OVERSAMPLED		3
+
+//highest level built in, the render kernels above it are left out of flash, and the level
+//every channel starts at; synth_set_osc_quality() and CC 19 change it per channel. FM and
+//the LFOs always read the table directly. SYNTH_OSC_OVERSAMPLED also takes half a KB of SRAM
+//for the decimator at the default control period and is left out unless asked for
+#ifndef SYNTH_OSC_QUALITY_MAX
+#  define SYNTH_OSC_QUALITY_MAX		SYNTH_OSC_INTERPOLATED
+#endif
+
+#ifndef SYNTH_OSC_QUALITY
+#  define SYNTH_OSC_QUALITY			SYNTH_OSC_BANDLIMITED
+#endif
+
+#if SYNTH_OSC_QUALITY > SYNTH_OSC_QUALITY_MAX
+#  error "SYNTH_OSC_QUALITY is above SYNTH_OSC_QUALITY_MAX"
+#endif
+
+#if SYNTH_OSC_QUALITY_MAX > SYNTH_OSC_OVERSAMPLED
+#  error "SYNTH_OSC_QUALITY_MAX is above SYNTH_OSC_OVERSAMPLED"
+#endif
+
+#ifdef SYNTH_SINE_INTERPOLATE
+#  error "SYNTH_SINE_INTERPOLATE is replaced by SYNTH_OSC_QUALITY=SYNTH_OSC_INTERPOLATED"
+#endif
+
+//default amplitude envelope
+#ifndef SYNTH_ENV_ATTACK_MS
+#  define SYNTH_ENV_ATTACK_MS		(	5	)
+#endif
+
+#ifndef SYNTH_ENV_DECAY_MS
+#  define SYNTH_ENV_DECAY_MS		(	200	)
+#endif
+
+#ifndef SYNTH_ENV_SUSTAIN_PERCENT
+#  define SYNTH_ENV_SUSTAIN_PERCENT	(	70	)
+#endif
+
+#ifndef SYNTH_ENV_RELEASE_MS
+#  define SYNTH_ENV_RELEASE_MS		(	200	)
+#endif
+
+//decay and release fall linearly (0), or exponentially (1) with their time to -60 dB
+#ifndef SYNTH_ENV_EXPONENTIAL
+#  define SYNTH_ENV_EXPONENTIAL		0
+#endif
+
+//master filter at start-up: 0 off, 1 lowpass, 2 bandpass, 3 highpass
+#ifndef SYNTH_FILTER_MODE
+#  define SYNTH_FILTER_MODE			(	0	)
+#endif
+
+#ifndef SYNTH_FILTER_CUTOFF_HZ
+#  define SYNTH_FILTER_CUTOFF_HZ	(	2000	)
+#endif
+
+#ifndef SYNTH_FILTER_RESONANCE
+#  define SYNTH_FILTER_RESONANCE	(	0	)
+#endif
+
+//route the block gain/saturation stages through the CMSIS-DSP library (ARM builds only, the
+//host build of the engine always uses the scalar loops)
+#ifndef SYNTH_USE_CMSIS_DSP
+#  if defined(ARM_MATH_CM0PLUS) || defined(ARM_MATH_CM4)
+#    define SYNTH_USE_CMSIS_DSP		1
+#  else
+#    define SYNTH_USE_CMSIS_DSP		0
+#  endif
+#endif
+
+//peak and RMS levels of every output channel, taken in the loop that makes its DAC codes, and
+//of every voice's gain into the mix, taken at each control tick; synth_levels() reads them,
+//telemetry sends them. The metered loop is C, it takes the place of SYNTH_MIX_ASM
+#ifndef SYNTH_METERS
+#  define SYNTH_METERS				1
+#endif
+
+//the output's peak on LED0 (PB30) as PWM from TCC1's WO[2], brightness going with its square
+#ifndef SYNTH_METER_LED
+#  define SYNTH_METER_LED			0
+#endif
+
+//a copy of every voice's state for the console's ':voices', published by the renderer at the
+//end of a block when one was asked for; a flag test per block otherwise
+#ifndef SYNTH_VOICE_SNAPSHOT
+#  define SYNTH_VOICE_SNAPSHOT		1
+#endif
+
+//turn each output channel's mix into DAC codes with the Thumb-1 loop of dac_codes_m0.S rather
+//than the C loop or the CMSIS-DSP passes (M0+ builds only), see dac_codes.h
+#ifndef SYNTH_MIX_ASM
+#  if defined(__GNUC__) && defined(__arm__) && !SYNTH_PART_DSP && !SYNTH_METERS
+#    define SYNTH_MIX_ASM			1
+#  else
+#    define SYNTH_MIX_ASM			0
+#  endif
+#endif
+
+//the same with one SSAT per sample, on the parts that have it
+#ifndef SYNTH_MIX_SSAT
+#  define SYNTH_MIX_SSAT			( SYNTH_PART_DSP && !SYNTH_MIX_ASM && !SYNTH_METERS )
+#endif
+
+//oscillator kernels on packed 16-bit pairs (simd.h): the MORPH crossfade as one SMUAD per
+//sample and the ORGAN drawbars two to an SMLAD. On by default where the DSP extension is; the
+//host build can set it to run the same kernels, C in place of the instructions
+#ifndef SYNTH_OSC_SIMD
+#  define SYNTH_OSC_SIMD			SYNTH_PART_DSP
+#endif
+
+//voice stealing policy once all voice slots are busy
+#define VOICE_STEAL_OLDEST			0
+#define VOICE_STEAL_QUIETEST		1
+
+#ifndef SYNTH_VOICE_STEAL
+#  define SYNTH_VOICE_STEAL			VOICE_STEAL_OLDEST
+#endif
+
+//the voice slots are split evenly into this many groups, MIDI channel c plays on group
+//c % SYNTH_VOICE_GROUPS until synth_route_channel() says otherwise
+#ifndef SYNTH_VOICE_GROUPS
+#  define SYNTH_VOICE_GROUPS		(	1	)
+#endif
+
+//note-on velocity to amplitude curve, 0 linear, 1 exponential (40 dB range)
+#ifndef SYNTH_VELOCITY_CURVE
+#  define SYNTH_VELOCITY_CURVE		(	0	)
+#endif
+
+//user tuning of the voices, from MIDI Tuning Standard SysEx or the shell; 768 bytes of RAM
+#ifndef SYNTH_TUNING
+#  define SYNTH_TUNING				1
+#endif
+
+//pitch bend wheel range in semitones either way
+#ifndef SYNTH_PITCH_BEND_RANGE
+#  define SYNTH_PITCH_BEND_RANGE	(	2	)
+#endif
+
+//MIDI Polyphonic Expression, the lower zone: channel 1 is the master channel and the next
+//SYNTH_MPE_CHANNELS are its member channels, one note each. 0 keeps all 16 channels
+//independent parts
+#ifndef SYNTH_MPE_CHANNELS
+#  define SYNTH_MPE_CHANNELS		(	0	)
+#endif
+
+//per-note pitch bend range of the member channels in semitones, MPE's default; the master
+//channel bends the whole zone by SYNTH_PITCH_BEND_RANGE
+#ifndef SYNTH_MPE_BEND_RANGE
+#  define SYNTH_MPE_BEND_RANGE		(	48	)
+#endif
+
+//pulse width swing of the MPE timbre route (CC 74) from the middle to either end, Q15
+#ifndef SYNTH_MPE_TIMBRE_DEPTH
+#  define SYNTH_MPE_TIMBRE_DEPTH	(	12288	)
+#endif
+
+//aftertouch routes, poly (0xA0) and channel (0xD0) pressure alike: how far no pressure drops
+//the amplitude, Q15, and the master filter cutoff, in 1/256 semitone; 0 sets no route, full
+//pressure leaves both where they were
+#ifndef SYNTH_PRESSURE_AMP_DEPTH
+#  if SYNTH_MPE_CHANNELS
+#    define SYNTH_PRESSURE_AMP_DEPTH	(	24576	)
+#  else
+#    define SYNTH_PRESSURE_AMP_DEPTH	(	0	)
+#  endif
+#endif
+
+#ifndef SYNTH_PRESSURE_CUTOFF_DEPTH
+#  define SYNTH_PRESSURE_CUTOFF_DEPTH	(	0	)
+#endif
+
+//tempo in 1/100 BPM while no MIDI clock comes in, and how long a clock may be missing
+//before the internal one takes over at the last tempo measured
+#ifndef SYNTH_TEMPO
+#  define SYNTH_TEMPO				(	12000	)
+#endif
+
+#ifndef SYNTH_CLOCK_TIMEOUT_MS
+#  define SYNTH_CLOCK_TIMEOUT_MS	(	250	)
+#endif
+
+//arpeggiator: the channel it plays (0 is MIDI channel 1), the keys it holds, its start-up
+//mode (see enum arp_mode, CC 102 sets it), clocks per step (6 is a sixteenth) and octaves
+#ifndef SYNTH_ARP_CHANNEL
+#  define SYNTH_ARP_CHANNEL			(	0	)
+#endif
+
+#ifndef SYNTH_ARP_NOTES
+#  define SYNTH_ARP_NOTES			(	16	)
+#endif
+
+#ifndef SYNTH_ARP_MODE
+#  define SYNTH_ARP_MODE			(	0	)
+#endif
+
+#ifndef SYNTH_ARP_DIVISION
+#  define SYNTH_ARP_DIVISION		(	6	)
+#endif
+
+#ifndef SYNTH_ARP_OCTAVES
+#  define SYNTH_ARP_OCTAVES			(	1	)
+#endif
+
+//flash pattern played from power-up, n is pattern n of patterns.c and 0 none; CC 107 selects
+//one at run time
+#ifndef SYNTH_PATTERN
+#  define SYNTH_PATTERN				(	0	)
+#endif
+
+//controller automation: clocks in the loop (192 is two bars of 4/4) and the control changes
+//a take holds, CC 84 records and plays it, see automation.h
+#ifndef SYNTH_AUTOMATION_CLOCKS
+#  define SYNTH_AUTOMATION_CLOCKS	(	192	)
+#endif
+
+#ifndef SYNTH_AUTOMATION_EVENTS
+#  define SYNTH_AUTOMATION_EVENTS	(	128	)
+#endif
+
+//clocks per LFO1 cycle and per delay repeat when locked to the tempo, 0 runs them free
+#ifndef SYNTH_LFO_SYNC
+#  define SYNTH_LFO_SYNC			(	0	)
+#endif
+
+#ifndef SYNTH_DELAY_SYNC
+#  define SYNTH_DELAY_SYNC			(	0	)
+#endif
+
+//portamento glide time once a channel switches portamento on (CC 65), CC 5 sets it per channel
+#ifndef SYNTH_PORTAMENTO_MS
+#  define SYNTH_PORTAMENTO_MS		(	200	)
+#endif
+
+//NOISE voices hold each value for 1/16 of the note's period instead of a new one every sample,
+//so the noise colour follows the key; CC 77 switches it per channel
+#ifndef SYNTH_NOISE_HOLD
+#  define SYNTH_NOISE_HOLD			0
+#endif
+
+//FM voice defaults, modulator frequency as a multiple of the carrier (1..16) and modulation
+//index in 1/16 radian (0..127), CC 75 and CC 76 set them per channel
+#ifndef SYNTH_FM_RATIO
+#  define SYNTH_FM_RATIO			(	2	)
+#endif
+
+#ifndef SYNTH_FM_INDEX
+#  define SYNTH_FM_INDEX			(	32	)
+#endif
+
+//start-up drawbar registration of the ORGAN voices, one digit 0..8 per drawbar from 16' to 1'
+#ifndef SYNTH_DRAWBARS
+#  define SYNTH_DRAWBARS			(	888000000	)
+#endif
+
+//oscillators of a SUPERSAW voice (2..8) and their start-up detune, 0..127 for up to about a
+//semitone either side on the outer two; CC 30 sets the detune per channel
+#ifndef SYNTH_UNISON
+#  define SYNTH_UNISON				(	5	)
+#endif
+
+#ifndef SYNTH_UNISON_DETUNE
+#  define SYNTH_UNISON_DETUNE		(	40	)
+#endif
+
+//start-up level of the square sub-oscillator under every phase-driven voice, 0..127 with 0 off,
+//one octave down or two with SYNTH_SUB_TWO_OCTAVES; CC 31 and CC 9 set them per channel
+#ifndef SYNTH_SUB_LEVEL
+#  define SYNTH_SUB_LEVEL			(	0	)
+#endif
+
+#ifndef SYNTH_SUB_TWO_OCTAVES
+#  define SYNTH_SUB_TWO_OCTAVES		0
+#endif
+
+//start-up position of the MORPH voices between their tables, 0 triangle, 64 saw, 127 square;
+//CC 85 moves it per channel
+#ifndef SYNTH_MORPH_POSITION
+#  define SYNTH_MORPH_POSITION		(	64	)
+#endif
+
+//control ticks a held voice takes to fade out when a program change gives its channel another
+//waveform, which it switches to in silence and fades back in over as many; 0 leaves sounding
+//voices on the waveform they started with
+#ifndef SYNTH_WAVE_SWAP_TICKS
+#  define SYNTH_WAVE_SWAP_TICKS		(	8	)
+#endif
+
+//post-mix delay with a line of SYNTH_DELAY_FRAMES samples (a power of two) per output channel in
+//SRAM, 8 KB in all by default, 32 KB on the M4F parts; time in samples, feedback and mix 0..127,
+//CC 12, 13 and 91 set them
+#ifndef SYNTH_DELAY
+#  define SYNTH_DELAY				1
+#endif
+
+#ifndef SYNTH_DELAY_FRAMES
+#  define SYNTH_DELAY_FRAMES		(	SYNTH_PART_DELAY_SAMPLES / SYNTH_OUTPUT_CHANNELS	)
+#endif
+
+#ifndef SYNTH_DELAY_TIME
+#  define SYNTH_DELAY_TIME			(	SYNTH_DELAY_FRAMES * 3 / 4	)
+#endif
+
+#ifndef SYNTH_DELAY_FEEDBACK
+#  define SYNTH_DELAY_FEEDBACK		(	48	)
+#endif
+
+#ifndef SYNTH_DELAY_MIX
+#  define SYNTH_DELAY_MIX			(	0	)
+#endif
+
+//waveshaper and bit crusher ahead of the master filter; curve 0 off, 1 soft, 2 asymmetric, 3 fold,
+//drive Q8 (256 = unity), bits 1..12, every sample held for SYNTH_SHAPER_HOLD periods. CC 14 sets
+//the drive, 15 the curve, 16 the bit reduction and 17 the hold
+#ifndef SYNTH_SHAPER
+#  define SYNTH_SHAPER				1
+#endif
+
+#ifndef SYNTH_SHAPER_CURVE
+#  define SYNTH_SHAPER_CURVE		(	0	)
+#endif
+
+#ifndef SYNTH_SHAPER_DRIVE
+#  define SYNTH_SHAPER_DRIVE		(	256	)
+#endif
+
+#ifndef SYNTH_SHAPER_BITS
+#  define SYNTH_SHAPER_BITS			(	12	)
+#endif
+
+#ifndef SYNTH_SHAPER_HOLD
+#  define SYNTH_SHAPER_HOLD			(	1	)
+#endif
+
+//run the render loop, the oscillator kernels, the output stages and the DMA and sample clock
+//interrupts from SRAM: at 48 MHz every flash fetch the NVM cache misses waits 2 states, SRAM
+//none. The startup code copies .ramfunc along with .data, calls between the two go through
+//linker veneers; the code takes around 5 KB of SRAM
+#ifndef SYNTH_RAMFUNC
+#  define SYNTH_RAMFUNC				1
+#endif
+
+#if SYNTH_RAMFUNC && defined(__GNUC__) && defined(__arm__)
+#  define SYNTH_RAM_CODE			__attribute__((section(".ramfunc")))
+#else
+#  define SYNTH_RAM_CODE
+#endif
+
+//DMAC descriptors and the audio buffers go to sections of their own in the linker script, where
+//each has a RAM budget checked at link time and a line of its own in the .map; descriptors are
+//128-bit aligned as the DMAC needs, buffers word aligned for a stereo sample per DMA beat
+#if defined(__GNUC__) && defined(__arm__)
+#  define SYNTH_DMA_DESCRIPTOR		__attribute__((section(".dma_descriptors"), aligned(16)))
+#  define SYNTH_AUDIO_BUFFER		__attribute__((section(".audio_buffers"), aligned(4)))
+#else
+#  define SYNTH_DMA_DESCRIPTOR
+#  define SYNTH_AUDIO_BUFFER
+#endif
+
+//lock the 48 MHz DFLL to the 32 kHz crystal so pitch and sample rate hold across boards and
+//temperature; 1464 x 32768 Hz is 47.97 MHz, which system_cpu_clock_get_hz() reports and the
+//sample clock divides. Without a crystal or lock within SYNTH_CLOCK_READY_WAIT polls of each
+//stage it falls back to open loop
+#ifndef SYNTH_DFLL_CLOSED_LOOP
+#  define SYNTH_DFLL_CLOSED_LOOP	1
+#endif
+
+#ifndef SYNTH_DFLL_MULTIPLY
+#  define SYNTH_DFLL_MULTIPLY		(	48000000 / 32768	)
+#endif
+
+#ifndef SYNTH_CLOCK_READY_WAIT
+#  define SYNTH_CLOCK_READY_WAIT	(	2000000ul	)
+#endif
+
+//fast boot: the DFLL starts open loop at once instead of after the crystal's start-up and the
+//lock, so the output runs a few ms after reset. The trace log task closes the loop once
+//XOSC32K is ready, with the DFLL running throughout, and only then starts USB-MIDI. The TC3
+//sample clock is on OSC8M either way; the I2S output's DPLL needs the crystal and still waits
+#ifndef SYNTH_FAST_BOOT
+#  define SYNTH_FAST_BOOT			1
+#endif
+
+//CPU clock scaling: generator 0 drops from the DFLL to OSC8M (8 MHz) while at most
+//SYNTH_CLOCK_SCALE_VOICES voices sound and the load, scaled to the slow clock, has stayed under
+//SYNTH_CLOCK_SCALE_DOWN per mille for SYNTH_CLOCK_SCALE_HOLD blocks, and goes back up before a
+//block with events waiting or after one over SYNTH_CLOCK_SCALE_UP. The SPI ports, the DAC and
+//the run-time stats move to generator 4 on the DFLL, the sample clock and UARTs already run
+//on OSC8M, so only CPU speed changes
+#ifndef SYNTH_CLOCK_SCALING
+#  define SYNTH_CLOCK_SCALING		1
+#endif
+
+#ifndef SYNTH_CLOCK_SCALE_VOICES
+#  define SYNTH_CLOCK_SCALE_VOICES	(	2	)
+#endif
+
+#ifndef SYNTH_CLOCK_SCALE_DOWN
+#  define SYNTH_CLOCK_SCALE_DOWN	(	600	)
+#endif
+
+#ifndef SYNTH_CLOCK_SCALE_UP
+#  define SYNTH_CLOCK_SCALE_UP		(	800	)
+#endif
+
+#ifndef SYNTH_CLOCK_SCALE_HOLD
+#  define SYNTH_CLOCK_SCALE_HOLD	(	64	)
+#endif
+
+//generator of the peripherals that need the full clock whatever the CPU runs at
+#if SYNTH_CLOCK_SCALING
+#  define SYNTH_FIXED_GCLK			GCLK_GENERATOR_4
+#else
+#  define SYNTH_FIXED_GCLK			GCLK_GENERATOR_0
+#endif
+
+//NVM controller profile written before the switch to 48 MHz: 1 wait state is the datasheet
+//figure for 48 MHz at 2.7 V and up (use 2 below that), read mode 0 (no miss penalty) is the
+//fastest, 2 deterministic trades that for fixed timing, and the cache on. The benchmark
+//prints the render time in every read mode with and without the cache
+#ifndef SYNTH_FLASH_WAIT_STATES
+#  define SYNTH_FLASH_WAIT_STATES	1
+#endif
+
+#ifndef SYNTH_FLASH_READMODE
+#  define SYNTH_FLASH_READMODE		0
+#endif
+
+#ifndef SYNTH_FLASH_CACHE
+#  define SYNTH_FLASH_CACHE			1
+#endif
+
+//power saving, see power_save.h: the idle task sleeps in IDLE 0 whenever the render task is
+//ahead, peripherals left unused after the set-up lose their APB clock, and with the EDBG
+//unpowered the console USART is never started. The ':power' command turns the sleep off
+//and on at run time, for reading the board's current both ways
+#ifndef SYNTH_POWER_SAVE
+#  define SYNTH_POWER_SAVE			1
+#endif
+
+//load governor, fed the render load of each block in per mille of the block period: over
+//SYNTH_GOVERNOR_HIGH it fades out the quietest releasing voice, one per block, and with none
+//left it drops every voice to SYNTH_OSC_TRUNCATE quality until the load
+//has stayed under SYNTH_GOVERNOR_LOW for SYNTH_GOVERNOR_RECOVER_BLOCKS blocks
+#ifndef SYNTH_GOVERNOR
+#  define SYNTH_GOVERNOR			1
+#endif
+
+#ifndef SYNTH_GOVERNOR_HIGH
+#  define SYNTH_GOVERNOR_HIGH		(	900	)
+#endif
+
+#ifndef SYNTH_GOVERNOR_LOW
+#  define SYNTH_GOVERNOR_LOW		(	700	)
+#endif
+
+#ifndef SYNTH_GOVERNOR_RECOVER_BLOCKS
+#  define SYNTH_GOVERNOR_RECOVER_BLOCKS	(	32	)
+#endif
+
+//render deadline, with a board that says when each block goes out: once a block's render
+//comes within SYNTH_DEADLINE_RESERVE per mille of a block period of that, the rest of it
+//skips the formant, chorus and reverb and the block skips its meters, see synth_core.h
+#ifndef SYNTH_DEADLINE
+#  define SYNTH_DEADLINE			1
+#endif
+
+#ifndef SYNTH_DEADLINE_RESERVE
+#  define SYNTH_DEADLINE_RESERVE	(	250	)
+#endif
+
+//one-pole DC blocker on the master output after the effects, corner at or just under
+//SYNTH_DC_BLOCK_HZ; takes out the offset of narrow pulses, the asymmetric shaper curve and
+//samples that are not centred, so it does not move the output as voices start and stop
+#ifndef SYNTH_DC_BLOCK
+#  define SYNTH_DC_BLOCK			1
+#endif
+
+#ifndef SYNTH_DC_BLOCK_HZ
+#  define SYNTH_DC_BLOCK_HZ			(	20	)
+#endif
+
+//lookahead peak limiter ahead of the final saturate, one control period of latency while it is on;
+//threshold in DAC codes from the midscale (0 off, CC 18 sets it in 16 code steps), release
+//1 / 2^SYNTH_LIMITER_RELEASE_SHIFT of the way back to unity gain per control period
+#ifndef SYNTH_LIMITER
+#  define SYNTH_LIMITER				1
+#endif
+
+#ifndef SYNTH_LIMITER_THRESHOLD
+#  define SYNTH_LIMITER_THRESHOLD	(	0	)
+#endif
+
+#ifndef SYNTH_LIMITER_RELEASE_SHIFT
+#  define SYNTH_LIMITER_RELEASE_SHIFT	(	6	)
+#endif
+
+//chorus/flanger ahead of the delay, an LFO swept tap on a line of SYNTH_CHORUS_FRAMES samples
+//(a power of two up to 1024) per output channel; centre delay and depth in us, rate in 1/100 Hz,
+//feedback and mix 0..127, CC 93 sets the mix and CC 94 the depth. Around 2 ms delay with
+//feedback makes it a flanger
+#ifndef SYNTH_CHORUS
+#  define SYNTH_CHORUS				1
+#endif
+
+#ifndef SYNTH_CHORUS_FRAMES
+#  define SYNTH_CHORUS_FRAMES		(	1024	)
+#endif
+
+#ifndef SYNTH_CHORUS_DELAY_US
+#  define SYNTH_CHORUS_DELAY_US		(	12000	)
+#endif
+
+#ifndef SYNTH_CHORUS_DEPTH_US
+#  define SYNTH_CHORUS_DEPTH_US		(	4000	)
+#endif
+
+#ifndef SYNTH_CHORUS_RATE_CHZ
+#  define SYNTH_CHORUS_RATE_CHZ		(	60	)
+#endif
+
+#ifndef SYNTH_CHORUS_FEEDBACK
+#  define SYNTH_CHORUS_FEEDBACK		(	0	)
+#endif
+
+#ifndef SYNTH_CHORUS_MIX
+#  define SYNTH_CHORUS_MIX			(	0	)
+#endif
+
+//vowel filter after the master filter, three bandpasses on the formants of a, e, i, o and u
+//blended with the dry mix, see formant.h; vowel 0..127 sweeps the five, mix 0..127 with 0 off.
+//CC 86 sets the vowel, which glides there at control rate, and CC 87 the mix
+#ifndef SYNTH_FORMANT
+#  define SYNTH_FORMANT				1
+#endif
+
+#ifndef SYNTH_FORMANT_VOWEL
+#  define SYNTH_FORMANT_VOWEL		(	0	)
+#endif
+
+#ifndef SYNTH_FORMANT_MIX
+#  define SYNTH_FORMANT_MIX			(	0	)
+#endif
+
+//reverb after the delay, four combs and two all-passes at half the sample rate sharing a buffer
+//of SYNTH_REVERB_FRAMES samples per output channel, see reverb.h; size, damping and mix 0..127,
+//size 127 rings for several seconds. CC 89 sets the mix and CC 90 the size
+#ifndef SYNTH_REVERB
+#  define SYNTH_REVERB				1
+#endif
+
+#ifndef SYNTH_REVERB_FRAMES
+#  define SYNTH_REVERB_FRAMES		(	SYNTH_PART_REVERB_SAMPLES / SYNTH_OUTPUT_CHANNELS	)
+#endif
+
+#ifndef SYNTH_REVERB_SIZE
+#  define SYNTH_REVERB_SIZE			(	80	)
+#endif
+
+#ifndef SYNTH_REVERB_DAMP
+#  define SYNTH_REVERB_DAMP			(	64	)
+#endif
+
+#ifndef SYNTH_REVERB_MIX
+#  define SYNTH_REVERB_MIX			(	0	)
+#endif
+
+//per-voice prefetch ring of the STREAM voices in frames (a power of two), and the smallest read
+//the prefetch scheduler issues for one voice, see stream.h
+#ifndef SYNTH_STREAM_RING_FRAMES
+#  define SYNTH_STREAM_RING_FRAMES	(	256	)
+#endif
+
+#ifndef SYNTH_STREAM_READ_MIN
+#  define SYNTH_STREAM_READ_MIN		(	32	)
+#endif
+
+//delay lines of the PLUCK voices, the strings that can ring at once, and their length in frames:
+//the lowest pitch is the sample rate over it, 78 Hz at 20 kHz
+#ifndef SYNTH_PLUCK_LINES
+#  define SYNTH_PLUCK_LINES			(	4	)
+#endif
+
+#ifndef SYNTH_PLUCK_FRAMES
+#  define SYNTH_PLUCK_FRAMES		(	256	)
+#endif
+
+//grains the GRAIN voices share, the most that sound at once, and the channels' starting
+//grain size, density and spray, 0..127 as from CCs 81 to 83, see grain.h
+#ifndef SYNTH_GRAINS
+#  define SYNTH_GRAINS				(	SYNTH_PART_GRAINS	)
+#endif
+
+#ifndef SYNTH_GRAIN_SIZE
+#  define SYNTH_GRAIN_SIZE			(	40	)
+#endif
+
+#ifndef SYNTH_GRAIN_DENSITY
+#  define SYNTH_GRAIN_DENSITY		(	40	)
+#endif
+
+#ifndef SYNTH_GRAIN_SPRAY
+#  define SYNTH_GRAIN_SPRAY			(	8	)
+#endif
+
+//the channel that starts on the DRUM kit (9 is MIDI channel 10, as in General MIDI), -1 for
+//none; any channel can still select it with program 16, see drum.h
+#ifndef SYNTH_DRUM_CHANNEL
+#  define SYNTH_DRUM_CHANNEL		(	9	)
+#endif
+
+//LFOs (1..4) and route slots of the modulation matrix, see modulation.h
+#ifndef SYNTH_LFO_COUNT
+#  define SYNTH_LFO_COUNT			(	2	)
+#endif
+
+#ifndef SYNTH_MOD_ROUTES
+#  define SYNTH_MOD_ROUTES			(	8	)
+#endif
+
+//start-up LFO rate in 1/100 Hz
+#ifndef SYNTH_LFO_RATE_CHZ
+#  define SYNTH_LFO_RATE_CHZ		(	500	)
+#endif
+
+//vibrato depth at full mod wheel in 1/256 semitone, the wheel scales route slot 0 (LFO1 to pitch)
+#ifndef SYNTH_MOD_WHEEL_DEPTH
+#  define SYNTH_MOD_WHEEL_DEPTH		(	128	)
+#endif
+
+//stream frames to the output with the DMAC instead of per-sample CPU writes to the MCP4821 from the
+//sample clock ISR; both MCP4821 paths need the DAC chip select on the hardware SS pin, EXT1 pin 15 / PA05
+#ifndef SYNTH_OUTPUT_DMA
+#  define SYNTH_OUTPUT_DMA			1
+#endif
+
+//latch the MCP4821 on the sample clock itself: TCC0 pulses LDAC low on every TC3 overflow, taken
+//over the event system, so the output changes on a hardware edge whatever the DMA, SPI or ISR
+//latency of the word, each word a tick after it is sent. LDAC wired to PA04 (EXT1 pin 17, the
+//MISO the DAC has no use for) instead of to ground
+#ifndef SYNTH_MCP4821_LDAC
+#  define SYNTH_MCP4821_LDAC		0
+#endif
+
+//what the DMA output plays through, see audio_output.h; the CPU path is MCP4821 only
+#define SYNTH_OUTPUT_MCP4821		0	//MCP4821 (MCP4822 in stereo) on EXT1 SPI
+#define SYNTH_OUTPUT_INTERNAL_DAC	1	//the SAMD21's 10-bit DAC on PA02, mono
+#define SYNTH_OUTPUT_I2S			2	//I2S serializer 0, SCK PA10, FS PA11, SD PA19
+
+#ifndef SYNTH_OUTPUT_BACKEND
+#  define SYNTH_OUTPUT_BACKEND		SYNTH_OUTPUT_MCP4821
+#endif
+
+//drive the 256 fs master clock of an I2S codec on PA09 (EXT1 pin 12)
+#ifndef SYNTH_I2S_MCLK
+#  define SYNTH_I2S_MCLK			1
+#endif
+
+//a DC-coupled DAC sits at 0 V until the output starts; before that it climbs to the mid-scale
+//of the silent frames over this long instead of stepping there with a thump. 0 writes
+//mid-scale once, which still checks the DAC's link
+#ifndef SYNTH_OUTPUT_RAMP_MS
+#  define SYNTH_OUTPUT_RAMP_MS		(	20	)
+#endif
+
+//what the output plays when the renderer misses a frame
+#define SYNTH_UNDERRUN_HOLD			0	//hold the last sample
+#define SYNTH_UNDERRUN_FADE			1	//glide from the last sample to midscale
+#define SYNTH_UNDERRUN_REPEAT		2	//play the last frame again
+
+#ifndef SYNTH_UNDERRUN_POLICY
+#  define SYNTH_UNDERRUN_POLICY		SYNTH_UNDERRUN_FADE
+#endif
+
+//fade time constant in samples, 2^SYNTH_UNDERRUN_FADE_SHIFT (32 = 1.6 ms at 20 kHz)
+#ifndef SYNTH_UNDERRUN_FADE_SHIFT
+#  define SYNTH_UNDERRUN_FADE_SHIFT	(	5	)
+#endif
+
+//stream the STREAM voices from an SPI NOR flash on EXT3 (SERCOM5, chip select on pin 15 / PB17),
+//see spi_flash.h
+#ifndef SYNTH_STREAM
+#  define SYNTH_STREAM				0
+#endif
+
+//standard MIDI file player for the same SPI flash: a format 0 or 1 file at SYNTH_SMF_ADDRESS,
+//placed there by tools/gen_flash_image.py, streamed through a small buffer per track and played
+//through the MIDI task, see smf_player.h. With SYNTH_SMF_AUTOPLAY it starts at power-up and
+//with SYNTH_SMF_LOOP starts over at its end, for a score that runs without a host
+#ifndef SYNTH_SMF_PLAYER
+#  define SYNTH_SMF_PLAYER			0
+#endif
+
+#ifndef SYNTH_SMF_ADDRESS
+#  define SYNTH_SMF_ADDRESS			(	0x100000	)
+#endif
+
+#ifndef SYNTH_SMF_TRACKS
+#  define SYNTH_SMF_TRACKS			(	16	)
+#endif
+
+#ifndef SYNTH_SMF_AUTOPLAY
+#  define SYNTH_SMF_AUTOPLAY		1
+#endif
+
+#ifndef SYNTH_SMF_LOOP
+#  define SYNTH_SMF_LOOP			1
+#endif
+
+//write the SPI flash over MIDI from SysEx made by tools/flash_sysex.py, see flash_upload.h; the
+//upload may reach up to SYNTH_FLASH_UPLOAD_MAX, the size of the part
+#ifndef SYNTH_FLASH_UPLOAD
+#  define SYNTH_FLASH_UPLOAD		(SYNTH_STREAM || SYNTH_SMF_PLAYER)
+#endif
+
+#ifndef SYNTH_FLASH_UPLOAD_MAX
+#  define SYNTH_FLASH_UPLOAD_MAX	(	0x1000000	)
+#endif
+
+//MIDI input on the SERCOM1 RX pin, PA17: a serial-MIDI bridge on a PC at SYNTH_MIDI_BRIDGE_BAUD,
+//or a 5-pin DIN input through an opto-isolator at the standard 31250 baud; BOOT_SELECT takes DIN
+//unless SW0 is held through reset
+#define SYNTH_MIDI_BRIDGE			1
+#define SYNTH_MIDI_DIN				2
+#define SYNTH_MIDI_BOOT_SELECT		3
+
+#ifndef SYNTH_MIDI_INPUT
+#  define SYNTH_MIDI_INPUT			SYNTH_MIDI_BRIDGE
+#endif
+
+#ifndef SYNTH_MIDI_BRIDGE_BAUD
+#  define SYNTH_MIDI_BRIDGE_BAUD	(	115200	)
+#endif
+
+#define SYNTH_MIDI_DIN_BAUD			(	31250	)
+
+//MIDI input through a circular DMA buffer polled by the MIDI task, one interrupt per burst of
+//bytes; 0 takes an interrupt per byte and stamps each with its own arrival time, see
+//midi_rx_dma.h
+#ifndef SYNTH_MIDI_RX_DMA
+#  define SYNTH_MIDI_RX_DMA			1
+#endif
+
+//with the interrupt per byte, SERCOM1's vector goes straight to a handler that moves the byte
+//from DATA to the MIDI ring, through a vector table in SRAM (ram_vectors.h), instead of ASF's
+//SERCOM dispatch, its USART handler and the read callback; transmit jobs still go to ASF
+#ifndef SYNTH_MIDI_RX_FAST_ISR
+#  define SYNTH_MIDI_RX_FAST_ISR	(	!SYNTH_MIDI_RX_DMA	)
+#endif
+
+//DMA buffer size in bytes, a power of two; a poll takes at most 24 bytes at 115200 baud
+#ifndef SYNTH_MIDI_RX_DMA_SIZE
+#  define SYNTH_MIDI_RX_DMA_SIZE	(	128	)
+#endif
+
+//extra receive-only DIN MIDI inputs next to the main one, merged with it in arrival order, see
+//midi_uart.h: 1 adds EXT2 pin 8 (PB13, SERCOM4), 2 also EXT1 pin 11 (PA08, SERCOM2)
+#ifndef SYNTH_MIDI_UART_INPUTS
+#  define SYNTH_MIDI_UART_INPUTS	0
+#endif
+
+//potentiometers on consecutive ADC inputs from SYNTH_PANEL_FIRST_AIN, scanned by the ADC into
+//RAM through DMA and sent as controllers on SYNTH_PANEL_CHANNEL, see panel_knobs.h; 0 to 8.
+//From AIN8 they are PB00 and PB01 (EXT1 pins 3 and 4), PB02 and PB03 (pins 7 and 8), ...
+#ifndef SYNTH_PANEL_KNOBS
+#  define SYNTH_PANEL_KNOBS			0
+#endif
+
+#ifndef SYNTH_PANEL_FIRST_AIN
+#  define SYNTH_PANEL_FIRST_AIN		(	8	)
+#endif
+
+#ifndef SYNTH_PANEL_CHANNEL
+#  define SYNTH_PANEL_CHANNEL		(	0	)
+#endif
+
+//longest the MIDI task sleeps between two looks at the knobs
+#ifndef SYNTH_PANEL_POLL_MS
+#  define SYNTH_PANEL_POLL_MS		(	5	)
+#endif
+
+//external audio on ADC input SYNTH_AUDIO_INPUT_AIN, converted on the sample clock and added to
+//the mix ahead of the master effects, so the board can filter, delay or crush it, see
+//audio_input.h. Biased to half of VDDANA, 0 to VDDANA is the full DAC range. AIN8 is PB00,
+//EXT1 pin 3. Takes the ADC from the panel knobs; not with the I2S output, whose clocks are
+//its own
+#ifndef SYNTH_AUDIO_INPUT
+#  define SYNTH_AUDIO_INPUT			0
+#endif
+
+#ifndef SYNTH_AUDIO_INPUT_AIN
+#  define SYNTH_AUDIO_INPUT_AIN		(	8	)
+#endif
+
+#if (SYNTH_MIDI_UART_INPUTS < 0) || (SYNTH_MIDI_UART_INPUTS > 2)
+#  error "SYNTH_MIDI_UART_INPUTS must be 0, 1 or 2"
+#endif
+
+//MIDI out on the SERCOM1 TX pin, PA16, at the input's rate, sent by DMA, see midi_out.h: THRU
+//repeats every event from every input, OVERFLOW hands on the notes this board has no free voice
+//for, with the channel messages they need, to chain a second board behind it
+#define SYNTH_MIDI_OUT_OFF			0
+#define SYNTH_MIDI_OUT_THRU			1
+#define SYNTH_MIDI_OUT_OVERFLOW		2
+
+#ifndef SYNTH_MIDI_OUT
+#  define SYNTH_MIDI_OUT			SYNTH_MIDI_OUT_OFF
+#endif
+
+//transmit buffer in bytes, a power of two
+#ifndef SYNTH_MIDI_OUT_SIZE
+#  define SYNTH_MIDI_OUT_SIZE		(	256	)
+#endif
+
+//voice expansion over a fast serial link on EXT2, see voice_link.h: a MASTER hands the notes it
+//has no free voice for to up to SYNTH_VOICE_LINK_CARDS expander boards on its TX pin, PB12; an
+//EXPANDER is the same firmware as a voice card, taking the link on its RX pin, PB13, and ignoring
+//notes addressed to other cards
+#define SYNTH_VOICE_LINK_OFF		0
+#define SYNTH_VOICE_LINK_MASTER		1
+#define SYNTH_VOICE_LINK_EXPANDER	2
+
+#ifndef SYNTH_VOICE_LINK
+#  define SYNTH_VOICE_LINK			SYNTH_VOICE_LINK_OFF
+#endif
+
+#ifndef SYNTH_VOICE_LINK_BAUD
+#  define SYNTH_VOICE_LINK_BAUD		(	250000	)
+#endif
+
+//expanders on the master's link
+#ifndef SYNTH_VOICE_LINK_CARDS
+#  define SYNTH_VOICE_LINK_CARDS	(	2	)
+#endif
+
+//an expander's address on the link, 0 to SYNTH_VOICE_LINK_CARDS - 1
+#ifndef SYNTH_VOICE_CARD_ID
+#  define SYNTH_VOICE_CARD_ID		(	0	)
+#endif
+
+//the master asks one card for its load this often, round the cards, and spreads new notes by
+//what they report; 0 never asks and spreads them by the notes it sent each card
+#ifndef SYNTH_VOICE_LINK_POLL_MS
+#  define SYNTH_VOICE_LINK_POLL_MS	(	20	)
+#endif
+
+//sample clock lock across chained boards, see sample_clock.h: the MASTER outputs a block clock
+//on PA10, a FOLLOWER trims its sample clock to it
+#define SYNTH_SAMPLE_SYNC_OFF		0
+#define SYNTH_SAMPLE_SYNC_MASTER	1
+#define SYNTH_SAMPLE_SYNC_FOLLOWER	2
+
+#ifndef SYNTH_SAMPLE_SYNC
+#  define SYNTH_SAMPLE_SYNC			SYNTH_SAMPLE_SYNC_OFF
+#endif
+
+//patch presets in the last rows of the internal flash, recalled by program change, see preset.h.
+//SYNTH_PRESET_ROWS rows of 256 bytes, split in two halves that take turns; each half must hold
+//all SYNTH_PRESET_COUNT presets with room to spare
+#ifndef SYNTH_PRESETS
+#  define SYNTH_PRESETS				1
+#endif
+
+#ifndef SYNTH_PRESET_COUNT
+#  define SYNTH_PRESET_COUNT		(	16	)
+#endif
+
+#ifndef SYNTH_PRESET_ROWS
+#  define SYNTH_PRESET_ROWS			(	16	)
+#endif
+
+//performance recorder: the MIDI events every input hands the engine, recorded to rows of the
+//internal flash reserved next to the presets and replayed through the MIDI task, see
+//recorder.h. SYNTH_RECORDER_ROWS rows of 256 bytes, some 60 to 80 events each
+#ifndef SYNTH_RECORDER
+#  define SYNTH_RECORDER			1
+#endif
+
+#ifndef SYNTH_RECORDER_ROWS
+#  define SYNTH_RECORDER_ROWS		(	64	)
+#endif
+
+//MIDI-in to DAC-out latency probe, see latency_probe.h: notes measured from the sample their
+//last byte arrived at to the first sample of theirs further than SYNTH_LATENCY_PROBE_THRESHOLD
+//codes from midscale; the probe's own notes are SYNTH_LATENCY_PROBE_NOTE on channel 1
+#ifndef SYNTH_LATENCY_PROBE
+#  define SYNTH_LATENCY_PROBE		1
+#endif
+
+#ifndef SYNTH_LATENCY_PROBE_THRESHOLD
+#  define SYNTH_LATENCY_PROBE_THRESHOLD	(	16	)
+#endif
+
+#ifndef SYNTH_LATENCY_PROBE_NOTE
+#  define SYNTH_LATENCY_PROBE_NOTE	(	69	)
+#endif
+
+//polyphony stress test on the ':sweep' console command, see poly_sweep.h: the most voices of
+//each waveform that play with every effect on and no underrun
+#ifndef SYNTH_POLY_SWEEP
+#  define SYNTH_POLY_SWEEP			1
+#endif
+
+//the engine hands overflow notes on instead of stealing, to MIDI out or to the voice link
+#define SYNTH_VOICE_OVERFLOW		((SYNTH_MIDI_OUT == SYNTH_MIDI_OUT_OVERFLOW) || (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER))
+
+//USB-MIDI device on the TARGET USB port, a second MIDI input next to the UART, see usb_midi.h;
+//needs the DFLL locked to the crystal. The default IDs are the pid.codes test pair, for the bench
+//only
+#ifndef SYNTH_USB_MIDI
+#  define SYNTH_USB_MIDI			0
+#endif
+
+#ifndef SYNTH_USB_VID
+#  define SYNTH_USB_VID				(	0x1209	)
+#endif
+
+#ifndef SYNTH_USB_PID
+#  define SYNTH_USB_PID				(	0x0001	)
+#endif
+
+#ifndef SYNTH_USB_PRODUCT
+#  define SYNTH_USB_PRODUCT			"FreeRTOS Digital Synth"
+#endif
+
+//logic analyser markers around the render, DAC transfer, MIDI interrupt and MIDI parse,
+//on EXT1 pins 5 to 8 by default; driven through the single-cycle I/O port, see trace_pins.h
+#ifndef SYNTH_TRACE_PINS
+#  define SYNTH_TRACE_PINS			0
+#endif
+
+#ifndef SYNTH_TRACE_PIN_RENDER
+#  define SYNTH_TRACE_PIN_RENDER	PIN_PB06
+#endif
+
+#ifndef SYNTH_TRACE_PIN_DAC
+#  define SYNTH_TRACE_PIN_DAC		PIN_PB07
+#endif
+
+#ifndef SYNTH_TRACE_PIN_MIDI_ISR
+#  define SYNTH_TRACE_PIN_MIDI_ISR	PIN_PB02
+#endif
+
+#ifndef SYNTH_TRACE_PIN_MIDI_PARSE
+#  define SYNTH_TRACE_PIN_MIDI_PARSE	PIN_PB03
+#endif
+
+//printf on the EDBG port copies into a ring sent by interrupt-driven write jobs instead of
+//waiting for the line, dropping what does not fit; 0 keeps the ASF busy-wait, whose output
+//survives a crash; see debug_uart.h
+#ifndef SYNTH_DEBUG_UART_BUFFERED
+#  define SYNTH_DEBUG_UART_BUFFERED	1
+#endif
+
+//transmit ring size in bytes, a power of two
+#ifndef SYNTH_DEBUG_UART_TX_SIZE
+#  define SYNTH_DEBUG_UART_TX_SIZE	(	512	)
+#endif
+
+//framed binary status on the EDBG port for tools/telemetry.py, see telemetry.h; the 'b'
+//console command switches it on and off, SYNTH_TELEMETRY_START is the state at reset
+#ifndef SYNTH_TELEMETRY
+#  define SYNTH_TELEMETRY			1
+#endif
+
+#ifndef SYNTH_TELEMETRY_START
+#  define SYNTH_TELEMETRY_START		0
+#endif
+
+#ifndef SYNTH_TELEMETRY_PERIOD_MS
+#  define SYNTH_TELEMETRY_PERIOD_MS	(	100	)
+#endif
+
+//period of the software timer that samples the queue and ring levels for the 'q' command
+//and telemetry, see fill_stats.h
+#ifndef SYNTH_STATS_SAMPLE_MS
+#  define SYNTH_STATS_SAMPLE_MS		(	2	)
+#endif
+
+//WDT kicked by the output stage for each block rendered in time; the early warning saves a
+//post-mortem to RAM kept across the reset and resets at once, see audio_watchdog.h
+#ifndef SYNTH_WATCHDOG
+#  define SYNTH_WATCHDOG			1
+#endif
+
+//time without a block rendered in time before the board resets, and before the post-mortem
+#ifndef SYNTH_WATCHDOG_TIMEOUT_MS
+#  define SYNTH_WATCHDOG_TIMEOUT_MS	(	250	)
+#endif
+
+#ifndef SYNTH_WATCHDOG_WARNING_MS
+#  define SYNTH_WATCHDOG_WARNING_MS	(	125	)
+#endif
+
+//record context switches and queue traffic from the kernel trace hooks into a RAM ring, dumped
+//in binary on the EDBG port by the 'k' console command, see kernel_trace.h
+#ifndef SYNTH_KERNEL_TRACE
+#  define SYNTH_KERNEL_TRACE		0
+#endif
+
+//records kept, a power of two, 8 bytes each
+#ifndef SYNTH_KERNEL_TRACE_RECORDS
+#  define SYNTH_KERNEL_TRACE_RECORDS	(	256	)
+#endif
+
+//capture rendered blocks into RAM for tools/audio_tap.py, armed by the ":tap" console command
+//and dumped in binary on the EDBG port by 'a', see audio_tap.h
+#ifndef SYNTH_AUDIO_TAP
+#  define SYNTH_AUDIO_TAP			0
+#endif
+
+//blocks kept, SYNTH_FRAME_WORDS * 2 bytes each
+#ifndef SYNTH_AUDIO_TAP_BLOCKS
+#  define SYNTH_AUDIO_TAP_BLOCKS	(	64	)
+#endif
+
+//transmit a synthetic MIDI stream on the MIDI USART for loopback stress tests, see midi_flood.h
+#ifndef SYNTH_MIDI_FLOOD
+#  define SYNTH_MIDI_FLOOD			0
+#endif
+
+//build the kernel benchmark instead of the synth, results are printed on the EDBG console
+#ifndef SYNTH_BENCHMARK
+#  define SYNTH_BENCHMARK			0
+#endif
+
+//count calls and timer cycles per render stage, see profile.h; for the host tools, the
+//profiler's table does not fit the board
+#ifndef SYNTH_PROFILE
+#  define SYNTH_PROFILE				0
+#endif
+
+#if SYNTH_VOICE_LINK && SYNTH_MIDI_UART_INPUTS
+#  error "SYNTH_VOICE_LINK takes SERCOM4, the first of the SYNTH_MIDI_UART_INPUTS"
+#endif
+
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER) && SYNTH_MIDI_OUT
+#  error "the voice link master sends through the MIDI out transmitter, SYNTH_MIDI_OUT must be off"
+#endif
+
+#if (SYNTH_VOICE_LINK_CARDS < 1) || (SYNTH_VOICE_LINK_CARDS > 15) || (SYNTH_VOICE_CARD_ID >= SYNTH_VOICE_LINK_CARDS)
+#  error "the voice link takes 1 to 15 cards, SYNTH_VOICE_CARD_ID must be one of them"
+#endif
+
+#if SYNTH_SAMPLE_SYNC && SYNTH_OUTPUT_DMA && (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_I2S)
+#  error "SYNTH_SAMPLE_SYNC needs an output paced by the sample clock, I2S runs on its own"
+#endif
+
+#if SYNTH_MIDI_OUT && SYNTH_MIDI_FLOOD
+#  error "SYNTH_MIDI_OUT and SYNTH_MIDI_FLOOD both transmit on the MIDI USART"
+#endif
+
+#if SYNTH_PRESETS && ((SYNTH_PRESET_COUNT < 1) || (SYNTH_PRESET_COUNT > 128) || (SYNTH_PRESET_ROWS & 1) || (SYNTH_PRESET_ROWS * 2 < SYNTH_PRESET_COUNT + 2))
+#  error "SYNTH_PRESET_ROWS must be even, with a half of 4-page rows holding SYNTH_PRESET_COUNT (1 to 128) presets and a header"
+#endif
+
+#if (SYNTH_DRUM_CHANNEL < -1) || (SYNTH_DRUM_CHANNEL > 15)
+#  error "SYNTH_DRUM_CHANNEL must be between -1 and 15"
+#endif
+
+#if (SYNTH_ARP_CHANNEL < 0) || (SYNTH_ARP_CHANNEL > 15) || (SYNTH_ARP_NOTES < 1) || (SYNTH_ARP_NOTES > 128) || (SYNTH_ARP_DIVISION < 1) || (SYNTH_ARP_DIVISION > 96) || (SYNTH_ARP_OCTAVES < 1) || (SYNTH_ARP_OCTAVES > 4)
+#  error "SYNTH_ARP_CHANNEL must be 0 to 15, with 1 to 128 SYNTH_ARP_NOTES, a division of 1 to 96 clocks and 1 to 4 octaves"
+#endif
+
+#if (SYNTH_MPE_CHANNELS < 0) || (SYNTH_MPE_CHANNELS > 15)
+#  error "SYNTH_MPE_CHANNELS must be 0 to 15"
+#endif
+
+#if (SYNTH_MPE_CHANNELS || SYNTH_PRESSURE_AMP_DEPTH || SYNTH_PRESSURE_CUTOFF_DEPTH) && (SYNTH_MOD_ROUTES < 4)
+#  error "the MPE timbre and the aftertouch routes take the last three SYNTH_MOD_ROUTES, with slot 0 that is at least 4"
+#endif
+
+#if (SYNTH_SAMPLE_RATE < SYNTH_SAMPLE_RATE_MIN) || (SYNTH_SAMPLE_RATE > SYNTH_SAMPLE_RATE_MAX)
+#  error "SYNTH_SAMPLE_RATE must be between SYNTH_SAMPLE_RATE_MIN and SYNTH_SAMPLE_RATE_MAX"
+#endif
+
+#if (SYNTH_MAX_VOICES < 1) || (SYNTH_MAX_VOICES > 127)
+#  error "SYNTH_MAX_VOICES must be between 1 and 127"
+#endif
+
+#if (SYNTH_WAVE_SWAP_TICKS < 0) || (SYNTH_WAVE_SWAP_TICKS > 127)
+#  error "SYNTH_WAVE_SWAP_TICKS must be between 0 and 127"
+#endif
+
+#if (SYNTH_UNISON < 2) || (SYNTH_UNISON > 8)
+#  error "SYNTH_UNISON must be between 2 and 8"
+#endif
+
+#if (SYNTH_PLUCK_LINES < 1) || (SYNTH_PLUCK_LINES > 254) || (SYNTH_PLUCK_FRAMES < 2) || (SYNTH_PLUCK_FRAMES > 65535)
+#  error "SYNTH_PLUCK_LINES must be 1 to 254, of 2 to 65535 SYNTH_PLUCK_FRAMES"
+#endif
+
+#if (SYNTH_AUTOMATION_CLOCKS < 1) || (SYNTH_AUTOMATION_CLOCKS > 65535) || (SYNTH_AUTOMATION_EVENTS < 1) || (SYNTH_AUTOMATION_EVENTS > 65535)
+#  error "SYNTH_AUTOMATION_CLOCKS and SYNTH_AUTOMATION_EVENTS must be 1 to 65535"
+#endif
+
+#if (SYNTH_GRAINS < 1) || (SYNTH_GRAINS > 1024)
+#  error "SYNTH_GRAINS must be 1 to 1024"
+#endif
+
+#if (SYNTH_STREAM_RING_FRAMES & (SYNTH_STREAM_RING_FRAMES - 1)) || (SYNTH_STREAM_READ_MIN > SYNTH_STREAM_RING_FRAMES)
+#  error "SYNTH_STREAM_RING_FRAMES must be a power of two and at least SYNTH_STREAM_READ_MIN"
+#endif
+
+#if (SYNTH_DELAY_FRAMES & (SYNTH_DELAY_FRAMES - 1)) || (SYNTH_DELAY_FRAMES < 128)
+#  error "SYNTH_DELAY_FRAMES must be a power of two of at least 128"
+#endif
+
+#if (SYNTH_CHORUS_FRAMES & (SYNTH_CHORUS_FRAMES - 1)) || (SYNTH_CHORUS_FRAMES < 16) || (SYNTH_CHORUS_FRAMES > 1024)
+#  error "SYNTH_CHORUS_FRAMES must be a power of two between 16 and 1024"
+#endif
+
+#if SYNTH_REVERB && ((SYNTH_REVERB_FRAMES < 256) || (SYNTH_REVERB_FRAMES > 65535) || (SYNTH_CONTROL_PERIOD & 1))
+#  error "SYNTH_REVERB needs 256 to 65535 SYNTH_REVERB_FRAMES and an even SYNTH_CONTROL_PERIOD"
+#endif
+
+#if (SYNTH_VOICE_GROUPS < 1) || (SYNTH_VOICE_GROUPS > SYNTH_MAX_VOICES)
+#  error "SYNTH_VOICE_GROUPS must be between 1 and SYNTH_MAX_VOICES"
+#endif
+
+#if (SYNTH_LFO_COUNT < 1) || (SYNTH_LFO_COUNT > 4)
+#  error "SYNTH_LFO_COUNT must be between 1 and 4"
+#endif
+
+#if (SYNTH_BLOCK_SIZE % SYNTH_CONTROL_PERIOD)
+#  error "SYNTH_CONTROL_PERIOD must divide SYNTH_BLOCK_SIZE"
+#endif
+
+#if SYNTH_MIX_ASM && (SYNTH_CONTROL_PERIOD % 4)
+#  error "SYNTH_MIX_ASM needs SYNTH_CONTROL_PERIOD a multiple of 4"
+#endif
+
+#if SYNTH_MIX_SSAT && (SYNTH_MIX_ASM || !SYNTH_PART_DSP)
+#  error "SYNTH_MIX_SSAT needs a core with SSAT and takes the place of SYNTH_MIX_ASM"
+#endif
+
+#if SYNTH_METERS && (SYNTH_MIX_ASM || SYNTH_MIX_SSAT)
+#  error "SYNTH_METERS makes the DAC codes in its own loop, set SYNTH_MIX_ASM and SYNTH_MIX_SSAT to 0"
+#endif
+
+#if SYNTH_METERS && (SYNTH_BLOCK_SIZE > 512)
+#  error "SYNTH_METERS sums a block's squares in 32 bits, at most 512 samples"
+#endif
+
+#if SYNTH_METERS && SYNTH_TELEMETRY && (SYNTH_MAX_VOICES > 120)
+#  error "the telemetry levels frame holds at most 120 voices, set SYNTH_METERS or SYNTH_TELEMETRY to 0"
+#endif
+
+#if SYNTH_METER_LED && (!SYNTH_METERS || SYNTH_SAMPLE_SYNC)
+#  error "SYNTH_METER_LED needs SYNTH_METERS, and TCC1, which SYNTH_SAMPLE_SYNC counts blocks with"
+#endif
+
+#if (SYNTH_EVENT_QUEUE_SIZE & (SYNTH_EVENT_QUEUE_SIZE - 1))
+#  error "SYNTH_EVENT_QUEUE_SIZE must be a power of two"
+#endif
+
+#if (SYNTH_REALTIME_QUEUE_SIZE & (SYNTH_REALTIME_QUEUE_SIZE - 1))
+#  error "SYNTH_REALTIME_QUEUE_SIZE must be a power of two"
+#endif
+
+#if (SYNTH_FAST_NOTE_QUEUE_SIZE & (SYNTH_FAST_NOTE_QUEUE_SIZE - 1))
+#  error "SYNTH_FAST_NOTE_QUEUE_SIZE must be a power of two"
+#endif
+
+#if SYNTH_FAST_NOTE_ON && SYNTH_MIDI_RX_DMA
+#  error "SYNTH_FAST_NOTE_ON needs the RX interrupt per byte, set SYNTH_MIDI_RX_DMA to 0"
+#endif
+
+#if SYNTH_MIDI_RX_FAST_ISR && SYNTH_MIDI_RX_DMA
+#  error "SYNTH_MIDI_RX_FAST_ISR is the RX interrupt per byte, set SYNTH_MIDI_RX_DMA to 0"
+#endif
+
+#if SYNTH_STEREO && !SYNTH_OUTPUT_DMA
+#  error "SYNTH_STEREO needs SYNTH_OUTPUT_DMA"
+#endif
+
+#if (SYNTH_OUTPUT_BACKEND != SYNTH_OUTPUT_MCP4821) && !SYNTH_OUTPUT_DMA
+#  error "only the MCP4821 output has a CPU path, SYNTH_OUTPUT_BACKEND needs SYNTH_OUTPUT_DMA"
+#endif
+
+#if SYNTH_MCP4821_LDAC && ((SYNTH_OUTPUT_BACKEND != SYNTH_OUTPUT_MCP4821) || (SYNTH_PANEL_KNOBS && (SYNTH_PANEL_FIRST_AIN <= 4) && (SYNTH_PANEL_FIRST_AIN + SYNTH_PANEL_KNOBS > 4)) || (SYNTH_AUDIO_INPUT && (SYNTH_AUDIO_INPUT_AIN == 4)))
+#  error "SYNTH_MCP4821_LDAC is for the MCP4821 output and takes PA04, which is AIN4"
+#endif
+
+#if (SYNTH_MIDI_INPUT < SYNTH_MIDI_BRIDGE) || (SYNTH_MIDI_INPUT > SYNTH_MIDI_BOOT_SELECT)
+#  error "SYNTH_MIDI_INPUT must be SYNTH_MIDI_BRIDGE, SYNTH_MIDI_DIN or SYNTH_MIDI_BOOT_SELECT"
+#endif
+
+#if SYNTH_STEREO && (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_INTERNAL_DAC)
+#  error "the internal DAC output is mono, SYNTH_STEREO needs another SYNTH_OUTPUT_BACKEND"
+#endif
+
+#if (SYNTH_OUTPUT_FRAMES < 3)
+#  error "SYNTH_OUTPUT_FRAMES must be at least 3 (one rendering, one playing, one queued)"
+#endif
+
+#if (SYNTH_OUTPUT_FRAMES_ACTIVE < 3) || (SYNTH_OUTPUT_FRAMES_ACTIVE > SYNTH_OUTPUT_FRAMES)
+#  error "SYNTH_OUTPUT_FRAMES_ACTIVE must be between 3 and SYNTH_OUTPUT_FRAMES"
+#endif
+
+#if (SYNTH_IRQ_LEVEL_OUTPUT < 0) || (SYNTH_IRQ_LEVEL_OUTPUT >= SYNTH_IRQ_LEVEL_INPUT) || (SYNTH_IRQ_LEVEL_INPUT > SYNTH_IRQ_LEVEL_CONSOLE) || (SYNTH_IRQ_LEVEL_CONSOLE > 2)
+#  error "the interrupt levels must run output < input <= console < 3, the kernel's level"
+#endif
+
+#if (SYNTH_STATS_SAMPLE_MS < 1) || (SYNTH_STATS_SAMPLE_MS > SYNTH_TELEMETRY_PERIOD_MS)
+#  error "SYNTH_STATS_SAMPLE_MS must be between 1 and SYNTH_TELEMETRY_PERIOD_MS"
+#endif
+
+#if (SYNTH_WATCHDOG_WARNING_MS >= SYNTH_WATCHDOG_TIMEOUT_MS) || (SYNTH_WATCHDOG_TIMEOUT_MS > 16000)
+#  error "SYNTH_WATCHDOG_WARNING_MS must come before SYNTH_WATCHDOG_TIMEOUT_MS, at most 16 s"
+#endif
+
+#if SYNTH_FAST_BOOT && !SYNTH_DFLL_CLOSED_LOOP
+#  error "SYNTH_FAST_BOOT defers the DFLL lock, it needs SYNTH_DFLL_CLOSED_LOOP"
+#endif
+
+#if (SYNTH_PANEL_KNOBS < 0) || (SYNTH_PANEL_KNOBS > 8) || (SYNTH_PANEL_FIRST_AIN + SYNTH_PANEL_KNOBS > 20) || (SYNTH_PANEL_POLL_MS < 1)
+#  error "SYNTH_PANEL_KNOBS must be 0 to 8 on AIN0 to AIN19, read every SYNTH_PANEL_POLL_MS of at least 1"
+#endif
+
+#if SYNTH_PANEL_KNOBS && SYNTH_TRACE_PINS && (((SYNTH_PANEL_FIRST_AIN < 12) && (SYNTH_PANEL_FIRST_AIN + SYNTH_PANEL_KNOBS > 10)) || ((SYNTH_PANEL_FIRST_AIN < 16) && (SYNTH_PANEL_FIRST_AIN + SYNTH_PANEL_KNOBS > 14)))
+#  error "the panel knobs take AIN10, 11, 14 or 15, the default trace pins PB02, PB03, PB06 or PB07"
+#endif
+
+#if SYNTH_AUDIO_INPUT && (SYNTH_PANEL_KNOBS || (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_I2S))
+#  error "SYNTH_AUDIO_INPUT needs the ADC to itself and an output paced by the sample clock"
+#endif
+
+#if SYNTH_AUDIO_INPUT && ((SYNTH_AUDIO_INPUT_AIN < 0) || (SYNTH_AUDIO_INPUT_AIN > 19) || ((SYNTH_AUDIO_INPUT_AIN == 0) && (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_INTERNAL_DAC)))
+#  error "SYNTH_AUDIO_INPUT_AIN must be AIN0 to AIN19, not AIN0 (PA02) with the internal DAC on it"
+#endif
+
+#if SYNTH_AUDIO_INPUT && SYNTH_TRACE_PINS && ((SYNTH_AUDIO_INPUT_AIN == 10) || (SYNTH_AUDIO_INPUT_AIN == 11) || (SYNTH_AUDIO_INPUT_AIN == 14) || (SYNTH_AUDIO_INPUT_AIN == 15))
+#  error "AIN10, 11, 14 and 15 are the default trace pins PB02, PB03, PB06 and PB07"
+#endif
+
+#if SYNTH_RECORDER && (SYNTH_RECORDER_ROWS < 1)
+#  error "SYNTH_RECORDER_ROWS must be at least 1"
+#endif
+
+#if SYNTH_SMF_PLAYER && ((SYNTH_SMF_TRACKS < 1) || (SYNTH_SMF_TRACKS > 64))
+#  error "SYNTH_SMF_TRACKS must be 1 to 64"
+#endif
+
+#endif /* CONF_SYNTH_H_INCLUDED */
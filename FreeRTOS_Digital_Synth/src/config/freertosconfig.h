@@ -10,40 +10,96 @@
  */
 #include <stdint.h>
 void assert_triggered( const char * file, uint32_t line );
+
+/* Run-time stats time base, TC6/TC7 at configCPU_CLOCK_HZ / 64 (cycle_counter.c). */
+void run_time_counter_init( void );
+uint32_t run_time_counter_read( void );
+
+/* Tick suppression for the CM0 port (tickless_idle.c). */
+void tickless_idle_sleep( unsigned long expected_idle_ticks );
+
+/* Kernel event recorder behind the trace hooks (kernel_trace.c). */
+#include "conf_synth.h"
+#include "kernel_trace.h"
 #endif
 
 #define configUSE_PREEMPTION                    1
-#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICKLESS_IDLE                 1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+#define configUSE_IDLE_HOOK                     1
 #define configUSE_TICK_HOOK                     0
-#define configPRIO_BITS                         3
+/* The SAMD21 NVIC has four levels, see the priority plan in main.c. */
+#define configPRIO_BITS                         2
 #define configCPU_CLOCK_HZ                      ( 48000000 )
-#define configTICK_RATE_HZ                      ( ( portTickType ) 20000 )
+#define configTICK_RATE_HZ                      ( ( portTickType ) 1000 )
 #define configMAX_PRIORITIES                    ( ( unsigned portBASE_TYPE ) 5 )
-#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 500 )
-/* configTOTAL_HEAP_SIZE is not used when heap_3.c is used. */
-#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 15000 ) )
+/* Only the idle task uses the minimal stack size, application task stacks are
+static and sized in main.c. */
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 128 )
+/* configTOTAL_HEAP_SIZE is not used when heap_3.c is used. heap_1 now only
+holds the TCBs, the idle and timer task stacks, the queues and the timers. */
+#define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 2560 ) )
 #define configMAX_TASK_NAME_LEN                 ( 8 )
-#define configUSE_TRACE_FACILITY                0
+#define configUSE_TRACE_FACILITY                1
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_MUTEXES                       1
-#define configQUEUE_REGISTRY_SIZE               0
-#define configCHECK_FOR_STACK_OVERFLOW          0
+/* The CPU output path's frame queues, named for kernel aware debuggers. */
+#define configQUEUE_REGISTRY_SIZE               2
+#define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_RECURSIVE_MUTEXES             1
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_QUEUE_SETS                    1
-#define configGENERATE_RUN_TIME_STATS           0
+/* Direct to task wakeups for the renderer and the MIDI task, see task.h;
+stream_buffer.c blocks on them too. */
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configGENERATE_RUN_TIME_STATS           1
+
+/* Run time stats counter, read on every context switch. */
+#if SYNTH_KERNEL_TRACE
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    { run_time_counter_init(); kernel_trace_start(); }
+#else
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    run_time_counter_init()
+#endif
+#define portGET_RUN_TIME_COUNTER_VALUE()            run_time_counter_read()
+
+/* Kernel trace hooks. They all run with interrupts masked, inside the kernel's
+critical sections or the PendSV switch, and the run-time counter is their time
+base. Tasks are identified by their TCB number, queues by the number
+kernel_trace_name_queue() gave them. A notification is recorded against the
+task notified, or the task taking it, with its count. */
+#if SYNTH_KERNEL_TRACE
+#define traceTASK_CREATE( pxNewTCB )                kernel_trace_task_created( ( uint8_t ) ( pxNewTCB )->uxTCBNumber, ( const char * ) ( pxNewTCB )->pcTaskName )
+#define traceTASK_SWITCHED_IN()                     kernel_trace_record( KERNEL_TRACE_SWITCH, ( uint8_t ) pxCurrentTCB->uxTCBNumber, ( uint16_t ) pxCurrentTCB->uxPriority )
+#define traceQUEUE_SEND( pxQueue )                  kernel_trace_record( KERNEL_TRACE_SEND, ( pxQueue )->ucQueueNumber, ( uint16_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )         kernel_trace_record( KERNEL_TRACE_SEND_ISR, ( pxQueue )->ucQueueNumber, ( uint16_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )               kernel_trace_record( KERNEL_TRACE_RECEIVE, ( pxQueue )->ucQueueNumber, ( uint16_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )      kernel_trace_record( KERNEL_TRACE_RECEIVE_ISR, ( pxQueue )->ucQueueNumber, ( uint16_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )   kernel_trace_record( KERNEL_TRACE_BLOCK, ( pxQueue )->ucQueueNumber, ( uint16_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceTASK_NOTIFY_GIVE( pxTCB )              kernel_trace_record( KERNEL_TRACE_NOTIFY, ( uint8_t ) ( pxTCB )->uxTCBNumber, ( uint16_t ) ( pxTCB )->ulNotifiedValue )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR( pxTCB )     kernel_trace_record( KERNEL_TRACE_NOTIFY_ISR, ( uint8_t ) ( pxTCB )->uxTCBNumber, ( uint16_t ) ( pxTCB )->ulNotifiedValue )
+#define traceTASK_NOTIFY_TAKE()                     kernel_trace_record( KERNEL_TRACE_NOTIFY_TAKE, ( uint8_t ) pxCurrentTCB->uxTCBNumber, ( uint16_t ) pxCurrentTCB->ulNotifiedValue )
+#define traceTASK_NOTIFY_TAKE_BLOCK()               kernel_trace_record( KERNEL_TRACE_NOTIFY_BLOCK, ( uint8_t ) pxCurrentTCB->uxTCBNumber, 0 )
+#endif
+
+/* Sleep through idle periods, the CM0 port does not implement this itself. */
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    tickless_idle_sleep( xExpectedIdleTime )
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         ( 2 )
 
-/* Software timer definitions. */
+/* Software timer definitions.  The timers run short periodic work that does
+not print, such as the stats sampling in main.c; anything that prints is a
+job of the trace log task (see trace_log.h), whose stack is sized for printf.
+Between the MIDI task and the trace log task, see the priority plan in main.c.
+The callbacks are small, 64 words leaves room for them over the daemon's own
+frames; the 'h' console command shows what is left. */
 #define configUSE_TIMERS                        1
-#define configTIMER_TASK_PRIORITY               ( 2 )
+#define configTIMER_TASK_PRIORITY               ( 1 )
 #define configTIMER_QUEUE_LENGTH                2
-#define configTIMER_TASK_STACK_DEPTH            ( 80 )
+#define configTIMER_TASK_STACK_DEPTH            ( 64 )
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -56,10 +112,10 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
-#define INCLUDE_xTaskGetIdleTaskHandle          0
-#define INCLUDE_xTimerGetTimerDaemonTaskHandle  0
-#define INCLUDE_pcTaskGetTaskName               0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle  1
+#define INCLUDE_pcTaskGetTaskName               1
 #define INCLUDE_eTaskGetState                   0
 
 
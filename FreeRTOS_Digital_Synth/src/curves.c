@@ -0,0 +1,42 @@
+/*************************************************************************************************
+                                           --CURVES--
+
+	One octave of 2^(x/12) in semitone steps, interpolated linearly and shifted by whole
+	octaves; the interpolation is within 0.03% of the true curve between the steps.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "curves.h"
+#include "recip.h"
+
+
+/*******   GLOBAL VARS  *********/
+//2^(k/12) in Q16, k = 0..12
+static const uint32_t semitone_ratio[13] = {
+	65536, 69433, 73562, 77936, 82570, 87480, 92682, 98193, 104032, 110218, 116772, 123715, 131072
+};
+
+
+/***  APPLICATION FUNCTIONS  ****/
+uint32_t curve_exp2( int32_t fine )
+{
+	//2^(fine / (12 * 256)) in Q16, octaves outside -16..14 are clamped
+	int32_t octave;
+	int32_t rem;
+	uint32_t lo;
+	uint32_t ratio;
+
+	if(fine < -16 * CURVE_OCTAVE_FINE) fine = -16 * CURVE_OCTAVE_FINE;
+	if(fine > 15 * CURVE_OCTAVE_FINE - 1) fine = 15 * CURVE_OCTAVE_FINE - 1;
+
+	//floor division, the remainder stays within one octave; 3072 is 12 steps of 256
+	octave = recip_div((fine + 16 * CURVE_OCTAVE_FINE) >> 8, 12) - 16;
+	rem = fine - octave * CURVE_OCTAVE_FINE;
+
+	lo = semitone_ratio[rem >> 8];
+	ratio = lo + (((semitone_ratio[(rem >> 8) + 1] - lo) * (uint32_t) (rem & 0xFF)) >> 8);
+
+	return (octave >= 0) ? (ratio << octave) : (ratio >> -octave);
+}
+
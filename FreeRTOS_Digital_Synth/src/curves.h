@@ -0,0 +1,32 @@
+/*************************************************************************************************
+                                           --CURVES--
+
+	Exponential curves for the control paths, all from one flash table of 2^(k/12): pitch
+	and cutoff ratios, and decibels to gain for the exponential envelope's per-tick factors,
+	a level in dB being CURVE_FINE_PER_DB steps of 1/256 semitone each. No control path uses
+	floating point or a soft-float exp(); the pitch of a note itself comes from the note
+	table, the velocity curves and drawbar levels are tables of their own.
+
+	Ratios are Q16, pitch offsets in 1/256 semitone.
+
+*************************************************************************************************/
+
+#ifndef CURVES_H_INCLUDED
+#define CURVES_H_INCLUDED
+
+#include <stdint.h>
+
+/**********  DEFINE  ************/
+//1/256 semitone steps per octave
+#define CURVE_OCTAVE_FINE		(	12 * 256	)
+
+#define CURVE_RATIO_SHIFT		(	16	)
+#define CURVE_UNITY				(	1ul << CURVE_RATIO_SHIFT	)
+
+//1/256 semitone steps per dB of amplitude, 3072 / 6.0206
+#define CURVE_FINE_PER_DB		(	510	)
+
+/****** FUNCTION PROTOTYPES  ****/
+uint32_t curve_exp2( int32_t fine );
+
+#endif /* CURVES_H_INCLUDED */
@@ -0,0 +1,66 @@
+/*************************************************************************************************
+                                        --CYCLE COUNTER--
+
+	TC4 is the master of the 32-bit pair, TC5 only needs its bus clock. READREQ.RCONT keeps
+	the synchronized copy of COUNT up to date, so a read is a plain bus access a few cycles
+	behind the counter instead of a request and a sync wait.
+
+	TC6/TC7 form a second pair at 48 MHz / 64 (750 kHz) as the FreeRTOS run-time stats
+	time base, on SYNTH_FIXED_GCLK so it keeps its rate when the CPU clock scales down.
+	The cycle counter stays on generator 0 and counts CPU cycles at whatever rate. At that rate the kernel's 32-bit totals last about 95 minutes before they wrap,
+	against 89 seconds for the cycle counter.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "cycle_counter.h"
+#include "conf_synth.h"
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void tc32_sync( Tc *const hw )
+{
+	while(hw->COUNT32.STATUS.reg & TC_STATUS_SYNCBUSY);
+}
+
+static void tc32_start( Tc *const hw, uint8_t gclk_id, enum gclk_generator generator, uint32_t apb_mask, uint32_t prescaler )
+{
+	//free-running 32-bit count, pair clocked by the master's channel
+	struct system_gclk_chan_config gclk_chan_conf;
+
+	PM->APBCMASK.reg |= apb_mask;
+
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = generator;
+	system_gclk_chan_set_config(gclk_id, &gclk_chan_conf);
+	system_gclk_chan_enable(gclk_id);
+
+	hw->COUNT32.CTRLA.reg = TC_CTRLA_SWRST;
+	tc32_sync(hw);
+	while(hw->COUNT32.CTRLA.reg & TC_CTRLA_SWRST);
+
+	hw->COUNT32.CTRLA.reg = TC_CTRLA_MODE_COUNT32 | TC_CTRLA_WAVEGEN_NFRQ | prescaler;
+	tc32_sync(hw);
+
+	hw->COUNT32.READREQ.reg = TC_READREQ_RCONT | TC_READREQ_ADDR(TC_COUNT32_COUNT_OFFSET);
+	tc32_sync(hw);
+
+	hw->COUNT32.CTRLA.reg |= TC_CTRLA_ENABLE;
+	tc32_sync(hw);
+}
+
+void cycle_counter_init( void )
+{
+	tc32_start(TC4, TC4_GCLK_ID, GCLK_GENERATOR_0, PM_APBCMASK_TC4 | PM_APBCMASK_TC5, TC_CTRLA_PRESCALER_DIV1);
+}
+
+void run_time_counter_init( void )
+{
+	//called by the kernel from vTaskStartScheduler()
+	tc32_start(TC6, TC6_GCLK_ID, SYNTH_FIXED_GCLK, PM_APBCMASK_TC6 | PM_APBCMASK_TC7, TC_CTRLA_PRESCALER_DIV64);
+}
+
+uint32_t run_time_counter_read( void )
+{
+	return TC6->COUNT32.COUNT.reg;
+}
@@ -0,0 +1,30 @@
+/*************************************************************************************************
+                                        --CYCLE COUNTER--
+
+	Free-running 32-bit counter on the CPU clock for timing code on the M0+, which has no
+	DWT cycle counter. TC4 and TC5 are chained in COUNT32 mode and clocked from GCLK
+	generator 0, so one count is one CPU cycle and the counter wraps after ~89 s at 48 MHz.
+	Differences of two reads stay correct across the wrap.
+
+	A second, slower pair (TC6/TC7) is the time base for the FreeRTOS run-time stats.
+
+*************************************************************************************************/
+
+#ifndef CYCLE_COUNTER_H_INCLUDED
+#define CYCLE_COUNTER_H_INCLUDED
+
+#include <asf.h>
+
+/****** FUNCTION PROTOTYPES  ****/
+void cycle_counter_init( void );
+void run_time_counter_init( void );
+uint32_t run_time_counter_read( void );
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline uint32_t cycle_counter_read( void )
+{
+	//continuous read synchronization is on, COUNT can be read without a request
+	return TC4->COUNT32.COUNT.reg;
+}
+
+#endif /* CYCLE_COUNTER_H_INCLUDED */
@@ -0,0 +1,80 @@
+/*************************************************************************************************
+                                          --DAC CODES--
+
+	The clamp uses masks instead of branches, the M0+ has no SSAT and a taken branch costs
+	it two cycles; the compiler keeps the loop to loads, ALU ops and a halfword store. Where
+	there is an SSAT the clamp is that one instruction, the range is SAMPLE_BITS signed
+	either way.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "dac_codes.h"
+#include "synth_engine.h"
+#if SYNTH_MIX_SSAT
+#  include <arm_acle.h>
+#endif
+
+#if SYNTH_MIX_ASM && (SAMPLE_BITS != 12)
+#  error "dac_codes_m0.S is built for 12-bit DAC codes"
+#endif
+
+
+/***  APPLICATION FUNCTIONS  ****/
+SYNTH_RAM_CODE void dac_codes_c( const int32_t *mix, uint16_t *out, int stride, int count )
+{
+	int32_t x;
+	int32_t over;
+	int32_t under;
+	int i;
+
+	for(i=0; i<count; i++)
+	{
+		x = mix[i];
+		over = x - (DAC_MAX_CODE - DAC_MIDSCALE);
+		x -= over & ~(over >> 31);
+		under = x + DAC_MIDSCALE;
+		x -= under & (under >> 31);
+		out[i * stride] = (uint16_t) (x + DAC_MIDSCALE);
+	}
+}
+
+#if SYNTH_METERS
+SYNTH_RAM_CODE void dac_codes_meter( const int32_t *mix, uint16_t *out, int stride, int count, uint32_t *peak, uint32_t *sum_sq )
+{
+	//a clamped sample is at most 2048 from 0, its square fits 23 bits
+	uint32_t top = *peak;
+	uint32_t sum = *sum_sq;
+	uint32_t magnitude;
+	int32_t x;
+	int32_t over;
+	int32_t under;
+	int i;
+
+	for(i=0; i<count; i++)
+	{
+		x = mix[i];
+		over = x - (DAC_MAX_CODE - DAC_MIDSCALE);
+		x -= over & ~(over >> 31);
+		under = x + DAC_MIDSCALE;
+		x -= under & (under >> 31);
+		out[i * stride] = (uint16_t) (x + DAC_MIDSCALE);
+
+		magnitude = (uint32_t) ((x ^ (x >> 31)) - (x >> 31));
+		if(magnitude > top) top = magnitude;
+		sum += (uint32_t) (x * x);
+	}
+
+	*peak = top;
+	*sum_sq = sum;
+}
+#endif
+
+#if SYNTH_MIX_SSAT
+SYNTH_RAM_CODE void dac_codes_ssat( const int32_t *mix, uint16_t *out, int stride, int count )
+{
+	int i;
+
+	for(i=0; i<count; i++) out[i * stride] = (uint16_t) (__ssat(mix[i], SAMPLE_BITS) + DAC_MIDSCALE);
+}
+#endif
@@ -0,0 +1,41 @@
+/*************************************************************************************************
+                                          --DAC CODES--
+
+	The last step of every output channel: a control period of the mix, signed around 0 in
+	DAC units, clamped to the SAMPLE_BITS range and offset to unsigned DAC codes, each written
+	to every 'stride'th halfword of the frame so stereo interleaves. Takes the place of the
+	scalar saturate loop and of the four CMSIS-DSP passes that do the same job.
+
+	dac_codes_c() is the reference and the host build's. With SYNTH_MIX_ASM, dac_codes_m0()
+	in dac_codes_m0.S does it in Thumb-1 on the M0+: LDM takes four samples a go, each is
+	offset first so one branch clamps below 0 and one above DAC_MAX_CODE, and the count of
+	samples must be a multiple of four. With SYNTH_MIX_SSAT, on the M4F parts, dac_codes_ssat()
+	clamps each sample with one SSAT instead. The benchmark times them side by side.
+
+	With SYNTH_METERS, dac_codes_meter() is the C loop that also keeps the level: the
+	largest magnitude and the sum of squares of the clamped samples, added to the caller's.
+
+*************************************************************************************************/
+
+#ifndef DAC_CODES_H_INCLUDED
+#define DAC_CODES_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void dac_codes_c( const int32_t *mix, uint16_t *out, int stride, int count );
+#if SYNTH_MIX_ASM
+void dac_codes_m0( const int32_t *mix, uint16_t *out, int stride, int count );
+#  define dac_codes				dac_codes_m0
+#elif SYNTH_MIX_SSAT
+void dac_codes_ssat( const int32_t *mix, uint16_t *out, int stride, int count );
+#  define dac_codes				dac_codes_ssat
+#else
+#  define dac_codes				dac_codes_c
+#endif
+#if SYNTH_METERS
+void dac_codes_meter( const int32_t *mix, uint16_t *out, int stride, int count, uint32_t *peak, uint32_t *sum_sq );
+#endif
+
+#endif /* DAC_CODES_H_INCLUDED */
@@ -0,0 +1,256 @@
+/*************************************************************************************************
+                                        --DAC DMA OUTPUT--
+
+	A block-per-word target has one descriptor per word, triggered per block, so each trigger
+	moves exactly one word whatever the beat size. Otherwise a frame is a single descriptor
+	triggered per beat. Either way the last descriptor of each frame raises a block
+	interrupt, which is where played frames are handed back.
+
+	A change of the frame count is applied by the interrupt that starts frame 0. The only
+	links that change then belong to the last descriptors of later frames, which the DMAC
+	will not fetch for at least a frame.
+
+	The interrupt saves and restores CHID, so task code may select a channel and program it
+	without masking the DMAC interrupt.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "dac_dma.h"
+#include "trace_pins.h"
+
+
+/**********  DEFINE  ************/
+#define DAC_DMA_DESCRIPTORS	(	SYNTH_OUTPUT_FRAMES * SYNTH_FRAME_WORDS	) //the block-per-word worst case
+#define DAC_DMA_FRAME_BYTES	(	SYNTH_FRAME_WORDS * 2	)
+
+
+/*******   GLOBAL VARS  *********/
+//DMAC descriptor and write-back sections
+SYNTH_DMA_DESCRIPTOR static DmacDescriptor dma_base_descriptor[DMA_CHANNEL_COUNT];
+SYNTH_DMA_DESCRIPTOR static DmacDescriptor dma_writeback_descriptor[DMA_CHANNEL_COUNT];
+
+static dma_channel_handler_t dma_handlers[DMA_CHANNEL_COUNT];
+static bool dma_controller_ready;
+
+//linked descriptors for the remaining samples of the frame ring
+SYNTH_DMA_DESCRIPTOR static DmacDescriptor dma_chain[DAC_DMA_DESCRIPTORS - 1];
+
+static const struct dac_dma_target *dma_target;
+static int dma_frame_descriptors;
+static uint16_t (*dma_frames)[SYNTH_FRAME_WORDS];
+static dac_dma_callback_t dma_callback;
+static int dma_play_frame;
+static int dma_active_frames;
+static volatile int dma_pending_frames;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+void DMAC_Handler( void );
+static void dac_dma_frame_done( void );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void dac_dma_controller_init( void )
+{
+	//clock and reset the DMAC, once for all channels
+	if(dma_controller_ready) return;
+	dma_controller_ready = true;
+
+	PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+	PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+
+	DMAC->CTRL.reg &= ~DMAC_CTRL_DMAENABLE;
+	DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+	while(DMAC->CTRL.reg & DMAC_CTRL_SWRST);
+
+	DMAC->BASEADDR.reg = (uint32_t) dma_base_descriptor;
+	DMAC->WRBADDR.reg = (uint32_t) dma_writeback_descriptor;
+	DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xF);
+
+	NVIC_EnableIRQ(DMAC_IRQn);
+}
+
+DmacDescriptor *dac_dma_base_descriptor( int channel )
+{
+	return &dma_base_descriptor[channel];
+}
+
+void dac_dma_attach_channel( int channel, dma_channel_handler_t handler )
+{
+	dma_handlers[channel] = handler;
+}
+
+static DmacDescriptor *dac_dma_descriptor( int n )
+{
+	//descriptor 0 lives in the DMAC base section, the rest are chained
+	return (n == 0) ? &dma_base_descriptor[DAC_DMA_CHANNEL] : &dma_chain[n - 1];
+}
+
+void dac_dma_write_frame( uint16_t *frame, const uint16_t *samples )
+{
+	//converts rendered samples to output words on the way into the frame
+	uint16_t (*word)( uint16_t code, int index ) = dma_target->word;
+	int i;
+
+	for(i=0; i<SYNTH_FRAME_WORDS; i++) frame[i] = word(samples[i], i);
+}
+
+void dac_dma_conceal_frame( uint16_t *frame, const uint16_t *played_frame )
+{
+	//runs from the frame-played interrupt, a full sample period before the DMA reads the
+	//first word of the frame; continues from the frame just played, so back-to-back
+	//underruns carry on holding, fading or repeating; each output channel continues from its
+	//own last word
+	int i;
+#if (SYNTH_UNDERRUN_POLICY == SYNTH_UNDERRUN_FADE)
+	uint16_t code[SYNTH_OUTPUT_CHANNELS];
+	int c;
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) code[c] = dma_target->code(played_frame[SYNTH_FRAME_WORDS - SYNTH_OUTPUT_CHANNELS + c]);
+
+	for(i=0; i<SYNTH_FRAME_WORDS; i++)
+	{
+		c = i % SYNTH_OUTPUT_CHANNELS;
+		code[c] = dac_fade_step(code[c]);
+		frame[i] = dma_target->word(code[c], i);
+	}
+#elif (SYNTH_UNDERRUN_POLICY == SYNTH_UNDERRUN_REPEAT)
+	for(i=0; i<SYNTH_FRAME_WORDS; i++) frame[i] = played_frame[i];
+#else
+	for(i=0; i<SYNTH_FRAME_WORDS; i++) frame[i] = played_frame[SYNTH_FRAME_WORDS - SYNTH_OUTPUT_CHANNELS + (i % SYNTH_OUTPUT_CHANNELS)];
+#endif
+}
+
+static void dac_dma_link_ring( int count )
+{
+	//the last descriptor of frame count - 1 wraps around to the first one of frame 0
+	int frame;
+	int last;
+
+	for(frame=0; frame<SYNTH_OUTPUT_FRAMES; frame++)
+	{
+		last = frame * dma_frame_descriptors + dma_frame_descriptors - 1;
+		dac_dma_descriptor(last)->DESCADDR.reg =
+			(uint32_t) dac_dma_descriptor((frame < count - 1) ? last + 1 : 0);
+	}
+}
+
+void dac_dma_set_frames( int count )
+{
+	//takes effect when the ring next wraps to frame 0
+	if(count < 3) count = 3;
+	if(count > SYNTH_OUTPUT_FRAMES) count = SYNTH_OUTPUT_FRAMES;
+
+	dma_pending_frames = count;
+}
+
+int dac_dma_frames( void )
+{
+	return dma_pending_frames;
+}
+
+void dac_dma_init( const struct dac_dma_target *target, uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t callback )
+{
+	int frame;
+	int i;
+	int n;
+	int bytes;
+	DmacDescriptor *desc;
+
+	dma_target = target;
+	dma_frame_descriptors = target->block_per_word ? SYNTH_FRAME_WORDS : 1;
+	bytes = DAC_DMA_FRAME_BYTES / dma_frame_descriptors;
+	dma_frames = frames;
+	dma_callback = callback;
+	dma_play_frame = 0;
+	dma_active_frames = SYNTH_OUTPUT_FRAMES_ACTIVE;
+	dma_pending_frames = SYNTH_OUTPUT_FRAMES_ACTIVE;
+
+	//fill every frame with midscale words, silence that is also a valid MCP4821 command
+	for(frame=0; frame<SYNTH_OUTPUT_FRAMES; frame++)
+	{
+		for(i=0; i<SYNTH_FRAME_WORDS; i++) dma_frames[frame][i] = target->word(DAC_MIDSCALE, i);
+	}
+
+	//build circular descriptor ring, interrupt at the end of every frame
+	for(n=0; n<SYNTH_OUTPUT_FRAMES * dma_frame_descriptors; n++)
+	{
+		frame = n / dma_frame_descriptors;
+		i = n % dma_frame_descriptors;
+		desc = dac_dma_descriptor(n);
+
+		desc->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE(target->beat_size) | DMAC_BTCTRL_SRCINC |
+			((i == dma_frame_descriptors - 1) ? DMAC_BTCTRL_BLOCKACT_INT : DMAC_BTCTRL_BLOCKACT_NOACT);
+		desc->BTCNT.reg = bytes >> target->beat_size;
+		desc->SRCADDR.reg = (uint32_t) &dma_frames[frame][i * bytes / 2] + bytes; //end address when SRCINC is set
+		desc->DSTADDR.reg = target->data;
+		desc->DESCADDR.reg = (uint32_t) dac_dma_descriptor((n + 1) % (SYNTH_OUTPUT_FRAMES * dma_frame_descriptors));
+	}
+	dac_dma_link_ring(dma_active_frames);
+
+	dac_dma_controller_init();
+	dac_dma_attach_channel(DAC_DMA_CHANNEL, dac_dma_frame_done);
+
+	//a block per trigger for a block-per-word target, else a beat
+	DMAC->CHID.reg = DMAC_CHID_ID(DAC_DMA_CHANNEL);
+	DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+	DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(target->trigger) |
+		(target->block_per_word ? DMAC_CHCTRLB_TRIGACT_BLOCK : DMAC_CHCTRLB_TRIGACT_BEAT);
+	DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+}
+
+void dac_dma_start( void )
+{
+	DMAC->CHID.reg = DMAC_CHID_ID(DAC_DMA_CHANNEL);
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+SYNTH_RAM_CODE void DMAC_Handler( void )
+{
+	//one handler per channel with an interrupt pending
+	uint8_t chid = DMAC->CHID.reg;
+	uint32_t pending = DMAC->INTSTATUS.reg;
+	int channel;
+
+	for(channel=0; channel<DMA_CHANNEL_COUNT; channel++)
+	{
+		if(!(pending & (1ul << channel))) continue;
+
+		DMAC->CHID.reg = DMAC_CHID_ID(channel);
+		if(dma_handlers[channel] != NULL) dma_handlers[channel]();
+		else DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+	}
+
+	DMAC->CHID.reg = chid;
+}
+
+SYNTH_RAM_CODE static void dac_dma_frame_done( void )
+{
+	//the channel is already selected
+	uint16_t *played_frame;
+
+	if(DMAC->CHINTFLAG.reg & DMAC_CHINTFLAG_TCMPL)
+	{
+		DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+		TRACE_PIN_HIGH(SYNTH_TRACE_PIN_DAC);
+
+		played_frame = dma_frames[dma_play_frame];
+		if(++dma_play_frame >= dma_active_frames)
+		{
+			//frame 0 is playing now, safe to relink the end of the ring
+			dma_play_frame = 0;
+			if(dma_pending_frames != dma_active_frames)
+			{
+				dma_active_frames = dma_pending_frames;
+				dac_dma_link_ring(dma_active_frames);
+			}
+		}
+
+		if(dma_callback != NULL) dma_callback(played_frame, dma_frames[dma_play_frame]);
+		TRACE_PIN_LOW(SYNTH_TRACE_PIN_DAC);
+	}
+}
@@ -0,0 +1,80 @@
+/*************************************************************************************************
+                                        --DAC DMA OUTPUT--
+
+	DMAC-backed output ring shared by the output backends of audio_output.h. The output
+	frames form a circular chain of DMA descriptors streamed to the backend's data register,
+	described by a struct dac_dma_target. A callback runs from the DMAC interrupt each time a
+	frame has been played out, handing that frame back to be rendered again. Only the first
+	dac_dma_frames() frames of the ring play; dac_dma_set_frames() relinks the ring at run
+	time to trade latency against headroom.
+
+	Frames only ever hold finished output words: the renderer works in a scratch block of
+	DAC codes and dac_dma_write_frame() converts with the target's word() while copying. If
+	a frame comes up for playback before it was refilled, dac_dma_conceal_frame() overwrites
+	the stale samples according to SYNTH_UNDERRUN_POLICY, reading the codes back with the
+	target's code().
+
+	A target either takes one DMA block per word, for a peripheral where every trigger must
+	move exactly one word (the MCP4821 on SPI, where each word needs its own slave select),
+	or one block per frame with a beat per trigger (the internal DAC, I2S). A stereo frame
+	interleaves left and right words.
+
+	The module owns the DMAC itself: its descriptor sections, clocks and interrupt. Other
+	drivers bring it up with dac_dma_controller_init(), which is safe to call more than
+	once, and take a completion handler on their channel with dac_dma_attach_channel().
+
+*************************************************************************************************/
+
+#ifndef DAC_DMA_H_INCLUDED
+#define DAC_DMA_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "synth_engine.h"
+
+/**********  DEFINE  ************/
+#define DAC_DMA_CHANNEL		(	0	)
+#define FLASH_DMA_RX_CHANNEL	(	1	)
+#define FLASH_DMA_TX_CHANNEL	(	2	)
+#define MIDI_DMA_RX_CHANNEL		(	3	)
+#define MIDI_DMA_TX_CHANNEL		(	4	)
+#define PANEL_DMA_CHANNEL		(	5	)
+#define AUDIO_INPUT_DMA_CHANNEL	(	6	)
+#define DMA_CHANNEL_COUNT		(	7	)
+
+/********   TYPE DEFS  **********/
+typedef void (*dac_dma_callback_t)(uint16_t *played_frame, uint16_t *next_frame);
+typedef void (*dma_channel_handler_t)(void);
+
+struct dac_dma_target{
+	uint32_t data;								//peripheral data register
+	uint8_t trigger;							//DMAC trigger source
+	uint8_t beat_size;							//DMAC_BTCTRL_BEATSIZE_*_Val
+	bool block_per_word;						//one trigger per word, else one per beat
+	uint16_t (*word)( uint16_t code, int index );	//DAC code to output word, index in the frame
+	uint16_t (*code)( uint16_t word );			//and back, for concealment
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void dac_dma_controller_init( void );
+DmacDescriptor *dac_dma_base_descriptor( int channel );
+void dac_dma_attach_channel( int channel, dma_channel_handler_t handler );
+void dac_dma_init( const struct dac_dma_target *target, uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t callback );
+void dac_dma_start( void );
+void dac_dma_set_frames( int count );
+int dac_dma_frames( void );
+void dac_dma_write_frame( uint16_t *frame, const uint16_t *samples );
+void dac_dma_conceal_frame( uint16_t *frame, const uint16_t *played_frame );
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline uint16_t dac_fade_step( uint16_t code )
+{
+	//one sample of the underrun fade, rounds away from midscale so the glide ends on it
+	int32_t d = (int32_t) code - DAC_MIDSCALE;
+
+	if(d > 0) d += (1 << SYNTH_UNDERRUN_FADE_SHIFT) - 1;
+
+	return (uint16_t) (code - (d >> SYNTH_UNDERRUN_FADE_SHIFT));
+}
+
+#endif /* DAC_DMA_H_INCLUDED */
@@ -0,0 +1,160 @@
+/*************************************************************************************************
+                                         --DEBUG UART--
+
+	Producers are any task, so claiming ring space and deciding whether a write job has to
+	be started happen with interrupts masked, for a few instructions per byte. A job covers
+	the bytes from the tail up to the head or the end of the ring, whichever comes first.
+	Its transmit-complete callback frees them and starts the next stretch, so a long
+	message costs one interrupt per byte plus one per stretch.
+
+	Until debug_uart_attach() is called, debug_uart_write_wait() falls back to the ASF
+	busy-wait path and debug_uart_flush() returns at once; with no console at all
+	(power_save.h) it drops the bytes.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "debug_uart.h"
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void debug_uart_start_job( void );
+static bool debug_uart_push( uint8_t c );
+static int debug_uart_putchar( void volatile *module, char c );
+static void debug_uart_sent_callback( struct usart_module *const module );
+
+
+/*******   GLOBAL VARS  *********/
+static struct usart_module *debug_usart;
+static uint8_t tx_ring[SYNTH_DEBUG_UART_TX_SIZE];
+static volatile uint16_t tx_head;
+static volatile uint16_t tx_tail;
+static volatile uint16_t tx_job_length;		//bytes in the write job running, 0 when idle
+static volatile uint32_t tx_dropped;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void debug_uart_attach( struct usart_module *module )
+{
+	//after stdio_serial_init(), with no write pending
+	debug_usart = module;
+	usart_register_callback(module, debug_uart_sent_callback, USART_CALLBACK_BUFFER_TRANSMITTED);
+	usart_enable_callback(module, USART_CALLBACK_BUFFER_TRANSMITTED);
+	ptr_put = debug_uart_putchar;
+}
+
+static void debug_uart_start_job( void )
+{
+	//interrupts masked or from the callback, sends the stretch at the tail
+	uint16_t tail = tx_tail;
+	uint16_t length = (uint16_t) (tx_head - tail);
+	uint16_t to_end = SYNTH_DEBUG_UART_TX_SIZE - (tail & DEBUG_UART_TX_MASK);
+
+	if(length > to_end) length = to_end;
+	tx_job_length = length;
+	if(length) usart_write_buffer_job(debug_usart, &tx_ring[tail & DEBUG_UART_TX_MASK], length);
+}
+
+static bool debug_uart_push( uint8_t c )
+{
+	//false when the ring is full
+	irqflags_t flags;
+	uint16_t head;
+
+	flags = cpu_irq_save();
+	head = tx_head;
+	if((uint16_t) (head - tx_tail) >= SYNTH_DEBUG_UART_TX_SIZE)
+	{
+		cpu_irq_restore(flags);
+		return false;
+	}
+	tx_ring[head & DEBUG_UART_TX_MASK] = c;
+	tx_head = head + 1;
+	if(tx_job_length == 0) debug_uart_start_job();
+	cpu_irq_restore(flags);
+
+	return true;
+}
+
+static int debug_uart_putchar( void volatile *module, char c )
+{
+	//stdio's per character hook, never waits
+	(void) module;
+
+	if(debug_uart_push((uint8_t) c) == false) tx_dropped++;
+
+	return 0;
+}
+
+bool debug_uart_write( const void *data, uint16_t length )
+{
+	//all or nothing, never waits; a message that does not fit counts as dropped
+	const uint8_t *bytes = (const uint8_t *) data;
+	irqflags_t flags;
+	uint16_t head;
+	uint16_t i;
+
+	if(debug_usart == NULL)
+	{
+		debug_uart_write_wait(data, length);
+		return true;
+	}
+
+	flags = cpu_irq_save();
+	head = tx_head;
+	if((uint16_t) (head - tx_tail) + (uint32_t) length > SYNTH_DEBUG_UART_TX_SIZE)
+	{
+		cpu_irq_restore(flags);
+		tx_dropped += length;
+		return false;
+	}
+	for(i=0; i<length; i++) tx_ring[(head + i) & DEBUG_UART_TX_MASK] = bytes[i];
+	tx_head = head + length;
+	if(tx_job_length == 0) debug_uart_start_job();
+	cpu_irq_restore(flags);
+
+	return true;
+}
+
+void debug_uart_write_wait( const void *data, uint16_t length )
+{
+	//no drops, one tick at a time until there is room
+	const uint8_t *bytes = (const uint8_t *) data;
+	uint16_t i;
+
+	for(i=0; i<length; i++)
+	{
+		if(debug_usart == NULL)
+		{
+			if(stdio_base == NULL) return;
+			usart_serial_putchar((struct usart_module *) stdio_base, bytes[i]);
+			continue;
+		}
+		while(debug_uart_push(bytes[i]) == false) vTaskDelay(1);
+	}
+}
+
+void debug_uart_flush( void )
+{
+	if(debug_usart == NULL) return;
+
+	while(tx_head != tx_tail) vTaskDelay(1);
+}
+
+uint32_t debug_uart_dropped( void )
+{
+	return tx_dropped;
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+static void debug_uart_sent_callback( struct usart_module *const module )
+{
+	//the stretch is out, frees it and sends whatever was queued meanwhile
+	(void) module;
+
+	tx_tail = tx_tail + tx_job_length;
+	debug_uart_start_job();
+}
@@ -0,0 +1,39 @@
+/*************************************************************************************************
+                                         --DEBUG UART--
+
+	Buffered transmit for the EDBG console. With SYNTH_DEBUG_UART_BUFFERED set, main.c calls
+	debug_uart_attach(), which points stdio's putchar at a ring of SYNTH_DEBUG_UART_TX_SIZE
+	bytes emptied with interrupt-driven write jobs, so a printf only copies its text and
+	returns. When the ring is full the rest of the text is dropped and counted instead of
+	waiting for the line.
+
+	Output before the attach, the start-up banner, goes out with the ASF busy-wait writes.
+	debug_uart_write() queues a whole message or, when it does not fit, none of it, for
+	framed output a receiver has to resync on. debug_uart_write_wait() is for output that
+	must not lose bytes, such as binary dumps; it waits for room in the ring, from a task
+	only. debug_uart_flush() waits for the ring to drain, so a long reply can start with
+	the whole ring free.
+
+*************************************************************************************************/
+
+#ifndef DEBUG_UART_H_INCLUDED
+#define DEBUG_UART_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define DEBUG_UART_TX_MASK		(	SYNTH_DEBUG_UART_TX_SIZE - 1	)
+
+#if (SYNTH_DEBUG_UART_TX_SIZE & DEBUG_UART_TX_MASK)
+#  error "SYNTH_DEBUG_UART_TX_SIZE must be a power of two"
+#endif
+
+/****** FUNCTION PROTOTYPES  ****/
+void debug_uart_attach( struct usart_module *module );
+bool debug_uart_write( const void *data, uint16_t length );
+void debug_uart_write_wait( const void *data, uint16_t length );
+void debug_uart_flush( void );
+uint32_t debug_uart_dropped( void );
+
+#endif /* DEBUG_UART_H_INCLUDED */
@@ -0,0 +1,206 @@
+/*************************************************************************************************
+                                          --DELAY LINE--
+
+	The positions are free running sample counters masked on every access, so neither
+	ever needs a compare against the length. A tap time of zero would read the slot about
+	to be written, one full length back, so times are kept between 1 and the length - 1.
+
+	The feedback product is truncated towards zero; a plain shift floors negative samples,
+	and a tail would then settle on -1 forever instead of dying away.
+
+	The chorus triangle is the LFO phase folded at its top bit, 15 bits of it scale the
+	sweep. Per sample that is one add, two multiplies for the tap time and the
+	interpolation and two line reads more than the plain delay, around 40 cycles on the M0+
+	with the writes and mixing, under 2% of the CPU per channel at 20 kHz.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "delay.h"
+#include "conf_synth.h"
+
+
+/**********  DEFINE  ************/
+#define DELAY_SAMPLE_MAX		(	32767	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int32_t delay_clamp( int32_t x );
+static int32_t delay_echo( int32_t tap, int32_t feedback );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void delay_init( struct delay *delay, int16_t *line, uint32_t length )
+{
+	//length must be a power of two
+	delay->line = line;
+	delay->mask = length - 1;
+	delay->write = 0;
+	delay_set(delay, length / 2, 0, 0);
+	delay_clear(delay);
+}
+
+void delay_clear( struct delay *delay )
+{
+	uint32_t i;
+
+	for(i=0; i<=delay->mask; i++) delay->line[i] = 0;
+	delay->quiet = delay->mask + 1;
+}
+
+bool delay_idle( const struct delay *delay )
+{
+	return delay->quiet > delay->mask;
+}
+
+void delay_set( struct delay *delay, uint32_t time, int32_t feedback, int32_t mix )
+{
+	if(time < 1) time = 1;
+	if(time > delay->mask) time = delay->mask;
+	if(feedback > DELAY_GAIN_MAX) feedback = DELAY_GAIN_MAX;
+	if(mix > DELAY_GAIN_MAX) mix = DELAY_GAIN_MAX;
+
+	delay->time = time;
+	delay->feedback = (feedback < 0) ? 0 : feedback;
+	delay->mix = (mix < 0) ? 0 : mix;
+}
+
+SYNTH_RAM_CODE static int32_t delay_clamp( int32_t x )
+{
+	//branch-free clamp to the int16 range of the line
+	int32_t over = x - DELAY_SAMPLE_MAX;
+	int32_t under;
+
+	x -= over & ~(over >> 31);
+	under = x + DELAY_SAMPLE_MAX;
+	x -= under & (under >> 31);
+
+	return x;
+}
+
+SYNTH_RAM_CODE static inline int32_t delay_echo( int32_t tap, int32_t feedback )
+{
+	//feedback product truncated towards zero
+	int32_t echo = tap * feedback;
+
+	return (echo + ((echo >> 31) & ((1l << DELAY_GAIN_SHIFT) - 1))) >> DELAY_GAIN_SHIFT;
+}
+
+SYNTH_RAM_CODE void delay_process( struct delay *delay, int32_t *buffer, int count )
+{
+	//processes the buffer in place
+	int16_t *line = delay->line;
+	uint32_t mask = delay->mask;
+	uint32_t write = delay->write;
+	uint32_t read = write - delay->time;
+	int32_t feedback = delay->feedback;
+	int32_t mix = delay->mix;
+	int32_t tap;
+	int32_t in;
+	int32_t written = 0;
+	int i;
+
+	for(i=0; i<count; i++)
+	{
+		tap = line[read++ & mask];
+		in = delay_clamp(buffer[i] + delay_echo(tap, feedback));
+		line[write++ & mask] = (int16_t) in;
+		written |= in;
+		buffer[i] += (tap * mix) >> DELAY_GAIN_SHIFT;
+	}
+
+	delay->write = write;
+	if(written) delay->quiet = 0;
+	else if(delay->quiet <= mask) delay->quiet += count;
+}
+
+void chorus_init( struct chorus *chorus, int16_t *line, uint32_t length, uint32_t phase )
+{
+	//length a power of two up to CHORUS_FRAMES_MAX, phase is where the LFO starts
+	uint32_t i;
+
+	chorus->line = line;
+	chorus->mask = length - 1;
+	chorus->write = 0;
+	chorus->phase = phase;
+	chorus_set(chorus, (length / 2) << DELAY_FRAC_BITS, 0, 0, 0, 0);
+
+	for(i=0; i<length; i++) line[i] = 0;
+	chorus->quiet = length;
+}
+
+bool chorus_idle( const struct chorus *chorus )
+{
+	return chorus->quiet > chorus->mask;
+}
+
+void chorus_skip( struct chorus *chorus, int count )
+{
+	//an idle line reads back zero wherever the tap is, only the LFO has to move on
+	chorus->phase += chorus->rate_inc * (uint32_t) count;
+}
+
+void chorus_set( struct chorus *chorus, uint32_t delay, uint32_t depth, uint32_t rate_inc, int32_t feedback, int32_t mix )
+{
+	//delay and depth in Q15 samples, the sweep is kept at least one sample back and short
+	//of the line length less the interpolation sample
+	uint32_t low_min = 1ul << DELAY_FRAC_BITS;
+	uint32_t high_max = (chorus->mask - 1) << DELAY_FRAC_BITS;
+
+	if(depth > high_max - low_min) depth = high_max - low_min;
+	if(delay < low_min + depth / 2) delay = low_min + depth / 2;
+	if(delay > high_max - depth / 2) delay = high_max - depth / 2;
+	if(feedback > DELAY_GAIN_MAX) feedback = DELAY_GAIN_MAX;
+	if(mix > DELAY_GAIN_MAX) mix = DELAY_GAIN_MAX;
+
+	chorus->low = delay - depth / 2;
+	chorus->span = depth;
+	chorus->rate_inc = rate_inc;
+	chorus->feedback = (feedback < 0) ? 0 : feedback;
+	chorus->mix = (mix < 0) ? 0 : mix;
+}
+
+SYNTH_RAM_CODE void chorus_process( struct chorus *chorus, int32_t *buffer, int count )
+{
+	//processes the buffer in place
+	int16_t *line = chorus->line;
+	uint32_t mask = chorus->mask;
+	uint32_t write = chorus->write;
+	uint32_t phase = chorus->phase;
+	uint32_t rate_inc = chorus->rate_inc;
+	uint32_t low = chorus->low;
+	uint32_t span = chorus->span >> 9;
+	int32_t feedback = chorus->feedback;
+	int32_t mix = chorus->mix;
+	uint32_t tri;
+	uint32_t offset;
+	uint32_t read;
+	int32_t a;
+	int32_t b;
+	int32_t tap;
+	int32_t in;
+	int32_t written = 0;
+	int i;
+
+	for(i=0; i<count; i++)
+	{
+		phase += rate_inc;
+		tri = (phase ^ (0u - (phase >> 31))) >> 16;
+		offset = low + ((tri * span) >> 6);
+
+		read = write - (offset >> DELAY_FRAC_BITS);
+		a = line[read & mask];
+		b = line[(read - 1) & mask];
+		tap = a + (((b - a) * (int32_t) (offset & ((1ul << DELAY_FRAC_BITS) - 1))) >> DELAY_FRAC_BITS);
+
+		in = delay_clamp(buffer[i] + delay_echo(tap, feedback));
+		line[write++ & mask] = (int16_t) in;
+		written |= in;
+		buffer[i] += (tap * mix) >> DELAY_GAIN_SHIFT;
+	}
+
+	chorus->write = write;
+	chorus->phase = phase;
+	if(written) chorus->quiet = 0;
+	else if(chorus->quiet <= mask) chorus->quiet += count;
+}
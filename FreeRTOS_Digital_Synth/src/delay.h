@@ -0,0 +1,73 @@
+/*************************************************************************************************
+                                          --DELAY LINE--
+
+	Feedback delay on the master mix, a circular buffer of 16-bit samples in SRAM whose
+	length is a power of two, so the read and write positions wrap with a mask. Each sample
+	reads the tap time samples back, writes the input plus the tap scaled by feedback, and
+	adds the tap scaled by mix to the output. Signals are the 12-bit DAC range around zero,
+	the line saturates at the Q15 range so runaway feedback stays bounded.
+
+	The chorus is the same line with a moving tap: a triangle LFO sweeps the tap time
+	between delay - depth / 2 and delay + depth / 2, in Q15 samples, and the tap is linearly
+	interpolated between the two samples either side. A 10..25 ms delay without feedback
+	is a chorus, 1..5 ms with feedback a flanger. Lines are at most 1024 samples, which
+	keeps the sweep multiply within 32 bits.
+
+	Both count the samples since they last wrote anything but zero. Once that covers the
+	whole line the stage is idle, a silent block through it comes out silent and leaves it
+	as it was, so the engine can skip it.
+
+*************************************************************************************************/
+
+#ifndef DELAY_H_INCLUDED
+#define DELAY_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+//feedback and mix are Q8, 256 = unity
+#define DELAY_GAIN_SHIFT		(	8	)
+#define DELAY_GAIN_MAX			(	256	)
+
+//chorus tap times are Q15 samples
+#define DELAY_FRAC_BITS			(	15	)
+#define CHORUS_FRAMES_MAX		(	1024	)
+
+/********   TYPE DEFS  **********/
+struct delay{
+	int16_t *line;
+	uint32_t mask;
+	uint32_t write;
+	uint32_t time;
+	uint32_t quiet;
+	int32_t feedback;
+	int32_t mix;
+};
+
+struct chorus{
+	int16_t *line;
+	uint32_t mask;
+	uint32_t write;
+	uint32_t phase;
+	uint32_t rate_inc;
+	uint32_t low;
+	uint32_t span;
+	uint32_t quiet;
+	int32_t feedback;
+	int32_t mix;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void delay_init( struct delay *delay, int16_t *line, uint32_t length );
+void delay_clear( struct delay *delay );
+void delay_set( struct delay *delay, uint32_t time, int32_t feedback, int32_t mix );
+void delay_process( struct delay *delay, int32_t *buffer, int count );
+bool delay_idle( const struct delay *delay );
+void chorus_init( struct chorus *chorus, int16_t *line, uint32_t length, uint32_t phase );
+void chorus_set( struct chorus *chorus, uint32_t delay, uint32_t depth, uint32_t rate_inc, int32_t feedback, int32_t mix );
+void chorus_process( struct chorus *chorus, int32_t *buffer, int count );
+bool chorus_idle( const struct chorus *chorus );
+void chorus_skip( struct chorus *chorus, int count );
+
+#endif /* DELAY_H_INCLUDED */
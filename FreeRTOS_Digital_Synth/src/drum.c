@@ -0,0 +1,202 @@
+/*************************************************************************************************
+                                            --DRUM--
+
+	The kit is const and stays in flash; the factors drum_set_rate() derives from it are one
+	pair of words per piece in SRAM. A voice keeps its piece, its end increment, what is left
+	of the sweep and the hat's low-pass state.
+
+	The snare's tone share is out of 256, the rest is noise: one multiply per sample blends
+	the two. The hat's low-pass follows the noise by 1 / 2^shift per sample, the larger the
+	shift the lower the corner and the darker the cymbal.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "drum.h"
+#include "synth_engine.h"
+
+
+/**********  DEFINE  ************/
+#define DRUM_KIT_SIZE			(	DRUM_NOTE_LAST - DRUM_NOTE_FIRST + 1	)
+
+//a choked hit closes 6 dB per control tick
+#define DRUM_CHOKE_SHIFT		(	1	)
+
+
+/********   TYPE DEFS  **********/
+enum drum_kind{
+	DRUM_KICK,
+	DRUM_SNARE,
+	DRUM_HAT
+};
+
+struct drum_piece{
+	uint8_t kind;
+	uint8_t choke;			//group a hit fades out the others of, 0 for none
+	uint8_t tone;			//snare: share of the sine, out of 256
+	uint8_t hp_shift;		//hat: low-pass step
+	uint16_t start_hz;
+	uint16_t end_hz;
+	uint16_t sweep_ms;		//the fall to within 60 dB of the end pitch
+	uint16_t decay_ms;		//the fall of 60 dB in level
+};
+
+struct drum_factors{
+	uint32_t sweep;
+	uint32_t decay;
+};
+
+struct drum_voice{
+	uint32_t inc_end;
+	uint32_t sweep;
+	int32_t low;
+	uint8_t piece;
+};
+
+
+/*******   GLOBAL VARS  *********/
+//General MIDI notes 35 to 51
+static const struct drum_piece drum_kit[DRUM_KIT_SIZE] = {
+	{ DRUM_KICK,  0,   0, 0, 110,  42,  50,  500 },	//35 acoustic bass drum
+	{ DRUM_KICK,  0,   0, 0, 150,  48,  35,  400 },	//36 bass drum
+	{ DRUM_SNARE, 0, 160, 0, 420, 420,   0,   50 },	//37 side stick
+	{ DRUM_SNARE, 0,  90, 0, 200, 170,  30,  200 },	//38 acoustic snare
+	{ DRUM_SNARE, 0,   0, 0,   0,   0,   0,  150 },	//39 hand clap
+	{ DRUM_SNARE, 0,  60, 0, 230, 190,  20,  160 },	//40 electric snare
+	{ DRUM_KICK,  0,   0, 0, 100,  75, 100,  450 },	//41 low floor tom
+	{ DRUM_HAT,   1,   0, 1,   0,   0,   0,   60 },	//42 closed hi-hat
+	{ DRUM_KICK,  0,   0, 0, 120,  90, 100,  420 },	//43 high floor tom
+	{ DRUM_HAT,   1,   0, 1,   0,   0,   0,  100 },	//44 pedal hi-hat
+	{ DRUM_KICK,  0,   0, 0, 145, 110,  90,  380 },	//45 low tom
+	{ DRUM_HAT,   1,   0, 1,   0,   0,   0,  500 },	//46 open hi-hat
+	{ DRUM_KICK,  0,   0, 0, 170, 130,  80,  350 },	//47 low-mid tom
+	{ DRUM_KICK,  0,   0, 0, 200, 150,  70,  320 },	//48 hi-mid tom
+	{ DRUM_HAT,   0,   0, 2,   0,   0,   0, 1500 },	//49 crash cymbal
+	{ DRUM_KICK,  0,   0, 0, 235, 175,  60,  300 },	//50 high tom
+	{ DRUM_HAT,   0,   0, 3,   0,   0,   0, 1000 },	//51 ride cymbal
+};
+
+static struct drum_factors drum_factors[DRUM_KIT_SIZE];
+static uint32_t drum_inc_per_hz;
+
+static struct drum_voice drum_voices[SYNTH_MAX_VOICES];
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void drum_set_rate( uint32_t sample_rate )
+{
+	//engine init and every sample rate change, the kit's times in per-tick factors
+	int i;
+
+	drum_inc_per_hz = (uint32_t) (((uint64_t) 1 << 32) / sample_rate);
+	for(i=0; i<DRUM_KIT_SIZE; i++)
+	{
+		drum_factors[i].sweep = env_factor_from_ms(drum_kit[i].sweep_ms, sample_rate);
+		drum_factors[i].decay = env_factor_from_ms(drum_kit[i].decay_ms, sample_rate);
+	}
+}
+
+bool drum_in_kit( uint8_t note )
+{
+	return (note >= DRUM_NOTE_FIRST) && (note <= DRUM_NOTE_LAST);
+}
+
+uint32_t drum_voice_start( int voice, uint8_t note )
+{
+	//note-on of a note in the kit; returns the increment of the first tick
+	struct drum_voice *d = &drum_voices[voice];
+	const struct drum_piece *piece;
+
+	d->piece = (uint8_t) (note - DRUM_NOTE_FIRST);
+	piece = &drum_kit[d->piece];
+	d->inc_end = piece->end_hz * drum_inc_per_hz;
+	d->sweep = (piece->start_hz - piece->end_hz) * drum_inc_per_hz;
+	d->low = 0;
+
+	return d->inc_end + d->sweep;
+}
+
+uint8_t drum_choke( int voice )
+{
+	return drum_kit[drum_voices[voice].piece].choke;
+}
+
+uint32_t drum_sweep( int voice )
+{
+	//one control tick of the pitch fall; returns the increment for it
+	struct drum_voice *d = &drum_voices[voice];
+
+	if(d->sweep) d->sweep = (uint32_t) (((uint64_t) d->sweep * drum_factors[d->piece].sweep) >> CURVE_RATIO_SHIFT);
+
+	return d->inc_end + d->sweep;
+}
+
+SYNTH_RAM_CODE int32_t drum_env_advance( int voice, uint8_t *stage, int32_t level )
+{
+	//the level at the end of the next control tick; a hit decays from full, a choked one
+	//closes fast, both are cut at ENV_FLOOR
+	if(*stage == ENV_RELEASE) level >>= DRUM_CHOKE_SHIFT;
+	else level = (int32_t) (((uint32_t) level * drum_factors[drum_voices[voice].piece].decay) >> CURVE_RATIO_SHIFT);
+
+	if(level <= ENV_FLOOR)
+	{
+		level = 0;
+		*stage = ENV_IDLE;
+	}
+
+	return level;
+}
+
+SYNTH_RAM_CODE void drum_render( int voice, int32_t *out, int count, uint32_t *phase, uint32_t inc, uint32_t *lfsr, int32_t gain, int32_t step )
+{
+	//adds 'count' samples of the voice's piece to 'out', the pitch held for the segment
+	struct drum_voice *d = &drum_voices[voice];
+	const struct drum_piece *piece = &drum_kit[d->piece];
+	uint32_t ph = *phase;
+	uint32_t r = *lfsr;
+	int32_t noise_share = 256 - piece->tone;
+	int32_t low = d->low;
+	int shift = piece->hp_shift;
+	int32_t tone;
+	int32_t noise;
+	int i;
+
+	switch(piece->kind)
+	{
+		case DRUM_KICK:
+		for(i=0; i<count; i++)
+		{
+			out[i] += (sine_lookup(ph) * gain) >> MIX_SHIFT;
+			ph += inc;
+			gain += step;
+		}
+		break;
+
+		case DRUM_SNARE:
+		for(i=0; i<count; i++)
+		{
+			r = (r >> 1) ^ ((0u - (r & 1u)) & NOISE_LFSR_TAPS);
+			noise = (r & 1u) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1);
+			tone = sine_lookup(ph);
+			out[i] += ((tone + (((noise - tone) * noise_share) >> 8)) * gain) >> MIX_SHIFT;
+			ph += inc;
+			gain += step;
+		}
+		break;
+
+		default:
+		for(i=0; i<count; i++)
+		{
+			r = (r >> 1) ^ ((0u - (r & 1u)) & NOISE_LFSR_TAPS);
+			noise = (r & 1u) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1);
+			low += (noise - low) >> shift;
+			out[i] += ((noise - low) * gain) >> MIX_SHIFT;
+			gain += step;
+		}
+		break;
+	}
+
+	*phase = ph;
+	*lfsr = r;
+	d->low = low;
+}
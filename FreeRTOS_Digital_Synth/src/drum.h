@@ -0,0 +1,46 @@
+/*************************************************************************************************
+                                            --DRUM--
+
+	Percussion for the DRUM voice type, one kit on a fixed map of the General MIDI drum
+	notes 35 to 51; other notes on a DRUM channel are not played. Each piece is one of
+	three kernels, all on what a voice already has, its phase accumulator and its LFSR:
+
+		kick	the sine table with its pitch falling from a start to an end frequency,
+				also the toms
+		snare	a share of that swept sine under LFSR noise, also the side stick and,
+				with no tone, the clap
+		hat		LFSR noise less a one-pole low-pass of itself, also the cymbals
+
+	A hit is a one-shot: full level from its first sample, falling exponentially by 60 dB
+	over the piece's decay time at control rate, and a note-off does not end it. The sweep
+	closes the same way on the distance to the end pitch. Neither the channel's envelope,
+	its modulation nor bend or glide touch a drum, so past its kernel a hit costs two
+	multiplies per control tick. The hi-hats share a choke group: a closed or pedal hat
+	fades a ringing open one out within a few ticks.
+
+	Frequencies and times are in the kit table of drum.c; drum_set_rate() turns them into
+	increments and per-tick factors for the sample rate, so a note-on is a table lookup.
+
+*************************************************************************************************/
+
+#ifndef DRUM_H_INCLUDED
+#define DRUM_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define DRUM_NOTE_FIRST			(	35	)
+#define DRUM_NOTE_LAST			(	51	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void drum_set_rate( uint32_t sample_rate );
+bool drum_in_kit( uint8_t note );
+uint32_t drum_voice_start( int voice, uint8_t note );
+uint8_t drum_choke( int voice );
+uint32_t drum_sweep( int voice );
+int32_t drum_env_advance( int voice, uint8_t *stage, int32_t level );
+void drum_render( int voice, int32_t *out, int count, uint32_t *phase, uint32_t inc, uint32_t *lfsr, int32_t gain, int32_t step );
+
+#endif /* DRUM_H_INCLUDED */
@@ -0,0 +1,124 @@
+/*************************************************************************************************
+                                         --ENVELOPE--
+
+	Linear ADSR as an integer rate/target state machine. It is advanced once per control
+	tick, the renderer ramps the voice gain linearly between two consecutive tick values,
+	so the per-sample cost is one add.
+
+	With SYNTH_ENV_EXPONENTIAL the decay and release instead close a fixed fraction of the
+	distance to their target every tick, the time set being how long they take to fall by
+	60 dB; the fraction comes from curve_exp2() when the times change. The release is cut
+	to silence at -60 dB. The attack stays linear.
+
+*************************************************************************************************/
+
+#ifndef ENVELOPE_H_INCLUDED
+#define ENVELOPE_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+#include "curves.h"
+
+/**********  DEFINE  ************/
+//envelope level is Q15, full scale is 1.0
+#define ENV_FULL				(	1l << 15	)
+
+//level the exponential segments end at, -60 dB below full scale or the sustain level
+#define ENV_FLOOR				(	ENV_FULL >> 10	)
+#define ENV_FALL_DB				(	60	)
+
+/********   TYPE DEFS  **********/
+enum env_stage{
+	ENV_IDLE,
+	ENV_ATTACK,
+	ENV_DECAY,
+	ENV_SUSTAIN,
+	ENV_RELEASE
+};
+
+//rates are level change per control tick, the exponential segments' factors per tick Q16
+struct env_params{
+	int32_t attack_rate;
+	int32_t decay_rate;
+	int32_t sustain_level;
+	int32_t release_rate;
+	uint32_t decay_factor;
+	uint32_t release_factor;
+};
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline int32_t env_rate_from_ms( uint32_t ms, uint32_t sample_rate )
+{
+	//full scale travel in ms, evaluated when parameters or the sample rate change, never per tick
+	uint32_t samples = (uint32_t) (((uint64_t) ms * sample_rate) / 1000);
+
+	if(samples <= SYNTH_CONTROL_PERIOD) return ENV_FULL;
+
+	return (int32_t) (((uint32_t) ENV_FULL * SYNTH_CONTROL_PERIOD) / samples);
+}
+
+static inline uint32_t env_factor_from_ms( uint32_t ms, uint32_t sample_rate )
+{
+	//the per-tick gain that falls ENV_FALL_DB in ms, 0 for a fall within one tick
+	uint32_t samples = (uint32_t) (((uint64_t) ms * sample_rate) / 1000);
+
+	if(samples <= SYNTH_CONTROL_PERIOD) return 0;
+
+	return curve_exp2(-(int32_t) (((uint32_t) ENV_FALL_DB * CURVE_FINE_PER_DB * SYNTH_CONTROL_PERIOD) / samples));
+}
+
+static inline int32_t env_advance( uint8_t *stage, int32_t level, const struct env_params *p )
+{
+	//returns the level at the end of the next control tick
+	switch(*stage)
+	{
+		case ENV_ATTACK:
+		level += p->attack_rate;
+		if(level >= ENV_FULL)
+		{
+			level = ENV_FULL;
+			*stage = ENV_DECAY;
+		}
+		break;
+
+		case ENV_DECAY:
+#if SYNTH_ENV_EXPONENTIAL
+		level = p->sustain_level + (int32_t) (((uint32_t) (level - p->sustain_level) * p->decay_factor) >> CURVE_RATIO_SHIFT);
+		if(level - p->sustain_level <= ENV_FLOOR)
+#else
+		level -= p->decay_rate;
+		if(level <= p->sustain_level)
+#endif
+		{
+			level = p->sustain_level;
+			*stage = ENV_SUSTAIN;
+		}
+		break;
+
+		case ENV_SUSTAIN:
+		level = p->sustain_level;
+		break;
+
+		case ENV_RELEASE:
+#if SYNTH_ENV_EXPONENTIAL
+		level = (int32_t) (((uint32_t) level * p->release_factor) >> CURVE_RATIO_SHIFT);
+		if(level <= ENV_FLOOR)
+#else
+		level -= p->release_rate;
+		if(level <= 0)
+#endif
+		{
+			level = 0;
+			*stage = ENV_IDLE;
+		}
+		break;
+
+		default:
+		level = 0;
+		break;
+	}
+
+	return level;
+}
+
+#endif /* ENVELOPE_H_INCLUDED */
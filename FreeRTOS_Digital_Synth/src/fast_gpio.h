@@ -0,0 +1,43 @@
+/*************************************************************************************************
+                                         --FAST GPIO--
+
+	Output pins driven through the Cortex-M0+ single-cycle I/O port instead of the ASF port
+	driver. PORT_IOBUS maps the same PORT registers onto the core's local bus, so a set,
+	clear or toggle is one store that completes in a cycle, with no call, no group lookup
+	through the driver and no APB wait. For chip selects in hot loops and for scope markers
+	whose edges should sit where the code is, not a few dozen cycles later.
+
+	The pin still has to be configured as an output with port_pin_set_config() first. The
+	pin number is the ASF GPIO number (PIN_PB08 and friends), a constant in every caller so
+	the group and mask fold away.
+
+*************************************************************************************************/
+
+#ifndef FAST_GPIO_H_INCLUDED
+#define FAST_GPIO_H_INCLUDED
+
+#include <asf.h>
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline void fast_pin_high( uint8_t pin )
+{
+	PORT_IOBUS->Group[pin / 32].OUTSET.reg = 1ul << (pin % 32);
+}
+
+static inline void fast_pin_low( uint8_t pin )
+{
+	PORT_IOBUS->Group[pin / 32].OUTCLR.reg = 1ul << (pin % 32);
+}
+
+static inline void fast_pin_toggle( uint8_t pin )
+{
+	PORT_IOBUS->Group[pin / 32].OUTTGL.reg = 1ul << (pin % 32);
+}
+
+static inline void fast_pin_set( uint8_t pin, bool level )
+{
+	if(level) fast_pin_high(pin);
+	else fast_pin_low(pin);
+}
+
+#endif /* FAST_GPIO_H_INCLUDED */
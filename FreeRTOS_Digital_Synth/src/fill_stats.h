@@ -0,0 +1,51 @@
+/*************************************************************************************************
+                                         --FILL STATS--
+
+	Fill level of a queue or ring as seen once per SYNTH_STATS_SAMPLE_MS: the level at the last
+	look and the lowest and highest since the window was last reset. A low water mark
+	that never gets near zero over a long session is latency that can be taken out, a
+	high one that reaches the size is where input gets dropped.
+
+	Written by the stats timer's callback only, the console may read a level that is one
+	period old.
+
+*************************************************************************************************/
+
+#ifndef FILL_STATS_H_INCLUDED
+#define FILL_STATS_H_INCLUDED
+
+#include <stdint.h>
+
+/********   TYPE DEFS  **********/
+struct fill_stats{
+	uint16_t current;
+	uint16_t min;
+	uint16_t max;
+	uint16_t size;
+};
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline void fill_stats_reset( struct fill_stats *fill )
+{
+	//starts a new window at the current level
+	fill->min = fill->current;
+	fill->max = fill->current;
+}
+
+static inline void fill_stats_init( struct fill_stats *fill, uint16_t size )
+{
+	//the first sample sets both marks
+	fill->size = size;
+	fill->current = 0;
+	fill->min = size;
+	fill->max = 0;
+}
+
+static inline void fill_stats_sample( struct fill_stats *fill, uint16_t level )
+{
+	fill->current = level;
+	if(level < fill->min) fill->min = level;
+	if(level > fill->max) fill->max = level;
+}
+
+#endif /* FILL_STATS_H_INCLUDED */
@@ -0,0 +1,404 @@
+/*************************************************************************************************
+                                         --FLASH UPLOAD--
+
+	The MIDI task decodes each message as its bytes come, one septet behind: only the F7
+	tells which was the checksum. DATA bytes go straight into the page buffer being filled,
+	which the console task takes once the message that completes the page has checked out;
+	a message that fails stops the upload before its page is handed on.
+
+	The upload's state passes between the tasks: the MIDI task starts an upload only when
+	the console task has finished the last one, and stops one only while it receives. The
+	console task writes the buffers in the order they were handed on, and owns the erase
+	pointer and the read-back.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "flash_upload.h"
+#include "spi_flash.h"
+#include "midi_parser.h"
+#include "trace_log.h"
+
+#if SYNTH_FLASH_UPLOAD
+
+/**********  DEFINE  ************/
+#define UPLOAD_FIELD_SEPTETS	(	4	)
+#define UPLOAD_CRC_SEPTETS		(	5	)
+#define UPLOAD_HEADER			(	4	)	//F0, ID, device and op, then the payload
+#define UPLOAD_VERIFY_PAGES		(	16	)	//read back per console pass
+#define UPLOAD_CRC_INIT			(	0xFFFFFFFFu	)
+
+
+/********   TYPE DEFS  **********/
+enum upload_state{
+	UPLOAD_IDLE,
+	UPLOAD_RECEIVING,
+	UPLOAD_VERIFYING,
+	UPLOAD_FAILED,
+};
+
+
+/*******   GLOBAL VARS  *********/
+//reflected CRC-32 (0xEDB88320) a nibble at a time
+static const uint32_t upload_crc_table[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+static volatile uint8_t upload_state;
+static const char *upload_reason;
+static uint32_t upload_address;
+static uint32_t upload_length;
+static uint32_t upload_crc;
+static volatile bool upload_ended;
+
+//the page buffers
+static uint8_t upload_page[2][SPI_FLASH_PAGE_SIZE];
+static uint32_t upload_page_address[2];
+static uint16_t upload_page_length[2];
+static volatile bool upload_page_full[2];
+
+//MIDI task: the message and the buffer being filled
+static uint8_t upload_index;			//bytes since F0, 0 outside one of ours
+static uint8_t upload_op;
+static uint8_t upload_sum;
+static uint8_t upload_held;
+static uint16_t upload_pos;				//septets of the payload taken
+static uint32_t upload_field;
+static uint32_t upload_offset;
+static uint8_t upload_top;				//the group's top bits
+static uint16_t upload_count;			//data bytes of the message
+static uint32_t upload_received;		//bytes checked out
+static uint8_t upload_fill;				//buffer filled next
+
+//console task
+static uint8_t upload_write;			//buffer written next
+static uint32_t upload_erased;			//end of the sectors erased
+static uint32_t upload_verified;
+static uint32_t upload_check;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint32_t upload_crc_update( uint32_t crc, const uint8_t *data, uint32_t length )
+{
+	while(length--)
+	{
+		crc ^= *data++;
+		crc = (crc >> 4) ^ upload_crc_table[crc & 0x0F];
+		crc = (crc >> 4) ^ upload_crc_table[crc & 0x0F];
+	}
+
+	return crc;
+}
+
+static void upload_fail( const char *reason )
+{
+	//MIDI task, while receiving
+	upload_index = 0;
+	if(upload_state != UPLOAD_RECEIVING) return;
+	upload_reason = reason;
+	upload_state = UPLOAD_FAILED;
+}
+
+static void upload_begin( void )
+{
+	if(upload_state != UPLOAD_IDLE)
+	{
+		trace_log("upload: busy, BEGIN ignored\r\n", 0);
+		return;
+	}
+	if((upload_address % SPI_FLASH_SECTOR_SIZE) || (upload_length == 0) || (upload_length > SYNTH_FLASH_UPLOAD_MAX) ||
+		(upload_address > SYNTH_FLASH_UPLOAD_MAX - upload_length))
+	{
+		trace_log("upload: BEGIN at 0x%06lx out of range\r\n", upload_address);
+		return;
+	}
+
+	upload_received = 0;
+	upload_fill = 0;
+	upload_write = 0;
+	upload_page_full[0] = false;
+	upload_page_full[1] = false;
+	upload_erased = upload_address;
+	upload_ended = false;
+	upload_state = UPLOAD_RECEIVING;
+	trace_log("upload: receiving %lu bytes\r\n", upload_length);
+}
+
+static void upload_septet( uint8_t septet )
+{
+	//a payload septet that is not the checksum
+	uint16_t pos = upload_pos++;
+	uint8_t g;
+
+	upload_sum += septet;
+
+	switch(upload_op)
+	{
+		case FLASH_UPLOAD_BEGIN:
+		if(pos >= 2 * UPLOAD_FIELD_SEPTETS) break;
+		upload_field = (upload_field << 7) | septet;
+		if(pos == UPLOAD_FIELD_SEPTETS - 1)
+		{
+			upload_offset = upload_field;
+			upload_field = 0;
+		}
+		break;
+
+		case FLASH_UPLOAD_DATA:
+		if(pos < UPLOAD_FIELD_SEPTETS) upload_field = (upload_field << 7) | septet;
+		if(pos == UPLOAD_FIELD_SEPTETS - 1)
+		{
+			upload_offset = upload_field;
+			if(upload_state != UPLOAD_RECEIVING)
+			{
+				//not ours to take, the buffers may be in use
+				upload_index = 0;
+				return;
+			}
+			if(upload_offset != upload_received)
+			{
+				upload_fail("a DATA message missing");
+				return;
+			}
+			if(upload_page_full[upload_fill])
+			{
+				upload_fail("data faster than the flash, pace the sender");
+				return;
+			}
+		}
+		if(pos < UPLOAD_FIELD_SEPTETS) break;
+
+		g = (uint8_t) ((pos - UPLOAD_FIELD_SEPTETS) & 7);
+		if(g == 0)
+		{
+			upload_top = septet;
+			break;
+		}
+		if(((upload_offset + upload_count) % SPI_FLASH_PAGE_SIZE == 0) && (upload_count > 0))
+		{
+			upload_fail("a DATA message across a page");
+			return;
+		}
+		upload_page[upload_fill][(upload_offset + upload_count) % SPI_FLASH_PAGE_SIZE] =
+			(uint8_t) (septet | (((upload_top >> (g - 1)) & 1) << 7));
+		upload_count++;
+		break;
+
+		case FLASH_UPLOAD_END:
+		upload_field = (upload_field << 7) | septet;
+		break;
+
+		default:
+		break;
+	}
+}
+
+static void upload_message( void )
+{
+	//the F7 of one of ours, the held septet is the checksum
+	uint32_t end;
+
+	if((upload_pos == 0) || ((upload_sum + upload_held) & 0x7F))
+	{
+		upload_fail("a checksum failed");
+		return;
+	}
+
+	switch(upload_op)
+	{
+		case FLASH_UPLOAD_BEGIN:
+		if(upload_pos != 2 * UPLOAD_FIELD_SEPTETS) return;
+		upload_address = upload_offset;
+		upload_length = upload_field;
+		upload_begin();
+		break;
+
+		case FLASH_UPLOAD_DATA:
+		if(upload_state != UPLOAD_RECEIVING) return;
+		if((upload_count == 0) || (upload_offset + upload_count > upload_length))
+		{
+			upload_fail("DATA beyond the length");
+			return;
+		}
+		upload_received += upload_count;
+
+		//a full page, or the last bytes, go to the console task
+		if((upload_received % SPI_FLASH_PAGE_SIZE == 0) || (upload_received == upload_length))
+		{
+			end = upload_received - 1;
+			upload_page_address[upload_fill] = upload_address + end - (end % SPI_FLASH_PAGE_SIZE);
+			upload_page_length[upload_fill] = (uint16_t) (end % SPI_FLASH_PAGE_SIZE + 1);
+			upload_page_full[upload_fill] = true;
+			upload_fill ^= 1;
+		}
+		break;
+
+		case FLASH_UPLOAD_END:
+		if(upload_state != UPLOAD_RECEIVING) return;
+		if((upload_pos != UPLOAD_CRC_SEPTETS) || (upload_received != upload_length))
+		{
+			upload_fail("END before the last DATA");
+			return;
+		}
+		upload_crc = upload_field;
+		upload_ended = true;
+		break;
+
+		default:
+		break;
+	}
+}
+
+void flash_upload_feed( uint8_t byte )
+{
+	//MIDI task, every byte of every input
+	if(byte >= MIDI_CLOCK) return;
+
+	if(byte == MIDI_SYSEX_START)
+	{
+		if(upload_index > 0) upload_fail("a message cut short");
+		upload_index = 1;
+		return;
+	}
+	if(upload_index == 0) return;
+
+	if(byte & 0x80)
+	{
+		if(byte == MIDI_SYSEX_END) upload_message();
+		else upload_fail("a message cut short");
+		upload_index = 0;
+		return;
+	}
+
+	switch(upload_index)
+	{
+		case 1:
+		if(byte != FLASH_UPLOAD_ID) upload_index = 0;
+		break;
+
+		case 2:
+		if(byte != FLASH_UPLOAD_DEVICE) upload_index = 0;
+		break;
+
+		case 3:
+		upload_op = byte;
+		upload_sum = byte;
+		upload_pos = 0;
+		upload_field = 0;
+		upload_count = 0;
+		break;
+
+		case UPLOAD_HEADER:
+		upload_held = byte;
+		break;
+
+		default:
+		upload_septet(upload_held);
+		upload_held = byte;
+		break;
+	}
+	if(upload_index && (upload_index < UPLOAD_HEADER + 1)) upload_index++;
+}
+
+static void upload_claim( void )
+{
+	while(spi_flash_claim() == false) vTaskDelay(1);
+}
+
+static void upload_wait( void )
+{
+	//with the bus, a read now would come back as whatever the flash drives while busy
+	while(spi_flash_busy()) vTaskDelay(1);
+}
+
+static void upload_erase_next( void )
+{
+	upload_claim();
+	spi_flash_erase_sector(upload_erased);
+	upload_wait();
+	spi_flash_release();
+	upload_erased += SPI_FLASH_SECTOR_SIZE;
+}
+
+static void upload_verify( void )
+{
+	//a few pages back per pass, then the verdict
+	uint32_t length;
+	int n;
+
+	for(n=0; (n < UPLOAD_VERIFY_PAGES) && (upload_verified < upload_length); n++)
+	{
+		length = upload_length - upload_verified;
+		if(length > SPI_FLASH_PAGE_SIZE) length = SPI_FLASH_PAGE_SIZE;
+
+		upload_claim();
+		spi_flash_read(upload_address + upload_verified, upload_page[0], length);
+		spi_flash_release();
+
+		upload_check = upload_crc_update(upload_check, upload_page[0], length);
+		upload_verified += length;
+	}
+	if(upload_verified < upload_length) return;
+
+	if(~upload_check == upload_crc)
+	{
+		printf("upload: %lu bytes at 0x%06lx written and read back, reset to use them\r\n", (unsigned long) upload_length,
+			(unsigned long) upload_address);
+	}
+	else printf("upload: CRC %08lx read back, %08lx sent\r\n", (unsigned long) ~upload_check, (unsigned long) upload_crc);
+	upload_state = UPLOAD_IDLE;
+}
+
+void flash_upload_job( void )
+{
+	//console task, every pass
+	uint8_t i = upload_write;
+
+	switch(upload_state)
+	{
+		case UPLOAD_FAILED:
+		printf("upload: stopped, %s\r\n", upload_reason);
+		upload_state = UPLOAD_IDLE;
+		break;
+
+		case UPLOAD_RECEIVING:
+		if(upload_page_full[i])
+		{
+			while(upload_erased <= upload_page_address[i]) upload_erase_next();
+
+			upload_claim();
+			spi_flash_program(upload_page_address[i], upload_page[i], upload_page_length[i]);
+			upload_wait();
+			spi_flash_release();
+
+			upload_page_full[i] = false;
+			upload_write ^= 1;
+		}
+		else if(upload_ended)
+		{
+			upload_verified = 0;
+			upload_check = UPLOAD_CRC_INIT;
+			upload_state = UPLOAD_VERIFYING;
+		}
+		else if((upload_erased < upload_address + upload_length) &&
+			(upload_erased < upload_address + upload_received + 2 * SPI_FLASH_SECTOR_SIZE))
+		{
+			//the sector after the one being filled, while the line is busy with the data
+			upload_erase_next();
+		}
+		break;
+
+		case UPLOAD_VERIFYING:
+		upload_verify();
+		break;
+
+		default:
+		break;
+	}
+}
+
+#endif /* SYNTH_FLASH_UPLOAD */
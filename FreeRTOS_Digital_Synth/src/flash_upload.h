@@ -0,0 +1,53 @@
+/*************************************************************************************************
+                                         --FLASH UPLOAD--
+
+	Writes the SPI flash of spi_flash.h from SysEx, so a sample bank or a song made with
+	tools/gen_flash_image.py loads in the field over any MIDI input; tools/flash_sysex.py
+	turns the image into the messages. The data goes to the flash a page at a time as it
+	arrives, through two page buffers, never more of it in RAM. All messages are
+
+		F0 7D 01 <op> ... <checksum> F7
+
+	7D being the non-commercial ID, and the checksum the septet that brings the 7-bit sum of
+	every byte from <op> on to 0:
+
+		01 BEGIN	address, length: 4 septets each, most significant first; the address
+					on a 4 KB sector, the length at most SYNTH_FLASH_UPLOAD_MAX
+		02 DATA		offset from the address in 4 septets, then the bytes packed 7 to 8:
+					a byte of the top bits, bit n the top bit of the nth byte, ahead of each
+					7; at most a page, and within one
+		03 END		CRC-32 of the data, in 5 septets
+
+	DATA must come in order and the message with the last byte of a page before the next
+	page's. Every sector is erased just before the first page written to it, and the one
+	after it meanwhile, which keeps well ahead of DIN speed; a sender over USB-MIDI should
+	leave 30 ms a page, time for a slow part's sector erase every 16 pages. An upload with
+	a bad checksum, a missing or early message, or a page that finds both buffers taken
+	stops and says why on the console. After the END the written range is read back and
+	its CRC compared; the stream and the song player read the new data from the next reset.
+
+	The MIDI task hands flash_upload_feed() every byte from every input, ahead of the
+	parser, which skips these messages. flash_upload_job() does the flash work in the
+	console task, claiming the bus for each step.
+
+*************************************************************************************************/
+
+#ifndef FLASH_UPLOAD_H_INCLUDED
+#define FLASH_UPLOAD_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define FLASH_UPLOAD_ID			(	0x7D	)
+#define FLASH_UPLOAD_DEVICE		(	0x01	)
+#define FLASH_UPLOAD_BEGIN		(	0x01	)
+#define FLASH_UPLOAD_DATA		(	0x02	)
+#define FLASH_UPLOAD_END		(	0x03	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void flash_upload_feed( uint8_t byte );
+void flash_upload_job( void );
+
+#endif /* FLASH_UPLOAD_H_INCLUDED */
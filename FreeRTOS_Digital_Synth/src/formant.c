@@ -0,0 +1,123 @@
+/*************************************************************************************************
+                                          --FORMANT--
+
+	The presets are the first three formants of a sung tenor vowel, centre frequencies in Hz
+	and levels relative to the first. A band above fs/6 stays at the SVF's cutoff limit, so
+	at the lowest sample rates the upper formants bunch up there.
+
+	The wet signal is summed into a scratch period on the stack, then each sample moves
+	from the dry towards it by the mix.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "formant.h"
+#include "conf_synth.h"
+
+
+/********   TYPE DEFS  **********/
+struct formant_vowel{
+	uint16_t hz[FORMANT_BANDS];
+	uint16_t level[FORMANT_BANDS];
+};
+
+
+/*******   GLOBAL VARS  *********/
+static const struct formant_vowel formant_vowels[FORMANT_VOWELS] = {
+	{ { 650, 1080, 2650 }, { 256, 128, 114 } },	//a
+	{ { 400, 1700, 2600 }, { 256,  51,  64 } },	//e
+	{ { 290, 1870, 2800 }, { 256,  45,  32 } },	//i
+	{ { 400,  800, 2600 }, { 256,  81,  64 } },	//o
+	{ { 350,  600, 2700 }, { 256,  26,  36 } }	//u
+};
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void formant_init( struct formant *formant )
+{
+	int k;
+
+	for(k=0; k<FORMANT_BANDS; k++)
+	{
+		svf_init(&formant->band[k]);
+		formant->band[k].mode = SVF_BANDPASS;
+		svf_set_resonance(&formant->band[k], FORMANT_RESONANCE);
+		formant->gain[k] = 0;
+	}
+	formant->mix = 0;
+}
+
+bool formant_idle( const struct formant *formant )
+{
+	int k;
+
+	if(formant->mix == 0) return true;
+	for(k=0; k<FORMANT_BANDS; k++) if((formant->band[k].low | formant->band[k].band) != 0) return false;
+
+	return true;
+}
+
+void formant_set( struct formant *formant, int32_t position, uint32_t inc_per_hz, int32_t mix )
+{
+	//position 0..FORMANT_POS_MAX, inc_per_hz the phase increment of 1 Hz at the sample rate,
+	//mix Q8; the bands keep their state so a moving vowel does not click
+	const struct formant_vowel *from;
+	const struct formant_vowel *to;
+	int32_t w;
+	int32_t hz;
+	int32_t level;
+	int k;
+
+	if(position < 0) position = 0;
+	if(position > FORMANT_POS_MAX) position = FORMANT_POS_MAX;
+	if(mix < 0) mix = 0;
+	if(mix > FORMANT_MIX_MAX) mix = FORMANT_MIX_MAX;
+
+	from = &formant_vowels[position >> FORMANT_POS_SHIFT];
+	to = (position == FORMANT_POS_MAX) ? from : from + 1;
+	w = position & ((1l << FORMANT_POS_SHIFT) - 1);
+
+	for(k=0; k<FORMANT_BANDS; k++)
+	{
+		hz = from->hz[k] + (((to->hz[k] - from->hz[k]) * w) >> FORMANT_POS_SHIFT);
+		level = from->level[k] + (((to->level[k] - from->level[k]) * w) >> FORMANT_POS_SHIFT);
+
+		svf_set_cutoff(&formant->band[k], (uint32_t) hz * inc_per_hz);
+		formant->gain[k] = (level * formant->band[k].q) >> (FORMANT_LEVEL_SHIFT + SVF_Q_SHIFT - FORMANT_GAIN_SHIFT);
+	}
+
+	//switched off, the bands start from rest when it comes back
+	if(mix == 0)
+	{
+		for(k=0; k<FORMANT_BANDS; k++)
+		{
+			formant->band[k].low = 0;
+			formant->band[k].band = 0;
+		}
+	}
+	formant->mix = mix;
+}
+
+SYNTH_RAM_CODE void formant_process( struct formant *formant, int32_t *buffer, int count )
+{
+	//processes the buffer in place, a period at a time
+	int32_t wet[SYNTH_CONTROL_PERIOD];
+	int32_t mix = formant->mix;
+	int n;
+	int i;
+	int k;
+
+	if(mix == 0) return;
+
+	while(count > 0)
+	{
+		n = (count < SYNTH_CONTROL_PERIOD) ? count : SYNTH_CONTROL_PERIOD;
+
+		for(i=0; i<n; i++) wet[i] = 0;
+		for(k=0; k<FORMANT_BANDS; k++) svf_band_add(&formant->band[k], buffer, wet, formant->gain[k], n);
+		for(i=0; i<n; i++) buffer[i] += ((wet[i] - buffer[i]) * mix) >> FORMANT_LEVEL_SHIFT;
+
+		buffer += n;
+		count -= n;
+	}
+}
@@ -0,0 +1,54 @@
+/*************************************************************************************************
+                                          --FORMANT--
+
+	Vowel filter on the master mix: FORMANT_BANDS state-variable bandpasses in parallel on
+	the same input, each tuned to one formant of a vowel and weighted by its level, their
+	sum blended with the dry signal. The bands are the SVF kernel of svf.c, so the cost is
+	three filter steps and a multiply-add per sample, and nothing when the mix is zero.
+
+	The vowel is a position along a, e, i, o, u in 1/256 steps; formant_set() interpolates
+	the two neighbouring presets linearly in Hz and level. The engine moves the position at
+	control rate, so a vowel sweep retunes the bands once per tick, never per sample.
+
+	A bandpass at the damping the bands run with peaks at 1/q of its input, each level is
+	scaled by q so a band in tune with a partial passes it at its preset level.
+
+*************************************************************************************************/
+
+#ifndef FORMANT_H_INCLUDED
+#define FORMANT_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "svf.h"
+
+/**********  DEFINE  ************/
+#define FORMANT_BANDS			(	3	)
+#define FORMANT_VOWELS			(	5	)
+
+//vowel position, 1/256 of the way from one preset to the next
+#define FORMANT_POS_SHIFT		(	8	)
+#define FORMANT_POS_MAX			(	(FORMANT_VOWELS - 1) << FORMANT_POS_SHIFT	)
+
+//preset levels and the wet mix are Q8, 256 = unity; band gains Q15
+#define FORMANT_LEVEL_SHIFT		(	8	)
+#define FORMANT_MIX_MAX			(	256	)
+#define FORMANT_GAIN_SHIFT		(	15	)
+
+//SVF resonance of every band, 127 is the narrowest the kernel allows
+#define FORMANT_RESONANCE		(	127	)
+
+/********   TYPE DEFS  **********/
+struct formant{
+	struct svf band[FORMANT_BANDS];
+	int32_t gain[FORMANT_BANDS];
+	int32_t mix;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void formant_init( struct formant *formant );
+void formant_set( struct formant *formant, int32_t position, uint32_t inc_per_hz, int32_t mix );
+void formant_process( struct formant *formant, int32_t *buffer, int count );
+bool formant_idle( const struct formant *formant );
+
+#endif /* FORMANT_H_INCLUDED */
@@ -0,0 +1,274 @@
+/*************************************************************************************************
+                                            --GRAIN--
+
+	A voice's grains are a singly linked list through the pool blocks, newest first; a
+	grain is unlinked and handed back to the pool in the segment it ends in. The scan
+	position is in frames of the sample, a grain's read position and step are Q12 frames
+	like the SAMPLE voices'. A grain never reads past the sample: its start is pulled back
+	so the whole grain fits, and a sample too short for the grain at its pitch plays from
+	its start with the window squeezed onto what there is.
+
+	Spray offsets come from a xorshift of the voice's LFSR word, which a GRAIN voice has no
+	other use for; the top 16 bits scale the spray, the sign picks the side.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "grain.h"
+#include "synth_engine.h"
+#include "block_pool.h"
+
+
+/**********  DEFINE  ************/
+#define GRAIN_RATE_MS			(	1000	)
+
+
+/********   TYPE DEFS  **********/
+struct grain{
+	struct grain *next;
+	const void *data;
+	const int16_t *window;
+	uint32_t pos;				//Q12 frames
+	uint32_t step;
+	uint32_t phase;				//through the window
+	uint32_t phase_inc;
+	uint32_t left;				//samples to its end
+	uint16_t level;
+	uint8_t bits;
+};
+
+
+/*******   GLOBAL VARS  *********/
+static struct grain grains[SYNTH_GRAINS];
+static struct block_pool grain_pool;
+
+//each voice's grains, and the samples until it starts the next one
+static struct grain *voice_grains[SYNTH_MAX_VOICES];
+static int32_t voice_wait[SYNTH_MAX_VOICES];
+
+static uint16_t budget;
+static uint32_t skips;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void grain_init( void )
+{
+	int i;
+
+	block_pool_init(&grain_pool, "grain", grains, sizeof(grains[0]), SYNTH_GRAINS);
+	for(i=0; i<SYNTH_MAX_VOICES; i++)
+	{
+		voice_grains[i] = NULL;
+		voice_wait[i] = 0;
+	}
+	budget = SYNTH_GRAINS;
+	skips = 0;
+}
+
+void grain_set_budget( uint16_t grains_out )
+{
+	//grains sounding at once, 1 to SYNTH_GRAINS; the ones out already play to their end
+	if(grains_out < 1) grains_out = 1;
+	if(grains_out > SYNTH_GRAINS) grains_out = SYNTH_GRAINS;
+	budget = grains_out;
+}
+
+uint16_t grain_budget( void )
+{
+	return budget;
+}
+
+uint32_t grain_skip_count( void )
+{
+	return skips;
+}
+
+void grain_params_set( struct grain_params *params, uint8_t size, uint8_t density, uint8_t spray, uint32_t sample_rate )
+{
+	//size, density and spray 0..127 from the CCs, in samples of 'sample_rate'
+	uint32_t overlap;
+	uint32_t level;
+
+	if(size > 127) size = 127;
+	if(density > 127) density = 127;
+	if(spray > 127) spray = 127;
+
+	params->length = (GRAIN_SIZE_MIN_MS + (uint32_t) size * GRAIN_SIZE_STEP_MS) * sample_rate / GRAIN_RATE_MS;
+	params->window_inc = (uint32_t) ((1ull << 32) / params->length);
+	params->interval = sample_rate / (1u + density);
+	if(params->interval < SYNTH_CONTROL_PERIOD) params->interval = SYNTH_CONTROL_PERIOD;
+	params->spray = spray;
+
+	//1 / sqrt(overlap) in Q8, grains at random offsets add up in power
+	overlap = params->length / params->interval;
+	if(overlap < 1) overlap = 1;
+	level = 1u << GRAIN_LEVEL_SHIFT;
+	while(level * level * overlap > (1u << (2 * GRAIN_LEVEL_SHIFT))) level--;
+
+	params->level = (uint16_t) level;
+	params->window = (overlap >= 2) ? GRAIN_HANN : GRAIN_TUKEY;
+}
+
+void grain_voice_start( int voice )
+{
+	//a new note's first grain starts at its first control tick
+	grain_voice_stop(voice);
+	voice_wait[voice] = 0;
+}
+
+void grain_voice_stop( int voice )
+{
+	//the slot is given up, its grains go back to the pool
+	struct grain *g = voice_grains[voice];
+	struct grain *next;
+
+	while(g != NULL)
+	{
+		next = g->next;
+		block_pool_put(&grain_pool, g);
+		g = next;
+	}
+	voice_grains[voice] = NULL;
+}
+
+static void grain_start( int voice, const struct pcm_sample *pcm, uint32_t center, uint32_t step, const struct grain_params *params, uint32_t *lfsr )
+{
+	//one grain at the scan position moved by the spray; with the budget or the pool used up
+	//it is skipped, and counted
+	struct grain *g;
+	uint32_t r = *lfsr;
+	uint32_t span;
+	int32_t offset;
+	int32_t start;
+
+	if((grain_pool.used >= budget) || ((g = block_pool_get(&grain_pool)) == NULL))
+	{
+		skips++;
+		return;
+	}
+
+	r ^= r << 13;
+	r ^= r >> 17;
+	r ^= r << 5;
+	*lfsr = r;
+
+	//spray / 128 of half the sample to either side
+	offset = (int32_t) (((int64_t) ((int32_t) (r >> 16) - 32768) * params->spray * (int32_t) (pcm->length >> 1)) >> 22);
+	start = (int32_t) center + offset;
+
+	g->left = params->length;
+	g->phase_inc = params->window_inc;
+	span = (uint32_t) (((uint64_t) params->length * step) >> PCM_FRAC_BITS) + 1;
+	if(span >= pcm->length)
+	{
+		//the whole sample is shorter than the grain, the window shrinks to fit it
+		start = 0;
+		g->left = step ? (uint32_t) (((uint64_t) (pcm->length - 1) << PCM_FRAC_BITS) / step) : params->length;
+		if(g->left < 1) g->left = 1;
+		if(g->left < params->length) g->phase_inc = (uint32_t) ((1ull << 32) / g->left);
+	}
+	else
+	{
+		if(start < 0) start = 0;
+		if(start > (int32_t) (pcm->length - span)) start = (int32_t) (pcm->length - span);
+	}
+
+	g->data = pcm->data;
+	g->bits = pcm->bits;
+	g->pos = (uint32_t) start << PCM_FRAC_BITS;
+	g->step = step;
+	g->phase = 0;
+	g->window = grain_windows[params->window];
+	g->level = params->level;
+
+	g->next = voice_grains[voice];
+	voice_grains[voice] = g;
+}
+
+void grain_voice_tick( int voice, const struct pcm_sample *pcm, uint32_t center, uint32_t step, const struct grain_params *params, uint32_t *lfsr )
+{
+	//control rate: starts the grains due in the next period, at the voice's current step
+	int32_t wait = voice_wait[voice] - SYNTH_CONTROL_PERIOD;
+
+	while(wait < 0)
+	{
+		grain_start(voice, pcm, center, step, params, lfsr);
+		wait += (int32_t) params->interval;
+	}
+
+	voice_wait[voice] = wait;
+}
+
+SYNTH_RAM_CODE void grain_render( int voice, int32_t *out, int count, int32_t gain, int32_t gain_step )
+{
+	//the voice's grains summed at their levels, then one pass of the voice's gain ramp
+	int32_t sum[SYNTH_CONTROL_PERIOD];
+	struct grain **link = &voice_grains[voice];
+	struct grain *g;
+	const int8_t *data8;
+	const int16_t *data12;
+	const int16_t *window;
+	uint32_t pos;
+	uint32_t step;
+	uint32_t phase;
+	uint32_t phase_inc;
+	int32_t level;
+	int32_t s;
+	int n;
+	int i;
+
+	for(i=0; i<count; i++) sum[i] = 0;
+
+	while((g = *link) != NULL)
+	{
+		n = (g->left < (uint32_t) count) ? (int) g->left : count;
+		pos = g->pos;
+		step = g->step;
+		phase = g->phase;
+		phase_inc = g->phase_inc;
+		window = g->window;
+		level = g->level;
+
+		if(g->bits == 8)
+		{
+			data8 = (const int8_t *) g->data;
+			for(i=0; i<n; i++)
+			{
+				s = data8[pos >> PCM_FRAC_BITS] << 4;
+				sum[i] += (s * ((window[phase >> GRAIN_WINDOW_SHIFT] * level) >> GRAIN_LEVEL_SHIFT)) >> GRAIN_WINDOW_BITS;
+				pos += step;
+				phase += phase_inc;
+			}
+		}
+		else
+		{
+			data12 = (const int16_t *) g->data;
+			for(i=0; i<n; i++)
+			{
+				s = data12[pos >> PCM_FRAC_BITS];
+				sum[i] += (s * ((window[phase >> GRAIN_WINDOW_SHIFT] * level) >> GRAIN_LEVEL_SHIFT)) >> GRAIN_WINDOW_BITS;
+				pos += step;
+				phase += phase_inc;
+			}
+		}
+
+		g->left -= (uint32_t) n;
+		if(g->left == 0)
+		{
+			*link = g->next;
+			block_pool_put(&grain_pool, g);
+			continue;
+		}
+
+		g->pos = pos;
+		g->phase = phase;
+		link = &g->next;
+	}
+
+	for(i=0; i<count; i++)
+	{
+		out[i] += (sum[i] * gain) >> MIX_SHIFT;
+		gain += gain_step;
+	}
+}
@@ -0,0 +1,78 @@
+/*************************************************************************************************
+                                            --GRAIN--
+
+	Granular playback for the GRAIN voice type, over the same flash PCM bank as the SAMPLE
+	voices. A sounding voice is a cloud of short grains, each a piece of the sample read at
+	the voice's pitch under a window from the const tables of grain_windows.c, so a grain
+	costs a sample read, a window read and two multiplies per sample and never a cosine.
+	The grains come from one block pool of SYNTH_GRAINS shared by all voices, are handed
+	back the sample they end, and a voice's grains are summed before its gain ramp is
+	applied once, the way the renderer treats any other voice.
+
+	The scheduler runs at control rate: every grain_params.interval samples a voice asks for
+	a grain at the channel's scan position (the sample start, CC 78) moved by up to the
+	spray either way, picked by the voice's LFSR. The grains sounding at once are the CPU
+	cost, so a grain is only started while fewer than the budget are out; the budget starts
+	at the pool size and the engine's load governor takes it down a grain per block over
+	its high mark and back up a grain per block under its low mark. A grain that does not start is
+	counted in grain_skip_count() and the cloud thins out instead of the block running late.
+
+	Grain size (CC 81), density (CC 82) and spray (CC 83) are per channel; grain_params_set()
+	turns them into samples for the sample rate when they change, never in the render path.
+	Each grain's level is 1 / sqrt of the overlap, so a denser cloud does not get louder.
+	Clouds of grains overlapping twice or more take the Hann window, sparser ones the Tukey,
+	whose flat top keeps a lone grain near full level.
+
+*************************************************************************************************/
+
+#ifndef GRAIN_H_INCLUDED
+#define GRAIN_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+#include "samples.h"
+
+/**********  DEFINE  ************/
+//window tables are Q15 over GRAIN_WINDOW_SIZE steps, indexed by the top bits of a 32-bit phase
+#define GRAIN_WINDOW_SIZE		(	256	)
+#define GRAIN_WINDOW_SHIFT		(	24	)
+#define GRAIN_WINDOW_BITS		(	15	)
+
+//per grain level, Q8
+#define GRAIN_LEVEL_SHIFT		(	8	)
+
+//what the CCs map to: 10 ms plus 2 ms a step, 1 grain a second plus 1 a step
+#define GRAIN_SIZE_MIN_MS		(	10	)
+#define GRAIN_SIZE_STEP_MS		(	2	)
+
+/********   TYPE DEFS  **********/
+enum grain_window{
+	GRAIN_HANN,
+	GRAIN_TUKEY,
+	GRAIN_WINDOW_COUNT
+};
+
+struct grain_params{
+	uint32_t length;		//samples a grain lasts
+	uint32_t window_inc;	//window phase a sample, 2^32 / length
+	uint32_t interval;		//samples from one grain to the next, at least a control period
+	uint16_t level;
+	uint8_t spray;			//0..127 of half the sample either side of the scan position
+	uint8_t window;
+};
+
+/*******   GLOBAL VARS  *********/
+extern const int16_t grain_windows[GRAIN_WINDOW_COUNT][GRAIN_WINDOW_SIZE + 1];
+
+/****** FUNCTION PROTOTYPES  ****/
+void grain_init( void );
+void grain_params_set( struct grain_params *params, uint8_t size, uint8_t density, uint8_t spray, uint32_t sample_rate );
+void grain_voice_start( int voice );
+void grain_voice_stop( int voice );
+void grain_voice_tick( int voice, const struct pcm_sample *pcm, uint32_t center, uint32_t step, const struct grain_params *params, uint32_t *lfsr );
+void grain_render( int voice, int32_t *out, int count, int32_t gain, int32_t gain_step );
+void grain_set_budget( uint16_t grains );
+uint16_t grain_budget( void );
+uint32_t grain_skip_count( void );
+
+#endif /* GRAIN_H_INCLUDED */
@@ -0,0 +1,181 @@
+/*************************************************************************************************
+                                        --KERNEL TRACE--
+
+	Every hook runs with interrupts masked, so a record is written without a lock: a counter
+	read, four stores and the index increment, around 30 cycles from RAM. At 20 kHz with a
+	queue event and a switch per sample that is 2.5% of the CPU, so recording is compiled
+	out unless asked for.
+
+	The dump runs in the console's task at idle priority and waits for room in the EDBG
+	transmit ring rather than dropping, recording is off meanwhile so the ring holds still. The capture that follows starts
+	empty, the time spent dumping would otherwise sit as a gap in the middle of it.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "conf_synth.h"
+#include "kernel_trace.h"
+#include "debug_uart.h"
+
+#if SYNTH_KERNEL_TRACE
+
+#if !configUSE_TRACE_FACILITY
+#  error "SYNTH_KERNEL_TRACE needs configUSE_TRACE_FACILITY for the task and queue numbers"
+#endif
+
+
+/**********  DEFINE  ************/
+#define KERNEL_TRACE_MASK		(	SYNTH_KERNEL_TRACE_RECORDS - 1	)
+
+#if (SYNTH_KERNEL_TRACE_RECORDS & KERNEL_TRACE_MASK)
+#  error "SYNTH_KERNEL_TRACE_RECORDS must be a power of two"
+#endif
+
+
+/********   TYPE DEFS  **********/
+struct kernel_trace_record{
+	uint32_t time;
+	uint8_t event;
+	uint8_t object;
+	uint16_t arg;
+};
+
+struct kernel_trace_name{
+	uint8_t number;
+	char name[KERNEL_TRACE_NAME_LEN];
+};
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void kernel_trace_put( const void *data, uint16_t length, uint16_t *sum );
+static void kernel_trace_put_names( const struct kernel_trace_name *names, uint8_t count, uint16_t *sum );
+
+
+/*******   GLOBAL VARS  *********/
+static struct kernel_trace_record kernel_trace_ring[SYNTH_KERNEL_TRACE_RECORDS];
+static uint32_t kernel_trace_count;
+static volatile bool kernel_trace_on;
+
+static struct kernel_trace_name kernel_trace_tasks[KERNEL_TRACE_TASKS];
+static struct kernel_trace_name kernel_trace_queues[KERNEL_TRACE_QUEUES];
+static uint8_t kernel_trace_task_count;
+static uint8_t kernel_trace_queue_count;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void kernel_trace_start( void )
+{
+	//called with the run-time counter, from vTaskStartScheduler()
+	kernel_trace_count = 0;
+	kernel_trace_on = true;
+}
+
+SYNTH_RAM_CODE void kernel_trace_record( uint8_t event, uint8_t object, uint16_t arg )
+{
+	//from the kernel hooks only, interrupts are masked
+	struct kernel_trace_record *rec;
+
+	if(kernel_trace_on == false) return;
+
+	rec = &kernel_trace_ring[kernel_trace_count & KERNEL_TRACE_MASK];
+	rec->time = run_time_counter_read();
+	rec->event = event;
+	rec->object = object;
+	rec->arg = arg;
+	kernel_trace_count++;
+}
+
+void kernel_trace_task_created( uint8_t number, const char *name )
+{
+	//from traceTASK_CREATE, keeps the name the dump maps TCB numbers to
+	struct kernel_trace_name *task;
+	uint8_t i;
+
+	if(kernel_trace_task_count >= KERNEL_TRACE_TASKS) return;
+
+	task = &kernel_trace_tasks[kernel_trace_task_count++];
+	task->number = number;
+	for(i=0; i<KERNEL_TRACE_NAME_LEN && name[i] != '\0'; i++) task->name[i] = name[i];
+	for(; i<KERNEL_TRACE_NAME_LEN; i++) task->name[i] = '\0';
+}
+
+void kernel_trace_name_queue( void *queue, const char *name )
+{
+	//numbers the queue from 1 up, unnamed queues record as 0
+	struct kernel_trace_name *entry;
+	uint8_t i;
+
+	if(queue == NULL || kernel_trace_queue_count >= KERNEL_TRACE_QUEUES) return;
+
+	entry = &kernel_trace_queues[kernel_trace_queue_count++];
+	entry->number = kernel_trace_queue_count;
+	for(i=0; i<KERNEL_TRACE_NAME_LEN && name[i] != '\0'; i++) entry->name[i] = name[i];
+	for(; i<KERNEL_TRACE_NAME_LEN; i++) entry->name[i] = '\0';
+
+	vQueueSetQueueNumber((xQueueHandle) queue, entry->number);
+}
+
+static void kernel_trace_put( const void *data, uint16_t length, uint16_t *sum )
+{
+	const uint8_t *bytes = (const uint8_t *) data;
+	uint16_t i;
+
+	for(i=0; i<length; i++) *sum += bytes[i];
+	debug_uart_write_wait(data, length);
+}
+
+static void kernel_trace_put_names( const struct kernel_trace_name *names, uint8_t count, uint16_t *sum )
+{
+	uint8_t i;
+
+	for(i=0; i<count; i++)
+	{
+		kernel_trace_put(&names[i].number, 1, sum);
+		kernel_trace_put(names[i].name, KERNEL_TRACE_NAME_LEN, sum);
+	}
+}
+
+void kernel_trace_dump( void )
+{
+	//writes the capture to the EDBG port in the format in kernel_trace.h, then starts a new one
+	uint8_t head[4];
+	uint32_t rate;
+	uint32_t count;
+	uint32_t lost;
+	uint16_t records;
+	uint16_t sum = 0;
+	uint16_t check;
+	uint32_t i;
+
+	if(stdio_base == NULL) return;
+
+	kernel_trace_on = false;
+	count = kernel_trace_count;
+	records = (count > SYNTH_KERNEL_TRACE_RECORDS) ? SYNTH_KERNEL_TRACE_RECORDS : (uint16_t) count;
+	lost = count - records;
+	rate = system_gclk_gen_get_hz(SYNTH_FIXED_GCLK) / 64;
+
+	kernel_trace_put("KTRC", 4, &sum);
+	sum = 0;
+	head[0] = KERNEL_TRACE_VERSION;
+	head[1] = kernel_trace_task_count;
+	head[2] = kernel_trace_queue_count;
+	head[3] = sizeof(struct kernel_trace_record);
+	kernel_trace_put(head, sizeof(head), &sum);
+	kernel_trace_put(&rate, sizeof(rate), &sum);
+	kernel_trace_put(&records, sizeof(records), &sum);
+	kernel_trace_put(&lost, sizeof(lost), &sum);
+	kernel_trace_put_names(kernel_trace_tasks, kernel_trace_task_count, &sum);
+	kernel_trace_put_names(kernel_trace_queues, kernel_trace_queue_count, &sum);
+
+	for(i=count-records; i!=count; i++) kernel_trace_put(&kernel_trace_ring[i & KERNEL_TRACE_MASK], sizeof(struct kernel_trace_record), &sum);
+	check = sum;
+	kernel_trace_put(&check, sizeof(check), &sum);
+
+	kernel_trace_start();
+}
+
+#endif /* SYNTH_KERNEL_TRACE */
@@ -0,0 +1,60 @@
+/*************************************************************************************************
+                                        --KERNEL TRACE--
+
+	Flight recorder for the scheduler. With SYNTH_KERNEL_TRACE set, the FreeRTOS trace hooks
+	in freertosconfig.h write one 8-byte record per context switch, queue send, queue
+	receive and blocking receive into a RAM ring of SYNTH_KERNEL_TRACE_RECORDS, overwriting
+	the oldest. Semaphores are queues, so gives and takes show up as sends and receives;
+	task notifications get their own events, give, take and blocking take.
+
+	A record is the run-time counter (the fixed clock / 64, 1.33 us at 48 MHz), the event,
+	the task's TCB number or the queue's number and an argument, the task priority for a
+	switch, the messages waiting for a queue event and the task's count for a notification. Queues are anonymous to the kernel,
+	kernel_trace_name_queue() numbers one and keeps a name for it.
+
+	kernel_trace_dump() stops recording, writes the ring to the EDBG port and starts a new
+	capture. The dump is binary, little-endian:
+
+		"KTRC", version, task count, queue count, record size
+		timer rate in Hz (4 bytes), records (2), records lost to overwriting (4)
+		per task and per queue: number, 8-byte name
+		records, oldest first: time (4), event, object, argument (2)
+		sum of every byte from the version on (2)
+
+	tools/kernel_trace.py finds it in a capture of the port and decodes it.
+
+*************************************************************************************************/
+
+#ifndef KERNEL_TRACE_H_INCLUDED
+#define KERNEL_TRACE_H_INCLUDED
+
+#include <stdint.h>
+
+/**********  DEFINE  ************/
+//record events
+#define KERNEL_TRACE_SWITCH			(	1	)
+#define KERNEL_TRACE_SEND			(	2	)
+#define KERNEL_TRACE_SEND_ISR		(	3	)
+#define KERNEL_TRACE_RECEIVE		(	4	)
+#define KERNEL_TRACE_RECEIVE_ISR	(	5	)
+#define KERNEL_TRACE_BLOCK			(	6	)
+#define KERNEL_TRACE_NOTIFY			(	7	)
+#define KERNEL_TRACE_NOTIFY_ISR		(	8	)
+#define KERNEL_TRACE_NOTIFY_TAKE	(	9	)
+#define KERNEL_TRACE_NOTIFY_BLOCK	(	10	)
+
+#define KERNEL_TRACE_VERSION		(	1	)
+#define KERNEL_TRACE_NAME_LEN		(	8	)
+
+//named tasks and queues kept for the dump
+#define KERNEL_TRACE_TASKS			(	8	)
+#define KERNEL_TRACE_QUEUES			(	8	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void kernel_trace_start( void );
+void kernel_trace_record( uint8_t event, uint8_t object, uint16_t arg );
+void kernel_trace_task_created( uint8_t number, const char *name );
+void kernel_trace_name_queue( void *queue, const char *name );
+void kernel_trace_dump( void );
+
+#endif /* KERNEL_TRACE_H_INCLUDED */
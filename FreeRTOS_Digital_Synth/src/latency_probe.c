@@ -0,0 +1,175 @@
+/*************************************************************************************************
+                                         --LATENCY PROBE--
+
+	One note is measured at a time. Its state passes from task to task: the MIDI task
+	stamps a note while the probe waits for one, the render task turns the stamp into a
+	result once the sound shows, the console task releases the probe's note and moves on,
+	and each only writes the state it moves to, after everything that goes with it.
+
+	A sample before the note's arrival cannot be its sound, so the scan starts there; a
+	block with the note's first samples may still be midscale in them if the note was
+	scheduled later in the block, the next one carries on from its start.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include "latency_probe.h"
+#include "synth_engine.h"
+
+#if SYNTH_LATENCY_PROBE
+
+/**********  DEFINE  ************/
+#define PROBE_GAP_TICKS			(	200	)	//between a release and the next note
+#define PROBE_TIMEOUT_MS		(	1000	)
+#define PROBE_CHANNEL			(	0	)
+#define PROBE_VELOCITY			(	127	)
+
+
+/********   TYPE DEFS  **********/
+enum probe_state{
+	PROBE_IDLE,
+	PROBE_WAIT_NOTE,
+	PROBE_WAIT_SOUND,
+	PROBE_HEARD,			//or missed, the console task moves on
+	PROBE_DONE,
+};
+
+struct latency_probe_stats{
+	uint16_t notes;				//heard
+	uint16_t misses;
+	uint32_t min;				//in samples
+	uint32_t max;
+	uint32_t sum;
+};
+
+
+/*******   GLOBAL VARS  *********/
+static volatile uint8_t probe_state;
+static uint16_t probe_notes;
+static bool probe_send;
+static bool probe_sent;
+static uint32_t probe_last_tick;
+static uint32_t probe_arrival;
+static struct latency_probe_stats probe_stats;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void latency_probe_start( uint16_t notes, bool send )
+{
+	//from the console task; 'send' has the probe play the notes, otherwise they come from
+	//the inputs
+	probe_state = PROBE_IDLE;
+	probe_stats.notes = 0;
+	probe_stats.misses = 0;
+	probe_stats.min = UINT32_MAX;
+	probe_stats.max = 0;
+	probe_stats.sum = 0;
+	probe_notes = notes;
+	probe_send = send;
+	probe_sent = false;
+	probe_last_tick = 0;
+	if(notes > 0) probe_state = PROBE_WAIT_NOTE;
+}
+
+void latency_probe_stop( void )
+{
+	//from the console task, a note still sounding is left to its own release; a result the
+	//render task is writing just now ends it all the same
+	probe_notes = 0;
+	if(probe_state != PROBE_IDLE) probe_state = PROBE_DONE;
+}
+
+void latency_probe_note( const struct midi_event *event, uint32_t arrival )
+{
+	//MIDI task, every Note On with the sample its last byte arrived at
+	if(probe_state != PROBE_WAIT_NOTE) return;
+	if((event->status != MIDI_NOTE_ON) || (event->data2 == 0)) return;
+	if(probe_send && ((event->channel != PROBE_CHANNEL) || (event->data1 != SYNTH_LATENCY_PROBE_NOTE))) return;
+
+	probe_arrival = arrival;
+	probe_state = PROBE_WAIT_SOUND;
+}
+
+void latency_probe_frame( const uint16_t *frame, uint32_t time )
+{
+	//render task, every block with the render time of its first sample
+	uint32_t latency;
+	int32_t offset;
+	int code;
+	int i;
+
+	if(probe_state != PROBE_WAIT_SOUND) return;
+
+	offset = (int32_t) (probe_arrival - time);
+	for(i=(offset > 0) ? (int) offset * SYNTH_OUTPUT_CHANNELS : 0; i<SYNTH_FRAME_WORDS; i++)
+	{
+		code = (int) frame[i] - DAC_MIDSCALE;
+		if((code <= SYNTH_LATENCY_PROBE_THRESHOLD) && (code >= -SYNTH_LATENCY_PROBE_THRESHOLD)) continue;
+
+		latency = time + (uint32_t) (i / SYNTH_OUTPUT_CHANNELS) - probe_arrival;
+		probe_stats.notes++;
+		probe_stats.sum += latency;
+		if(latency < probe_stats.min) probe_stats.min = latency;
+		if(latency > probe_stats.max) probe_stats.max = latency;
+		probe_state = PROBE_HEARD;
+		return;
+	}
+
+	if((int32_t) (time + SYNTH_BLOCK_SIZE - probe_arrival) > (int32_t) ((synth_sample_rate() * PROBE_TIMEOUT_MS) / 1000))
+	{
+		probe_stats.misses++;
+		probe_state = PROBE_HEARD;
+	}
+}
+
+static void latency_probe_print( void )
+{
+	uint32_t rate = synth_sample_rate();
+
+	printf("probe: %u notes heard, %u missed\r\n", probe_stats.notes, probe_stats.misses);
+	if(probe_stats.notes == 0) return;
+
+	printf("probe: latency min %lu, avg %lu, max %lu us\r\n",
+		(unsigned long) (((uint64_t) probe_stats.min * 1000000) / rate),
+		(unsigned long) (((uint64_t) probe_stats.sum * 1000000) / ((uint64_t) rate * probe_stats.notes)),
+		(unsigned long) (((uint64_t) probe_stats.max * 1000000) / rate));
+}
+
+bool latency_probe_job( uint32_t tick, struct midi_event *event )
+{
+	//console task, every pass with the tick count: true with an event for the probe to post
+	switch(probe_state)
+	{
+	case PROBE_WAIT_NOTE:
+		if((probe_send == false) || probe_sent || ((uint32_t) (tick - probe_last_tick) < PROBE_GAP_TICKS)) return false;
+		event->status = MIDI_NOTE_ON;
+		event->data2 = PROBE_VELOCITY;
+		probe_sent = true;
+		break;
+
+	case PROBE_HEARD:
+		if((uint32_t) (probe_stats.notes + probe_stats.misses) >= probe_notes) probe_state = PROBE_DONE;
+		else probe_state = PROBE_WAIT_NOTE;
+		if(probe_send == false) return false;
+		event->status = MIDI_NOTE_OFF;
+		event->data2 = 0;
+		probe_sent = false;
+		probe_last_tick = tick;
+		break;
+
+	case PROBE_DONE:
+		latency_probe_print();
+		probe_state = PROBE_IDLE;
+		return false;
+
+	default:
+		return false;
+	}
+
+	event->channel = PROBE_CHANNEL;
+	event->data1 = SYNTH_LATENCY_PROBE_NOTE;
+	return true;
+}
+
+#endif /* SYNTH_LATENCY_PROBE */
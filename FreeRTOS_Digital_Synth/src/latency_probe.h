@@ -0,0 +1,39 @@
+/*************************************************************************************************
+                                         --LATENCY PROBE--
+
+	Measures the latency from a Note On reaching the synth to its sound leaving the DAC, for
+	picking the block size and frames in flight without an oscilloscope. Each note is
+	stamped with the sample playing when its last byte arrived, the same stamp the MIDI task
+	schedules it by, and the render task looks for its first sample further than
+	SYNTH_LATENCY_PROBE_THRESHOLD codes from midscale in the blocks after that. Both are
+	times of the output's own sample clock, so the difference is the latency as played,
+	the time the DAC's output stage takes to settle aside.
+
+	latency_probe_start() measures the next few notes. The probe sends its own, one at a
+	time with a pause between them and each released once heard, through the console's
+	event queue: those cover the MIDI task, the event queue, the engine and the frames in
+	flight. Notes from a keyboard or a tester on any input add the UART's reception of the
+	message, about 1 ms at 31250 baud. Nothing else should be sounding, the first sample
+	off midscale is taken for the note's; a note not heard within a second is a miss.
+
+	The MIDI task hands every Note On to latency_probe_note(), the render task every block
+	to latency_probe_frame(), and latency_probe_job() runs in the console task.
+
+*************************************************************************************************/
+
+#ifndef LATENCY_PROBE_H_INCLUDED
+#define LATENCY_PROBE_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void latency_probe_start( uint16_t notes, bool send );
+void latency_probe_stop( void );
+void latency_probe_note( const struct midi_event *event, uint32_t arrival );
+void latency_probe_frame( const uint16_t *frame, uint32_t time );
+bool latency_probe_job( uint32_t tick, struct midi_event *event );
+
+#endif /* LATENCY_PROBE_H_INCLUDED */
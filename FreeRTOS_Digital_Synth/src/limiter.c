@@ -0,0 +1,104 @@
+/*************************************************************************************************
+                                        --LIMITER--
+
+	Each block the gain heads for the lowest of three values: the gain that keeps the
+	incoming block's peak at the threshold, the one that did the same for the held block,
+	and the current gain released a step towards unity. The ramp ends there, so every sample
+	of the held block gets at most the gain its own peak allows and the next block starts
+	from a gain that suits it. Release is exponential, 1 / 2^release_shift of the way back to
+	unity per block, rounded up so it gets all the way there.
+
+	A threshold of zero bypasses the limiter without the period of latency. Switching it on
+	clears the held block, which drops one period of the output.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "limiter.h"
+#include "recip.h"
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int32_t limiter_target( int32_t threshold, int32_t peak );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void limiter_init( struct limiter *limiter, uint8_t release_shift )
+{
+	limiter->threshold = 0;
+	limiter->release_shift = release_shift;
+	limiter_set_threshold(limiter, 0);
+}
+
+void limiter_set_threshold( struct limiter *limiter, int32_t threshold )
+{
+	//threshold in DAC codes from the midscale, 0 is off
+	int i;
+
+	if(threshold < 0) threshold = 0;
+	if(threshold > 0 && limiter->threshold == 0)
+	{
+		for(i=0; i<SYNTH_CONTROL_PERIOD; i++) limiter->ahead[i] = 0;
+		limiter->gain = LIMITER_UNITY;
+		limiter->ahead_gain = LIMITER_UNITY;
+		limiter->ahead_peak = 0;
+	}
+
+	limiter->threshold = threshold;
+}
+
+bool limiter_idle( const struct limiter *limiter )
+{
+	//a silent block through a released limiter holding silence changes nothing
+	if(limiter->threshold == 0) return true;
+
+	return (limiter->ahead_peak == 0) && (limiter->gain == LIMITER_UNITY) && (limiter->ahead_gain == LIMITER_UNITY);
+}
+
+SYNTH_RAM_CODE static int32_t limiter_target( int32_t threshold, int32_t peak )
+{
+	if(peak <= threshold) return LIMITER_UNITY;
+
+	return (int32_t) recip_fraction((uint32_t) threshold, (uint32_t) peak, LIMITER_GAIN_SHIFT);
+}
+
+SYNTH_RAM_CODE void limiter_process( struct limiter *limiter, int32_t *buffer )
+{
+	//processes one control period in place, the output is the block before
+	int32_t peak = 0;
+	int32_t target;
+	int32_t next;
+	int32_t gain;
+	int32_t step;
+	int32_t x;
+	int i;
+
+	if(limiter->threshold == 0) return;
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++)
+	{
+		x = buffer[i];
+		x = (x ^ (x >> 31)) - (x >> 31);
+		if(x > peak) peak = x;
+	}
+
+	target = limiter_target(limiter->threshold, peak);
+	next = limiter->gain + ((LIMITER_UNITY - limiter->gain + (1l << limiter->release_shift) - 1) >> limiter->release_shift);
+	if(target < next) next = target;
+	if(limiter->ahead_gain < next) next = limiter->ahead_gain;
+
+	gain = limiter->gain << LIMITER_RAMP_SHIFT;
+	step = recip_div((next - limiter->gain) << LIMITER_RAMP_SHIFT, SYNTH_CONTROL_PERIOD);
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++)
+	{
+		gain += step;
+		x = buffer[i];
+		buffer[i] = (limiter->ahead[i] * (gain >> LIMITER_RAMP_SHIFT)) >> LIMITER_GAIN_SHIFT;
+		limiter->ahead[i] = x;
+	}
+
+	limiter->gain = next;
+	limiter->ahead_gain = target;
+	limiter->ahead_peak = peak;
+}
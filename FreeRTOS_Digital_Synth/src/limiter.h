@@ -0,0 +1,43 @@
+/*************************************************************************************************
+                                        --LIMITER--
+
+	Peak limiter ahead of the final saturate, so a hot mix at high polyphony is turned down
+	instead of squared off at the DAC rails. The limiter looks one control period ahead: it
+	holds each block back by one period, finds the peak of the block coming in, and ramps
+	the gain across the held block so it is already down when the peak reaches the output.
+	The gain is worked out once per block, one divide; per sample there is one multiply.
+
+*************************************************************************************************/
+
+#ifndef LIMITER_H_INCLUDED
+#define LIMITER_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//gains are Q12, 4096 = unity
+#define LIMITER_GAIN_SHIFT		(	12	)
+#define LIMITER_UNITY			(	1l << LIMITER_GAIN_SHIFT	)
+
+//ramp precision below the gain LSB
+#define LIMITER_RAMP_SHIFT		(	8	)
+
+/********   TYPE DEFS  **********/
+struct limiter{
+	int32_t ahead[SYNTH_CONTROL_PERIOD];
+	int32_t threshold;
+	int32_t gain;
+	int32_t ahead_gain;
+	int32_t ahead_peak;
+	uint8_t release_shift;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void limiter_init( struct limiter *limiter, uint8_t release_shift );
+void limiter_set_threshold( struct limiter *limiter, int32_t threshold );
+void limiter_process( struct limiter *limiter, int32_t *buffer );
+bool limiter_idle( const struct limiter *limiter );
+
+#endif /* LIMITER_H_INCLUDED */
@@ -2,8 +2,9 @@
                                           --READ ME--
 
 	This is a digital synthesizer instrument written for FreeRTOS. It receives MIDI note on/off 
-	commands via UART. It outputs to a Microchip MCP4821 DAC. It has three voices. Waveform can
-	be changed by MIDI program change command.
+	commands via UART. It outputs to a Microchip MCP4821 DAC, or to the SAMD21's own DAC or I2S,
+	see audio_output.h. It has three voices. Waveform can be changed by MIDI program change
+	command.
 
 	Author: Thaddeus Gulden
 	Last updated: 21 April 2017
@@ -12,97 +13,339 @@
 
 /******* HEADER INCLUDES ********/
 #include <asf.h>
+#include <string.h>
 #include "task.h"
 #include "semphr.h"
+#include "timers.h"
+#include "stream_buffer.h"
+#include "synth_engine.h"
+#include "dac_dma.h"
+#include "audio_output.h"
+#include "sample_clock.h"
+#include "midi_ring.h"
+#include "trace_log.h"
+#include "cycle_counter.h"
+#include "audio_stats.h"
+#include "audio_watchdog.h"
+#include "tickless_idle.h"
+#include "bench.h"
+#include "midi_flood.h"
+#include "stream.h"
+#include "spi_flash.h"
+#include "clock_scale.h"
+#include "mcp4821_spi.h"
+#include "trace_pins.h"
+#include "kernel_trace.h"
+#include "fill_stats.h"
+#include "block_pool.h"
+#include "debug_uart.h"
+#include "telemetry.h"
+#include "shell.h"
+#include "audio_tap.h"
+#include "midi_rx_dma.h"
+#include "usb_midi.h"
+#include "midi_uart.h"
+#include "midi_out.h"
+#include "voice_link.h"
+#include "preset.h"
+#include "panel_knobs.h"
+#include "audio_input.h"
+#include "recorder.h"
+#include "smf_player.h"
+#include "latency_probe.h"
+#include "poly_sweep.h"
+#include "flash_upload.h"
+#include "synth_core.h"
+#include "power_save.h"
+#include "ram_vectors.h"
+#include "meter_led.h"
 
 
 /**********  DEFINE  ************/
-#define	DAC_CMD_MASK		(	0x3000	) //to logical OR with every outgoing DAC sample, for MCP4821
-
 #define USART_BAUD_RATE		(	115200	)
 
 #define USART_BUFF_LEN		(	10		)
 
-#define portTICK_RATE_uS	(	(portTickType) 1000000 / configTICK_RATE_HZ	)
-
 #define SYSTEM_CLK_FREQ		configCPU_CLOCK_HZ
 
-#define SAMPLE_FREQ			configTICK_RATE_HZ
 
-#define SPI_BAUDRATE		(	20000000	)
+//how long ':voices' waits for the renderer's copy, a few blocks at the lowest rate
+#define VOICES_WAIT_MS		(	50	)
+
+//room for one line of kernel task stats per task
+#define TASK_STATS_BUFF_LEN	(	384	)
+
+//input blocks for the engine core, see synth_core.h
+#if SYNTH_AUDIO_INPUT
+#  define BOARD_INPUT		audio_input_block
+#else
+#  define BOARD_INPUT		NULL
+#endif
+
+//shell events waiting for the MIDI task
+#define CONSOLE_EVENT_QUEUE_LEN	(	4	)
+
+//bytes in the RX ring that wake the MIDI task even in the middle of a message
+#define MIDI_RX_WAKE_LEVEL	(	MIDI_RING_SIZE / 2	)
+
+//yields timed by the context switch benchmark, the least of them is reported
+#define SWITCH_BENCH_YIELDS	(	64	)
+
+//codes of the start-up ramp to mid-scale, 8 codes apart
+#define OUTPUT_RAMP_STEPS	(	256	)
+
+//task stacks in words, statically allocated so they show up in the .map; the trace log task
+//runs newlib printf and the kernel stats formatting
+#define SYNTH_TASK_STACK	(	256	)
+#define MIDI_TASK_STACK		(	160	)
+#define TRACE_TASK_STACK	(	500	)
+
+//priority plan, rate monotonic, the shortest deadline first: the output's interrupts (one
+//sample or one DMA block), the renderer (one block), the MIDI task (its bytes keep their
+//arrival time, so it has the whole output latency), the timer daemon, which samples the stats,
+//and last the console, telemetry and log task, which also runs the housekeeping jobs. The interrupt levels are SYNTH_IRQ_LEVEL_... in conf_synth.h, with
+//SysTick and PendSV below all of them, so no kernel interrupt delays the output's; the CM0
+//port masks every interrupt in its critical sections, so an ISR at any level may use the
+//FromISR API
+#define SYNTH_TASK_PRIORITY	(	3	)
+#define MIDI_TASK_PRIORITY	(	2	)
+#define TRACE_TASK_PRIORITY	(	0	)
+
+//SysTick and PendSV, both in SHPR3, at the lowest level
+#define KERNEL_IRQ_PRIORITIES	(	(0xFFul << 16) | (0xFFul << 24)	)
+
+#if (SYNTH_TASK_PRIORITY <= MIDI_TASK_PRIORITY) || (MIDI_TASK_PRIORITY <= configTIMER_TASK_PRIORITY) || (configTIMER_TASK_PRIORITY <= TRACE_TASK_PRIORITY)
+#  error "the task priorities must run renderer > MIDI > timer daemon > trace log"
+#endif
+
+//the engine builds for every part in conf_part.h, the clocks, DMAC and timers here do not yet
+#if !SYNTH_PART_BOARD
+#  error "main.c has no board bring-up for this part, only the engine sources build for it"
+#endif
+
+//sample clock ticks per block, the MCP4821 takes one per word
+#if SYNTH_OUTPUT_DMA && (SYNTH_OUTPUT_BACKEND == SYNTH_OUTPUT_MCP4821)
+#  define SAMPLE_CLOCK_BLOCK_TICKS	(	SYNTH_BLOCK_SIZE * SYNTH_OUTPUT_CHANNELS	)
+#else
+#  define SAMPLE_CLOCK_BLOCK_TICKS	(	SYNTH_BLOCK_SIZE	)
+#endif
+
+//MIDI inputs the MIDI task merges: the SERCOM1 UART, USB, the extra DIN ports and a voice
+//card's link
+#define MIDI_INPUTS			(	1 + SYNTH_USB_MIDI + SYNTH_MIDI_UART_INPUTS + (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)	)
+
+//the MIDI task's sleep once every input is empty; with panel knobs it wakes to look at them,
+//during a replay every tick
+#if SYNTH_PANEL_KNOBS
+#  define MIDI_IDLE_TICKS	(	SYNTH_PANEL_POLL_MS / portTICK_RATE_MS	)
+#else
+#  define MIDI_IDLE_TICKS	portMAX_DELAY
+#endif
+
+//replayed events the MIDI task takes from the recorder or the song player at a time
+#define REPLAY_BATCH		(	8	)
+
+//the SERCOM1 UART's realtime bytes reach the engine from its RX interrupt, with RX DMA there is
+//no interrupt per byte and they take the MIDI task's way like every other input's
+#define MIDI_REALTIME_FAST	(	!SYNTH_MIDI_RX_DMA	)
 
 /********   TYPE DEFS  **********/
 //voicing struct goes here
 
-union u16_to_u8 {
-	uint16_t u16;
-	uint8_t u8[2];
-};
-
-enum wave_type{
-	SQUARE,
-	SAW,
-	TRI
+//a MIDI input's ring with the parser that keeps its running status
+struct midi_input {
+	struct midi_ring *ring;
+	struct midi_parser parser;
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+	struct voice_link_parser *link;		//link packets instead of MIDI, for the voice link input
+#endif
 };
 
-//state variable for voice control
-struct voices{
-	bool v_enable;
-	enum wave_type v_type;
-	long v_counter;
-	long v_period;
-	int v_note_id;
+//one row of the stack usage report
+struct task_stack_info {
+	const char *name;
+	xTaskHandle handle;
+	uint16_t size;
 };
 
 /****** FUNCTION PROTOTYPES  ****/
 //clock config functions
 void configure_extosc32k(void);
 void configure_dfll_open_loop(void);
+void configure_dfll_closed_loop(void);
+static uint8_t dfll_coarse_calibration( void );
 void configure_gclock_generator( void );
 void configure_gclock_channel( void );
 void dfll_setup( void );
+void flash_setup( void );
 void extosc32k_setup( void );
+#if SYNTH_FAST_BOOT
+static void dfll_lock_job( void );
+#endif
+static void boot_time_mark( void );
+static void boot_time_report( void );
+static bool output_prime( void );
 
 //UART config functions
+static uint32_t midi_select_baud( void );
 void configure_usart(void);
 void configure_usart_EDBG(void);
 void configure_usart_callbacks(void);
-
-//SPI config functions
-void configure_spi_master(void);
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+static void configure_voice_link( void );
+static void link_report_callback( struct usart_module *const usart_module );
+#elif (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+static void link_answer( void );
+static void configure_interrupt_priorities( void );
+static void check_priorities( void );
+#endif
 
 //callbacks
+#if SYNTH_USB_MIDI || SYNTH_MIDI_UART_INPUTS || (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+static void midi_input_wake( void );
+#endif
+#if SYNTH_MIDI_RX_DMA
+void midi_rx_start_callback(struct usart_module *const usart_module);
+#elif SYNTH_MIDI_RX_FAST_ISR
+static void midi_rx_fast_handler( void );
+#else
 void usart_read_callback(struct usart_module *const usart_module);
+void usart_read_error_callback(struct usart_module *const usart_module);
+#endif
+void dac_frame_played_callback(uint16_t *played_frame, uint16_t *next_frame);
+static uint32_t board_cycles( void );
+static uint32_t board_deadline( void );
+static void board_submit( uint16_t *frame, const uint16_t *samples );
+#if !SYNTH_OUTPUT_DMA
+void dac_sample_tick( void );
+#endif
+void console_command( char c );
+uint32_t output_time( void );
+int output_frames_active( void );
+void output_set_frames( int count );
+void output_set_sample_rate( uint32_t rate );
+void vApplicationStackOverflowHook( xTaskHandle xTask, signed char *pcTaskName );
+void vApplicationIdleHook( void );
 
 //FreeRTOS Tasks
-static void vUARTHandlerTask( void *pvParameters );
-static void vPeriodicSPITask( void *pvParameters );
 static void vMIDIInterpreter( void *pvParameters );
-
-//Application functions
-void write_to_MCP4821( uint16_t input16 );
-void sample_calc( void );
-uint16_t fraction_of_FFF(long num, long den);
-long note_switcher(int note_id);
+static void midi_post( const struct midi_event *event, uint32_t time );
+static void midi_dispatch( void );
+#if SYNTH_CLOCK_SCALING
+static void clock_changed( void );
+#endif
+static void sample_fill_levels( xTimerHandle timer );
+#if SYNTH_TELEMETRY
+static void send_telemetry( void );
+#endif
+static void report_learn( void );
 
 
 /*******   GLOBAL VARS  *********/
-//SPI instances
-struct spi_module spi_master_instance;
-struct spi_slave_inst slave;
-
 //UART instance
 struct usart_module usart_instance;
 struct usart_module usart_instance_EDBG;
+static bool console_attached = true;	//false when the EDBG is unpowered, see power_save.h
 
 //FreeRTOS Vars
-xQueueHandle sampleQueue;
-xQueueHandle messageQueue;
+#if !SYNTH_OUTPUT_DMA
+xQueueHandle freeFrameQueue;	//frames the output stage is done with, for the renderer to refill
+xQueueHandle sampleQueue;		//rendered frames waiting for the sample clock ISR
+#endif
+
+//DFLL state after dfll_setup(), false when it runs open loop; with SYNTH_FAST_BOOT set once
+//dfll_lock_job() has closed the loop
+static bool dfll_locked;
+
+//start-up time, CPU cycles since system_init() folded into microseconds at each CPU clock
+//change, reported when the output plays the first block the renderer made
+static uint32_t boot_cycles;
+static uint32_t boot_us;
+static uint32_t boot_mhz;
+static bool boot_reported;
+
+//MIDI input, filled by the RX complete interrupt, or by vMIDIInterpreter from the RX DMA
+//buffer, and drained by vMIDIInterpreter
+static struct midi_ring midi_rx_ring;
+#if !SYNTH_MIDI_RX_DMA
+#if !SYNTH_MIDI_RX_FAST_ISR
+static uint16_t midi_rx_byte;
+#endif
+
+//where the bytes in the ring end a message, so the RX interrupt wakes vMIDIInterpreter once
+//per message; a SysEx wakes it at MIDI_RX_WAKE_LEVEL as well
+static struct midi_framer midi_rx_framer;
+#endif
+
+//MIDI line rate, SYNTH_MIDI_DIN_BAUD when the DIN input was selected
+static uint32_t midi_baud;
+
+#if SYNTH_USB_MIDI
+//USB-MIDI input, filled by the USB interrupt a packet at a time
+static struct midi_ring usb_rx_ring;
+#endif
+#if SYNTH_MIDI_UART_INPUTS
+//extra DIN inputs, see midi_uart.h
+static struct midi_ring uart_rx_ring[SYNTH_MIDI_UART_INPUTS];
+static struct midi_uart uart_rx_port[SYNTH_MIDI_UART_INPUTS];
+#endif
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+//a voice card's link from the master, see voice_link.h
+static struct midi_ring link_rx_ring;
+static struct midi_uart link_rx_port;
+static struct voice_link_parser link_rx_parser;
+#elif (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+//the master's link to its voice cards, and the cards' reports coming back on its receiver
+static struct usart_module usart_instance_link;
+static struct voice_link_parser link_report_parser;
+static uint16_t link_report_byte;
+#endif
+
+//every input with a parser of its own, so running status never spans two of them
+static struct midi_input midi_inputs[MIDI_INPUTS] = {
+	{ &midi_rx_ring },
+#if SYNTH_USB_MIDI
+	{ &usb_rx_ring },
+#endif
+#if SYNTH_MIDI_UART_INPUTS
+	{ &uart_rx_ring[0] },
+#endif
+#if SYNTH_MIDI_UART_INPUTS > 1
+	{ &uart_rx_ring[1] },
+#endif
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+	{ &link_rx_ring, { 0 }, &link_rx_parser },
+#endif
+};
 
-xSemaphoreHandle UARTsem;
+//every interrupt the output, the MIDI inputs and the console use, with its level in the plan
+static const struct{
+	enum system_interrupt_vector vector;
+	enum system_interrupt_priority_level level;
+	const char *name;
+} irq_plan[] = {
+	{ SYSTEM_INTERRUPT_MODULE_DMA, SYNTH_IRQ_LEVEL_OUTPUT, "DMAC" },
+	{ SYSTEM_INTERRUPT_MODULE_TC3, SYNTH_IRQ_LEVEL_OUTPUT, "TC3" },
+	{ SYSTEM_INTERRUPT_MODULE_EIC, SYNTH_IRQ_LEVEL_OUTPUT, "EIC" },
+#if SYNTH_WATCHDOG
+	{ SYSTEM_INTERRUPT_MODULE_WDT, SYNTH_IRQ_LEVEL_OUTPUT, "WDT" },
+#endif
+	{ SYSTEM_INTERRUPT_MODULE_SERCOM1, SYNTH_IRQ_LEVEL_INPUT, "SERCOM1" },
+	{ SYSTEM_INTERRUPT_MODULE_SERCOM2, SYNTH_IRQ_LEVEL_INPUT, "SERCOM2" },
+	{ SYSTEM_INTERRUPT_MODULE_SERCOM4, SYNTH_IRQ_LEVEL_INPUT, "SERCOM4" },
+	{ SYSTEM_INTERRUPT_MODULE_USB, SYNTH_IRQ_LEVEL_INPUT, "USB" },
+	{ SYSTEM_INTERRUPT_MODULE_SERCOM3, SYNTH_IRQ_LEVEL_CONSOLE, "SERCOM3" },
+};
 
-//SPI transfer union
-union u16_to_u8 SPI_union;
+//time of the last event posted, the engine needs them in order whichever input they came from
+static uint32_t midi_last_time;
+
+//events from the console shell, posted to the engine by vMIDIInterpreter, the engine's only
+//event producer; the shell is the only writer and the MIDI task the only reader, so a stream
+//buffer of whole events does, copied in one at a time and out all at once
+static uint8_t console_event_storage[CONSOLE_EVENT_QUEUE_LEN * sizeof(struct midi_event) + 1];
+static xStaticStreamBuffer console_event_buffer;
+static xStreamBufferHandle console_events;
 
 //UART buffer
 uint8_t	UART_buffer[USART_BUFF_LEN];
@@ -111,464 +354,2243 @@ uint8_t	UART_buffer[USART_BUFF_LEN];
 long n;
 long j;
 
-//voice state variables
-static struct voices active_voices[4];
-static bool full_queue_flag;
-static uint16_t sample_buffer;
+//application task handles, for the stack usage report; the MIDI RX interrupts notify midi_task
+//after each message, or at the start of a burst with the RX DMA
+static xTaskHandle synth_task;
+static xTaskHandle midi_task;
+static xTaskHandle trace_task;
+
+//task stacks, handed to the kernel in place of heap allocations
+static portSTACK_TYPE synth_task_stack[SYNTH_TASK_STACK];
+static portSTACK_TYPE midi_task_stack[MIDI_TASK_STACK];
+static portSTACK_TYPE trace_task_stack[TRACE_TASK_STACK];
+
+//queue and ring levels, sampled by stats_timer, see fill_stats.h
+static struct fill_stats fill_output;	//rendered frames waiting to be played
+static struct fill_stats fill_free;		//played frames waiting for the renderer
+static struct fill_stats fill_midi;		//MIDI bytes waiting for the parser
+static struct fill_stats fill_events;	//parsed events waiting for their render time
+static xTimerHandle stats_timer;
+
+//kernel task stats text, filled by the console commands
+static signed char task_stats_buffer[TASK_STATS_BUFF_LEN];
+
+//parameter names for the CC map commands, in enum synth_param order
+static const char *const param_names[SYNTH_PARAM_COUNT] = {
+	"none", "modwheel", "glidetime", "volume", "pan", "delaytime", "delayfeedback", "drive", "curve",
+	"crushbits", "crushhold", "limiter", "quality", "polyphony", "sustain", "portamento", "pulsewidth",
+	"resonance", "cutoff", "fmratio", "fmindex", "noisehold", "samplestart", "filtermode", "delaymix",
+	"chorusmix", "chorusdepth", "arpmode", "arprate", "arpoctaves", "lfosync", "delaysync", "pattern",
+	"drawbar1", "drawbar2", "drawbar3", "drawbar4", "drawbar5", "drawbar6", "drawbar7", "drawbar8", "drawbar9",
+	"detune", "sublevel", "suboctave", "morph", "vowel", "formantmix", "reverbmix", "reverbsize",
+	"grainsize", "graindensity", "grainspray", "automation"
+};
+
+#if SYNTH_VOICE_SNAPSHOT || SYNTH_POLY_SWEEP
+//for ':voices' and ':sweep', in enum wave_type order
+static const char *const wave_names[WAVE_TYPE_COUNT] = { "square", "saw", "tri", "square blep", "saw blep", "fm", "sine", "noise", "sample", "stream", "pluck", "organ", "sync", "ring", "supersaw", "morph", "drum", "grain" };
+#endif
+#if SYNTH_VOICE_SNAPSHOT
+//and enum env_stage order
+static const char *const env_stage_names[] = { "idle", "attack", "decay", "sustain", "release" };
+
+//the copy ':voices' prints, too big for the console task's stack
+static struct synth_snapshot voice_snapshot;
+#endif
+
+//rates the console steps through
+static const uint32_t sample_rates[] = { 16000, 20000, 22050, 32000, 44100, 48000 };
+
+//sample clock period in CPU cycles at the current rate
+static volatile uint32_t cycles_per_sample;
+
+//output frame pool, only pointers travel between renderer and output stage; word aligned for
+//outputs that move a stereo sample per DMA beat
+SYNTH_AUDIO_BUFFER static uint16_t sample_frames[SYNTH_OUTPUT_FRAMES][SYNTH_FRAME_WORDS];
+//the output backend, see audio_output.h; the CPU path only takes its name and prime
+static const struct audio_output *const audio_output = &AUDIO_OUTPUT_DEFAULT;
+//what the engine core takes from the board
+static const struct synth_hal board_hal = { SYNTH_PART_NAME, board_cycles, BOARD_INPUT, board_submit, board_deadline };
+#if SYNTH_OUTPUT_DMA
+
+//set once a frame holds freshly rendered samples, cleared when the DMA has played it
+static volatile bool frame_ready[SYNTH_OUTPUT_FRAMES];
+
+//slots the DMA has played, in order, for the renderer to refill: the frame callback owns the
+//head and notifies synth_task once per slot, the renderer owns the tail
+static volatile uint8_t played_slot[SYNTH_OUTPUT_FRAMES + 1];
+static volatile uint8_t played_head;
+static uint8_t played_tail;
+
+//renderer scratch block, copied into a frame as finished DAC words
+static uint16_t render_block[SYNTH_FRAME_WORDS];
+
+//render time of the first sample in each frame, and of the frame playing now with the cycle
+//count at which it started
+static uint32_t frame_time[SYNTH_OUTPUT_FRAMES];
+static volatile uint32_t output_frame_time;
+static volatile uint32_t output_frame_cycles;
+#else
+//frame samples the sample clock ISR has written, concealment samples do not count
+static volatile uint32_t output_samples;
+
+//frames allowed in flight, the renderer parks the rest of the pool
+static volatile int output_active = SYNTH_OUTPUT_FRAMES_ACTIVE;
+#endif
 
 
 /***  APPLICATION FUNCTIONS  ****/
-void write_to_MCP4821( uint16_t input16 )
+static void print_audio_stats( void )
+{
+	//render time against the block period plus output deadline misses
+	struct audio_stats stats;
+
+	audio_stats_get(&stats);
+	printf("audio: budget %lu cyc, last %lu, avg %lu, peak %lu\r\n", (unsigned long) stats.budget_cycles,
+		(unsigned long) stats.last_cycles, (unsigned long) stats.avg_cycles, (unsigned long) stats.peak_cycles);
+	printf("audio: load avg %u, peak %u per mille\r\n", (unsigned int) audio_stats_load(stats.avg_cycles),
+		(unsigned int) audio_stats_load(stats.peak_cycles));
+	printf("audio: %lu blocks, %lu underruns, %lu overruns\r\n", (unsigned long) stats.blocks,
+		(unsigned long) stats.underruns, (unsigned long) stats.overruns);
+	printf("audio: rate tables for %lu Hz built in %lu cyc\r\n", (unsigned long) synth_sample_rate(),
+		(unsigned long) synth_rate_cycles());
+#if SYNTH_DEADLINE
+	printf("audio: %lu blocks late, effects cut short\r\n", (unsigned long) stats.late);
+#endif
+#if SYNTH_STREAM
+	printf("audio: %lu stream underruns\r\n", (unsigned long) stream_underruns());
+#endif
+#if SYNTH_AUDIO_INPUT
+	printf("audio: %lu input overruns\r\n", (unsigned long) audio_input_overruns());
+#endif
+#if SYNTH_GOVERNOR
+	printf("audio: governor shed %lu voices, %s quality\r\n", (unsigned long) synth_governor_shed_count(),
+		synth_governor_draft() ? "draft" : "full");
+#endif
+#if SYNTH_CLOCK_SCALING
+	printf("audio: CPU at %lu Hz\r\n", (unsigned long) system_cpu_clock_get_hz());
+#endif
+#if (SYNTH_SAMPLE_SYNC == SYNTH_SAMPLE_SYNC_FOLLOWER)
+	printf("audio: %lu sync edges, last %ld clock counts early\r\n", (unsigned long) sample_clock_sync_edges(),
+		(long) sample_clock_sync_error());
+#endif
+#if SYNTH_DEBUG_UART_BUFFERED
+	printf("debug: %lu bytes of output dropped\r\n", (unsigned long) debug_uart_dropped());
+#endif
+}
+
+static void print_stack_usage( void )
 {
-	//writes to DAC with max voltage depth 2.048V
+	//smallest amount of stack each task has had left since it started
+	struct task_stack_info tasks[] = {
+		{ "Synth", synth_task, SYNTH_TASK_STACK },
+		{ "MIDI", midi_task, MIDI_TASK_STACK },
+		{ "Trace", trace_task, TRACE_TASK_STACK },
+		{ "Idle", xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE },
+		{ "Timer", xTimerGetTimerDaemonTaskHandle(), configTIMER_TASK_STACK_DEPTH },
+	};
+	int i;
+
+	for(i=0; i<(int) (sizeof(tasks) / sizeof(tasks[0])); i++)
+	{
+		printf("stack: %s\t%u of %u words never used\r\n", tasks[i].name,
+			(unsigned int) uxTaskGetStackHighWaterMark(tasks[i].handle), (unsigned int) tasks[i].size);
+	}
+}
 
-	union u16_to_u8 sample_to_send;
-	uint8_t sent_bytes[2];
+static uint32_t yield_cycles( void )
+{
+	//least cycles a taskYIELD() took, the runs an interrupt or the renderer got into are longer
+	uint32_t best = UINT32_MAX;
+	uint32_t start;
+	uint32_t cycles;
 	int i;
 
-	sample_to_send.u16 = (input16 & 0xFFF) | (DAC_CMD_MASK);
+	for(i=0; i<SWITCH_BENCH_YIELDS; i++)
+	{
+		start = cycle_counter_read();
+		taskYIELD();
+		cycles = cycle_counter_read() - start;
+		if(cycles < best) best = cycles;
+	}
 
-	sent_bytes[0] = sample_to_send.u8[1];
-	sent_bytes[1] = sample_to_send.u8[0];
+	return best;
+}
 
-	//send sample to spi peripheral in two, 8-bit chunks
-	spi_select_slave(&spi_master_instance, &slave, true);
-	spi_write_buffer_wait(&spi_master_instance, sent_bytes, 2);
-	spi_select_slave(&spi_master_instance, &slave, false);
+static void print_switch_cost( void )
+{
+	//console task: at its own priority a yield switches to the idle task, which yields straight
+	//back, two switches; one level up nothing else is ready and PendSV keeps the same task
+	uint32_t round_trip;
+	uint32_t same_task;
+
+	round_trip = yield_cycles();
+	vTaskPrioritySet(NULL, TRACE_TASK_PRIORITY + 1);
+	same_task = yield_cycles();
+	vTaskPrioritySet(NULL, TRACE_TASK_PRIORITY);
+
+	printf("switch: %lu cycles to the idle task and back, %lu for a yield that keeps the task\r\n",
+		(unsigned long) round_trip, (unsigned long) same_task);
 }
 
+static void print_latency( void )
+{
+	//MIDI events are scheduled with the same latency as the audio, see vMIDIInterpreter
+	uint32_t samples = (uint32_t) output_frames_active() * SYNTH_BLOCK_SIZE;
+
+	printf("latency: %d frames of %d samples, %lu samples = %lu us\r\n", output_frames_active(), SYNTH_BLOCK_SIZE,
+		(unsigned long) samples, (unsigned long) ((samples * 1000000ul) / synth_sample_rate()));
+}
 
-void sample_calc( void )
+static void print_midi_input( void )
 {
-	//generates sample for one time slice for all enabled voices
-	for(j=0; j<4; j++)
-	{
-		sample_buffer = 0;
-		if(active_voices[j].v_enable)
-		{
-			if(active_voices[j].v_type == SQUARE)
-			{
-				if(active_voices[j].v_counter <= (active_voices[j].v_period)/2)
-				{
-					sample_buffer += (uint16_t) (0xFFF >> 2);
-				}
-			}
+	printf("midi: %s input at %lu baud\r\n", (midi_baud == SYNTH_MIDI_DIN_BAUD) ? "DIN" : "bridge", (unsigned long) midi_baud);
+}
 
-			if(active_voices[j].v_type == SAW)
-			{
-				sample_buffer += (uint16_t) (fraction_of_FFF(active_voices[j].v_counter, active_voices[j].v_period) >> 2);
-			}
+static void print_line_errors( const char *prefix, const struct midi_ring *ring )
+{
+	//the kinds, when there were any; the parser resynced after each run of them
+	if(midi_ring_errors(ring) == 0) return;
 
-			if(active_voices[j].v_type == TRI)
-			{
-				if(active_voices[j].v_counter <= ((active_voices[j].v_period) >> 1))
-				{
-					sample_buffer += (uint16_t) (fraction_of_FFF((active_voices[j].v_counter << 1), active_voices[j].v_period) >> 2);
-				}
-				else if(active_voices[j].v_counter > ((active_voices[j].v_period) >> 1))
-				{
-					sample_buffer += (uint16_t) (fraction_of_FFF(((active_voices[j].v_period - active_voices[j].v_counter) << 1), active_voices[j].v_period) >> 2);
-				}
-			}
+	printf("%s %u framing, %u overflow, %u parity\r\n", prefix, (unsigned int) ring->errors[MIDI_LINE_FRAMING],
+		(unsigned int) ring->errors[MIDI_LINE_OVERFLOW], (unsigned int) ring->errors[MIDI_LINE_PARITY]);
+}
 
-			if(active_voices[j].v_counter < active_voices[j].v_period)
-			{
-				active_voices[j].v_counter++;
-			}
-			else active_voices[j].v_counter = 0;
-		}
+static void print_midi_stats( void )
+{
+	//input path fill levels and losses, the late figure is how far behind its render time
+	//the worst event was applied
+#if SYNTH_MIDI_UART_INPUTS || (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+	int i;
+
+#endif
+	print_midi_input();
+	printf("midi: ring peak %u of %u, %u bytes dropped, %u receive errors\r\n", (unsigned int) midi_rx_ring.peak,
+		MIDI_RING_SIZE, (unsigned int) midi_rx_ring.dropped, (unsigned int) midi_ring_errors(&midi_rx_ring));
+	print_line_errors("midi:", &midi_rx_ring);
+	printf("midi: events peak %u of %u, %u dropped, worst %lu samples late\r\n", (unsigned int) synth_events_peak(),
+		SYNTH_EVENT_QUEUE_SIZE, (unsigned int) synth_events_dropped(), (unsigned long) synth_events_late_max());
+#if SYNTH_USB_MIDI
+	printf("usb: %s, %lu packets, ring peak %u of %u, %u bytes dropped\r\n", usb_midi_configured() ? "configured" : "not configured",
+		(unsigned long) usb_midi_packets(), (unsigned int) usb_rx_ring.peak, MIDI_RING_SIZE, (unsigned int) usb_rx_ring.dropped);
+#endif
+#if SYNTH_MIDI_UART_INPUTS
+	for(i=0; i<SYNTH_MIDI_UART_INPUTS; i++)
+	{
+		printf("midi: DIN %d ring peak %u of %u, %u bytes dropped, %u receive errors\r\n", i + 2, (unsigned int) uart_rx_ring[i].peak,
+			MIDI_RING_SIZE, (unsigned int) uart_rx_ring[i].dropped, (unsigned int) midi_ring_errors(&uart_rx_ring[i]));
+		print_line_errors("midi:", &uart_rx_ring[i]);
+	}
+#endif
+#if SYNTH_MIDI_OUT
+	printf("midi: out %s, %lu bytes sent, %u messages dropped\r\n", (SYNTH_MIDI_OUT == SYNTH_MIDI_OUT_THRU) ? "thru" : "overflow",
+		(unsigned long) midi_out_bytes(), (unsigned int) midi_out_dropped());
+#endif
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+	printf("link: card %d, ring peak %u of %u, %u bytes dropped, %u receive errors\r\n", SYNTH_VOICE_CARD_ID, (unsigned int) link_rx_ring.peak,
+		MIDI_RING_SIZE, (unsigned int) link_rx_ring.dropped, (unsigned int) midi_ring_errors(&link_rx_ring));
+	print_line_errors("link:", &link_rx_ring);
+#elif (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+	for(i=0; i<SYNTH_VOICE_LINK_CARDS; i++)
+	{
+		if(voice_link_card_load(i) == 0xFFFF) printf("link: card %d has %u notes, no load report\r\n", i, (unsigned int) voice_link_card_notes(i));
+		else printf("link: card %d has %u notes, load %u per mille\r\n", i, (unsigned int) voice_link_card_notes(i), (unsigned int) voice_link_card_load(i));
 	}
+	printf("link: %lu bytes sent, %u packets dropped\r\n", (unsigned long) midi_out_bytes(), (unsigned int) midi_out_dropped());
+#endif
+#if SYNTH_MIDI_FLOOD
+	printf("midi: %lu flood bytes sent at %lu baud\r\n", (unsigned long) midi_flood_bytes_sent(), (unsigned long) midi_baud);
+#endif
+#if SYNTH_PANEL_KNOBS
+	printf("panel: %d knobs, %u scan restarts\r\n", SYNTH_PANEL_KNOBS, (unsigned int) panel_knobs_restarts());
+#endif
+#if SYNTH_RECORDER
+	printf("recorder: take of %lu events, %lu s; %lu dropped recording\r\n", (unsigned long) recorder_take_events(),
+		(unsigned long) recorder_take_seconds(), (unsigned long) recorder_dropped());
+#endif
+#if SYNTH_SMF_PLAYER
+	printf("song: %s, %lu stalls\r\n", smf_player_playing() ? "playing" : "stopped", (unsigned long) smf_player_stalls());
+#endif
 }
 
-uint16_t fraction_of_FFF(long num, long den)
+static void sample_fill_levels( xTimerHandle timer )
 {
-	//returns a fraction of 0xFFF based on numerator and denominator, for sample calculation
-	float num_f = num;
-	float den_f = den;
-	float output = (float) 0xFFF;
-
-	output = output * (num_f/den_f);
+	//timer daemon, every SYNTH_STATS_SAMPLE_MS; the renderer preempts it, so it sees the levels
+	//between blocks
+#if SYNTH_OUTPUT_DMA
+	uint16_t ready = 0;
+	int i;
+#endif
 
-	return ((uint16_t) output);
+	(void) timer;
+#if SYNTH_OUTPUT_DMA
+	for(i=0; i<SYNTH_OUTPUT_FRAMES; i++) if(frame_ready[i]) ready++;
+	fill_stats_sample(&fill_output, ready);
+	fill_stats_sample(&fill_free, (uint16_t) ((played_head + SYNTH_OUTPUT_FRAMES + 1 - played_tail) % (SYNTH_OUTPUT_FRAMES + 1)));
+#else
+	fill_stats_sample(&fill_output, (uint16_t) uxQueueMessagesWaiting(sampleQueue));
+	fill_stats_sample(&fill_free, (uint16_t) uxQueueMessagesWaiting(freeFrameQueue));
+#endif
+	fill_stats_sample(&fill_midi, midi_ring_count(&midi_rx_ring));
+	fill_stats_sample(&fill_events, synth_events_queued());
 }
 
-long note_switcher(int note_id)
+static void print_fill_levels( void )
 {
-	switch(note_id)
-	{
-		//returns (sample frequency)/(note frequency)
-		//only filled in one octave for testing
-		case 48: //C3
-		return 154;
-		break;
-
-		case 49: //Db3
-		return 144;
-		break;
+	//levels since the last query or telemetry frame, either starts a new window
+	struct fill_stats *fills[] = { &fill_output, &fill_free, &fill_midi, &fill_events };
+	static const char *const names[] = { "output", "free", "midi", "events" };
+	int i;
 
-		case 50: //D3
-		return 136;
-		break;
-		
-		case 51: //Eb3
-		return 129;
-		break;
+	for(i=0; i<(int) (sizeof(fills) / sizeof(fills[0])); i++)
+	{
+		printf("fill: %s\t%u now, min %u, max %u of %u\r\n", names[i], (unsigned int) fills[i]->current,
+			(unsigned int) fills[i]->min, (unsigned int) fills[i]->max, (unsigned int) fills[i]->size);
+		fill_stats_reset(fills[i]);
+	}
+}
 
-		case 52: //E3
-		return 121;
-		break;
+static void print_pool_stats( void )
+{
+	//high water marks since boot, a pool's blocks are its budget for the whole session
+	const struct block_pool *pool;
 
-		case 53: //F3
-		return 115;
-		break;		
-		
-		case 54: //Gb3
-		return 108;
-		break;
+	for(pool=block_pool_first(); pool!=NULL; pool=pool->next)
+	{
+		printf("pool: %s\t%u out, max %u of %u, %u misses\r\n", pool->name, (unsigned int) pool->used,
+			(unsigned int) pool->high_water, (unsigned int) pool->blocks, (unsigned int) pool->misses);
+	}
+}
 
-		case 55: //G3
-		return 102;
-		break;
+#if SYNTH_TELEMETRY
+static void send_telemetry( void )
+{
+	//console task job, once per SYNTH_TELEMETRY_PERIOD_MS; the frame's min and max cover the
+	//period since the last one
+	struct audio_stats stats;
+	struct telemetry_sample sample;
+#if SYNTH_METERS
+	struct synth_levels levels;
+#endif
 
-		case 56: //Ab3
-		return 96;
-		break;
-		
-		case 57: //A3
-		return 91;
-		break;
+	if(telemetry_enabled() == false) return;
+
+	audio_stats_get(&stats);
+	sample.tick_ms = xTaskGetTickCount() * portTICK_RATE_MS;
+	sample.load_avg = audio_stats_load(stats.avg_cycles);
+	sample.load_peak = audio_stats_load(stats.peak_cycles);
+	sample.voices = (uint8_t) synth_voice_count();
+	sample.frames_active = (uint8_t) output_frames_active();
+	sample.blocks = stats.blocks;
+	sample.underruns = stats.underruns;
+	sample.overruns = stats.overruns;
+	sample.fills[0] = &fill_output;
+	sample.fills[1] = &fill_free;
+	sample.fills[2] = &fill_midi;
+	sample.fills[3] = &fill_events;
+	sample.midi_dropped = midi_rx_ring.dropped;
+	sample.events_dropped = synth_events_dropped();
+	sample.midi_framing = midi_rx_ring.errors[MIDI_LINE_FRAMING];
+	sample.midi_overflow = midi_rx_ring.errors[MIDI_LINE_OVERFLOW];
+	sample.midi_parity = midi_rx_ring.errors[MIDI_LINE_PARITY];
+
+	telemetry_send(&sample);
+#if SYNTH_METERS
+	synth_levels(&levels);
+	telemetry_send_levels(sample.tick_ms, &levels);
+#endif
+	fill_stats_reset(&fill_output);
+	fill_stats_reset(&fill_free);
+	fill_stats_reset(&fill_midi);
+	fill_stats_reset(&fill_events);
+}
+#endif
 
-		case 58: //Bb3
-		return 89;
-		break;
+static void report_learn( void )
+{
+	//console task job, every pass: the result of a MIDI learn
+	uint8_t channel;
+	uint8_t controller;
+	enum synth_param param;
 
-		case 59: //B3
-		return 81;
-		break;
+	if(synth_cc_learned(&channel, &controller, &param))
+	{
+		printf("learn: cc %u on channel %u drives %s\r\n", (unsigned int) controller, (unsigned int) channel + 1, param_names[param]);
 	}
 }
 
-
-/******  CONFIG FUNCTIONS  ******/
-//clock config functions
-void dfll_setup( void )
+static void next_sample_rate( void )
 {
-	#if (!SAMC21)
-	/* Configure the DFLL in open loop mode using default values */
-	configure_dfll_open_loop();
-	/* Enable the DFLL oscillator */
-	enum status_code dfll_status =
-	system_clock_source_enable(SYSTEM_CLOCK_SOURCE_DFLL);
-	if (dfll_status != STATUS_OK) {
-		/* Error enabling the clock source */
+	//steps to the next rate in the list, wrapping back to the lowest
+	int i;
+	uint32_t rate = sample_rates[0];
+
+	for(i=0; i<(int) (sizeof(sample_rates) / sizeof(sample_rates[0])); i++)
+	{
+		if(sample_rates[i] > synth_sample_rate())
+		{
+			rate = sample_rates[i];
+			break;
+		}
 	}
-	/* Configure flash wait states before switching to high frequency clock */
-	system_flash_set_waitstates(2);
-	/* Change system clock to DFLL */
-	struct  system_gclk_gen_config config_gclock_gen;
-	system_gclk_gen_get_config_defaults(&config_gclock_gen);
-	config_gclock_gen.source_clock = SYSTEM_CLOCK_SOURCE_DFLL;
-	config_gclock_gen.division_factor = 1;
-	system_gclk_gen_set_config(GCLK_GENERATOR_0, &config_gclock_gen);
-	#endif
+
+	output_set_sample_rate(rate);
+	printf("rate: %lu Hz\r\n", (unsigned long) synth_sample_rate());
+	print_latency();
 }
 
-void extosc32k_setup( void )
+static void console_post( uint8_t status, uint8_t channel, uint8_t data1, uint8_t data2 )
 {
-	/* Configure the external 32KHz oscillator */
-	configure_extosc32k();
-	/* Enable the external 32KHz oscillator */
-		enum status_code osc32k_status =
-	system_clock_source_enable(SYSTEM_CLOCK_SOURCE_XOSC32K);
-	if (osc32k_status != STATUS_OK) {
-		/* Error enabling the clock source */
+	//hands an event to the MIDI task and wakes it
+	struct midi_event event = { status, channel, data1, data2 };
+
+	//all or nothing, only this task writes, so the room cannot shrink before the send
+	if(xStreamBufferSpacesAvailable( console_events ) < sizeof(event))
+	{
+		printf("shell: event queue full\r\n");
+		return;
 	}
+	xStreamBufferSend( console_events, &event, sizeof(event), 0 );
+	xTaskNotifyGive( midi_task );
 }
 
-void configure_extosc32k( void )
+static void shell_help_command( char *argv[] )
 {
-	//starts the 32kHz external reference clock
-	struct  system_clock_source_xosc32k_config config_ext32k;
-	system_clock_source_xosc32k_get_config_defaults(&config_ext32k);
-	config_ext32k.startup_time = SYSTEM_XOSC32K_STARTUP_4096;
-	system_clock_source_xosc32k_set_config(&config_ext32k);
+	(void) argv;
+	shell_help();
 }
 
-#if (!SAMC21)
-void configure_dfll_open_loop( void )
+static void shell_stats_command( char *argv[] )
 {
-	//configures 48MHz DFLL
-	struct  system_clock_source_dfll_config config_dfll;
-	system_clock_source_dfll_get_config_defaults(&config_dfll);
-	system_clock_source_dfll_set_config(&config_dfll);
+	(void) argv;
+	print_audio_stats();
+	print_midi_stats();
+	print_fill_levels();
+	print_pool_stats();
 }
-#endif
 
-void configure_gclock_generator( void )
+static void shell_frames_command( char *argv[] )
 {
-	//configures slow clock generator for serial devices
-	struct  system_gclk_gen_config gclock_gen_conf;
-	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
-	#if (SAML21) || (SAML22)
-	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_OSC16M;
-	gclock_gen_conf.division_factor = 1;
-	#elif (SAMC21)
-	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_OSC48M;
-	gclock_gen_conf.division_factor = 1;
-	#else
-	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_OSC8M;
-	gclock_gen_conf.division_factor = 1;
-	#endif
-	system_gclk_gen_set_config(GCLK_GENERATOR_2, &gclock_gen_conf);
-	system_gclk_gen_enable(GCLK_GENERATOR_2);
+	//the block size is fixed at build time, the frames in flight are the latency knob
+	int32_t frames;
+
+	if(!shell_number(argv[0], 3, SYNTH_OUTPUT_FRAMES, &frames)) return;
+	output_set_frames((int) frames);
+	print_latency();
 }
 
-void configure_gclock_channel( void )
+static void shell_rate_command( char *argv[] )
 {
-	//configures slow clock channel
-	struct  system_gclk_chan_config gclk_chan_conf;
-	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
-	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
-	#if (SAMD10) || (SAMD11)
-	system_gclk_chan_set_config(TC1_GCLK_ID, &gclk_chan_conf);
-	system_gclk_chan_enable(TC1_GCLK_ID);
-	#else
-	system_gclk_chan_set_config(TC3_GCLK_ID, &gclk_chan_conf);
-	system_gclk_chan_enable(TC3_GCLK_ID);
-	#endif
+	int32_t rate;
+
+	if(!shell_number(argv[0], SYNTH_SAMPLE_RATE_MIN, SYNTH_SAMPLE_RATE_MAX, &rate)) return;
+	output_set_sample_rate((uint32_t) rate);
+	printf("rate: %lu Hz\r\n", (unsigned long) synth_sample_rate());
+	print_latency();
 }
 
-void configure_usart(void)
+static void shell_poly_command( char *argv[] )
 {
-	//configures UART for MIDI communication
-	struct usart_config config_usart;
-	usart_get_config_defaults(&config_usart);
-	config_usart.baudrate = USART_BAUD_RATE;
-	config_usart.mux_setting = USART_RX_1_TX_0_XCK_1;
-	config_usart.pinmux_pad0 = PINMUX_PA16C_SERCOM1_PAD0;
-	config_usart.pinmux_pad1 = PINMUX_PA17C_SERCOM1_PAD1;
-	config_usart.pinmux_pad2 = PINMUX_UNUSED;
-	config_usart.pinmux_pad3 = PINMUX_UNUSED;
-	config_usart.start_frame_detection_enable = true;
-	config_usart.generator_source = GCLK_GENERATOR_2;
-	while (usart_init(&usart_instance, SERCOM1
-	, &config_usart) != STATUS_OK) {
-	}
-	usart_enable(&usart_instance);
+	int32_t voices;
+
+	if(!shell_number(argv[0], 1, SYNTH_MAX_VOICES, &voices)) return;
+	console_post(MIDI_CONTROL_CHANGE, 0, MIDI_CC_POLYPHONY, (uint8_t) voices);
+	printf("poly: %ld of %d voices\r\n", (long) voices, SYNTH_MAX_VOICES);
 }
 
-void configure_usart_callbacks(void)
+static void shell_quality_command( char *argv[] )
 {
-	//registers callback for start of frame on UART
-	usart_register_callback(&usart_instance,
-	usart_read_callback, USART_CALLBACK_START_RECEIVED);
-	usart_enable_callback(&usart_instance, USART_CALLBACK_START_RECEIVED);
+	//the controller spreads the levels built in evenly, 43 apart without oversampling
+	int32_t channel;
+	int32_t quality;
+
+	if(!shell_number(argv[0], 1, 16, &channel)) return;
+	if(!shell_number(argv[1], SYNTH_OSC_TRUNCATE, SYNTH_OSC_QUALITY_MAX, &quality)) return;
+	console_post(MIDI_CONTROL_CHANGE, (uint8_t) (channel - 1), MIDI_CC_OSC_QUALITY, (uint8_t) ((quality * 128 + SYNTH_OSC_QUALITY_MAX) / (SYNTH_OSC_QUALITY_MAX + 1)));
 }
 
-void configure_usart_EDBG(void)
+static void shell_gain_command( char *argv[] )
 {
-	//Debug UART config
-	struct usart_config config_usart;
-	usart_get_config_defaults(&config_usart);
-	config_usart.baudrate = USART_BAUD_RATE;
-	config_usart.mux_setting = EDBG_CDC_SERCOM_MUX_SETTING;
-	config_usart.pinmux_pad0 = EDBG_CDC_SERCOM_PINMUX_PAD0;
-	config_usart.pinmux_pad1 = EDBG_CDC_SERCOM_PINMUX_PAD1;
-	config_usart.pinmux_pad2 = EDBG_CDC_SERCOM_PINMUX_PAD2;
-	config_usart.pinmux_pad3 = EDBG_CDC_SERCOM_PINMUX_PAD3;
-	config_usart.generator_source = GCLK_GENERATOR_2;
-	
-	stdio_serial_init(&usart_instance_EDBG, EDBG_CDC_MODULE, &config_usart);
+	//a single store the renderer ramps towards, safe from this task
+	int32_t gain;
 
-	usart_enable(&usart_instance_EDBG);
+	if(!shell_number(argv[0], 0, SYNTH_MASTER_GAIN_MAX, &gain)) return;
+	synth_set_master_gain((uint16_t) gain);
 }
 
-void configure_spi_master(void)
-{
-	struct spi_config config_spi_master;
-	struct spi_slave_inst_config slave_dev_config;
-	/* Configure and initialize software device instance of peripheral
-	slave */
-	spi_slave_inst_get_config_defaults(&slave_dev_config);
-	slave_dev_config.ss_pin = PIN_PB08;
-	spi_attach_slave(&slave, &slave_dev_config);
-	/* Configure, initialize and enable SERCOM SPI module */
-	spi_get_config_defaults(&config_spi_master);
-	config_spi_master.mux_setting = EXT1_SPI_SERCOM_MUX_SETTING;
-	/* Configure pad 0 for data in */
-	config_spi_master.pinmux_pad0 = EXT1_SPI_SERCOM_PINMUX_PAD0;
-	/* Configure pad 1 as unused */
-	config_spi_master.pinmux_pad1 = PINMUX_UNUSED;
-	/* Configure pad 2 for data out */
-	config_spi_master.pinmux_pad2 = EXT1_SPI_SERCOM_PINMUX_PAD2; //PA06
-	/* Configure pad 3 for SCK */
-	config_spi_master.pinmux_pad3 = EXT1_SPI_SERCOM_PINMUX_PAD3; //PA07
-	config_spi_master.generator_source = GCLK_GENERATOR_0;
-	spi_init(&spi_master_instance, EXT1_SPI_MODULE, &config_spi_master);
-	spi_enable(&spi_master_instance);
-	spi_set_baudrate(&spi_master_instance, SPI_BAUDRATE);
+static void shell_cc_command( char *argv[] )
+{
+	int32_t channel;
+	int32_t controller;
+	int32_t value;
+
+	if(!shell_number(argv[0], 1, 16, &channel)) return;
+	if(!shell_number(argv[1], 0, 127, &controller)) return;
+	if(!shell_number(argv[2], 0, 127, &value)) return;
+	console_post(MIDI_CONTROL_CHANGE, (uint8_t) (channel - 1), (uint8_t) controller, (uint8_t) value);
 }
 
-/*****  INTERRUPT HANDLERS  *****/
-void usart_read_callback(struct usart_module *const usart_module)
+static void shell_pattern_command( char *argv[] )
 {
-	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+	//goes through the CC map like any controller, channel 1's default one
+	int32_t number;
+
+	if(!shell_number(argv[0], 0, pattern_count, &number)) return;
+	console_post(MIDI_CONTROL_CHANGE, 0, MIDI_CC_PATTERN, (uint8_t) number);
+}
 
-	//sets semaphore for secondary handler task to receive
-	xSemaphoreGiveFromISR( UARTsem, &xHigherPriorityTaskWoken );
+static void shell_automation_command( char *argv[] )
+{
+	//CC 84 on channel 1, through the map like the pattern
+	int32_t mode;
 
-	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
-	printf( "Interrupt - Semaphore generated.\r\n" );
+	if(!shell_number(argv[0], 0, AUTOMATION_RECORD, &mode)) return;
+	console_post(MIDI_CONTROL_CHANGE, 0, MIDI_CC_AUTOMATION, (uint8_t) ((mode * 127) / AUTOMATION_RECORD));
 }
 
+#if SYNTH_TUNING
+static void shell_tune_command( char *argv[] )
+{
+	//sent as an MTS single note change would come in
+	int32_t note;
+	int32_t cents;
+	int32_t pitch;
+
+	if(!shell_number(argv[0], 0, 127, &note)) return;
+	if(!shell_number(argv[1], -6400, 6400, &cents)) return;
+	pitch = (note << NOTE_PITCH_SHIFT) + (cents << NOTE_PITCH_SHIFT) / 100;
+	if(pitch < 0) pitch = 0;
+	if(pitch > NOTE_PITCH_MAX) pitch = NOTE_PITCH_MAX;
+	console_post(MIDI_TUNING_NOTE, (uint8_t) note, (uint8_t) (pitch >> NOTE_PITCH_SHIFT), (uint8_t) (pitch & 0x7F));
+}
 
-/******  FreeRTOS TASKS   *******/
-static void vUARTHandlerTask( void *pvParameters )
-{	
-	uint16_t temp;
-	uint8_t temp8;
+static void shell_tuneoctave_command( char *argv[] )
+{
+	//one pitch class in every octave, as an MTS scale/octave message would
+	int32_t pitch_class;
+	int32_t cents;
 
-	//attempts to take semaphore if it is set
+	if(!shell_number(argv[0], 0, 11, &pitch_class)) return;
+	if(!shell_number(argv[1], -64, 63, &cents)) return;
+	console_post(MIDI_TUNING_SCALE, (uint8_t) pitch_class, (uint8_t) (cents + 64), 0);
+}
 
-	while(1)
+static void shell_untune_command( char *argv[] )
+{
+	console_post(MIDI_TUNING_SCALE, MIDI_TUNING_RESET, 0, 0);
+}
+#endif
+
+static void shell_program_command( char *argv[] )
+{
+	int32_t channel;
+	int32_t program;
+
+	if(!shell_number(argv[0], 1, 16, &channel)) return;
+	if(!shell_number(argv[1], 0, 127, &program)) return;
+	console_post(MIDI_PROGRAM_CHANGE, (uint8_t) (channel - 1), (uint8_t) program, 0);
+}
+
+static bool shell_param( const char *word, enum synth_param *param )
+{
+	//a parameter by its :params name or number
+	int32_t number;
+	int i;
+
+	for(i=0; i<SYNTH_PARAM_COUNT; i++)
+	{
+		if(strcmp(word, param_names[i]) == 0)
+		{
+			*param = (enum synth_param) i;
+			return true;
+		}
+	}
+	if(!shell_number(word, 0, SYNTH_PARAM_COUNT - 1, &number)) return false;
+
+	*param = (enum synth_param) number;
+	return true;
+}
+
+static void shell_params_command( char *argv[] )
+{
+	int i;
+
+	(void) argv;
+	for(i=1; i<SYNTH_PARAM_COUNT; i++) printf("%d %s\r\n", i, param_names[i]);
+}
+
+static void shell_learn_command( char *argv[] )
+{
+	int32_t channel;
+	enum synth_param param;
+
+	if(!shell_number(argv[0], 1, 16, &channel)) return;
+	if(!shell_param(argv[1], &param)) return;
+	if(synth_cc_request((uint8_t) (channel - 1), SYNTH_CC_LEARN, param, 0, 127)) printf("learn: move a controller on channel %ld\r\n", (long) channel);
+	else printf("learn: the last request is still pending\r\n");
+}
+
+static void shell_ccmap_command( char *argv[] )
+{
+	int32_t channel;
+	int32_t controller;
+	enum synth_param param;
+	int32_t low;
+	int32_t high;
+
+	if(!shell_number(argv[0], 1, 16, &channel)) return;
+	if(!shell_number(argv[1], 0, MIDI_CC_ALL_SOUND_OFF - 1, &controller)) return;
+	if(!shell_param(argv[2], &param)) return;
+	if(!shell_number(argv[3], 0, 127, &low)) return;
+	if(!shell_number(argv[4], 0, 127, &high)) return;
+	if(!synth_cc_request((uint8_t) (channel - 1), (uint8_t) controller, param, (uint8_t) low, (uint8_t) high)) printf("ccmap: the last request is still pending\r\n");
+}
+
+static void shell_ccmaps_command( char *argv[] )
+{
+	int32_t channel;
+	enum synth_param param;
+	uint8_t low;
+	uint8_t high;
+	int i;
+
+	if(!shell_number(argv[0], 1, 16, &channel)) return;
+	for(i=0; i<MIDI_CC_ALL_SOUND_OFF; i++)
+	{
+		param = synth_cc_param((uint8_t) (channel - 1), (uint8_t) i, &low, &high);
+		if(param != SYNTH_PARAM_NONE) printf("cc %d\t%s %u..%u\r\n", i, param_names[param], (unsigned int) low, (unsigned int) high);
+	}
+}
+
+#if SYNTH_PRESETS
+static void shell_save_command( char *argv[] )
+{
+	//the channel's patch as of the renderer's last block
+	struct synth_patch patch;
+	int32_t program;
+	int32_t channel;
+
+	if(!shell_number(argv[0], 0, SYNTH_PRESET_COUNT - 1, &program)) return;
+	if(!shell_number(argv[1], 1, 16, &channel)) return;
+	synth_get_patch((uint8_t) (channel - 1), &patch);
+	if(preset_save((uint8_t) program, &patch)) printf("presets: program %ld saved from channel %ld\r\n", (long) program, (long) channel);
+	else printf("presets: flash write failed, program %ld unchanged\r\n", (long) program);
+}
+
+static void shell_forget_command( char *argv[] )
+{
+	int32_t program;
+
+	if(!shell_number(argv[0], 0, SYNTH_PRESET_COUNT - 1, &program)) return;
+	if(preset_save((uint8_t) program, NULL)) printf("presets: program %ld back to a waveform select\r\n", (long) program);
+	else printf("presets: flash write failed, program %ld unchanged\r\n", (long) program);
+}
+
+static void shell_presets_command( char *argv[] )
+{
+	int i;
+
+	(void) argv;
+	printf("presets:");
+	for(i=0; i<SYNTH_PRESET_COUNT; i++) if(preset_stored((uint8_t) i)) printf(" %d", i);
+	printf("\r\npresets: generation %lu, %d pages of the half used\r\n", (unsigned long) preset_generation(), preset_pages_used());
+}
+#endif
+
+#if SYNTH_RECORDER
+static void shell_record_command( char *argv[] )
+{
+	(void) argv;
+	if(recorder_record(output_time())) printf("recorder: recording, 'stop' saves the take\r\n");
+	else printf("recorder: busy, or the flash did not erase\r\n");
+}
+
+static void shell_replay_command( char *argv[] )
+{
+	(void) argv;
+	if(recorder_replay_start() == false)
+	{
+		printf("recorder: busy, or no take\r\n");
+		return;
+	}
+	printf("recorder: replaying %lu events\r\n", (unsigned long) recorder_take_events());
+	xTaskNotifyGive( midi_task );
+}
+
+static void shell_stop_command( char *argv[] )
+{
+	//a take's last pages go to the flash from the next job on, the console reports it
+	(void) argv;
+	recorder_stop();
+	xTaskNotifyGive( midi_task );
+}
+#endif
+
+#if SYNTH_SMF_PLAYER
+static void shell_song_command( char *argv[] )
+{
+	int32_t play;
+
+	if(!shell_number(argv[0], 0, 1, &play)) return;
+	if(play) smf_player_start();
+	else smf_player_stop();
+	xTaskNotifyGive( midi_task );
+}
+#endif
+
+#if SYNTH_LATENCY_PROBE
+static void shell_probe_command( char *argv[] )
+{
+	int32_t notes;
+	int32_t send;
+
+	if(!shell_number(argv[0], 0, 1000, &notes)) return;
+	if(!shell_number(argv[1], 0, 1, &send)) return;
+	if(notes == 0)
+	{
+		latency_probe_stop();
+		return;
+	}
+	latency_probe_start((uint16_t) notes, send != 0);
+	printf("probe: %ld notes %s, keep everything else quiet\r\n", (long) notes, send ? "of its own" : "from the inputs");
+}
+
+static void probe_job( void )
+{
+	//console task, the probe's notes go the way of the shell's
+	struct midi_event event;
+
+	if(latency_probe_job(xTaskGetTickCount(), &event)) console_post(event.status, event.channel, event.data1, event.data2);
+}
+#endif
+
+#if SYNTH_POLY_SWEEP
+static void shell_sweep_command( char *argv[] )
+{
+	//at most a step per voice of every waveform, so a second a step is minutes for the whole sweep
+	int32_t seconds;
+
+	if(!shell_number(argv[0], 0, 60, &seconds)) return;
+	if(seconds == 0)
+	{
+		poly_sweep_stop();
+		return;
+	}
+	poly_sweep_start((uint32_t) seconds * 1000 / portTICK_RATE_MS, wave_names);
+	printf("sweep: %ld s a step, up to %d voices of each waveform, keep everything else quiet\r\n", (long) seconds, SYNTH_MAX_VOICES);
+}
+
+static void sweep_job( void )
+{
+	//console task, the sweep's events go the way of the shell's
+	struct midi_event event;
+
+	if(poly_sweep_job(xTaskGetTickCount(), &event)) console_post(event.status, event.channel, event.data1, event.data2);
+}
+#endif
+
+#if SYNTH_POWER_SAVE
+static void shell_power_command( char *argv[] )
+{
+	//the sleep share covers the time since the last ':power', read it twice for a figure
+	int32_t sleep;
+
+	if(!shell_number(argv[0], 0, 1, &sleep)) return;
+	printf("power: idle sleep was %s, asleep %u per mille since last asked\r\n", power_sleep_enabled() ? "on" : "off",
+		(unsigned int) power_sleep_share());
+	power_set_sleep(sleep != 0);
+	printf("power: idle sleep %s\r\n", sleep ? "on, IDLE 0" : "off, the idle task spins");
+}
+#endif
+
+#if SYNTH_VOICE_SNAPSHOT
+static void shell_voices_command( char *argv[] )
+{
+	//the renderer's voice table at its next block boundary; with the renderer stuck, the copy
+	//from the last time it was asked
+	const struct synth_voice_state *v;
+	uint32_t before;
+	uint32_t after;
+	int wait;
+	int voice;
+
+	(void) argv;
+	before = synth_snapshot_read(&voice_snapshot);
+	after = before;
+	synth_snapshot_request();
+	for(wait=0; wait<VOICES_WAIT_MS; wait+=portTICK_RATE_MS)
+	{
+		vTaskDelay(1);
+		after = synth_snapshot_read(&voice_snapshot);
+		if(after != before) break;
+	}
+	if(after == before)
+	{
+		if(after == 0)
+		{
+			printf("voices: no copy from the renderer\r\n");
+			return;
+		}
+		printf("voices: the renderer did not answer, this is the last copy\r\n");
+	}
+
+	printf("voices: %u enabled at render time %lu, playing %lu\r\n", (unsigned int) voice_snapshot.active_count,
+		(unsigned long) voice_snapshot.render_time, (unsigned long) output_time());
+	for(voice=0; voice<SYNTH_MAX_VOICES; voice++)
+	{
+		v = &voice_snapshot.voice[voice];
+		if(!v->enable && (v->env_stage == ENV_IDLE)) continue;
+		printf("voice %d: %s ch %u note %u vel %u gate %s %s env %s %ld gain %ld\r\n", voice, v->enable ? "on" : "OFF",
+			(unsigned int) v->channel + 1, (unsigned int) v->note, (unsigned int) v->velocity, v->gate ? "held" : "up",
+			(v->type < WAVE_TYPE_COUNT) ? wave_names[v->type] : "?",
+			(v->env_stage <= ENV_RELEASE) ? env_stage_names[v->env_stage] : "?", (long) v->env_level, (long) v->gain);
+		printf("\tinc %lu glide %ld mod pitch %ld amp %u pressure %d swap %u\r\n", (unsigned long) v->inc, (long) v->glide,
+			(long) v->mod_pitch, (unsigned int) v->mod_amp, (int) v->pressure, (unsigned int) v->swap_fade);
+	}
+}
+#endif
+
+#if SYNTH_AUDIO_TAP
+static void shell_tap_command( char *argv[] )
+{
+	int32_t decimation;
+
+	if(!shell_number(argv[0], 1, 1000, &decimation)) return;
+	audio_tap_arm((uint16_t) decimation);
+	printf("tap: every %ld block(s), %d blocks of %d, 'a' dumps\r\n", (long) decimation, SYNTH_AUDIO_TAP_BLOCKS, SYNTH_BLOCK_SIZE);
+}
+#endif
+
+//line commands, entered after a ':' on the console
+static const struct shell_command shell_commands[] = {
+	{ "help", "", 0, shell_help_command },
+	{ "stats", "", 0, shell_stats_command },
+	{ "frames", "<frames in flight>", 1, shell_frames_command },
+	{ "rate", "<Hz>", 1, shell_rate_command },
+	{ "poly", "<voices>", 1, shell_poly_command },
+	{ "quality", "<channel> <0 truncate, 1 band-limited, 2 interpolated, 3 oversampled>", 2, shell_quality_command },
+	{ "gain", "<master gain, 256 = unity>", 1, shell_gain_command },
+	{ "cc", "<channel> <controller> <value>", 3, shell_cc_command },
+	{ "program", "<channel> <program>", 2, shell_program_command },
+	{ "pattern", "<pattern, 0 stops>", 1, shell_pattern_command },
+	{ "automation", "<0 off, 1 plays, 2 records a loop>", 1, shell_automation_command },
+#if SYNTH_TUNING
+	{ "tune", "<note> <cents from equal temperament>", 2, shell_tune_command },
+	{ "tuneoctave", "<pitch class, 0 = C> <cents -64..63>", 2, shell_tuneoctave_command },
+	{ "untune", "", 0, shell_untune_command },
+#endif
+	{ "params", "", 0, shell_params_command },
+	{ "learn", "<channel> <param>", 2, shell_learn_command },
+	{ "ccmap", "<channel> <controller> <param, none unmaps> <low> <high>", 5, shell_ccmap_command },
+	{ "ccmaps", "<channel>", 1, shell_ccmaps_command },
+#if SYNTH_PRESETS
+	{ "save", "<program> <channel to take the patch from>", 2, shell_save_command },
+	{ "forget", "<program>", 1, shell_forget_command },
+	{ "presets", "", 0, shell_presets_command },
+#endif
+#if SYNTH_RECORDER
+	{ "record", "", 0, shell_record_command },
+	{ "replay", "", 0, shell_replay_command },
+	{ "stop", "", 0, shell_stop_command },
+#endif
+#if SYNTH_SMF_PLAYER
+	{ "song", "<1 plays from the start, 0 stops>", 1, shell_song_command },
+#endif
+#if SYNTH_LATENCY_PROBE
+	{ "probe", "<notes, 0 stops> <1 sends them, 0 waits for them on the inputs>", 2, shell_probe_command },
+#endif
+#if SYNTH_POLY_SWEEP
+	{ "sweep", "<seconds a step, 0 stops>", 1, shell_sweep_command },
+#endif
+#if SYNTH_AUDIO_TAP
+	{ "tap", "<capture every n-th block, 1 = gapless>", 1, shell_tap_command },
+#endif
+#if SYNTH_POWER_SAVE
+	{ "power", "<0 idle task spins, 1 sleeps>", 1, shell_power_command },
+#endif
+#if SYNTH_VOICE_SNAPSHOT
+	{ "voices", "", 0, shell_voices_command },
+#endif
+};
+
+void console_command( char c )
+{
+	//single-key commands on the EDBG port, run from the trace log task; each reply gets the
+	//whole transmit ring. Lines after a ':' go to the shell
+	if(shell_input(c)) return;
+	debug_uart_flush();
+
+	switch(c)
+	{
+		case 's':
+			print_audio_stats();
+			break;
+		case 'r':
+			audio_stats_reset_peak();
+			printf("audio: peak reset\r\n");
+			break;
+		case 'p':
+			//per-task share of the run time counter since the scheduler started, the timer daemon
+			//and so the stats sampling as "Tmr Svc"
+			vTaskGetRunTimeStats(task_stats_buffer);
+			printf("task\t\tcount\t\tshare\r\n%s", (char *) task_stats_buffer);
+			break;
+		case 'h':
+			print_stack_usage();
+			break;
+		case 'x':
+			print_switch_cost();
+			break;
+		case 'l':
+			print_latency();
+			break;
+		case '[':
+			output_set_frames(output_frames_active() - 1);
+			print_latency();
+			break;
+		case ']':
+			output_set_frames(output_frames_active() + 1);
+			print_latency();
+			break;
+		case 'm':
+			print_midi_stats();
+			break;
+		case 'q':
+			print_fill_levels();
+			break;
+#if SYNTH_TELEMETRY
+		case 'b':
+			//binary, for tools/telemetry.py
+			telemetry_set_enabled(!telemetry_enabled());
+			break;
+#endif
+		case 'f':
+			next_sample_rate();
+			break;
+		case 't':
+			vTaskList(task_stats_buffer);
+			printf("task\t\tstate\tprio\tstack\tnum\r\n%s", (char *) task_stats_buffer);
+			break;
+#if SYNTH_KERNEL_TRACE
+		case 'k':
+			//binary, for tools/kernel_trace.py
+			kernel_trace_dump();
+			break;
+#endif
+#if SYNTH_AUDIO_TAP
+		case 'a':
+			//binary, for tools/audio_tap.py
+			audio_tap_dump();
+			break;
+#endif
+		default:
+			break;
+	}
+}
+
+
+
+uint32_t output_time( void )
+{
+	//engine render time of the sample being played right now
+#if SYNTH_OUTPUT_DMA
+	irqflags_t flags;
+	uint32_t time;
+	uint32_t offset;
+
+	flags = cpu_irq_save();
+	time = output_frame_time;
+	offset = (cycle_counter_read() - output_frame_cycles) / cycles_per_sample;
+	cpu_irq_restore(flags);
+
+	if(offset >= SYNTH_BLOCK_SIZE) offset = SYNTH_BLOCK_SIZE - 1;
+
+	return time + offset;
+#else
+	return output_samples;
+#endif
+}
+
+int output_frames_active( void )
+{
+#if SYNTH_OUTPUT_DMA
+	return dac_dma_frames();
+#else
+	return output_active;
+#endif
+}
+
+void output_set_frames( int count )
+{
+	//frames in flight, which is the output latency in blocks
+	if(count < 3) count = 3;
+	if(count > SYNTH_OUTPUT_FRAMES) count = SYNTH_OUTPUT_FRAMES;
+
+#if SYNTH_OUTPUT_DMA
+	int frame;
+
+	//frames coming back into the ring hold whatever they had when they left, conceal them
+	//until the renderer has been round
+	for(frame=dac_dma_frames(); frame<count; frame++) frame_ready[frame] = false;
+
+	dac_dma_set_frames(count);
+#else
+	output_active = count;
+#endif
+}
+
+void output_set_sample_rate( uint32_t rate )
+{
+	//the engine retunes at its next block, the clock changes now; the frames already in
+	//flight play at the new rate
+	synth_set_sample_rate(rate);
+	rate = synth_sample_rate();
+
+	cycles_per_sample = SYSTEM_CLK_FREQ / rate;
+#if SYNTH_OUTPUT_DMA
+	audio_output->set_rate(rate);
+#else
+	sample_clock_set_rate(rate);
+#endif
+	audio_stats_set_rate(system_cpu_clock_get_hz(), rate);
+}
+
+
+
+/******  CONFIG FUNCTIONS  ******/
+//clock config functions
+void dfll_setup( void )
+{
+	#if (!SAMC21)
+#if SYNTH_DFLL_CLOSED_LOOP && !SYNTH_FAST_BOOT
+	uint32_t wait;
+
+	/* Lock the DFLL to the 32kHz crystal, open loop if either never comes up */
+	for(wait=0; (wait < SYNTH_CLOCK_READY_WAIT) && !system_clock_source_is_ready(SYSTEM_CLOCK_SOURCE_XOSC32K); wait++);
+	if(wait < SYNTH_CLOCK_READY_WAIT)
+	{
+		configure_dfll_closed_loop();
+		system_clock_source_enable(SYSTEM_CLOCK_SOURCE_DFLL);
+		for(wait=0; (wait < SYNTH_CLOCK_READY_WAIT) && !system_clock_source_is_ready(SYSTEM_CLOCK_SOURCE_DFLL); wait++);
+		dfll_locked = (wait < SYNTH_CLOCK_READY_WAIT);
+	}
+	if(!dfll_locked) system_clock_source_disable(SYSTEM_CLOCK_SOURCE_DFLL);
+#endif
+
+	if(!dfll_locked)
+	{
+		/* Configure the DFLL in open loop mode using default values */
+		configure_dfll_open_loop();
+		/* Enable the DFLL oscillator */
+		enum status_code dfll_status =
+		system_clock_source_enable(SYSTEM_CLOCK_SOURCE_DFLL);
+		if (dfll_status != STATUS_OK) {
+			/* Error enabling the clock source */
+		}
+	}
+	/* Configure flash wait states before switching to high frequency clock */
+	flash_setup();
+	/* Change system clock to DFLL */
+	struct  system_gclk_gen_config config_gclock_gen;
+	system_gclk_gen_get_config_defaults(&config_gclock_gen);
+	config_gclock_gen.source_clock = SYSTEM_CLOCK_SOURCE_DFLL;
+	config_gclock_gen.division_factor = 1;
+	system_gclk_gen_set_config(GCLK_GENERATOR_0, &config_gclock_gen);
+	boot_time_mark();
+#if SYNTH_CLOCK_SCALING
+	clock_scale_init();
+#endif
+	#endif
+}
+
+#if SYNTH_FAST_BOOT
+static void dfll_lock_job( void )
+{
+	//trace log job: closes the DFLL loop once the crystal runs. The DFLL stays enabled and
+	//starts locking from the open loop value it already runs at, so generator 0 and the
+	//peripherals on generator 4 keep their clock throughout
+	static bool locking = false;
+	const uint32_t lock = SYSCTRL_PCLKSR_DFLLLCKC | SYSCTRL_PCLKSR_DFLLLCKF;
+
+	if(dfll_locked) return;
+
+	if(!locking)
+	{
+		if(!system_clock_source_is_ready(SYSTEM_CLOCK_SOURCE_XOSC32K)) return;
+
+		//the ASF's idea of the DFLL rate is off between the two calls, clock scaling must not
+		//read it then
+		taskENTER_CRITICAL();
+		configure_dfll_closed_loop();
+		system_clock_source_enable(SYSTEM_CLOCK_SOURCE_DFLL);
+		taskEXIT_CRITICAL();
+		locking = true;
+		return;
+	}
+
+	if((SYSCTRL->PCLKSR.reg & lock) != lock) return;
+
+	dfll_locked = true;
+	printf("clock: DFLL locked to XOSC32K at tick %lu\r\n", (unsigned long) xTaskGetTickCount());
+#if SYNTH_USB_MIDI
+	usb_midi_init(&usb_rx_ring, output_time, midi_input_wake);
+	printf("usb: MIDI on\r\n");
+#endif
+}
+#endif
+
+static void boot_time_mark( void )
+{
+	//after a CPU clock change, the cycles up to here still count at the old rate
+	uint32_t now = cycle_counter_read();
+
+	if(boot_mhz != 0) boot_us += (now - boot_cycles) / boot_mhz;
+	boot_cycles = now;
+	boot_mhz = (system_cpu_clock_get_hz() + 500000) / 1000000;
+}
+
+static void boot_time_report( void )
+{
+	//output interrupt, the first rendered block goes out, the pipeline is primed and LED0 says
+	//so; clock scaling only starts after many more, so the rate is still the last one marked
+	boot_reported = true;
+	port_pin_set_output_level(LED_0_PIN, LED_0_ACTIVE);
+	trace_log("boot: ready, first block out %lu us after system_init()\r\n", boot_us + (cycle_counter_read() - boot_cycles) / boot_mhz);
+}
+
+static bool output_prime( void )
+{
+	//start-up, between the output's init and start: from the 0 V the DAC sat at while off up
+	//to mid-scale, the first code of the silent frames; false as soon as the DAC does not take
+	//a write
+	uint32_t step_cycles = system_cpu_clock_get_hz() / 1000 * SYNTH_OUTPUT_RAMP_MS / OUTPUT_RAMP_STEPS;
+	uint32_t start;
+	int i;
+
+	if(audio_output->prime == NULL) return true;
+
+	for(i=(SYNTH_OUTPUT_RAMP_MS ? 1 : OUTPUT_RAMP_STEPS); i<=OUTPUT_RAMP_STEPS; i++)
+	{
+		if(!audio_output->prime((uint16_t) (DAC_MIDSCALE * i / OUTPUT_RAMP_STEPS))) return false;
+
+		start = cycle_counter_read();
+		while(cycle_counter_read() - start < step_cycles);
+	}
+
+	return true;
+}
+
+void flash_setup( void )
+{
+	//wait states, read mode and cache in one write, the manual write bit set at startup stays
+	uint32_t ctrlb = NVMCTRL->CTRLB.reg;
+
+	ctrlb &= ~(NVMCTRL_CTRLB_RWS_Msk | NVMCTRL_CTRLB_READMODE_Msk | NVMCTRL_CTRLB_CACHEDIS);
+	ctrlb |= NVMCTRL_CTRLB_RWS(SYNTH_FLASH_WAIT_STATES) | NVMCTRL_CTRLB_READMODE(SYNTH_FLASH_READMODE);
+	if(!SYNTH_FLASH_CACHE) ctrlb |= NVMCTRL_CTRLB_CACHEDIS;
+	NVMCTRL->CTRLB.reg = ctrlb;
+}
+
+void extosc32k_setup( void )
+{
+	/* Configure the external 32KHz oscillator */
+	configure_extosc32k();
+	/* Enable the external 32KHz oscillator */
+		enum status_code osc32k_status =
+	system_clock_source_enable(SYSTEM_CLOCK_SOURCE_XOSC32K);
+	if (osc32k_status != STATUS_OK) {
+		/* Error enabling the clock source */
+	}
+}
+
+void configure_extosc32k( void )
+{
+	//starts the 32kHz external reference clock
+	struct  system_clock_source_xosc32k_config config_ext32k;
+	system_clock_source_xosc32k_get_config_defaults(&config_ext32k);
+	config_ext32k.startup_time = SYSTEM_XOSC32K_STARTUP_4096;
+	system_clock_source_xosc32k_set_config(&config_ext32k);
+}
+
+#if (!SAMC21)
+void configure_dfll_open_loop( void )
+{
+	//configures 48MHz DFLL
+	struct  system_clock_source_dfll_config config_dfll;
+	system_clock_source_dfll_get_config_defaults(&config_dfll);
+	config_dfll.coarse_value = dfll_coarse_calibration();
+	system_clock_source_dfll_set_config(&config_dfll);
+}
+
+void configure_dfll_closed_loop( void )
+{
+	//48MHz DFLL tracking XOSC32K through generator 1, starting from the factory coarse value
+	struct  system_gclk_gen_config gclock_gen_conf;
+	struct  system_gclk_chan_config gclk_chan_conf;
+	struct  system_clock_source_dfll_config config_dfll;
+
+	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
+	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_XOSC32K;
+	gclock_gen_conf.division_factor = 1;
+	system_gclk_gen_set_config(GCLK_GENERATOR_1, &gclock_gen_conf);
+	system_gclk_gen_enable(GCLK_GENERATOR_1);
+
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_1;
+	system_gclk_chan_set_config(SYSCTRL_GCLK_ID_DFLL48, &gclk_chan_conf);
+	system_gclk_chan_enable(SYSCTRL_GCLK_ID_DFLL48);
+
+	system_clock_source_dfll_get_config_defaults(&config_dfll);
+	config_dfll.loop_mode = SYSTEM_CLOCK_DFLL_LOOP_MODE_CLOSED;
+	config_dfll.on_demand = false;
+	config_dfll.coarse_value = dfll_coarse_calibration();
+	config_dfll.coarse_max_step = 0x1f / 4;
+	config_dfll.fine_max_step = 0xff / 4;
+	config_dfll.multiply_factor = SYNTH_DFLL_MULTIPLY;
+	system_clock_source_dfll_set_config(&config_dfll);
+}
+
+static uint8_t dfll_coarse_calibration( void )
+{
+	//DFLL48M coarse value from the NVM software calibration area, bits 58..63; some
+	//revisions leave it unprogrammed at 0x3f
+	uint32_t coarse = (*((uint32_t *) NVMCTRL_OTP4 + 1) >> (58 - 32)) & 0x3f;
+
+	return (coarse == 0x3f) ? 0x1f : (uint8_t) coarse;
+}
+#endif
+
+void configure_gclock_generator( void )
+{
+	//configures slow clock generator for serial devices
+	struct  system_gclk_gen_config gclock_gen_conf;
+	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
+	#if (SAML21) || (SAML22)
+	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_OSC16M;
+	gclock_gen_conf.division_factor = 1;
+	#elif (SAMC21)
+	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_OSC48M;
+	gclock_gen_conf.division_factor = 1;
+	#else
+	gclock_gen_conf.source_clock = SYSTEM_CLOCK_SOURCE_OSC8M;
+	gclock_gen_conf.division_factor = 1;
+	#endif
+	system_gclk_gen_set_config(GCLK_GENERATOR_2, &gclock_gen_conf);
+	system_gclk_gen_enable(GCLK_GENERATOR_2);
+}
+
+void configure_gclock_channel( void )
+{
+	//configures slow clock channel
+	struct  system_gclk_chan_config gclk_chan_conf;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
+	#if (SAMD10) || (SAMD11)
+	system_gclk_chan_set_config(TC1_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(TC1_GCLK_ID);
+	#else
+	system_gclk_chan_set_config(TC3_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(TC3_GCLK_ID);
+	#endif
+}
+
+static uint32_t midi_select_baud( void )
+{
+	//line rate of the MIDI input chosen by SYNTH_MIDI_INPUT
+#if SYNTH_MIDI_INPUT == SYNTH_MIDI_BOOT_SELECT
+	struct port_config pin_conf;
+	bool held = false;
+	int i;
+
+	//input with pull-up, a few reads give the pull-up time to charge the pin
+	port_get_config_defaults(&pin_conf);
+	port_pin_set_config(SW0_PIN, &pin_conf);
+	for(i=0; i<100; i++) held = (port_pin_get_input_level(SW0_PIN) == SW0_ACTIVE);
+
+	return held ? SYNTH_MIDI_BRIDGE_BAUD : SYNTH_MIDI_DIN_BAUD;
+#elif SYNTH_MIDI_INPUT == SYNTH_MIDI_DIN
+	return SYNTH_MIDI_DIN_BAUD;
+#else
+	return SYNTH_MIDI_BRIDGE_BAUD;
+#endif
+}
+
+void configure_usart(void)
+{
+	//configures UART for MIDI communication
+	struct usart_config config_usart;
+	midi_baud = midi_select_baud();
+	usart_get_config_defaults(&config_usart);
+	config_usart.baudrate = midi_baud;
+	config_usart.mux_setting = USART_RX_1_TX_0_XCK_1;
+	config_usart.pinmux_pad0 = PINMUX_PA16C_SERCOM1_PAD0;
+	config_usart.pinmux_pad1 = PINMUX_PA17C_SERCOM1_PAD1;
+	config_usart.pinmux_pad2 = PINMUX_UNUSED;
+	config_usart.pinmux_pad3 = PINMUX_UNUSED;
+	config_usart.start_frame_detection_enable = true;
+	config_usart.generator_source = GCLK_GENERATOR_2;
+	while (usart_init(&usart_instance, SERCOM1
+	, &config_usart) != STATUS_OK) {
+	}
+
+	//the opto-isolator only pulls the line low, the internal pull-up holds it at idle when
+	//nothing is plugged in; the opto's own pull-up still sets the edge speed
+	if(midi_baud == SYNTH_MIDI_DIN_BAUD)
+	{
+		port_pin_set_output_level(PIN_PA17, true);
+		PORT->Group[0].PINCFG[17].reg |= PORT_PINCFG_PULLEN;
+	}
+	usart_enable(&usart_instance);
+}
+
+void configure_usart_callbacks(void)
+{
+	//registers RX complete and error callbacks, each received byte goes to the MIDI ring
+	midi_ring_init(&midi_rx_ring);
+#if !SYNTH_MIDI_RX_DMA
+	midi_framer_init(&midi_rx_framer);
+#endif
+
+#if SYNTH_MIDI_RX_DMA
+	midi_rx_dma_init(&usart_instance, midi_rx_start_callback);
+#elif SYNTH_MIDI_RX_FAST_ISR
+	//usart_enable() has the NVIC line on already, the RAM table takes over its vector
+	ram_vectors_set(SERCOM1_IRQn, midi_rx_fast_handler);
+	SERCOM1->USART.INTENSET.reg = SERCOM_USART_INTFLAG_RXC;
+#else
+	usart_register_callback(&usart_instance,
+	usart_read_callback, USART_CALLBACK_BUFFER_RECEIVED);
+	usart_enable_callback(&usart_instance, USART_CALLBACK_BUFFER_RECEIVED);
+	usart_register_callback(&usart_instance,
+	usart_read_error_callback, USART_CALLBACK_ERROR);
+	usart_enable_callback(&usart_instance, USART_CALLBACK_ERROR);
+
+	usart_read_job(&usart_instance, &midi_rx_byte);
+#endif
+}
+
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+static void configure_voice_link( void )
+{
+	//voice link to the cards on the EXT2 UART's TX pin, PB12, their reports back on its RX
+	//pin, PB13, which the pull-up holds at idle while no card answers
+	struct usart_config config_usart;
+	struct system_pinmux_config config_mux;
+
+	usart_get_config_defaults(&config_usart);
+	config_usart.baudrate = SYNTH_VOICE_LINK_BAUD;
+	config_usart.mux_setting = USART_RX_1_TX_0_XCK_1;
+	config_usart.pinmux_pad0 = PINMUX_PB12C_SERCOM4_PAD0;
+	config_usart.pinmux_pad1 = PINMUX_UNUSED;
+	config_usart.pinmux_pad2 = PINMUX_UNUSED;
+	config_usart.pinmux_pad3 = PINMUX_UNUSED;
+	config_usart.generator_source = GCLK_GENERATOR_2;
+	while (usart_init(&usart_instance_link, SERCOM4, &config_usart) != STATUS_OK) {
+	}
+
+	system_pinmux_get_config_defaults(&config_mux);
+	config_mux.mux_position = PINMUX_PB13C_SERCOM4_PAD1 & 0xFFFF;
+	config_mux.input_pull = SYSTEM_PINMUX_PIN_PULL_UP;
+	system_pinmux_pin_set_config(PINMUX_PB13C_SERCOM4_PAD1 >> 16, &config_mux);
+
+	voice_link_parser_init(&link_report_parser);
+	usart_register_callback(&usart_instance_link, link_report_callback, USART_CALLBACK_BUFFER_RECEIVED);
+	usart_enable_callback(&usart_instance_link, USART_CALLBACK_BUFFER_RECEIVED);
+	usart_register_callback(&usart_instance_link, link_report_callback, USART_CALLBACK_ERROR);
+	usart_enable_callback(&usart_instance_link, USART_CALLBACK_ERROR);
+	usart_enable(&usart_instance_link);
+
+	usart_read_job(&usart_instance_link, &link_report_byte);
+}
+
+static void link_report_callback( struct usart_module *const usart_module )
+{
+	//a byte of a card's report, or a line error, which starts the packet over
+	if(usart_module->rx_status == STATUS_OK) voice_link_report_feed(&link_report_parser, (uint8_t) link_report_byte);
+	else voice_link_parser_init(&link_report_parser);
+	usart_read_job(usart_module, &link_report_byte);
+}
+#elif (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+static void link_answer( void )
+{
+	//MIDI task, the master polled this card: the load and voices its telemetry sends, and the
+	//packet stays put while the interrupt sends it
+	static uint8_t packet[VOICE_LINK_PACKET_LEN];
+	struct audio_stats stats;
+
+	audio_stats_get(&stats);
+	voice_link_report(packet, audio_stats_load(stats.avg_cycles), synth_voice_count());
+	midi_uart_write(&link_rx_port, packet, VOICE_LINK_PACKET_LEN);
+}
+#endif
+
+static void configure_interrupt_priorities( void )
+{
+	//the drivers leave every interrupt at level 0, enabling one does not change its level
+	int i;
+
+	for(i=0; i<(int) (sizeof(irq_plan) / sizeof(irq_plan[0])); i++) system_interrupt_set_priority(irq_plan[i].vector, irq_plan[i].level);
+
+	//the port does the same when the scheduler starts; not through the ASF call, whose SysTick
+	//write puts PendSV, in the same register, at level 0
+	SCB->SHP[1] |= KERNEL_IRQ_PRIORITIES;
+}
+
+static void check_priorities( void )
+{
+	//just before the scheduler starts, with every driver and task set up: reports what is off
+	//the plan instead of fixing it, so a driver that set its own level shows up
+	bool ok = true;
+	int i;
+
+	for(i=0; i<(int) (sizeof(irq_plan) / sizeof(irq_plan[0])); i++)
+	{
+		if(system_interrupt_get_priority(irq_plan[i].vector) == irq_plan[i].level) continue;
+		printf("priorities: %s at level %u, planned %u\r\n", irq_plan[i].name, (unsigned int) system_interrupt_get_priority(irq_plan[i].vector),
+			(unsigned int) irq_plan[i].level);
+		ok = false;
+	}
+
+	//only the top two bits of each level byte are implemented, SysTick's at 31:30, PendSV's at 23:22
+	if((((SCB->SHP[1] >> 30) & 3) != SYSTEM_INTERRUPT_PRIORITY_LEVEL_3) || (((SCB->SHP[1] >> 22) & 3) != SYSTEM_INTERRUPT_PRIORITY_LEVEL_3))
+	{
+		printf("priorities: SysTick or PendSV above the lowest level\r\n");
+		ok = false;
+	}
+
+	if((uxTaskPriorityGet(synth_task) <= uxTaskPriorityGet(midi_task)) || (uxTaskPriorityGet(midi_task) <= configTIMER_TASK_PRIORITY) || (configTIMER_TASK_PRIORITY <= uxTaskPriorityGet(trace_task)))
+	{
+		printf("priorities: tasks out of order, render %u, MIDI %u, log %u\r\n", (unsigned int) uxTaskPriorityGet(synth_task),
+			(unsigned int) uxTaskPriorityGet(midi_task), (unsigned int) uxTaskPriorityGet(trace_task));
+		ok = false;
+	}
+
+	if(ok) printf("priorities: render %d, MIDI %d, timers %d, log %d; output irq %d, input %d, console %d\r\n", SYNTH_TASK_PRIORITY,
+		MIDI_TASK_PRIORITY, configTIMER_TASK_PRIORITY, TRACE_TASK_PRIORITY, SYNTH_IRQ_LEVEL_OUTPUT, SYNTH_IRQ_LEVEL_INPUT, SYNTH_IRQ_LEVEL_CONSOLE);
+}
+
+void configure_usart_EDBG(void)
+{
+	//Debug UART config
+	struct usart_config config_usart;
+	usart_get_config_defaults(&config_usart);
+	config_usart.baudrate = USART_BAUD_RATE;
+	config_usart.mux_setting = EDBG_CDC_SERCOM_MUX_SETTING;
+	config_usart.pinmux_pad0 = EDBG_CDC_SERCOM_PINMUX_PAD0;
+	config_usart.pinmux_pad1 = EDBG_CDC_SERCOM_PINMUX_PAD1;
+	config_usart.pinmux_pad2 = EDBG_CDC_SERCOM_PINMUX_PAD2;
+	config_usart.pinmux_pad3 = EDBG_CDC_SERCOM_PINMUX_PAD3;
+	config_usart.generator_source = GCLK_GENERATOR_2;
+	
+	stdio_serial_init(&usart_instance_EDBG, EDBG_CDC_MODULE, &config_usart);
+
+	usart_enable(&usart_instance_EDBG);
+}
+
+/*****  INTERRUPT HANDLERS  *****/
+#if SYNTH_USB_MIDI || SYNTH_MIDI_UART_INPUTS || (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+static void midi_input_wake( void )
+{
+	//from the USB interrupt after each packet, or a DIN port's after each byte; the ring keeps
+	//anything that arrives before the task exists
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if(midi_task != NULL) vTaskNotifyGiveFromISR( midi_task, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+#endif
+
+#if SYNTH_MIDI_RX_DMA
+void midi_rx_start_callback(struct usart_module *const usart_module)
+{
+	//start bit of the first byte of a burst, wakes the interpreter to poll the DMA buffer
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	TRACE_PIN_HIGH(SYNTH_TRACE_PIN_MIDI_ISR);
+	if(midi_task != NULL) vTaskNotifyGiveFromISR( midi_task, &xHigherPriorityTaskWoken );
+	TRACE_PIN_LOW(SYNTH_TRACE_PIN_MIDI_ISR);
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+#else
+SYNTH_RAM_CODE static void midi_rx_store( uint8_t byte, portBASE_TYPE *woken )
+{
+	//stores the received byte with its arrival time straight into the MIDI ring and wakes the
+	//interpreter once a message is complete; a realtime byte also goes to the engine from
+	//here, at the same output latency midi_post() adds, so MIDI clock is timed without the
+	//task's wake-up. The bytes keep their own times, so waking later per message does not
+	//move any event. With SYNTH_FAST_NOTE_ON a Note On goes to the engine from here too, for
+	//its next control tick
+	uint32_t time = output_time();
+	bool end;
+#if SYNTH_FAST_NOTE_ON
+	struct midi_event note;
+#endif
+
+	if(byte >= MIDI_CLOCK) synth_post_realtime(byte, time + (uint32_t) output_frames_active() * SYNTH_BLOCK_SIZE);
+	midi_ring_push(&midi_rx_ring, byte, time);
+
+	end = midi_framer_feed(&midi_rx_framer, byte);
+#if SYNTH_FAST_NOTE_ON
+	if(end && midi_framer_note_on(&midi_rx_framer, byte, &note)) synth_post_note_now(&note);
+#endif
+	if(end || (midi_ring_count(&midi_rx_ring) >= MIDI_RX_WAKE_LEVEL))
+	{
+		if(midi_task != NULL) vTaskNotifyGiveFromISR( midi_task, woken );
+	}
+}
+
+#if SYNTH_MIDI_RX_FAST_ISR
+SYNTH_RAM_CODE static void midi_rx_fast_handler( void )
+{
+	//SERCOM1's vector: both bytes of the receive FIFO go to the ring from here. A framing or
+	//parity error drops its byte, any error restarts the framer as the ASF path does. Only
+	//transmit jobs (MIDI out, the flood) go on to ASF's handler, which turns the RX interrupt
+	//off if it finds one it has no read job for, so it is turned back on after
+	SercomUsart *const hw = &SERCOM1->USART;
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+	uint16_t status;
+	uint8_t byte;
+
+	TRACE_PIN_HIGH(SYNTH_TRACE_PIN_MIDI_ISR);
+	while(hw->INTFLAG.reg & SERCOM_USART_INTFLAG_RXC)
 	{
-		xSemaphoreTake( UARTsem, portMAX_DELAY );
-		
-		//reads out everything in USART buffer, and stores to messageQueue
-		while(usart_read_wait(&usart_instance, &temp) == STATUS_OK)
+		status = hw->STATUS.reg & (SERCOM_USART_STATUS_FERR | SERCOM_USART_STATUS_BUFOVF | SERCOM_USART_STATUS_PERR);
+		byte = (uint8_t) hw->DATA.reg;
+		if(status)
 		{
-			temp8 = (uint8_t) temp;	
-			xQueueSendToBack(messageQueue, &temp8, 0);
+			hw->STATUS.reg = status;
+			midi_uart_status_errors(&midi_rx_ring, status);
+			midi_framer_init(&midi_rx_framer);
+			if(status & (SERCOM_USART_STATUS_FERR | SERCOM_USART_STATUS_PERR)) continue;
 		}
-		
-		taskYIELD();
+		midi_rx_store(byte, &xHigherPriorityTaskWoken);
+	}
+
+	if(hw->INTFLAG.reg & hw->INTENSET.reg & (SERCOM_USART_INTFLAG_DRE | SERCOM_USART_INTFLAG_TXC))
+	{
+		SERCOM1_Handler();
+		hw->INTENSET.reg = SERCOM_USART_INTFLAG_RXC;
 	}
+	TRACE_PIN_LOW(SYNTH_TRACE_PIN_MIDI_ISR);
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+#else
+void usart_read_callback(struct usart_module *const usart_module)
+{
+	//takes the byte and re-arms the next read before storing it
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+	uint8_t byte = (uint8_t) midi_rx_byte;
+
+	TRACE_PIN_HIGH(SYNTH_TRACE_PIN_MIDI_ISR);
+	usart_read_job(usart_module, &midi_rx_byte);
+	midi_rx_store(byte, &xHigherPriorityTaskWoken);
+	TRACE_PIN_LOW(SYNTH_TRACE_PIN_MIDI_ISR);
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
 
-static void vPeriodicSPITask( void *pvParameters )
+void usart_read_error_callback(struct usart_module *const usart_module)
 {
-	//gets current tick count
-	portTickType xLastWakeTime = xTaskGetTickCount();
-	portBASE_TYPE xStatus;
-	uint16_t sample_to_send;
+	//a framing, overflow or parity error ends the read job, start the next one; the framer
+	//starts over here, the parser once it reaches this point in the ring
+	midi_ring_error(&midi_rx_ring, midi_uart_line_error(usart_module));
+	midi_framer_init(&midi_rx_framer);
+	trace_log("MIDI RX error\r\n", 0);
+	usart_read_job(usart_module, &midi_rx_byte);
+}
+#endif
+#endif
 
-	while(1)
+void vApplicationStackOverflowHook( xTaskHandle xTask, signed char *pcTaskName )
+{
+	//called by the kernel on a context switch away from a task that ran past its stack;
+	//the name lives in the TCB, so the deferred printf can still reach it
+	trace_log("stack overflow in task %s\r\n", (uint32_t) pcTaskName);
+}
+
+void vApplicationIdleHook( void )
+{
+	//sleeps until the next interrupt whenever nothing is ready, the tickless path takes over
+	//for the longer idles
+#if SYNTH_POWER_SAVE
+	power_idle();
+#endif
+}
+
+void dac_frame_played_callback(uint16_t *played_frame, uint16_t *next_frame)
+{
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+#if SYNTH_OUTPUT_DMA
+	int played = (played_frame - sample_frames[0]) / SYNTH_FRAME_WORDS;
+	int next = (next_frame - sample_frames[0]) / SYNTH_FRAME_WORDS;
+
+	//the DMA has already moved on to the next frame; if the renderer did not make it in time,
+	//count it and replace the stale samples before the first one goes out, otherwise the
+	//watchdog is told the audio is alive
+	frame_ready[played] = false;
+	if(frame_ready[next] == false)
+	{
+		audio_stats_underrun();
+		audio_output->conceal(next_frame, played_frame);
+		frame_time[next] = frame_time[played] + SYNTH_BLOCK_SIZE;
+	}
+#if SYNTH_WATCHDOG
+	else audio_watchdog_kick();
+#endif
+	if(!boot_reported && frame_ready[next] && ((int32_t) frame_time[next] >= 0)) boot_time_report();
+
+	//time base for the MIDI timestamps
+	output_frame_cycles = cycle_counter_read();
+	output_frame_time = frame_time[next];
+
+	//returns the frame the DMA just finished to the renderer
+	played_slot[played_head] = (uint8_t) played;
+	played_head = (played_head + 1) % (SYNTH_OUTPUT_FRAMES + 1);
+	vTaskNotifyGiveFromISR( synth_task, &xHigherPriorityTaskWoken );
+#else
+	//returns the frame the sample clock just finished to the renderer
+	xQueueSendToBackFromISR( freeFrameQueue, &played_frame, &xHigherPriorityTaskWoken );
+#endif
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+#if !SYNTH_OUTPUT_DMA
+SYNTH_RAM_CODE void dac_sample_tick( void )
+{
+	//called by the sample clock once per sample when the DAC is written by the CPU
+	static uint16_t *frame_to_send = NULL;
+#if (SYNTH_UNDERRUN_POLICY == SYNTH_UNDERRUN_REPEAT)
+	static uint16_t *last_frame = NULL;
+#endif
+	static int frame_index = 0;
+	static uint16_t last_sample = DAC_MIDSCALE;
+	static bool starved = true; //nothing rendered before start-up is not an underrun
+	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	//pull next frame from queue once the current one has been played out
+	if(frame_to_send == NULL)
 	{
-		//pull sample from queue
-		xStatus = xQueueReceive( sampleQueue, &sample_to_send, 0 );
+		if(xQueueReceiveFromISR( sampleQueue, &frame_to_send, &xHigherPriorityTaskWoken ) != pdTRUE) frame_to_send = NULL;
+
+		//one underrun per gap, not per missed sample
+		if(frame_to_send == NULL && starved == false) audio_stats_underrun();
+#if SYNTH_WATCHDOG
+		if(frame_to_send != NULL) audio_watchdog_kick();
+#endif
+		if(frame_to_send != NULL && !boot_reported) boot_time_report();
+		if(frame_to_send != NULL || starved == false) frame_index = 0;
+		starved = (frame_to_send == NULL);
+	}
 
-		//send sample to DAC
-		if (xStatus == pdTRUE) write_to_MCP4821( sample_to_send );
+	if(frame_to_send != NULL)
+	{
+		last_sample = frame_to_send[frame_index];
+		output_samples++;
 
-		//delays for 1/(20kHz)
-		vTaskDelayUntil( &xLastWakeTime, 50/portTICK_RATE_uS );
+		if(++frame_index >= SYNTH_BLOCK_SIZE)
+		{
+			//played out, back to the pool
+#if (SYNTH_UNDERRUN_POLICY == SYNTH_UNDERRUN_REPEAT)
+			//the last frame stays out of the pool while it may be repeated
+			if(last_frame != NULL) xQueueSendToBackFromISR( freeFrameQueue, &last_frame, &xHigherPriorityTaskWoken );
+			last_frame = frame_to_send;
+#else
+			xQueueSendToBackFromISR( freeFrameQueue, &frame_to_send, &xHigherPriorityTaskWoken );
+#endif
+			frame_to_send = NULL;
+		}
 	}
+	else
+	{
+		//underrun, keep the output moving according to the policy
+#if (SYNTH_UNDERRUN_POLICY == SYNTH_UNDERRUN_FADE)
+		last_sample = dac_fade_step(last_sample);
+#elif (SYNTH_UNDERRUN_POLICY == SYNTH_UNDERRUN_REPEAT)
+		if(last_frame != NULL) last_sample = last_frame[frame_index];
+		frame_index = (frame_index + 1) % SYNTH_BLOCK_SIZE;
+#endif
+	}
+
+	//send sample to DAC
+	TRACE_PIN_HIGH(SYNTH_TRACE_PIN_DAC);
+	mcp4821_spi_write( last_sample );
+	TRACE_PIN_LOW(SYNTH_TRACE_PIN_DAC);
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
+#endif
 
-static void vMIDIInterpreter( void *pvParameters )
+
+/******  FreeRTOS TASKS   *******/
+static uint32_t board_cycles( void )
+{
+	return cycle_counter_read();
+}
+
+static uint32_t board_deadline( void )
+{
+	//the block about to render starts to play once the output has got through the samples
+	//queued ahead of it, that many sample periods from now
+	int32_t lead = (int32_t) (synth_render_time() - output_time());
+
+	//until the first block is out the output has no position, the pool is the lead
+	if(!boot_reported) lead = SYNTH_OUTPUT_FRAMES * SYNTH_BLOCK_SIZE;
+	if(lead < 0) lead = 0;
+	return cycle_counter_read() + (uint32_t) lead * cycles_per_sample;
+}
+
+static void board_submit( uint16_t *frame, const uint16_t *samples )
+{
+	audio_output->submit(frame, samples);
+}
+
+static void midi_post( const struct midi_event *event, uint32_t time )
+{
+	//queues an event for render time 'time' plus the output latency, never before the last one
+#if SYNTH_RECORDER
+	recorder_event(event, time);
+#endif
+	time += (uint32_t) output_frames_active() * SYNTH_BLOCK_SIZE;
+	if((int32_t) (time - midi_last_time) < 0) time = midi_last_time;
+	midi_last_time = time;
+
+	synth_post_event_at(event, time);
+}
+
+static bool midi_posted_by_isr( const struct midi_event *event )
+{
+	//events of the SERCOM1 UART that usart_read_callback() hands to the engine itself
+	if(MIDI_REALTIME_FAST && (event->status >= MIDI_CLOCK)) return true;
+
+	return SYNTH_FAST_NOTE_ON && (event->status == MIDI_NOTE_ON);
+}
+
+static void midi_dispatch( void )
 {
-	uint8_t MIDI_message;
-	portBASE_TYPE xStatus;
+	//everything every input has waiting, merged in arrival order: the earliest stamped byte
+	//of all the rings goes to its input's parser next, and every complete message is queued
+	//for the sample its last byte arrived at
+	struct midi_input *input;
+	struct midi_event event;
+	struct midi_event console[CONSOLE_EVENT_QUEUE_LEN];
+#if SYNTH_PANEL_KNOBS
+	struct midi_event knobs[SYNTH_PANEL_KNOBS];
+#endif
+#if SYNTH_RECORDER || SYNTH_SMF_PLAYER
+	struct midi_event replayed[REPLAY_BATCH];
+	uint32_t replayed_time[REPLAY_BATCH];
+#endif
+	uint8_t MIDI_byte;
+	uint32_t MIDI_time = 0;
+	uint32_t time;
+	int count;
+	int i;
 
 	while(1)
 	{
-		//pull messages from MIDI queue and change the voice struct variables
-		xStatus = xQueueReceive( messageQueue, &MIDI_message, 0 );
-
-		if(xStatus == pdTRUE){
-			if((MIDI_message & 0b11110000) == 0b10010000) //NOTE ON command
+		input = NULL;
+		for(i=0; i<MIDI_INPUTS; i++)
+		{
+			if(midi_ring_peek_time(midi_inputs[i].ring, &time) == false) continue;
+			if((input == NULL) || ((int32_t) (time - MIDI_time) < 0))
 			{
-				//pop note id from queue
-				xQueueReceive( messageQueue, &MIDI_message, 0 );
-
-				for(j=0; j<4; j++)
-				{
-					if(active_voices[j].v_enable == false)
-					{
-						active_voices[j].v_enable = true;
-						active_voices[j].v_note_id = 0x7F & MIDI_message;
-						active_voices[j].v_period = note_switcher(0x7F & MIDI_message);
-						active_voices[j].v_counter = 0;
-						break;
-					}
-				}
+				input = &midi_inputs[i];
+				MIDI_time = time;
 			}
-			else if((MIDI_message & 0b11110000) == 0b10000000) //NOTE OFF command
+		}
+		if(input == NULL) break;
+
+		//the first byte after a line error, whatever was in progress is lost
+		if(midi_ring_resync(input->ring))
+		{
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+			if(input->link) voice_link_parser_init(input->link);
+			else
+#endif
+			midi_parser_init(&input->parser);
+		}
+
+		midi_ring_pop(input->ring, &MIDI_byte, &MIDI_time);
+		TRACE_PIN_HIGH(SYNTH_TRACE_PIN_MIDI_PARSE);
+#if SYNTH_FLASH_UPLOAD
+		flash_upload_feed(MIDI_byte);
+#endif
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+		if(input->link)
+		{
+			if(voice_link_feed(input->link, MIDI_byte, &event)) midi_post(&event, MIDI_time);
+			if(input->link->polled)
 			{
-				//pop note id from queue
-				xQueueReceive( messageQueue, &MIDI_message, 0 );
-
-				for(j=0; j<4; j++)
-				{
-					if((active_voices[j].v_enable == true) && (active_voices[j].v_note_id == MIDI_message)
-					{
-						active_voices[j].v_enable = false;
-					}
-				}
+				input->link->polled = false;
+				link_answer();
 			}
 		}
 		else
+#endif
+		if(midi_parser_feed(&input->parser, MIDI_byte, &event))
 		{
-			taskYIELD();
+#if SYNTH_LATENCY_PROBE
+			latency_probe_note(&event, MIDI_time);
+#endif
+			//the RX interrupt has posted the UART's realtime bytes already, and its Note Ons with
+			//SYNTH_FAST_NOTE_ON; those only pass thru
+			if((input != &midi_inputs[0]) || !midi_posted_by_isr(&event)) midi_post(&event, MIDI_time);
+#if SYNTH_RECORDER
+			else recorder_event(&event, MIDI_time);
+#endif
+#if (SYNTH_MIDI_OUT == SYNTH_MIDI_OUT_THRU)
+			midi_out_event(&event);
+#endif
 		}
+		TRACE_PIN_LOW(SYNTH_TRACE_PIN_MIDI_PARSE);
+	}
+
+	//shell events, whole ones only since each was written in one piece
+	count = xStreamBufferReceive( console_events, console, sizeof(console), 0 ) / sizeof(struct midi_event);
+	for(i=0; i<count; i++)
+	{
+		time = output_time();
+#if SYNTH_LATENCY_PROBE
+		latency_probe_note(&console[i], time);
+#endif
+		midi_post(&console[i], time);
 	}
+
+#if SYNTH_PANEL_KNOBS
+	//knobs that moved since the last look, from the array the ADC's DMA keeps current
+	count = panel_knobs_read(knobs);
+	for(i=0; i<count; i++) midi_post(&knobs[i], output_time());
+#endif
+
+#if SYNTH_RECORDER
+	//the take's events due by now, each queued for its own sample
+	do
+	{
+		count = recorder_replay(output_time(), replayed, replayed_time, REPLAY_BATCH);
+		for(i=0; i<count; i++) midi_post(&replayed[i], replayed_time[i]);
+	} while(count == REPLAY_BATCH);
+#endif
+
+#if SYNTH_SMF_PLAYER
+	//the song's, likewise; its flash reads are issued from here too
+	do
+	{
+		count = smf_player_poll(output_time(), replayed, replayed_time, REPLAY_BATCH);
+		for(i=0; i<count; i++) midi_post(&replayed[i], replayed_time[i]);
+	} while(count == REPLAY_BATCH);
+#endif
 }
 
-static void vSampleCalcTask( void *pvParameters )
+static void vMIDIInterpreter( void *pvParameters )
 {
-	portBASE_TYPE xStatus;
-	
+	int i;
+#if SYNTH_MIDI_RX_DMA
+	bool polling;
+#endif
+
+	for(i=0; i<MIDI_INPUTS; i++) midi_parser_init(&midi_inputs[i].parser);
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+	voice_link_parser_init(&link_rx_parser);
+#endif
+	midi_last_time = output_time();
+
+#if SYNTH_MIDI_FLOOD
+	//loopback stress stream, started once the scheduler can take the RX wake-ups
+	midi_flood_start(&usart_instance);
+#endif
+
 	while(1)
 	{
-		//interpret state variables and do sample computation here, then push to sample queue
-		while(full_queue_flag)
+		midi_dispatch();
+
+#if SYNTH_MIDI_RX_DMA
+		//poll the DMA buffer from a burst's first start bit on, see midi_rx_dma.h; USB or the
+		//console cut a poll short, which then proves nothing about the line
+		midi_rx_dma_clear_start();
+		polling = (ulTaskNotifyTake( pdTRUE, MIDI_RX_DMA_POLL_TICKS ) != 0);
+		if(midi_rx_dma_drain(&midi_rx_ring, output_time()) != 0) polling = true;
+		if(midi_rx_dma_line_error(&midi_rx_ring)) trace_log("MIDI RX error\r\n", 0);
+		if(polling) continue;
+
+		//the line was idle for a whole poll, any start bit since its clear wakes the task at once
+		midi_rx_dma_arm();
+#endif
+		//rings are empty, sleep until the next byte or packet; one that slipped in since the
+		//last pop has already notified the task, so nothing is missed
+#if SYNTH_RECORDER
+		if(recorder_replaying())
 		{
-			//runs if there is a sample waiting in the compute buffer, pushes it to queue, resets flag if successful
-			xStatus = xQueueSendToBackFromISR(sampleQueue, &sample_buffer, 0);
-			if(xStatus == pdTRUE) full_queue_flag = false;
+			ulTaskNotifyTake( pdTRUE, 1 );
+			continue;
 		}
+#endif
+#if SYNTH_SMF_PLAYER
+		if(smf_player_playing())
+		{
+			ulTaskNotifyTake( pdTRUE, 1 );
+			continue;
+		}
+#endif
+		ulTaskNotifyTake( pdTRUE, MIDI_IDLE_TICKS );
+	}
+}
+
+#if SYNTH_OUTPUT_DMA
+static void vSampleCalcTask( void *pvParameters )
+{
+	uint16_t *frame;
+	uint16_t *block;
+	uint16_t load;
+	int slot;
+
+	while(1)
+	{
+		//waits for the DMA to hand back a played frame, then renders the next one into it; the
+		//notification counts the slots, so one is there for every take
+		ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		slot = played_slot[played_tail];
+		played_tail = (played_tail + 1) % (SYNTH_OUTPUT_FRAMES + 1);
+		frame = sample_frames[slot];
+
+#if SYNTH_CLOCK_SCALING
+		if(clock_scale_before()) clock_changed();
+#endif
+		TRACE_PIN_HIGH(SYNTH_TRACE_PIN_RENDER);
+		frame_time[slot] = synth_render_time();
+#if SYNTH_AUDIO_TAP
+		//a captured block is rendered into the tap buffer and submitted from there
+		block = audio_tap_slot();
+		if(block == NULL) block = render_block;
+#else
+		block = render_block;
+#endif
+		load = synth_core_block(block, frame);
+#if SYNTH_METER_LED
+		if(!synth_render_late()) meter_led_show(synth_block_peak());
+#endif
+#if SYNTH_LATENCY_PROBE
+		latency_probe_frame(block, frame_time[slot]);
+#endif
+		TRACE_PIN_LOW(SYNTH_TRACE_PIN_RENDER);
+#if SYNTH_CLOCK_SCALING
+		if(clock_scale_after(load)) clock_changed();
+#endif
+
+		frame_ready[slot] = true;
+	}
+}
+#else
+static void render_and_queue( uint16_t *frame )
+{
+#if SYNTH_LATENCY_PROBE
+	uint32_t time;
+#endif
+	uint16_t load;
+#if SYNTH_AUDIO_TAP
+	uint16_t *tap;
+#endif
+
+	//renders a whole frame based on state variables
+#if SYNTH_CLOCK_SCALING
+	if(clock_scale_before()) clock_changed();
+#endif
+	TRACE_PIN_HIGH(SYNTH_TRACE_PIN_RENDER);
+#if SYNTH_LATENCY_PROBE
+	time = synth_render_time();
+#endif
+	//the CPU path's output reads the frame from the queue, nothing to submit
+	load = synth_core_block(frame, NULL);
+#if SYNTH_METER_LED
+	if(!synth_render_late()) meter_led_show(synth_block_peak());
+#endif
+#if SYNTH_LATENCY_PROBE
+	latency_probe_frame(frame, time);
+#endif
+#if SYNTH_AUDIO_TAP
+	tap = audio_tap_slot();
+	if(tap != NULL) audio_tap_copy(tap, frame);
+#endif
+	TRACE_PIN_LOW(SYNTH_TRACE_PIN_RENDER);
+#if SYNTH_CLOCK_SCALING
+	if(clock_scale_after(load)) clock_changed();
+#endif
+
+	//both queues hold the whole pool, so this only fails if a frame pointer got duplicated
+	if(xQueueSendToBack( sampleQueue, &frame, 0 ) != pdTRUE) audio_stats_overrun();
+}
 
-		//calculates samples based state variables and puts it in buffer
-		sample_calc();
+static void vSampleCalcTask( void *pvParameters )
+{
+	uint16_t *frame;
+	uint16_t *parked[SYNTH_OUTPUT_FRAMES];
+	int parked_count = 0;
+
+	while(1)
+	{
+		//blocks until the output stage hands a frame back, so a renderer that is ahead sleeps
+		xQueueReceive( freeFrameQueue, &frame, portMAX_DELAY );
 
-		xStatus = xQueueSendToBackFromISR(sampleQueue, &sample_buffer, 0);
-		if (xStatus == pdFALSE)
+		//keeps the frames beyond the wanted latency out of circulation
+		if(parked_count < SYNTH_OUTPUT_FRAMES - output_active)
 		{
-			//sets full queue flag if push to queue fails
-			full_queue_flag = true;
+			parked[parked_count++] = frame;
+			continue;
 		}
+
+		render_and_queue(frame);
+
+		//latency raised, put parked frames back in flight
+		while(parked_count > SYNTH_OUTPUT_FRAMES - output_active) render_and_queue(parked[--parked_count]);
 	}
 }
+#endif
+
+
+#if SYNTH_CLOCK_SCALING
+static void clock_changed( void )
+{
+	//the block budget is kept in CPU cycles
+	audio_stats_set_rate(system_cpu_clock_get_hz(), synth_sample_rate());
+}
+#endif
 
 /*******      MAIN     **********/
 int main ( void )
 {
+#if !SYNTH_OUTPUT_DMA
+	uint16_t *frame;
+#endif
+
 	//peripheral config
 	system_init();
+	cycle_counter_init();
+	boot_time_mark();
 
 	extosc32k_setup();
-	dfll_setup();	configure_gclock_generator();
-	configure_gclock_channel();	configure_usart();
-	configure_usart_EDBG();
-	configure_usart_callbacks();	system_interrupt_enable_global();
-	configure_spi_master();
+	dfll_setup();
+
+	configure_gclock_generator();
+	configure_gclock_channel();
+
+	configure_usart();
+#if SYNTH_POWER_SAVE
+	console_attached = power_console_present();
+#endif
+	if(console_attached) configure_usart_EDBG();
+	else power_console_discard();
+	configure_usart_callbacks();
+	configure_interrupt_priorities();
+
+	system_interrupt_enable_global();
+#if !SYNTH_OUTPUT_DMA
+	mcp4821_spi_init();
+#endif
 
 	printf("PROGRAM START!\r\n");
+	printf("console: single keys, ':help' for line commands\r\n");
+#if SYNTH_FAST_BOOT
+	printf("clock: %lu Hz, DFLL open loop until XOSC32K runs\r\n", (unsigned long) system_cpu_clock_get_hz());
+#else
+	printf("clock: %lu Hz, DFLL %s\r\n", (unsigned long) system_cpu_clock_get_hz(), dfll_locked ? "locked to XOSC32K" : "open loop");
+#endif
+#if SYNTH_WATCHDOG
+	audio_watchdog_report();
+#endif
+	print_midi_input();
+#if SYNTH_USB_MIDI
+	//the USB module needs the DFLL's 48 MHz within the spec, open loop it is not
+	midi_ring_init(&usb_rx_ring);
+#if SYNTH_FAST_BOOT
+	printf("usb: MIDI starts once the DFLL locks\r\n");
+#else
+	if(dfll_locked) usb_midi_init(&usb_rx_ring, output_time, midi_input_wake);
+	else printf("usb: MIDI off, the DFLL is not locked\r\n");
+#endif
+#endif
+#if SYNTH_MIDI_UART_INPUTS
+	//extra DIN ports, on EXT2 and then EXT1
+	midi_ring_init(&uart_rx_ring[0]);
+	midi_uart_init(&uart_rx_port[0], SERCOM4, USART_RX_1_TX_0_XCK_1, PINMUX_PB13C_SERCOM4_PAD1, SYNTH_MIDI_DIN_BAUD, &uart_rx_ring[0],
+		output_time, midi_input_wake);
+#endif
+#if SYNTH_MIDI_UART_INPUTS > 1
+	midi_ring_init(&uart_rx_ring[1]);
+	midi_uart_init(&uart_rx_port[1], SERCOM2, USART_RX_0_TX_2_XCK_3, PINMUX_PA08D_SERCOM2_PAD0, SYNTH_MIDI_DIN_BAUD, &uart_rx_ring[1],
+		output_time, midi_input_wake);
+	printf("midi: %d DIN inputs next to the main one\r\n", SYNTH_MIDI_UART_INPUTS);
+#endif
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+	midi_ring_init(&link_rx_ring);
+	midi_uart_init(&link_rx_port, SERCOM4, USART_RX_1_TX_0_XCK_1, PINMUX_PB13C_SERCOM4_PAD1, SYNTH_VOICE_LINK_BAUD, &link_rx_ring,
+		output_time, midi_input_wake);
+	midi_uart_enable_tx(&link_rx_port, PINMUX_PB12C_SERCOM4_PAD0);
+	printf("link: voice card %d of %d\r\n", SYNTH_VOICE_CARD_ID, SYNTH_VOICE_LINK_CARDS);
+#endif
+#if SYNTH_PANEL_KNOBS
+	panel_knobs_init();
+	printf("panel: %d knobs from AIN%d on channel %d\r\n", SYNTH_PANEL_KNOBS, SYNTH_PANEL_FIRST_AIN, SYNTH_PANEL_CHANNEL + 1);
+#endif
+
+#if SYNTH_BENCHMARK
+	//kernel timing only, the synth never starts
+	bench_run();
+	while(1);
+#endif
 
 
 	//Begin FreeRTOS Setup
 
-	//create queues and semaphore
-	sampleQueue = xQueueCreate(100, sizeof(uint16_t));
-	messageQueue = xQueueCreate(100, sizeof(uint8_t));
+	//create the queues and buffers, the DMA output path and the MIDI wake-ups use task
+	//notifications instead
+	console_events = xStreamBufferCreateStatic(sizeof(console_event_storage) - 1, sizeof(struct midi_event), console_event_storage, &console_event_buffer);
+#if !SYNTH_OUTPUT_DMA
+	//frame pointers only, the samples never pass through queue storage
+	freeFrameQueue = xQueueCreate(SYNTH_OUTPUT_FRAMES, sizeof(uint16_t *));
+	vQueueAddToRegistry(freeFrameQueue, (signed char *) "free");
+#if SYNTH_KERNEL_TRACE
+	kernel_trace_name_queue(freeFrameQueue, "free");
+#endif
+	sampleQueue = xQueueCreate(SYNTH_OUTPUT_FRAMES, sizeof(uint16_t *));
+	vQueueAddToRegistry(sampleQueue, (signed char *) "sample");
+#if SYNTH_KERNEL_TRACE
+	kernel_trace_name_queue(sampleQueue, "sample");
+#endif
+
+	//the CPU output path starts with every frame free, the DMA ring starts out owning all of them
+	for(n=0; n<SYNTH_OUTPUT_FRAMES; n++)
+	{
+		frame = sample_frames[n];
+		xQueueSendToBack( freeFrameQueue, &frame, 0 );
+	}
+#endif
+
+	synth_core_init(&board_hal);
+	synth_init();
+	printf("synth: rate tables for %lu Hz in %lu cyc\r\n", (unsigned long) synth_sample_rate(), (unsigned long) synth_rate_cycles());
+#if SYNTH_PRESETS
+	printf("presets: %d of %d loaded\r\n", preset_init(), SYNTH_PRESET_COUNT);
+#endif
+#if SYNTH_RECORDER
+	recorder_init();
+	printf("recorder: take of %lu events in %d rows\r\n", (unsigned long) recorder_take_events(), SYNTH_RECORDER_ROWS);
+#endif
+#if SYNTH_MIDI_OUT
+	midi_out_init(&usart_instance);
+#endif
+#if (SYNTH_MIDI_OUT == SYNTH_MIDI_OUT_OVERFLOW)
+	synth_set_overflow(midi_out_event);
+#elif (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+	configure_voice_link();
+	voice_link_init();
+	midi_out_init(&usart_instance_link);
+	synth_set_overflow(voice_link_forward);
+#endif
+	fill_stats_init(&fill_output, SYNTH_OUTPUT_FRAMES);
+	fill_stats_init(&fill_free, SYNTH_OUTPUT_FRAMES);
+	fill_stats_init(&fill_midi, MIDI_RING_SIZE);
+	fill_stats_init(&fill_events, SYNTH_EVENT_QUEUE_SIZE);
+	stats_timer = xTimerCreate((const signed char *) "Stats", SYNTH_STATS_SAMPLE_MS / portTICK_RATE_MS, pdTRUE, NULL, sample_fill_levels);
+	xTimerStart(stats_timer, 0);
+#if SYNTH_STREAM || SYNTH_SMF_PLAYER || SYNTH_FLASH_UPLOAD
+	spi_flash_init();
+#endif
+#if SYNTH_STREAM
+	printf("stream: %d samples in SPI flash\r\n", stream_attach(spi_flash_read, spi_flash_read_batch));
+#endif
+#if SYNTH_SMF_PLAYER
+	printf("song: %d tracks at 0x%06lx\r\n", smf_player_init(), (unsigned long) SYNTH_SMF_ADDRESS);
+	if(SYNTH_SMF_AUTOPLAY) smf_player_start();
+#endif
+
+	cycles_per_sample = SYSTEM_CLK_FREQ / synth_sample_rate();
+	trace_pins_init();
+	audio_stats_init(system_cpu_clock_get_hz(), synth_sample_rate());
+	shell_init(shell_commands, (int) (sizeof(shell_commands) / sizeof(shell_commands[0])));
+	trace_log_set_command_handler(console_command);
+	//housekeeping runs as jobs of the trace log task rather than tasks with their own stacks
+#if SYNTH_TELEMETRY
+	trace_log_add_job(send_telemetry, SYNTH_TELEMETRY_PERIOD_MS / portTICK_RATE_MS);
+#endif
+	trace_log_add_job(report_learn, 0);
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER) && SYNTH_VOICE_LINK_POLL_MS
+	trace_log_add_job(voice_link_poll, SYNTH_VOICE_LINK_POLL_MS / portTICK_RATE_MS);
+#endif
+#if SYNTH_RECORDER
+	trace_log_add_job(recorder_job, 0);
+#endif
+#if SYNTH_LATENCY_PROBE
+	trace_log_add_job(probe_job, 0);
+#endif
+#if SYNTH_POLY_SWEEP
+	trace_log_add_job(sweep_job, 0);
+#endif
+#if SYNTH_FLASH_UPLOAD
+	trace_log_add_job(flash_upload_job, 0);
+#endif
+#if SYNTH_FAST_BOOT
+	trace_log_add_job(dfll_lock_job, 0);
+#endif
+	tickless_idle_init();
+
+	//only the TCBs come from the heap, the stacks are static
+	xTaskGenericCreate(vSampleCalcTask, "Synth", SYNTH_TASK_STACK, NULL, SYNTH_TASK_PRIORITY, &synth_task, synth_task_stack, NULL);
+	xTaskGenericCreate(vMIDIInterpreter, "MIDI Interp", MIDI_TASK_STACK, NULL, MIDI_TASK_PRIORITY, &midi_task, midi_task_stack, NULL);
+	xTaskGenericCreate(vTraceLogTask, "Trace Log", TRACE_TASK_STACK, NULL, TRACE_TASK_PRIORITY, &trace_task, trace_task_stack, NULL);
+	//the sample clock paces the DAC, the kernel tick no longer does
+#if SYNTH_OUTPUT_DMA
+	//the output's init fills every frame with silence, so all of them start out playable; renderer
+	//block 0 follows the silent frames of the ring
+	for(n=0; n<SYNTH_OUTPUT_FRAMES; n++)
+	{
+		frame_ready[n] = true;
+		frame_time[n] = (uint32_t) (n - SYNTH_OUTPUT_FRAMES_ACTIVE) * SYNTH_BLOCK_SIZE;
+	}
+	output_frame_time = frame_time[0];
+	printf("output: %s\r\n", audio_output->name);
+	audio_output->init(sample_frames, dac_frame_played_callback);
+	if(!output_prime()) printf("output: %s does not take writes\r\n", audio_output->name);
+	audio_output->start(synth_sample_rate());
+#else
+	if(!output_prime()) printf("output: %s does not take writes\r\n", audio_output->name);
+	sample_clock_init(synth_sample_rate(), dac_sample_tick);
+#if SYNTH_MCP4821_LDAC
+	sample_clock_strobe_init();
+#endif
+	sample_clock_start();
+#endif
+#if SYNTH_AUDIO_INPUT
+	//converts on the output's own sample clock ticks
+	audio_input_init();
+	printf("input: AIN%d into the master effects\r\n", SYNTH_AUDIO_INPUT_AIN);
+#endif
+#if SYNTH_SAMPLE_SYNC
+	sample_clock_sync_init(SAMPLE_CLOCK_BLOCK_TICKS);
+	printf("output: sample clock %s\r\n", (SYNTH_SAMPLE_SYNC == SYNTH_SAMPLE_SYNC_MASTER) ? "sync master on PA10" : "follows PA10");
+#endif
+
+#if SYNTH_METER_LED
+	//LED0 is TCC1's from here on, the boot report's port level no longer shows
+	meter_led_init();
+	printf("meter: output peak on LED0\r\n");
+#endif
+
+#if SYNTH_WATCHDOG
+	//the output runs, from here on it has to keep delivering blocks
+	audio_watchdog_init();
+	printf("watchdog: reset after %d ms without a block in time\r\n", SYNTH_WATCHDOG_TIMEOUT_MS);
+#endif
 
-	//UARTsem = vSemaphoreCreateBinary();
+#if SYNTH_POWER_SAVE
+	//everything the synth runs on is set up by now
+	power_print_gated(power_gate_unused());
+#endif
 
-	xTaskCreate(vSampleCalcTask, "Synth", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
-	xTaskCreate(vMIDIInterpreter, "MIDI Interp", configMINIMAL_STACK_SIZE, NULL, 2, NULL);
-	xTaskCreate(vPeriodicSPITask, "SPI Push", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
-	xTaskCreate(vUARTHandlerTask, "UART read", configMINIMAL_STACK_SIZE, NULL, 4, NULL);
+	//start-up output is done, from here on printf does not wait for the line
+#if SYNTH_DEBUG_UART_BUFFERED
+	if(console_attached) debug_uart_attach(&usart_instance_EDBG);
+#endif
 
+	check_priorities();
 	vTaskStartScheduler();
 	while(1);
 
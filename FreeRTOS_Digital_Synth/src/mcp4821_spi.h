@@ -0,0 +1,39 @@
+/*************************************************************************************************
+                                      --MCP4821 SPI WRITE--
+
+	The per-sample DAC write of the CPU-driven output (SYNTH_OUTPUT_DMA off), inlined into
+	the sample clock interrupt. The SERCOM is addressed as the board constant rather than
+	through the ASF module, so a write is two flag polls and two stores with no argument
+	checks or timeouts; mcp4821_spi_init() still sets the port up with the ASF driver.
+
+	Both bytes go into the double-buffered DATA register back to back, so the hardware SS
+	stays low for the whole word. Nothing waits for the transfer to complete, it is done
+	long before the next sample.
+
+*************************************************************************************************/
+
+#ifndef MCP4821_SPI_H_INCLUDED
+#define MCP4821_SPI_H_INCLUDED
+
+#include <asf.h>
+#include "sample_format.h"
+
+/**********  DEFINE  ************/
+#define	DAC_CMD_MASK		(	0x3000	) //to logical OR with every outgoing DAC sample, for MCP4821
+#define DAC_CMD_CHANNEL_B	(	0x8000	) //second channel of the MCP4822
+#define MCP4821_WORD_BITS	(	12	)
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline void mcp4821_spi_write( uint16_t code )
+{
+	//writes to DAC with max voltage depth 2.048V
+	SercomSpi *const spi = &EXT1_SPI_MODULE->SPI;
+	uint16_t word = sample_word(code, MCP4821_WORD_BITS, false) | DAC_CMD_MASK;
+
+	while(!(spi->INTFLAG.reg & SERCOM_SPI_INTFLAG_DRE));
+	spi->DATA.reg = word >> 8;
+	while(!(spi->INTFLAG.reg & SERCOM_SPI_INTFLAG_DRE));
+	spi->DATA.reg = word & 0xFF;
+}
+
+#endif /* MCP4821_SPI_H_INCLUDED */
@@ -0,0 +1,61 @@
+/*************************************************************************************************
+                                          --METER LED--
+
+	A peak of 2048, full scale, is 2048 * 2048 >> 11, the whole period; anything larger is
+	held there, the LED cannot be more than always on.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "meter_led.h"
+
+#if SYNTH_METER_LED
+
+/**********  DEFINE  ************/
+#define METER_LED_PERIOD		(	2048	)
+#define METER_LED_SHIFT			(	11	)
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void meter_led_wait( uint32_t bits )
+{
+	while(TCC1->SYNCBUSY.reg & bits);
+}
+
+void meter_led_init( void )
+{
+	//takes LED0 over from the port, dark until the first block is shown
+	struct system_gclk_chan_config gclk_chan_conf;
+	struct system_pinmux_config config_mux;
+
+	PM->APBCMASK.reg |= PM_APBCMASK_TCC1;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
+	system_gclk_chan_set_config(TCC1_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(TCC1_GCLK_ID);
+
+	TCC1->CTRLA.reg = TCC_CTRLA_SWRST;
+	meter_led_wait(TCC_SYNCBUSY_SWRST);
+	TCC1->WAVE.reg = TCC_WAVE_WAVEGEN_NPWM;
+	TCC1->DRVCTRL.reg = TCC_DRVCTRL_INVEN2;
+	TCC1->PER.reg = METER_LED_PERIOD - 1;
+	TCC1->CC[0].reg = 0;
+	meter_led_wait(TCC_SYNCBUSY_MASK);
+	TCC1->CTRLA.reg = TCC_CTRLA_ENABLE;
+	meter_led_wait(TCC_SYNCBUSY_ENABLE);
+
+	system_pinmux_get_config_defaults(&config_mux);
+	config_mux.mux_position = PINMUX_PB30F_TCC1_WO2 & 0xFFFF;
+	config_mux.direction = SYSTEM_PINMUX_PIN_DIR_OUTPUT;
+	system_pinmux_pin_set_config(PINMUX_PB30F_TCC1_WO2 >> 16, &config_mux);
+}
+
+SYNTH_RAM_CODE void meter_led_show( uint16_t peak )
+{
+	//render task, once per block; no wait, the buffer is written whatever its state
+	uint32_t on = ((uint32_t) peak * peak) >> METER_LED_SHIFT;
+
+	TCC1->CCB[0].reg = (on > METER_LED_PERIOD) ? METER_LED_PERIOD : on;
+}
+
+#endif /* SYNTH_METER_LED */
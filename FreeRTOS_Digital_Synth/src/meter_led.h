@@ -0,0 +1,27 @@
+/*************************************************************************************************
+                                          --METER LED--
+
+	The output's peak level on LED0 (PB30), for a glance at the level without a console.
+	TCC1 runs normal PWM from the 8 MHz generator with a period of 2048 counts, about 3.9 kHz,
+	on WO[2], PB30's function F, which follows CC0. The output is inverted for the active
+	low LED, so the compare value is the time it is lit.
+
+	meter_led_show() takes a block's peak in DAC units from midscale, synth_block_peak(),
+	and lights the LED for its square; the eye takes brightness about as the square root of
+	the duty cycle, so the LED looks about as bright as the level is high. The compare value goes through the buffer register and takes effect at the next period.
+
+	TCC1 is the block counter of SYNTH_SAMPLE_SYNC, the two do not go together.
+
+*************************************************************************************************/
+
+#ifndef METER_LED_H_INCLUDED
+#define METER_LED_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void meter_led_init( void );
+void meter_led_show( uint16_t peak );
+
+#endif /* METER_LED_H_INCLUDED */
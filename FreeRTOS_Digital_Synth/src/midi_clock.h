@@ -0,0 +1,45 @@
+/*************************************************************************************************
+                                         --MIDI CLOCK--
+
+	Tempo from MIDI timing clock (0xF8, 24 per quarter note). Every clock carries the
+	render time its byte was stamped with in the receive interrupt, so the interval between
+	two of them is the sender's, without the delay of waking the MIDI task or of the event
+	queue. The period is kept in Q8 samples per clock and follows each new interval by
+	1/2^MIDI_CLOCK_SMOOTH_SHIFT, which averages out the byte time and a sender's own jitter
+	over a beat or so.
+
+	An interval more than a quarter away from the period is a tempo change, the period
+	jumps to it; one longer than the timeout given is a gap (stopped transport, cable
+	pulled) and only restarts the measurement. midi_clock_restart() does the same after
+	MIDI Start.
+
+	Pure arithmetic on a struct, the engine owns it and runs it in its control context.
+
+*************************************************************************************************/
+
+#ifndef MIDI_CLOCK_H_INCLUDED
+#define MIDI_CLOCK_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define MIDI_CLOCK_PPQN			(	24	)
+#define MIDI_CLOCK_FRAC_BITS	(	8	)
+#define MIDI_CLOCK_SMOOTH_SHIFT	(	4	)
+
+/********   TYPE DEFS  **********/
+struct midi_clock{
+	uint32_t last;			//render time of the last clock
+	uint32_t period;		//Q8 samples per clock, 0 until two clocks were timed
+	bool timing;			//last is valid
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void midi_clock_init( struct midi_clock *clock );
+void midi_clock_restart( struct midi_clock *clock );
+bool midi_clock_tick( struct midi_clock *clock, uint32_t time, uint32_t timeout );
+uint32_t midi_clock_tempo( uint32_t period, uint32_t sample_rate );
+uint32_t midi_clock_period( uint32_t tempo, uint32_t sample_rate );
+
+#endif /* MIDI_CLOCK_H_INCLUDED */
@@ -0,0 +1,143 @@
+/*************************************************************************************************
+                                         --MIDI FLOOD--
+
+	The stream is two buffers sent alternately with interrupt-driven write jobs: the flood
+	part (dense burst, all sound off, a gap of active sensing bytes, which the parser drops)
+	and the probe note-on. The transmit-complete callback starts the other buffer, so the
+	line never idles and the CPU only sees one interrupt per byte.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "midi_flood.h"
+#include "synth_engine.h"
+#include "fast_gpio.h"
+
+
+/**********  DEFINE  ************/
+#define FLOOD_BUFF_LEN		(	512	)
+
+//active sensing bytes between all sound off and the probe, ~5.6 ms at 115.2k
+#define FLOOD_GAP_BYTES		(	64	)
+
+#define FLOOD_PROBE_NOTE	(	69	)
+
+
+/*******   GLOBAL VARS  *********/
+static uint8_t flood_buffer[FLOOD_BUFF_LEN];
+static uint16_t flood_length;
+
+static uint8_t probe_buffer[3] = { MIDI_NOTE_ON, FLOOD_PROBE_NOTE, 127 };
+
+static bool flood_probe_next;
+static volatile uint32_t flood_bytes_sent;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void midi_flood_sent_callback( struct usart_module *const usart );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void flood_put( uint8_t byte )
+{
+	if(flood_length < FLOOD_BUFF_LEN) flood_buffer[flood_length++] = byte;
+}
+
+static void flood_build( void )
+{
+	//four chords, each with a cutoff sweep and a bend sweep, status bytes only where running
+	//status can not carry over
+	static const uint8_t roots[4] = { 48, 53, 55, 60 };
+	int chord;
+	int n;
+
+	flood_length = 0;
+
+	for(chord=0; chord<4; chord++)
+	{
+		flood_put(MIDI_NOTE_ON);
+		for(n=0; n<4; n++)
+		{
+			flood_put(roots[chord] + 4 * n);
+			flood_put(100);
+		}
+
+		flood_put(MIDI_CONTROL_CHANGE);
+		for(n=0; n<128; n+=8)
+		{
+			flood_put(MIDI_CC_CUTOFF);
+			flood_put(n);
+		}
+
+		flood_put(MIDI_PITCH_BEND);
+		for(n=0; n<128; n+=16)
+		{
+			flood_put(0);
+			flood_put(n);
+		}
+		flood_put(0);
+		flood_put(64);
+
+		//note-on with velocity 0 releases
+		flood_put(MIDI_NOTE_ON);
+		for(n=0; n<4; n++)
+		{
+			flood_put(roots[chord] + 4 * n);
+			flood_put(0);
+		}
+	}
+
+	//silence before the probe
+	flood_put(MIDI_NOTE_OFF);
+	flood_put(FLOOD_PROBE_NOTE);
+	flood_put(0);
+	flood_put(MIDI_CONTROL_CHANGE);
+	flood_put(MIDI_CC_ALL_SOUND_OFF);
+	flood_put(0);
+	for(n=0; n<FLOOD_GAP_BYTES; n++) flood_put(MIDI_ACTIVE_SENSING);
+}
+
+void midi_flood_start( struct usart_module *const usart )
+{
+	struct port_config pin_conf;
+
+	port_get_config_defaults(&pin_conf);
+	pin_conf.direction = PORT_PIN_DIR_OUTPUT;
+	port_pin_set_config(MIDI_FLOOD_MARKER_PIN, &pin_conf);
+	port_pin_set_output_level(MIDI_FLOOD_MARKER_PIN, false);
+
+	flood_build();
+	flood_probe_next = true;
+	flood_bytes_sent = 0;
+
+	usart_register_callback(usart, midi_flood_sent_callback, USART_CALLBACK_BUFFER_TRANSMITTED);
+	usart_enable_callback(usart, USART_CALLBACK_BUFFER_TRANSMITTED);
+
+	usart_write_buffer_job(usart, flood_buffer, flood_length);
+}
+
+uint32_t midi_flood_bytes_sent( void )
+{
+	return flood_bytes_sent;
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+static void midi_flood_sent_callback( struct usart_module *const usart )
+{
+	//alternates flood and probe, the marker is high while the probe note-on is on the line
+	if(flood_probe_next)
+	{
+		flood_bytes_sent += flood_length;
+		fast_pin_high(MIDI_FLOOD_MARKER_PIN);
+		usart_write_buffer_job(usart, probe_buffer, sizeof(probe_buffer));
+	}
+	else
+	{
+		flood_bytes_sent += sizeof(probe_buffer);
+		fast_pin_low(MIDI_FLOOD_MARKER_PIN);
+		usart_write_buffer_job(usart, flood_buffer, flood_length);
+	}
+
+	flood_probe_next = !flood_probe_next;
+}
@@ -0,0 +1,29 @@
+/*************************************************************************************************
+                                         --MIDI FLOOD--
+
+	Input path stress test, built in when SYNTH_MIDI_FLOOD is set. The MIDI USART transmits
+	a synthetic stream back to back at the line rate: chords, CC sweeps and pitch bends
+	with running status between single probe notes. Needs a jumper from the MIDI TX pin to
+	its RX pin (PA16 to PA17).
+
+	Each probe note-on follows a silent gap, and MIDI_FLOOD_MARKER_PIN goes high as the probe
+	starts transmitting, so the time from the marker edge to the first DAC change on a scope
+	is the whole note-on to output latency.
+
+*************************************************************************************************/
+
+#ifndef MIDI_FLOOD_H_INCLUDED
+#define MIDI_FLOOD_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//EXT1 pin 3, the old software DAC chip select
+#define MIDI_FLOOD_MARKER_PIN		PIN_PB08
+
+/****** FUNCTION PROTOTYPES  ****/
+void midi_flood_start( struct usart_module *const usart );
+uint32_t midi_flood_bytes_sent( void );
+
+#endif /* MIDI_FLOOD_H_INCLUDED */
@@ -0,0 +1,186 @@
+/*************************************************************************************************
+                                          --MIDI OUT--
+
+	Producers write the ring's head inside a critical section, the channel's completion
+	interrupt moves the tail and starts the next run, so neither side waits on the other.
+	A run ends at the buffer's end or at the head as it was when it started; what is queued
+	meanwhile goes out with the next one, started from the interrupt. The channel is on a
+	low level: at 31250 baud it moves one byte every 320 us.
+
+	Running status is dropped after a message did not fit, the next one goes out with its
+	status byte in case the receiver lost track.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "midi_out.h"
+#include "dac_dma.h"
+
+#if SYNTH_MIDI_OUT || (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+
+/**********  DEFINE  ************/
+#define MIDI_OUT_MASK			(	SYNTH_MIDI_OUT_SIZE - 1	)
+
+#if (SYNTH_MIDI_OUT_SIZE & MIDI_OUT_MASK)
+#  error "SYNTH_MIDI_OUT_SIZE must be a power of two"
+#endif
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static bool midi_out_queue( const uint8_t *bytes, int length );
+static void midi_out_start( void );
+static void midi_out_done( void );
+
+
+/*******   GLOBAL VARS  *********/
+static SercomUsart *midi_out_hw;
+static uint8_t midi_out_buffer[SYNTH_MIDI_OUT_SIZE];
+static uint16_t midi_out_head;
+static volatile uint16_t midi_out_tail;
+static volatile uint16_t midi_out_run;		//bytes the DMA is sending, 0 while idle
+static uint8_t midi_out_status;			//running status, 0 for none
+static volatile uint32_t midi_out_sent;
+static uint16_t midi_out_lost;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void midi_out_init( struct usart_module *usart )
+{
+	//the USART must be enabled with its transmitter on; SERCOMn's TX trigger is 2n + 2
+	uint8_t trigger = SERCOM0_DMAC_ID_TX + 2 * _sercom_get_sercom_inst_index(usart->hw);
+
+	midi_out_hw = &usart->hw->USART;
+	midi_out_head = 0;
+	midi_out_tail = 0;
+	midi_out_run = 0;
+	midi_out_status = 0;
+
+	dac_dma_controller_init();
+	DMAC->CHID.reg = DMAC_CHID_ID(MIDI_DMA_TX_CHANNEL);
+	DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+	DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(trigger) | DMAC_CHCTRLB_TRIGACT_BEAT;
+	DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+	dac_dma_attach_channel(MIDI_DMA_TX_CHANNEL, midi_out_done);
+}
+
+bool midi_out_event( const struct midi_event *event )
+{
+	//false when the ring had no room for the message
+	uint8_t status;
+	uint8_t bytes[3];
+	int length = 0;
+	int i;
+	bool queued;
+
+	//the parsed tuning SysEx has no single-message form to pass on
+	if((event->status == MIDI_TUNING_NOTE) || (event->status == MIDI_TUNING_SCALE)) return true;
+
+	if(event->status >= MIDI_SYSEX_START)
+	{
+		//realtime, passes running status by
+		bytes[length++] = event->status;
+	}
+	else
+	{
+		status = event->status | (event->channel & 0x0F);
+		bytes[length++] = status;
+		bytes[length++] = event->data1 & 0x7F;
+		if((event->status != MIDI_PROGRAM_CHANGE) && (event->status != MIDI_CHANNEL_PRESSURE)) bytes[length++] = event->data2 & 0x7F;
+	}
+
+	taskENTER_CRITICAL();
+	if((bytes[0] < MIDI_SYSEX_START) && (bytes[0] == midi_out_status))
+	{
+		//running status, the status byte is left out
+		for(i=1; i<length; i++) bytes[i - 1] = bytes[i];
+		length--;
+	}
+
+	queued = midi_out_queue(bytes, length);
+	if(queued == false) midi_out_status = 0;
+	else if(event->status < MIDI_SYSEX_START) midi_out_status = event->status | (event->channel & 0x0F);
+	taskEXIT_CRITICAL();
+
+	return queued;
+}
+
+bool midi_out_write( const uint8_t *bytes, int length )
+{
+	//raw bytes, whole or not at all; for a transmitter that carries no MIDI
+	bool queued;
+
+	taskENTER_CRITICAL();
+	queued = midi_out_queue(bytes, length);
+	taskEXIT_CRITICAL();
+
+	return queued;
+}
+
+static bool midi_out_queue( const uint8_t *bytes, int length )
+{
+	//with interrupts masked
+	int i;
+
+	if((uint16_t) (midi_out_head - midi_out_tail) + length > SYNTH_MIDI_OUT_SIZE)
+	{
+		midi_out_lost++;
+		return false;
+	}
+
+	for(i=0; i<length; i++) midi_out_buffer[(midi_out_head + i) & MIDI_OUT_MASK] = bytes[i];
+	midi_out_head += length;
+	if(midi_out_run == 0) midi_out_start();
+
+	return true;
+}
+
+uint32_t midi_out_bytes( void )
+{
+	return midi_out_sent;
+}
+
+uint16_t midi_out_dropped( void )
+{
+	return midi_out_lost;
+}
+
+static void midi_out_start( void )
+{
+	//next run from the tail, with interrupts masked or from the channel's own interrupt
+	DmacDescriptor *desc = dac_dma_base_descriptor(MIDI_DMA_TX_CHANNEL);
+	uint16_t offset = midi_out_tail & MIDI_OUT_MASK;
+	uint16_t count = (uint16_t) (midi_out_head - midi_out_tail);
+	uint8_t chid = DMAC->CHID.reg;
+
+	if(count > SYNTH_MIDI_OUT_SIZE - offset) count = SYNTH_MIDI_OUT_SIZE - offset;
+	midi_out_run = count;
+	if(count == 0) return;
+
+	//the source is the end address where the descriptor increments
+	desc->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_BLOCKACT_NOACT;
+	desc->BTCNT.reg = count;
+	desc->SRCADDR.reg = (uint32_t) &midi_out_buffer[offset] + count;
+	desc->DSTADDR.reg = (uint32_t) &midi_out_hw->DATA.reg;
+	desc->DESCADDR.reg = 0;
+
+	DMAC->CHID.reg = DMAC_CHID_ID(MIDI_DMA_TX_CHANNEL);
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+	DMAC->CHID.reg = chid;
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+static void midi_out_done( void )
+{
+	//the channel is already selected, and disabled by the end of its only block
+	DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+
+	midi_out_sent += midi_out_run;
+	midi_out_tail += midi_out_run;
+	midi_out_start();
+}
+
+#endif /* SYNTH_MIDI_OUT || SYNTH_VOICE_LINK_MASTER */
@@ -0,0 +1,37 @@
+/*************************************************************************************************
+                                          --MIDI OUT--
+
+	MIDI out on the TX pad of the MIDI USART, SERCOM1 PAD0 on PA16, at the input's line
+	rate. Events are encoded into a transmit ring, with running status, and the DMA moves
+	them to the USART a contiguous run at a time; the CPU only touches the bytes once, at
+	midi_out_event(). A DIN port needs the usual 3.3 V output stage and two 33 ohm resistors
+	on the pin, the serial-MIDI bridge takes it as it is.
+
+	midi_out_event() may be called from any task, it queues a message whole or not at all
+	and counts the ones that did not fit.
+
+	SYNTH_MIDI_OUT_THRU feeds it every event the MIDI task parses. With OVERFLOW the engine
+	hands it the notes it has no free voice for, see synth_set_overflow(), along with every
+	channel message except notes, so the board behind plays the spill with the same
+	controllers, program and bend.
+
+	The voice link master runs the same transmitter on its own USART instead, with
+	midi_out_write() for its packets; the channel's trigger follows the USART it was given.
+
+*************************************************************************************************/
+
+#ifndef MIDI_OUT_H_INCLUDED
+#define MIDI_OUT_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void midi_out_init( struct usart_module *usart );
+bool midi_out_event( const struct midi_event *event );
+bool midi_out_write( const uint8_t *bytes, int length );
+uint32_t midi_out_bytes( void );
+uint16_t midi_out_dropped( void );
+
+#endif /* MIDI_OUT_H_INCLUDED */
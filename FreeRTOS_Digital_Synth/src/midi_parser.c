@@ -0,0 +1,247 @@
+/*************************************************************************************************
+                                         --MIDI PARSER--
+
+	Running status is kept across channel messages and cleared by system common and SysEx;
+	data bytes without a status in force are dropped, which resynchronizes the parser on
+	the next status byte.
+
+	The MTS messages are recognized from their first four bytes, universal ID (7E or 7F),
+	device, 08 and the sub-ID; after the fixed header the notes follow in groups of four
+	(key and three frequency bytes) or three (frequency only, the key counting up from 0)
+	and the scale/octave form has twelve single offsets.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "midi_parser.h"
+
+
+/**********  DEFINE  ************/
+#define MTS_ID					(	0x08	)
+#define MTS_BULK_DUMP			(	0x01	)
+#define MTS_NOTE_CHANGE			(	0x02	)
+#define MTS_NOTE_CHANGE_BANK	(	0x07	)
+#define MTS_SCALE_OCTAVE		(	0x08	)
+
+//first data byte after the header of each form, the bulk dump has a 16-byte name first
+#define MTS_BULK_START			(	21	)
+#define MTS_NOTE_START			(	6	)
+#define MTS_NOTE_BANK_START		(	7	)
+#define MTS_SCALE_START			(	7	)
+
+//a 7F 7F 7F frequency leaves the note as it is
+#define MTS_NO_CHANGE			(	0x7F	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static bool midi_sysex_feed( struct midi_parser *parser, uint8_t byte, struct midi_event *event );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint8_t midi_data_length( uint8_t status )
+{
+	//program change and channel pressure carry one data byte, all other channel messages two
+	switch(status & 0xF0)
+	{
+		case MIDI_PROGRAM_CHANGE:
+		case MIDI_CHANNEL_PRESSURE:
+		return 1;
+
+		default:
+		return 2;
+	}
+}
+
+void midi_parser_init( struct midi_parser *parser )
+{
+	parser->running_status = 0;
+	parser->count = 0;
+	parser->in_sysex = false;
+	parser->sysex_index = 0;
+	parser->sysex_type = 0;
+}
+
+bool midi_parser_feed( struct midi_parser *parser, uint8_t byte, struct midi_event *event )
+{
+	//returns true when byte completes an event
+	if(byte >= MIDI_CLOCK)
+	{
+		//realtime, single byte and does not disturb a message in progress
+		event->status = byte;
+		event->channel = 0;
+		event->data1 = 0;
+		event->data2 = 0;
+		return true;
+	}
+
+	if(byte & 0x80)
+	{
+		parser->count = 0;
+
+		if(byte < MIDI_SYSEX_START)
+		{
+			parser->running_status = byte;
+			parser->in_sysex = false;
+		}
+		else
+		{
+			//SysEx and system common cancel running status
+			parser->running_status = 0;
+			parser->in_sysex = (byte == MIDI_SYSEX_START);
+			parser->sysex_index = 0;
+			parser->sysex_type = 0;
+		}
+		return false;
+	}
+
+	if(parser->in_sysex) return midi_sysex_feed(parser, byte, event);
+	if(parser->running_status == 0) return false;
+
+	parser->data[parser->count++] = byte;
+	if(parser->count < midi_data_length(parser->running_status)) return false;
+
+	parser->count = 0;
+
+	event->status = parser->running_status & 0xF0;
+	event->channel = parser->running_status & 0x0F;
+	event->data1 = parser->data[0];
+	event->data2 = (event->status == MIDI_PROGRAM_CHANGE || event->status == MIDI_CHANNEL_PRESSURE) ? 0 : parser->data[1];
+
+	//note on with velocity 0 is a note off
+	if((event->status == MIDI_NOTE_ON) && (event->data2 == 0)) event->status = MIDI_NOTE_OFF;
+
+	return true;
+}
+
+void midi_framer_init( struct midi_framer *framer )
+{
+	framer->running_status = 0;
+	framer->count = 0;
+	framer->data1 = 0;
+}
+
+bool midi_framer_feed( struct midi_framer *framer, uint8_t byte )
+{
+	//the parser's status and count rules without the data, SysEx bytes only end at F7
+	if(byte >= MIDI_CLOCK) return true;
+
+	if(byte & 0x80)
+	{
+		framer->count = 0;
+		framer->running_status = (byte < MIDI_SYSEX_START) ? byte : 0;
+
+		//F6 and F7 end what they belong to, every other system common byte waits for data
+		return (byte == 0xF6) || (byte == MIDI_SYSEX_END);
+	}
+
+	if(framer->running_status == 0) return false;
+
+	if(framer->count == 0) framer->data1 = byte;
+	if(++framer->count < midi_data_length(framer->running_status)) return false;
+	framer->count = 0;
+
+	return true;
+}
+
+bool midi_framer_note_on( const struct midi_framer *framer, uint8_t byte, struct midi_event *event )
+{
+	//'byte' is the one midi_framer_feed() just returned true for; a velocity of 0 is a Note
+	//Off and left to the parser
+	if((byte & 0x80) || (byte == 0) || ((framer->running_status & 0xF0) != MIDI_NOTE_ON)) return false;
+
+	event->status = MIDI_NOTE_ON;
+	event->channel = framer->running_status & 0x0F;
+	event->data1 = framer->data1;
+	event->data2 = byte;
+
+	return true;
+}
+
+static bool midi_sysex_feed( struct midi_parser *parser, uint8_t byte, struct midi_event *event )
+{
+	//true when the byte completes a tuned note or pitch class
+	uint16_t i = parser->sysex_index;
+	uint16_t start;
+	uint16_t group;
+	uint16_t pos;
+
+	if(i < 0xFFFF) parser->sysex_index = i + 1;
+
+	switch(i)
+	{
+		case 0:
+		parser->sysex_type = ((byte == 0x7E) || (byte == 0x7F)) ? MTS_ID : 0;
+		return false;
+
+		case 1:
+		return false;
+
+		case 2:
+		if(byte != MTS_ID) parser->sysex_type = 0;
+		return false;
+
+		case 3:
+		if(parser->sysex_type == 0) return false;
+		if((byte == MTS_BULK_DUMP) || (byte == MTS_NOTE_CHANGE) || (byte == MTS_NOTE_CHANGE_BANK) || (byte == MTS_SCALE_OCTAVE)) parser->sysex_type = byte;
+		else parser->sysex_type = 0;
+		return false;
+
+		default:
+		break;
+	}
+
+	switch(parser->sysex_type)
+	{
+		case MTS_BULK_DUMP:
+		start = MTS_BULK_START;
+		group = 3;
+		break;
+
+		case MTS_NOTE_CHANGE:
+		start = MTS_NOTE_START;
+		group = 4;
+		break;
+
+		case MTS_NOTE_CHANGE_BANK:
+		start = MTS_NOTE_BANK_START;
+		group = 4;
+		break;
+
+		case MTS_SCALE_OCTAVE:
+		if((i < MTS_SCALE_START) || (i >= MTS_SCALE_START + 12)) return false;
+		event->status = MIDI_TUNING_SCALE;
+		event->channel = (uint8_t) (i - MTS_SCALE_START);
+		event->data1 = byte;
+		event->data2 = 0;
+		return true;
+
+		default:
+		return false;
+	}
+
+	if(i < start) return false;
+
+	//a dump has exactly 128 notes, its checksum comes after them
+	if((group == 3) && (i >= start + 128 * 3)) return false;
+
+	pos = (i - start) % group;
+	parser->sysex_data[pos] = byte;
+	if(pos != group - 1) return false;
+
+	if(group == 3)
+	{
+		//the key is the note's place in the dump
+		parser->sysex_data[3] = parser->sysex_data[2];
+		parser->sysex_data[2] = parser->sysex_data[1];
+		parser->sysex_data[1] = parser->sysex_data[0];
+		parser->sysex_data[0] = (uint8_t) ((i - start) / 3);
+	}
+
+	if((parser->sysex_data[1] == MTS_NO_CHANGE) && (parser->sysex_data[2] == MTS_NO_CHANGE) && (parser->sysex_data[3] == MTS_NO_CHANGE)) return false;
+
+	event->status = MIDI_TUNING_NOTE;
+	event->channel = parser->sysex_data[0];
+	event->data1 = parser->sysex_data[1];
+	event->data2 = parser->sysex_data[2];
+	return true;
+}
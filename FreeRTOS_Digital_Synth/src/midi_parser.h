@@ -0,0 +1,96 @@
+/*************************************************************************************************
+                                         --MIDI PARSER--
+
+	Incremental byte-at-a-time MIDI parser. Handles running status, velocity-0 note off,
+	all channel voice messages and realtime bytes (which may arrive in the middle of another
+	message). Complete messages come out as compact 4-byte events.
+
+	Of SysEx only the MIDI Tuning Standard is read: single note tuning changes (real-time,
+	and with a bank), the bulk dump and the 1-byte scale/octave tuning, whatever device
+	ID. Each note or pitch class comes out as a MIDI_TUNING_NOTE or MIDI_TUNING_SCALE event
+	as soon as its bytes are in, so the dump's checksum is not checked; the last of the
+	three frequency bytes is dropped, which leaves 1/128 semitone. Every other SysEx and
+	system common message is skipped.
+
+	A framer follows only where messages end, for an RX interrupt to wake the parsing task
+	once per message instead of once per byte: midi_framer_feed() is true for a byte that
+	may complete one, the last data byte of a channel message, a realtime byte, the end of
+	a SysEx or a single-byte system common message. Apart from the tuning events inside a
+	SysEx, which wait for its F7, it never misses an end the parser would see; it may see
+	one the parser then drops. A long SysEx also needs waking on the ring's fill level.
+	After an end, midi_framer_note_on() tells whether it was a Note On with a velocity and
+	gives it as the parser would, for an interrupt to start the note itself.
+
+*************************************************************************************************/
+
+#ifndef MIDI_PARSER_H_INCLUDED
+#define MIDI_PARSER_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+//event status, channel messages carry the upper nibble only
+#define MIDI_NOTE_OFF			(	0x80	)
+#define MIDI_NOTE_ON			(	0x90	)
+#define MIDI_POLY_PRESSURE		(	0xA0	)
+#define MIDI_CONTROL_CHANGE		(	0xB0	)
+#define MIDI_PROGRAM_CHANGE		(	0xC0	)
+#define MIDI_CHANNEL_PRESSURE	(	0xD0	)
+#define MIDI_PITCH_BEND			(	0xE0	)
+#define MIDI_SYSEX_START		(	0xF0	)
+#define MIDI_SYSEX_END			(	0xF7	)
+#define MIDI_TUNING_NOTE		(	0xF4	)	//parsed MTS, never sent: see below
+#define MIDI_TUNING_SCALE		(	0xF5	)
+#define MIDI_CLOCK				(	0xF8	)
+#define MIDI_START				(	0xFA	)
+#define MIDI_CONTINUE			(	0xFB	)
+#define MIDI_STOP				(	0xFC	)
+#define MIDI_ACTIVE_SENSING		(	0xFE	)
+#define MIDI_RESET				(	0xFF	)
+
+#define MIDI_PITCH_BEND_CENTER	(	8192	)
+#define MIDI_TUNING_RESET		(	0x7F	)
+
+/********   TYPE DEFS  **********/
+//a MIDI_TUNING_NOTE event has the key in 'channel', the semitone it plays in data1 and the
+//fraction in 1/128 in data2; MIDI_TUNING_SCALE has the pitch class 0..11 in 'channel' and
+//its offset in cents plus 64 in data1, a pitch class of MIDI_TUNING_RESET goes back to
+//equal temperament
+struct midi_event{
+	uint8_t status;
+	uint8_t channel;
+	uint8_t data1;
+	uint8_t data2;
+};
+
+struct midi_framer{
+	uint8_t running_status;
+	uint8_t count;
+	uint8_t data1;				//first data byte of the message in progress
+};
+
+struct midi_parser{
+	uint8_t running_status;
+	uint8_t data[2];
+	uint8_t count;
+	bool in_sysex;
+	uint16_t sysex_index;		//bytes since F0
+	uint8_t sysex_type;			//MTS sub-ID, 0 for a SysEx being skipped
+	uint8_t sysex_data[4];
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void midi_parser_init( struct midi_parser *parser );
+bool midi_parser_feed( struct midi_parser *parser, uint8_t byte, struct midi_event *event );
+void midi_framer_init( struct midi_framer *framer );
+bool midi_framer_feed( struct midi_framer *framer, uint8_t byte );
+bool midi_framer_note_on( const struct midi_framer *framer, uint8_t byte, struct midi_event *event );
+
+//signed pitch bend amount, -8192..8191
+static inline int16_t midi_event_bend( const struct midi_event *event )
+{
+	return (int16_t) ((((int16_t) event->data2 << 7) | event->data1) - MIDI_PITCH_BEND_CENTER);
+}
+
+#endif /* MIDI_PARSER_H_INCLUDED */
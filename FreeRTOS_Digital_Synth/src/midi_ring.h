@@ -0,0 +1,152 @@
+/*************************************************************************************************
+                                         --MIDI RING--
+
+	Lock-free single-producer/single-consumer byte ring. The producer (RX interrupt) only
+	writes head, the consumer (MIDI parser) only writes tail, so neither side needs a
+	critical section. Size must be a power of two. Every byte carries the time it was
+	received, in whatever unit the producer uses.
+
+	A UART producer also reports its line errors, by kind, with the head at the time. The
+	bytes around a framing or overflow error are suspect, so once the consumer has popped
+	everything before it, midi_ring_resync() is true once and the parser starts over from
+	the next status byte, rather than completing a message out of the wreckage.
+
+*************************************************************************************************/
+
+#ifndef MIDI_RING_H_INCLUDED
+#define MIDI_RING_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#ifndef MIDI_RING_SIZE
+#  define MIDI_RING_SIZE		(	64	)
+#endif
+
+#define MIDI_RING_MASK			(	MIDI_RING_SIZE - 1	)
+
+#if (MIDI_RING_SIZE & MIDI_RING_MASK)
+#  error "MIDI_RING_SIZE must be a power of two"
+#endif
+
+//keeps the compiler from moving data accesses across the index update
+#define midi_ring_barrier()		__asm volatile ("" ::: "memory")
+
+/********   TYPE DEFS  **********/
+enum midi_line_error{
+	MIDI_LINE_FRAMING,
+	MIDI_LINE_OVERFLOW,			//the USART's receive buffer, a byte was lost before the ring
+	MIDI_LINE_PARITY,
+	MIDI_LINE_ERRORS
+};
+
+struct midi_ring{
+	volatile uint16_t head;
+	volatile uint16_t tail;
+	volatile uint16_t dropped;
+	volatile uint16_t peak;
+	volatile uint16_t errors[MIDI_LINE_ERRORS];
+	volatile uint16_t error_head;	//head at the last error
+	uint16_t errors_seen;			//consumer side, the errors it has resynced on
+	uint8_t data[MIDI_RING_SIZE];
+	uint32_t time[MIDI_RING_SIZE];
+};
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline void midi_ring_init( struct midi_ring *ring )
+{
+	ring->head = 0;
+	ring->tail = 0;
+	ring->dropped = 0;
+	ring->peak = 0;
+	ring->errors[MIDI_LINE_FRAMING] = 0;
+	ring->errors[MIDI_LINE_OVERFLOW] = 0;
+	ring->errors[MIDI_LINE_PARITY] = 0;
+	ring->error_head = 0;
+	ring->errors_seen = 0;
+}
+
+static inline bool midi_ring_push( struct midi_ring *ring, uint8_t byte, uint32_t time )
+{
+	//producer side, safe to call from an ISR
+	uint16_t head = ring->head;
+
+	if((uint16_t) (head - ring->tail) >= MIDI_RING_SIZE)
+	{
+		ring->dropped++;
+		return false;
+	}
+
+	ring->data[head & MIDI_RING_MASK] = byte;
+	ring->time[head & MIDI_RING_MASK] = time;
+	midi_ring_barrier();
+	ring->head = head + 1;
+
+	//high-water mark, for sizing the ring
+	if((uint16_t) (head + 1 - ring->tail) > ring->peak) ring->peak = (uint16_t) (head + 1 - ring->tail);
+
+	return true;
+}
+
+static inline bool midi_ring_pop( struct midi_ring *ring, uint8_t *byte, uint32_t *time )
+{
+	//consumer side
+	uint16_t tail = ring->tail;
+
+	if(tail == ring->head) return false;
+
+	*byte = ring->data[tail & MIDI_RING_MASK];
+	*time = ring->time[tail & MIDI_RING_MASK];
+	midi_ring_barrier();
+	ring->tail = tail + 1;
+
+	return true;
+}
+
+static inline void midi_ring_error( struct midi_ring *ring, enum midi_line_error kind )
+{
+	//producer side, the error came after every byte pushed so far
+	ring->error_head = ring->head;
+	midi_ring_barrier();
+	ring->errors[kind]++;
+}
+
+static inline uint16_t midi_ring_errors( const struct midi_ring *ring )
+{
+	return (uint16_t) (ring->errors[MIDI_LINE_FRAMING] + ring->errors[MIDI_LINE_OVERFLOW] + ring->errors[MIDI_LINE_PARITY]);
+}
+
+static inline bool midi_ring_resync( struct midi_ring *ring )
+{
+	//consumer side, before each pop: true once per run of errors, when the next byte is the
+	//first after them
+	uint16_t errors = midi_ring_errors(ring);
+
+	if(errors == ring->errors_seen) return false;
+
+	midi_ring_barrier();
+	if((int16_t) (ring->tail - ring->error_head) < 0) return false;
+
+	ring->errors_seen = errors;
+	return true;
+}
+
+static inline bool midi_ring_peek_time( const struct midi_ring *ring, uint32_t *time )
+{
+	//consumer side, the time of the byte midi_ring_pop() would return next
+	uint16_t tail = ring->tail;
+
+	if(tail == ring->head) return false;
+
+	midi_ring_barrier();
+	*time = ring->time[tail & MIDI_RING_MASK];
+	return true;
+}
+
+static inline uint16_t midi_ring_count( const struct midi_ring *ring )
+{
+	return (uint16_t) (ring->head - ring->tail);
+}
+
+#endif /* MIDI_RING_H_INCLUDED */
@@ -0,0 +1,111 @@
+/*************************************************************************************************
+                                         --MIDI RX DMA--
+
+	The channel has a single descriptor linked to itself, so the DMAC goes round the buffer
+	for as long as it runs and never raises an interrupt. It is at the highest level: it
+	moves one byte per trigger and the SERCOM only holds two, 170 us at 115200 baud.
+
+	Line errors do not stop the DMA, it reads DATA all the same, so they are picked up from
+	the USART's status on the next drain instead of from an error interrupt.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "midi_rx_dma.h"
+#include "midi_uart.h"
+#include "dac_dma.h"
+
+#if SYNTH_MIDI_RX_DMA
+
+/**********  DEFINE  ************/
+#define MIDI_RX_DMA_MASK		(	SYNTH_MIDI_RX_DMA_SIZE - 1	)
+
+#if (SYNTH_MIDI_RX_DMA_SIZE & MIDI_RX_DMA_MASK) || (SYNTH_MIDI_RX_DMA_SIZE > 1024)
+#  error "SYNTH_MIDI_RX_DMA_SIZE must be a power of two of at most 1024"
+#endif
+
+#define MIDI_RX_DMA_ERRORS		(	SERCOM_USART_STATUS_FERR | SERCOM_USART_STATUS_BUFOVF | SERCOM_USART_STATUS_PERR	)
+
+
+/*******   GLOBAL VARS  *********/
+static SercomUsart *midi_rx_hw;
+static volatile uint8_t midi_rx_buffer[SYNTH_MIDI_RX_DMA_SIZE];
+static uint16_t midi_rx_tail;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void midi_rx_dma_init( struct usart_module *usart, usart_callback_t start_callback )
+{
+	//starts the circular transfer from the enabled USART and registers the wake-up callback
+	DmacDescriptor *desc = dac_dma_base_descriptor(MIDI_DMA_RX_CHANNEL);
+	int i;
+
+	midi_rx_hw = &usart->hw->USART;
+	for(i=0; i<SYNTH_MIDI_RX_DMA_SIZE; i++) midi_rx_buffer[i] = MIDI_RX_DMA_EMPTY;
+	midi_rx_tail = 0;
+
+	dac_dma_controller_init();
+	DMAC->CHID.reg = DMAC_CHID_ID(MIDI_DMA_RX_CHANNEL);
+	DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+	DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(3) | DMAC_CHCTRLB_TRIGSRC(SERCOM1_DMAC_ID_RX) | DMAC_CHCTRLB_TRIGACT_BEAT;
+
+	//the destination is the end address where the descriptor increments
+	desc->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_DSTINC | DMAC_BTCTRL_BLOCKACT_NOACT;
+	desc->BTCNT.reg = SYNTH_MIDI_RX_DMA_SIZE;
+	desc->SRCADDR.reg = (uint32_t) &midi_rx_hw->DATA.reg;
+	desc->DSTADDR.reg = (uint32_t) midi_rx_buffer + SYNTH_MIDI_RX_DMA_SIZE;
+	desc->DESCADDR.reg = (uint32_t) desc;
+
+	usart_register_callback(usart, start_callback, USART_CALLBACK_START_RECEIVED);
+	usart_enable_callback(usart, USART_CALLBACK_START_RECEIVED);
+	midi_rx_hw->INTFLAG.reg = SERCOM_USART_INTFLAG_RXS;
+
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+	midi_rx_dma_arm();
+}
+
+void midi_rx_dma_clear_start( void )
+{
+	midi_rx_hw->INTFLAG.reg = SERCOM_USART_INTFLAG_RXS;
+}
+
+void midi_rx_dma_arm( void )
+{
+	//the ASF handler disables the interrupt again when it calls the start callback
+	midi_rx_hw->INTENSET.reg = SERCOM_USART_INTFLAG_RXS;
+}
+
+uint16_t midi_rx_dma_drain( struct midi_ring *ring, uint32_t time )
+{
+	//moves what the DMA has written since the last drain into the ring, returns the count
+	uint16_t count = 0;
+	uint8_t byte;
+
+	while((byte = midi_rx_buffer[midi_rx_tail]) != MIDI_RX_DMA_EMPTY)
+	{
+		midi_rx_buffer[midi_rx_tail] = MIDI_RX_DMA_EMPTY;
+		midi_rx_tail = (midi_rx_tail + 1) & MIDI_RX_DMA_MASK;
+		midi_ring_push(ring, byte, time);
+
+		//a buffer written full round since the last drain would otherwise never end
+		if(++count == SYNTH_MIDI_RX_DMA_SIZE) break;
+	}
+
+	return count;
+}
+
+bool midi_rx_dma_line_error( struct midi_ring *ring )
+{
+	//true once per run of framing, parity or overflow errors; each kind seen counts once in
+	//the ring, and the flags are cleared
+	uint16_t status = midi_rx_hw->STATUS.reg & MIDI_RX_DMA_ERRORS;
+
+	if(status == 0) return false;
+
+	midi_rx_hw->STATUS.reg = status;
+	midi_uart_status_errors(ring, status);
+	return true;
+}
+
+#endif /* SYNTH_MIDI_RX_DMA */
@@ -0,0 +1,49 @@
+/*************************************************************************************************
+                                         --MIDI RX DMA--
+
+	MIDI input without an interrupt per byte. A DMA channel copies every byte the MIDI
+	USART receives into a circular buffer of SYNTH_MIDI_RX_DMA_SIZE, and the MIDI task moves
+	them on into the MIDI ring with midi_rx_dma_drain(), stamped with the time of the drain.
+
+	The USART's start-of-frame interrupt wakes the task for the first byte of a burst. From
+	then on the task polls: midi_rx_dma_clear_start(), a sleep of MIDI_RX_DMA_POLL_TICKS,
+	a drain, until a poll finds the line was idle, and only then midi_rx_dma_arm() enables
+	the interrupt again. A byte whose start bit comes after the clear raises it as soon as
+	it is armed, one that started before has been received by the drain, so none is left
+	waiting for the next burst. That makes one interrupt per burst, none while a stream is
+	continuous.
+
+	The price is timing: the bytes of a poll share its time, up to two ticks after they
+	arrived, where the interrupt path stamps each byte as it comes in. SYNTH_MIDI_RX_DMA 0
+	keeps that path.
+
+	The DMA never stops, so the buffer has no indices to compare. The drain instead turns
+	every byte it takes into MIDI_RX_DMA_EMPTY, 0xFD, which MIDI leaves undefined, and reads
+	until it finds one; a 0xFD on the wire is dropped with it.
+
+	Line errors are read from the USART's STATUS after a drain, so the parser resyncs after
+	the bytes of that poll rather than at the byte that had the error.
+
+*************************************************************************************************/
+
+#ifndef MIDI_RX_DMA_H_INCLUDED
+#define MIDI_RX_DMA_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "midi_ring.h"
+
+/**********  DEFINE  ************/
+#define MIDI_RX_DMA_EMPTY			(	0xFD	)
+
+//a whole tick at least, longer than a byte at any MIDI baud rate
+#define MIDI_RX_DMA_POLL_TICKS		(	2	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void midi_rx_dma_init( struct usart_module *usart, usart_callback_t start_callback );
+void midi_rx_dma_clear_start( void );
+void midi_rx_dma_arm( void );
+uint16_t midi_rx_dma_drain( struct midi_ring *ring, uint32_t time );
+bool midi_rx_dma_line_error( struct midi_ring *ring );
+
+#endif /* MIDI_RX_DMA_H_INCLUDED */
@@ -0,0 +1,107 @@
+/*************************************************************************************************
+                                          --MIDI UART--
+
+	The ASF callback driver reads one byte per job: the RX complete callback pushes it and
+	starts the next job at once, well inside a byte time at 31250 baud, and still inside the
+	40 us of one at the voice link's 250000. An error ends the
+	job as well, so the error callback only counts it and starts another.
+
+	The DIN input's opto-isolator only pulls the line low, the pin's pull-up holds it at
+	idle with nothing plugged in.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "midi_uart.h"
+
+#if SYNTH_MIDI_UART_INPUTS || (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+
+/****** FUNCTION PROTOTYPES  ****/
+static void midi_uart_read_callback( struct usart_module *const usart_module );
+static void midi_uart_error_callback( struct usart_module *const usart_module );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void midi_uart_init( struct midi_uart *port, Sercom *sercom, enum usart_signal_mux_settings mux,
+	uint32_t rx_pinmux, uint32_t baud, struct midi_ring *ring, uint32_t (*now)( void ),
+	void (*wake)( void ) )
+{
+	struct usart_config config_usart;
+	struct system_pinmux_config config_mux;
+
+	port->ring = ring;
+	port->now = now;
+	port->wake = wake;
+
+	usart_get_config_defaults(&config_usart);
+	config_usart.baudrate = baud;
+	config_usart.mux_setting = mux;
+	config_usart.pinmux_pad0 = PINMUX_UNUSED;
+	config_usart.pinmux_pad1 = PINMUX_UNUSED;
+	config_usart.pinmux_pad2 = PINMUX_UNUSED;
+	config_usart.pinmux_pad3 = PINMUX_UNUSED;
+	config_usart.transmitter_enable = false;
+	config_usart.generator_source = GCLK_GENERATOR_2;
+	while (usart_init(&port->usart, sercom, &config_usart) != STATUS_OK) {
+	}
+
+	//RX pad by hand, with its pull-up; a PINMUX_ value is the pin above the mux position
+	system_pinmux_get_config_defaults(&config_mux);
+	config_mux.mux_position = rx_pinmux & 0xFFFF;
+	config_mux.input_pull = SYSTEM_PINMUX_PIN_PULL_UP;
+	system_pinmux_pin_set_config(rx_pinmux >> 16, &config_mux);
+
+	usart_register_callback(&port->usart, midi_uart_read_callback, USART_CALLBACK_BUFFER_RECEIVED);
+	usart_enable_callback(&port->usart, USART_CALLBACK_BUFFER_RECEIVED);
+	usart_register_callback(&port->usart, midi_uart_error_callback, USART_CALLBACK_ERROR);
+	usart_enable_callback(&port->usart, USART_CALLBACK_ERROR);
+	usart_enable(&port->usart);
+
+	usart_read_job(&port->usart, &port->byte);
+}
+
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+void midi_uart_enable_tx( struct midi_uart *port, uint32_t tx_pinmux )
+{
+	//TXEN is not enable-protected, the running receiver carries on
+	SercomUsart *const usart = &port->usart.hw->USART;
+	struct system_pinmux_config config_mux;
+
+	system_pinmux_get_config_defaults(&config_mux);
+	config_mux.mux_position = tx_pinmux & 0xFFFF;
+	config_mux.direction = SYSTEM_PINMUX_PIN_DIR_OUTPUT;
+	system_pinmux_pin_set_config(tx_pinmux >> 16, &config_mux);
+
+	usart->CTRLB.reg |= SERCOM_USART_CTRLB_TXEN;
+	while(usart->SYNCBUSY.reg);
+	port->usart.transmitter_enabled = true;
+}
+
+bool midi_uart_write( struct midi_uart *port, const uint8_t *bytes, int length )
+{
+	//sent from the interrupt, 'bytes' must stay as they are until then; false while the last
+	//write is still going out
+	return usart_write_buffer_job(&port->usart, (uint8_t *) bytes, (uint16_t) length) == STATUS_OK;
+}
+#endif
+
+
+/*****  INTERRUPT HANDLERS  *****/
+static void midi_uart_read_callback( struct usart_module *const usart_module )
+{
+	struct midi_uart *port = (struct midi_uart *) usart_module;
+
+	midi_ring_push(port->ring, (uint8_t) port->byte, port->now());
+	usart_read_job(usart_module, &port->byte);
+	port->wake();
+}
+
+static void midi_uart_error_callback( struct usart_module *const usart_module )
+{
+	struct midi_uart *port = (struct midi_uart *) usart_module;
+
+	midi_ring_error(port->ring, midi_uart_line_error(usart_module));
+	usart_read_job(usart_module, &port->byte);
+}
+
+#endif /* SYNTH_MIDI_UART_INPUTS || SYNTH_VOICE_LINK_EXPANDER */
@@ -0,0 +1,60 @@
+/*************************************************************************************************
+                                          --MIDI UART--
+
+	A receive-only MIDI input on a SERCOM of its own, for DIN ports next to the main one on
+	SERCOM1. Each received byte goes into the MIDI ring handed to midi_uart_init(), stamped
+	with the clock it was given, and the wake function runs once per byte from the SERCOM
+	interrupt; a line error goes to the ring as well. Every input keeps its own ring, and the MIDI task its own parser for it, so
+	running status from a keyboard never completes a message from a sequencer; the task
+	merges the rings in time order.
+
+	The RX pins are EXT2 pin 8 (PB13, SERCOM4, the board's EXT2 UART RX) and EXT1 pin 11 (PA08,
+	SERCOM2, its I2C SDA). The transmitter stays off, its pad is left free. A voice card takes
+	the voice link through one as well, on SERCOM4 at the link's rate, see voice_link.h, and
+	turns the transmitter on with midi_uart_enable_tx() to answer the master's polls on PB12.
+
+*************************************************************************************************/
+
+#ifndef MIDI_UART_H_INCLUDED
+#define MIDI_UART_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "midi_ring.h"
+
+/********   TYPE DEFS  **********/
+struct midi_uart{
+	struct usart_module usart;		//first, the ASF callbacks hand back its address
+	struct midi_ring *ring;
+	uint32_t (*now)( void );
+	void (*wake)( void );
+	uint16_t byte;
+};
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline enum midi_line_error midi_uart_line_error( const struct usart_module *usart )
+{
+	//from an ASF error callback, the kind the driver found and cleared
+	if(usart->rx_status == STATUS_ERR_OVERFLOW) return MIDI_LINE_OVERFLOW;
+	if(usart->rx_status == STATUS_ERR_BAD_DATA) return MIDI_LINE_PARITY;
+	return MIDI_LINE_FRAMING;
+}
+
+static inline void midi_uart_status_errors( struct midi_ring *ring, uint16_t status )
+{
+	//from the USART's STATUS flags, for a path that reads them itself; each kind counts once
+	if(status & SERCOM_USART_STATUS_FERR) midi_ring_error(ring, MIDI_LINE_FRAMING);
+	if(status & SERCOM_USART_STATUS_BUFOVF) midi_ring_error(ring, MIDI_LINE_OVERFLOW);
+	if(status & SERCOM_USART_STATUS_PERR) midi_ring_error(ring, MIDI_LINE_PARITY);
+}
+
+/****** FUNCTION PROTOTYPES  ****/
+void midi_uart_init( struct midi_uart *port, Sercom *sercom, enum usart_signal_mux_settings mux,
+	uint32_t rx_pinmux, uint32_t baud, struct midi_ring *ring, uint32_t (*now)( void ),
+	void (*wake)( void ) );
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_EXPANDER)
+void midi_uart_enable_tx( struct midi_uart *port, uint32_t tx_pinmux );
+bool midi_uart_write( struct midi_uart *port, const uint8_t *bytes, int length );
+#endif
+
+#endif /* MIDI_UART_H_INCLUDED */
@@ -0,0 +1,223 @@
+/*************************************************************************************************
+                                        --MODULATION--
+
+	The LFOs advance once per control tick, their phase increment is derived from the rate
+	whenever the rate or the sample rate changes. Shapes are computed from the phase, the
+	sine is read from the oscillators' quarter-wave table. The pitch and cutoff offsets are
+	in 1/256 semitone, the engine turns them into ratios with curve_exp2() (curves.h).
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "modulation.h"
+#include "wavetables.h"
+#include "midi_clock.h"
+
+
+/*******   GLOBAL VARS  *********/
+static uint32_t lfo_phase[SYNTH_LFO_COUNT];
+static uint32_t lfo_inc[SYNTH_LFO_COUNT];
+static uint32_t lfo_rate_chz[SYNTH_LFO_COUNT];
+static uint8_t lfo_shape[SYNTH_LFO_COUNT];
+static int32_t lfo_value[SYNTH_LFO_COUNT];
+static uint8_t lfo_sync[SYNTH_LFO_COUNT];		//clocks per cycle, 0 runs free
+
+//Q8 samples per MIDI clock, 0 while no tempo is known
+static uint32_t clock_period;
+
+static struct mod_route routes[SYNTH_MOD_ROUTES];
+
+//cutoff offset from the LFO and pressure routes, refreshed by mod_tick()
+static int32_t cutoff_offset;
+static int32_t cutoff_pressure;
+
+static uint32_t mod_sample_rate;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int32_t lfo_eval( uint8_t shape, uint32_t phase );
+static void lfo_derive( int lfo );
+static int32_t mod_clamp( int32_t x, int32_t lo, int32_t hi );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void mod_init( uint32_t sample_rate )
+{
+	int i;
+
+	mod_sample_rate = sample_rate;
+	clock_period = 0;
+
+	for(i=0; i<SYNTH_LFO_COUNT; i++)
+	{
+		lfo_phase[i] = 0;
+		lfo_value[i] = 0;
+		lfo_sync[i] = 0;
+		mod_set_lfo(i, LFO_SINE, SYNTH_LFO_RATE_CHZ);
+	}
+
+	for(i=0; i<SYNTH_MOD_ROUTES; i++) mod_set_route(i, MOD_SRC_LFO1, MOD_DST_NONE, 0);
+
+	cutoff_offset = 0;
+	cutoff_pressure = 0;
+}
+
+void mod_set_rate( uint32_t sample_rate )
+{
+	//keeps every LFO at its rate in Hz
+	int i;
+
+	mod_sample_rate = sample_rate;
+
+	for(i=0; i<SYNTH_LFO_COUNT; i++) mod_set_lfo(i, (enum lfo_shape) lfo_shape[i], lfo_rate_chz[i]);
+}
+
+void mod_set_lfo( int lfo, enum lfo_shape shape, uint32_t rate_chz )
+{
+	//rate in 1/100 Hz, the increment is per control tick
+	if((lfo < 0) || (lfo >= SYNTH_LFO_COUNT) || (shape >= LFO_SHAPE_COUNT)) return;
+
+	lfo_shape[lfo] = (uint8_t) shape;
+	lfo_rate_chz[lfo] = rate_chz;
+	lfo_derive(lfo);
+}
+
+void mod_set_lfo_sync( int lfo, uint8_t clocks )
+{
+	//0 goes back to the LFO's rate in Hz; without a clock period it keeps that rate meanwhile
+	if((lfo < 0) || (lfo >= SYNTH_LFO_COUNT)) return;
+
+	lfo_sync[lfo] = clocks;
+	lfo_derive(lfo);
+}
+
+void mod_set_clock( uint32_t period )
+{
+	//Q8 samples per clock, only the locked LFOs are re-derived
+	int i;
+
+	clock_period = period;
+	for(i=0; i<SYNTH_LFO_COUNT; i++) if(lfo_sync[i]) lfo_derive(i);
+}
+
+void mod_restart_synced( void )
+{
+	int i;
+
+	for(i=0; i<SYNTH_LFO_COUNT; i++) if(lfo_sync[i]) lfo_phase[i] = 0;
+}
+
+static void lfo_derive( int lfo )
+{
+	//increment per control tick, from the clock period when locked to it
+	if(lfo_sync[lfo] && clock_period)
+	{
+		lfo_inc[lfo] = (uint32_t) (((uint64_t) SYNTH_CONTROL_PERIOD << (32 + MIDI_CLOCK_FRAC_BITS)) / ((uint64_t) lfo_sync[lfo] * clock_period));
+	}
+	else
+	{
+		lfo_inc[lfo] = (uint32_t) ((((uint64_t) lfo_rate_chz[lfo] << 32) * SYNTH_CONTROL_PERIOD) / (100ull * mod_sample_rate));
+	}
+}
+
+void mod_set_route( int slot, enum mod_source source, enum mod_dest dest, int16_t depth )
+{
+	//MOD_DST_NONE or a zero depth frees the slot, LFOs beyond SYNTH_LFO_COUNT are refused
+	if((slot < 0) || (slot >= SYNTH_MOD_ROUTES) || (dest >= MOD_DST_COUNT)) return;
+	if((source < MOD_SRC_ENVELOPE) && (source >= SYNTH_LFO_COUNT)) return;
+	if(source >= MOD_SRC_COUNT) return;
+
+	routes[slot].source = (uint8_t) source;
+	routes[slot].dest = (depth == 0) ? MOD_DST_NONE : (uint8_t) dest;
+	routes[slot].depth = depth;
+}
+
+void mod_set_pressure( int32_t pressure )
+{
+	//Q15 below full like the per-voice source, for the cutoff routes
+	cutoff_pressure = pressure;
+}
+
+void mod_tick( void )
+{
+	//advances the LFOs and sums the cutoff routes, which only the LFOs and pressure can reach
+	int i;
+	int32_t sum = 0;
+
+	for(i=0; i<SYNTH_LFO_COUNT; i++)
+	{
+		lfo_phase[i] += lfo_inc[i];
+		lfo_value[i] = lfo_eval(lfo_shape[i], lfo_phase[i]);
+	}
+
+	for(i=0; i<SYNTH_MOD_ROUTES; i++)
+	{
+		if(routes[i].dest != MOD_DST_CUTOFF) continue;
+
+		if(routes[i].source < SYNTH_LFO_COUNT) sum += (lfo_value[routes[i].source] * routes[i].depth) >> MOD_SHIFT;
+		else if(routes[i].source == MOD_SRC_PRESSURE) sum += (cutoff_pressure * routes[i].depth) >> MOD_SHIFT;
+	}
+
+	cutoff_offset = sum;
+}
+
+void mod_voice_eval( const struct mod_input *in, struct mod_voice *out )
+{
+	//one pass over the route table, neutral values when no route is set
+	int i;
+	int32_t src;
+	int32_t acc[MOD_DST_COUNT] = { 0 };
+
+	for(i=0; i<SYNTH_MOD_ROUTES; i++)
+	{
+		if((routes[i].dest == MOD_DST_NONE) || (routes[i].dest == MOD_DST_CUTOFF)) continue;
+
+		if(routes[i].source == MOD_SRC_ENVELOPE) src = in->envelope;
+		else if(routes[i].source == MOD_SRC_VELOCITY) src = in->velocity;
+		else if(routes[i].source == MOD_SRC_PRESSURE) src = in->pressure;
+		else if(routes[i].source == MOD_SRC_TIMBRE) src = in->timbre;
+		else src = lfo_value[routes[i].source];
+
+		acc[routes[i].dest] += (src * routes[i].depth) >> MOD_SHIFT;
+	}
+
+	out->pitch = acc[MOD_DST_PITCH];
+	//amplitude can only be cut, full scale is the velocity curve's
+	out->amp = mod_clamp(MOD_UNITY + acc[MOD_DST_AMP], 0, MOD_UNITY);
+	out->pulse_width = mod_clamp(acc[MOD_DST_PULSE_WIDTH], -MOD_PW_LIMIT, MOD_PW_LIMIT);
+}
+
+int32_t mod_cutoff( void )
+{
+	return cutoff_offset;
+}
+
+static int32_t lfo_eval( uint8_t shape, uint32_t phase )
+{
+	//bipolar Q15, every shape starts at zero or its top and rises first
+	int32_t x = (int16_t) (phase >> 16);
+
+	switch(shape)
+	{
+		case LFO_TRIANGLE:
+		//folds the sine's argument, peaks at a quarter cycle
+		return mod_clamp((x < -16384) ? (-32768 - x) * 2 : ((x > 16383) ? (32767 - x) * 2 : x * 2), -32767, 32767);
+
+		case LFO_SAW:
+		return (int32_t) (phase >> 16) - 32768;
+
+		case LFO_SQUARE:
+		return (phase < 0x80000000ul) ? 32767 : -32767;
+
+		default:
+		//table peak 2047 scaled to Q15
+		return sine_lookup(phase) << 4;
+	}
+}
+
+static int32_t mod_clamp( int32_t x, int32_t lo, int32_t hi )
+{
+	if(x < lo) return lo;
+	if(x > hi) return hi;
+	return x;
+}
@@ -0,0 +1,108 @@
+/*************************************************************************************************
+                                        --MODULATION--
+
+	LFOs and a modulation matrix evaluated at control rate. A route adds source * depth to
+	one destination. The sources are the SYNTH_LFO_COUNT free running LFOs, the voice's
+	envelope level, its velocity, pressure and timbre; the destinations are pitch,
+	amplitude, pulse width and the master filter cutoff. Every route lives in one table of SYNTH_MOD_ROUTES slots that
+	is walked once per voice per control tick, so the per-sample loops only see the results:
+	the amplitude joins the envelope gain ramp, pitch and pulse width step once per tick.
+
+	The filter is one filter on the master mix, so only the LFOs and the latest pressure
+	message of any channel, handed over with mod_set_pressure(), can reach its cutoff;
+	routes from the other per-voice sources to MOD_DST_CUTOFF are skipped. Pulse width applies to both square
+	waveforms.
+
+	An LFO may lock to the MIDI clock instead, one cycle per so many clocks: its increment
+	is re-derived whenever the engine hands over a new clock period, and MIDI Start puts
+	the locked LFOs back to the start of their cycle.
+
+	Pressure counts down from full: 0 with the key pressed all the way, -1 with no pressure,
+	so a positive depth on the amplitude, which can only be cut, swells the note as it is
+	pressed, and a voice that never gets pressure is left alone. Timbre is bipolar around
+	its middle, 64.
+
+*************************************************************************************************/
+
+#ifndef MODULATION_H_INCLUDED
+#define MODULATION_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//sources and the amplitude factor are Q15
+#define MOD_SHIFT				(	15	)
+#define MOD_UNITY				(	1l << MOD_SHIFT	)
+
+//pulse width stays between 5% and 95% duty
+#define MOD_PW_LIMIT			(	29491	)
+
+/********   TYPE DEFS  **********/
+enum lfo_shape{
+	LFO_SINE,
+	LFO_TRIANGLE,
+	LFO_SAW,
+	LFO_SQUARE,
+	LFO_SHAPE_COUNT
+};
+
+//LFOs first, so MOD_SRC_LFO1 + n is LFO n
+enum mod_source{
+	MOD_SRC_LFO1,
+	MOD_SRC_LFO2,
+	MOD_SRC_LFO3,
+	MOD_SRC_LFO4,
+	MOD_SRC_ENVELOPE,
+	MOD_SRC_VELOCITY,
+	MOD_SRC_PRESSURE,
+	MOD_SRC_TIMBRE,
+	MOD_SRC_COUNT
+};
+
+//depth units: pitch and cutoff 1/256 semitone, amplitude and pulse width Q15 of full scale
+enum mod_dest{
+	MOD_DST_NONE,
+	MOD_DST_PITCH,
+	MOD_DST_AMP,
+	MOD_DST_PULSE_WIDTH,
+	MOD_DST_CUTOFF,
+	MOD_DST_COUNT
+};
+
+struct mod_route{
+	uint8_t source;
+	uint8_t dest;
+	int16_t depth;
+};
+
+//one voice's per-voice sources, Q15
+struct mod_input{
+	int32_t envelope;
+	int32_t velocity;
+	int32_t pressure;
+	int32_t timbre;
+};
+
+//one voice's destination values for the next control tick
+struct mod_voice{
+	int32_t pitch;
+	int32_t amp;
+	int32_t pulse_width;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void mod_init( uint32_t sample_rate );
+void mod_set_rate( uint32_t sample_rate );
+void mod_set_lfo( int lfo, enum lfo_shape shape, uint32_t rate_chz );
+void mod_set_lfo_sync( int lfo, uint8_t clocks );
+void mod_set_clock( uint32_t period );
+void mod_restart_synced( void );
+void mod_set_route( int slot, enum mod_source source, enum mod_dest dest, int16_t depth );
+void mod_set_pressure( int32_t pressure );
+void mod_tick( void );
+void mod_voice_eval( const struct mod_input *in, struct mod_voice *out );
+int32_t mod_cutoff( void );
+
+#endif /* MODULATION_H_INCLUDED */
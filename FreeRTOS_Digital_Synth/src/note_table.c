@@ -0,0 +1,171 @@
+/*************************************************************************************************
+                                         --NOTE TABLE--
+
+	Phase increment per sample for every MIDI note. Flash only holds the twelve frequencies
+	of the top octave, 440 * 2^((n-69)/12) Hz in 1/256 mHz. note_table_set_rate() derives the
+	increments in RAM for the sample rate in use: one 64-bit division per seed, which gives
+	its increment with NOTE_INC_EXTRA bits to spare, and a rounded shift per octave below
+	it. The M0+ divides in software, so twelve divisions instead of one per note is most of
+	what a rate change costs taken off, and the lowest notes come out as exact as the top.
+
+	A tuned note keeps its pitch in 1/128 semitone and its increment is the equal-tempered
+	one of the semitone below times 2^(fraction / 12), from the cubic of its series, well
+	within a hundredth of a cent; both are worked out when the tuning or the sample rate
+	changes.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "note_table.h"
+
+
+/**********  DEFINE  ************/
+//highest increment, half a cycle per sample (Nyquist)
+#define NOTE_INC_MAX		(	0x80000000ull	)
+
+//the seeded octave and the bits below the increment's LSB it is worked out with
+#define NOTE_OCTAVE			(	12	)
+#define NOTE_SEED_FIRST		(	NOTE_TABLE_SIZE - NOTE_OCTAVE	)
+#define NOTE_SEED_SHIFT		(	8	)
+#define NOTE_INC_EXTRA		(	6	)
+
+//ln(2) / 12 in Q30, a semitone's exponent
+#define NOTE_LN_SEMITONE	(	62021760ull	)
+
+
+/*******   GLOBAL VARS  *********/
+uint32_t note_phase_inc_table[NOTE_TABLE_SIZE];
+const uint32_t *note_tuned_inc = note_phase_inc_table;
+
+#if SYNTH_TUNING
+static uint32_t note_user_inc[NOTE_TABLE_SIZE];
+static uint16_t note_user_pitch[NOTE_TABLE_SIZE];
+#endif
+
+//the top octave, Ab8 .. G9, in 1/256 mHz; every lower note is one of these halved
+static const uint32_t note_seed[NOTE_OCTAVE] = {
+	1701088041u, 1802240000u, 1909406767u, 2022946002u,	//Ab8 .. B8
+	2143236631u, 2270680113u, 2405701779u, 2548752251u,	//C9 .. Eb9
+	2700308946u, 2860877672u, 3030994311u, 3211226612u	//E9 .. G9
+};
+
+
+/****** FUNCTION PROTOTYPES  ****/
+#if SYNTH_TUNING
+static uint32_t note_pitch_increment( uint16_t pitch );
+#endif
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void note_table_set_rate( uint32_t sample_rate )
+{
+	//increment = f / fs * 2^32, runs once per rate change
+	int n;
+	int k;
+	int shift;
+	uint64_t top;
+	uint64_t inc;
+
+	for(k=0; k<NOTE_OCTAVE; k++)
+	{
+		top = ((uint64_t) note_seed[k] << (32 + NOTE_INC_EXTRA - NOTE_SEED_SHIFT)) / ((uint64_t) sample_rate * 1000u);
+		for(n=NOTE_SEED_FIRST + k, shift=NOTE_INC_EXTRA; n>=0; n-=NOTE_OCTAVE, shift++)
+		{
+			inc = (top + (1ull << (shift - 1))) >> shift;
+			note_phase_inc_table[n] = (uint32_t) ((inc > NOTE_INC_MAX) ? NOTE_INC_MAX : inc);
+		}
+	}
+
+#if SYNTH_TUNING
+	for(n=0; n<NOTE_TABLE_SIZE; n++) note_user_inc[n] = note_pitch_increment(note_user_pitch[n]);
+#endif
+}
+
+#if SYNTH_TUNING
+static uint32_t note_pitch_increment( uint16_t pitch )
+{
+	//e^x to the cubic term for x = fraction * ln(2) / 12, at most 0.058
+	uint64_t x;
+	uint64_t ratio;
+	uint64_t inc;
+
+	if(pitch > NOTE_PITCH_MAX) pitch = NOTE_PITCH_MAX;
+
+	x = (NOTE_LN_SEMITONE * (pitch & ((1u << NOTE_PITCH_SHIFT) - 1))) >> NOTE_PITCH_SHIFT;
+	ratio = (1ull << 30) + x + ((x * x) >> 31) + ((((x * x) >> 30) * x) / (6ull << 30));
+	inc = (note_phase_inc_table[pitch >> NOTE_PITCH_SHIFT] * ratio) >> 30;
+
+	return (uint32_t) ((inc > NOTE_INC_MAX) ? NOTE_INC_MAX : inc);
+}
+
+void note_tuning_set( int note_id, uint16_t pitch )
+{
+	//the note plays at 'pitch' from now on, the voices switch to the user table
+	note_id &= 0x7F;
+	note_user_pitch[note_id] = (pitch > NOTE_PITCH_MAX) ? NOTE_PITCH_MAX : pitch;
+	note_user_inc[note_id] = note_pitch_increment(note_user_pitch[note_id]);
+	note_tuned_inc = note_user_inc;
+}
+
+void note_tuning_octave( int pitch_class, int cents )
+{
+	//every note of the pitch class 'cents' off equal temperament, -64..63 as MTS allows
+	int n;
+	int32_t pitch;
+
+	if(cents < -64) cents = -64;
+	if(cents > 63) cents = 63;
+
+	for(n=pitch_class % 12; n<NOTE_TABLE_SIZE; n+=12)
+	{
+		pitch = (n << NOTE_PITCH_SHIFT) + ((cents << NOTE_PITCH_SHIFT) / 100);
+		note_tuning_set(n, (uint16_t) ((pitch < 0) ? 0 : pitch));
+	}
+}
+
+void note_tuning_reset( void )
+{
+	//equal temperament, also what a note not yet retuned keeps in the user table
+	int n;
+
+	for(n=0; n<NOTE_TABLE_SIZE; n++)
+	{
+		note_user_pitch[n] = (uint16_t) (n << NOTE_PITCH_SHIFT);
+		note_user_inc[n] = note_phase_inc_table[n];
+	}
+	note_tuned_inc = note_phase_inc_table;
+}
+#endif
+
+static uint32_t table_increment_fine( const uint32_t *table, int note_id, int fine )
+{
+	//note plus a signed offset in 1/256 semitone, linear between neighbouring table entries
+	int pitch = (note_id << 8) + fine;
+	int index;
+	uint32_t frac;
+	uint32_t lo;
+	uint32_t hi;
+
+	if(pitch <= 0) return table[0];
+	if(pitch >= ((NOTE_TABLE_SIZE - 1) << 8)) return table[NOTE_TABLE_SIZE - 1];
+
+	index = pitch >> 8;
+	frac = (uint32_t) (pitch & 0xFF);
+	lo = table[index];
+	hi = table[index + 1];
+
+	//a user table may run downwards between two keys
+	if(hi < lo) return lo - (((lo - hi) >> 8) * frac);
+	return lo + (((hi - lo) >> 8) * frac);
+}
+
+uint32_t note_phase_increment_fine( int note_id, int fine )
+{
+	return table_increment_fine(note_phase_inc_table, note_id, fine);
+}
+
+uint32_t note_tuned_increment_fine( int note_id, int fine )
+{
+	//the voices' pitch, from the tuning in use
+	return table_increment_fine(note_tuned_inc, note_id, fine);
+}
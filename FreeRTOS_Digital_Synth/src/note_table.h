@@ -0,0 +1,49 @@
+/*************************************************************************************************
+                                         --NOTE TABLE--
+
+	MIDI note to 32-bit phase increment lookup, see note_table.c. The table is empty until
+	note_table_set_rate() has run.
+
+	Voices play from note_tuned_inc, which points at the equal-tempered table or, once a
+	note has been retuned with SYNTH_TUNING, at a second table of the user's tuning, so a
+	note-on is the same single lookup either way. Bend and glide interpolate between the
+	neighbouring keys of the table in use. The filter cutoff and the sample root keys stay
+	on equal temperament.
+
+*************************************************************************************************/
+
+#ifndef NOTE_TABLE_H_INCLUDED
+#define NOTE_TABLE_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define NOTE_TABLE_SIZE		(	128	)
+
+//a tuned pitch is in 1/128 semitone above note 0, as MTS gives it
+#define NOTE_PITCH_SHIFT	(	7	)
+#define NOTE_PITCH_MAX		(	(NOTE_TABLE_SIZE << NOTE_PITCH_SHIFT) - 1	)
+
+/*******   GLOBAL VARS  *********/
+extern uint32_t note_phase_inc_table[NOTE_TABLE_SIZE];
+extern const uint32_t *note_tuned_inc;
+
+/****** FUNCTION PROTOTYPES  ****/
+void note_table_set_rate( uint32_t sample_rate );
+#if SYNTH_TUNING
+void note_tuning_set( int note_id, uint16_t pitch );
+void note_tuning_octave( int pitch_class, int cents );
+void note_tuning_reset( void );
+#endif
+
+//O(1) lookup, out-of-range note ids are masked into 0..127
+static inline uint32_t note_phase_increment( int note_id )
+{
+	return note_phase_inc_table[note_id & 0x7F];
+}
+
+uint32_t note_phase_increment_fine( int note_id, int fine );
+uint32_t note_tuned_increment_fine( int note_id, int fine );
+
+#endif /* NOTE_TABLE_H_INCLUDED */
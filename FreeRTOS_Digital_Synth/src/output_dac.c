@@ -0,0 +1,120 @@
+/*************************************************************************************************
+                                      --INTERNAL DAC OUTPUT--
+
+	The SAMD21's own 10-bit DAC on VOUT (PA02), referenced to AVCC, so full scale is the
+	3.3 V supply rather than the 2.048 V of the MCP4821. The codes lose their two low bits on
+	the way, in sample_word().
+
+	No CPU and no DMA timing in the conversion path: the sample clock overflow reaches the
+	DAC's start input through the event system and moves DATABUF into DATA, which converts
+	on the overflow itself. That empties DATABUF, and the empty trigger has the DMA put the
+	next sample there a whole sample period ahead, so however long the DMAC waits behind the
+	flash channels the sample still converts on time. A frame is one DMA block.
+
+	Mono only, there is one DAC.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "audio_output.h"
+#include "sample_clock.h"
+
+
+/**********  DEFINE  ************/
+#define DAC_WORD_BITS		(	10	)
+#define DAC_PRIME_WAIT		(	1000	) //sync polls
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void internal_dac_init( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played );
+static void internal_dac_start( uint32_t sample_rate );
+static void internal_dac_set_rate( uint32_t sample_rate );
+static uint16_t internal_dac_word( uint16_t code, int index );
+static uint16_t internal_dac_code( uint16_t word );
+static bool internal_dac_prime( uint16_t code );
+
+
+/*******   GLOBAL VARS  *********/
+static const struct dac_dma_target internal_dac_target = {
+	.data = (uint32_t) &DAC->DATABUF.reg,
+	.trigger = DAC_DMAC_ID_EMPTY,
+	.beat_size = DMAC_BTCTRL_BEATSIZE_HWORD_Val,
+	.block_per_word = false,
+	.word = internal_dac_word,
+	.code = internal_dac_code,
+};
+
+const struct audio_output audio_output_dac = {
+	.name = "internal DAC",
+	.init = internal_dac_init,
+	.start = internal_dac_start,
+	.set_rate = internal_dac_set_rate,
+	.submit = dac_dma_write_frame,
+	.conceal = dac_dma_conceal_frame,
+	.prime = internal_dac_prime,
+};
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint16_t internal_dac_word( uint16_t code, int index )
+{
+	return sample_word(code, DAC_WORD_BITS, false);
+}
+
+static uint16_t internal_dac_code( uint16_t word )
+{
+	return sample_code(word, DAC_WORD_BITS, false);
+}
+
+static void internal_dac_init( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played )
+{
+	struct system_pinmux_config pin_conf;
+	struct system_gclk_chan_config gclk_chan_conf;
+
+	system_pinmux_get_config_defaults(&pin_conf);
+	pin_conf.mux_position = MUX_PA02B_DAC_VOUT;
+	system_pinmux_pin_set_config(PIN_PA02B_DAC_VOUT, &pin_conf);
+
+	PM->APBCMASK.reg |= PM_APBCMASK_DAC;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = SYNTH_FIXED_GCLK;
+	system_gclk_chan_set_config(DAC_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(DAC_GCLK_ID);
+
+	DAC->CTRLA.reg = DAC_CTRLA_SWRST;
+	while(DAC->STATUS.reg & DAC_STATUS_SYNCBUSY);
+	DAC->CTRLB.reg = DAC_CTRLB_EOEN | DAC_CTRLB_REFSEL_AVCC;
+	DAC->EVCTRL.reg = DAC_EVCTRL_STARTEI;
+	//enabled at 0 V, where the DAC sat while off; prime ramps it up to the silent frames
+	DAC->DATA.reg = 0;
+	while(DAC->STATUS.reg & DAC_STATUS_SYNCBUSY);
+	DAC->CTRLA.reg = DAC_CTRLA_ENABLE;
+	while(DAC->STATUS.reg & DAC_STATUS_SYNCBUSY);
+
+	dac_dma_init(&internal_dac_target, frames, frame_played);
+}
+
+static bool internal_dac_prime( uint16_t code )
+{
+	//converts at once, DATA rather than the DATABUF the events move on
+	int wait;
+
+	DAC->DATA.reg = internal_dac_word(code, 0);
+	for(wait=0; (wait < DAC_PRIME_WAIT) && (DAC->STATUS.reg & DAC_STATUS_SYNCBUSY); wait++);
+
+	return (wait < DAC_PRIME_WAIT);
+}
+
+static void internal_dac_start( uint32_t sample_rate )
+{
+	//the DMA fills the empty DATABUF straight away, the first overflow converts it
+	dac_dma_start();
+	sample_clock_init(sample_rate, NULL);
+	sample_clock_route_event(EVSYS_ID_USER_DAC_START);
+	sample_clock_start();
+}
+
+static void internal_dac_set_rate( uint32_t sample_rate )
+{
+	sample_clock_set_rate(sample_rate);
+}
@@ -0,0 +1,172 @@
+/*************************************************************************************************
+                                          --I2S OUTPUT--
+
+	I2S serializer 0 as a transmitter on clock unit 0: SCK PA10, FS PA11, SD PA19, standard
+	I2S framing of two 16-bit slots. With SYNTH_I2S_MCLK the 256 fs master clock a codec
+	runs from goes out on MCK PA09 (EXT1 pin 12); a DAC like the PCM5102 that makes its own
+	does without. The engine codes go out as signed 16-bit samples, from sample_word().
+
+	The clocks come from the FDPLL locked to the 32.768 kHz crystal, run at 256 fs times the
+	power of two k that puts it in its 48..96 MHz range. GCLK generator 3 divides it by k
+	into the master clock and the I2S divides that by 8 into the serial clock, 32 bits per
+	sample. The DPLL ratio has 1/16 steps of the reference, so 256 fs * k comes out exact
+	for any even rate from k = 4 up, which covers 44.1 and 48 kHz and the console rates.
+	A rate change relocks the DPLL, the output stops for the lock time.
+
+	Stereo frames are left/right pairs, which is the compact 16-bit layout of DATA, so each
+	DMA beat is a whole stereo sample. In mono each halfword beat is one sample, sent to both
+	slots by the serializer.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "audio_output.h"
+
+
+/**********  DEFINE  ************/
+#define I2S_GCLK_GENERATOR		GCLK_GENERATOR_3
+#define I2S_MCLK_FS				(	256	) //master clock in samples
+#define I2S_SCK_DIV				(	8	) //master clock to 32 bit clocks per sample, two 16-bit slots
+#define I2S_DPLL_MIN_HZ			(	48000000	)
+#define I2S_DPLL_REF_HZ			(	32768	)
+
+#define I2S_WORD_BITS			(	16	)
+
+#define I2S_SERIALIZER			(	0	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void i2s_output_init( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played );
+static void i2s_output_start( uint32_t sample_rate );
+static void i2s_output_set_rate( uint32_t sample_rate );
+static uint16_t i2s_output_word( uint16_t code, int index );
+static uint16_t i2s_output_code( uint16_t word );
+
+
+/*******   GLOBAL VARS  *********/
+static const struct dac_dma_target i2s_output_target = {
+	.data = (uint32_t) &I2S->DATA[I2S_SERIALIZER].reg,
+	.trigger = I2S_DMAC_ID_TX_0,
+#if SYNTH_STEREO
+	.beat_size = DMAC_BTCTRL_BEATSIZE_WORD_Val,
+#else
+	.beat_size = DMAC_BTCTRL_BEATSIZE_HWORD_Val,
+#endif
+	.block_per_word = false,
+	.word = i2s_output_word,
+	.code = i2s_output_code,
+};
+
+const struct audio_output audio_output_i2s = {
+	.name = "I2S",
+	.init = i2s_output_init,
+	.start = i2s_output_start,
+	.set_rate = i2s_output_set_rate,
+	.submit = dac_dma_write_frame,
+	.conceal = dac_dma_conceal_frame,
+	.prime = NULL,	//a codec's output is AC coupled, silence is 0 from the start
+};
+
+static uint32_t i2s_rate;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint16_t i2s_output_word( uint16_t code, int index )
+{
+	return sample_word(code, I2S_WORD_BITS, true);
+}
+
+static uint16_t i2s_output_code( uint16_t word )
+{
+	return sample_code(word, I2S_WORD_BITS, true);
+}
+
+static void i2s_output_set_rate( uint32_t sample_rate )
+{
+	//DPLL at 256 fs * k, the generator divides by k back to 256 fs
+	struct system_clock_source_dpll_config dpll_conf;
+	struct system_gclk_gen_config gclock_gen_conf;
+	uint32_t mclk = sample_rate * I2S_MCLK_FS;
+	uint32_t k = 1;
+
+	if(sample_rate == i2s_rate) return;
+	i2s_rate = sample_rate;
+
+	while(mclk * k < I2S_DPLL_MIN_HZ) k <<= 1;
+
+	system_clock_source_disable(SYSTEM_CLOCK_SOURCE_DPLL);
+	system_clock_source_dpll_get_config_defaults(&dpll_conf);
+	dpll_conf.on_demand = false;
+	dpll_conf.reference_clock = SYSTEM_CLOCK_SOURCE_DPLL_REFERENCE_CLOCK_XOSC32K;
+	dpll_conf.reference_frequency = I2S_DPLL_REF_HZ;
+	dpll_conf.output_frequency = mclk * k;
+	system_clock_source_dpll_set_config(&dpll_conf);
+	system_clock_source_enable(SYSTEM_CLOCK_SOURCE_DPLL);
+	while(!system_clock_source_is_ready(SYSTEM_CLOCK_SOURCE_DPLL));
+
+	system_gclk_gen_get_config_defaults(&gclock_gen_conf);
+	gclock_gen_conf.source_clock = GCLK_SOURCE_FDPLL;
+	gclock_gen_conf.division_factor = k;
+	system_gclk_gen_set_config(I2S_GCLK_GENERATOR, &gclock_gen_conf);
+}
+
+static void i2s_output_init( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played )
+{
+	struct system_pinmux_config pin_conf;
+	struct system_gclk_chan_config gclk_chan_conf;
+
+	system_pinmux_get_config_defaults(&pin_conf);
+	pin_conf.mux_position = MUX_PA10G_I2S_SCK0;
+	system_pinmux_pin_set_config(PIN_PA10G_I2S_SCK0, &pin_conf);
+	pin_conf.mux_position = MUX_PA11G_I2S_FS0;
+	system_pinmux_pin_set_config(PIN_PA11G_I2S_FS0, &pin_conf);
+	pin_conf.mux_position = MUX_PA19G_I2S_SD0;
+	system_pinmux_pin_set_config(PIN_PA19G_I2S_SD0, &pin_conf);
+#if SYNTH_I2S_MCLK
+	pin_conf.mux_position = MUX_PA09G_I2S_MCK0;
+	system_pinmux_pin_set_config(PIN_PA09G_I2S_MCK0, &pin_conf);
+#endif
+
+	i2s_output_set_rate(synth_sample_rate());
+	system_gclk_gen_enable(I2S_GCLK_GENERATOR);
+
+	PM->APBCMASK.reg |= PM_APBCMASK_I2S;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = I2S_GCLK_GENERATOR;
+	system_gclk_chan_set_config(I2S_GCLK_ID_0, &gclk_chan_conf);
+	system_gclk_chan_enable(I2S_GCLK_ID_0);
+
+	I2S->CTRLA.reg = I2S_CTRLA_SWRST;
+	while(I2S->SYNCBUSY.reg & I2S_SYNCBUSY_SWRST);
+
+	//the generator clock is the master clock, I2S framing, frame sync one slot wide
+	I2S->CLKCTRL[0].reg = I2S_CLKCTRL_MCKSEL_GCLK | I2S_CLKCTRL_MCKOUTDIV(0) |
+#if SYNTH_I2S_MCLK
+		I2S_CLKCTRL_MCKEN |
+#endif
+		I2S_CLKCTRL_SCKSEL_MCKDIV | I2S_CLKCTRL_MCKDIV(I2S_SCK_DIV - 1) |
+		I2S_CLKCTRL_FSSEL_SCKDIV | I2S_CLKCTRL_FSWIDTH_SLOT | I2S_CLKCTRL_BITDELAY_I2S |
+		I2S_CLKCTRL_NBSLOTS(1) | I2S_CLKCTRL_SLOTSIZE_16;
+
+	//an underrun of the serializer repeats the last sample rather than clicking to zero
+	I2S->SERCTRL[I2S_SERIALIZER].reg = I2S_SERCTRL_SERMODE_TX | I2S_SERCTRL_CLKSEL_CLK0 | I2S_SERCTRL_TXSAME_SAME |
+		I2S_SERCTRL_DMA_SINGLE |
+#if SYNTH_STEREO
+		I2S_SERCTRL_DATASIZE_16C;
+#else
+		I2S_SERCTRL_DATASIZE_16 | I2S_SERCTRL_MONO_MONO;
+#endif
+
+	dac_dma_init(&i2s_output_target, frames, frame_played);
+}
+
+static void i2s_output_start( uint32_t sample_rate )
+{
+	//the serializer requests its first sample as soon as it is enabled; init has locked the
+	//DPLL to the engine's rate already, which is normally this one
+	i2s_output_set_rate(sample_rate);
+	dac_dma_start();
+
+	I2S->CTRLA.reg = I2S_CTRLA_ENABLE | I2S_CTRLA_CKEN0 | I2S_CTRLA_SEREN0;
+	while(I2S->SYNCBUSY.reg & (I2S_SYNCBUSY_ENABLE | I2S_SYNCBUSY_CKEN0 | I2S_SYNCBUSY_SEREN0));
+}
@@ -0,0 +1,153 @@
+/*************************************************************************************************
+                                        --MCP4821 OUTPUT--
+
+	Every DAC word is its own DMA block (two byte beats, MSB first) so that each trigger moves
+	exactly one 16-bit DAC word and the SERCOM releases SS in between.
+
+	With SYNTH_STEREO the DAC is an MCP4822 and a frame interleaves left and right words,
+	sent to DAC A and DAC B. Each word is still its own DMA block, so the sample clock has to
+	run at twice the sample rate, which puts the right channel half a sample after the left.
+
+	With SYNTH_MCP4821_LDAC the words only load the input register and the sample clock's
+	strobe on LDAC moves them to the output, on the overflow after the one that sent them.
+	SPI and DMA latency then no longer show in the output timing. In stereo the strobe still
+	comes every tick, so each channel changes on its own tick as before.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "audio_output.h"
+#include "sample_clock.h"
+#include "mcp4821_spi.h"
+
+
+/**********  DEFINE  ************/
+#define SPI_BAUDRATE		(	20000000	)
+#define SPI_PRIME_WAIT		(	1000	) //flag polls, a byte takes well under 100
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void mcp4821_init( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played );
+static void mcp4821_start( uint32_t sample_rate );
+static void mcp4821_set_rate( uint32_t sample_rate );
+static uint16_t mcp4821_word( uint16_t code, int index );
+static uint16_t mcp4821_code( uint16_t word );
+static bool mcp4821_prime( uint16_t code );
+
+
+/*******   GLOBAL VARS  *********/
+static struct spi_module spi_master_instance;
+
+static struct dac_dma_target mcp4821_target = {
+	.trigger = SAMPLE_CLOCK_DMAC_TRIGGER,
+	.beat_size = DMAC_BTCTRL_BEATSIZE_BYTE_Val,
+	.block_per_word = true,
+	.word = mcp4821_word,
+	.code = mcp4821_code,
+};
+
+const struct audio_output audio_output_mcp4821 = {
+	.name = "MCP4821",
+	.init = mcp4821_init,
+	.start = mcp4821_start,
+	.set_rate = mcp4821_set_rate,
+	.submit = dac_dma_write_frame,
+	.conceal = dac_dma_conceal_frame,
+	.prime = mcp4821_prime,
+};
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void mcp4821_spi_init( void )
+{
+	struct spi_config config_spi_master;
+	/* Configure, initialize and enable SERCOM SPI module */
+	spi_get_config_defaults(&config_spi_master);
+	config_spi_master.mux_setting = EXT1_SPI_SERCOM_MUX_SETTING;
+	/* Configure pad 0 for data in, or leave PA04 to LDAC */
+#if SYNTH_MCP4821_LDAC
+	config_spi_master.pinmux_pad0 = PINMUX_UNUSED;
+#else
+	config_spi_master.pinmux_pad0 = EXT1_SPI_SERCOM_PINMUX_PAD0;
+#endif
+	/* Configure pad 1 as hardware SS, framing each DAC word */
+	config_spi_master.pinmux_pad1 = EXT1_SPI_SERCOM_PINMUX_PAD1; //PA05
+	config_spi_master.master_slave_select_enable = true;
+	config_spi_master.receiver_enable = false;
+	/* Configure pad 2 for data out */
+	config_spi_master.pinmux_pad2 = EXT1_SPI_SERCOM_PINMUX_PAD2; //PA06
+	/* Configure pad 3 for SCK */
+	config_spi_master.pinmux_pad3 = EXT1_SPI_SERCOM_PINMUX_PAD3; //PA07
+	config_spi_master.generator_source = SYNTH_FIXED_GCLK;
+	spi_init(&spi_master_instance, EXT1_SPI_MODULE, &config_spi_master);
+	spi_enable(&spi_master_instance);
+	spi_set_baudrate(&spi_master_instance, SPI_BAUDRATE);
+}
+
+static uint16_t mcp4821_word( uint16_t code, int index )
+{
+	//MCP4821 command word in SPI byte order, odd words of a stereo frame go to DAC B
+	uint16_t channel = ((SYNTH_OUTPUT_CHANNELS > 1) && (index & 1)) ? DAC_CMD_CHANNEL_B : 0;
+
+	return Swap16(sample_word(code, MCP4821_WORD_BITS, false) | DAC_CMD_MASK | channel);
+}
+
+static uint16_t mcp4821_code( uint16_t word )
+{
+	return sample_code(Swap16(word), MCP4821_WORD_BITS, false);
+}
+
+static bool mcp4821_wait( uint8_t flag )
+{
+	SercomSpi *const spi = &EXT1_SPI_MODULE->SPI;
+	int wait;
+
+	for(wait=0; (wait < SPI_PRIME_WAIT) && !(spi->INTFLAG.reg & flag); wait++);
+
+	return (wait < SPI_PRIME_WAIT);
+}
+
+static bool mcp4821_prime( uint16_t code )
+{
+	//mcp4821_spi_write() with timeouts, to both channels of an MCP4822. The DAC has no
+	//read-back, so this only shows the SERCOM is clocked and shifts the words out
+	SercomSpi *const spi = &EXT1_SPI_MODULE->SPI;
+	uint16_t word;
+	int n;
+
+	for(n=0; n<SYNTH_OUTPUT_CHANNELS; n++)
+	{
+		word = sample_word(code, MCP4821_WORD_BITS, false) | DAC_CMD_MASK | (n ? DAC_CMD_CHANNEL_B : 0);
+		if(!mcp4821_wait(SERCOM_SPI_INTFLAG_DRE)) return false;
+		spi->DATA.reg = word >> 8;
+		if(!mcp4821_wait(SERCOM_SPI_INTFLAG_DRE)) return false;
+		spi->DATA.reg = word & 0xFF;
+		if(!mcp4821_wait(SERCOM_SPI_INTFLAG_TXC)) return false;
+	}
+
+	return true;
+}
+
+static void mcp4821_init( uint16_t (*frames)[SYNTH_FRAME_WORDS], dac_dma_callback_t frame_played )
+{
+	mcp4821_spi_init();
+
+	mcp4821_target.data = (uint32_t) &spi_master_instance.hw->SPI.DATA.reg;
+	dac_dma_init(&mcp4821_target, frames, frame_played);
+}
+
+static void mcp4821_start( uint32_t sample_rate )
+{
+	//one trigger per DAC word, two per sample in stereo
+	dac_dma_start();
+	sample_clock_init(sample_rate * SYNTH_OUTPUT_CHANNELS, NULL);
+#if SYNTH_MCP4821_LDAC
+	sample_clock_strobe_init();
+#endif
+	sample_clock_start();
+}
+
+static void mcp4821_set_rate( uint32_t sample_rate )
+{
+	sample_clock_set_rate(sample_rate * SYNTH_OUTPUT_CHANNELS);
+}
@@ -0,0 +1,207 @@
+/*************************************************************************************************
+                                         --PANEL KNOBS--
+
+	The ADC runs from OSC8M on generator 2, divided by 16, so clock scaling does not change
+	its rate. Each knob is the average of 16 samples, about 350 us, which gives every knob a
+	new value some 300 times a second at 8 knobs. The reference is half of VDDANA at a gain
+	of one half, so the full range of a pot between VDDANA and ground is the full 12 bits
+	whatever the supply.
+
+	The DMA channel is at the lowest level: a result waits a whole conversion in RESULT
+	before the next one overruns it.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "panel_knobs.h"
+#include "dac_dma.h"
+#include "synth_engine.h"
+
+#if SYNTH_PANEL_KNOBS
+
+/**********  DEFINE  ************/
+#define KNOB_RAW_NONE			(	0xFFFF	) //nothing converted since the scan started
+#define KNOB_UNSET				(	0xFF	)
+#define KNOB_STEP_SHIFT			(	5	) //12-bit results to 7-bit values
+#define KNOB_HYSTERESIS			(	16	) //half a step
+#define KNOB_SAMPLE_LENGTH		(	7	) //half ADC clocks of sampling, beyond the first
+
+
+/*******   GLOBAL VARS  *********/
+//PORT pin of each ADC input, AIN0 to AIN19
+static const uint8_t knob_ain_pin[] = {
+	PIN_PA02, PIN_PA03, PIN_PB08, PIN_PB09, PIN_PA04, PIN_PA05, PIN_PA06, PIN_PA07,
+	PIN_PB00, PIN_PB01, PIN_PB02, PIN_PB03, PIN_PB04, PIN_PB05, PIN_PB06, PIN_PB07,
+	PIN_PA08, PIN_PA09, PIN_PA10, PIN_PA11,
+};
+
+//controller each knob sends, in the default map: filter cutoff and resonance, mod wheel,
+//volume, pulse width, portamento time, delay mix and chorus mix
+static const uint8_t knob_controller[8] = {
+	MIDI_CC_CUTOFF, MIDI_CC_RESONANCE, MIDI_CC_MOD_WHEEL, MIDI_CC_VOLUME,
+	MIDI_CC_PULSE_WIDTH, MIDI_CC_PORTAMENTO_TIME, MIDI_CC_DELAY_MIX, MIDI_CC_CHORUS_MIX,
+};
+
+static volatile uint16_t knob_raw[SYNTH_PANEL_KNOBS];
+static uint8_t knob_value[SYNTH_PANEL_KNOBS];
+static uint16_t knob_restarts;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void panel_knobs_start( void );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void adc_sync( void )
+{
+	while(ADC->STATUS.reg & ADC_STATUS_SYNCBUSY);
+}
+
+void panel_knobs_init( void )
+{
+	struct system_pinmux_config pin_conf;
+	struct system_gclk_chan_config gclk_chan_conf;
+	DmacDescriptor *desc = dac_dma_base_descriptor(PANEL_DMA_CHANNEL);
+	uint32_t linearity;
+	uint32_t bias;
+	int i;
+
+	//function B is the analog one on every ADC pin
+	system_pinmux_get_config_defaults(&pin_conf);
+	pin_conf.mux_position = 1;
+	pin_conf.input_pull = SYSTEM_PINMUX_PIN_PULL_NONE;
+	for(i=0; i<SYNTH_PANEL_KNOBS; i++) system_pinmux_pin_set_config(knob_ain_pin[SYNTH_PANEL_FIRST_AIN + i], &pin_conf);
+
+	PM->APBCMASK.reg |= PM_APBCMASK_ADC;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
+	system_gclk_chan_set_config(ADC_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(ADC_GCLK_ID);
+
+	ADC->CTRLA.reg = ADC_CTRLA_SWRST;
+	adc_sync();
+	while(ADC->CTRLA.reg & ADC_CTRLA_SWRST);
+
+	//factory calibration from the NVM software calibration area
+	linearity = (*(uint32_t *) ADC_FUSES_LINEARITY_0_ADDR & ADC_FUSES_LINEARITY_0_Msk) >> ADC_FUSES_LINEARITY_0_Pos;
+	linearity |= ((*(uint32_t *) ADC_FUSES_LINEARITY_1_ADDR & ADC_FUSES_LINEARITY_1_Msk) >> ADC_FUSES_LINEARITY_1_Pos) << 5;
+	bias = (*(uint32_t *) ADC_FUSES_BIASCAL_ADDR & ADC_FUSES_BIASCAL_Msk) >> ADC_FUSES_BIASCAL_Pos;
+	ADC->CALIB.reg = ADC_CALIB_BIAS_CAL(bias) | ADC_CALIB_LINEARITY_CAL(linearity);
+
+	ADC->REFCTRL.reg = ADC_REFCTRL_REFSEL_INTVCC1;
+	ADC->AVGCTRL.reg = ADC_AVGCTRL_SAMPLENUM_16 | ADC_AVGCTRL_ADJRES(4);
+	ADC->SAMPCTRL.reg = ADC_SAMPCTRL_SAMPLEN(KNOB_SAMPLE_LENGTH);
+	ADC->CTRLB.reg = ADC_CTRLB_PRESCALER_DIV16 | ADC_CTRLB_RESSEL_16BIT | ADC_CTRLB_FREERUN;
+	adc_sync();
+
+	dac_dma_controller_init();
+	DMAC->CHID.reg = DMAC_CHID_ID(PANEL_DMA_CHANNEL);
+	DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+	DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(ADC_DMAC_ID_RESRDY) | DMAC_CHCTRLB_TRIGACT_BEAT;
+
+	//one result per knob round and round; the destination is the end address where the
+	//descriptor increments
+	desc->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC | DMAC_BTCTRL_BLOCKACT_NOACT;
+	desc->BTCNT.reg = SYNTH_PANEL_KNOBS;
+	desc->SRCADDR.reg = (uint32_t) &ADC->RESULT.reg;
+	desc->DSTADDR.reg = (uint32_t) knob_raw + sizeof(knob_raw);
+	desc->DESCADDR.reg = (uint32_t) desc;
+
+	for(i=0; i<SYNTH_PANEL_KNOBS; i++) knob_value[i] = KNOB_UNSET;
+	knob_restarts = 0;
+	panel_knobs_start();
+}
+
+static void panel_knobs_start( void )
+{
+	//the scan from its first input and the DMA from the first entry, with both stopped
+	uint8_t chid = DMAC->CHID.reg;
+	int i;
+
+	for(i=0; i<SYNTH_PANEL_KNOBS; i++) knob_raw[i] = KNOB_RAW_NONE;
+
+	ADC->INPUTCTRL.reg = ADC_INPUTCTRL_MUXPOS(SYNTH_PANEL_FIRST_AIN) | ADC_INPUTCTRL_MUXNEG_GND |
+		ADC_INPUTCTRL_INPUTSCAN(SYNTH_PANEL_KNOBS - 1) | ADC_INPUTCTRL_INPUTOFFSET(0) | ADC_INPUTCTRL_GAIN_DIV2;
+	adc_sync();
+	ADC->INTFLAG.reg = ADC_INTFLAG_MASK;
+
+	DMAC->CHID.reg = DMAC_CHID_ID(PANEL_DMA_CHANNEL);
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+	DMAC->CHID.reg = chid;
+
+	ADC->CTRLA.reg = ADC_CTRLA_ENABLE;
+	adc_sync();
+	ADC->SWTRIG.reg = ADC_SWTRIG_START;
+	adc_sync();
+}
+
+static void panel_knobs_restart( void )
+{
+	//from a task; the DMA channel select is shared with the other tasks' drivers
+	uint8_t chid;
+
+	taskENTER_CRITICAL();
+	ADC->CTRLA.reg = 0;
+	adc_sync();
+
+	chid = DMAC->CHID.reg;
+	DMAC->CHID.reg = DMAC_CHID_ID(PANEL_DMA_CHANNEL);
+	DMAC->CHCTRLA.reg &= ~DMAC_CHCTRLA_ENABLE;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_ENABLE);
+	DMAC->CHID.reg = chid;
+
+	panel_knobs_start();
+	taskEXIT_CRITICAL();
+
+	knob_restarts++;
+}
+
+int panel_knobs_read( struct midi_event *events )
+{
+	//the knobs that moved as control changes, SYNTH_PANEL_KNOBS at most; returns the count
+	uint16_t raw;
+	uint16_t low;
+	int count = 0;
+	int i;
+
+	if(ADC->INTFLAG.reg & ADC_INTFLAG_OVERRUN)
+	{
+		panel_knobs_restart();
+		return 0;
+	}
+
+	for(i=0; i<SYNTH_PANEL_KNOBS; i++)
+	{
+		raw = knob_raw[i];
+		if(raw == KNOB_RAW_NONE) continue;
+
+		//the first reading only sets where the knob is
+		if(knob_value[i] == KNOB_UNSET)
+		{
+			knob_value[i] = (uint8_t) (raw >> KNOB_STEP_SHIFT);
+			continue;
+		}
+
+		low = (uint16_t) knob_value[i] << KNOB_STEP_SHIFT;
+		if((raw + KNOB_HYSTERESIS >= low) && (raw < low + (1 << KNOB_STEP_SHIFT) + KNOB_HYSTERESIS)) continue;
+
+		knob_value[i] = (uint8_t) (raw >> KNOB_STEP_SHIFT);
+		events[count].status = MIDI_CONTROL_CHANGE;
+		events[count].channel = SYNTH_PANEL_CHANNEL;
+		events[count].data1 = knob_controller[i];
+		events[count].data2 = knob_value[i];
+		count++;
+	}
+
+	return count;
+}
+
+uint16_t panel_knobs_restarts( void )
+{
+	return knob_restarts;
+}
+
+#endif /* SYNTH_PANEL_KNOBS */
@@ -0,0 +1,33 @@
+/*************************************************************************************************
+                                         --PANEL KNOBS--
+
+	Potentiometers on SYNTH_PANEL_KNOBS consecutive ADC inputs from SYNTH_PANEL_FIRST_AIN,
+	wired between VDDANA and ground. The ADC scans them in free-running mode and a DMA
+	channel copies every result into a RAM array of one halfword per knob, so the CPU never
+	starts a conversion or waits for one.
+
+	panel_knobs_read() only looks at that array. A knob whose 7-bit value moved by more
+	than half a step past its last one becomes a control change on SYNTH_PANEL_CHANNEL,
+	which the MIDI task queues like any other; the controller map (see synth_engine.h)
+	decides what it drives. Knobs do not send their positions at start-up, the patch keeps
+	its values until one is turned.
+
+	The array holds each knob at its own index for as long as the DMA takes every result.
+	A result it missed shows as the ADC's overrun flag; the next read then restarts the scan
+	and the DMA together instead of reporting knobs shifted by one.
+
+*************************************************************************************************/
+
+#ifndef PANEL_KNOBS_H_INCLUDED
+#define PANEL_KNOBS_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void panel_knobs_init( void );
+int panel_knobs_read( struct midi_event *events );
+uint16_t panel_knobs_restarts( void );
+
+#endif /* PANEL_KNOBS_H_INCLUDED */
@@ -0,0 +1,75 @@
+/*************************************************************************************************
+                                          --PATTERN--
+
+	The player reads one step from flash per step, two bytes, and keeps nothing of the
+	pattern in RAM. A new pattern replaces the old one from its first step; the caller
+	releases the old one's note first with pattern_release().
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "pattern.h"
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void pattern_play( struct pattern_player *player, const struct pattern *pattern )
+{
+	//NULL stops it
+	player->pattern = ((pattern != NULL) && (pattern->length != 0)) ? pattern : NULL;
+	player->sounding = PATTERN_NONE;
+	player->tied = false;
+	pattern_restart(player);
+}
+
+void pattern_restart( struct pattern_player *player )
+{
+	//the next clock is the first step
+	player->step = 0;
+	player->clock = 0;
+}
+
+bool pattern_clock( struct pattern_player *player, struct pattern_out *out )
+{
+	//true when the clock asks for a note off or on
+	const struct pattern *pattern = player->pattern;
+	struct pattern_step step;
+
+	out->off = PATTERN_NONE;
+	out->on = PATTERN_NONE;
+	if(pattern == NULL) return false;
+	out->channel = pattern->channel;
+
+	if(player->clock == 0)
+	{
+		out->off = player->sounding;
+		player->sounding = PATTERN_NONE;
+
+		step = pattern->steps[player->step];
+		if(step.note != PATTERN_REST)
+		{
+			out->on = step.note & 0x7F;
+			out->velocity = step.velocity & 0x7F;
+			player->sounding = out->on;
+			player->tied = (step.velocity & PATTERN_TIE) != 0;
+		}
+		player->step = (player->step + 1 >= pattern->length) ? 0 : player->step + 1;
+	}
+	else if((player->clock == pattern->gate) && !player->tied)
+	{
+		out->off = player->sounding;
+		player->sounding = PATTERN_NONE;
+	}
+
+	player->clock = (player->clock + 1 >= pattern->division) ? 0 : player->clock + 1;
+	return (out->off != PATTERN_NONE) || (out->on != PATTERN_NONE);
+}
+
+int16_t pattern_release( struct pattern_player *player )
+{
+	//the sounding note for the caller to release, on the pattern's channel
+	int16_t note = player->sounding;
+
+	player->sounding = PATTERN_NONE;
+	return note;
+}
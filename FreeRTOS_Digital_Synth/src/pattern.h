@@ -0,0 +1,68 @@
+/*************************************************************************************************
+                                          --PATTERN--
+
+	Step patterns kept in flash and played on the engine's clock, so a board plays its loop
+	on its own with nothing connected: from power-up with SYNTH_PATTERN, or once CC 107 on
+	any channel selects one. A step is two bytes, the note (PATTERN_REST for none) and the
+	velocity, with PATTERN_TIE set in it for a note that holds until the next step starts
+	instead of for the pattern's gate. Every step lasts 'division' clocks and the pattern
+	loops after its last one.
+
+	The patterns themselves are in patterns.c, const like the sample bank. pattern_clock()
+	is called once per clock and says which note to release and which to start, like
+	arp_clock(); MIDI clock or, without it, the internal clock drives it.
+
+*************************************************************************************************/
+
+#ifndef PATTERN_H_INCLUDED
+#define PATTERN_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define PATTERN_NONE			(	-1	)
+#define PATTERN_REST			(	0xFF	)
+#define PATTERN_TIE				(	0x80	)
+
+/********   TYPE DEFS  **********/
+struct pattern_step{
+	uint8_t note;
+	uint8_t velocity;
+};
+
+struct pattern{
+	const struct pattern_step *steps;
+	uint16_t length;
+	uint8_t channel;
+	uint8_t division;		//clocks per step
+	uint8_t gate;			//clocks a note sounds, below division
+};
+
+struct pattern_player{
+	const struct pattern *pattern;		//NULL while stopped
+	uint16_t step;
+	uint8_t clock;			//clocks into the current step
+	bool tied;				//the sounding note waits for the next step
+	int16_t sounding;		//PATTERN_NONE when released
+};
+
+//what one clock asks for, PATTERN_NONE for nothing; both on the pattern's channel
+struct pattern_out{
+	int16_t off;
+	int16_t on;
+	uint8_t velocity;
+	uint8_t channel;
+};
+
+/*******   GLOBAL VARS  *********/
+extern const struct pattern patterns[];
+extern const int pattern_count;
+
+/****** FUNCTION PROTOTYPES  ****/
+void pattern_play( struct pattern_player *player, const struct pattern *pattern );
+void pattern_restart( struct pattern_player *player );
+bool pattern_clock( struct pattern_player *player, struct pattern_out *out );
+int16_t pattern_release( struct pattern_player *player );
+
+#endif /* PATTERN_H_INCLUDED */
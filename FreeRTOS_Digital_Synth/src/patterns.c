@@ -0,0 +1,39 @@
+/*************************************************************************************************
+                                         --PATTERNS--
+
+	The step patterns CC 107 and SYNTH_PATTERN select, pattern n is value n. Edit or add to
+	them here, steps are { note, velocity }, see pattern.h.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "pattern.h"
+
+
+/**********  DEFINE  ************/
+#define R						{ PATTERN_REST, 0 }
+
+
+/*******   GLOBAL VARS  *********/
+//a bar of sixteenths in A minor, for the bass on channel 1
+static const struct pattern_step bass_steps[16] = {
+	{ 33, 110 }, R, { 45, 80 }, { 33, 90 },
+	R, { 33, 100 }, { 45, 80 }, R,
+	{ 36, 110 }, R, { 48, 80 }, { 36, 90 },
+	{ 31, 100 | PATTERN_TIE }, R, { 43, 80 }, { 38, 90 },
+};
+
+//two bars of eighths for a lead on channel 2, the last note held across the turn
+static const struct pattern_step lead_steps[16] = {
+	{ 69, 90 }, { 72, 70 }, { 76, 90 }, { 72, 70 },
+	{ 74, 90 }, { 72, 70 }, { 71, 90 }, { 67, 70 },
+	{ 69, 90 }, { 72, 70 }, { 76, 90 }, { 79, 70 },
+	{ 77, 90 }, { 76, 70 }, { 74, 90 | PATTERN_TIE }, R,
+};
+
+const struct pattern patterns[] = {
+	{ bass_steps, 16, 0, 6, 3 },
+	{ lead_steps, 16, 1, 12, 9 },
+};
+
+const int pattern_count = (int) (sizeof(patterns) / sizeof(patterns[0]));
@@ -0,0 +1,129 @@
+/*************************************************************************************************
+                                           --PLUCK--
+
+	The burst is full scale, one LFSR step per frame like a NOISE voice; the averaging
+	takes the level down from there. Lines hold DAC-range samples around 0 so the mean
+	never leaves int16_t.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "pluck.h"
+#include "synth_engine.h"
+#include "block_pool.h"
+
+
+/********   TYPE DEFS  **********/
+struct pluck_line{
+	uint32_t struck;			//the strike count it was taken at
+	uint16_t pos;
+	uint16_t length;
+	uint8_t voice;
+	int16_t data[SYNTH_PLUCK_FRAMES];
+};
+
+
+/*******   GLOBAL VARS  *********/
+SYNTH_AUDIO_BUFFER static struct pluck_line pluck_lines[SYNTH_PLUCK_LINES];
+static struct block_pool pluck_pool;
+
+//the line a voice plays, NULL for none
+static struct pluck_line *voice_line[SYNTH_MAX_VOICES];
+static uint32_t strikes;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void pluck_init( void )
+{
+	int i;
+
+	block_pool_init(&pluck_pool, "pluck", pluck_lines, sizeof(pluck_lines[0]), SYNTH_PLUCK_LINES);
+	for(i=0; i<SYNTH_MAX_VOICES; i++) voice_line[i] = NULL;
+	strikes = 0;
+}
+
+bool pluck_voice_start( int voice, uint32_t inc, uint32_t *lfsr )
+{
+	//strikes the voice's string at phase increment 'inc', false with no line to play on; the
+	//voice keeps the line it had, or takes a free one, or the oldest string's
+	uint32_t state = *lfsr;
+	uint32_t length;
+	struct pluck_line *line = voice_line[voice];
+	int i;
+
+	if(line == NULL)
+	{
+		line = block_pool_get(&pluck_pool);
+		if(line == NULL)
+		{
+			for(i=0; i<SYNTH_MAX_VOICES; i++)
+			{
+				if(voice_line[i] == NULL) continue;
+				if((line == NULL) || ((int32_t) (voice_line[i]->struck - line->struck) < 0)) line = voice_line[i];
+			}
+			if(line == NULL) return false;
+			voice_line[line->voice] = NULL;
+		}
+
+		line->voice = (uint8_t) voice;
+		voice_line[voice] = line;
+	}
+
+	//one period is 2^32 / inc samples, the averaging adds half of one
+	length = inc ? (uint32_t) ((1ull << 32) / inc) : SYNTH_PLUCK_FRAMES;
+	if(length > SYNTH_PLUCK_FRAMES) length = SYNTH_PLUCK_FRAMES;
+	if(length < 2) length = 2;
+
+	for(i=0; i<(int) length; i++)
+	{
+		state = (state >> 1) ^ ((0u - (state & 1u)) & NOISE_LFSR_TAPS);
+		line->data[i] = (state & 1u) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1);
+	}
+
+	*lfsr = state;
+	line->pos = 0;
+	line->length = (uint16_t) length;
+	line->struck = strikes++;
+	return true;
+}
+
+void pluck_voice_stop( int voice )
+{
+	//the slot is given up, its line goes back to the pool
+	struct pluck_line *line = voice_line[voice];
+
+	if(line == NULL) return;
+	block_pool_put(&pluck_pool, line);
+	voice_line[voice] = NULL;
+}
+
+SYNTH_RAM_CODE void pluck_render( int voice, int32_t *mix, int count, int32_t gain, int32_t gain_step )
+{
+	//a string that lost its line stays silent until it is struck again
+	struct pluck_line *line = voice_line[voice];
+	int16_t *data;
+	int32_t s;
+	int pos;
+	int next;
+	int length;
+	int i;
+
+	if(line == NULL) return;
+
+	data = line->data;
+	pos = line->pos;
+	length = line->length;
+
+	for(i=0; i<count; i++)
+	{
+		next = (pos + 1 < length) ? pos + 1 : 0;
+		s = data[pos];
+		data[pos] = (int16_t) ((s + data[next]) >> 1);
+		mix[i] += (s * gain) >> MIX_SHIFT;
+		gain += gain_step;
+		pos = next;
+	}
+
+	line->pos = (uint16_t) pos;
+}
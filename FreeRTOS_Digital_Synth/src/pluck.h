@@ -0,0 +1,32 @@
+/*************************************************************************************************
+                                           --PLUCK--
+
+	Karplus-Strong string for the PLUCK voice type. A note fills a delay line one period of
+	its pitch long with a burst of the voice's LFSR noise, then plays the line round and
+	round, every sample leaving behind the mean of itself and the next one: one add and one
+	shift, which damps the highs first like a real string. The loop is the line plus half a
+	sample long, the line length is rounded to fit, so the pitch is within a few cents in
+	the lower octaves and drifts sharp or flat by up to half a sample at the top. It is set
+	at the strike, bend and glide do not move a sounding string.
+
+	The lines come from a block pool of SYNTH_PLUCK_LINES, SYNTH_PLUCK_FRAMES long each,
+	shared by all voices; a voice holds its line from note-on until its slot is given up.
+	With every line taken the string struck longest ago loses its line and falls silent,
+	one of the pool's misses. A note below the lowest pitch a line holds plays at that pitch.
+
+*************************************************************************************************/
+
+#ifndef PLUCK_H_INCLUDED
+#define PLUCK_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void pluck_init( void );
+bool pluck_voice_start( int voice, uint32_t inc, uint32_t *lfsr );
+void pluck_voice_stop( int voice );
+void pluck_render( int voice, int32_t *mix, int count, int32_t gain, int32_t gain_step );
+
+#endif /* PLUCK_H_INCLUDED */
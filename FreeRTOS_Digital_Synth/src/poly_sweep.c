@@ -0,0 +1,171 @@
+/*************************************************************************************************
+                                         --POLY SWEEP--
+
+	All of the sweep runs in the console task. The underrun and shed counts are read at the
+	start and the end of each hold, so only a step's own failures count against it; the
+	first hold of a waveform also covers the switch from the last one's notes.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include "poly_sweep.h"
+#include "synth_engine.h"
+#include "audio_stats.h"
+
+#if SYNTH_POLY_SWEEP
+
+/**********  DEFINE  ************/
+#define SWEEP_CHANNEL			(	0	)
+#define SWEEP_VELOCITY			(	100	)
+#define SWEEP_FIRST_NOTE		(	36	)
+#define SWEEP_LEVEL				(	96	)	//of every effect's controller
+
+
+/********   TYPE DEFS  **********/
+enum sweep_state{
+	SWEEP_IDLE,
+	SWEEP_SETUP,			//the effects' controllers, one a pass
+	SWEEP_WAVE,				//all sound off, then the next waveform
+	SWEEP_NOTE,
+	SWEEP_HOLD,
+	SWEEP_DONE,
+};
+
+
+/*******   GLOBAL VARS  *********/
+static const uint8_t sweep_controls[][2] = {
+	{ MIDI_CC_POLYPHONY, 0 },
+	{ MIDI_CC_RESONANCE, SWEEP_LEVEL },
+	{ MIDI_CC_SHAPER_DRIVE, SWEEP_LEVEL },
+	{ MIDI_CC_FORMANT_MIX, SWEEP_LEVEL },
+	{ MIDI_CC_CHORUS_MIX, SWEEP_LEVEL },
+	{ MIDI_CC_DELAY_MIX, SWEEP_LEVEL },
+	{ MIDI_CC_REVERB_MIX, SWEEP_LEVEL },
+};
+
+#define SWEEP_CONTROLS		(	sizeof(sweep_controls) / sizeof(sweep_controls[0])	)
+
+static uint8_t sweep_state;
+static const char *const *sweep_names;
+static uint32_t sweep_hold_ticks;
+static uint32_t sweep_start_tick;
+static uint32_t sweep_underruns;
+static uint32_t sweep_sheds;
+static uint8_t sweep_step;				//controller, or 0 all sound off and 1 the program
+static uint8_t sweep_wave;
+static uint8_t sweep_voices;			//held in the current step
+static uint8_t sweep_lowest;
+static bool sweep_stopped;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void poly_sweep_start( uint32_t hold_ticks, const char *const *wave_names )
+{
+	//from the console task, the waveforms' names are for the report
+	sweep_names = wave_names;
+	sweep_hold_ticks = hold_ticks;
+	sweep_step = 0;
+	sweep_wave = 0;
+	sweep_lowest = SYNTH_MAX_VOICES;
+	sweep_stopped = false;
+	sweep_state = SWEEP_SETUP;
+}
+
+void poly_sweep_stop( void )
+{
+	//from the console task, the held notes are stopped on the next pass
+	if(sweep_state == SWEEP_IDLE) return;
+	sweep_stopped = true;
+	sweep_state = SWEEP_DONE;
+}
+
+static void sweep_counts( uint32_t *underruns, uint32_t *sheds )
+{
+	struct audio_stats stats;
+
+	audio_stats_get(&stats);
+	*underruns = stats.underruns;
+	*sheds = synth_governor_shed_count();
+}
+
+static void sweep_wave_end( uint8_t voices )
+{
+	//the waveform's result, and on to the next
+	printf("sweep: %s holds %u voices\r\n", sweep_names[sweep_wave], (unsigned int) voices);
+	if(voices < sweep_lowest) sweep_lowest = voices;
+
+	sweep_step = 0;
+	sweep_state = (++sweep_wave < WAVE_TYPE_COUNT) ? SWEEP_WAVE : SWEEP_DONE;
+}
+
+bool poly_sweep_job( uint32_t tick, struct midi_event *event )
+{
+	//console task, every pass with the tick count: true with an event for the sweep to post
+	uint32_t underruns;
+	uint32_t sheds;
+
+	event->channel = SWEEP_CHANNEL;
+
+	switch(sweep_state)
+	{
+	case SWEEP_SETUP:
+		event->status = MIDI_CONTROL_CHANGE;
+		event->data1 = sweep_controls[sweep_step][0];
+		event->data2 = sweep_controls[sweep_step][1];
+		if(++sweep_step == SWEEP_CONTROLS)
+		{
+			sweep_step = 0;
+			sweep_state = SWEEP_WAVE;
+		}
+		return true;
+
+	case SWEEP_WAVE:
+		if(sweep_step++ == 0)
+		{
+			event->status = MIDI_CONTROL_CHANGE;
+			event->data1 = MIDI_CC_ALL_SOUND_OFF;
+			event->data2 = 0;
+			return true;
+		}
+		event->status = MIDI_PROGRAM_CHANGE;
+		event->data1 = sweep_wave;
+		event->data2 = 0;
+		sweep_voices = 0;
+		sweep_state = SWEEP_NOTE;
+		return true;
+
+	case SWEEP_NOTE:
+		event->status = MIDI_NOTE_ON;
+		event->data1 = (uint8_t) (SWEEP_FIRST_NOTE + sweep_voices);
+		event->data2 = SWEEP_VELOCITY;
+		sweep_voices++;
+		sweep_counts(&sweep_underruns, &sweep_sheds);
+		sweep_start_tick = tick;
+		sweep_state = SWEEP_HOLD;
+		return true;
+
+	case SWEEP_HOLD:
+		if((uint32_t) (tick - sweep_start_tick) < sweep_hold_ticks) return false;
+		sweep_counts(&underruns, &sheds);
+		if((underruns != sweep_underruns) || (sheds != sweep_sheds)) sweep_wave_end(sweep_voices - 1);
+		else if(sweep_voices == SYNTH_MAX_VOICES) sweep_wave_end(sweep_voices);
+		else sweep_state = SWEEP_NOTE;
+		return false;
+
+	case SWEEP_DONE:
+		if(sweep_stopped) printf("sweep: stopped\r\n");
+		else if(sweep_lowest == 0) printf("sweep: underruns with a single voice, try a lower sample rate\r\n");
+		else printf("sweep: every waveform holds %u voices, ':poly %u' is safe\r\n", (unsigned int) sweep_lowest, (unsigned int) sweep_lowest);
+		sweep_state = SWEEP_IDLE;
+		event->status = MIDI_CONTROL_CHANGE;
+		event->data1 = MIDI_CC_ALL_SOUND_OFF;
+		event->data2 = 0;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+#endif /* SYNTH_POLY_SWEEP */
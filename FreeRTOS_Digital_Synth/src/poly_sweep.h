@@ -0,0 +1,33 @@
+/*************************************************************************************************
+                                         --POLY SWEEP--
+
+	Finds how many voices a board renders without underruns, for setting a safe polyphony
+	limit (CC 20, or ':poly') on each hardware revision. poly_sweep_start() turns the filter
+	resonance, shaper, formant, chorus, delay and reverb up, then plays every waveform in
+	turn: one held note more every step, each step held for the given time, until a step
+	shows an underrun or the engine's voices are all sounding. A step that made the load
+	governor shed a voice fails as well, the governor only hides the overload.
+
+	Each waveform's result is printed as it ends, the lowest of them at the end. That is the
+	count the synth sustains whatever is played on it. Nothing else should be playing; the
+	effects are left where the sweep set them.
+
+	The notes go through the console's event queue, one event per pass of the console task
+	that runs poly_sweep_job().
+
+*************************************************************************************************/
+
+#ifndef POLY_SWEEP_H_INCLUDED
+#define POLY_SWEEP_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void poly_sweep_start( uint32_t hold_ticks, const char *const *wave_names );
+void poly_sweep_stop( void );
+bool poly_sweep_job( uint32_t tick, struct midi_event *event );
+
+#endif /* POLY_SWEEP_H_INCLUDED */
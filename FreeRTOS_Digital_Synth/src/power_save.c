@@ -0,0 +1,189 @@
+/*************************************************************************************************
+                                         --POWER SAVE--
+
+	Every peripheral the gate looks at has its enable in bit 1 of the first byte of its
+	first register (CTRLA, or CTRL for the DMAC, EIC, RTC and WDT), so one byte read tells.
+	It only reads a peripheral whose APB clock is on. The paired TCs of the 32-bit counters
+	share a generic clock with their master, as TCC2 does with TC3, so the slave keeps its
+	bus while the pair runs.
+
+	The sleep is timed on the TC4/TC5 cycle counter with interrupts masked, so the interrupt
+	that wakes the core runs after the count, not inside it.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "power_save.h"
+#include "cycle_counter.h"
+
+
+/**********  DEFINE  ************/
+#define POWER_ENABLE_BIT		(	0x02	)
+#define POWER_NO_GCLK			(	0xFF	)
+
+//cycles for the pull-down to bring a floating RX pin low, a few microseconds
+#define POWER_PULL_CYCLES		(	256	)
+
+enum power_bus{ POWER_APBA, POWER_APBB, POWER_APBC };
+
+
+/********   TYPE DEFS  **********/
+struct power_gate{
+	const char *name;
+	enum power_bus bus;
+	uint32_t mask;
+	uint8_t gclk;
+	const volatile void *ctrl;
+};
+
+
+/*******   GLOBAL VARS  *********/
+static const struct power_gate power_gates[] = {
+	{ "EIC", POWER_APBA, PM_APBAMASK_EIC, EIC_GCLK_ID, EIC },
+	{ "RTC", POWER_APBA, PM_APBAMASK_RTC, RTC_GCLK_ID, RTC },
+	{ "WDT", POWER_APBA, PM_APBAMASK_WDT, WDT_GCLK_ID, WDT },
+	{ "DMAC", POWER_APBB, PM_APBBMASK_DMAC, POWER_NO_GCLK, DMAC },
+	{ "USB", POWER_APBB, PM_APBBMASK_USB, USB_GCLK_ID, USB },
+	{ "SERCOM0", POWER_APBC, PM_APBCMASK_SERCOM0, SERCOM0_GCLK_ID_CORE, SERCOM0 },
+	{ "SERCOM1", POWER_APBC, PM_APBCMASK_SERCOM1, SERCOM1_GCLK_ID_CORE, SERCOM1 },
+	{ "SERCOM2", POWER_APBC, PM_APBCMASK_SERCOM2, SERCOM2_GCLK_ID_CORE, SERCOM2 },
+	{ "SERCOM3", POWER_APBC, PM_APBCMASK_SERCOM3, SERCOM3_GCLK_ID_CORE, SERCOM3 },
+	{ "SERCOM4", POWER_APBC, PM_APBCMASK_SERCOM4, SERCOM4_GCLK_ID_CORE, SERCOM4 },
+	{ "SERCOM5", POWER_APBC, PM_APBCMASK_SERCOM5, SERCOM5_GCLK_ID_CORE, SERCOM5 },
+	{ "TCC0", POWER_APBC, PM_APBCMASK_TCC0, TCC0_GCLK_ID, TCC0 },
+	{ "TCC1", POWER_APBC, PM_APBCMASK_TCC1, TCC1_GCLK_ID, TCC1 },
+	{ "TCC2", POWER_APBC, PM_APBCMASK_TCC2, TCC2_GCLK_ID, TCC2 },
+	{ "TC3", POWER_APBC, PM_APBCMASK_TC3, TC3_GCLK_ID, TC3 },
+	{ "TC4", POWER_APBC, PM_APBCMASK_TC4, TC4_GCLK_ID, TC4 },
+	{ "TC5", POWER_APBC, PM_APBCMASK_TC5, TC5_GCLK_ID, TC5 },
+	{ "TC6", POWER_APBC, PM_APBCMASK_TC6, TC6_GCLK_ID, TC6 },
+	{ "TC7", POWER_APBC, PM_APBCMASK_TC7, TC7_GCLK_ID, TC7 },
+	{ "ADC", POWER_APBC, PM_APBCMASK_ADC, ADC_GCLK_ID, ADC },
+	{ "AC", POWER_APBC, PM_APBCMASK_AC, AC_GCLK_ID_DIG, AC },
+	{ "DAC", POWER_APBC, PM_APBCMASK_DAC, DAC_GCLK_ID, DAC },
+	{ "I2S", POWER_APBC, PM_APBCMASK_I2S, I2S_GCLK_ID_0, I2S },
+};
+
+static volatile bool sleep_enabled = true;
+static volatile uint32_t sleep_cycles;
+static uint32_t share_start;
+static uint32_t share_slept;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+bool power_console_present( void )
+{
+	//the EDBG drives its TX, the console's RX, high whenever it has power
+	struct port_config pin_conf;
+	uint8_t pin = (uint8_t) (EDBG_CDC_SERCOM_PINMUX_PAD1 >> 16);
+	uint32_t start;
+
+	port_get_config_defaults(&pin_conf);
+	pin_conf.direction = PORT_PIN_DIR_INPUT;
+	pin_conf.input_pull = PORT_PIN_PULL_DOWN;
+	port_pin_set_config(pin, &pin_conf);
+
+	start = cycle_counter_read();
+	while((cycle_counter_read() - start) < POWER_PULL_CYCLES);
+
+	//left pulled down when nobody drives it, a floating input draws current
+	return port_pin_get_input_level(pin);
+}
+
+static int power_discard_putchar( void volatile *module, char c )
+{
+	(void) module;
+	(void) c;
+	return 0;
+}
+
+void power_console_discard( void )
+{
+	//printf with no console USART: stdio_base stays NULL, which the console readers check
+	ptr_put = power_discard_putchar;
+}
+
+static volatile uint32_t *power_mask( enum power_bus bus )
+{
+	if(bus == POWER_APBA) return &PM->APBAMASK.reg;
+	if(bus == POWER_APBB) return &PM->APBBMASK.reg;
+	return &PM->APBCMASK.reg;
+}
+
+uint32_t power_gate_unused( void )
+{
+	//once the set-up is done; returns the gated peripherals, bit n for power_gates[n]
+	uint32_t gated = 0;
+	volatile uint32_t *mask;
+	unsigned int i;
+
+	for(i=0; i<sizeof(power_gates) / sizeof(power_gates[0]); i++)
+	{
+		mask = power_mask(power_gates[i].bus);
+		if((*mask & power_gates[i].mask) == 0) continue;
+		if(*(const volatile uint8_t *) power_gates[i].ctrl & POWER_ENABLE_BIT) continue;
+		if((power_gates[i].gclk != POWER_NO_GCLK) && system_gclk_chan_is_enabled(power_gates[i].gclk)) continue;
+
+		*mask &= ~power_gates[i].mask;
+		gated |= 1ul << i;
+	}
+
+	return gated;
+}
+
+void power_print_gated( uint32_t gated )
+{
+	unsigned int i;
+
+	printf("power: APB clock off for");
+	for(i=0; i<sizeof(power_gates) / sizeof(power_gates[0]); i++)
+		if(gated & (1ul << i)) printf(" %s", power_gates[i].name);
+	printf("%s\r\n", gated ? "" : " nothing");
+}
+
+void power_set_sleep( bool sleep )
+{
+	//false keeps the idle task spinning, for the current of a board that never sleeps
+	sleep_enabled = sleep;
+}
+
+bool power_sleep_enabled( void )
+{
+	return sleep_enabled;
+}
+
+void power_sleep( void )
+{
+	//interrupts masked; the wake-up still ends the WFI, its handler runs once unmasked
+	uint32_t start = cycle_counter_read();
+
+	system_sleep();
+	sleep_cycles += cycle_counter_read() - start;
+}
+
+void power_idle( void )
+{
+	//the idle hook, one interrupt's worth of sleep at a time
+	if(!sleep_enabled) return;
+
+	cpu_irq_disable();
+	power_sleep();
+	cpu_irq_enable();
+}
+
+uint16_t power_sleep_share( void )
+{
+	//per mille of the cycles since the last call spent asleep
+	uint32_t now = cycle_counter_read();
+	uint32_t slept = sleep_cycles;
+	uint32_t elapsed = now - share_start;
+	uint32_t share = 0;
+
+	if(elapsed >= 1000) share = (slept - share_slept) / (elapsed / 1000);
+	if(share > 1000) share = 1000;
+
+	share_start = now;
+	share_slept = slept;
+
+	return (uint16_t) share;
+}
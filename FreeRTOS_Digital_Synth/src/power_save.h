@@ -0,0 +1,42 @@
+/*************************************************************************************************
+                                         --POWER SAVE--
+
+	What the board draws between blocks. The render task blocks as soon as it is ahead of
+	the output, and the idle task then sleeps in IDLE 0 until the next interrupt: from its
+	hook for the short gaps, from tickless_idle.c when the kernel expects several ticks.
+	IDLE 0 stops the CPU clock only, so the DMAC, the sample clock and the SERCOMs keep the
+	audio going. Both count the cycles spent asleep, and power_sleep_share() turns them
+	into a per mille share of the time since it was last asked.
+
+	power_gate_unused() runs once the set-up is done and clears the APB clock of every
+	peripheral that is neither enabled nor has its generic clock on, so one configured for
+	later keeps its bus. A driver set up later enables its own APB clock again, as all of
+	them here do.
+
+	power_console_present() tells whether the EDBG is powered, from the level it drives on
+	the console's RX pin; with the debugger's USB unplugged the pin is pulled down, main.c
+	leaves the console USART off and printf goes nowhere.
+
+	The current itself needs a meter on the board's MCU current header; ':power' switches
+	the idle sleep off and on so both figures can be read off a running synth.
+
+*************************************************************************************************/
+
+#ifndef POWER_SAVE_H_INCLUDED
+#define POWER_SAVE_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+bool power_console_present( void );
+void power_console_discard( void );
+uint32_t power_gate_unused( void );
+void power_print_gated( uint32_t gated );
+void power_set_sleep( bool sleep );
+bool power_sleep_enabled( void );
+void power_sleep( void );
+void power_idle( void );
+uint16_t power_sleep_share( void );
+
+#endif /* POWER_SAVE_H_INCLUDED */
@@ -0,0 +1,312 @@
+/*************************************************************************************************
+                                            --PRESET--
+
+	The reserved rows are a const array of erased bytes, aligned to a row, so the linker
+	keeps code and data out of them; it is read through a volatile pointer since the
+	compiler would otherwise fold the reads to 0xFF. Each half starts with a header page
+	holding its generation, the records follow in the order they were written, one page
+	each:
+
+		0x50, program, patch length (0 deletes), checksum, patch bytes
+
+	The checksum is the inverted byte sum of program, length and patch, a page cut short by
+	power loss fails it and is skipped. The scan at boot stops at the first erased page,
+	which is where the next record goes.
+
+	Writes use the NVM controller's manual page write: clear the page buffer, fill it with
+	word stores to the page's address, then the write command, checked by reading the page
+	back after invalidating the NVM cache. A compaction erases the other half, copies the
+	live records and writes the header last, so the old half stays the newest until the new
+	one is complete.
+
+	A published patch is never written again while the engine may still be copying it:
+	preset_save() fills a spare of the SYNTH_PRESET_COUNT + 2 RAM slots, the one released
+	longest ago, and only then swaps the program's pointer to it.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include <string.h>
+#include "preset.h"
+
+#if SYNTH_PRESETS
+
+/**********  DEFINE  ************/
+#define PRESET_FLASH_SIZE		(	SYNTH_PRESET_ROWS * NVMCTRL_ROW_SIZE	)
+#define PRESET_HALF_ROWS		(	SYNTH_PRESET_ROWS / 2	)
+#define PRESET_HALF_PAGES		(	PRESET_HALF_ROWS * NVMCTRL_ROW_PAGES	)
+#define PRESET_PAGE_WORDS		(	FLASH_PAGE_SIZE / 4	)
+#define PRESET_SLOTS			(	SYNTH_PRESET_COUNT + 2	)
+
+#define PRESET_HEADER			(	0x48	)
+#define PRESET_RECORD			(	0x50	)
+#define PRESET_ERASED			(	0xFF	)
+#define PRESET_DATA				(	4	)	//patch offset in a record, 60 bytes left for it
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static const volatile uint8_t *preset_page( int half, int page );
+static uint8_t preset_checksum( const uint8_t *record );
+static bool preset_header_valid( int half, uint32_t *generation );
+static void preset_scan( int half );
+static void preset_publish( uint8_t program, const struct synth_patch *patch );
+static bool preset_append( uint8_t program, const struct synth_patch *patch );
+static bool preset_compact( void );
+static bool preset_erase_half( int half );
+static bool preset_write_page( const volatile uint8_t *page, const uint32_t *words );
+static bool preset_nvm_command( uint32_t command, const volatile uint8_t *address );
+
+
+/*******   GLOBAL VARS  *********/
+static const uint8_t preset_flash[PRESET_FLASH_SIZE] __attribute__((aligned(NVMCTRL_ROW_SIZE))) = {
+	[0 ... PRESET_FLASH_SIZE - 1] = PRESET_ERASED
+};
+
+static struct synth_patch preset_pool[PRESET_SLOTS];
+static uint32_t preset_released[PRESET_SLOTS];		//save count when the slot was last given up
+static uint32_t preset_saves;
+static const struct synth_patch *preset_table[SYNTH_PRESET_COUNT];
+
+static int preset_half;			//the half in use
+static int preset_next;			//its first erased page
+static uint32_t preset_gen;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+int preset_init( void )
+{
+	//loads the newest half into RAM and hands the table to the engine, returns how many presets
+	//it found; formats the rows when neither half is valid
+	uint32_t gen[2];
+	bool valid[2];
+	int count = 0;
+	int i;
+
+	NVMCTRL->CTRLB.reg |= NVMCTRL_CTRLB_MANW;
+
+	valid[0] = preset_header_valid(0, &gen[0]);
+	valid[1] = preset_header_valid(1, &gen[1]);
+
+	if(valid[0] || valid[1])
+	{
+		//generations wrap, the newer one is ahead by less than half the range
+		preset_half = (valid[0] && (!valid[1] || ((int32_t) (gen[0] - gen[1]) > 0))) ? 0 : 1;
+		preset_gen = gen[preset_half];
+		preset_scan(preset_half);
+	}
+	else
+	{
+		//a full half makes the first save retry the format if it fails here
+		preset_half = 1;
+		preset_gen = 0;
+		preset_next = PRESET_HALF_PAGES;
+		preset_compact();
+	}
+
+	for(i=0; i<SYNTH_PRESET_COUNT; i++) if(preset_table[i] != NULL) count++;
+	synth_set_presets(preset_table, SYNTH_PRESET_COUNT);
+	return count;
+}
+
+bool preset_save( uint8_t program, const struct synth_patch *patch )
+{
+	//stores the patch under the program, NULL deletes it; false when the flash write failed,
+	//the program then keeps what it had
+	if(program >= SYNTH_PRESET_COUNT) return false;
+
+	if(preset_next == PRESET_HALF_PAGES)
+	{
+		if(preset_compact() == false) return false;
+	}
+	if(preset_append(program, patch) == false) return false;
+
+	preset_publish(program, patch);
+	return true;
+}
+
+bool preset_stored( uint8_t program )
+{
+	return (program < SYNTH_PRESET_COUNT) && (preset_table[program] != NULL);
+}
+
+uint32_t preset_generation( void )
+{
+	return preset_gen;
+}
+
+int preset_pages_used( void )
+{
+	//of the half in use, header included
+	return preset_next;
+}
+
+static const volatile uint8_t *preset_page( int half, int page )
+{
+	return (const volatile uint8_t *) &preset_flash[(half * PRESET_HALF_PAGES + page) * FLASH_PAGE_SIZE];
+}
+
+static uint8_t preset_checksum( const uint8_t *record )
+{
+	uint8_t sum = record[1] + record[2];
+	int i;
+
+	for(i=0; i<record[2]; i++) sum += record[PRESET_DATA + i];
+	return (uint8_t) ~sum;
+}
+
+static bool preset_header_valid( int half, uint32_t *generation )
+{
+	//header: magic, three zero bytes, little-endian generation, its inverse
+	const volatile uint8_t *p = preset_page(half, 0);
+	uint32_t gen = p[4] | (p[5] << 8) | (p[6] << 16) | ((uint32_t) p[7] << 24);
+	uint32_t check = p[8] | (p[9] << 8) | (p[10] << 16) | ((uint32_t) p[11] << 24);
+
+	if((p[0] != PRESET_HEADER) || p[1] || p[2] || p[3] || (check != ~gen)) return false;
+
+	*generation = gen;
+	return true;
+}
+
+static void preset_scan( int half )
+{
+	uint32_t words[PRESET_PAGE_WORDS];
+	uint8_t *record = (uint8_t *) words;
+	const volatile uint8_t *p;
+	int page;
+	int i;
+
+	for(page=1; page<PRESET_HALF_PAGES; page++)
+	{
+		p = preset_page(half, page);
+		if(p[0] == PRESET_ERASED) break;
+
+		for(i=0; i<FLASH_PAGE_SIZE; i++) record[i] = p[i];
+		if(record[0] != PRESET_RECORD) continue;
+		if(record[1] >= SYNTH_PRESET_COUNT) continue;
+		if((record[2] != 0) && (record[2] != sizeof(struct synth_patch))) continue;
+		if(record[3] != preset_checksum(record)) continue;
+
+		preset_publish(record[1], record[2] ? (const struct synth_patch *) &record[PRESET_DATA] : NULL);
+	}
+	preset_next = page;
+}
+
+static void preset_publish( uint8_t program, const struct synth_patch *patch )
+{
+	//copies the patch into the spare slot given up longest ago, then points the program at it
+	const struct synth_patch *old = preset_table[program];
+	int slot = -1;
+	int i;
+	int j;
+
+	if(patch != NULL)
+	{
+		for(i=0; i<PRESET_SLOTS; i++)
+		{
+			for(j=0; j<SYNTH_PRESET_COUNT; j++) if(preset_table[j] == &preset_pool[i]) break;
+			if(j < SYNTH_PRESET_COUNT) continue;
+			if((slot < 0) || ((int32_t) (preset_released[i] - preset_released[slot]) < 0)) slot = i;
+		}
+		memcpy(&preset_pool[slot], patch, sizeof(struct synth_patch));
+	}
+
+	preset_saves++;
+	preset_table[program] = (patch != NULL) ? &preset_pool[slot] : NULL;
+	if(old != NULL) preset_released[old - preset_pool] = preset_saves;
+}
+
+static bool preset_append( uint8_t program, const struct synth_patch *patch )
+{
+	uint32_t words[PRESET_PAGE_WORDS];
+	uint8_t *record = (uint8_t *) words;
+
+	memset(words, PRESET_ERASED, sizeof(words));
+	record[0] = PRESET_RECORD;
+	record[1] = program;
+	record[2] = (patch != NULL) ? sizeof(struct synth_patch) : 0;
+	if(patch != NULL) memcpy(&record[PRESET_DATA], patch, sizeof(struct synth_patch));
+	record[3] = preset_checksum(record);
+
+	//a failed page is skipped at the next scan, the one after it is still free
+	return preset_write_page(preset_page(preset_half, preset_next++), words);
+}
+
+static bool preset_compact( void )
+{
+	//live presets to the other half, its header last; on a failure the old half stays in use
+	uint32_t words[PRESET_PAGE_WORDS];
+	uint8_t *record = (uint8_t *) words;
+	int half = preset_half ^ 1;
+	int page = 1;
+	int program;
+
+	if(preset_erase_half(half) == false) return false;
+
+	for(program=0; program<SYNTH_PRESET_COUNT; program++)
+	{
+		if(preset_table[program] == NULL) continue;
+
+		memset(words, PRESET_ERASED, sizeof(words));
+		record[0] = PRESET_RECORD;
+		record[1] = (uint8_t) program;
+		record[2] = sizeof(struct synth_patch);
+		memcpy(&record[PRESET_DATA], preset_table[program], sizeof(struct synth_patch));
+		record[3] = preset_checksum(record);
+		if(preset_write_page(preset_page(half, page++), words) == false) return false;
+	}
+
+	memset(words, PRESET_ERASED, sizeof(words));
+	words[0] = PRESET_HEADER;
+	words[1] = preset_gen + 1;
+	words[2] = ~(preset_gen + 1);
+	if(preset_write_page(preset_page(half, 0), words) == false) return false;
+
+	preset_half = half;
+	preset_next = page;
+	preset_gen++;
+	return true;
+}
+
+static bool preset_erase_half( int half )
+{
+	int row;
+
+	for(row=0; row<PRESET_HALF_ROWS; row++)
+	{
+		if(preset_nvm_command(NVMCTRL_CTRLA_CMD_ER, preset_page(half, row * NVMCTRL_ROW_PAGES)) == false) return false;
+	}
+	return true;
+}
+
+static bool preset_write_page( const volatile uint8_t *page, const uint32_t *words )
+{
+	//the page buffer only takes 16 and 32-bit stores
+	volatile uint32_t *dst = (volatile uint32_t *) page;
+	int i;
+
+	if(preset_nvm_command(NVMCTRL_CTRLA_CMD_PBC, page) == false) return false;
+	for(i=0; i<PRESET_PAGE_WORDS; i++) dst[i] = words[i];
+	if(preset_nvm_command(NVMCTRL_CTRLA_CMD_WP, page) == false) return false;
+
+	NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_INVALL | NVMCTRL_CTRLA_CMDEX_KEY;
+	while((NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY) == 0);
+
+	for(i=0; i<PRESET_PAGE_WORDS; i++) if(dst[i] != words[i]) return false;
+	return true;
+}
+
+static bool preset_nvm_command( uint32_t command, const volatile uint8_t *address )
+{
+	//ADDR counts 16-bit words; false on a programming, lock or NVM error
+	while((NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY) == 0);
+
+	NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+	NVMCTRL->ADDR.reg = (uint32_t) address / 2;
+	NVMCTRL->CTRLA.reg = command | NVMCTRL_CTRLA_CMDEX_KEY;
+	while((NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY) == 0);
+
+	return (NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_PROGE | NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_NVME)) == 0;
+}
+
+#endif /* SYNTH_PRESETS */
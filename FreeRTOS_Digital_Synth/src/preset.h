@@ -0,0 +1,41 @@
+/*************************************************************************************************
+                                            --PRESET--
+
+	Patch presets kept in the internal flash and recalled by program change. Program n
+	below SYNTH_PRESET_COUNT plays preset n once one has been saved, see synth_set_presets();
+	the others, and programs without a preset, only select the waveform as before.
+
+	The presets live in RAM, loaded from the flash by preset_init() at boot, so a recall
+	never touches the flash. preset_save() stores a channel's patch under a program and
+	publishes it to the engine with a single pointer store; the engine copies it at the
+	next program change for that number.
+
+	The flash side is a log in SYNTH_PRESET_ROWS rows reserved at link time, EEPROM
+	emulation without the ASF driver. Each save appends one page, the last record of a
+	program wins, and a half that is full is copied, live presets only, to the other half,
+	which gets a newer generation number once complete. Writes spread over all rows that
+	way, and a save cut off by power loss leaves the previous presets readable.
+
+	A save erases a row now and then, about 6 ms, and a compaction up to half of them; the
+	CPU stalls on any flash fetch meanwhile, so a save may cost an underrun. Save between
+	songs, recall is what is safe mid-song. preset_save() is for one task only, the console.
+	Reprogramming the firmware with a chip erase clears the presets.
+
+*************************************************************************************************/
+
+#ifndef PRESET_H_INCLUDED
+#define PRESET_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "synth_engine.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+int preset_init( void );
+bool preset_save( uint8_t program, const struct synth_patch *patch );
+bool preset_stored( uint8_t program );
+uint32_t preset_generation( void );
+int preset_pages_used( void );
+
+#endif /* PRESET_H_INCLUDED */
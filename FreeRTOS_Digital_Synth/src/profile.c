@@ -0,0 +1,121 @@
+/*************************************************************************************************
+                                           --PROFILE--
+
+	Node 0 stands for the caller of the render path and is not a stage; the nodes under it
+	are added as their paths are first entered. The stack only keeps the timer at each
+	entry, the path is the chain of parents. Entries the table or the stack has no room for
+	are counted in profile_skipped and their leaves just count them back down, so whatever
+	runs under them adds to the last stage that was counted.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <string.h>
+#include "profile.h"
+
+#if SYNTH_PROFILE
+
+/*******   GLOBAL VARS  *********/
+static const char *const profile_names[PROFILE_OSC] = {
+	"block", "control", "envelope", "events", "voices", "sub", "mix", "decimate", "output", "gain",
+	"shaper", "filter", "formant", "chorus", "delay", "reverb", "dc block", "limiter", "codes"
+};
+
+static const char *const osc_names[WAVE_TYPE_COUNT] = {
+	"square", "saw", "tri", "square blep", "saw blep", "fm", "sine", "noise", "sample", "stream",
+	"pluck", "organ", "sync", "ring", "supersaw", "morph", "drum", "grain"
+};
+
+static struct profile_node profile_table[PROFILE_NODES];
+static int profile_count;
+static uint8_t profile_current;
+static int profile_depth;
+static uint32_t profile_start[PROFILE_DEPTH];
+static uint32_t profile_skipped;
+static uint32_t (*profile_timer)( void );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void profile_set_timer( uint32_t (*cycles)( void ) )
+{
+	//without a timer the stages only count their calls
+	profile_timer = cycles;
+}
+
+void profile_reset( void )
+{
+	//between renders, not inside one
+	memset(profile_table, 0, sizeof(profile_table));
+	profile_table[0].parent = PROFILE_NONE;
+	profile_count = 1;
+	profile_current = 0;
+	profile_depth = 0;
+	profile_skipped = 0;
+}
+
+void profile_enter( enum profile_stage stage )
+{
+	struct profile_node *node = &profile_table[profile_current];
+	uint8_t next;
+
+	if(profile_count == 0) profile_reset();
+
+	if(profile_skipped || (profile_depth == PROFILE_DEPTH))
+	{
+		profile_skipped++;
+		return;
+	}
+
+	next = node->child[stage];
+	if(next == 0)
+	{
+		if(profile_count == PROFILE_NODES)
+		{
+			profile_skipped++;
+			return;
+		}
+		next = (uint8_t) profile_count++;
+		profile_table[next].parent = profile_current;
+		profile_table[next].stage = (uint8_t) stage;
+		node->child[stage] = next;
+	}
+
+	profile_current = next;
+	profile_start[profile_depth++] = (profile_timer != NULL) ? profile_timer() : 0;
+}
+
+void profile_leave( void )
+{
+	uint32_t now = (profile_timer != NULL) ? profile_timer() : 0;
+	struct profile_node *node = &profile_table[profile_current];
+	uint32_t cycles;
+
+	if(profile_skipped)
+	{
+		profile_skipped--;
+		return;
+	}
+
+	cycles = now - profile_start[--profile_depth];
+	node->calls++;
+	node->cycles += cycles;
+	profile_table[node->parent].inner += cycles;
+	profile_current = node->parent;
+}
+
+const struct profile_node *profile_nodes( int *count )
+{
+	//node 0 is the caller, the stages start at 1
+	*count = profile_count;
+	return profile_table;
+}
+
+const char *profile_stage_name( enum profile_stage stage )
+{
+	if(stage >= PROFILE_STAGE_COUNT) return "?";
+	if(stage >= PROFILE_OSC) return osc_names[stage - PROFILE_OSC];
+
+	return profile_names[stage];
+}
+
+#endif /* SYNTH_PROFILE */
@@ -0,0 +1,94 @@
+/*************************************************************************************************
+                                           --PROFILE--
+
+	Stage profiler for the render path, for finding its hot spots on the desktop before
+	touching the board. Built in with SYNTH_PROFILE, which only the host tools set. The
+	engine marks its stages with PROFILE_ENTER() and PROFILE_LEAVE(), and without
+	SYNTH_PROFILE they compile to nothing:
+
+		block			synth_render_block(), once a block
+		 control		the control tick, the envelopes' tick inside it
+		 events			applying the queued events
+		 voices			the voice loops: the sub-oscillators, one stage per waveform with
+						the stereo pan into the mix inside it, and the decimator
+		 output			the master chain of each channel, one stage per effect
+
+	Every path of stages from the block down is counted on its own, so the pan under the
+	saw voices and the pan under the sines are two entries. A path's entry has its calls,
+	the cycles spent in it and the cycles spent in the stages under it, from the timer
+	profile_set_timer() is given; the host renderer gives the processor's time stamp
+	counter, which counts at about the core clock. The mono voices add into the mix in the
+	kernels' own loops, so their mixing counts to the waveform's stage.
+
+	The marks cost two reads of the timer each, which land in the stage around them. The
+	paths are kept in a table of PROFILE_NODES entries with a lookup per stage, so the
+	profiler needs some kilobytes of RAM and is a host tool only. A path past the table, or
+	deeper than PROFILE_DEPTH, counts to the stage it would have been under.
+
+*************************************************************************************************/
+
+#ifndef PROFILE_H_INCLUDED
+#define PROFILE_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+#include "synth_engine.h"
+
+/**********  DEFINE  ************/
+#define PROFILE_NODES			(	128	)
+#define PROFILE_DEPTH			(	8	)
+
+//the root's parent
+#define PROFILE_NONE			(	0xFF	)
+
+#if SYNTH_PROFILE
+#  define PROFILE_ENTER(stage)	profile_enter(stage)
+#  define PROFILE_LEAVE()		profile_leave()
+#else
+#  define PROFILE_ENTER(stage)
+#  define PROFILE_LEAVE()
+#endif
+
+/********   TYPE DEFS  **********/
+enum profile_stage{
+	PROFILE_BLOCK,
+	PROFILE_CONTROL,
+	PROFILE_ENVELOPE,
+	PROFILE_EVENTS,
+	PROFILE_VOICES,
+	PROFILE_SUB,
+	PROFILE_MIX,
+	PROFILE_DECIMATE,
+	PROFILE_OUTPUT,
+	PROFILE_GAIN,
+	PROFILE_SHAPER,
+	PROFILE_FILTER,
+	PROFILE_FORMANT,
+	PROFILE_CHORUS,
+	PROFILE_DELAY,
+	PROFILE_REVERB,
+	PROFILE_DC_BLOCK,
+	PROFILE_LIMITER,
+	PROFILE_CODES,
+	PROFILE_OSC,			//plus the waveform
+	PROFILE_STAGE_COUNT = PROFILE_OSC + WAVE_TYPE_COUNT
+};
+
+struct profile_node{
+	uint8_t parent;
+	uint8_t stage;
+	uint8_t child[PROFILE_STAGE_COUNT];		//node of each stage entered from here, 0 none yet
+	uint32_t calls;
+	uint64_t cycles;		//in the stage and the ones under it
+	uint64_t inner;			//in the ones under it
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void profile_set_timer( uint32_t (*cycles)( void ) );
+void profile_reset( void );
+void profile_enter( enum profile_stage stage );
+void profile_leave( void );
+const struct profile_node *profile_nodes( int *count );
+const char *profile_stage_name( enum profile_stage stage );
+
+#endif /* PROFILE_H_INCLUDED */
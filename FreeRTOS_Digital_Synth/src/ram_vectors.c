@@ -0,0 +1,42 @@
+/*************************************************************************************************
+                                         --RAM VECTORS--
+
+	The copy is taken with interrupts masked, and VTOR moves only once it is complete, so an
+	interrupt never finds a half-written table.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "ram_vectors.h"
+
+
+/**********  DEFINE  ************/
+#define RAM_VECTORS_COUNT		(	16 + PERIPH_COUNT_IRQn	)
+#define RAM_VECTORS_ALIGN		(	256	)
+
+
+/*******   GLOBAL VARS  *********/
+static void (*ram_vectors[RAM_VECTORS_COUNT])( void ) __attribute__((aligned(RAM_VECTORS_ALIGN)));
+_Static_assert(sizeof(ram_vectors) <= RAM_VECTORS_ALIGN, "RAM_VECTORS_ALIGN must be the vector table's size rounded up to a power of two");
+static bool ram_vectors_active;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void ram_vectors_set( IRQn_Type irq, void (*handler)( void ) )
+{
+	void (*const *boot_vectors)( void ) = (void (*const *)( void )) SCB->VTOR;
+	irqflags_t flags;
+	int i;
+
+	flags = cpu_irq_save();
+	if(!ram_vectors_active)
+	{
+		for(i=0; i<RAM_VECTORS_COUNT; i++) ram_vectors[i] = boot_vectors[i];
+		__DMB();
+		SCB->VTOR = (uint32_t) ram_vectors;
+		__DSB();
+		ram_vectors_active = true;
+	}
+	ram_vectors[16 + irq] = handler;
+	cpu_irq_restore(flags);
+}
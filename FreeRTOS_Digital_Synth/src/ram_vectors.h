@@ -0,0 +1,22 @@
+/*************************************************************************************************
+                                         --RAM VECTORS--
+
+	A copy of the vector table in SRAM, for an interrupt that must not go through a
+	driver's dispatch. The first ram_vectors_set() copies the table the part booted with and
+	points VTOR at the copy; from then on each call replaces one peripheral's entry. The
+	handler is entered straight from the NVIC, with nothing of ASF in front of it.
+
+	The M0+ wants the table aligned to its size rounded up to a power of two, 256 bytes for
+	the SAMD21's 16 + 28 entries.
+
+*************************************************************************************************/
+
+#ifndef RAM_VECTORS_H_INCLUDED
+#define RAM_VECTORS_H_INCLUDED
+
+#include <asf.h>
+
+/****** FUNCTION PROTOTYPES  ****/
+void ram_vectors_set( IRQn_Type irq, void (*handler)( void ) );
+
+#endif /* RAM_VECTORS_H_INCLUDED */
@@ -0,0 +1,41 @@
+/*************************************************************************************************
+                                            --RAMP--
+
+	Control-rate values that are read per sample, moved in a straight line across the control
+	period instead of a step at its start. A value set once a tick is the start of its ramp
+	plus a step per sample, so the loop that reads it pays one add a sample and the period
+	boundary has no zipper. The voices' gains have always been ramped this way, with the
+	envelope's start and end of the tick; the master filter's cutoff and the voices' pan
+	gains go through ramp_begin() below.
+
+	ramp_begin() is called once per control period before the samples: it works out the step
+	from where the value is to its target, and moves the value by what the step's truncation
+	leaves over, so SYNTH_CONTROL_PERIOD steps land exactly on the target and a ramp that has
+	arrived stays put with a step of 0. A render cut short of the period (a silent period
+	that is skipped) is picked up from wherever it stopped by the next call.
+
+*************************************************************************************************/
+
+#ifndef RAMP_H_INCLUDED
+#define RAMP_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+#include "recip.h"
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline int32_t ramp_begin( int32_t *value, int32_t target )
+{
+	//the step a sample that takes *value to target over one control period
+	int32_t distance = target - *value;
+	int32_t step;
+
+	if(distance == 0) return 0;
+
+	step = recip_div(distance, SYNTH_CONTROL_PERIOD);
+	*value = target - step * SYNTH_CONTROL_PERIOD;
+
+	return step;
+}
+
+#endif /* RAMP_H_INCLUDED */
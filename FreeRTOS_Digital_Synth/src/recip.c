@@ -0,0 +1,91 @@
+/*************************************************************************************************
+                                         --RECIPROCALS--
+
+	The tables are worked out by the compiler. A seed from the top 9 bits of a normalized
+	divisor is low by at most 256, the Newton step brings that within one, checked for every
+	divisor from 2^14 to 2^15 against 2^30 / d.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "recip.h"
+
+
+/**********  DEFINE  ************/
+#define RECIP(d)				(	0xFFFFFFFFul / ((d) | !(d))	)
+#define RECIP_8(d)				RECIP(d), RECIP(d + 1), RECIP(d + 2), RECIP(d + 3), RECIP(d + 4), RECIP(d + 5), RECIP(d + 6), RECIP(d + 7)
+#define RECIP_32(d)				RECIP_8(d), RECIP_8(d + 8), RECIP_8(d + 16), RECIP_8(d + 24)
+
+//2^30 / the top of each step of 64 from 2^14 up, never above the quotient
+#define RECIP_SEED(i)			(	(uint16_t) ((1ul << 30) / (((i) + 257) << 6))	)
+#define RECIP_SEED_8(i)			RECIP_SEED(i), RECIP_SEED(i + 1), RECIP_SEED(i + 2), RECIP_SEED(i + 3), RECIP_SEED(i + 4), RECIP_SEED(i + 5), RECIP_SEED(i + 6), RECIP_SEED(i + 7)
+#define RECIP_SEED_64(i)		RECIP_SEED_8(i), RECIP_SEED_8(i + 8), RECIP_SEED_8(i + 16), RECIP_SEED_8(i + 24), RECIP_SEED_8(i + 32), RECIP_SEED_8(i + 40), RECIP_SEED_8(i + 48), RECIP_SEED_8(i + 56)
+
+
+/*******   GLOBAL VARS  *********/
+const uint32_t recip_table[RECIP_TABLE_SIZE] = {
+	RECIP_32(0), RECIP_32(32), RECIP_32(64), RECIP_32(96)
+};
+
+#if !SYNTH_PART_DIVIDE
+static const uint16_t recip_seed[256] = {
+	RECIP_SEED_64(0), RECIP_SEED_64(64), RECIP_SEED_64(128), RECIP_SEED_64(192)
+};
+#endif
+
+
+/***  APPLICATION FUNCTIONS  ****/
+SYNTH_RAM_CODE uint32_t recip_fraction( uint32_t num, uint32_t den, int bits )
+{
+	//(num << bits) / den for num < den <= 2^31, one quotient bit per step
+	uint32_t q = 0;
+
+	while(bits--)
+	{
+		num <<= 1;
+		q <<= 1;
+		if(num >= den)
+		{
+			num -= den;
+			q |= 1;
+		}
+	}
+
+	return q;
+}
+
+#if SYNTH_PART_DIVIDE
+SYNTH_RAM_CODE uint32_t recip_q30( uint32_t d )
+{
+	//2^30 / d, 0 for 0
+	return (d == 0) ? 0 : (1ul << 30) / d;
+}
+#else
+SYNTH_RAM_CODE uint32_t recip_q30( uint32_t d )
+{
+	//2^30 / d for d < 2^15, 0 for 0
+	uint32_t q;
+	uint32_t e;
+	int shift = 0;
+
+	if(d == 0) return 0;
+
+	//only sub-hertz increments come in below 2^14, scaled up and filled in a bit at a time
+	while(d < (1ul << 14))
+	{
+		d <<= 1;
+		shift++;
+	}
+
+	q = recip_seed[(d >> 6) - 256];
+	e = (1ul << 30) - q * d;
+	q += ((e >> 7) * q) >> 23;
+	if((q + 1) * d <= (1ul << 30)) q++;
+
+	d >>= shift;
+	q <<= shift;
+	while(shift--) if((q + (1ul << shift)) * d <= (1ul << 30)) q += 1ul << shift;
+
+	return q;
+}
+#endif
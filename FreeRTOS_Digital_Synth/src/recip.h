@@ -0,0 +1,80 @@
+/*************************************************************************************************
+                                         --RECIPROCALS--
+
+	Division for the render path without a divide: the M0+ has no divider, and a '/' by
+	anything but a constant power of two is a call to libgcc's shift and subtract loop.
+	These give the same truncated quotients as '/', so the output does not change by a code:
+
+	recip_div() divides by a small integer, below RECIP_TABLE_SIZE, with one multiply by its
+	reciprocal from a flash table and one correction step; a constant power of two still
+	compiles to a shift. recip_apply() is the same for any divisor whose reciprocal,
+	recip_of(), is worked out beforehand, where the divisor changes with a setting.
+	recip_fraction() is num / den in 'bits' fractional bits for num < den, the quotient bit
+	by bit with shifts and subtracts, and recip_q30() is 2^30 / d from a seed table, one
+	Newton step and one correction.
+
+	On the parts with a divide instruction (SYNTH_PART_DIVIDE, conf_part.h) recip_div(),
+	recip_apply() and recip_q30() are a plain '/', which is the faster there.
+
+	tools/check_divides.py looks for any libgcc divide called from the .ramfunc code.
+
+*************************************************************************************************/
+
+#ifndef RECIP_H_INCLUDED
+#define RECIP_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define RECIP_TABLE_SIZE		(	128	)
+
+#if (SYNTH_CONTROL_PERIOD >= RECIP_TABLE_SIZE)
+#  error "recip_div() takes segment lengths below RECIP_TABLE_SIZE"
+#endif
+
+/*******   GLOBAL VARS  *********/
+//0xFFFFFFFF / d, entry 0 unused
+extern const uint32_t recip_table[RECIP_TABLE_SIZE];
+
+/****** FUNCTION PROTOTYPES  ****/
+uint32_t recip_fraction( uint32_t num, uint32_t den, int bits );
+uint32_t recip_q30( uint32_t d );
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline uint32_t recip_of( uint32_t d )
+{
+	//a division, for when the divisor is set, never per sample
+	return 0xFFFFFFFFul / d;
+}
+
+static inline int32_t recip_apply( int32_t x, uint32_t d, uint32_t recip )
+{
+	//x / d, truncated towards zero; the product is at most one short of the quotient
+#if SYNTH_PART_DIVIDE
+	(void) recip;
+	return x / (int32_t) d;
+#else
+	uint32_t n = (x < 0) ? -(uint32_t) x : (uint32_t) x;
+	uint32_t q = (uint32_t) (((uint64_t) n * recip) >> 32);
+
+	if(n - q * d >= d) q++;
+
+	return (x < 0) ? -(int32_t) q : (int32_t) q;
+#endif
+}
+
+static inline int32_t recip_div( int32_t x, int d )
+{
+	//x / d for 0 < d < RECIP_TABLE_SIZE
+#if SYNTH_PART_DIVIDE
+	return x / d;
+#else
+#  if defined(__GNUC__)
+	if(__builtin_constant_p(d) && ((d & (d - 1)) == 0)) return x / d;
+#  endif
+	return recip_apply(x, (uint32_t) d, recip_table[d]);
+#endif
+}
+
+#endif /* RECIP_H_INCLUDED */
@@ -0,0 +1,558 @@
+/*************************************************************************************************
+                                           --RECORDER--
+
+	The reserved rows are a const array of erased bytes, aligned to a row, read through a
+	volatile pointer like the presets' (see preset.c). Page 0 is the header of the take,
+	written last:
+
+		magic, sample rate, data pages, events, length in samples, check word
+
+	the check being the inverse of the others XORed. The data pages follow, each a byte
+	count and then whole records, none runs on into the next page:
+
+		delta time, status, data bytes
+
+	The delta is the samples since the previous event as a MIDI file variable-length
+	quantity, most significant 7 bits first with the top bit set on all but the last byte;
+	a gap too long for 4 bytes, over 3 hours, is shortened to what fits. A channel message
+	has the usual status byte with its channel and 1 or 2 data bytes, and leaves its status
+	out when it is the previous channel message's, which restarts with every page. Of the
+	system events the tuning ones have their key or pitch class and data bytes, realtime
+	bytes stand alone.
+
+	Recording fills RECORDER_RAM_PAGES pages in RAM from the MIDI task, which recorder_job()
+	writes to the flash in the console task; a row is erased as its first page comes up.
+	An event that finds no free page is dropped and counted, the next one's delta spans the
+	gap. Each side's state changes are short critical sections.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "recorder.h"
+#include "synth_engine.h"
+#include "trace_log.h"
+
+#if SYNTH_RECORDER
+
+/**********  DEFINE  ************/
+#define RECORDER_FLASH_SIZE		(	SYNTH_RECORDER_ROWS * NVMCTRL_ROW_SIZE	)
+#define RECORDER_PAGES			(	SYNTH_RECORDER_ROWS * NVMCTRL_ROW_PAGES	)	//header included
+#define RECORDER_PAGE_WORDS		(	FLASH_PAGE_SIZE / 4	)
+#define RECORDER_PAGE_DATA		(	FLASH_PAGE_SIZE - 1	)
+#define RECORDER_RAM_PAGES		(	4	)
+#define RECORDER_RECORD_MAX		(	8	)	//4 delta bytes, a status and 3 data bytes
+#define RECORDER_DELTA_MAX		(	0x0FFFFFFF	)
+#define RECORDER_HEADER_WORDS	(	6	)
+
+#define RECORDER_MAGIC			(	0x31434552	)	//"REC1"
+#define RECORDER_ERASED			(	0xFF	)
+#define RECORDER_CHANNELS		(	16	)
+
+
+/********   TYPE DEFS  **********/
+enum recorder_state{
+	RECORDER_IDLE,
+	RECORDER_RECORDING,
+	RECORDER_STOPPING,		//the console task writes out what is left
+	RECORDER_REPLAYING,
+	RECORDER_RELEASING,		//a replay stopped, the MIDI task sends All Notes Off
+};
+
+struct recorder_take{
+	uint32_t magic;
+	uint32_t sample_rate;
+	uint32_t pages;
+	uint32_t events;
+	uint32_t length;
+	uint32_t check;
+};
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static const volatile uint8_t *recorder_page( int page );
+static uint32_t recorder_check( const struct recorder_take *header );
+static void recorder_page_open( uint8_t *page );
+static int recorder_encode( uint8_t *out, uint32_t delta, const struct midi_event *event, uint8_t *status );
+static bool recorder_decode( struct midi_event *event, uint32_t *delta );
+static bool recorder_flush_page( void );
+static bool recorder_write_header( void );
+static bool recorder_write_page( const volatile uint8_t *page, const uint32_t *words );
+static bool recorder_nvm_command( uint32_t command, const volatile uint8_t *address );
+
+
+/*******   GLOBAL VARS  *********/
+static const uint8_t recorder_flash[RECORDER_FLASH_SIZE] __attribute__((aligned(NVMCTRL_ROW_SIZE))) = {
+	[0 ... RECORDER_FLASH_SIZE - 1] = RECORDER_ERASED
+};
+
+static volatile enum recorder_state recorder_state;
+static struct recorder_take take;			//the last complete one, magic 0 if none
+
+//recording: pages rec_tail up to rec_head are full, rec_head is being filled
+static uint32_t rec_ram[RECORDER_RAM_PAGES][RECORDER_PAGE_WORDS];
+static volatile uint32_t rec_head;
+static volatile uint32_t rec_tail;
+static uint32_t rec_start;
+static uint32_t rec_time;					//of the last event recorded
+static uint32_t rec_events;
+static uint32_t rec_dropped;
+static uint8_t rec_status;
+static bool rec_full;
+
+//replay
+static int play_page;
+static int play_offset;
+static uint8_t play_status;
+static bool play_started;
+static bool play_pending;
+static struct midi_event play_next;
+static uint32_t play_time;
+static uint32_t play_rate;
+static uint8_t play_release;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void recorder_init( void )
+{
+	//the take the flash holds, if it has a valid one
+	const volatile uint8_t *p = recorder_page(0);
+	uint32_t *words = (uint32_t *) &take;
+	int i;
+
+	NVMCTRL->CTRLB.reg |= NVMCTRL_CTRLB_MANW;
+
+	for(i=0; i<RECORDER_HEADER_WORDS; i++) words[i] = p[4*i] | (p[4*i + 1] << 8) | (p[4*i + 2] << 16) | ((uint32_t) p[4*i + 3] << 24);
+	if((take.magic != RECORDER_MAGIC) || (take.check != recorder_check(&take)) || (take.pages >= RECORDER_PAGES) || (take.sample_rate == 0))
+	{
+		take.magic = 0;
+	}
+
+	recorder_state = RECORDER_IDLE;
+}
+
+bool recorder_record( uint32_t now )
+{
+	//console task: drops the last take and records from render time 'now' on; false while
+	//busy or when the flash does not erase
+	if(recorder_state != RECORDER_IDLE) return false;
+
+	take.magic = 0;
+	if(recorder_nvm_command(NVMCTRL_CTRLA_CMD_ER, recorder_page(0)) == false) return false;
+
+	rec_head = 0;
+	rec_tail = 0;
+	rec_start = now;
+	rec_time = now;
+	rec_events = 0;
+	rec_dropped = 0;
+	rec_status = 0;
+	rec_full = false;
+	recorder_page_open((uint8_t *) rec_ram[0]);
+
+	taskENTER_CRITICAL();
+	recorder_state = RECORDER_RECORDING;
+	taskEXIT_CRITICAL();
+
+	return true;
+}
+
+bool recorder_replay_start( void )
+{
+	//console task: false without a take or while busy
+	bool started = false;
+
+	taskENTER_CRITICAL();
+	if((recorder_state == RECORDER_IDLE) && (take.magic == RECORDER_MAGIC))
+	{
+		play_page = 0;
+		play_offset = 0;
+		play_status = 0;
+		play_started = false;
+		play_pending = false;
+		play_rate = synth_sample_rate();
+		recorder_state = RECORDER_REPLAYING;
+		started = true;
+	}
+	taskEXIT_CRITICAL();
+
+	return started;
+}
+
+void recorder_stop( void )
+{
+	//console task: a take is written out by the jobs to come, a replay lets go of its notes
+	taskENTER_CRITICAL();
+	if(recorder_state == RECORDER_RECORDING) recorder_state = RECORDER_STOPPING;
+	else if(recorder_state == RECORDER_REPLAYING)
+	{
+		play_release = 0;
+		recorder_state = RECORDER_RELEASING;
+	}
+	taskEXIT_CRITICAL();
+}
+
+bool recorder_busy( void )
+{
+	return recorder_state != RECORDER_IDLE;
+}
+
+bool recorder_replaying( void )
+{
+	//the MIDI task has to look in every tick
+	return (recorder_state == RECORDER_REPLAYING) || (recorder_state == RECORDER_RELEASING);
+}
+
+uint32_t recorder_take_events( void )
+{
+	return (take.magic == RECORDER_MAGIC) ? take.events : 0;
+}
+
+uint32_t recorder_take_seconds( void )
+{
+	return (take.magic == RECORDER_MAGIC) ? take.length / take.sample_rate : 0;
+}
+
+uint32_t recorder_dropped( void )
+{
+	//of the last take
+	return rec_dropped;
+}
+
+void recorder_event( const struct midi_event *event, uint32_t time )
+{
+	//MIDI task, an event for the engine at render time 'time'
+	uint8_t record[RECORDER_RECORD_MAX];
+	uint8_t status;
+	uint8_t *page;
+	uint32_t delta;
+	int n;
+
+	if(recorder_state != RECORDER_RECORDING) return;
+
+	taskENTER_CRITICAL();
+	if(recorder_state == RECORDER_RECORDING)
+	{
+		delta = time - rec_time;
+		if((int32_t) delta < 0) delta = 0;
+		if(delta > RECORDER_DELTA_MAX) delta = RECORDER_DELTA_MAX;
+
+		page = (uint8_t *) rec_ram[rec_head % RECORDER_RAM_PAGES];
+		status = rec_status;
+		n = recorder_encode(record, delta, event, &status);
+		if(page[0] + n > RECORDER_PAGE_DATA)
+		{
+			//the next page, in RAM and in the flash, with the full status byte
+			if((rec_head + 1 - rec_tail >= RECORDER_RAM_PAGES) || (rec_head + 2 >= RECORDER_PAGES))
+			{
+				if(rec_head + 2 >= RECORDER_PAGES) rec_full = true;
+				rec_dropped++;
+				n = 0;
+			}
+			else
+			{
+				rec_head++;
+				page = (uint8_t *) rec_ram[rec_head % RECORDER_RAM_PAGES];
+				recorder_page_open(page);
+				status = 0;
+				n = recorder_encode(record, delta, event, &status);
+			}
+		}
+
+		if(n != 0)
+		{
+			memcpy(&page[1 + page[0]], record, n);
+			page[0] += n;
+			rec_status = status;
+			rec_time = time;
+			rec_events++;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+int recorder_replay( uint32_t now, struct midi_event *events, uint32_t *times, int max )
+{
+	//MIDI task: the events due by render time 'now', at most 'max', with their times
+	uint32_t delta;
+	int count = 0;
+
+	taskENTER_CRITICAL();
+	if(recorder_state == RECORDER_RELEASING)
+	{
+		while((count < max) && (play_release < RECORDER_CHANNELS))
+		{
+			events[count].status = MIDI_CONTROL_CHANGE;
+			events[count].channel = play_release++;
+			events[count].data1 = MIDI_CC_ALL_NOTES_OFF;
+			events[count].data2 = 0;
+			times[count++] = now;
+		}
+		if(play_release == RECORDER_CHANNELS) recorder_state = RECORDER_IDLE;
+	}
+
+	if(recorder_state == RECORDER_REPLAYING)
+	{
+		//the take's start is the first look
+		if(play_started == false)
+		{
+			play_time = now;
+			play_started = true;
+		}
+
+		while(count < max)
+		{
+			if(play_pending == false)
+			{
+				if(recorder_decode(&play_next, &delta) == false)
+				{
+					recorder_state = RECORDER_IDLE;
+					trace_log("recorder: replay done\r\n", 0);
+					break;
+				}
+				if(take.sample_rate != play_rate) delta = (uint32_t) (((uint64_t) delta * play_rate + take.sample_rate / 2) / take.sample_rate);
+				play_time += delta;
+				play_pending = true;
+			}
+			if((int32_t) (play_time - now) > 0) break;
+
+			events[count] = play_next;
+			times[count++] = play_time;
+			play_pending = false;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return count;
+}
+
+void recorder_job( void )
+{
+	//console task job, every pass: full pages to the flash, and the header once a stopped
+	//take is all there
+	bool stop = false;
+
+	if(rec_full && (recorder_state == RECORDER_RECORDING))
+	{
+		recorder_stop();
+		trace_log("recorder: flash full, take stopped\r\n", 0);
+	}
+	if((recorder_state != RECORDER_RECORDING) && (recorder_state != RECORDER_STOPPING)) return;
+
+	while(rec_tail != rec_head)
+	{
+		if(recorder_flush_page() == false) break;
+	}
+
+	//the MIDI task is done with the last page once the state says so
+	taskENTER_CRITICAL();
+	if(recorder_state == RECORDER_STOPPING)
+	{
+		if((rec_tail == rec_head) && (((uint8_t *) rec_ram[rec_head % RECORDER_RAM_PAGES])[0] != 0))
+		{
+			rec_head++;
+			recorder_page_open((uint8_t *) rec_ram[rec_head % RECORDER_RAM_PAGES]);
+		}
+		stop = true;
+	}
+	taskEXIT_CRITICAL();
+	if(stop == false) return;
+
+	while(rec_tail != rec_head)
+	{
+		if(recorder_flush_page() == false) break;
+	}
+	if(rec_tail != rec_head) return;
+
+	if(recorder_write_header()) trace_log("recorder: take of %lu events saved\r\n", take.events);
+	else trace_log("recorder: flash write failed, take lost\r\n", 0);
+	recorder_state = RECORDER_IDLE;
+}
+
+static const volatile uint8_t *recorder_page( int page )
+{
+	return (const volatile uint8_t *) &recorder_flash[page * FLASH_PAGE_SIZE];
+}
+
+static uint32_t recorder_check( const struct recorder_take *header )
+{
+	return ~(header->magic ^ header->sample_rate ^ header->pages ^ header->events ^ header->length);
+}
+
+static void recorder_page_open( uint8_t *page )
+{
+	memset(page, RECORDER_ERASED, FLASH_PAGE_SIZE);
+	page[0] = 0;
+}
+
+static int recorder_encode( uint8_t *out, uint32_t delta, const struct midi_event *event, uint8_t *status )
+{
+	//one record, returns its length; 'status' is the running status before and after
+	uint8_t groups[4];
+	uint8_t byte;
+	int count = 0;
+	int n = 0;
+
+	do
+	{
+		groups[count++] = delta & 0x7F;
+		delta >>= 7;
+	} while(delta != 0);
+	while(count > 1) out[n++] = groups[--count] | 0x80;
+	out[n++] = groups[0];
+
+	if(event->status < MIDI_SYSEX_START)
+	{
+		byte = event->status | event->channel;
+		if(byte != *status) out[n++] = byte;
+		*status = byte;
+		out[n++] = event->data1 & 0x7F;
+		if((event->status != MIDI_PROGRAM_CHANGE) && (event->status != MIDI_CHANNEL_PRESSURE)) out[n++] = event->data2 & 0x7F;
+	}
+	else
+	{
+		out[n++] = event->status;
+		if((event->status == MIDI_TUNING_NOTE) || (event->status == MIDI_TUNING_SCALE))
+		{
+			out[n++] = event->channel & 0x7F;
+			out[n++] = event->data1 & 0x7F;
+		}
+		if(event->status == MIDI_TUNING_NOTE) out[n++] = event->data2 & 0x7F;
+	}
+
+	return n;
+}
+
+static bool recorder_decode( struct midi_event *event, uint32_t *delta )
+{
+	//the next record of the take, false at its end or on a record that does not parse
+	const volatile uint8_t *page;
+	uint8_t byte;
+	int n;
+
+	while(1)
+	{
+		if(play_page >= (int) take.pages) return false;
+		page = recorder_page(1 + play_page);
+		if((page[0] <= RECORDER_PAGE_DATA) && (play_offset < page[0])) break;
+
+		play_page++;
+		play_offset = 0;
+		play_status = 0;
+	}
+	page++;
+	n = play_offset;
+
+	*delta = 0;
+	do
+	{
+		byte = page[n++];
+		*delta = (*delta << 7) | (byte & 0x7F);
+	} while((byte & 0x80) && (n < RECORDER_PAGE_DATA));
+
+	byte = page[n];
+	if(byte & 0x80) n++;
+	else byte = play_status;
+	if(byte == 0) return false;
+
+	event->channel = 0;
+	event->data1 = 0;
+	event->data2 = 0;
+	if(byte < MIDI_SYSEX_START)
+	{
+		play_status = byte;
+		event->status = byte & 0xF0;
+		event->channel = byte & 0x0F;
+		event->data1 = page[n++];
+		if((event->status != MIDI_PROGRAM_CHANGE) && (event->status != MIDI_CHANNEL_PRESSURE)) event->data2 = page[n++];
+	}
+	else
+	{
+		event->status = byte;
+		if((byte == MIDI_TUNING_NOTE) || (byte == MIDI_TUNING_SCALE))
+		{
+			event->channel = page[n++];
+			event->data1 = page[n++];
+		}
+		if(byte == MIDI_TUNING_NOTE) event->data2 = page[n++];
+	}
+
+	play_offset = n;
+	return true;
+}
+
+static bool recorder_flush_page( void )
+{
+	//the oldest full RAM page to its place in the flash, erasing the row it starts; a failed
+	//write ends the take, the header is never written
+	int page = 1 + (int) rec_tail;
+	bool written = true;
+
+	if((page % NVMCTRL_ROW_PAGES) == 0) written = recorder_nvm_command(NVMCTRL_CTRLA_CMD_ER, recorder_page(page));
+	if(written) written = recorder_write_page(recorder_page(page), rec_ram[rec_tail % RECORDER_RAM_PAGES]);
+	if(written)
+	{
+		rec_tail++;
+		return true;
+	}
+
+	taskENTER_CRITICAL();
+	recorder_state = RECORDER_IDLE;
+	taskEXIT_CRITICAL();
+	trace_log("recorder: flash write failed, take lost\r\n", 0);
+	return false;
+}
+
+static bool recorder_write_header( void )
+{
+	uint32_t words[RECORDER_PAGE_WORDS];
+
+	take.magic = RECORDER_MAGIC;
+	take.sample_rate = synth_sample_rate();
+	take.pages = rec_head;
+	take.events = rec_events;
+	take.length = rec_time - rec_start;
+	take.check = recorder_check(&take);
+
+	memset(words, RECORDER_ERASED, sizeof(words));
+	memcpy(words, &take, sizeof(take));
+	if(recorder_write_page(recorder_page(0), words)) return true;
+
+	take.magic = 0;
+	return false;
+}
+
+static bool recorder_write_page( const volatile uint8_t *page, const uint32_t *words )
+{
+	//the page buffer only takes 16 and 32-bit stores
+	volatile uint32_t *dst = (volatile uint32_t *) page;
+	int i;
+
+	if(recorder_nvm_command(NVMCTRL_CTRLA_CMD_PBC, page) == false) return false;
+	for(i=0; i<RECORDER_PAGE_WORDS; i++) dst[i] = words[i];
+	if(recorder_nvm_command(NVMCTRL_CTRLA_CMD_WP, page) == false) return false;
+
+	NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_INVALL | NVMCTRL_CTRLA_CMDEX_KEY;
+	while((NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY) == 0);
+
+	for(i=0; i<RECORDER_PAGE_WORDS; i++) if(dst[i] != words[i]) return false;
+	return true;
+}
+
+static bool recorder_nvm_command( uint32_t command, const volatile uint8_t *address )
+{
+	//ADDR counts 16-bit words; false on a programming, lock or NVM error
+	while((NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY) == 0);
+
+	NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+	NVMCTRL->ADDR.reg = (uint32_t) address / 2;
+	NVMCTRL->CTRLA.reg = command | NVMCTRL_CTRLA_CMDEX_KEY;
+	while((NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY) == 0);
+
+	return (NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_PROGE | NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_NVME)) == 0;
+}
+
+#endif /* SYNTH_RECORDER */
@@ -0,0 +1,46 @@
+/*************************************************************************************************
+                                           --RECORDER--
+
+	Records a performance as the MIDI events the engine was handed, with the sample each one
+	arrived at, to rows of the internal flash reserved at link time; and replays it through
+	the MIDI task, which queues the events for the same samples relative to the start. A
+	take is a few bytes per event, so the flash keeps up with any playing, and a replay
+	renders exactly what the recording did from the same patch and state.
+
+	recorder_record() starts a take from the console, replacing the last one, and
+	recorder_stop() ends it; the take only counts once its header is written after the stop,
+	a take cut short by power loss is gone. The MIDI task hands every event it posts to
+	recorder_event(), the ones the RX interrupt posts itself included, and asks
+	recorder_replay() for the events due while a replay runs. recorder_job() does the flash
+	writes, from the console task, the same one that saves presets.
+
+	Like a preset save, a page write stalls the CPU on flash fetches for a few milliseconds
+	and a row erase, once every four pages, for about 6 ms; a busy take may cost an
+	underrun now and then. A replay only reads. A take recorded at another sample rate
+	replays at its own tempo, the times scaled to the current rate.
+
+*************************************************************************************************/
+
+#ifndef RECORDER_H_INCLUDED
+#define RECORDER_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void recorder_init( void );
+bool recorder_record( uint32_t now );
+bool recorder_replay_start( void );
+void recorder_stop( void );
+bool recorder_busy( void );
+bool recorder_replaying( void );
+void recorder_event( const struct midi_event *event, uint32_t time );
+int recorder_replay( uint32_t now, struct midi_event *events, uint32_t *times, int max );
+void recorder_job( void );
+uint32_t recorder_take_events( void );
+uint32_t recorder_take_seconds( void );
+uint32_t recorder_dropped( void );
+
+#endif /* RECORDER_H_INCLUDED */
@@ -0,0 +1,66 @@
+/*************************************************************************************************
+                                           --REVERB--
+
+	Small room on the master mix, a Schroeder network at half the sample rate: the input
+	pair averaged into REVERB_COMBS feedback combs in parallel, each with a one-pole low-pass
+	in its loop for damping, their mean through REVERB_ALLPASSES all-passes in series for
+	diffusion. The output is linearly interpolated back up to the full rate and added to the
+	dry signal scaled by mix, so the tail's top octave is given up for half the cost and
+	twice the room per byte.
+
+	All the lines are carved out of one buffer of 16-bit samples in the proportions of the
+	Freeverb tunings, so the buffer length alone sets the room size and the SRAM it takes;
+	at 1280 samples and 20 kHz the combs are 24 to 29 ms. Lengths are in samples of the half
+	rate, a lower sample rate makes the room larger. A spread shortens every line a little
+	so a second channel's tail does not sound in step with the first.
+
+	Like the delay it counts the steps since anything but zero was written, and once that
+	covers every line a silent block through it stays silent. With the mix at zero it is
+	skipped outright, and emptied on the way there.
+
+*************************************************************************************************/
+
+#ifndef REVERB_H_INCLUDED
+#define REVERB_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define REVERB_COMBS			(	4	)
+#define REVERB_ALLPASSES		(	2	)
+
+//feedback, damping and mix are Q8, 256 = unity
+#define REVERB_GAIN_SHIFT		(	8	)
+#define REVERB_GAIN_MAX			(	256	)
+
+//smallest buffer that leaves every line a few samples
+#define REVERB_FRAMES_MIN		(	256	)
+
+/********   TYPE DEFS  **********/
+struct reverb_line{
+	int16_t *data;
+	uint16_t length;
+	uint16_t pos;
+};
+
+struct reverb{
+	struct reverb_line comb[REVERB_COMBS];
+	struct reverb_line allpass[REVERB_ALLPASSES];
+	int32_t damp_state[REVERB_COMBS];
+	int32_t last;
+	uint32_t frames;
+	uint32_t quiet;
+	int32_t feedback;
+	int32_t damp;
+	int32_t mix;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void reverb_init( struct reverb *reverb, int16_t *buffer, uint32_t frames, uint32_t spread );
+void reverb_clear( struct reverb *reverb );
+void reverb_set( struct reverb *reverb, int32_t feedback, int32_t damp, int32_t mix );
+void reverb_process( struct reverb *reverb, int32_t *buffer, int count );
+bool reverb_idle( const struct reverb *reverb );
+
+#endif /* REVERB_H_INCLUDED */
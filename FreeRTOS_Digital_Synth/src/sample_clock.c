@@ -0,0 +1,302 @@
+/*************************************************************************************************
+                                        --SAMPLE CLOCK--
+
+	TC3 in 16-bit match-frequency mode: the counter wraps at CC0, giving one overflow (DMA
+	trigger / interrupt) per sample period.
+
+	Board sync counts the overflows with TCC1 on a resynchronized event channel, NFRQ with
+	CC0 at 0 toggles its WO[0] at the start of every block. A follower takes the master's
+	edges on EXTINT10 and reads where its own block is at that moment, TCC1 in ticks and TC3
+	within the tick. The SAMD21 TC has no fractional period, so the trim is whole counts on
+	CC0 for the next block: the error divided by the block's ticks, rounded, which brings
+	the edge back within half a count per tick by the next one. The phase then wanders a
+	few microseconds around the master's, it does not drift.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "sample_clock.h"
+#include "recip.h"
+
+
+/**********  DEFINE  ************/
+#define SAMPLE_SYNC_EVSYS_CHANNEL	(	1	)
+#define SAMPLE_STROBE_EVSYS_CHANNEL	(	2	)
+#define SAMPLE_SYNC_EXTINT			(	10	)
+
+
+/*******   GLOBAL VARS  *********/
+static sample_clock_callback_t clock_callback;
+
+//period at the set rate, the follower's trim is applied around it
+static uint16_t clock_period;
+
+#if SYNTH_SAMPLE_SYNC
+static uint16_t sync_ticks;
+static uint32_t sync_recip;
+static volatile int32_t sync_error;
+static volatile uint32_t sync_edges;
+#endif
+
+
+/****** FUNCTION PROTOTYPES  ****/
+void TC3_Handler( void );
+#if (SYNTH_SAMPLE_SYNC == SYNTH_SAMPLE_SYNC_FOLLOWER)
+void EIC_Handler( void );
+#endif
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void sample_clock_sync( void )
+{
+	while(TC3->COUNT16.STATUS.reg & TC_STATUS_SYNCBUSY);
+}
+
+static uint16_t sample_clock_period( uint32_t sample_rate )
+{
+	//period rounded to the nearest timer count
+	return (uint16_t) (((SAMPLE_CLOCK_SOURCE_HZ + (sample_rate / 2)) / sample_rate) - 1);
+}
+
+void sample_clock_init( uint32_t sample_rate, sample_clock_callback_t callback )
+{
+	clock_callback = callback;
+
+	//the GCLK channel for TC3 is set up by configure_gclock_channel()
+	PM->APBCMASK.reg |= PM_APBCMASK_TC3;
+
+	TC3->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+	sample_clock_sync();
+	while(TC3->COUNT16.CTRLA.reg & TC_CTRLA_SWRST);
+
+	TC3->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER_DIV1;
+	sample_clock_sync();
+
+	clock_period = sample_clock_period(sample_rate);
+	TC3->COUNT16.CC[0].reg = clock_period;
+	sample_clock_sync();
+
+	//DMA triggers on OVF without an interrupt, only the CPU output path needs one
+	if(clock_callback != NULL)
+	{
+		TC3->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+		NVIC_EnableIRQ(TC3_IRQn);
+	}
+}
+
+void sample_clock_route_event( uint8_t user )
+{
+	//asynchronous path, the user sees the overflow with no resynchronisation delay; call after
+	//sample_clock_init(), whose reset clears the event output
+	PM->APBCMASK.reg |= PM_APBCMASK_EVSYS;
+
+	EVSYS->USER.reg = EVSYS_USER_USER(user) | EVSYS_USER_CHANNEL(SAMPLE_CLOCK_EVSYS_CHANNEL + 1); //0 is no channel
+	EVSYS->CHANNEL.reg = EVSYS_CHANNEL_CHANNEL(SAMPLE_CLOCK_EVSYS_CHANNEL) | EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_TC3_OVF) |
+		EVSYS_CHANNEL_PATH_ASYNCHRONOUS | EVSYS_CHANNEL_EDGSEL_NO_EVT_OUTPUT;
+
+	TC3->COUNT16.EVCTRL.reg |= TC_EVCTRL_OVFEO;
+}
+
+static void sample_strobe_tcc_wait( uint32_t bits )
+{
+	while(TCC0->SYNCBUSY.reg & bits);
+}
+
+void sample_clock_strobe_init( void )
+{
+	//TCC0 on the same 8 MHz as TC3, normal PWM with a period it never reaches: every overflow
+	//restarts it from 0, which sets WO[0] until CC0, inverted to a low pulse. The TCC takes
+	//events in its own clock domain, so the channel resynchronizes, a fixed two counts or so
+	//after the overflow; call after sample_clock_init()
+	struct system_gclk_chan_config gclk_chan_conf;
+	struct system_pinmux_config config_mux;
+
+	PM->APBCMASK.reg |= PM_APBCMASK_TCC0 | PM_APBCMASK_EVSYS;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
+	system_gclk_chan_set_config(TCC0_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(TCC0_GCLK_ID);
+	system_gclk_chan_set_config(EVSYS_GCLK_ID_0 + SAMPLE_STROBE_EVSYS_CHANNEL, &gclk_chan_conf);
+	system_gclk_chan_enable(EVSYS_GCLK_ID_0 + SAMPLE_STROBE_EVSYS_CHANNEL);
+
+	TCC0->CTRLA.reg = TCC_CTRLA_SWRST;
+	sample_strobe_tcc_wait(TCC_SYNCBUSY_SWRST);
+	TCC0->WAVE.reg = TCC_WAVE_WAVEGEN_NPWM;
+	TCC0->PER.reg = TCC_PER_PER_Msk;
+	TCC0->CC[0].reg = SAMPLE_CLOCK_STROBE_COUNTS;
+	TCC0->DRVCTRL.reg = TCC_DRVCTRL_INVEN0;
+	TCC0->EVCTRL.reg = TCC_EVCTRL_EVACT0_RETRIGGER | TCC_EVCTRL_TCEI0;
+	sample_strobe_tcc_wait(TCC_SYNCBUSY_MASK);
+
+	EVSYS->USER.reg = EVSYS_USER_USER(EVSYS_ID_USER_TCC0_EV_0) | EVSYS_USER_CHANNEL(SAMPLE_STROBE_EVSYS_CHANNEL + 1);
+	EVSYS->CHANNEL.reg = EVSYS_CHANNEL_CHANNEL(SAMPLE_STROBE_EVSYS_CHANNEL) | EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_TC3_OVF) |
+		EVSYS_CHANNEL_PATH_RESYNCHRONIZED | EVSYS_CHANNEL_EDGSEL_RISING_EDGE;
+	TC3->COUNT16.EVCTRL.reg |= TC_EVCTRL_OVFEO;
+	sample_clock_sync();
+
+	//counts up to its first overflow with WO[0] cleared, so LDAC idles high from here on
+	TCC0->COUNT.reg = SAMPLE_CLOCK_STROBE_COUNTS;
+	sample_strobe_tcc_wait(TCC_SYNCBUSY_COUNT);
+	TCC0->CTRLA.reg = TCC_CTRLA_ENABLE;
+	sample_strobe_tcc_wait(TCC_SYNCBUSY_ENABLE);
+
+	system_pinmux_get_config_defaults(&config_mux);
+	config_mux.mux_position = PINMUX_PA04E_TCC0_WO0 & 0xFFFF;
+	config_mux.direction = SYSTEM_PINMUX_PIN_DIR_OUTPUT;
+	system_pinmux_pin_set_config(PINMUX_PA04E_TCC0_WO0 >> 16, &config_mux);
+}
+
+void sample_clock_start( void )
+{
+	TC3->COUNT16.CTRLA.reg |= TC_CTRLA_ENABLE;
+	sample_clock_sync();
+}
+
+void sample_clock_set_rate( uint32_t sample_rate )
+{
+	//restarting the count keeps a shorter period from missing the match and running to 0xFFFF
+	clock_period = sample_clock_period(sample_rate);
+	TC3->COUNT16.CC[0].reg = clock_period;
+	sample_clock_sync();
+	TC3->COUNT16.COUNT.reg = 0;
+	sample_clock_sync();
+}
+
+void sample_clock_stop( void )
+{
+	TC3->COUNT16.CTRLA.reg &= ~TC_CTRLA_ENABLE;
+	sample_clock_sync();
+}
+
+#if SYNTH_SAMPLE_SYNC
+static void sample_sync_tcc_wait( uint32_t bits )
+{
+	while(TCC1->SYNCBUSY.reg & bits);
+}
+
+void sample_clock_sync_init( uint16_t ticks_per_block )
+{
+	//block counter on the running sample clock, and the master's sync output or the
+	//follower's input; call after sample_clock_init()
+	struct system_gclk_chan_config gclk_chan_conf;
+	struct system_pinmux_config config_mux;
+
+	sync_ticks = ticks_per_block;
+	sync_recip = recip_of(ticks_per_block);
+	sync_error = 0;
+	sync_edges = 0;
+
+	PM->APBCMASK.reg |= PM_APBCMASK_TCC1 | PM_APBCMASK_EVSYS;
+	system_gclk_chan_get_config_defaults(&gclk_chan_conf);
+	gclk_chan_conf.source_generator = GCLK_GENERATOR_2;
+	system_gclk_chan_set_config(TCC1_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(TCC1_GCLK_ID);
+	system_gclk_chan_set_config(EVSYS_GCLK_ID_0 + SAMPLE_SYNC_EVSYS_CHANNEL, &gclk_chan_conf);
+	system_gclk_chan_enable(EVSYS_GCLK_ID_0 + SAMPLE_SYNC_EVSYS_CHANNEL);
+
+	TCC1->CTRLA.reg = TCC_CTRLA_SWRST;
+	sample_sync_tcc_wait(TCC_SYNCBUSY_SWRST);
+	TCC1->WAVE.reg = TCC_WAVE_WAVEGEN_NFRQ;
+	TCC1->PER.reg = ticks_per_block - 1;
+	TCC1->CC[0].reg = 0;
+	TCC1->EVCTRL.reg = TCC_EVCTRL_EVACT0_COUNTEV | TCC_EVCTRL_TCEI0;
+	sample_sync_tcc_wait(TCC_SYNCBUSY_MASK);
+
+	//the TCC counts events from its own clock domain, so this channel resynchronizes
+	EVSYS->USER.reg = EVSYS_USER_USER(EVSYS_ID_USER_TCC1_EV_0) | EVSYS_USER_CHANNEL(SAMPLE_SYNC_EVSYS_CHANNEL + 1);
+	EVSYS->CHANNEL.reg = EVSYS_CHANNEL_CHANNEL(SAMPLE_SYNC_EVSYS_CHANNEL) | EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_TC3_OVF) |
+		EVSYS_CHANNEL_PATH_RESYNCHRONIZED | EVSYS_CHANNEL_EDGSEL_RISING_EDGE;
+	TC3->COUNT16.EVCTRL.reg |= TC_EVCTRL_OVFEO;
+	sample_clock_sync();
+
+	TCC1->CTRLA.reg = TCC_CTRLA_ENABLE;
+	sample_sync_tcc_wait(TCC_SYNCBUSY_ENABLE);
+
+	system_pinmux_get_config_defaults(&config_mux);
+#if (SYNTH_SAMPLE_SYNC == SYNTH_SAMPLE_SYNC_MASTER)
+	config_mux.mux_position = PINMUX_PA10E_TCC1_WO0 & 0xFFFF;
+	config_mux.direction = SYSTEM_PINMUX_PIN_DIR_OUTPUT;
+	system_pinmux_pin_set_config(PINMUX_PA10E_TCC1_WO0 >> 16, &config_mux);
+#else
+	//both edges of the master's square wave, one per block
+	PM->APBAMASK.reg |= PM_APBAMASK_EIC;
+	system_gclk_chan_set_config(EIC_GCLK_ID, &gclk_chan_conf);
+	system_gclk_chan_enable(EIC_GCLK_ID);
+
+	EIC->CTRL.reg = EIC_CTRL_SWRST;
+	while(EIC->STATUS.reg & EIC_STATUS_SYNCBUSY);
+	EIC->CONFIG[SAMPLE_SYNC_EXTINT / 8].reg = EIC_CONFIG_SENSE0_BOTH << (4 * (SAMPLE_SYNC_EXTINT % 8));
+	EIC->INTENSET.reg = 1ul << SAMPLE_SYNC_EXTINT;
+	EIC->CTRL.reg = EIC_CTRL_ENABLE;
+	while(EIC->STATUS.reg & EIC_STATUS_SYNCBUSY);
+
+	config_mux.mux_position = PINMUX_PA10A_EIC_EXTINT10 & 0xFFFF;
+	config_mux.input_pull = SYSTEM_PINMUX_PIN_PULL_DOWN;
+	system_pinmux_pin_set_config(PINMUX_PA10A_EIC_EXTINT10 >> 16, &config_mux);
+	NVIC_EnableIRQ(EIC_IRQn);
+#endif
+}
+
+int32_t sample_clock_sync_error( void )
+{
+	//the follower's block start against the master's edge at the last one, in sample clock
+	//counts, positive when it is early
+	return sync_error;
+}
+
+uint32_t sample_clock_sync_edges( void )
+{
+	return sync_edges;
+}
+#endif
+
+
+/*****  INTERRUPT HANDLERS  *****/
+SYNTH_RAM_CODE void TC3_Handler( void )
+{
+	TC3->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+
+	if(clock_callback != NULL) clock_callback();
+}
+
+#if (SYNTH_SAMPLE_SYNC == SYNTH_SAMPLE_SYNC_FOLLOWER)
+SYNTH_RAM_CODE void EIC_Handler( void )
+{
+	//a master block edge: where the own block is, and the period for the next one
+	int32_t total = (int32_t) sync_ticks * (clock_period + 1);
+	int32_t limit = clock_period / 32 + 1;
+	int32_t error;
+	int32_t trim;
+	uint16_t count;
+	uint16_t again;
+	uint32_t ticks;
+
+	EIC->INTFLAG.reg = 1ul << SAMPLE_SYNC_EXTINT;
+
+	//a tick that ends between the two counter reads shows as TC3 going backwards
+	do
+	{
+		count = TC3->COUNT16.COUNT.reg;
+		TCC1->CTRLBSET.reg = TCC_CTRLBSET_CMD_READSYNC;
+		sample_sync_tcc_wait(TCC_SYNCBUSY_CTRLB | TCC_SYNCBUSY_COUNT);
+		ticks = TCC1->COUNT.reg;
+		again = TC3->COUNT16.COUNT.reg;
+	} while(again < count);
+
+	error = (int32_t) ticks * (clock_period + 1) + count;
+	if(error >= total / 2) error -= total;
+	sync_error = error;
+	sync_edges++;
+
+	//early means fast, a longer period for the next block
+	trim = recip_apply(error + ((error >= 0) ? sync_ticks / 2 : -(int32_t) (sync_ticks / 2)), sync_ticks, sync_recip);
+	if(trim > limit) trim = limit;
+	if(trim < -limit) trim = -limit;
+
+	TC3->COUNT16.CC[0].reg = (uint16_t) (clock_period + trim);
+	sample_clock_sync();
+
+	//a shorter period below the count would run it to 0xFFFF
+	if(TC3->COUNT16.COUNT.reg >= clock_period + trim) TC3->COUNT16.COUNT.reg = (uint16_t) (clock_period + trim - 1);
+}
+#endif
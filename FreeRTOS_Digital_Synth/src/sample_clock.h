@@ -0,0 +1,52 @@
+/*************************************************************************************************
+                                        --SAMPLE CLOCK--
+
+	TC3 match-frequency timer that paces audio output independently of the FreeRTOS tick.
+	The overflow triggers the DAC DMA directly; in non-DMA builds it interrupts and calls a
+	per-sample callback instead. sample_clock_route_event() also puts the overflow on an
+	event channel, for a peripheral that starts its work from the event itself.
+
+	sample_clock_strobe_init() puts a short low pulse on PA04 at every overflow, from TCC0
+	restarted by the overflow's event: the MCP4821's LDAC with SYNTH_MCP4821_LDAC.
+
+	SYNTH_SAMPLE_SYNC locks chained boards' sample clocks together: the master puts a square
+	wave on PA10 (EXT2 pin 3) with an edge at the start of every block, a follower takes it
+	on its own PA10 and trims its sample period each block so its blocks start on those
+	edges. All boards must run the same rate and block size. Not with the I2S output, which
+	has its own clocks and uses PA10.
+
+*************************************************************************************************/
+
+#ifndef SAMPLE_CLOCK_H_INCLUDED
+#define SAMPLE_CLOCK_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//TC3 runs from GCLK_GENERATOR_2 (OSC8M, undivided), see configure_gclock_channel()
+#define SAMPLE_CLOCK_SOURCE_HZ		(	8000000	)
+
+#define SAMPLE_CLOCK_DMAC_TRIGGER	TC3_DMAC_ID_OVF
+#define SAMPLE_CLOCK_EVSYS_CHANNEL	(	0	)
+
+//the strobe's length in sample clock counts, 250 ns; the MCP4821 wants 100 ns of LDAC
+#define SAMPLE_CLOCK_STROBE_COUNTS	(	2	)
+
+/********   TYPE DEFS  **********/
+typedef void (*sample_clock_callback_t)(void);
+
+/****** FUNCTION PROTOTYPES  ****/
+void sample_clock_init( uint32_t sample_rate, sample_clock_callback_t callback );
+void sample_clock_start( void );
+void sample_clock_set_rate( uint32_t sample_rate );
+void sample_clock_route_event( uint8_t user );
+void sample_clock_strobe_init( void );
+void sample_clock_stop( void );
+#if SYNTH_SAMPLE_SYNC
+void sample_clock_sync_init( uint16_t ticks_per_block );
+int32_t sample_clock_sync_error( void );
+uint32_t sample_clock_sync_edges( void );
+#endif
+
+#endif /* SAMPLE_CLOCK_H_INCLUDED */
@@ -0,0 +1,67 @@
+/*************************************************************************************************
+                                        --SAMPLE FORMAT--
+
+	The one sample format of the engine. The mix is summed at full resolution and the master
+	gain brings it down to signed SAMPLE_BITS integers around 0. Every stage after that works
+	in those units and nothing in between rescales: shaper, filter, formant, chorus, delay,
+	reverb, DC blocker, limiter and the audio input. dac_codes() then clamps a control period
+	to unsigned codes around DAC_MIDSCALE. Those codes are what the frames, the tap, the
+	recorder, the meters and the underrun fade handle.
+
+	The converter's format exists only at the very edge. A backend's word() builds its output
+	word from a code with sample_word(), and its code() reverses it with sample_code(). The
+	word width and the coding are the only difference between the backends:
+
+		MCP4821			12 bits, offset binary
+		internal DAC	10 bits, offset binary
+		I2S				16 bits, two's complement
+
+	A narrower word drops the low bits. A wider one pads them with zeros, so the extra bits
+	of I2S carry no more resolution than the engine has. The mix keeps DITHER_SHIFT bits below
+	the code for the dither stage. The effects' lines and states are int16 with 24 dB of
+	headroom over SAMPLE_BITS.
+
+*************************************************************************************************/
+
+#ifndef SAMPLE_FORMAT_H_INCLUDED
+#define SAMPLE_FORMAT_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define SAMPLE_BITS				(	12	)
+
+//voices mix as signed samples around the DAC mid code
+#define DAC_MIDSCALE			(	2048	)
+#define DAC_MAX_CODE			(	4095	)
+
+#if (DAC_MIDSCALE != (1 << (SAMPLE_BITS - 1))) || (DAC_MAX_CODE != (1 << SAMPLE_BITS) - 1)
+#  error "DAC_MIDSCALE and DAC_MAX_CODE must be the middle and top of SAMPLE_BITS"
+#endif
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline uint16_t sample_word( uint16_t code, int bits, bool twos )
+{
+	//a code as a 'bits' wide converter word, offset binary or two's complement; with
+	//constant arguments this inlines to a mask, an exclusive or and a shift
+	uint32_t word = code & DAC_MAX_CODE;
+
+	if(twos) word ^= DAC_MIDSCALE;
+	if(bits >= SAMPLE_BITS) return (uint16_t) (word << (bits - SAMPLE_BITS));
+
+	return (uint16_t) (word >> (SAMPLE_BITS - bits));
+}
+
+static inline uint16_t sample_code( uint16_t word, int bits, bool twos )
+{
+	//and back, for reading played frames
+	uint32_t code = word & ((1ul << bits) - 1);
+
+	code = (bits >= SAMPLE_BITS) ? (code >> (bits - SAMPLE_BITS)) : (code << (SAMPLE_BITS - bits));
+	if(twos) code ^= DAC_MIDSCALE;
+
+	return (uint16_t) code;
+}
+
+#endif /* SAMPLE_FORMAT_H_INCLUDED */
@@ -0,0 +1,1118 @@
+/*************************************************************************************************
+                                         --SAMPLES--
+
+	Generated by tools/gen_samples.py, do not edit by hand.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "samples.h"
+
+
+/*******   GLOBAL VARS  *********/
+static const int8_t pcm_kick[5512] = {
+	6, 11, 17, 22, 27, 33, 38, 43, 48, 53, 58, 63, 68, 72, 76, 81,
+	85, 89, 93, 96, 100, 103, 106, 109, 111, 114, 116, 118, 120, 122, 123, 124,
+	125, 126, 127, 127, 127, 127, 127, 126, 125, 124, 123, 122, 120, 118, 116, 114,
+	112, 109, 107, 104, 101, 98, 94, 91, 87, 83, 79, 75, 71, 67, 62, 58,
+	53, 49, 44, 39, 35, 30, 25, 20, 15, 10, 5, 0, -5, -10, -15, -20,
+	-25, -29, -34, -39, -43, -48, -52, -57, -61, -65, -69, -73, -77, -81, -84, -88,
+	-91, -94, -97, -100, -102, -105, -107, -109, -111, -113, -115, -116, -118, -119, -120, -120,
+	-121, -121, -122, -122, -122, -121, -121, -120, -119, -118, -117, -115, -114, -112, -110, -108,
+	-106, -104, -101, -99, -96, -93, -90, -87, -83, -80, -77, -73, -69, -66, -62, -58,
+	-54, -50, -45, -41, -37, -33, -28, -24, -20, -15, -11, -6, -2, 3, 7, 11,
+	16, 20, 24, 29, 33, 37, 41, 45, 49, 53, 57, 61, 64, 68, 71, 75,
+	78, 81, 84, 87, 90, 92, 95, 97, 100, 102, 104, 106, 107, 109, 110, 112,
+	113, 114, 114, 115, 116, 116, 116, 116, 116, 116, 116, 115, 114, 113, 112, 111,
+	110, 109, 107, 106, 104, 102, 100, 98, 95, 93, 90, 88, 85, 82, 79, 76,
+	73, 70, 67, 63, 60, 56, 53, 49, 46, 42, 38, 34, 31, 27, 23, 19,
+	15, 11, 7, 3, -1, -5, -9, -13, -16, -20, -24, -28, -32, -35, -39, -43,
+	-46, -50, -53, -56, -60, -63, -66, -69, -72, -75, -77, -80, -83, -85, -88, -90,
+	-92, -94, -96, -98, -99, -101, -103, -104, -105, -106, -107, -108, -109, -109, -110, -110,
+	-111, -111, -111, -110, -110, -110, -109, -109, -108, -107, -106, -105, -104, -103, -101, -100,
+	-98, -96, -94, -92, -90, -88, -86, -84, -81, -79, -76, -74, -71, -68, -65, -62,
+	-59, -56, -53, -50, -47, -44, -40, -37, -34, -30, -27, -23, -20, -17, -13, -10,
+	-6, -3, 1, 4, 8, 11, 15, 18, 21, 25, 28, 31, 35, 38, 41, 44,
+	47, 50, 53, 56, 59, 62, 64, 67, 69, 72, 74, 77, 79, 81, 83, 85,
+	87, 89, 91, 92, 94, 95, 97, 98, 99, 100, 101, 102, 103, 103, 104, 104,
+	105, 105, 105, 105, 105, 105, 104, 104, 104, 103, 102, 102, 101, 100, 99, 98,
+	96, 95, 94, 92, 91, 89, 87, 85, 84, 82, 80, 77, 75, 73, 71, 68,
+	66, 63, 61, 58, 56, 53, 50, 48, 45, 42, 39, 36, 33, 30, 27, 24,
+	21, 18, 15, 12, 9, 6, 3, 0, -3, -6, -9, -12, -15, -18, -21, -24,
+	-27, -30, -33, -36, -38, -41, -44, -46, -49, -52, -54, -57, -59, -61, -64, -66,
+	-68, -70, -72, -74, -76, -78, -80, -81, -83, -85, -86, -87, -89, -90, -91, -92,
+	-93, -94, -95, -96, -97, -97, -98, -98, -98, -99, -99, -99, -99, -99, -99, -99,
+	-98, -98, -98, -97, -96, -96, -95, -94, -93, -92, -91, -90, -89, -87, -86, -85,
+	-83, -82, -80, -78, -76, -75, -73, -71, -69, -67, -65, -63, -61, -58, -56, -54,
+	-52, -49, -47, -44, -42, -39, -37, -34, -32, -29, -27, -24, -21, -19, -16, -13,
+	-11, -8, -5, -3, 0, 3, 5, 8, 11, 13, 16, 18, 21, 24, 26, 29,
+	31, 34, 36, 38, 41, 43, 45, 48, 50, 52, 54, 56, 58, 60, 62, 64,
+	66, 68, 69, 71, 73, 74, 76, 77, 79, 80, 81, 83, 84, 85, 86, 87,
+	88, 88, 89, 90, 91, 91, 92, 92, 92, 93, 93, 93, 93, 93, 93, 93,
+	93, 93, 92, 92, 92, 91, 90, 90, 89, 88, 88, 87, 86, 85, 84, 83,
+	81, 80, 79, 78, 76, 75, 73, 72, 70, 69, 67, 65, 64, 62, 60, 58,
+	56, 54, 52, 50, 48, 46, 44, 42, 40, 38, 36, 33, 31, 29, 27, 24,
+	22, 20, 17, 15, 13, 10, 8, 6, 3, 1, -1, -3, -6, -8, -10, -13,
+	-15, -17, -19, -22, -24, -26, -28, -30, -32, -35, -37, -39, -41, -43, -45, -47,
+	-48, -50, -52, -54, -56, -57, -59, -61, -62, -64, -65, -67, -68, -70, -71, -72,
+	-73, -75, -76, -77, -78, -79, -80, -81, -81, -82, -83, -83, -84, -85, -85, -86,
+	-86, -86, -87, -87, -87, -87, -87, -87, -87, -87, -87, -87, -86, -86, -86, -85,
+	-85, -84, -84, -83, -83, -82, -81, -80, -79, -79, -78, -77, -76, -74, -73, -72,
+	-71, -70, -68, -67, -66, -64, -63, -61, -60, -58, -57, -55, -54, -52, -50, -48,
+	-47, -45, -43, -41, -40, -38, -36, -34, -32, -30, -28, -26, -24, -22, -20, -18,
+	-16, -14, -12, -10, -8, -6, -4, -2, 0, 2, 4, 6, 8, 10, 12, 14,
+	16, 18, 20, 22, 24, 25, 27, 29, 31, 33, 35, 36, 38, 40, 41, 43,
+	45, 46, 48, 50, 51, 53, 54, 55, 57, 58, 60, 61, 62, 63, 65, 66,
+	67, 68, 69, 70, 71, 72, 73, 73, 74, 75, 76, 76, 77, 78, 78, 79,
+	79, 79, 80, 80, 80, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81,
+	80, 80, 80, 79, 79, 79, 78, 77, 77, 76, 76, 75, 74, 73, 73, 72,
+	71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 60, 59, 58, 57, 55, 54,
+	53, 51, 50, 48, 47, 45, 44, 42, 41, 39, 38, 36, 34, 33, 31, 29,
+	28, 26, 24, 23, 21, 19, 18, 16, 14, 12, 11, 9, 7, 5, 4, 2,
+	0, -2, -3, -5, -7, -9, -10, -12, -14, -15, -17, -19, -20, -22, -24, -25,
+	-27, -28, -30, -32, -33, -35, -36, -38, -39, -40, -42, -43, -45, -46, -47, -49,
+	-50, -51, -52, -54, -55, -56, -57, -58, -59, -60, -61, -62, -63, -64, -65, -66,
+	-66, -67, -68, -68, -69, -70, -70, -71, -71, -72, -72, -73, -73, -74, -74, -74,
+	-74, -75, -75, -75, -75, -75, -75, -75, -75, -75, -75, -75, -75, -74, -74, -74,
+	-74, -73, -73, -73, -72, -72, -71, -71, -70, -69, -69, -68, -67, -67, -66, -65,
+	-64, -64, -63, -62, -61, -60, -59, -58, -57, -56, -55, -54, -53, -51, -50, -49,
+	-48, -47, -46, -44, -43, -42, -40, -39, -38, -36, -35, -34, -32, -31, -29, -28,
+	-27, -25, -24, -22, -21, -19, -18, -16, -15, -13, -12, -10, -9, -7, -6, -4,
+	-3, -1, 0, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18, 19,
+	21, 22, 24, 25, 26, 28, 29, 30, 32, 33, 34, 36, 37, 38, 39, 40,
+	42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57,
+	57, 58, 59, 60, 60, 61, 62, 62, 63, 64, 64, 65, 65, 66, 66, 66,
+	67, 67, 68, 68, 68, 68, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+	69, 69, 69, 69, 69, 68, 68, 68, 68, 67, 67, 67, 66, 66, 65, 65,
+	64, 64, 63, 63, 62, 61, 61, 60, 59, 59, 58, 57, 56, 56, 55, 54,
+	53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38,
+	37, 36, 35, 33, 32, 31, 30, 29, 27, 26, 25, 24, 22, 21, 20, 19,
+	17, 16, 15, 13, 12, 11, 10, 8, 7, 6, 4, 3, 2, 0, -1, -2,
+	-3, -5, -6, -7, -9, -10, -11, -12, -14, -15, -16, -17, -19, -20, -21, -22,
+	-23, -25, -26, -27, -28, -29, -30, -31, -32, -34, -35, -36, -37, -38, -39, -40,
+	-41, -42, -43, -43, -44, -45, -46, -47, -48, -49, -49, -50, -51, -52, -52, -53,
+	-54, -54, -55, -56, -56, -57, -57, -58, -58, -59, -59, -60, -60, -60, -61, -61,
+	-61, -62, -62, -62, -63, -63, -63, -63, -63, -63, -63, -63, -63, -63, -63, -63,
+	-63, -63, -63, -63, -63, -63, -63, -62, -62, -62, -62, -61, -61, -61, -60, -60,
+	-60, -59, -59, -58, -58, -57, -57, -56, -56, -55, -54, -54, -53, -52, -52, -51,
+	-50, -50, -49, -48, -47, -47, -46, -45, -44, -43, -42, -41, -41, -40, -39, -38,
+	-37, -36, -35, -34, -33, -32, -31, -30, -29, -28, -27, -26, -25, -24, -23, -22,
+	-20, -19, -18, -17, -16, -15, -14, -13, -12, -11, -9, -8, -7, -6, -5, -4,
+	-3, -2, 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+	31, 32, 33, 34, 35, 35, 36, 37, 38, 39, 40, 40, 41, 42, 43, 43,
+	44, 45, 45, 46, 47, 47, 48, 49, 49, 50, 50, 51, 51, 52, 52, 53,
+	53, 53, 54, 54, 55, 55, 55, 56, 56, 56, 56, 57, 57, 57, 57, 57,
+	57, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 57, 57,
+	57, 57, 57, 56, 56, 56, 56, 55, 55, 55, 54, 54, 54, 53, 53, 52,
+	52, 52, 51, 51, 50, 50, 49, 48, 48, 47, 47, 46, 45, 45, 44, 44,
+	43, 42, 41, 41, 40, 39, 39, 38, 37, 36, 35, 35, 34, 33, 32, 31,
+	30, 30, 29, 28, 27, 26, 25, 24, 23, 22, 22, 21, 20, 19, 18, 17,
+	16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,
+	0, -1, -2, -3, -3, -4, -5, -6, -7, -8, -9, -10, -11, -12, -13, -14,
+	-15, -16, -17, -18, -18, -19, -20, -21, -22, -23, -24, -24, -25, -26, -27, -28,
+	-29, -29, -30, -31, -32, -32, -33, -34, -35, -35, -36, -37, -37, -38, -39, -39,
+	-40, -40, -41, -42, -42, -43, -43, -44, -44, -45, -45, -46, -46, -47, -47, -47,
+	-48, -48, -49, -49, -49, -49, -50, -50, -50, -51, -51, -51, -51, -51, -52, -52,
+	-52, -52, -52, -52, -52, -52, -52, -53, -53, -53, -53, -53, -52, -52, -52, -52,
+	-52, -52, -52, -52, -52, -51, -51, -51, -51, -51, -50, -50, -50, -49, -49, -49,
+	-48, -48, -48, -47, -47, -47, -46, -46, -45, -45, -44, -44, -43, -43, -42, -42,
+	-41, -41, -40, -40, -39, -38, -38, -37, -36, -36, -35, -35, -34, -33, -33, -32,
+	-31, -30, -30, -29, -28, -27, -27, -26, -25, -24, -24, -23, -22, -21, -21, -20,
+	-19, -18, -17, -17, -16, -15, -14, -13, -12, -12, -11, -10, -9, -8, -7, -7,
+	-6, -5, -4, -3, -2, -1, -1, 0, 1, 2, 3, 4, 4, 5, 6, 7,
+	8, 9, 9, 10, 11, 12, 13, 13, 14, 15, 16, 17, 17, 18, 19, 20,
+	20, 21, 22, 23, 23, 24, 25, 25, 26, 27, 27, 28, 29, 29, 30, 31,
+	31, 32, 32, 33, 34, 34, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39,
+	40, 40, 41, 41, 41, 42, 42, 42, 43, 43, 44, 44, 44, 44, 45, 45,
+	45, 45, 46, 46, 46, 46, 46, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+	47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+	46, 46, 46, 46, 46, 45, 45, 45, 45, 44, 44, 44, 43, 43, 43, 42,
+	42, 42, 41, 41, 41, 40, 40, 39, 39, 38, 38, 37, 37, 37, 36, 36,
+	35, 34, 34, 33, 33, 32, 32, 31, 31, 30, 29, 29, 28, 28, 27, 26,
+	26, 25, 24, 24, 23, 22, 22, 21, 20, 20, 19, 18, 18, 17, 16, 16,
+	15, 14, 13, 13, 12, 11, 11, 10, 9, 8, 8, 7, 6, 5, 5, 4,
+	3, 2, 2, 1, 0, 0, -1, -2, -3, -3, -4, -5, -6, -6, -7, -8,
+	-8, -9, -10, -11, -11, -12, -13, -13, -14, -15, -15, -16, -17, -17, -18, -19,
+	-19, -20, -21, -21, -22, -22, -23, -24, -24, -25, -25, -26, -26, -27, -28, -28,
+	-29, -29, -30, -30, -31, -31, -32, -32, -33, -33, -33, -34, -34, -35, -35, -36,
+	-36, -36, -37, -37, -37, -38, -38, -38, -39, -39, -39, -39, -40, -40, -40, -40,
+	-41, -41, -41, -41, -41, -42, -42, -42, -42, -42, -42, -42, -42, -43, -43, -43,
+	-43, -43, -43, -43, -43, -43, -43, -43, -43, -43, -43, -42, -42, -42, -42, -42,
+	-42, -42, -42, -41, -41, -41, -41, -41, -40, -40, -40, -40, -40, -39, -39, -39,
+	-38, -38, -38, -37, -37, -37, -36, -36, -36, -35, -35, -35, -34, -34, -33, -33,
+	-33, -32, -32, -31, -31, -30, -30, -29, -29, -28, -28, -27, -27, -26, -26, -25,
+	-25, -24, -24, -23, -22, -22, -21, -21, -20, -20, -19, -18, -18, -17, -17, -16,
+	-15, -15, -14, -14, -13, -12, -12, -11, -10, -10, -9, -9, -8, -7, -7, -6,
+	-5, -5, -4, -3, -3, -2, -1, -1, 0, 0, 1, 2, 2, 3, 4, 4,
+	5, 6, 6, 7, 7, 8, 9, 9, 10, 10, 11, 12, 12, 13, 13, 14,
+	15, 15, 16, 16, 17, 17, 18, 19, 19, 20, 20, 21, 21, 22, 22, 23,
+	23, 24, 24, 25, 25, 26, 26, 26, 27, 27, 28, 28, 29, 29, 29, 30,
+	30, 31, 31, 31, 32, 32, 32, 33, 33, 33, 34, 34, 34, 34, 35, 35,
+	35, 35, 36, 36, 36, 36, 36, 37, 37, 37, 37, 37, 37, 38, 38, 38,
+	38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+	38, 38, 38, 38, 38, 38, 38, 38, 37, 37, 37, 37, 37, 37, 37, 36,
+	36, 36, 36, 36, 35, 35, 35, 35, 34, 34, 34, 33, 33, 33, 33, 32,
+	32, 32, 31, 31, 31, 30, 30, 30, 29, 29, 28, 28, 28, 27, 27, 26,
+	26, 25, 25, 25, 24, 24, 23, 23, 22, 22, 21, 21, 20, 20, 19, 19,
+	18, 18, 17, 17, 16, 16, 15, 15, 14, 14, 13, 13, 12, 11, 11, 10,
+	10, 9, 9, 8, 8, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 1,
+	1, 0, 0, -1, -1, -2, -2, -3, -4, -4, -5, -5, -6, -6, -7, -7,
+	-8, -8, -9, -10, -10, -11, -11, -12, -12, -13, -13, -14, -14, -15, -15, -16,
+	-16, -17, -17, -18, -18, -18, -19, -19, -20, -20, -21, -21, -22, -22, -22, -23,
+	-23, -24, -24, -24, -25, -25, -25, -26, -26, -27, -27, -27, -28, -28, -28, -28,
+	-29, -29, -29, -30, -30, -30, -30, -31, -31, -31, -31, -32, -32, -32, -32, -32,
+	-32, -33, -33, -33, -33, -33, -33, -34, -34, -34, -34, -34, -34, -34, -34, -34,
+	-34, -34, -34, -34, -34, -34, -34, -34, -34, -34, -34, -34, -34, -34, -34, -34,
+	-34, -34, -34, -34, -34, -33, -33, -33, -33, -33, -33, -33, -32, -32, -32, -32,
+	-32, -31, -31, -31, -31, -31, -30, -30, -30, -30, -29, -29, -29, -28, -28, -28,
+	-27, -27, -27, -27, -26, -26, -26, -25, -25, -24, -24, -24, -23, -23, -23, -22,
+	-22, -21, -21, -21, -20, -20, -19, -19, -19, -18, -18, -17, -17, -16, -16, -15,
+	-15, -15, -14, -14, -13, -13, -12, -12, -11, -11, -10, -10, -9, -9, -8, -8,
+	-7, -7, -6, -6, -5, -5, -5, -4, -4, -3, -3, -2, -2, -1, -1, 0,
+	0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+	8, 9, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 13, 14, 14, 15,
+	15, 16, 16, 16, 17, 17, 18, 18, 18, 19, 19, 19, 20, 20, 21, 21,
+	21, 22, 22, 22, 23, 23, 23, 24, 24, 24, 24, 25, 25, 25, 25, 26,
+	26, 26, 26, 27, 27, 27, 27, 28, 28, 28, 28, 28, 29, 29, 29, 29,
+	29, 29, 29, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 31, 31,
+	31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 30, 30, 30,
+	30, 30, 30, 30, 30, 30, 30, 30, 29, 29, 29, 29, 29, 29, 29, 28,
+	28, 28, 28, 28, 27, 27, 27, 27, 27, 26, 26, 26, 26, 25, 25, 25,
+	25, 24, 24, 24, 23, 23, 23, 23, 22, 22, 22, 21, 21, 21, 20, 20,
+	20, 19, 19, 19, 18, 18, 17, 17, 17, 16, 16, 16, 15, 15, 14, 14,
+	14, 13, 13, 12, 12, 12, 11, 11, 10, 10, 10, 9, 9, 8, 8, 7,
+	7, 7, 6, 6, 5, 5, 4, 4, 4, 3, 3, 2, 2, 1, 1, 1,
+	0, 0, -1, -1, -2, -2, -2, -3, -3, -4, -4, -5, -5, -5, -6, -6,
+	-7, -7, -8, -8, -8, -9, -9, -10, -10, -10, -11, -11, -11, -12, -12, -13,
+	-13, -13, -14, -14, -14, -15, -15, -15, -16, -16, -17, -17, -17, -17, -18, -18,
+	-18, -19, -19, -19, -20, -20, -20, -20, -21, -21, -21, -22, -22, -22, -22, -23,
+	-23, -23, -23, -23, -24, -24, -24, -24, -24, -25, -25, -25, -25, -25, -25, -26,
+	-26, -26, -26, -26, -26, -26, -26, -27, -27, -27, -27, -27, -27, -27, -27, -27,
+	-27, -27, -27, -27, -27, -27, -27, -27, -27, -27, -27, -27, -27, -27, -27, -27,
+	-27, -27, -27, -27, -27, -27, -27, -27, -27, -26, -26, -26, -26, -26, -26, -26,
+	-26, -25, -25, -25, -25, -25, -25, -24, -24, -24, -24, -24, -23, -23, -23, -23,
+	-23, -22, -22, -22, -22, -21, -21, -21, -21, -20, -20, -20, -20, -19, -19, -19,
+	-18, -18, -18, -18, -17, -17, -17, -16, -16, -16, -15, -15, -15, -14, -14, -14,
+	-13, -13, -13, -12, -12, -12, -11, -11, -11, -10, -10, -9, -9, -9, -8, -8,
+	-8, -7, -7, -6, -6, -6, -5, -5, -5, -4, -4, -3, -3, -3, -2, -2,
+	-2, -1, -1, 0, 0, 0, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4,
+	4, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 10, 10,
+	10, 11, 11, 11, 12, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15,
+	15, 15, 16, 16, 16, 17, 17, 17, 17, 18, 18, 18, 18, 19, 19, 19,
+	19, 20, 20, 20, 20, 20, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22,
+	22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 24,
+	24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+	24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 23,
+	23, 23, 23, 23, 23, 23, 23, 23, 22, 22, 22, 22, 22, 22, 21, 21,
+	21, 21, 21, 21, 20, 20, 20, 20, 20, 19, 19, 19, 19, 18, 18, 18,
+	18, 18, 17, 17, 17, 17, 16, 16, 16, 15, 15, 15, 15, 14, 14, 14,
+	14, 13, 13, 13, 12, 12, 12, 11, 11, 11, 11, 10, 10, 10, 9, 9,
+	9, 8, 8, 8, 7, 7, 7, 6, 6, 6, 5, 5, 5, 4, 4, 4,
+	3, 3, 3, 2, 2, 2, 1, 1, 1, 0, 0, 0, -1, -1, -1, -2,
+	-2, -2, -3, -3, -3, -4, -4, -4, -5, -5, -5, -6, -6, -6, -7, -7,
+	-7, -7, -8, -8, -8, -9, -9, -9, -10, -10, -10, -10, -11, -11, -11, -12,
+	-12, -12, -12, -13, -13, -13, -13, -14, -14, -14, -14, -15, -15, -15, -15, -16,
+	-16, -16, -16, -16, -17, -17, -17, -17, -17, -18, -18, -18, -18, -18, -19, -19,
+	-19, -19, -19, -19, -19, -20, -20, -20, -20, -20, -20, -20, -20, -21, -21, -21,
+	-21, -21, -21, -21, -21, -21, -21, -21, -21, -21, -21, -22, -22, -22, -22, -22,
+	-22, -22, -22, -22, -22, -22, -22, -22, -22, -22, -22, -22, -21, -21, -21, -21,
+	-21, -21, -21, -21, -21, -21, -21, -21, -21, -21, -20, -20, -20, -20, -20, -20,
+	-20, -20, -20, -19, -19, -19, -19, -19, -19, -18, -18, -18, -18, -18, -18, -17,
+	-17, -17, -17, -17, -16, -16, -16, -16, -16, -15, -15, -15, -15, -15, -14, -14,
+	-14, -14, -13, -13, -13, -13, -12, -12, -12, -12, -11, -11, -11, -11, -10, -10,
+	-10, -9, -9, -9, -9, -8, -8, -8, -8, -7, -7, -7, -6, -6, -6, -5,
+	-5, -5, -5, -4, -4, -4, -3, -3, -3, -3, -2, -2, -2, -1, -1, -1,
+	0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+	4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 8, 8, 8, 8,
+	9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 12,
+	12, 13, 13, 13, 13, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15,
+	16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19,
+	19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+	19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 18,
+	18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 17, 17, 17, 17, 17, 17,
+	17, 16, 16, 16, 16, 16, 16, 16, 15, 15, 15, 15, 15, 15, 14, 14,
+	14, 14, 14, 13, 13, 13, 13, 13, 12, 12, 12, 12, 12, 11, 11, 11,
+	11, 10, 10, 10, 10, 10, 9, 9, 9, 9, 8, 8, 8, 8, 7, 7,
+	7, 7, 6, 6, 6, 6, 5, 5, 5, 5, 4, 4, 4, 3, 3, 3,
+	3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, -1, -1, -1,
+	-1, -2, -2, -2, -3, -3, -3, -3, -4, -4, -4, -4, -5, -5, -5, -5,
+	-6, -6, -6, -6, -6, -7, -7, -7, -7, -8, -8, -8, -8, -9, -9, -9,
+	-9, -9, -10, -10, -10, -10, -10, -11, -11, -11, -11, -11, -12, -12, -12, -12,
+	-12, -13, -13, -13, -13, -13, -13, -14, -14, -14, -14, -14, -14, -14, -15, -15,
+	-15, -15, -15, -15, -15, -15, -15, -16, -16, -16, -16, -16, -16, -16, -16, -16,
+	-16, -16, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17,
+	-17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17, -17,
+	-17, -17, -17, -17, -17, -17, -17, -17, -16, -16, -16, -16, -16, -16, -16, -16,
+	-16, -16, -16, -16, -15, -15, -15, -15, -15, -15, -15, -15, -14, -14, -14, -14,
+	-14, -14, -14, -13, -13, -13, -13, -13, -13, -13, -12, -12, -12, -12, -12, -11,
+	-11, -11, -11, -11, -11, -10, -10, -10, -10, -10, -9, -9, -9, -9, -9, -8,
+	-8, -8, -8, -8, -7, -7, -7, -7, -6, -6, -6, -6, -6, -5, -5, -5,
+	-5, -4, -4, -4, -4, -3, -3, -3, -3, -3, -2, -2, -2, -2, -1, -1,
+	-1, -1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 5, 6, 6, 6,
+	6, 6, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 9, 9, 9, 9,
+	9, 9, 10, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11, 11, 12, 12,
+	12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13, 13, 14, 14,
+	14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+	14, 13, 13, 13, 13, 13, 13, 13, 13, 13, 12, 12, 12, 12, 12, 12,
+	12, 11, 11, 11, 11, 11, 11, 11, 10, 10, 10, 10, 10, 10, 9, 9,
+	9, 9, 9, 9, 8, 8, 8, 8, 8, 7, 7, 7, 7, 7, 7, 6,
+	6, 6, 6, 6, 5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 3, 3,
+	3, 3, 3, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 0, 0, 0,
+	0, -1, -1, -1, -1, -1, -2, -2, -2, -2, -2, -3, -3, -3, -3, -3,
+	-4, -4, -4, -4, -4, -4, -5, -5, -5, -5, -5, -6, -6, -6, -6, -6,
+	-7, -7, -7, -7, -7, -7, -8, -8, -8, -8, -8, -8, -8, -9, -9, -9,
+	-9, -9, -9, -10, -10, -10, -10, -10, -10, -10, -10, -11, -11, -11, -11, -11,
+	-11, -11, -11, -11, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -13,
+	-13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13,
+	-13, -13, -13, -13, -13, -13, -13, -13, -14, -14, -14, -13, -13, -13, -13, -13,
+	-13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13, -13,
+	-13, -13, -13, -13, -13, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-11, -11, -11, -11, -11, -11, -11, -11, -11, -11, -10, -10, -10, -10, -10, -10,
+	-10, -9, -9, -9, -9, -9, -9, -9, -8, -8, -8, -8, -8, -8, -8, -7,
+	-7, -7, -7, -7, -7, -6, -6, -6, -6, -6, -6, -5, -5, -5, -5, -5,
+	-5, -4, -4, -4, -4, -4, -4, -3, -3, -3, -3, -3, -2, -2, -2, -2,
+	-2, -2, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 1, 1, 1,
+	1, 1, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4,
+	4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6,
+	7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 8, 8, 9,
+	9, 9, 9, 9, 9, 9, 9, 9, 10, 10, 10, 10, 10, 10, 10, 10,
+	10, 10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+	11, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+	12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+	12, 12, 12, 12, 12, 12, 12, 12, 12, 11, 11, 11, 11, 11, 11, 11,
+	11, 11, 11, 11, 11, 11, 11, 11, 10, 10, 10, 10, 10, 10, 10, 10,
+	10, 10, 10, 9, 9, 9, 9, 9, 9, 9, 9, 9, 8, 8, 8, 8,
+	8, 8, 8, 8, 7, 7, 7, 7, 7, 7, 7, 6, 6, 6, 6, 6,
+	6, 6, 5, 5, 5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4,
+	3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1,
+	1, 1, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -2,
+	-2, -2, -2, -2, -2, -3, -3, -3, -3, -3, -3, -3, -4, -4, -4, -4,
+	-4, -4, -5, -5, -5, -5, -5, -5, -5, -5, -6, -6, -6, -6, -6, -6,
+	-6, -7, -7, -7, -7, -7, -7, -7, -7, -7, -8, -8, -8, -8, -8, -8,
+	-8, -8, -8, -8, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9,
+	-10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10,
+	-10, -10, -10, -10, -10, -11, -11, -11, -11, -11, -11, -11, -11, -11, -11, -11,
+	-11, -11, -11, -11, -11, -11, -11, -11, -11, -11, -11, -11, -10, -10, -10, -10,
+	-10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10, -10,
+	-10, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9, -9, -8, -8,
+	-8, -8, -8, -8, -8, -8, -8, -8, -7, -7, -7, -7, -7, -7, -7, -7,
+	-7, -6, -6, -6, -6, -6, -6, -6, -6, -5, -5, -5, -5, -5, -5, -5,
+	-5, -4, -4, -4, -4, -4, -4, -4, -3, -3, -3, -3, -3, -3, -3, -2,
+	-2, -2, -2, -2, -2, -2, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2,
+	2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4,
+	4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8,
+	8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 9, 9, 9,
+	9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+	9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+	9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+	9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 8, 8, 8, 8,
+	8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6, 6, 5,
+	5, 5, 5, 5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4,
+	4, 3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 2,
+	2, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0,
+	0, -1, -1, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -2, -2, -2,
+	-2, -3, -3, -3, -3, -3, -3, -3, -3, -3, -4, -4, -4, -4, -4, -4,
+	-4, -4, -4, -5, -5, -5, -5, -5, -5, -5, -5, -5, -5, -6, -6, -6,
+	-6, -6, -6, -6, -6, -6, -6, -6, -6, -7, -7, -7, -7, -7, -7, -7,
+	-7, -7, -7, -7, -7, -7, -7, -7, -8, -8, -8, -8, -8, -8, -8, -8,
+	-8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8,
+	-8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8,
+	-8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8,
+	-8, -8, -8, -8, -8, -8, -8, -8, -8, -7, -7, -7, -7, -7, -7, -7,
+	-7, -7, -7, -7, -7, -7, -7, -7, -6, -6, -6, -6, -6, -6, -6, -6,
+	-6, -6, -6, -6, -6, -5, -5, -5, -5, -5, -5, -5, -5, -5, -5, -4,
+	-4, -4, -4, -4, -4, -4, -4, -4, -4, -3, -3, -3, -3, -3, -3, -3,
+	-3, -3, -3, -2, -2, -2, -2, -2, -2, -2, -2, -2, -1, -1, -1, -1,
+	-1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4,
+	4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 5, 5, 5, 5, 5, 5, 5, 5,
+	5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+	4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -3,
+	-3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -4, -4, -4, -4, -4,
+	-4, -4, -4, -4, -4, -4, -4, -4, -5, -5, -5, -5, -5, -5, -5, -5,
+	-5, -5, -5, -5, -5, -5, -5, -5, -6, -6, -6, -6, -6, -6, -6, -6,
+	-6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6,
+	-6, -6, -6, -6, -6, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7,
+	-7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -6, -6, -6, -6,
+	-6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6, -6,
+	-6, -6, -6, -6, -6, -6, -6, -6,
+};
+
+static const int8_t pcm_snare[3969] = {
+	-14, 10, 61, -38, -28, -53, -37, -50, -25, 31, 104, 63, 19, 26, 70, 19,
+	-16, 98, 67, -5, -9, -4, 123, 0, 76, 127, -8, 43, 56, 120, 15, 24,
+	22, -7, 82, 102, 46, -13, 83, 85, 71, 22, 92, 61, 53, 44, -3, 26,
+	72, 53, 3, 67, 67, -49, -36, -30, -62, 39, 21, 3, 63, -29, -54, -70,
+	-40, 26, -9, -88, -38, -95, -17, -89, -83, -21, 4, -28, -75, -28, -81, -119,
+	-83, -27, -36, -96, -8, -10, -85, 8, -88, -114, -53, -4, -39, -46, -53, -79,
+	-75, -60, -39, 17, -99, -73, 22, -14, -90, -38, -8, 30, -78, 34, 19, -44,
+	-7, 35, -40, 24, 8, -54, -25, -3, -37, 73, -16, -16, 35, 28, 3, 6,
+	31, 87, -19, 92, 97, 65, 82, 29, 106, 78, 72, 42, 13, 75, 81, -13,
+	27, 56, 14, 3, 10, -13, 0, 34, 47, 64, 20, -4, 95, 57, 61, 61,
+	12, 44, 7, 47, 66, -38, 58, -30, -45, -40, 19, 53, 59, -40, -9, 53,
+	43, 33, -42, -41, -59, -47, -32, 14, -5, -68, -69, -37, 15, -38, -1, -15,
+	7, -41, -57, -48, -7, -72, -83, -5, -49, -30, -87, -103, -81, -55, -103, -73,
+	9, -52, -103, -6, -65, -79, -22, -17, -57, -8, 13, -49, -28, -85, -13, -47,
+	-1, 14, -34, 7, 43, -47, 30, -5, 52, -48, -9, -33, -19, 58, 18, 0,
+	73, -32, -34, 56, 34, 68, 30, 84, 14, 4, 81, 42, -16, -17, -15, 68,
+	58, -2, 77, 75, 59, 53, 36, 65, 30, 91, 52, 61, 89, 94, 42, -7,
+	39, 82, 0, 4, 4, -2, 61, 28, -25, 21, 40, -37, -20, -43, 31, -4,
+	-50, -26, -34, 6, -12, -15, -28, -62, -32, 0, -13, -9, -59, -74, 4, -3,
+	-11, 21, -52, -7, -57, -24, 9, -42, -25, 15, -40, -68, 10, -21, -59, -65,
+	-92, -85, 12, -33, -9, -66, 0, -14, 5, -36, 12, -24, -68, 15, -49, 19,
+	-19, -33, -18, -32, -62, -63, -57, 32, -25, -57, -15, 12, 14, 45, -12, 54,
+	-43, -26, 11, 29, 7, 47, 24, -31, 11, 39, 1, -5, 44, 26, 82, 79,
+	13, -14, 2, 29, 28, 30, -6, 16, 28, 63, -2, 51, 24, 64, 54, 4,
+	55, 20, 66, -17, 12, 31, 7, 16, 33, -3, 58, -1, 38, 63, -25, 51,
+	-21, 5, -30, 49, -15, 4, 47, -37, -45, 14, -52, -46, -35, -61, -30, -60,
+	25, -18, -67, 2, -50, 12, -72, -65, -41, 2, 12, 14, -61, -45, 1, -3,
+	9, -75, -79, -44, -1, -16, -42, -16, -38, 0, -52, -7, -64, -21, -46, -43,
+	-48, -69, -62, -6, -5, -4, -24, -8, 13, 33, -21, 14, 22, 27, 12, -28,
+	29, 7, 26, 28, -21, -32, 36, 27, -32, -27, 9, 32, -16, 39, 8, 37,
+	3, 1, -6, 45, 40, -11, -6, 61, 9, 70, 75, 60, -1, -4, 62, 24,
+	-11, -5, 11, 7, -13, 48, -12, 8, 44, 48, 50, -1, -8, 31, 47, 39,
+	38, 7, 33, 48, 21, -23, 36, -36, -40, -16, -11, 40, 18, -10, 0, -15,
+	26, 0, -24, 24, 12, -24, 23, -58, 13, -26, -24, 10, -31, -31, -49, -11,
+	-9, -13, -58, 4, -30, -63, -55, -62, -60, -28, -7, -12, 12, 14, -17, 4,
+	9, -24, 5, -18, -1, 5, 14, -18, -53, -54, 2, -5, 17, -38, 17, 33,
+	-8, -39, 12, -37, 24, 27, -7, 38, -5, 34, -9, 28, -21, -1, 5, 47,
+	43, -15, 15, 48, 60, 18, -5, 47, -1, 33, 10, -10, -13, 20, -10, 38,
+	47, 46, 27, 37, 56, 11, 34, -1, 40, 65, 10, 38, -5, 62, -15, 0,
+	12, 39, 20, -18, 25, -21, -2, 47, 10, -32, -15, -13, -23, 22, -18, 12,
+	2, 25, -18, -46, 3, -4, -47, -13, -40, 25, -11, 8, -7, -10, 8, -57,
+	-33, -9, -35, 8, -39, -7, -22, -23, 3, 10, 12, -38, -22, -52, -3, -16,
+	-25, -22, -33, -45, -25, -7, -53, -39, -35, 2, -18, 12, -23, -39, -30, -47,
+	-11, -12, -16, 4, 1, -17, 11, -27, 12, -6, 22, 29, 4, -24, 18, -28,
+	-22, -11, 34, 4, 29, 15, 23, -19, 50, 14, -12, 24, 48, 19, 32, -8,
+	-2, 10, -11, 32, -13, 21, 36, -2, 59, 29, 40, 38, 26, 13, 28, 34,
+	9, -17, 49, 1, 46, 51, -18, 42, 1, 37, 29, -7, 28, -22, 34, 10,
+	37, -1, 15, -15, -18, -36, 11, 27, -12, -38, -38, -31, 6, -26, -15, 11,
+	-2, -47, 14, -4, -41, -50, 8, -35, -19, -35, -4, -26, -9, 7, -48, -30,
+	-6, 1, 3, -28, -9, -15, 4, -42, -48, -40, -30, -1, -9, -30, -45, -21,
+	19, -40, 16, -17, -2, -18, 23, 14, 6, -3, 3, -19, 8, 27, -27, 1,
+	4, 7, 38, 12, 5, -18, -3, 36, 20, 29, 41, 40, 41, 47, 44, 29,
+	19, -12, 47, 17, 6, 10, 36, 37, 6, -2, 14, -4, 26, 42, 13, -4,
+	47, -3, -3, 18, 28, 6, -9, 2, 38, 43, -4, 24, 29, 30, -22, -22,
+	-20, 10, -14, 30, -13, -2, -22, 25, -19, -17, -16, -23, -32, 12, -33, -21,
+	-39, -7, -11, 14, -42, 15, -37, -23, 11, 7, 9, -36, -38, -26, -28, -12,
+	-46, -13, -49, -29, -15, -33, -5, -3, -10, -20, -22, -16, 4, 14, -32, 7,
+	1, -11, -16, 4, 17, -9, -38, -3, -26, -30, -1, -19, 12, -9, 19, -27,
+	27, 12, -26, -11, 29, 23, -21, 23, 3, 4, 26, -10, 18, -1, 32, 37,
+	38, -5, -11, 11, -7, -1, 18, 31, 20, 45, 31, 44, 24, 9, 43, 22,
+	24, -4, -7, -12, -5, 3, 7, 26, 8, 6, 10, 17, 31, 38, -5, 4,
+	4, 16, -1, -11, 29, -5, 17, 11, -24, -12, 3, 13, 25, -19, -27, 14,
+	18, -28, -12, -22, -20, -17, -14, -15, -24, -24, -7, -14, -13, -32, -15, 4,
+	-30, -34, -19, -33, -30, -28, 9, -7, -19, -11, -18, -9, -7, -26, -24, 12,
+	1, -12, -4, -23, -29, 4, -20, -9, 10, -3, -8, -6, -18, 8, -16, 8,
+	11, 5, 5, -20, 23, -2, 25, -1, 21, -4, -1, -6, 21, 9, -3, -18,
+	28, -17, 2, -2, 22, -4, 28, 30, 13, 18, 16, 16, 11, -5, -7, 19,
+	-6, 23, 22, 31, 11, 10, 5, 13, 23, 32, -1, 29, 32, 11, 13, 32,
+	14, -7, 27, 3, -9, 19, -1, 27, 0, -6, -12, 16, -12, -16, -5, 10,
+	24, 23, 11, 13, -2, -6, -15, 16, 8, -31, -25, 12, 11, 15, -21, -11,
+	4, -24, -10, -31, -29, -18, -1, -37, -14, -34, -25, 6, 11, -32, -26, -28,
+	-25, -22, -32, -8, -17, -5, 6, 12, 8, -31, 8, -28, -3, 3, -13, 7,
+	-1, 16, -15, -3, -3, -15, 8, 20, 10, -2, -4, -8, 25, 20, -12, -18,
+	2, 25, -7, 18, 24, 0, 14, 15, -9, 19, 0, -12, -1, 32, -8, -1,
+	17, -2, 18, 24, 13, 21, 22, 20, 34, 0, -9, 2, 33, 8, 11, 15,
+	18, -13, 11, -12, 8, -14, -9, 10, 5, -6, 19, -9, -12, -10, -4, 1,
+	18, -9, 12, 9, 4, -14, -16, 15, -7, 8, -21, 14, -24, -16, -4, 7,
+	12, -24, -28, -17, -8, -5, 5, 5, -2, 8, 4, -31, -18, -31, -22, -10,
+	-12, 1, 5, -7, -12, -29, -22, 8, 9, 5, 3, 3, -24, -10, -29, 5,
+	5, 7, 0, -14, -9, -25, -14, 5, -5, -16, 13, -4, -2, -13, -3, 22,
+	-2, -11, 20, 13, -15, -15, -2, 2, 19, -12, 17, 6, -4, -8, 7, -5,
+	-9, 30, 19, 18, 21, -6, 21, 0, 13, 10, -6, 27, 24, 17, 10, -6,
+	-5, -9, 23, 27, 18, -2, 22, 27, -11, 11, -6, 5, -10, 11, 13, 11,
+	0, 4, -12, 20, 9, 2, 8, 17, -13, -7, -12, -10, 11, -2, -16, -6,
+	-7, 11, 11, 4, -20, 8, 8, -9, -20, -11, -2, 2, -26, 6, -22, -13,
+	-20, 9, -10, -22, -23, -29, -24, 1, -24, 2, 2, -9, -6, -20, 2, 1,
+	-7, -7, -15, -19, -11, 12, -2, 2, -19, 11, -1, -6, -15, -20, -4, -7,
+	10, 16, 3, 17, -14, 17, 3, 21, 17, 3, 12, -5, -5, 19, 8, 3,
+	24, -5, -10, 6, 6, 22, 13, -4, 17, 8, 26, 0, -4, -1, -3, 11,
+	5, 9, 7, 18, 6, -8, -7, -4, 2, 21, 6, 4, -4, -10, -11, -4,
+	-2, 11, 15, 0, 15, -5, 13, -2, -10, 15, 17, -4, 6, 1, -9, -10,
+	-17, -7, -1, -13, 9, -18, -2, -6, -2, -6, -23, -15, 4, 9, -14, 7,
+	-17, 1, -19, -17, -2, -4, -2, -8, -13, 2, -5, -17, -16, -5, -19, 5,
+	-12, 4, -6, -12, -16, 10, -16, -2, -3, 11, -7, -14, -5, -4, -10, 1,
+	-18, -18, -1, 11, 14, -3, 6, -3, -11, 11, 1, 17, 2, 3, 10, -1,
+	6, 19, 2, -7, 8, 9, 10, 22, 12, 13, -7, -2, 16, -1, -3, 16,
+	1, -6, 15, 2, 15, 23, -6, -8, 9, 18, 10, 8, -7, -1, 9, 11,
+	8, 4, -2, 12, 5, -5, -5, -11, 16, -2, -6, 6, -13, 13, -14, -6,
+	-6, 14, 0, -11, 13, 4, -18, 11, -8, -6, 5, 6, 0, -17, -11, -4,
+	-4, 0, -17, 0, 7, -19, -13, -12, -9, -3, -21, -21, -13, -19, 8, -4,
+	-20, 5, 5, -17, 1, -20, -15, 8, 9, -6, 8, -7, -7, -1, -18, -11,
+	-15, -17, 8, -13, -1, 7, 7, 6, 12, 0, -4, 13, -12, -3, 2, 14,
+	-3, 9, -5, 15, -3, 0, 14, 14, 4, -5, -6, 5, 16, 0, -5, -5,
+	13, -5, 0, -4, -3, 11, 16, 20, 16, 13, 9, -6, -1, 3, 4, 1,
+	3, 4, 2, 4, 8, 12, 2, 13, 17, 10, 6, -10, 3, 2, 7, 0,
+	-5, 7, -4, 0, 8, 3, -9, 8, 2, 6, -7, 7, -7, 10, -15, -7,
+	-6, -8, 7, 3, 5, -10, 7, -8, -15, 5, 6, 8, -10, -1, 0, -12,
+	-18, -6, -10, -2, -12, -6, -9, -13, 6, -13, -10, -10, 7, -1, 5, -10,
+	-11, 8, -15, 9, 8, 10, -1, 1, -7, -4, -8, -11, -4, -10, 3, -12,
+	2, -8, 2, 10, -7, -2, 9, 15, 7, 9, 1, 9, -6, 15, 6, 8,
+	12, 6, 13, 0, 13, 3, -4, 10, 14, 14, 9, 13, 3, 0, 10, -7,
+	0, -6, 16, 6, 14, 9, 12, 5, 14, 7, 8, -4, 0, -2, -5, 7,
+	7, 14, -7, -7, -1, 4, 7, 0, 1, -8, -8, -1, -9, -1, 2, -3,
+	6, 2, 9, 5, 9, 5, 2, 2, -3, 3, 7, -8, 4, -1, -12, -14,
+	-11, 5, -4, -2, -7, -14, -14, -5, -15, 6, -1, -14, -3, -1, -10, 3,
+	-9, -16, -7, -4, -14, 5, -13, -1, -4, -11, -9, -7, -9, -10, 11, -1,
+	-11, 9, -7, 4, 2, 4, -6, 10, 3, -7, -6, -6, -3, 13, 8, -7,
+	2, 4, 1, 7, 3, 10, -1, 12, -7, 4, 2, -4, 3, -3, 5, 11,
+	6, 15, -6, 11, 0, 10, 11, -3, 7, 0, 11, -1, 11, -6, 9, 6,
+	13, 13, -4, 6, 10, 1, -6, 2, 6, -7, 6, 8, 5, 0, 3, 9,
+	-3, -8, -9, -11, -6, -2, -5, -1, -2, 3, -8, 7, 3, 6, -14, 0,
+	-5, -7, 0, -13, -6, -15, 4, -7, -4, 6, -5, -3, -10, 6, 1, 6,
+	-8, -11, 3, -10, 0, 2, 1, 3, -7, -8, -10, 7, -3, -11, 1, -4,
+	9, 1, 2, -5, -9, -8, -8, -8, -4, 4, 7, -2, 5, -6, -5, -1,
+	-3, -2, -5, -7, 13, -6, -4, 2, 8, 6, 9, 4, 2, 5, -5, 1,
+	2, -1, -3, 8, -4, -4, 1, -3, 0, 6, 10, -6, -4, -1, -6, -5,
+	11, 2, 11, -5, 9, 6, 8, -3, -3, 3, 7, 3, -4, 3, -7, 10,
+	3, -8, 5, -10, -3, -2, -7, 7, 7, -9, 1, -4, 1, 1, 6, -7,
+	-5, -1, 0, -10, -5, -13, -4, -3, 1, 5, 1, -12, -12, 0, -3, 1,
+	1, -7, -1, -13, 0, -5, -8, -3, 6, 5, 3, -3, -10, -8, -8, -2,
+	-7, -5, 1, 0, -4, 8, 2, -5, -5, 4, 0, 0, 2, 0, 8, -5,
+	0, 9, -3, 0, 11, 6, -1, 10, 3, 10, 6, -1, 8, 1, 10, 10,
+	7, 7, 1, -4, 8, 3, 11, -1, 8, 4, -4, -4, -2, 2, 2, -4,
+	4, 10, 10, 6, 0, 10, -6, 10, 5, -1, 3, 0, 4, -5, -3, -5,
+	3, -8, -2, 1, 7, 7, -9, 0, -7, 5, 7, -2, 7, 3, -10, 3,
+	-2, -4, 4, 5, -9, -6, 3, -4, -5, 3, 1, 5, 0, 4, 3, 3,
+	-3, 3, -8, 5, -2, 5, 1, -6, -1, 4, -5, -11, -7, -7, -2, 1,
+	-4, 1, -5, -2, -2, -7, 3, 4, 7, 4, -8, -7, -6, -8, 1, 2,
+	-2, 6, 2, 7, -2, 8, 2, 8, -2, 6, -5, 1, -5, -4, 8, 7,
+	8, 3, -2, -2, -1, 4, 0, 9, 4, 8, 3, 4, -5, 10, 9, 5,
+	2, 1, 10, 3, -3, 4, -4, 6, 3, -5, -4, 9, 1, 8, -3, 4,
+	-6, 4, 3, -2, -2, -6, 4, 6, -4, 6, -7, 0, -7, 5, 3, 5,
+	4, -6, -1, -6, 1, -2, 3, 0, -8, -3, -10, 2, 0, -8, -6, 0,
+	3, -4, 0, -3, -9, -3, -2, -3, -4, 2, -5, -6, -5, -4, 3, -10,
+	-9, -5, -5, -2, 2, 4, 4, -1, -8, -5, 5, 2, -4, 1, 3, -8,
+	-1, -3, 5, 1, -3, -3, 1, -1, -6, -4, -4, -4, 3, -4, 0, -2,
+	-3, -4, 6, 4, -2, 8, 3, 7, 3, -5, 4, 7, 9, 3, 1, 4,
+	2, -2, -4, 8, -2, -1, -3, 7, 1, -2, 3, -4, -1, -1, 0, 0,
+	1, -5, 4, -5, 2, -6, 1, 6, 0, 2, -6, -1, -2, 4, 0, -3,
+	2, 2, 3, 4, -5, 0, 5, -5, 2, 4, -6, 3, -6, 3, -8, -9,
+	-8, -7, 1, -4, -6, -4, -9, -1, 4, -8, -8, 3, 2, -9, -8, -2,
+	0, 2, 4, 4, -3, -8, -5, 2, -7, -5, -3, -6, -2, 0, 3, 4,
+	6, -3, 6, -1, 3, -3, -3, 2, 1, 2, -2, 3, 2, 2, 1, -1,
+	3, 4, 3, 3, 4, -2, 6, -3, -2, -3, 6, -3, 4, -4, 1, 5,
+	-3, 7, -4, -4, 6, 1, 4, -3, -1, 3, -4, 3, -2, 4, 2, -3,
+	-5, 3, -4, 5, 7, 2, -4, 2, -3, -5, -5, 4, 0, 5, -3, 5,
+	-6, -1, -6, -6, 0, 2, -2, 0, -1, -6, -6, -6, 2, -2, -6, -6,
+	-1, 1, 2, -3, -1, 1, 3, -3, -2, 1, -1, -6, -2, -3, -4, -2,
+	-2, 0, 3, 3, -6, 0, 1, 2, 2, 1, -5, -4, -1, -3, 2, 5,
+	1, 3, -6, -3, 3, -5, -3, -3, 0, -2, -4, 0, 0, -3, 0, 5,
+	-3, 5, 0, 5, 2, -4, 4, 5, 1, -4, 5, 4, -4, -2, -4, 2,
+	3, 3, -2, 2, -3, 1, 7, -2, 2, -2, 5, 5, 3, 1, 0, 4,
+	-2, -3, -4, 4, 5, 5, 6, 2, 2, 4, -4, 5, 5, -2, 0, 3,
+	-4, -5, -3, -4, 4, 2, -3, 2, 2, 2, 4, -5, -3, 1, 1, -6,
+	-5, 0, -4, -5, -4, -5, -6, -6, -5, -7, -3, 0, -3, -4, -4, 3,
+	-5, -5, -6, -1, -6, -6, 2, 3, -3, -5, 3, 0, 1, -6, -4, -4,
+	1, -3, 1, 2, 4, 1, 4, -4, -1, 0, -5, -3, 3, 1, -4, -3,
+	4, 3, 3, -4, 5, 3, 2, -3, -1, -1, -2, -1, 0, 1, 4, 3,
+	-3, -1, -2, 1, 1, 5, 6, 5, -3, -2, -3, 0, 3, 5, -3, 5,
+	0, 0, 0, -2, -2, -4, 0, 3, -3, -1, 3, 4, 0, 5, 1, 3,
+	-2, -2, 0, -3, 3, 3, -1, 2, 4, 0, -1, -5, -4, 2, 1, -3,
+	-2, -6, 0, 1, -6, -2, -1, 2, 0, -3, 0, -2, -2, -3, -3, -1,
+	-1, 1, -6, -4, -2, -4, -5, 3, 3, 3, -5, 3, -1, -4, 1, -1,
+	-5, -4, -3, 1, -5, 1, -5, -1, 0, -1, 0, 1, 2, -2, 1, -3,
+	4, 1, 2, 3, 4, 1, 4, 3, 2, -1, 3, -2, 5, -1, -3, -1,
+	1, -2, 2, 0, 1, 5, 5, 3, 4, 3, 3, -1, 5, -3, 6, 2,
+	-3, 1, 1, -2, 5, -1, 1, 0, 1, -3, 3, -3, -3, 1, 5, 2,
+	-1, 2, 0, 0, -2, 1, -3, 4, -4, 4, 4, 2, 0, -1, 0, -4,
+	2, 1, 3, -2, -4, 0, 3, 1, -4, 2, -1, 3, 2, 3, -3, 3,
+	2, -5, -2, -5, -5, -1, -5, 0, -3, 3, -5, -5, -1, -1, -4, 0,
+	1, -4, -2, -3, 1, 1, -3, 2, -2, 3, 2, 2, -1, 2, -2, -3,
+	4, -1, 3, -2, -2, 4, 1, 1, -2, -2, 3, 0, -3, -2, -3, 1,
+	-3, 0, 2, 0, 0, 2, 1, -2, 4, -3, -1, 2, 5, 2, -1, 0,
+	4, -2, 5, -2, -1, 5, -1, 1, 1, -1, 0, -2, 4, 2, 2, -3,
+	4, -1, -1, 2, 0, -3, -3, -1, 2, 0, -2, 3, -2, -3, 1, -1,
+	-1, -2, 1, -1, 0, 1, 0, -4, -2, 2, -3, -1, -2, -1, -4, -2,
+	-3, -2, 1, -1, -4, 0, 2, -4, 2, 2, 0, -2, 3, 2, 1, -2,
+	-2, -2, 1, 2, 3, 1, -2, -4, -3, -1, -1, 2, -4, -4, 0, -4,
+	2, -2, -3, -2, -3, 0, -2, -2, -1, 3, -3, 0, 0, 1, -2, -1,
+	-2, 1, 0, -2, -2, 4, 2, -1, 0, 1, -3, 3, -2, -2, 3, 4,
+	-2, 4, 1, -2, 2, 2, 3, 1, 4, -2, 0, 1, 1, -1, 0, 1,
+	0, 1, -1, 0, 1, 0, 1, -1, 3, 1, 4, -1, 0, 2, 1, 0,
+	-3, 3, 3, 0, -2, -3, -1, 1, -1, 0, -3, -1, -2, -2, 2, -1,
+	1, 2, -4, -4, 0, -3, -2, -1, 2, -2, 2, -3, -1, -3, -1, 0,
+	2, 1, -3, 1, 1, 1, 0, -1, 0, 0, 1, -1, 0, 0, 1, -2,
+	0, 2, -2, -2, 2, 0, -3, -3, 1, -2, 1, 3, -3, -1, 2, -2,
+	3, -1, 3, 0, 0, 1, 0, 3, -1, -2, 4, 1, 1, 2, 4, 3,
+	-2, 0, 4, 1, -1, 1, 1, -2, 4, 1, -2, -1, 2, 4, -2, 3,
+	-1, 2, 0, -1, 0, 0, -1, -1, 3, 3, -3, -1, -1, 2, 3, 1,
+	0, 3, -2, 2, 0, -2, 1, -2, -1, -1, 0, 2, -3, -3, 0, 1,
+	3, 0, 0, -2, -3, 2, -1, 0, -1, 1, 2, 1, -3, 0, 1, 1,
+	1, -1, -2, 0, -2, -1, 0, 0, 1, -1, 2, 0, -1, 1, 1, 0,
+	2, 0, -3, 1, 2, 1, -2, -1, 2, -1, 1, -1, -1, -2, 1, -3,
+	1, -3, -1, 2, 1, 2, 1, 0, -2, 0, 1, -1, 1, 2, 2, -2,
+	-1, 1, 2, -1, 2, 1, 3, 2, 2, 1, 3, 2, -1, -1, -2, 0,
+	0, 3, 2, 0, -2, 0, 0, 2, 3, 2, 2, 3, -2, 1, -2, 2,
+	-2, 2, 1, 1, -2, 1, 0, -2, 3, 2, 2, 2, 0, 1, 2, -2,
+	-1, -2, -2, 0, -2, 0, 0, 0, -1, 1, 1, 0, 0, 0, -3, -2,
+	0, -2, -2, -2, 2, 1, 0, 0, -3, -1, 1, -2, 0, 1, -2, 1,
+	-2, -2, -2, 1, -1, -2, 1, 1, 0, 0, -3, 0, 0, -1, 1, -2,
+	-2, 0, 0, -2, -2, -2, -2, 2, -1, 3, -1, -2, -2, 3, -1, 1,
+	2, -2, -2, 2, 0, 2, 1, -1, -2, 3, 1, -1, 1, 1, 1, -1,
+	-2, 3, -2, -1, 0, 2, 2, 2, 1, 1, 2, -2, 0, -1, -1, 0,
+	1, 3, 1, -1, 2, 0, 1, -1, -1, 1, 2, 1, 1, 1, -1, 1,
+	1, 1, -2, -2, -2, -2, -1, 2, -2, -1, 1, 0, -2, 0, 0, 0,
+	-1, 0, -3, 0, 2, -2, -2, 1, -1, 0, 1, -2, 1, -1, -1, -2,
+	0, 0, 1, 2, 0, -2, -1, 2, -2, 2, -2, -2, 1, 1, -2, 1,
+	2, 1, -1, -2, -1, -1, 0, 0, 1, -1, 1, -1, -1, 1, 1, 2,
+	2, 2, -2, 1, 2, 1, 1, 1, 2, 1, 2, 1, -1, 2, 2, 3,
+	2, 2, -1, -1, 0, 2, -2, -1, 0, 1, 2, -1, -1, 2, 1, 1,
+	2, 1, 2, 2, -1, -1, -2, 0, 1, 1, -2, -1, 0, 2, 0, -1,
+	-1, -2, -1, 0, -1, 1, 1, 0, 1, 1, -1, 0, 0, 0, -1, -1,
+	-1, 0, -1, -2, 0, 1, 1, 0, -2, 1, 0, -2, -1, 0, -2, 0,
+	-2, -1, 0, 1, 0, -1, -1, -2, -2, -2, 2, -1, -1, -2, 2, -1,
+	1, 0, -1, 1, 0, 0, -2, 0, -1, 1, 1, 2, 2, 1, -2, -2,
+	-1, -1, -1, -1, 1, 2, -1, 1, -2, 0, 0, 1, -1, 2, -1, 1,
+	2, 2, 0, -1, 1, 0, 0, 2, 2, 1, -1, -2, -1, 1, 2, 2,
+	2, -1, 1, -1, 0, -1, -1, -1, 0, 0, -1, -1, 2, -2, 1, -1,
+	-1, 2, -1, -2, 2, -1, -1, -1, -1, -1, -1, 0, -2, -1, -1, 0,
+	-2, 0, 1, 1, -1, -2, 1, -1, 1, -2, 0, -2, -1, 1, 0, 0,
+	1, 0, 0, 1, 1, -2, 1, 1, 1, -1, 0, 0, -2, 0, 1, 1,
+	1, 0, 0, 1, -2, -2, 2, -1, -1, 1, -1, -2, 2, 0, 1, 1,
+	1, 1, 1, -1, 1, -1, 0, 2, -1, -1, 1, 0, -2, 0, 2, 0,
+	0, 1, 1, 1, -1, -1, 0, 0, 1, 1, 2, 2, 1, 2, 0, -1,
+	-1, 1, 0, 0, 0, 2, 1, 1, 0, 0, 2, 1, 1, -1, -1, 1,
+	1, -1, 1, 1, 1, 2, 1, -1, 0, 1, 1, 1, -1, 1, -1, 1,
+	1, -1, -1, -1, 1, 2, 1, 1, 1, 0, 0, -2, 0, -1, -2, 0,
+	0, -1, -2, 0, -1, 0, -1, 0, 1, 0, -2, -1, 1, 0, 1, 0,
+	-1, -1, 0, 0, 1, -1, -1, 0, 1, -1, 0, 0, 0, -1, -1, 0,
+	1, -1, 1, 0, -1, -1, 1, 0, -1, 1, 0, 0, 1, 0, 0, 1,
+	0, 0, 1, 1, -1, -1, 1, -1, 0, -1, 2, 0, 0, 2, -1, 0,
+	1, 2, -1, 1, -1, -1, 2, 0, -1, 1, 1, 0, 1, 2, 2, -1,
+	-1, -1, 1, 1, 0, 1, -1, 1, 0, -1, 0, 0, 1, 0, -1, 1,
+	0, -1, -1, -1, -1, 1, 0, 1, 0, 1, -1, 1, 0, 0, -1, 0,
+	-1, 0, -2, 0, 1, 0, -1, 0, 1, 1, 0, 1, 0, 0, 0, -1,
+	0, 1, 1, -1, -1, -1, 0, 0, -1, 0, 0, -1, 1, 1, -1, 0,
+	-1, 0, -1, 0, 0, 1, -1, 1, 0, 0, -1, 0, 0, 0, 2, 0,
+	-1, 1, 0, -1, 1, -1, -1, -1, -1, 2, -1, 1, 1, 1, 0, 1,
+	1,
+};
+
+static const int8_t pcm_hat[1764] = {
+	-70, 32, 94, -115, 63, -52, -20, 6, 25, 102, -116, 58, -46, 83, -5, -34,
+	67, -118, 83, -44, -18, -10, -14, 56, -1, -72, 89, 1, -92, 11, 58, -53,
+	99, -52, -22, 11, -4, 28, -54, -11, 22, 35, -7, 68, -53, 30, 12, -67,
+	-43, 50, -57, 50, 34, -58, 7, 89, -120, 4, 93, 19, 10, -127, 119, -26,
+	-94, 37, 10, -21, -17, 29, 35, 39, -21, -50, 21, 15, -41, -24, 113, -27,
+	-72, 15, 4, 1, -25, 64, 32, -89, 42, 24, -2, -18, 17, -63, 91, -36,
+	-15, 31, 2, -38, 59, -88, 85, -31, 8, -48, -38, 105, -29, 23, 3, -56,
+	47, -61, 46, -76, 37, -12, -1, 79, -32, -16, 41, -64, 12, -46, 0, 101,
+	-12, -76, 14, 7, -37, 13, 27, -28, 31, -22, 79, -41, -4, -12, 36, -74,
+	88, -44, 44, 4, -64, -22, -2, 93, -97, 6, 33, -4, 9, 34, -75, 23,
+	1, 26, -10, -29, -5, 14, 37, 4, 34, -75, 37, 16, -65, 65, -36, -9,
+	40, 23, 0, -64, -2, 64, -53, 31, 0, -22, -16, 34, 11, 11, -6, 4,
+	-30, -24, 63, -47, -34, 29, 40, -32, -5, 11, -7, -37, 71, -66, 73, -4,
+	-13, 8, -22, -50, 40, -40, 42, -37, 26, -21, 71, -79, 29, 11, 12, -6,
+	10, -39, 8, -10, 15, -32, 8, 34, 11, -45, 69, -79, 51, -7, -8, 14,
+	-30, 24, 16, 9, -29, -11, -10, 58, -58, 26, 13, -55, 19, 0, 47, -2,
+	-13, -25, -10, 28, 8, 9, -4, -8, -45, 60, -11, -47, 22, -3, 48, -63,
+	-10, 3, 45, -13, 10, -37, 45, -45, 10, -6, 38, -26, 14, 22, -49, 14,
+	27, 15, -32, 24, -12, -38, 48, -1, -41, -11, 5, 39, -31, 23, 14, -16,
+	-6, -14, 50, -31, -26, 0, 25, 23, -39, 31, -3, 7, 15, -11, 3, -39,
+	17, 1, -8, 14, 13, -35, -8, 42, -13, 13, -45, 19, 6, 16, -39, 37,
+	10, -27, -19, 38, -10, -25, 1, 22, 6, 4, -18, 2, 5, -25, 10, 20,
+	1, -27, 6, 37, -55, 8, 41, -10, 6, -25, 29, -22, -8, 25, -39, 41,
+	-23, 11, -4, -8, 27, -41, 30, 2, -33, -4, 23, 21, -3, -2, -12, 12,
+	-4, -11, -20, 37, 10, -14, 8, -8, -25, 15, 21, -20, 15, 4, -31, 10,
+	22, -26, 29, -44, 14, 19, -22, -15, 11, 30, -9, -27, 31, -30, 27, -2,
+	10, 4, -45, 39, -9, 1, -28, 39, -23, 17, -19, -10, 26, -15, -8, 17,
+	1, -24, 25, 11, -13, -27, 3, 32, -27, 21, 7, -22, 25, -33, -1, 29,
+	-23, 7, 6, -22, 17, -9, 0, -6, 31, -5, 0, -17, 20, -25, -8, 20,
+	3, 2, -11, -11, 11, 4, -14, -3, 41, -22, 0, 6, -6, 20, 2, -3,
+	-9, 7, -29, 3, 9, 5, -8, 17, -3, 6, -35, 14, 1, 24, -39, 32,
+	0, -8, 8, -18, 9, -20, 12, 20, -33, 23, -22, 30, -1, 3, -33, 5,
+	29, -14, 1, -7, 10, -9, -9, 18, -2, -16, 5, 20, -22, 1, -3, 15,
+	-13, 2, 7, 12, -15, 8, 15, -2, -27, -5, 19, 15, -14, -10, -8, 14,
+	2, -7, 23, -4, 0, -17, 19, -27, 18, -5, -3, -7, 6, -6, -8, 24,
+	0, 5, 0, -14, -10, 20, -4, 7, 2, -4, -25, 6, 21, 1, -27, 2,
+	1, 17, -15, 21, 2, -12, -13, 19, -1, -12, 22, -7, 3, 4, -9, -5,
+	13, -23, 23, -21, -1, 7, 1, 1, -5, 15, -25, 8, 18, -24, 4, 17,
+	-2, 4, -8, -16, 9, 7, -13, 24, -12, -2, 14, -25, -1, 15, -4, -12,
+	27, -10, 10, -3, 1, -23, 15, -1, -2, 4, -4, -14, 22, -9, -5, 3,
+	2, -8, 14, 6, -23, 7, -7, 5, 16, -2, -9, -12, 10, -7, 7, -11,
+	16, 8, -9, -1, -5, -5, 18, -20, 2, -4, 18, -2, -10, 9, 9, -19,
+	11, 8, -14, -5, 18, -20, 12, -10, 18, -2, -5, 3, -19, 23, -12, -10,
+	4, 16, -11, 11, -13, 0, 1, 9, -3, -10, 0, 7, 11, -4, -8, -5,
+	15, -18, 4, -1, 5, 7, -9, 13, -3, -7, 2, -2, -9, 6, 12, 2,
+	-13, -8, 3, -1, 3, 12, -15, -1, 7, 9, 2, -3, -11, -5, 15, -13,
+	14, -14, 5, -1, 9, -8, 1, 4, 1, -9, 7, -1, 2, 2, -13, 12,
+	-12, 4, 11, -5, 4, 1, -12, 12, -1, -8, 10, -13, 8, 5, -10, 0,
+	10, -13, 11, -14, 2, 4, 9, -10, 5, 0, 1, -3, 6, -4, -4, 9,
+	-4, -4, -5, 0, 3, -1, -1, 10, -3, -8, 12, -12, -2, 1, 4, -5,
+	12, -7, 5, 1, -3, 3, -6, 6, -6, 5, 5, -14, 11, -5, 8, -12,
+	7, -5, 3, -2, 3, 5, -8, 6, -8, 8, -12, 7, 6, -14, 11, -11,
+	8, -6, 5, 7, -11, 8, 2, 1, -7, -7, 13, -9, 7, -1, -6, 2,
+	-3, 1, -4, 9, -3, -3, -4, 4, 0, 9, -12, 4, 7, -11, 8, -4,
+	0, 1, -3, 0, 5, -6, 2, 6, -1, -1, -6, 6, -6, -1, 10, -11,
+	10, -10, 7, -2, -2, 2, 2, 5, -4, 0, 0, -6, 1, 2, -4, 10,
+	-9, 7, -8, 9, -8, -2, 5, -5, 8, 0, -1, -3, 4, 2, -3, 0,
+	2, -1, 3, 0, -3, 0, -1, -5, 6, -2, 2, 3, -8, 7, -6, 4,
+	4, -9, 6, 2, -2, -7, 7, -7, 4, 1, 5, -10, 4, -1, 6, 1,
+	0, -8, 2, 2, -4, 5, 2, -5, -2, 6, 2, -7, 1, 5, -8, -1,
+	6, -2, -1, 3, -1, -5, 5, -7, 4, 5, -4, -3, 1, -3, 9, -1,
+	0, 1, 1, -3, -2, 2, 3, -4, 6, -1, -2, 0, -4, -3, 6, -4,
+	4, -4, 5, -3, 4, -3, 3, 1, -8, -1, 1, 7, -8, 6, -1, 2,
+	0, -3, 0, -1, -2, 8, -1, -1, 0, -6, 4, 1, -2, 0, -3, 5,
+	-1, -5, 1, 0, 6, 2, -1, 1, -4, -2, 3, -2, 1, -4, 6, -3,
+	-1, 1, 3, 2, -5, 2, -3, 7, 0, -4, -3, 1, 3, -5, 6, -1,
+	1, 2, -7, 1, 4, -3, 4, -2, 1, -4, -1, 0, 4, 2, -2, -3,
+	1, 2, -4, 4, 2, 0, -5, 4, -1, 3, -1, -1, 1, -1, -1, -5,
+	5, 0, -4, 0, 0, 6, -6, 6, -5, 2, 1, -1, 1, -3, -1, 5,
+	-4, -2, 3, -3, 6, -2, -3, 4, -4, 6, -4, 3, -4, -1, 2, -3,
+	6, -5, 0, 0, 3, -1, 1, -1, -5, 2, 2, -5, 7, -6, 4, 2,
+	-3, -2, 0, 2, 2, -2, 2, 0, -1, 1, -3, 1, 1, -3, 3, -5,
+	5, -3, 1, 3, -1, -2, -2, -1, 0, 5, 1, -6, 6, -3, -3, 4,
+	0, 0, 0, 2, 0, -5, 3, 2, -4, 0, 0, 3, -3, 1, 1, -1,
+	0, 2, -4, 4, -1, 1, 0, -4, 5, -1, 1, -4, 5, -4, -1, 5,
+	0, -4, 0, 1, 4, -1, -2, 3, -3, 2, 0, -1, 2, -1, 0, 0,
+	0, -4, 3, 2, -1, -5, 2, 0, 1, 1, 1, -4, 1, -1, 3, -4,
+	-1, 4, 1, -2, -1, 0, -2, 0, 0, 1, 2, -3, -1, 2, -2, 2,
+	1, -1, 3, -2, 0, -2, 3, -3, 2, -1, 0, 1, -1, 1, 2, -1,
+	2, -3, 2, 2, 0, -1, -3, 2, -1, -2, 4, -3, -1, 0, 1, -1,
+	1, 2, 0, -2, 0, 0, 2, -2, 0, -1, 2, -3, 4, -1, -2, 2,
+	1, -1, -1, -2, 3, 1, -4, 2, -1, 1, -1, -1, 1, 1, 0, -1,
+	0, 0, 1, -1, 2, -1, 0, -1, -1, 3, 0, -3, 0, -1, 0, 0,
+	4, -4, 2, 0, 1, -1, -2, 2, -2, 2, -1, -1, 1, 0, -1, 0,
+	-1, 3, -2, 2, 1, 0, -2, 2, -1, 0, -1, -1, 0, 0, 1, 2,
+	0, -1, 0, 0, 0, 0, -1, -2, 1, 1, -1, 0, 2, -2, 2, -1,
+	-2, 1, 2, -1, 0, -1, 1, -1, 2, -2, -1, 1, -1, 0, 2, -2,
+	1, 0, -1, 1, 1, 1, -3, 0, 0, 2, 0, -2, 1, 2, -2, -1,
+	2, -1, 1, -1, 1, -1, 0, 0, -1, 3, -2, 1, 0, 0, 0, 1,
+	-2, 0, 2, 0, -2, 1, 1, -2, 2, -1, 1, -1, 1, -1, -2, 1,
+	0, -1, 0, 2, -3, 1, 1, 0, 0, 1, -1, -1, 2, -2, 1, -1,
+	2, 0, -2, 2, 0, -2, 2, 0, 0, 0, 0, 0, 1, -1, 0, 0,
+	1, -2, 0, 0, 1, 1, -2, 2, 0, -2, 2, 0, -1, 1, 0, -2,
+	2, 0, 0, -2, 2, -2, 0, 0, -1, 1, 0, 0, 0, -1, 1, 0,
+	0, 1, -1, 0, 0, 1, -1, 1, 1, -2, 1, 1, -1, 1, 0, 0,
+	0, -1, 1, 1, -1, 0, -1, 1, -1, 0, 0, 1, -1, 2, 0, -1,
+	1, 0, -1, 0, 1, 0, -1, 2, 0, -1, 1, -1, 0, 1, 0, 2,
+	-1, -1, 1, 1, -1, 0, 1, 0, -1, 1, 0, 0, 1, -1, 0, 0,
+	-1, 0, 0, 0, 1, -1, 1, -2, 1, 0, -1, 0, 0, 1, 0, 0,
+	-1, 1, 0, -1, 1, 0, -1, 0, 1, -2, 1, 0, -1, 2, -1, 0,
+	-1, 0, 0, -1, 0, 1, -1, 0, 0, -1, 1, -1, 0, 0, 1, -1,
+	1, 0, 0, 0, 0, 0, -1, -1, 1, -1, 1, 1, -1, 0, -1, 1,
+	1, -1, 0, -1, 0, 1, -1, 1, -1, 1, 0, -1, 0, -1, 0, 0,
+	1, 0, -1, 1, 0, -1, 1, 0, -1, 1, 0, -1, 1, 0, 0, 0,
+	0, 0, 0, 0, -1, 0, 1, -1, 1, -1, 1, -1, 0, 1, -1, 1,
+	0, 0, 0, 0, 0, 1, 0, 0, -1, 0, 1, -1, 1, 1, -1, 1,
+	0, 0, -1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, -1, 0,
+	1, -1, 1, 0, -1, 1, 0, -1, -1, 1, -1, 1, -1, 0, 1, -1,
+	1, -1, 1, -1, 1, 0, 0, 0, 0, 0, -1, 1, 0, -1, 1, -1,
+	0, 0, 1, 0, 0, -1, 1, -1, 1, -1, 0, 0, -1, 1, 0, -1,
+	1, 0, 0, -1,
+};
+
+static const int16_t pcm_keys[6096] = {
+	0, 294, 581, 854, 1109, 1339, 1540, 1710, 1846, 1947, 2013, 2045, 2047, 2021, 1970, 1901,
+	1816, 1721, 1621, 1520, 1422, 1330, 1246, 1172, 1108, 1055, 1012, 976, 947, 921, 895, 868,
+	836, 797, 749, 691, 622, 542, 452, 352, 245, 132, 16, -100, -214, -323, -425, -518,
+	-602, -674, -736, -787, -829, -864, -894, -921, -949, -978, -1013, -1055, -1105, -1166, -1236, -1316,
+	-1404, -1498, -1595, -1691, -1783, -1865, -1935, -1985, -2014, -2016, -1989, -1929, -1837, -1711, -1552, -1361,
+	-1143, -901, -639, -364, -80, 205, 485, 754, 1007, 1238, 1443, 1618, 1761, 1871, 1948, 1993,
+	2007, 1993, 1956, 1898, 1825, 1740, 1648, 1554, 1462, 1373, 1291, 1218, 1154, 1100, 1054, 1016,
+	984, 955, 927, 897, 864, 824, 776, 718, 650, 571, 482, 383, 277, 165, 49, -68,
+	-183, -294, -400, -497, -585, -662, -729, -786, -834, -874, -908, -938, -968, -998, -1032, -1072,
+	-1120, -1176, -1241, -1314, -1395, -1482, -1572, -1662, -1748, -1826, -1893, -1943, -1972, -1977, -1954, -1902,
+	-1818, -1702, -1554, -1376, -1171, -942, -692, -428, -155, 121, 395, 659, 910, 1140, 1348, 1527,
+	1677, 1796, 1883, 1939, 1965, 1963, 1938, 1892, 1829, 1754, 1671, 1584, 1497, 1413, 1334, 1262,
+	1198, 1143, 1095, 1055, 1020, 989, 958, 927, 892, 851, 803, 745, 677, 600, 512, 414,
+	309, 198, 82, -35, -151, -265, -373, -474, -566, -648, -720, -783, -835, -880, -919, -952,
+	-984, -1016, -1050, -1089, -1134, -1186, -1246, -1314, -1389, -1469, -1552, -1636, -1717, -1791, -1855, -1903,
+	-1933, -1940, -1922, -1875, -1799, -1693, -1555, -1389, -1196, -978, -741, -488, -225, 42, 309, 568,
+	816, 1046, 1255, 1439, 1595, 1721, 1817, 1883, 1920, 1930, 1916, 1882, 1830, 1765, 1690, 1611,
+	1529, 1449, 1373, 1303, 1240, 1184, 1135, 1093, 1056, 1023, 990, 957, 920, 878, 830, 772,
+	705, 628, 541, 445, 341, 231, 115, -2, -119, -234, -345, -449, -545, -632, -709, -776,
+	-834, -884, -926, -964, -998, -1032, -1067, -1105, -1147, -1197, -1252, -1315, -1384, -1459, -1536, -1614,
+	-1690, -1760, -1820, -1867, -1897, -1906, -1891, -1850, -1781, -1683, -1555, -1400, -1218, -1012, -786, -544,
+	-291, -32, 227, 482, 726, 955, 1165, 1352, 1513, 1646, 1751, 1826, 1874, 1895, 1892, 1868,
+	1827, 1771, 1705, 1633, 1558, 1483, 1410, 1342, 1279, 1223, 1174, 1130, 1092, 1056, 1022, 987,
+	949, 906, 857, 799, 733, 657, 571, 476, 373, 263, 149, 31, -87, -203, -316, -423,
+	-522, -613, -695, -767, -830, -884, -931, -972, -1010, -1045, -1081, -1119, -1160, -1207, -1259, -1318,
+	-1382, -1451, -1523, -1595, -1666, -1732, -1789, -1834, -1864, -1874, -1862, -1826, -1763, -1673, -1554, -1409,
+	-1237, -1042, -827, -596, -352, -102, 150, 399, 640, 868, 1078, 1268, 1433, 1572, 1684, 1769,
+	1826, 1857, 1865, 1852, 1820, 1774, 1717, 1652, 1583, 1513, 1444, 1378, 1317, 1261, 1211, 1167,
+	1126, 1089, 1053, 1016, 977, 934, 884, 826, 760, 685, 600, 507, 405, 296, 182, 64,
+	-54, -172, -286, -395, -498, -593, -679, -755, -823, -882, -933, -978, -1019, -1056, -1093, -1132,
+	-1172, -1217, -1266, -1321, -1381, -1445, -1512, -1579, -1646, -1707, -1761, -1805, -1834, -1845, -1835, -1803,
+	-1746, -1662, -1552, -1416, -1254, -1070, -865, -644, -410, -168, 77, 321, 558, 784, 994, 1185,
+	1354, 1499, 1618, 1710, 1776, 1818, 1835, 1832, 1810, 1774, 1725, 1668, 1605, 1540, 1475, 1412,
+	1352, 1297, 1247, 1202, 1160, 1122, 1084, 1046, 1006, 961, 911, 853, 788, 713, 629, 537,
+	436, 328, 215, 98, -21, -139, -255, -367, -472, -571, -661, -742, -813, -877, -932, -981,
+	-1025, -1065, -1104, -1143, -1183, -1226, -1274, -1325, -1381, -1440, -1503, -1566, -1628, -1686, -1737, -1778,
+	-1806, -1818, -1811, -1782, -1730, -1652, -1550, -1422, -1270, -1095, -900, -689, -464, -230, 8, 246,
+	479, 702, 912, 1105, 1277, 1426, 1551, 1651, 1726, 1776, 1804, 1810, 1798, 1770, 1730, 1680,
+	1624, 1564, 1503, 1443, 1386, 1332, 1282, 1236, 1194, 1154, 1115, 1075, 1034, 989, 938, 881,
+	815, 741, 659, 567, 467, 361, 248, 131, 13, -106, -224, -337, -446, -547, -641, -726,
+	-802, -870, -929, -982, -1029, -1072, -1113, -1153, -1193, -1235, -1281, -1329, -1382, -1438, -1496, -1554,
+	-1612, -1667, -1715, -1754, -1781, -1793, -1788, -1762, -1714, -1643, -1547, -1427, -1284, -1118, -933, -730,
+	-514, -288, -57, 175, 403, 624, 833, 1026, 1201, 1354, 1485, 1592, 1674, 1733, 1770, 1785,
+	1782, 1763, 1731, 1689, 1639, 1585, 1528, 1472, 1417, 1364, 1315, 1269, 1226, 1185, 1145, 1105,
+	1062, 1016, 965, 908, 843, 769, 688, 597, 499, 393, 281, 165, 46, -73, -192, -307,
+	-418, -522, -619, -708, -788, -860, -924, -980, -1031, -1077, -1120, -1161, -1202, -1243, -1287, -1334,
+	-1384, -1436, -1490, -1545, -1599, -1650, -1695, -1732, -1758, -1771, -1766, -1743, -1699, -1633, -1544, -1431,
+	-1296, -1139, -963, -769, -561, -343, -119, 107, 331, 549, 757, 950, 1127, 1284, 1419, 1532,
+	1622, 1689, 1734, 1759, 1764, 1754, 1730, 1695, 1652, 1603, 1551, 1498, 1446, 1395, 1346, 1301,
+	1257, 1216, 1175, 1134, 1090, 1044, 992, 935, 870, 797, 716, 627, 530, 425, 314, 198,
+	80, -40, -159, -276, -389, -495, -596, -688, -772, -848, -916, -977, -1031, -1080, -1125, -1167,
+	-1209, -1251, -1294, -1339, -1386, -1435, -1486, -1538, -1588, -1636, -1678, -1713, -1738, -1750, -1747, -1726,
+	-1686, -1624, -1541, -1435, -1307, -1158, -990, -805, -606, -395, -178, 42, 262, 477, 683, 876,
+	1054, 1214, 1354, 1473, 1569, 1644, 1697, 1730, 1744, 1742, 1726, 1698, 1661, 1618, 1571, 1522,
+	1472, 1424, 1376, 1331, 1288, 1246, 1204, 1162, 1118, 1071, 1019, 962, 897, 825, 745, 657,
+	560, 457, 347, 232, 114, -6, -126, -244, -359, -468, -571, -667, -755, -834, -906, -970,
+	-1028, -1080, -1128, -1172, -1215, -1257, -1299, -1343, -1388, -1435, -1483, -1532, -1579, -1624, -1664, -1697,
+	-1720, -1732, -1730, -1711, -1673, -1616, -1538, -1438, -1318, -1176, -1016, -839, -647, -444, -234, -19,
+	196, 407, 611, 804, 983, 1146, 1290, 1413, 1516, 1598, 1658, 1699, 1722, 1727, 1719, 1698,
+	1668, 1631, 1589, 1544, 1497, 1450, 1405, 1360, 1317, 1275, 1233, 1190, 1146, 1098, 1046, 989,
+	924, 853, 774, 686, 591, 488, 379, 265, 148, 28, -93, -212, -328, -439, -545, -644,
+	-735, -819, -894, -962, -1023, -1078, -1129, -1175, -1219, -1262, -1304, -1347, -1391, -1436, -1481, -1527,
+	-1571, -1613, -1651, -1682, -1704, -1716, -1714, -1697, -1662, -1609, -1535, -1441, -1327, -1193, -1040, -870,
+	-686, -491, -287, -78, 133, 340, 542, 734, 914, 1079, 1226, 1354, 1463, 1551, 1618, 1667,
+	1697, 1711, 1710, 1696, 1673, 1641, 1604, 1563, 1519, 1475, 1431, 1388, 1345, 1303, 1261, 1218,
+	1173, 1125, 1073, 1015, 952, 881, 802, 715, 621, 520, 412, 299, 181, 61, -59, -179,
+	-296, -410, -518, -620, -714, -801, -880, -952, -1017, -1075, -1128, -1177, -1222, -1266, -1308, -1351,
+	-1393, -1437, -1480, -1523, -1565, -1605, -1640, -1669, -1690, -1701, -1700, -1684, -1652, -1602, -1533, -1444,
+	-1336, -1208, -1063, -900, -723, -535, -337, -134, 72, 276, 476, 667, 847, 1013, 1163, 1295,
+	1409, 1503, 1577, 1633, 1670, 1692, 1698, 1691, 1674, 1649, 1616, 1580, 1540, 1498, 1456, 1414,
+	1372, 1330, 1288, 1245, 1200, 1152, 1099, 1042, 978, 908, 830, 745, 651, 551, 444, 332,
+	215, 95, -25, -146, -264, -380, -490, -594, -692, -782, -865, -940, -1008, -1070, -1125, -1176,
+	-1224, -1269, -1312, -1354, -1396, -1438, -1479, -1520, -1560, -1597, -1631, -1658, -1678, -1689, -1687, -1673,
+	-1643, -1596, -1531, -1447, -1344, -1223, -1084, -928, -758, -576, -385, -187, 14, 214, 411, 601,
+	781, 948, 1101, 1237, 1355, 1455, 1535, 1598, 1642, 1671, 1684, 1684, 1674, 1654, 1627, 1594,
+	1558, 1519, 1480, 1439, 1398, 1357, 1315, 1272, 1226, 1178, 1126, 1068, 1005, 935, 858, 774,
+	681, 582, 476, 365, 249, 129, 9, -112, -232, -349, -461, -568, -668, -762, -848, -926,
+	-998, -1062, -1121, -1175, -1224, -1270, -1314, -1357, -1398, -1439, -1479, -1518, -1556, -1591, -1623, -1649,
+	-1668, -1678, -1677, -1663, -1634, -1590, -1529, -1449, -1352, -1236, -1104, -955, -791, -615, -430, -238,
+	-42, 155, 349, 537, 717, 885, 1040, 1179, 1301, 1406, 1492, 1561, 1613, 1648, 1668, 1675,
+	1670, 1656, 1634, 1606, 1574, 1539, 1501, 1462, 1423, 1382, 1341, 1298, 1252, 1204, 1152, 1095,
+	1032, 962, 886, 802, 711, 613, 508, 398, 282, 164, 43, -79, -199, -317, -431, -540,
+	-643, -740, -829, -911, -985, -1053, -1115, -1171, -1223, -1270, -1315, -1358, -1400, -1440, -1479, -1517,
+	-1553, -1587, -1616, -1641, -1659, -1668, -1667, -1654, -1627, -1586, -1527, -1452, -1360, -1249, -1122, -980,
+	-822, -653, -473, -286, -95, 98, 289, 476, 655, 823, 980, 1122, 1248, 1357, 1449, 1524,
+	1581, 1623, 1650, 1663, 1665, 1657, 1640, 1617, 1588, 1556, 1521, 1484, 1446, 1406, 1365, 1323,
+	1278, 1230, 1177, 1121, 1058, 989, 914, 831, 741, 644, 540, 430, 316, 198, 77, -45,
+	-166, -285, -400, -512, -617, -716, -808, -894, -971, -1042, -1107, -1166, -1220, -1269, -1316, -1359,
+	-1401, -1441, -1479, -1516, -1551, -1583, -1611, -1634, -1651, -1660, -1659, -1647, -1621, -1582, -1527, -1455,
+	-1367, -1262, -1140, -1003, -852, -688, -514, -333, -146, 43, 231, 416, 594, 763, 920, 1065,
+	1194, 1308, 1405, 1485, 1549, 1597, 1630, 1650, 1658, 1655, 1643, 1625, 1600, 1571, 1539, 1505,
+	1468, 1430, 1389, 1347, 1303, 1255, 1203, 1146, 1084, 1016, 941, 859, 770, 674, 571, 463,
+	349, 231, 111, -11, -132, -252, -369, -482, -590, -692, -787, -875, -956, -1030, -1098, -1159,
+	-1215, -1267, -1315, -1359, -1401, -1441, -1479, -1515, -1549, -1580, -1607, -1629, -1645, -1653, -1652, -1640,
+	-1616, -1579, -1526, -1458, -1374, -1274, -1157, -1026, -880, -722, -554, -377, -195, -10, 175, 358,
+	535, 704, 862, 1009, 1141, 1259, 1360, 1446, 1515, 1569, 1609, 1635, 1648, 1651, 1645, 1631,
+	1610, 1585, 1556, 1523, 1489, 1452, 1412, 1371, 1327, 1279, 1228, 1172, 1110, 1043, 968, 887,
+	799, 704, 603, 495, 382, 265, 145, 24, -98, -219, -337, -452, -562, -666, -764, -855,
+	-939, -1016, -1087, -1151, -1209, -1263, -1313, -1358, -1401, -1441, -1479, -1514, -1547, -1577, -1603, -1624,
+	-1639, -1647, -1646, -1635, -1612, -1576, -1527, -1462, -1381, -1285, -1174, -1048, -907, -755, -592, -420,
+	-242, -61, 121, 301, 477, 646, 805, 953, 1088, 1209, 1315, 1406, 1481, 1541, 1586, 1618,
+	1637, 1645, 1644, 1635, 1619, 1597, 1571, 1541, 1508, 1472, 1434, 1394, 1350, 1303, 1252, 1197,
+	1136, 1069, 996, 915, 828, 734, 634, 527, 415, 299, 179, 58, -64, -186, -305, -421,
+	-533, -639, -740, -833, -920, -1001, -1074, -1141, -1202, -1258, -1309, -1356, -1400, -1441, -1479, -1514,
+	-1546, -1575, -1600, -1621, -1635, -1642, -1642, -1631, -1609, -1575, -1527, -1465, -1389, -1297, -1190, -1068,
+	-933, -786, -628, -461, -287, -110, 69, 247, 421, 589, 749, 899, 1036, 1160, 1270, 1365,
+	1445, 1510, 1561, 1599, 1624, 1638, 1642, 1637, 1625, 1607, 1584, 1557, 1526, 1492, 1456, 1416,
+	1373, 1327, 1276, 1221, 1161, 1095, 1022, 943, 857, 764, 665, 559, 448, 333, 214, 92,
+	-30, -152, -272, -390, -503, -612, -714, -811, -901, -984, -1060, -1130, -1194, -1252, -1305, -1354,
+	-1398, -1440, -1478, -1513, -1545, -1574, -1598, -1618, -1632, -1639, -1638, -1628, -1607, -1574, -1529, -1469,
+	-1396, -1308, -1205, -1088, -958, -816, -662, -500, -331, -157, 18, 194, 366, 534, 694, 845,
+	984, 1111, 1225, 1324, 1409, 1479, 1536, 1579, 1609, 1628, 1637, 1637, 1629, 1615, 1595, 1571,
+	1543, 1511, 1476, 1437, 1395, 1350, 1300, 1246, 1186, 1121, 1049, 971, 885, 794, 695, 591,
+	481, 366, 248, 127, 4, -118, -239, -358, -473, -583, -688, -787, -880, -965, -1045, -1117,
+	-1183, -1244, -1299, -1350, -1396, -1438, -1477, -1512, -1544, -1572, -1596, -1615, -1629, -1636, -1635, -1625,
+	-1605, -1574, -1531, -1474, -1403, -1319, -1220, -1108, -982, -844, -696, -538, -373, -203, -31, 142,
+	313, 480, 640, 792, 933, 1062, 1179, 1283, 1372, 1447, 1509, 1557, 1593, 1617, 1631, 1636,
+	1632, 1622, 1605, 1584, 1558, 1528, 1495, 1457, 1417, 1372, 1323, 1269, 1211, 1146, 1075, 998,
+	914, 823, 726, 622, 513, 399, 282, 161, 39, -84, -205, -325, -442, -554, -661, -762,
+	-857, -946, -1028, -1103, -1172, -1235, -1292, -1345, -1392, -1436, -1475, -1511, -1543, -1571, -1595, -1614,
+	-1627, -1634, -1633, -1624, -1605, -1575, -1533, -1479, -1411, -1330, -1235, -1126, -1005, -872, -728, -574,
+	-414, -247, -78, 92, 262, 427, 587, 739, 882, 1014, 1134, 1241, 1334, 1414, 1480, 1534,
+	1575, 1604, 1623, 1632, 1633, 1627, 1614, 1595, 1572, 1544, 1512, 1477, 1437, 1394, 1346, 1293,
+	1235, 1171, 1101, 1025, 942, 852, 756, 653, 545, 432, 315, 195, 73, -49, -172, -292,
+	-410, -524, -633, -737, -834, -925, -1010, -1088, -1159, -1225, -1284, -1338, -1388, -1432, -1473, -1509,
+	-1542, -1570, -1593, -1612, -1625, -1632, -1632, -1623, -1604, -1576, -1536, -1484, -1419, -1341, -1249, -1145,
+	-1027, -898, -759, -610, -453, -290, -124, 44, 211, 376, 535, 688, 832, 966, 1088, 1198,
+	1296, 1380, 1451, 1509, 1555, 1590, 1613, 1627, 1632, 1630, 1620, 1605, 1584, 1559, 1529, 1495,
+	1457, 1415, 1368, 1316, 1258, 1196, 1127, 1051, 969, 881, 786, 684, 577, 465, 349, 230,
+	108, -15, -138, -259, -378, -493, -604, -710, -810, -903, -991, -1071, -1145, -1213, -1275, -1331,
+	-1382, -1428, -1470, -1507, -1540, -1568, -1592, -1611, -1624, -1631, -1631, -1622, -1605, -1577, -1539, -1489,
+	-1427, -1351, -1263, -1162, -1049, -924, -789, -643, -491, -332, -168, -3, 162, 325, 484, 637,
+	782, 918, 1043, 1156, 1257, 1345, 1421, 1484, 1535, 1574, 1602, 1621, 1630, 1631, 1626, 1613,
+	1596, 1573, 1545, 1513, 1476, 1435, 1389, 1338, 1282, 1220, 1152, 1077, 997, 909, 815, 715,
+	609, 498, 383, 264, 142, 20, -103, -225, -345, -462, -574, -682, -784, -880, -970, -1053,
+	-1130, -1200, -1265, -1323, -1376, -1423, -1466, -1505, -1538, -1567, -1591, -1610, -1624, -1631, -1631, -1623,
+	-1606, -1580, -1543, -1495, -1435, -1362, -1277, -1180, -1070, -949, -818, -676, -527, -372, -212, -49,
+	114, 276, 434, 587, 733, 870, 997, 1114, 1218, 1310, 1390, 1457, 1513, 1557, 1590, 1612,
+	1626, 1631, 1629, 1620, 1605, 1585, 1559, 1529, 1494, 1454, 1410, 1360, 1305, 1244, 1177, 1103,
+	1024, 937, 845, 746, 641, 531, 416, 298, 177, 54, -69, -191, -312, -430, -544, -654,
+	-758, -856, -949, -1034, -1114, -1186, -1253, -1314, -1368, -1418, -1462, -1501, -1536, -1565, -1590, -1609,
+	-1623, -1631, -1631, -1624, -1608, -1582, -1547, -1501, -1443, -1373, -1291, -1197, -1091, -974, -846, -708,
+	-563, -411, -254, -94, 68, 228, 385, 538, 685, 823, 952, 1071, 1178, 1274, 1358, 1430,
+	1490, 1538, 1576, 1603, 1621, 1630, 1631, 1626, 1614, 1596, 1573, 1544, 1511, 1473, 1429, 1381,
+	1327, 1267, 1201, 1129, 1050, 965, 874, 776, 672, 563, 449, 332, 211, 89, -34, -157,
+	-279, -398, -513, -625, -731, -832, -926, -1014, -1096, -1171, -1240, -1303, -1360, -1411, -1457, -1498,
+	-1533, -1564, -1589, -1609, -1623, -1631, -1631, -1625, -1610, -1586, -1552, -1507, -1451, -1384, -1305, -1214,
+	-1111, -997, -873, -739, -597, -448, -294, -137, 22, 181, 337, 490, 637, 776, 907, 1028,
+	1139, 1238, 1325, 1401, 1465, 1518, 1560, 1592, 1614, 1627, 1632, 1630, 1621, 1606, 1585, 1559,
+	1527, 1491, 1449, 1401, 1349, 1290, 1225, 1154, 1077, 993, 902, 806, 703, 595, 482, 365,
+	245, 123, 0, -123, -245, -365, -482, -595, -703, -806, -903, -993, -1077, -1155, -1226, -1291,
+	-1350, -1403, -1451, -1493, -1530, -1561, -1587, -1608, -1622, -1631, -1632, -1626, -1612, -1589, -1556, -1513,
+	-1460, -1395, -1318, -1230, -1131, -1020, -900, -769, -631, -485, -334, -179, -22, 135, 290, 442,
+	589, 730, 862, 986, 1099, 1201, 1292, 1372, 1440, 1497, 1543, 1579, 1605, 1623, 1631, 1633,
+	1627, 1614, 1596, 1572, 1543, 1508, 1467, 1421, 1370, 1312, 1249, 1179, 1103, 1020, 931, 835,
+	734, 627, 515, 399, 280, 158, 35, -89, -211, -332, -450, -564, -674, -779, -878, -971,
+	-1058, -1138, -1211, -1279, -1340, -1395, -1444, -1488, -1526, -1558, -1585, -1607, -1622, -1631, -1633, -1628,
+	-1615, -1593, -1562, -1520, -1468, -1406, -1332, -1247, -1150, -1043, -925, -799, -663, -521, -373, -220,
+	-66, 90, 244, 396, 543, 684, 818, 943, 1059, 1164, 1258, 1342, 1414, 1475, 1525, 1565,
+	1596, 1617, 1629, 1634, 1631, 1622, 1606, 1584, 1557, 1524, 1485, 1441, 1390, 1334, 1272, 1203,
+	1128, 1047, 959, 865, 764, 659, 548, 432, 314, 192, 70, -54, -177, -299, -418, -533,
+	-645, -752, -853, -948, -1037, -1119, -1195, -1265, -1328, -1386, -1437, -1482, -1521, -1555, -1583, -1606,
+	-1622, -1632, -1635, -1630, -1618, -1597, -1567, -1527, -1477, -1417, -1345, -1263, -1169, -1065, -951, -827,
+	-695, -556, -410, -261, -108, 46, 199, 350, 497, 639, 773, 900, 1018, 1126, 1224, 1311,
+	1387, 1452, 1506, 1550, 1585, 1610, 1626, 1634, 1634, 1628, 1615, 1595, 1570, 1539, 1502, 1459,
+	1410, 1356, 1295, 1227, 1154, 1073, 987, 894, 795, 690, 580, 466, 348, 227, 104, -19,
+	-143, -265, -385, -502, -615, -723, -826, -924, -1015, -1100, -1178, -1250, -1316, -1375, -1428, -1475,
+	-1516, -1551, -1581, -1604, -1621, -1632, -1636, -1632, -1621, -1601, -1573, -1534, -1486, -1428, -1359, -1279,
+	-1188, -1087, -976, -855, -726, -590, -447, -300, -150, 2, 154, 305, 451, 594, 729, 858,
+	978, 1089, 1189, 1279, 1359, 1428, 1486, 1534, 1572, 1601, 1621, 1633, 1636, 1633, 1622, 1606,
+	1582, 1553, 1518, 1477, 1430, 1377, 1317, 1251, 1179, 1100, 1014, 922, 824, 721, 612, 499,
+	382, 261, 139, 15, -108, -231, -352, -470, -584, -694, -799, -899, -992, -1080, -1160, -1235,
+	-1302, -1364, -1419, -1468, -1510, -1547, -1578, -1602, -1620, -1632, -1637, -1634, -1624, -1606, -1578, -1542,
+	-1495, -1439, -1372, -1294, -1206, -1108, -1000, -882, -756, -623, -483, -338, -190, -40, 111, 260,
+	407, 549, 686, 816, 937, 1050, 1154, 1247, 1330, 1403, 1465, 1517, 1559, 1591, 1615, 1630,
+	1637, 1636, 1629, 1615, 1594, 1567, 1533, 1494, 1449, 1397, 1339, 1274, 1203, 1125, 1041, 951,
+	854, 752, 644, 532, 415, 295, 174, 50, -74, -197, -318, -438, -553, -665, -772, -873,
+	-969, -1058, -1141, -1218, -1288, -1351, -1409, -1459, -1504, -1542, -1574, -1600, -1619, -1632, -1638, -1637,
+	-1627, -1610, -1584, -1549, -1504, -1450, -1385, -1310, -1225, -1129, -1024, -909, -786, -655, -518, -376,
+	-230, -81, 68, 216, 363, 505, 642, 773, 897, 1012, 1118, 1215, 1301, 1377, 1443, 1498,
+	1544, 1580, 1607, 1626, 1636, 1639, 1634, 1622, 1604, 1579, 1548, 1510, 1467, 1416, 1360, 1297,
+	1227, 1151, 1068, 979, 883, 782, 676, 564, 449, 330, 208, 85, -39, -162, -285, -405,
+	-522, -635, -743, -847, -944, -1036, -1121, -1200, -1272, -1338, -1397, -1450, -1497, -1537, -1570, -1597,
+	-1618, -1632, -1639, -1639, -1631, -1615, -1590, -1557, -1514, -1461, -1398, -1325, -1242, -1150, -1047, -935,
+	-815, -687, -553, -413, -269, -122, 26, 173, 319, 461, 599, 731, 857, 974, 1082, 1181,
+	1271, 1350, 1420, 1479, 1528, 1568, 1599, 1621, 1635, 1640, 1638, 1629, 1613, 1591, 1562, 1526,
+	1484, 1435, 1380, 1319, 1250, 1176, 1094, 1006, 912, 812, 707, 597, 482, 364, 243, 120,
+	-4, -128, -251, -372, -490, -604, -714, -819, -919, -1013, -1100, -1182, -1256, -1324, -1385, -1440,
+	-1488, -1530, -1565, -1594, -1616, -1632, -1640, -1641, -1634, -1619, -1596, -1564, -1523, -1472, -1411, -1341,
+	-1260, -1170, -1070, -961, -843, -718, -586, -449, -307, -162, -16, 131, 276, 418, 557, 690,
+	816, 935, 1046, 1148, 1240, 1323, 1395, 1458, 1511, 1555, 1589, 1615, 1632, 1640, 1641, 1635,
+	1622, 1601, 1574, 1541, 1501, 1454, 1400, 1340, 1274, 1200, 1120, 1034, 941, 842, 738, 629,
+	515, 397, 277, 154, 31, -93, -216, -338, -457, -573, -685, -791, -893, -989, -1079, -1162,
+	-1239, -1309, -1373, -1429, -1480, -1523, -1560, -1590, -1614, -1631, -1640, -1643, -1637, -1624, -1602, -1571,
+	-1532, -1483, -1424, -1356, -1278, -1190, -1092, -986, -871, -748, -619, -484, -344, -201, -56, 89,
+	233, 376, 514, 648, 776, 897, 1009, 1114, 1209, 1295, 1371, 1437, 1493, 1540, 1578, 1607,
+	1627, 1639, 1643, 1640, 1629, 1611, 1586, 1555, 1516, 1471, 1420, 1361, 1296, 1224, 1146, 1061,
+	969, 872, 769, 661, 548, 431, 311, 189, 66, -59, -182, -304, -424, -541, -654, -763,
+	-866, -964, -1056, -1142, -1221, -1293, -1359, -1418, -1470, -1516, -1554, -1586, -1611, -1630, -1641, -1644,
+	-1640, -1628, -1608, -1579, -1541, -1494, -1437, -1371, -1295, -1209, -1114, -1011, -898, -778, -651, -519,
+	-381, -240, -96, 48, 192, 334, 472, 607, 736, 858, 973, 1079, 1177, 1266, 1345, 1415,
+	1475, 1525, 1566, 1598, 1622, 1637, 1644, 1643, 1635, 1620, 1597, 1568, 1532, 1488, 1438, 1382,
+	1318, 1248, 1171, 1087, 997, 901, 799, 692, 580, 464, 345, 224, 100, -24, -148, -270,
+	-391, -509, -624, -734, -839, -939, -1033, -1120, -1202, -1276, -1344, -1405, -1460, -1507, -1548, -1581,
+	-1608, -1628, -1640, -1645, -1643, -1632, -1614, -1586, -1550, -1505, -1450, -1386, -1312, -1229, -1136, -1035,
+	-925, -808, -683, -552, -417, -278, -136, 7, 150, 292, 431, 566, 695, 819, 936, 1044,
+	1145, 1236, 1319, 1391, 1455, 1509, 1553, 1589, 1616, 1634, 1644, 1646, 1641, 1628, 1607, 1580,
+	1546, 1505, 1457, 1402, 1340, 1271, 1195, 1113, 1025, 930, 829, 723, 613, 498, 379, 258,
+	135, 11, -113, -236, -358, -477, -592, -704, -811, -912, -1008, -1098, -1182, -1258, -1329, -1392,
+	-1448, -1498, -1540, -1576, -1604, -1626, -1640, -1646, -1645, -1636, -1619, -1593, -1559, -1515, -1462, -1400,
+	-1329, -1248, -1158, -1059, -951, -836, -714, -586, -452, -315, -175, -33, 109, 251, 389, 525,
+	655, 780, 899, 1009, 1112, 1206, 1291, 1367, 1434, 1491, 1539, 1578, 1608, 1629, 1643, 1648,
+	1645, 1634, 1617, 1592, 1559, 1520, 1474, 1421, 1361, 1293, 1220, 1139, 1052, 958, 859, 754,
+	645, 531, 413, 293, 170, 46, -78, -202, -324, -444, -561, -674, -782, -886, -983, -1075,
+	-1161, -1240, -1312, -1378, -1436, -1488, -1532, -1570, -1600, -1623, -1639, -1647, -1648, -1640, -1625, -1600,
+	-1568, -1526, -1475, -1415, -1345, -1267, -1179, -1082, -977, -865, -745, -619, -487, -352, -213, -72,
+	69, 210, 348, 484, 615, 741, 861, 974, 1079, 1176, 1264, 1343, 1412, 1473, 1524, 1566,
+	1599, 1624, 1640, 1648, 1648, 1640, 1625, 1602, 1572, 1535, 1491, 1439, 1381, 1316, 1243, 1164,
+	1079, 987, 889, 785, 677, 564, 447, 327, 205, 81, -43, -167, -290, -411, -529, -643,
+	-753, -858, -958, -1052, -1139, -1221, -1295, -1363, -1423, -1477, -1524, -1563, -1595, -1620, -1638, -1647,
+	-1650, -1644, -1630, -1607, -1576, -1536, -1487, -1429, -1362, -1285, -1200, -1105, -1003, -892, -775, -651,
+	-521, -388, -250, -111, 29, 169, 308, 444, 576, 703, 824, 938, 1046, 1145, 1235, 1317,
+	1390, 1453, 1508, 1553, 1590, 1617, 1637, 1647, 1650, 1645, 1632, 1612, 1584, 1549, 1507, 1457,
+	1401, 1337, 1266, 1189, 1105, 1014, 918, 816, 708, 596, 480, 361, 239, 116, -8, -133,
+	-256, -377, -496, -612, -723, -830, -931, -1027, -1117, -1200, -1277, -1347, -1410, -1465, -1514, -1556,
+	-1590, -1616, -1636, -1647, -1651, -1647, -1635, -1614, -1585, -1546, -1499, -1443, -1378, -1303, -1220, -1128,
+	-1028, -920, -804, -682, -555, -423, -287, -149, -10, 129, 268, 403, 536, 664, 786, 903,
+	1012, 1113, 1206, 1291, 1367, 1433, 1491, 1539, 1579, 1610, 1632, 1646, 1652, 1649, 1639, 1621,
+	1595, 1563, 1522, 1475, 1420, 1358, 1289, 1213, 1131, 1042, 947, 846, 739, 628, 513, 395,
+	274, 151, 26, -98, -221, -344, -463, -580, -693, -801, -904, -1002, -1094, -1179, -1258, -1330,
+	-1395, -1453, -1504, -1547, -1583, -1612, -1633, -1647, -1652, -1650, -1639, -1620, -1593, -1556, -1511, -1457,
+	-1394, -1321, -1240, -1151, -1052, -947, -833, -714, -588, -458, -324, -187, -49, 90, 228, 364,
+	496, 625, 749, 867, 978, 1081, 1177, 1264, 1343, 1412, 1473, 1525, 1567, 1601, 1627, 1643,
+	1652, 1652, 1644, 1629, 1606, 1575, 1537, 1491, 1439, 1378, 1311, 1237, 1156, 1069, 975, 875,
+	770, 661, 546, 429, 308, 185, 61, -63, -187, -310, -430, -548, -662, -772, -877, -976,
+	-1070, -1158, -1239, -1313, -1380, -1440, -1493, -1538, -1577, -1607, -1630, -1645, -1653, -1652, -1643, -1626,
+	-1600, -1566, -1523, -1470, -1409, -1339, -1260, -1173, -1077, -973, -862, -744, -621, -492, -360, -225,
+	-87, 50, 188, 324, 457, 587, 711, 831, 943, 1049, 1147, 1237, 1318, 1390, 1454, 1509,
+	1555, 1592, 1620, 1640, 1651, 1654, 1649, 1636, 1615, 1587, 1551, 1507, 1456, 1398, 1333, 1260,
+	1181, 1095, 1003, 905, 801, 692, 579, 462, 342, 220, 96, -28, -152, -275, -397, -515,
+	-631, -742, -849, -950, -1046, -1135, -1218, -1294, -1364, -1426, -1481, -1529, -1569, -1602, -1627, -1644,
+	-1653, -1654, -1647, -1632, -1608, -1575, -1534, -1484, -1425, -1357, -1280, -1194, -1101, -999, -890, -775,
+	-653, -526, -396, -262, -125, 12, 149, 285, 418, 548, 674, 794, 909, 1016, 1116, 1209,
+	1292, 1368, 1434, 1492, 1541, 1581, 1612, 1635, 1649, 1655, 1653, 1642, 1624, 1598, 1564, 1523,
+	1474, 1417, 1354, 1283, 1206, 1121, 1031, 934, 831, 724, 612, 496, 376, 255, 131, 7,
+	-118, -241, -363, -483, -599, -712, -820, -923, -1020, -1112, -1197, -1275, -1347, -1412, -1469, -1519,
+	-1561, -1596, -1622, -1642, -1653, -1656, -1651, -1637, -1615, -1584, -1545, -1497, -1440, -1374, -1299, -1216,
+	-1124, -1025, -918, -804, -685, -560, -431, -298, -163, -27, 110, 245, 379, 510, 636, 758,
+	874, 983, 1085, 1180, 1266, 1345, 1414, 1475, 1527, 1570, 1604, 1630, 1647, 1655, 1656, 1648,
+	1632, 1608, 1577, 1537, 1490, 1436, 1374, 1305, 1230, 1147, 1058, 962, 861, 755, 644, 529,
+	410, 289, 166, 42, -83, -207, -329, -450, -567, -681, -791, -895, -994, -1088, -1175, -1256,
+	-1329, -1396, -1455, -1507, -1552, -1589, -1618, -1639, -1652, -1657, -1654, -1642, -1622, -1593, -1556, -1509,
+	-1454, -1390, -1318, -1237, -1147, -1050, -945, -834, -716, -593, -465, -334, -200, -65, 71, 207,
+	340, 471, 599, 721, 839, 950, 1054, 1151, 1240, 1321, 1393, 1456, 1511, 1557, 1595, 1623,
+	1643, 1654, 1657, 1652, 1639, 1618, 1588, 1551, 1506, 1454, 1394, 1327, 1253, 1172, 1084, 991,
+	891, 786, 676, 562, 444, 323, 201, 77, -48, -172, -295, -416, -535, -650, -761, -867,
+	-968, -1063, -1152, -1235, -1311, -1380, -1441, -1496, -1542, -1581, -1612, -1635, -1651, -1658, -1656, -1647,
+	-1628, -1602, -1566, -1522, -1469, -1407, -1336, -1257, -1170, -1075, -972, -862, -747, -625, -499, -370,
+	-237, -102, 33, 168, 302, 433, 561, 685, 803, 916, 1022, 1121, 1213, 1296, 1371, 1437,
+	1495, 1544, 1584, 1616, 1638, 1653, 1658, 1656, 1645, 1626, 1599, 1564, 1522, 1471, 1414, 1348,
+	1276, 1197, 1111, 1018, 920, 816, 708, 595, 478, 358, 235, 112, -13, -137, -261, -383,
+	-502, -618, -730, -838, -941, -1038, -1129, -1214, -1292, -1363, -1427, -1483, -1532, -1573, -1606, -1631,
+	-1649, -1658, -1658, -1651, -1635, -1610, -1576, -1534, -1483, -1423, -1354, -1277, -1192, -1099, -999, -891,
+	-777, -657, -533, -405, -273, -140, -5, 130, 263, 395, 523, 648, 768, 882, 990, 1091,
+	1185, 1271, 1348, 1417, 1478, 1530, 1573, 1607, 1633, 1650, 1658, 1659, 1650, 1634, 1609, 1577,
+	1536, 1488, 1432, 1369, 1299, 1221, 1137, 1046, 949, 847, 739, 627, 511, 392, 270, 147,
+	22, -102, -226, -349, -469, -586, -700, -809, -913, -1012, -1105, -1192, -1272, -1345, -1411, -1470,
+	-1521, -1564, -1599, -1627, -1646, -1657, -1660, -1654, -1640, -1617, -1586, -1545, -1496, -1439, -1372, -1297,
+	-1214, -1123, -1025, -919, -807, -689, -566, -439, -309, -177, -43, 91, 225, 357, 486, 611,
+	732, 848, 958, 1061, 1156, 1245, 1325, 1397, 1460, 1515, 1561, 1598, 1627, 1646, 1658, 1660,
+	1655, 1641, 1619, 1588, 1550, 1504, 1450, 1389, 1320, 1245, 1162, 1073, 978, 876, 770, 659,
+	544, 426, 305, 181, 57, -67, -192, -315, -436, -554, -668, -779, -885, -986, -1081, -1169,
+	-1251, -1327, -1395, -1456, -1509, -1554, -1592, -1621, -1643, -1656, -1661, -1657, -1645, -1624, -1595, -1557,
+	-1510, -1454, -1390, -1317, -1236, -1147, -1050, -947, -836, -720, -599, -474, -345, -213, -80, 54,
+	187, 319, 448, 574, 696, 813, 925, 1030, 1128, 1218, 1301, 1375, 1441, 1499, 1548, 1588,
+	1619, 1642, 1656, 1661, 1658, 1647, 1627, 1599, 1563, 1520, 1468, 1409, 1342, 1268, 1187, 1099,
+	1006, 906, 801, 691, 577, 459, 339, 216, 92, -32, -157, -280, -402, -521, -637, -749,
+	-856, -958, -1055, -1146, -1230, -1307, -1377, -1440, -1496, -1543, -1583, -1615, -1639, -1654, -1661, -1660,
+	-1650, -1631, -1604, -1568, -1523, -1470, -1408, -1337, -1258, -1171, -1077, -975, -867, -753, -633, -509,
+	-381, -250, -117, 16, 149, 282, 412, 539, 662, 781, 894, 1000, 1100, 1193, 1278, 1355,
+	1423, 1483, 1535, 1577, 1611, 1636, 1653, 1661, 1660, 1651, 1634, 1608, 1574, 1533, 1483, 1426,
+	1361, 1289, 1210, 1125, 1032, 934, 831, 722, 609, 493, 373, 251, 127, 3, -122, -246,
+	-368, -488, -605, -718, -827, -930, -1029, -1121, -1207, -1286, -1358, -1423, -1481, -1531, -1573, -1607,
+	-1633, -1651, -1660, -1661, -1653, -1637, -1612, -1579, -1537, -1486, -1426, -1358, -1281, -1197, -1104, -1005,
+	-898, -785, -667, -544, -417, -287, -155, -21, 112, 245, 375, 504, 628, 748, 862, 971,
+	1073, 1168, 1255, 1334, 1405, 1467, 1521, 1566, 1603, 1630, 1649, 1659, 1661, 1654, 1639, 1616,
+	1585, 1545, 1498, 1443, 1380, 1310, 1233, 1149, 1059, 963, 860, 753, 642, 526, 407, 285,
+	162, 38, -87, -211, -334, -454, -572, -686, -796, -902, -1002, -1096, -1183, -1265, -1339, -1406,
+	-1466, -1518, -1562, -1598, -1626, -1646, -1658, -1661, -1656, -1643, -1620, -1589, -1549, -1501, -1444, -1378,
+	-1304, -1221, -1131, -1033, -929, -818, -701, -579, -453, -324, -192, -59, 75, 208, 339, 468,
+	593, 715, 831, 941, 1045, 1142, 1231, 1313, 1386, 1451, 1507, 1554, 1593, 1623, 1645, 1657,
+	1662, 1657, 1644, 1623, 1594, 1557, 1512, 1459, 1399, 1331, 1256, 1174, 1085, 990, 890, 784,
+	673, 559, 441, 320, 197, 73, -52, -176, -300, -421, -540, -655, -766, -873, -974, -1070,
+	-1159, -1243, -1319, -1388, -1450, -1504, -1550, -1589, -1619, -1642, -1656, -1661, -1659, -1647, -1627, -1599,
+	-1561, -1515, -1461, -1397, -1325, -1245, -1157, -1061, -959, -849, -734, -614, -489, -360, -229, -96,
+	37, 170, 302, 432, 559, 681, 799, 911, 1017, 1115, 1207, 1291, 1366, 1433, 1492, 1542,
+	1583, 1616, 1640, 1655, 1661, 1659, 1649, 1630, 1603, 1568, 1525, 1475, 1416, 1350, 1277, 1197,
+	1110, 1017, 918, 814, 705, 591, 474, 354, 231, 107, -17, -142, -265, -387, -507, -623,
+	-735, -843, -946, -1044, -1135, -1220, -1298, -1369, -1433, -1489, -1538, -1579, -1611, -1636, -1653, -1661,
+	-1660, -1651, -1634, -1608, -1573, -1529, -1477, -1416, -1346, -1268, -1183, -1089, -988, -881, -767, -648,
+	-524, -397, -266, -134, 0, 133, 265, 396, 523, 647, 766, 880, 988, 1088, 1182, 1268,
+	1346, 1415, 1476, 1529, 1573, 1608, 1634, 1651, 1660, 1661, 1653, 1636, 1612, 1579, 1538, 1490,
+	1433, 1370, 1299, 1220, 1135, 1044, 947, 844, 736, 623, 507, 388, 266, 142, 18, -107,
+	-231, -353, -473, -591, -704, -813, -918, -1017, -1110, -1197, -1277, -1350, -1416, -1474, -1525, -1568,
+	-1603, -1630, -1649, -1659, -1661, -1655, -1640, -1616, -1583, -1542, -1492, -1434, -1367, -1291, -1207, -1116,
+	-1017, -911, -799, -682, -559, -433, -303, -171, -38, 96, 228, 360, 488, 613, 733, 849,
+	958, 1061, 1156, 1245, 1325, 1397, 1460, 1515, 1561, 1599, 1627, 1647, 1659, 1661, 1656, 1642,
+	1619, 1589, 1550, 1504, 1450, 1388, 1319, 1243, 1160, 1070, 975, 873, 767, 655, 540, 422,
+	300, 177, 53, -72, -196, -319, -440, -558, -673, -783, -889, -990, -1084, -1173, -1255, -1330,
+	-1398, -1459, -1512, -1557, -1594, -1623, -1644, -1657, -1662, -1657, -1645, -1623, -1593, -1555, -1507, -1451,
+	-1386, -1313, -1232, -1142, -1046, -942, -831, -715, -594, -469, -340, -208, -75, 58, 191, 323,
+	452, 578, 700, 817, 928, 1033, 1130, 1221, 1303, 1377, 1443, 1500, 1549, 1589, 1620, 1643,
+	1656, 1661, 1658, 1646, 1626, 1598, 1562, 1518, 1466, 1406, 1339, 1265, 1184, 1096, 1002, 902,
+	797, 687, 573, 455, 335, 212, 88, -37, -161, -285, -406, -525, -641, -753, -860, -962,
+	-1058, -1149, -1233, -1310, -1380, -1442, -1498, -1545, -1584, -1616, -1639, -1654, -1661, -1659, -1649, -1630,
+	-1603, -1566, -1521, -1468, -1405, -1335, -1255, -1168, -1074, -972, -863, -749, -629, -504, -376, -245,
+	-113, 21, 154, 286, 416, 543, 666, 785, 897, 1004, 1104, 1196, 1281, 1357, 1426, 1485,
+	1536, 1579, 1612, 1637, 1653, 1661, 1660, 1651, 1633, 1607, 1573, 1531, 1481, 1424, 1359, 1287,
+	1207, 1121, 1029, 931, 827, 718, 605, 489, 369, 247, 123, -2, -126, -250, -372, -492,
+	-609, -722, -830, -934, -1032, -1124, -1210, -1289, -1361, -1426, -1483, -1532, -1574, -1608, -1634, -1651,
+	-1660, -1661, -1653, -1637, -1611, -1578, -1535, -1484, -1424, -1355, -1278, -1194, -1101, -1001, -894, -781,
+	-663, -540, -413, -282, -150, -17, 117, 249, 380, 508, 632, 752, 866, 975, 1076, 1171,
+	1258, 1337, 1407, 1469, 1523, 1568, 1604, 1631, 1650, 1660, 1661, 1654, 1639, 1615, 1583, 1544,
+	1496, 1441, 1378, 1308, 1230, 1146, 1056, 959, 857, 749, 638, 522, 403, 281, 158, 33,
+	-91, -215, -338, -459, -576, -690, -800, -905, -1005, -1099, -1186, -1267, -1341, -1408, -1468, -1519,
+	-1563, -1599, -1627, -1647, -1658, -1661, -1656, -1642, -1619, -1588, -1548, -1499, -1441, -1375, -1301, -1218,
+	-1128, -1030, -925, -814, -697, -575, -449, -319, -187, -54, 79, 212, 343, 472, 598, 719,
+	835, 945, 1049, 1145, 1234, 1315, 1388, 1453, 1509, 1556, 1594, 1624, 1645, 1658, 1662, 1657,
+	1644, 1623, 1593, 1556, 1510, 1457, 1396, 1328, 1253, 1171, 1082, 987, 886, 780, 669, 555,
+	436, 315, 192, 68, -56, -181, -304, -425, -544, -659, -770, -876, -978, -1073, -1162, -1245,
+	-1321, -1390, -1452, -1506, -1552, -1590, -1620, -1642, -1656, -1661, -1658, -1647, -1627, -1598, -1560, -1514,
+	-1458, -1395, -1323, -1242, -1154, -1058, -955, -845, -730, -609, -484, -356, -225, -92, 42, 175,
+	307, 436, 563, 685, 803, 915, 1020, 1119, 1210, 1293, 1369, 1436, 1494, 1544, 1585, 1617,
+	1640, 1655, 1661, 1659, 1648, 1629, 1602, 1567, 1524, 1473, 1414, 1348, 1275, 1194, 1107, 1014,
+	915, 810, 701, 587, 470, 350, 227, 103, -21, -146, -269, -391, -511, -627, -739, -847,
+	-950, -1047, -1138, -1223, -1301, -1372, -1435, -1491, -1540, -1580, -1612, -1637, -1653, -1661, -1660, -1651,
+	-1633, -1607, -1571, -1527, -1475, -1413, -1344, -1266, -1179, -1086, -985, -877, -763, -644, -520, -392,
+	-262, -129, 4, 138, 270, 400, 528, 651, 770, 884, 991, 1092, 1185, 1271, 1348, 1418,
+	1478, 1531, 1574, 1609, 1635, 1652, 1660, 1661, 1652, 1636, 1611, 1578, 1537, 1488, 1431, 1367,
+	1296, 1218, 1132, 1041, 943, 840, 732, 620, 503, 384, 262, 138, 14, -111, -235, -357,
+	-477, -595, -708, -817, -921, -1020, -1113, -1200, -1279, -1352, -1418, -1476, -1527, -1569, -1604, -1631,
+	-1649, -1659, -1661, -1654, -1639, -1615, -1582, -1541, -1490, -1432, -1364, -1288, -1204, -1113, -1014, -908,
+	-795, -678, -555, -428, -299, -167, -33, 100, 233, 364, 492, 617, 737, 853, 962, 1064,
+	1160, 1248, 1327, 1399, 1462, 1517, 1563, 1600, 1628, 1648, 1659, 1661, 1655, 1641, 1618, 1588,
+	1549, 1502, 1448, 1386, 1317, 1240, 1157, 1067, 971, 870, 763, 652, 536, 417, 296, 173,
+	49, -76, -200, -323, -444, -562, -677, -787, -893, -993, -1088, -1176, -1258, -1333, -1400, -1461,
+	-1513, -1558, -1595, -1624, -1645, -1657, -1662, -1657, -1644, -1623, -1592, -1553, -1505, -1449, -1384, -1310,
+	-1229, -1139, -1042, -938, -828, -711, -590, -464, -335, -204, -71, 63, 196, 327, 457, 583,
+	704, 821, 932, 1036, 1134, 1224, 1306, 1380, 1445, 1502, 1551, 1590, 1621, 1643, 1657, 1661,
+	1658, 1646, 1626, 1597, 1561, 1516, 1464, 1404, 1337, 1262, 1181, 1093, 999, 899, 793, 683,
+	569, 451, 330, 208, 84, -41, -165, -289, -410, -529, -645, -756, -863, -965, -1062, -1152,
+	-1235, -1312, -1382, -1444, -1499, -1546, -1586, -1617, -1640, -1655, -1661, -1659, -1649, -1630, -1602, -1565,
+	-1520, -1466, -1403, -1332, -1252, -1165, -1070, -968, -859, -744, -624, -500, -372, -241, -108, 25,
+	159, 291, 421, 548, 670, 789, 901, 1007, 1107, 1199, 1284, 1360, 1428, 1487, 1538, 1580,
+	1613, 1638, 1654, 1661, 1660, 1650, 1632, 1606, 1572, 1529, 1479, 1422, 1357, 1284, 1205, 1118,
+	1026, 927, 823, 715, 601, 484, 365, 242, 118, -6, -131, -254, -376, -496, -613, -726,
+	-834, -937, -1035, -1127, -1213, -1291, -1363, -1428, -1485, -1534, -1575, -1609, -1634, -1651, -1660, -1661,
+	-1653, -1636, -1610, -1576, -1533, -1482, -1421, -1353, -1276, -1190, -1098, -997, -890, -777, -659, -535,
+	-408, -278, -146, -12, 121, 254, 384, 512, 636, 756, 870, 978, 1080, 1174, 1261, 1339,
+	1410, 1471, 1525, 1569, 1605, 1632, 1650, 1660, 1661, 1654, 1638, 1614, 1582, 1542, 1494, 1439,
+	1376, 1305, 1228, 1143, 1052, 956, 853, 746, 634, 518, 398, 277, 153, 29, -96, -220,
+	-342, -463, -580, -694, -804, -909, -1008, -1102, -1189, -1270, -1344, -1410, -1469, -1521, -1565, -1600,
+	-1628, -1647, -1659, -1661, -1656, -1641, -1618, -1587, -1546, -1497, -1439, -1373, -1298, -1215, -1124, -1026,
+	-921, -810, -692, -570, -444, -315, -183, -50, 84, 217, 348, 477, 602, 723, 839, 949,
+	1052, 1148, 1237, 1318, 1391, 1455, 1511, 1557, 1596, 1625, 1646, 1658, 1661, 1657, 1643, 1622,
+	1592, 1554, 1508, 1455, 1394, 1326, 1250, 1168, 1079, 983, 882, 776, 665, 551, 432, 311,
+	188, 64, -61, -185, -308, -429, -548, -663, -774, -880, -981, -1076, -1165, -1248, -1324, -1392,
+	-1454, -1507, -1553, -1591, -1621, -1643, -1656, -1661, -1658, -1646, -1626, -1596, -1559, -1512, -1456, -1392,
+	-1320, -1239, -1151, -1054, -951, -841, -726, -605, -480, -351, -220, -87, 46, 180, 311, 441,
+	567, 689, 807, 918, 1024, 1122, 1213, 1296, 1371, 1438, 1496, 1545, 1586, 1618, 1641, 1655,
+	1661, 1659, 1648, 1629, 1601, 1566, 1522, 1471, 1412, 1346, 1272, 1191, 1104, 1011, 911, 807,
+	697, 583, 466, 345, 223, 99, -26, -150, -274, -395, -515, -631, -743, -851, -953, -1050,
+	-1141, -1226, -1303, -1374, -1437, -1493, -1541, -1581, -1613, -1638, -1653, -1661, -1660, -1650, -1632, -1606,
+	-1570, -1526, -1473, -1411, -1341, -1263, -1176, -1082, -981, -873, -759, -639, -515, -388, -257, -125,
+	9, 142, 275, 405, 532, 656, 774, 888, 995, 1095, 1188, 1274, 1351, 1420, 1480, 1532,
+	1575, 1610, 1635, 1652, 1661, 1660, 1652, 1635, 1610, 1576, 1535, 1486, 1429, 1365, 1293, 1215,
+	1129, 1038, 940, 837, 728, 616, 499, 379, 257, 134, 9, -115, -239, -361, -482, -599,
+	-712, -821, -925, -1023, -1116, -1203, -1282, -1355, -1420, -1478, -1528, -1571, -1605, -1632, -1650, -1660,
+	-1661, -1654, -1638, -1614, -1581, -1539, -1489, -1429, -1362, -1286, -1201, -1109, -1010, -904, -791, -673,
+	-551, -424, -294, -162, -29, 105, 238, 369, 497, 621, 742, 856, 965, 1068, 1163, 1250,
+	1330, 1401, 1464, 1519, 1564, 1601, 1629, 1648, 1659, 1661, 1655, 1640, 1618, 1587, 1547, 1501,
+};
+
+const struct pcm_sample pcm_samples[] = {
+	{ pcm_kick, 8, 36, 36, 36, 22050, 5512, 0, 0 },
+	{ pcm_snare, 8, 38, 38, 38, 22050, 3969, 0, 0 },
+	{ pcm_hat, 8, 42, 42, 42, 22050, 1764, 0, 0 },
+	{ pcm_keys, 12, 60, 48, 108, 22050, 6096, 4410, 6096 },
+};
+
+const int pcm_sample_count = sizeof(pcm_samples) / sizeof(pcm_samples[0]);
@@ -0,0 +1,55 @@
+/*************************************************************************************************
+                                         --SAMPLES--
+
+	PCM sample bank for the SAMPLE voice type, const so it stays in flash. Every sample is
+	8-bit (int8_t, scaled up to the DAC range on playback) or 12-bit (int16_t, -2048..2047)
+	and covers a key range; a note plays the first sample whose range holds it, pitched
+	from the sample's root key. Samples with loop_end above loop_start loop between the two
+	once played up to loop_end, the others stop at their end. Regenerate samples.c with
+	tools/gen_samples.py.
+
+*************************************************************************************************/
+
+#ifndef SAMPLES_H_INCLUDED
+#define SAMPLES_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//playback position and step are Q12 sample frames, so samples hold up to 2^20 frames
+#define PCM_FRAC_BITS			(	12	)
+#define PCM_MAX_FRAMES			(	1ul << (32 - PCM_FRAC_BITS)	)
+
+/********   TYPE DEFS  **********/
+struct pcm_sample{
+	const void *data;
+	uint8_t bits;
+	uint8_t root_note;
+	uint8_t key_lo;
+	uint8_t key_hi;
+	uint32_t rate;
+	uint32_t length;
+	uint32_t loop_start;
+	uint32_t loop_end;
+};
+
+/*******   GLOBAL VARS  *********/
+extern const struct pcm_sample pcm_samples[];
+extern const int pcm_sample_count;
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline const struct pcm_sample *pcm_sample_for_note( uint8_t note )
+{
+	//the bank is a handful of entries, a scan at note-on is cheaper than a key table
+	int i;
+
+	for(i=0; i<pcm_sample_count; i++)
+	{
+		if((note >= pcm_samples[i].key_lo) && (note <= pcm_samples[i].key_hi)) return &pcm_samples[i];
+	}
+
+	return 0;
+}
+
+#endif /* SAMPLES_H_INCLUDED */
@@ -0,0 +1,115 @@
+/*************************************************************************************************
+                                       --WAVESHAPER--
+
+	The driven signal is clamped to the table range first, so a hot mix flattens onto the
+	curve end points rather than reading past the table; the top entry is only ever the
+	far end of the last interpolation step. Bit reduction masks the low bits
+	of the two's complement sample, which floors it, the same as a converter with fewer bits
+	would. The hold count runs across blocks so the reduced rate does not restart every
+	control period.
+
+	Everything off (no curve, 12 bits, hold 1) returns straight away and leaves the mix
+	untouched. Every curve passes zero through as zero, so with a zero sample held the stage
+	is idle and a skipped silent block only has to move the hold count on.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "shaper.h"
+#include "recip.h"
+#include "conf_synth.h"
+
+
+/**********  DEFINE  ************/
+#define SHAPER_INPUT_MAX		(	2047	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int32_t shaper_clamp( int32_t x );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void shaper_init( struct shaper *shaper )
+{
+	shaper->held = 0;
+	shaper->count = 0;
+	shaper_set(shaper, SHAPER_OFF, 1l << SHAPER_DRIVE_SHIFT, SHAPER_BITS, 1);
+}
+
+void shaper_set( struct shaper *shaper, enum shaper_curve curve, int32_t drive, uint8_t bits, uint8_t hold )
+{
+	if(drive < 0) drive = 0;
+	if(drive > SHAPER_DRIVE_MAX) drive = SHAPER_DRIVE_MAX;
+	if(bits < 1) bits = 1;
+	if(bits > SHAPER_BITS) bits = SHAPER_BITS;
+	if(hold < 1) hold = 1;
+	if(hold > SHAPER_HOLD_MAX) hold = SHAPER_HOLD_MAX;
+
+	shaper->curve = (curve > SHAPER_OFF && curve < SHAPER_CURVE_COUNT) ? shaper_curves[curve - 1] : 0;
+	shaper->drive = drive;
+	shaper->mask = ~((1l << (SHAPER_BITS - bits)) - 1);
+	shaper->hold = hold;
+	if(shaper->count >= hold) shaper->count = 0;
+}
+
+bool shaper_idle( const struct shaper *shaper )
+{
+	return (shaper->held == 0) || ((shaper->curve == 0) && (shaper->mask == -1) && (shaper->hold == 1));
+}
+
+void shaper_skip( struct shaper *shaper, int count )
+{
+	int32_t n = shaper->count + count;
+
+	shaper->count = (uint8_t) (n - recip_div(n, shaper->hold) * shaper->hold);
+}
+
+SYNTH_RAM_CODE static int32_t shaper_clamp( int32_t x )
+{
+	//branch-free clamp to -2048..2047, the last interpolation step ends on the extra entry
+	int32_t over = x - SHAPER_INPUT_MAX;
+	int32_t under;
+
+	x -= over & ~(over >> 31);
+	under = x + SHAPER_INPUT_MAX + 1;
+	x -= under & (under >> 31);
+
+	return x;
+}
+
+SYNTH_RAM_CODE void shaper_process( struct shaper *shaper, int32_t *buffer, int count )
+{
+	//processes the buffer in place
+	const int16_t *curve = shaper->curve;
+	int32_t drive = shaper->drive;
+	int32_t mask = shaper->mask;
+	int32_t held = shaper->held;
+	uint8_t hold = shaper->hold;
+	uint8_t n = shaper->count;
+	int32_t x;
+	int32_t index;
+	int32_t a;
+	int i;
+
+	if(curve == 0 && mask == -1 && hold == 1) return;
+
+	for(i=0; i<count; i++)
+	{
+		x = buffer[i];
+
+		if(curve)
+		{
+			x = shaper_clamp((x * drive) >> SHAPER_DRIVE_SHIFT) + SHAPER_INPUT_MAX + 1;
+			index = x >> SHAPER_TABLE_SHIFT;
+			a = curve[index];
+			x = a + (((curve[index + 1] - a) * (x & ((1l << SHAPER_TABLE_SHIFT) - 1))) >> SHAPER_TABLE_SHIFT);
+		}
+
+		if(n == 0) held = x & mask;
+		if(++n >= hold) n = 0;
+		buffer[i] = held;
+	}
+
+	shaper->held = held;
+	shaper->count = n;
+}
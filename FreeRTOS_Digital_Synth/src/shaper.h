@@ -0,0 +1,57 @@
+/*************************************************************************************************
+                                       --WAVESHAPER--
+
+	Distortion stage on the master mix: a pre-gain drives the signed 12-bit signal into a
+	transfer curve, then a bit crusher drops low bits and holds every sample for a number of
+	periods. The curves are const tables in flash of SHAPER_TABLE_SIZE steps over the 12-bit
+	range, linearly interpolated, so shaping costs two loads and a multiply per sample
+	instead of polynomial math. Regenerate shaper_curves.c with tools/gen_shaper_curves.py.
+
+*************************************************************************************************/
+
+#ifndef SHAPER_H_INCLUDED
+#define SHAPER_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define SHAPER_TABLE_SIZE		(	256	)
+#define SHAPER_TABLE_SHIFT		(	4	) //12-bit input to table steps
+
+//drive is Q8, 256 = unity into the curve
+#define SHAPER_DRIVE_SHIFT		(	8	)
+#define SHAPER_DRIVE_MAX		(	4096	)
+
+#define SHAPER_BITS				(	12	)
+#define SHAPER_HOLD_MAX			(	64	)
+
+/********   TYPE DEFS  **********/
+enum shaper_curve{
+	SHAPER_OFF,
+	SHAPER_SOFT,
+	SHAPER_ASYM,
+	SHAPER_FOLD,
+	SHAPER_CURVE_COUNT
+};
+
+struct shaper{
+	const int16_t *curve;
+	int32_t drive;
+	int32_t mask;
+	int32_t held;
+	uint8_t hold;
+	uint8_t count;
+};
+
+/*******   GLOBAL VARS  *********/
+extern const int16_t shaper_curves[SHAPER_CURVE_COUNT - 1][SHAPER_TABLE_SIZE + 1];
+
+/****** FUNCTION PROTOTYPES  ****/
+void shaper_init( struct shaper *shaper );
+void shaper_set( struct shaper *shaper, enum shaper_curve curve, int32_t drive, uint8_t bits, uint8_t hold );
+void shaper_process( struct shaper *shaper, int32_t *buffer, int count );
+bool shaper_idle( const struct shaper *shaper );
+void shaper_skip( struct shaper *shaper, int count );
+
+#endif /* SHAPER_H_INCLUDED */
@@ -0,0 +1,74 @@
+/*************************************************************************************************
+                                    --SHAPER CURVES--
+
+	Generated by tools/gen_shaper_curves.py, do not edit by hand.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "shaper.h"
+
+
+/*******   GLOBAL VARS  *********/
+const int16_t shaper_curves[SHAPER_CURVE_COUNT - 1][SHAPER_TABLE_SIZE + 1] = {
+	//SOFT
+	{
+		-2047, -2046, -2045, -2044, -2042, -2041, -2040, -2038, -2037, -2035, -2034, -2032, -2031, -2029, -2027, -2025,
+		-2023, -2021, -2019, -2017, -2015, -2012, -2010, -2007, -2005, -2002, -1999, -1996, -1993, -1990, -1986, -1983,
+		-1979, -1976, -1972, -1968, -1964, -1959, -1955, -1950, -1946, -1941, -1935, -1930, -1924, -1919, -1913, -1907,
+		-1900, -1893, -1887, -1879, -1872, -1864, -1856, -1848, -1840, -1831, -1822, -1812, -1803, -1792, -1782, -1771,
+		-1760, -1748, -1737, -1724, -1711, -1698, -1685, -1671, -1656, -1641, -1626, -1610, -1594, -1577, -1559, -1541,
+		-1523, -1504, -1485, -1465, -1444, -1423, -1401, -1379, -1356, -1332, -1308, -1283, -1258, -1232, -1206, -1178,
+		-1151, -1122, -1093, -1064, -1034, -1003, -971, -940, -907, -874, -840, -806, -772, -736, -701, -665,
+		-628, -591, -554, -516, -478, -439, -400, -361, -322, -282, -242, -202, -162, -121, -81, -41,
+		0, 41, 81, 121, 162, 202, 242, 282, 322, 361, 400, 439, 478, 516, 554, 591,
+		628, 665, 701, 736, 772, 806, 840, 874, 907, 940, 971, 1003, 1034, 1064, 1093, 1122,
+		1151, 1178, 1206, 1232, 1258, 1283, 1308, 1332, 1356, 1379, 1401, 1423, 1444, 1465, 1485, 1504,
+		1523, 1541, 1559, 1577, 1594, 1610, 1626, 1641, 1656, 1671, 1685, 1698, 1711, 1724, 1737, 1748,
+		1760, 1771, 1782, 1792, 1803, 1812, 1822, 1831, 1840, 1848, 1856, 1864, 1872, 1879, 1887, 1893,
+		1900, 1907, 1913, 1919, 1924, 1930, 1935, 1941, 1946, 1950, 1955, 1959, 1964, 1968, 1972, 1976,
+		1979, 1983, 1986, 1990, 1993, 1996, 1999, 2002, 2005, 2007, 2010, 2012, 2015, 2017, 2019, 2021,
+		2023, 2025, 2027, 2029, 2031, 2032, 2034, 2035, 2037, 2038, 2040, 2041, 2042, 2044, 2045, 2046,
+		2047,
+	},
+	//ASYM
+	{
+		-2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047,
+		-2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047,
+		-2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047,
+		-2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047,
+		-2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047, -2047,
+		-2047, -2047, -2042, -2003, -1963, -1923, -1882, -1841, -1799, -1757, -1714, -1672, -1628, -1585, -1541, -1497,
+		-1452, -1408, -1363, -1317, -1272, -1226, -1180, -1134, -1088, -1042, -996, -949, -903, -856, -810, -764,
+		-717, -671, -625, -579, -533, -487, -441, -396, -351, -306, -261, -217, -173, -129, -86, -43,
+		0, 42, 84, 126, 167, 207, 247, 287, 326, 365, 403, 441, 478, 515, 551, 587,
+		622, 656, 690, 724, 757, 789, 821, 852, 882, 913, 942, 971, 1000, 1027, 1055, 1081,
+		1108, 1133, 1159, 1183, 1207, 1231, 1254, 1276, 1299, 1320, 1341, 1362, 1382, 1402, 1421, 1439,
+		1458, 1476, 1493, 1510, 1526, 1543, 1558, 1574, 1589, 1603, 1617, 1631, 1645, 1658, 1671, 1683,
+		1695, 1707, 1718, 1730, 1741, 1751, 1761, 1771, 1781, 1791, 1800, 1809, 1817, 1826, 1834, 1842,
+		1850, 1857, 1865, 1872, 1879, 1886, 1892, 1899, 1905, 1911, 1917, 1922, 1928, 1933, 1938, 1943,
+		1948, 1953, 1957, 1962, 1966, 1970, 1974, 1978, 1982, 1986, 1990, 1993, 1997, 2000, 2003, 2006,
+		2009, 2012, 2015, 2018, 2020, 2023, 2026, 2028, 2030, 2033, 2035, 2037, 2039, 2041, 2043, 2045,
+		2047,
+	},
+	//FOLD
+	{
+		1447, 1402, 1356, 1308, 1259, 1209, 1158, 1106, 1052, 998, 943, 887, 830, 772, 713, 654,
+		594, 534, 473, 412, 350, 288, 226, 163, 100, 38, -25, -88, -151, -213, -275, -338,
+		-399, -461, -522, -582, -642, -701, -760, -818, -875, -932, -987, -1042, -1095, -1148, -1199, -1249,
+		-1299, -1347, -1393, -1439, -1483, -1525, -1566, -1606, -1644, -1681, -1716, -1749, -1781, -1811, -1840, -1866,
+		-1891, -1914, -1936, -1955, -1973, -1989, -2003, -2015, -2025, -2033, -2039, -2044, -2046, -2047, -2046, -2042,
+		-2037, -2030, -2021, -2010, -1997, -1983, -1966, -1948, -1927, -1905, -1881, -1856, -1828, -1799, -1769, -1736,
+		-1702, -1666, -1629, -1590, -1550, -1508, -1465, -1421, -1375, -1328, -1279, -1229, -1179, -1127, -1074, -1020,
+		-965, -909, -852, -795, -737, -678, -618, -558, -497, -436, -375, -313, -251, -188, -126, -63,
+		0, 63, 126, 188, 251, 313, 375, 436, 497, 558, 618, 678, 737, 795, 852, 909,
+		965, 1020, 1074, 1127, 1179, 1229, 1279, 1328, 1375, 1421, 1465, 1508, 1550, 1590, 1629, 1666,
+		1702, 1736, 1769, 1799, 1828, 1856, 1881, 1905, 1927, 1948, 1966, 1983, 1997, 2010, 2021, 2030,
+		2037, 2042, 2046, 2047, 2046, 2044, 2039, 2033, 2025, 2015, 2003, 1989, 1973, 1955, 1936, 1914,
+		1891, 1866, 1840, 1811, 1781, 1749, 1716, 1681, 1644, 1606, 1566, 1525, 1483, 1439, 1393, 1347,
+		1299, 1249, 1199, 1148, 1095, 1042, 987, 932, 875, 818, 760, 701, 642, 582, 522, 461,
+		399, 338, 275, 213, 151, 88, 25, -38, -100, -163, -226, -288, -350, -412, -473, -534,
+		-594, -654, -713, -772, -830, -887, -943, -998, -1052, -1106, -1158, -1209, -1259, -1308, -1356, -1402,
+		-1447,
+	},
+};
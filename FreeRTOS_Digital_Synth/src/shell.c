@@ -0,0 +1,140 @@
+/*************************************************************************************************
+                                            --SHELL--
+
+	The line is kept in a fixed buffer and split in place, the words point into it. A
+	command runs only with as many arguments as it asks for, so handlers can use argv
+	without counting; extra words are an error rather than silently ignored.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shell.h"
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void shell_run( void );
+
+
+/*******   GLOBAL VARS  *********/
+static const struct shell_command *shell_commands;
+static int shell_count;
+static char shell_line[SHELL_LINE_LEN + 1];
+static int shell_length;
+static bool shell_open;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void shell_init( const struct shell_command *commands, int count )
+{
+	shell_commands = commands;
+	shell_count = count;
+	shell_open = false;
+}
+
+bool shell_input( char c )
+{
+	//true when the character belongs to a line, false leaves it to the single-key commands
+	if(shell_open == false)
+	{
+		if(c != SHELL_PROMPT) return false;
+
+		shell_open = true;
+		shell_length = 0;
+		printf("%c", SHELL_PROMPT);
+		return true;
+	}
+
+	switch(c)
+	{
+		case '\r':
+		case '\n':
+			printf("\r\n");
+			shell_open = false;
+			shell_line[shell_length] = '\0';
+			shell_run();
+			break;
+		case 0x1B:
+			printf(" ^\r\n");
+			shell_open = false;
+			break;
+		case 0x08:
+		case 0x7F:
+			if(shell_length > 0)
+			{
+				shell_length--;
+				printf("\b \b");
+			}
+			break;
+		default:
+			if((c >= ' ') && (shell_length < SHELL_LINE_LEN))
+			{
+				shell_line[shell_length++] = c;
+				printf("%c", c);
+			}
+			break;
+	}
+
+	return true;
+}
+
+static void shell_run( void )
+{
+	char *words[SHELL_ARGS_MAX + 1];
+	char *word;
+	int count = 0;
+	int i;
+
+	for(word=strtok(shell_line, " \t"); word!=NULL; word=strtok(NULL, " \t"))
+	{
+		if(count == SHELL_ARGS_MAX + 1) break;
+		words[count++] = word;
+	}
+	if(count == 0) return;
+
+	for(i=0; i<shell_count; i++)
+	{
+		if(strcmp(words[0], shell_commands[i].name) != 0) continue;
+
+		if((count - 1 != shell_commands[i].args) || (word != NULL))
+		{
+			printf("usage: %s %s\r\n", shell_commands[i].name, shell_commands[i].usage);
+			return;
+		}
+		shell_commands[i].run(&words[1]);
+		return;
+	}
+
+	printf("shell: no command '%s', :help lists them\r\n", words[0]);
+}
+
+void shell_help( void )
+{
+	int i;
+
+	for(i=0; i<shell_count; i++) printf(":%s %s\r\n", shell_commands[i].name, shell_commands[i].usage);
+}
+
+bool shell_number( const char *word, int32_t low, int32_t high, int32_t *value )
+{
+	//whole word as a decimal or 0x hex number within low..high, prints why when it is not
+	char *end;
+	bool hex = (word[0] == '0') && ((word[1] == 'x') || (word[1] == 'X'));
+	long n = strtol(word, &end, hex ? 16 : 10);
+
+	if((*end != '\0') || (end == word))
+	{
+		printf("shell: '%s' is not a number\r\n", word);
+		return false;
+	}
+	if((n < low) || (n > high))
+	{
+		printf("shell: %ld is outside %ld..%ld\r\n", n, (long) low, (long) high);
+		return false;
+	}
+
+	*value = (int32_t) n;
+	return true;
+}
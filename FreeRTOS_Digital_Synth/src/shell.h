@@ -0,0 +1,40 @@
+/*************************************************************************************************
+                                            --SHELL--
+
+	Line commands on the EDBG console, next to the single-key ones. A ':' starts a line,
+	which is echoed and may be edited with backspace until Enter runs it or Escape drops
+	it; keys outside a line go on to the single-key handler. A line is a command name and
+	up to SHELL_ARGS_MAX whitespace separated words, commands come from a table the
+	application hands to shell_init().
+
+	Runs in whatever task feeds it characters, the console task here, so a command may
+	print and take its time but must not touch the engine's state directly.
+
+*************************************************************************************************/
+
+#ifndef SHELL_H_INCLUDED
+#define SHELL_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#define SHELL_PROMPT			(	':'	)
+#define SHELL_LINE_LEN			(	48	)
+#define SHELL_ARGS_MAX			(	5	)
+
+/********   TYPE DEFS  **********/
+struct shell_command{
+	const char *name;
+	const char *usage;		//arguments, for the help text
+	int args;				//number of arguments it needs
+	void (*run)(char *argv[]);
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void shell_init( const struct shell_command *commands, int count );
+bool shell_input( char c );
+void shell_help( void );
+bool shell_number( const char *word, int32_t low, int32_t high, int32_t *value );
+
+#endif /* SHELL_H_INCLUDED */
@@ -0,0 +1,52 @@
+/*************************************************************************************************
+                                            --SIMD--
+
+	Pairs of 16-bit values in a word for the DSP extension of the M4F parts, one SMUAD or
+	SMLAD multiplying both halves and summing them. With SYNTH_PART_DSP the products are the
+	ACLE intrinsics, one instruction each; elsewhere they are C with the same results, so
+	the host build can run the SYNTH_OSC_SIMD kernels against the golden renders. The pack
+	is C on both, GCC makes it a PKHBT.
+
+		simd_pack(lo, hi)			lo in the bottom halfword, hi in the top
+		simd_dual(x, y)				x.lo * y.lo + x.hi * y.hi
+		simd_dual_acc(x, y, acc)	the same plus acc, wrapping as an int32_t sum does
+
+	simd_dual() of the pair (a, b) with the pair (256 - w, w) is a * 256 + (b - a) * w, so
+	shifted down 8 it is the linear step from a to b by w / 256, exactly.
+
+*************************************************************************************************/
+
+#ifndef SIMD_H_INCLUDED
+#define SIMD_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+#if SYNTH_PART_DSP
+#  include <arm_acle.h>
+#endif
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline int32_t simd_pack( int32_t lo, int32_t hi )
+{
+	return (int32_t) (((uint32_t) hi << 16) | (uint16_t) lo);
+}
+
+static inline int32_t simd_dual( int32_t x, int32_t y )
+{
+#if SYNTH_PART_DSP
+	return __smuad(x, y);
+#else
+	return (int16_t) x * (int16_t) y + (x >> 16) * (y >> 16);
+#endif
+}
+
+static inline int32_t simd_dual_acc( int32_t x, int32_t y, int32_t acc )
+{
+#if SYNTH_PART_DSP
+	return __smlad(x, y, acc);
+#else
+	return (int32_t) ((uint32_t) acc + (uint32_t) ((int16_t) x * (int16_t) y) + (uint32_t) ((x >> 16) * (y >> 16)));
+#endif
+}
+
+#endif /* SIMD_H_INCLUDED */
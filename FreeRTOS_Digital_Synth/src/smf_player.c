@@ -0,0 +1,501 @@
+/*************************************************************************************************
+                                          --SMF PLAYER--
+
+	Each track's buffer is a ring of SMF_RING bytes indexed by the file offset, holding the
+	bytes from the next one to parse up to 'landed'; 'fetched' runs ahead of it by the read
+	in flight. Only one read is in flight for the whole player, for the track with the
+	least ahead that has room for SMF_READ_MIN bytes or its last ones, so a track about to
+	run dry is served first.
+
+	An event is parsed once SMF_EVENT_MAX bytes have landed past it, or the rest of the
+	track, which covers any channel message and the head of any meta event. A system
+	exclusive or meta event longer than what landed is skipped in the file: the ring starts
+	over after it, and the generation count makes the done callback drop a read still in
+	flight for the old offsets.
+
+	A tempo change starts a new segment: the sample and tick it falls on, from which later
+	ticks convert at its tempo, in 64 bits since a tick at a slow tempo and a high rate
+	overflows 32.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <string.h>
+#include "smf_player.h"
+#include "spi_flash.h"
+#include "synth_engine.h"
+#include "trace_log.h"
+
+#if SYNTH_SMF_PLAYER
+
+/**********  DEFINE  ************/
+#define SMF_RING				(	64	)	//a power of two
+#define SMF_RING_MASK			(	SMF_RING - 1	)
+#define SMF_READ_MIN			(	16	)
+#define SMF_EVENT_MAX			(	16	)	//4 delta bytes, FF 51, a length and the tempo, with room
+#define SMF_HEADER_SIZE			(	14	)
+#define SMF_CHUNK_HEAD			(	8	)
+#define SMF_CHUNK_MAX			(	0x01000000	)	//longer is erased flash
+#define SMF_TEMPO_DEFAULT		(	500000	)	//us per quarter note, 120 bpm
+#define SMF_CHANNELS			(	16	)
+
+#define SMF_META				(	0xFF	)
+#define SMF_META_END			(	0x2F	)
+#define SMF_META_TEMPO			(	0x51	)
+#define SMF_TEMPO_EVENT			(	0	)	//in the status of a track's next event
+
+
+/********   TYPE DEFS  **********/
+enum smf_parsed{
+	SMF_PARSED,
+	SMF_SHORT,			//waits for its buffer
+	SMF_END,
+};
+
+enum smf_request{
+	SMF_REQUEST_NONE,
+	SMF_REQUEST_START,
+	SMF_REQUEST_STOP,
+};
+
+struct smf_track{
+	uint32_t start;
+	uint32_t end;
+	uint32_t pos;
+	volatile uint32_t landed;
+	uint32_t fetched;
+	volatile uint8_t gen;
+	uint8_t status;				//running status, 0 for none
+	bool waiting;				//its next event is not parsed yet
+	bool ended;
+	uint32_t tick;				//of its next event
+	struct midi_event event;
+	uint32_t tempo;				//of its next event when that is a tempo change
+	uint8_t ring[SMF_RING];
+};
+
+
+/*******   GLOBAL VARS  *********/
+static struct smf_track smf_tracks[SYNTH_SMF_TRACKS];
+static int smf_track_count;
+static uint16_t smf_division;			//ticks per quarter note
+
+static uint8_t smf_heap[SYNTH_SMF_TRACKS];
+static int smf_heap_count;
+
+static volatile bool smf_reading;
+static uint8_t smf_read_track;
+static uint8_t smf_read_gen;
+static uint32_t smf_read_end;
+
+static volatile uint8_t smf_request;
+static bool smf_playing;
+static bool smf_started;
+static uint8_t smf_release = SMF_CHANNELS;
+static uint32_t smf_seg_sample;
+static uint32_t smf_seg_tick;
+static uint32_t smf_tempo;
+static uint32_t smf_stalls;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint32_t smf_be32( const uint8_t *p )
+{
+	return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+static uint16_t smf_be16( const uint8_t *p )
+{
+	return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+int smf_player_init( void )
+{
+	//start-up, with the flash up and before the scheduler: the tracks of the file at
+	//SYNTH_SMF_ADDRESS, 0 without one it plays
+	uint8_t head[SMF_HEADER_SIZE];
+	uint32_t address;
+	uint32_t length;
+	uint16_t tracks;
+	uint16_t n;
+
+	smf_track_count = 0;
+	spi_flash_read(SYNTH_SMF_ADDRESS, head, SMF_HEADER_SIZE);
+	length = smf_be32(&head[4]);
+	if((memcmp(head, "MThd", 4) != 0) || (length < 6) || (length >= SMF_CHUNK_MAX)) return 0;
+
+	//format 2 is independent songs, a negative division SMPTE frames
+	tracks = smf_be16(&head[10]);
+	smf_division = smf_be16(&head[12]);
+	if((smf_be16(&head[8]) > 1) || (smf_division == 0) || (smf_division & 0x8000)) return 0;
+
+	address = SYNTH_SMF_ADDRESS + SMF_CHUNK_HEAD + length;
+	for(n=0; (n < tracks) && (smf_track_count < SYNTH_SMF_TRACKS); n++)
+	{
+		spi_flash_read(address, head, SMF_CHUNK_HEAD);
+		length = smf_be32(&head[4]);
+		if(length >= SMF_CHUNK_MAX) break;
+
+		//chunks of other types are skipped
+		if(memcmp(head, "MTrk", 4) == 0)
+		{
+			smf_tracks[smf_track_count].start = address + SMF_CHUNK_HEAD;
+			smf_tracks[smf_track_count].end = address + SMF_CHUNK_HEAD + length;
+			smf_track_count++;
+		}
+		address += SMF_CHUNK_HEAD + length;
+	}
+
+	return smf_track_count;
+}
+
+void smf_player_start( void )
+{
+	//from the start; the MIDI task's next poll
+	if(smf_track_count > 0) smf_request = SMF_REQUEST_START;
+}
+
+void smf_player_stop( void )
+{
+	smf_request = SMF_REQUEST_STOP;
+}
+
+bool smf_player_playing( void )
+{
+	return smf_playing || (smf_request != SMF_REQUEST_NONE) || (smf_release < SMF_CHANNELS);
+}
+
+uint32_t smf_player_stalls( void )
+{
+	return smf_stalls;
+}
+
+static void smf_read_done( void )
+{
+	//SPI flash RX interrupt
+	struct smf_track *track = &smf_tracks[smf_read_track];
+
+	if(track->gen == smf_read_gen) track->landed = smf_read_end;
+	smf_reading = false;
+}
+
+static void smf_fetch( void )
+{
+	struct smf_track *track;
+	uint32_t ahead;
+	uint32_t room;
+	uint32_t left;
+	uint32_t best_ahead = SMF_RING;
+	uint32_t length;
+	int best = -1;
+	int i;
+
+	if(smf_reading) return;
+
+	for(i=0; i<smf_track_count; i++)
+	{
+		track = &smf_tracks[i];
+		left = track->end - track->fetched;
+		if(track->ended || (left == 0)) continue;
+
+		ahead = track->fetched - track->pos;
+		room = SMF_RING - ahead;
+		if((room < SMF_READ_MIN) && (room < left)) continue;
+
+		if(ahead < best_ahead)
+		{
+			best_ahead = ahead;
+			best = i;
+		}
+	}
+	if(best < 0) return;
+
+	//up to the end of the ring, the rest is the next read's
+	track = &smf_tracks[best];
+	length = SMF_RING - (track->fetched & SMF_RING_MASK);
+	if(length > SMF_RING - best_ahead) length = SMF_RING - best_ahead;
+	if(length > track->end - track->fetched) length = track->end - track->fetched;
+
+	smf_read_track = (uint8_t) best;
+	smf_read_gen = track->gen;
+	smf_read_end = track->fetched + length;
+	smf_reading = true;
+	spi_flash_read_async(track->fetched, &track->ring[track->fetched & SMF_RING_MASK], (uint16_t) length, smf_read_done);
+	track->fetched += length;
+}
+
+static bool smf_vlq( const struct smf_track *track, uint32_t landed, uint32_t *pos, uint32_t *value )
+{
+	uint8_t byte;
+	int i;
+
+	*value = 0;
+	for(i=0; i<4; i++)
+	{
+		if(*pos >= landed) return false;
+		byte = track->ring[(*pos)++ & SMF_RING_MASK];
+		*value = (*value << 7) | (byte & 0x7F);
+		if((byte & 0x80) == 0) return true;
+	}
+
+	return false;
+}
+
+static void smf_skip( struct smf_track *track, uint32_t pos )
+{
+	//past an event that ends beyond what landed: the ring starts over there
+	if(pos > track->end) pos = track->end;
+	track->pos = pos;
+	if(pos > track->landed)
+	{
+		track->gen++;
+		track->landed = pos;
+		track->fetched = pos;
+	}
+}
+
+static int smf_parse( struct smf_track *track )
+{
+	//the track's next event with its tick, skipping the ones the player does not send
+	uint32_t landed;
+	uint32_t pos;
+	uint32_t delta;
+	uint32_t length;
+	uint8_t status;
+	uint8_t type;
+
+	while(1)
+	{
+		landed = track->landed;
+		if(track->pos >= track->end) return SMF_END;
+		if((landed - track->pos < SMF_EVENT_MAX) && (landed < track->end)) return SMF_SHORT;
+
+		pos = track->pos;
+		if(smf_vlq(track, landed, &pos, &delta) == false) return SMF_END;
+		if(pos >= landed) return SMF_END;
+
+		status = track->ring[pos & SMF_RING_MASK];
+		if(status & 0x80) pos++;
+		else status = track->status;
+
+		if(status == SMF_META)
+		{
+			if(pos >= landed) return SMF_END;
+			type = track->ring[pos++ & SMF_RING_MASK];
+			if(smf_vlq(track, landed, &pos, &length) == false) return SMF_END;
+			if(type == SMF_META_END) return SMF_END;
+
+			track->tick += delta;
+			track->status = 0;
+			if((type == SMF_META_TEMPO) && (length == 3) && (pos + 3 <= landed))
+			{
+				track->tempo = ((uint32_t) track->ring[pos & SMF_RING_MASK] << 16) |
+					((uint32_t) track->ring[(pos + 1) & SMF_RING_MASK] << 8) | track->ring[(pos + 2) & SMF_RING_MASK];
+				track->event.status = SMF_TEMPO_EVENT;
+				track->pos = pos + 3;
+				return SMF_PARSED;
+			}
+			smf_skip(track, pos + length);
+		}
+		else if((status == MIDI_SYSEX_START) || (status == MIDI_SYSEX_END))
+		{
+			if(smf_vlq(track, landed, &pos, &length) == false) return SMF_END;
+			track->tick += delta;
+			track->status = 0;
+			smf_skip(track, pos + length);
+		}
+		else if((status < 0x80) || (status > MIDI_SYSEX_START))
+		{
+			//a data byte with no running status, or a system message files do not hold
+			return SMF_END;
+		}
+		else
+		{
+			track->status = status;
+			track->event.status = status & 0xF0;
+			track->event.channel = status & 0x0F;
+			track->event.data1 = track->ring[pos++ & SMF_RING_MASK] & 0x7F;
+			track->event.data2 = 0;
+			if((track->event.status != MIDI_PROGRAM_CHANGE) && (track->event.status != MIDI_CHANNEL_PRESSURE))
+			{
+				track->event.data2 = track->ring[pos++ & SMF_RING_MASK] & 0x7F;
+			}
+			if(pos > landed) return SMF_END;
+			if((track->event.status == MIDI_NOTE_ON) && (track->event.data2 == 0)) track->event.status = MIDI_NOTE_OFF;
+
+			track->tick += delta;
+			track->pos = pos;
+			return SMF_PARSED;
+		}
+	}
+}
+
+static bool smf_before( uint8_t a, uint8_t b )
+{
+	//earlier tick first, then the lower track, so the tempo map of a format 1 file leads
+	if(smf_tracks[a].tick != smf_tracks[b].tick) return smf_tracks[a].tick < smf_tracks[b].tick;
+	return a < b;
+}
+
+static void smf_heap_push( uint8_t track )
+{
+	int i = smf_heap_count++;
+	int parent;
+
+	while(i > 0)
+	{
+		parent = (i - 1) / 2;
+		if(smf_before(smf_heap[parent], track)) break;
+		smf_heap[i] = smf_heap[parent];
+		i = parent;
+	}
+	smf_heap[i] = track;
+}
+
+static void smf_heap_pop( void )
+{
+	uint8_t last = smf_heap[--smf_heap_count];
+	int i = 0;
+	int child;
+
+	while((child = 2 * i + 1) < smf_heap_count)
+	{
+		if((child + 1 < smf_heap_count) && smf_before(smf_heap[child + 1], smf_heap[child])) child++;
+		if(smf_before(last, smf_heap[child])) break;
+		smf_heap[i] = smf_heap[child];
+		i = child;
+	}
+	smf_heap[i] = last;
+}
+
+static uint32_t smf_sample( uint32_t tick )
+{
+	uint64_t us = (uint64_t) (tick - smf_seg_tick) * smf_tempo;
+
+	return smf_seg_sample + (uint32_t) ((us * synth_sample_rate()) / ((uint64_t) smf_division * 1000000));
+}
+
+static void smf_rewind( void )
+{
+	struct smf_track *track;
+	int i;
+
+	for(i=0; i<smf_track_count; i++)
+	{
+		track = &smf_tracks[i];
+		track->gen++;
+		track->pos = track->start;
+		track->landed = track->start;
+		track->fetched = track->start;
+		track->status = 0;
+		track->tick = 0;
+		track->waiting = true;
+		track->ended = false;
+	}
+	smf_heap_count = 0;
+	smf_tempo = SMF_TEMPO_DEFAULT;
+	smf_seg_tick = 0;
+	smf_started = false;
+}
+
+int smf_player_poll( uint32_t now, struct midi_event *events, uint32_t *times, int max )
+{
+	//MIDI task: the events due by render time 'now', at most 'max', with their times
+	struct smf_track *track;
+	uint32_t time;
+	bool waiting = false;
+	uint8_t i;
+	int count = 0;
+	int parsed;
+
+	if(smf_request != SMF_REQUEST_NONE)
+	{
+		if(smf_request == SMF_REQUEST_START) smf_rewind();
+		else if(smf_playing) smf_release = 0;
+		smf_playing = (smf_request == SMF_REQUEST_START);
+		smf_request = SMF_REQUEST_NONE;
+	}
+
+	while((count < max) && (smf_release < SMF_CHANNELS))
+	{
+		events[count].status = MIDI_CONTROL_CHANGE;
+		events[count].channel = smf_release++;
+		events[count].data1 = MIDI_CC_ALL_NOTES_OFF;
+		events[count].data2 = 0;
+		times[count++] = now;
+	}
+	if(smf_playing == false) return count;
+
+	smf_fetch();
+
+	for(i=0; i<smf_track_count; i++)
+	{
+		track = &smf_tracks[i];
+		if(track->waiting == false) continue;
+
+		parsed = smf_parse(track);
+		if(parsed == SMF_SHORT)
+		{
+			waiting = true;
+			continue;
+		}
+		track->waiting = false;
+		if(parsed == SMF_PARSED) smf_heap_push(i);
+		else track->ended = true;
+	}
+	if(waiting) return count;
+
+	//the song's first event is the first look
+	if(smf_started == false)
+	{
+		smf_seg_sample = now;
+		smf_started = true;
+	}
+
+	while((count < max) && (smf_heap_count > 0))
+	{
+		i = smf_heap[0];
+		track = &smf_tracks[i];
+		time = smf_sample(track->tick);
+		if((int32_t) (time - now) > 0) break;
+
+		smf_heap_pop();
+		if(track->event.status == SMF_TEMPO_EVENT)
+		{
+			smf_seg_sample = time;
+			smf_seg_tick = track->tick;
+			smf_tempo = track->tempo;
+		}
+		else
+		{
+			events[count] = track->event;
+			times[count++] = time;
+		}
+
+		parsed = smf_parse(track);
+		if(parsed == SMF_PARSED) smf_heap_push(i);
+		else if(parsed == SMF_END) track->ended = true;
+		else
+		{
+			//the other tracks wait for it, to stay in order
+			track->waiting = true;
+			smf_stalls++;
+			return count;
+		}
+	}
+
+	if(smf_heap_count == 0)
+	{
+		trace_log("song: ended, %lu stalls\r\n", smf_stalls);
+		if(SYNTH_SMF_LOOP) smf_rewind();
+		else
+		{
+			smf_playing = false;
+			smf_release = 0;
+		}
+	}
+
+	return count;
+}
+
+#endif /* SYNTH_SMF_PLAYER */
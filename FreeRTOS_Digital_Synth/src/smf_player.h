@@ -0,0 +1,37 @@
+/*************************************************************************************************
+                                          --SMF PLAYER--
+
+	Plays a standard MIDI file from the SPI flash of spi_flash.h through the engine, for a
+	background score without a host computer. The file stays in the flash: each track has
+	a read-ahead buffer of a few dozen bytes that DMA reads keep topped up next to the
+	stream passes, and its events are parsed from there one at a time as they come due.
+
+	The tracks are merged on the time of their next event, kept in a min-heap, so a format
+	1 file with many tracks costs a few comparisons per event. Tempo changes from any track
+	apply from their tick on; SMPTE time division and format 2 files are not played.
+
+	The MIDI task asks smf_player_poll() for the events due by the sample playing now and
+	queues each for the sample its tick falls on. A track whose buffer has not landed holds
+	back every track until it has, rather than play out of order, and counts a stall.
+	smf_player_start() and smf_player_stop() may be called from any task, the MIDI task
+	acts on them at its next poll; a stop sends All Notes Off on every channel.
+
+*************************************************************************************************/
+
+#ifndef SMF_PLAYER_H_INCLUDED
+#define SMF_PLAYER_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+int smf_player_init( void );
+void smf_player_start( void );
+void smf_player_stop( void );
+bool smf_player_playing( void );
+int smf_player_poll( uint32_t now, struct midi_event *events, uint32_t *times, int max );
+uint32_t smf_player_stalls( void );
+
+#endif /* SMF_PLAYER_H_INCLUDED */
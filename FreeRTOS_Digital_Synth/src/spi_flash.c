@@ -0,0 +1,318 @@
+/*************************************************************************************************
+                                          --SPI FLASH--
+
+	Each read is two linked descriptors per channel, command then data, rebuilt in place
+	before the channels are enabled. RX is enabled first and at a higher level than TX, so
+	no byte the flash clocks back is missed, and the DAC channel stays the lowest: its one
+	word per sample has most of a sample period to spare, the SERCOM receive buffer only
+	two bytes.
+
+	flash_active says the bus is taken. A pass or a single read that finds it taken waits
+	as pending and the RX interrupt of whatever holds it starts the next one, a pass before
+	a single read since voices underrun and a song's read-ahead does not as quickly. A task
+	that claims the bus for erasing and programming holds flash_active the same way, its
+	release starts what waited.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spi_flash.h"
+#include "dac_dma.h"
+#include "fast_gpio.h"
+
+
+/**********  DEFINE  ************/
+#define SPI_FLASH_CMD_BYTES		(	4	)
+
+
+/*******   GLOBAL VARS  *********/
+static struct spi_module flash_spi;
+
+//data descriptors linked from the channels' base descriptors
+SYNTH_DMA_DESCRIPTOR static DmacDescriptor flash_rx_data;
+SYNTH_DMA_DESCRIPTOR static DmacDescriptor flash_tx_data;
+
+static uint8_t flash_cmd[SPI_FLASH_CMD_BYTES];
+static uint8_t flash_discard;
+static const uint8_t flash_dummy = 0xFF;
+
+static const struct stream_read *flash_reads;
+static int flash_read_count;
+static int flash_read_next;
+
+static volatile bool flash_active;
+static bool flash_in_pass;
+static volatile bool flash_pass_pending;
+static struct stream_read flash_single;
+static spi_flash_done_t flash_single_done;
+static volatile bool flash_single_pending;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void spi_flash_rx_done( void );
+static void spi_flash_next( void );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static void spi_flash_channel_init( int channel, uint8_t trigger, uint8_t level )
+{
+	DMAC->CHID.reg = DMAC_CHID_ID(channel);
+	DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+	while(DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+	DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(level) | DMAC_CHCTRLB_TRIGSRC(trigger) | DMAC_CHCTRLB_TRIGACT_BEAT;
+}
+
+void spi_flash_init( void )
+{
+	struct spi_config config_spi;
+	struct port_config pin_conf;
+
+	port_get_config_defaults(&pin_conf);
+	pin_conf.direction = PORT_PIN_DIR_OUTPUT;
+	port_pin_set_config(SPI_FLASH_CS_PIN, &pin_conf);
+	port_pin_set_output_level(SPI_FLASH_CS_PIN, true);
+
+	//mode 0, pad 0 data in, pad 2 data out, pad 3 SCK, pad 1 left to the GPIO chip select
+	spi_get_config_defaults(&config_spi);
+	config_spi.mux_setting = EXT3_SPI_SERCOM_MUX_SETTING;
+	config_spi.pinmux_pad0 = EXT3_SPI_SERCOM_PINMUX_PAD0;
+	config_spi.pinmux_pad1 = PINMUX_UNUSED;
+	config_spi.pinmux_pad2 = EXT3_SPI_SERCOM_PINMUX_PAD2;
+	config_spi.pinmux_pad3 = EXT3_SPI_SERCOM_PINMUX_PAD3;
+	config_spi.generator_source = SYNTH_FIXED_GCLK;
+	spi_init(&flash_spi, EXT3_SPI_MODULE, &config_spi);
+	spi_enable(&flash_spi);
+	spi_set_baudrate(&flash_spi, SPI_FLASH_BAUDRATE);
+
+	dac_dma_controller_init();
+	spi_flash_channel_init(FLASH_DMA_TX_CHANNEL, EXT3_SPI_SERCOM_DMAC_ID_TX, 1);
+	spi_flash_channel_init(FLASH_DMA_RX_CHANNEL, EXT3_SPI_SERCOM_DMAC_ID_RX, 2);
+	DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+	dac_dma_attach_channel(FLASH_DMA_RX_CHANNEL, spi_flash_rx_done);
+}
+
+static void spi_flash_command( uint32_t address )
+{
+	flash_cmd[0] = SPI_FLASH_CMD_READ;
+	flash_cmd[1] = (uint8_t) (address >> 16);
+	flash_cmd[2] = (uint8_t) (address >> 8);
+	flash_cmd[3] = (uint8_t) address;
+}
+
+static void spi_flash_simple( uint8_t command )
+{
+	uint16_t rx;
+
+	fast_pin_low(SPI_FLASH_CS_PIN);
+	spi_transceive_wait(&flash_spi, command, &rx);
+	fast_pin_high(SPI_FLASH_CS_PIN);
+}
+
+void spi_flash_read( uint32_t address, void *buffer, uint32_t length )
+{
+	//one byte at a time on the CPU
+	uint8_t *out = buffer;
+	uint16_t rx;
+	int i;
+
+	spi_flash_command(address);
+	fast_pin_low(SPI_FLASH_CS_PIN);
+
+	for(i=0; i<SPI_FLASH_CMD_BYTES; i++) spi_transceive_wait(&flash_spi, flash_cmd[i], &rx);
+	while(length--)
+	{
+		spi_transceive_wait(&flash_spi, flash_dummy, &rx);
+		*out++ = (uint8_t) rx;
+	}
+
+	fast_pin_high(SPI_FLASH_CS_PIN);
+}
+
+static void spi_flash_start( const struct stream_read *r )
+{
+	//addresses are end addresses where the descriptor increments
+	DmacDescriptor *rx = dac_dma_base_descriptor(FLASH_DMA_RX_CHANNEL);
+	DmacDescriptor *tx = dac_dma_base_descriptor(FLASH_DMA_TX_CHANNEL);
+	uint32_t data = (uint32_t) &flash_spi.hw->SPI.DATA.reg;
+
+	spi_flash_command(r->address);
+
+	rx->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_BLOCKACT_NOACT;
+	rx->BTCNT.reg = SPI_FLASH_CMD_BYTES;
+	rx->SRCADDR.reg = data;
+	rx->DSTADDR.reg = (uint32_t) &flash_discard;
+	rx->DESCADDR.reg = (uint32_t) &flash_rx_data;
+
+	flash_rx_data.BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_DSTINC | DMAC_BTCTRL_BLOCKACT_INT;
+	flash_rx_data.BTCNT.reg = r->length;
+	flash_rx_data.SRCADDR.reg = data;
+	flash_rx_data.DSTADDR.reg = (uint32_t) r->buffer + r->length;
+	flash_rx_data.DESCADDR.reg = 0;
+
+	tx->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_BLOCKACT_NOACT;
+	tx->BTCNT.reg = SPI_FLASH_CMD_BYTES;
+	tx->SRCADDR.reg = (uint32_t) flash_cmd + SPI_FLASH_CMD_BYTES;
+	tx->DSTADDR.reg = data;
+	tx->DESCADDR.reg = (uint32_t) &flash_tx_data;
+
+	flash_tx_data.BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_BLOCKACT_NOACT;
+	flash_tx_data.BTCNT.reg = r->length;
+	flash_tx_data.SRCADDR.reg = (uint32_t) &flash_dummy;
+	flash_tx_data.DSTADDR.reg = data;
+	flash_tx_data.DESCADDR.reg = 0;
+
+	fast_pin_low(SPI_FLASH_CS_PIN);
+
+	DMAC->CHID.reg = DMAC_CHID_ID(FLASH_DMA_RX_CHANNEL);
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+	DMAC->CHID.reg = DMAC_CHID_ID(FLASH_DMA_TX_CHANNEL);
+	DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+}
+
+void spi_flash_read_batch( const struct stream_read *reads, int count )
+{
+	//the rest of the pass is chained from the RX interrupt, and the pass itself from the
+	//single read's if that has the bus
+	flash_reads = reads;
+	flash_read_count = count;
+	flash_read_next = 0;
+
+	taskENTER_CRITICAL();
+	if(flash_active) flash_pass_pending = true;
+	else
+	{
+		flash_active = true;
+		flash_in_pass = true;
+		spi_flash_start(&flash_reads[0]);
+	}
+	taskEXIT_CRITICAL();
+}
+
+void spi_flash_read_async( uint32_t address, void *buffer, uint16_t length, spi_flash_done_t done )
+{
+	//one read by DMA, 'done' runs from the DMAC interrupt once it has landed; one at a time,
+	//the next only after that
+	flash_single.address = address;
+	flash_single.buffer = buffer;
+	flash_single.length = length;
+	flash_single_done = done;
+
+	taskENTER_CRITICAL();
+	if(flash_active) flash_single_pending = true;
+	else
+	{
+		flash_active = true;
+		flash_in_pass = false;
+		spi_flash_start(&flash_single);
+	}
+	taskEXIT_CRITICAL();
+}
+
+
+bool spi_flash_claim( void )
+{
+	//a task, for the blocking calls below; false while a read has the bus
+	bool claimed = false;
+
+	taskENTER_CRITICAL();
+	if(flash_active == false)
+	{
+		flash_active = true;
+		claimed = true;
+	}
+	taskEXIT_CRITICAL();
+
+	return claimed;
+}
+
+void spi_flash_release( void )
+{
+	taskENTER_CRITICAL();
+	spi_flash_next();
+	taskEXIT_CRITICAL();
+}
+
+bool spi_flash_busy( void )
+{
+	//an erase or program still running
+	uint16_t rx;
+
+	fast_pin_low(SPI_FLASH_CS_PIN);
+	spi_transceive_wait(&flash_spi, SPI_FLASH_CMD_STATUS, &rx);
+	spi_transceive_wait(&flash_spi, flash_dummy, &rx);
+	fast_pin_high(SPI_FLASH_CS_PIN);
+
+	return (rx & SPI_FLASH_STATUS_WIP) != 0;
+}
+
+void spi_flash_erase_sector( uint32_t address )
+{
+	//starts the erase of the sector holding 'address', spi_flash_busy() until it is done
+	uint16_t rx;
+	int i;
+
+	spi_flash_simple(SPI_FLASH_CMD_WRITE_ENABLE);
+	spi_flash_command(address);
+	flash_cmd[0] = SPI_FLASH_CMD_ERASE_SECTOR;
+	fast_pin_low(SPI_FLASH_CS_PIN);
+	for(i=0; i<SPI_FLASH_CMD_BYTES; i++) spi_transceive_wait(&flash_spi, flash_cmd[i], &rx);
+	fast_pin_high(SPI_FLASH_CS_PIN);
+}
+
+void spi_flash_program( uint32_t address, const void *data, uint16_t length )
+{
+	//starts programming up to the end of the page holding 'address', into erased bytes
+	const uint8_t *in = data;
+	uint16_t rx;
+	int i;
+
+	spi_flash_simple(SPI_FLASH_CMD_WRITE_ENABLE);
+	spi_flash_command(address);
+	flash_cmd[0] = SPI_FLASH_CMD_PROGRAM;
+	fast_pin_low(SPI_FLASH_CS_PIN);
+	for(i=0; i<SPI_FLASH_CMD_BYTES; i++) spi_transceive_wait(&flash_spi, flash_cmd[i], &rx);
+	while(length--) spi_transceive_wait(&flash_spi, *in++, &rx);
+	fast_pin_high(SPI_FLASH_CS_PIN);
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+static void spi_flash_rx_done( void )
+{
+	//the last data byte is in, so the flash is done with the read
+	DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+	fast_pin_high(SPI_FLASH_CS_PIN);
+
+	if(flash_in_pass)
+	{
+		stream_read_done();
+		if(++flash_read_next < flash_read_count)
+		{
+			spi_flash_start(&flash_reads[flash_read_next]);
+			return;
+		}
+	}
+	else flash_single_done();
+
+	spi_flash_next();
+}
+
+static void spi_flash_next( void )
+{
+	//the bus is free, for whoever waits
+	if(flash_pass_pending)
+	{
+		flash_pass_pending = false;
+		flash_in_pass = true;
+		spi_flash_start(&flash_reads[0]);
+	}
+	else if(flash_single_pending)
+	{
+		flash_single_pending = false;
+		flash_in_pass = false;
+		spi_flash_start(&flash_single);
+	}
+	else flash_active = false;
+}
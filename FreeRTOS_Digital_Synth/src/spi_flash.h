@@ -0,0 +1,60 @@
+/*************************************************************************************************
+                                          --SPI FLASH--
+
+	Driver for a 25-series SPI NOR flash on EXT3 (SERCOM5, MISO PB16, MOSI PB22,
+	SCK PB23), the stream backend of stream.h. Chip select is a GPIO on EXT3 pin 15 (PB17),
+	a read is framed by one chip select for its whole length.
+
+	Reads of a prefetch pass run on two DMAC channels: TX clocks out the READ command, the
+	24-bit address and then a dummy byte per data byte, RX drops the four command bytes and
+	lands the rest in the voice's ring. The RX completion interrupt raises chip select,
+	reports the read to stream_read_done() and starts the next one, so the whole pass runs
+	without the CPU beyond one interrupt per read.
+
+	spi_flash_read_async() is a single DMA read next to the passes, for the song player of
+	smf_player.h; it waits for a pass in flight and a pass waits for it.
+
+	spi_flash_read() is the blocking CPU path for the directory at start-up, it must not run
+	while a pass or a single read is in flight. After start-up a task first takes the bus
+	with spi_flash_claim(), which fails while a read has it, and gives it back with
+	spi_flash_release(); in between it may also erase and program, for flash_upload.h. The
+	reads that come up meanwhile wait, and stream voices underrun for as long.
+
+*************************************************************************************************/
+
+#ifndef SPI_FLASH_H_INCLUDED
+#define SPI_FLASH_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "stream.h"
+
+/**********  DEFINE  ************/
+#define SPI_FLASH_CS_PIN		EXT3_PIN_SPI_SS_0
+
+//READ (0x03) is good to 33 MHz on common parts, the SERCOM runs at GCLK0 / 2 at most
+#define SPI_FLASH_BAUDRATE		(	12000000	)
+#define SPI_FLASH_CMD_READ		(	0x03	)
+#define SPI_FLASH_CMD_PROGRAM	(	0x02	)
+#define SPI_FLASH_CMD_STATUS	(	0x05	)
+#define SPI_FLASH_CMD_WRITE_ENABLE	(	0x06	)
+#define SPI_FLASH_CMD_ERASE_SECTOR	(	0x20	)
+#define SPI_FLASH_STATUS_WIP	(	0x01	)
+#define SPI_FLASH_SECTOR_SIZE	(	4096	)
+#define SPI_FLASH_PAGE_SIZE		(	256	)
+
+/********   TYPE DEFS  **********/
+typedef void (*spi_flash_done_t)(void);
+
+/****** FUNCTION PROTOTYPES  ****/
+void spi_flash_init( void );
+void spi_flash_read( uint32_t address, void *buffer, uint32_t length );
+void spi_flash_read_batch( const struct stream_read *reads, int count );
+void spi_flash_read_async( uint32_t address, void *buffer, uint16_t length, spi_flash_done_t done );
+bool spi_flash_claim( void );
+void spi_flash_release( void );
+bool spi_flash_busy( void );
+void spi_flash_erase_sector( uint32_t address );
+void spi_flash_program( uint32_t address, const void *data, uint16_t length );
+
+#endif /* SPI_FLASH_H_INCLUDED */
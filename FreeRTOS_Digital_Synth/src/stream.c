@@ -0,0 +1,239 @@
+/*************************************************************************************************
+                                        --SAMPLE STREAM--
+
+	The ring positions are free running frame counters, the ring slot is the counter masked,
+	so the counters only ever get compared by their difference and wrap harmlessly. Source
+	frames run separately: a read stops at the loop end (or the sample end) and the next one
+	continues from the loop start, so the ring holds the sample already unrolled and the
+	renderer never sees the loop.
+
+	A pass is only started once the previous one has completed. A read that is in flight
+	when its voice restarts therefore lands before the new note asks for anything.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "stream.h"
+#include "synth_engine.h"
+
+
+/**********  DEFINE  ************/
+#define STREAM_FRAME_BYTES		(	2	)
+
+
+/********   TYPE DEFS  **********/
+//play and frac belong to the renderer, requested and src to the scheduler, written to the
+//read interrupt
+struct stream_voice{
+	const struct stream_sample *sample;
+	uint32_t play;
+	uint32_t frac;
+	uint32_t requested;
+	volatile uint32_t written;
+	uint32_t src;
+	uint8_t gen;
+	bool src_done;
+	bool active;
+};
+
+
+/*******   GLOBAL VARS  *********/
+static struct stream_sample stream_samples[STREAM_SAMPLES_MAX];
+static int stream_sample_count;
+
+static stream_batch_fn_t stream_batch;
+
+static struct stream_voice stream_voices[SYNTH_MAX_VOICES];
+static int16_t stream_ring[SYNTH_MAX_VOICES][SYNTH_STREAM_RING_FRAMES];
+
+static struct stream_read stream_reads[SYNTH_MAX_VOICES];
+static volatile int stream_reads_left;
+static int stream_read_next;
+
+static volatile uint32_t underruns;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+int stream_attach( stream_read_fn_t read, stream_batch_fn_t batch )
+{
+	//loads the directory, entries that do not fit the Q12 playback position are skipped
+	struct stream_entry entry;
+	uint32_t header[2];
+	uint32_t n;
+
+	stream_sample_count = 0;
+	stream_batch = batch;
+
+	read(0, header, sizeof(header));
+	if(header[0] != STREAM_MAGIC) return 0;
+
+	for(n=0; (n < header[1]) && (stream_sample_count < STREAM_SAMPLES_MAX); n++)
+	{
+		read(sizeof(header) + n * sizeof(entry), &entry, sizeof(entry));
+		if((entry.length == 0) || (entry.length >= PCM_MAX_FRAMES)) continue;
+
+		stream_samples[stream_sample_count].address = entry.address;
+		stream_samples[stream_sample_count].pcm.data = 0;
+		stream_samples[stream_sample_count].pcm.bits = 16;
+		stream_samples[stream_sample_count].pcm.root_note = entry.root_note;
+		stream_samples[stream_sample_count].pcm.key_lo = entry.key_lo;
+		stream_samples[stream_sample_count].pcm.key_hi = entry.key_hi;
+		stream_samples[stream_sample_count].pcm.rate = entry.rate;
+		stream_samples[stream_sample_count].pcm.length = entry.length;
+		stream_samples[stream_sample_count].pcm.loop_start = entry.loop_start;
+		stream_samples[stream_sample_count].pcm.loop_end = (entry.loop_end <= entry.length) ? entry.loop_end : 0;
+		stream_sample_count++;
+	}
+
+	return stream_sample_count;
+}
+
+const struct stream_sample *stream_sample_for_note( uint8_t note )
+{
+	int i;
+
+	for(i=0; i<stream_sample_count; i++)
+	{
+		if((note >= stream_samples[i].pcm.key_lo) && (note <= stream_samples[i].pcm.key_hi)) return &stream_samples[i];
+	}
+
+	return 0;
+}
+
+void stream_voice_start( int voice, const struct stream_sample *sample, uint32_t frame )
+{
+	//the generation goes first, a read completing from here on is dropped
+	struct stream_voice *sv = &stream_voices[voice];
+
+	sv->gen++;
+	sv->written = 0;
+	sv->requested = 0;
+	sv->play = 0;
+	sv->frac = 0;
+	sv->sample = sample;
+	sv->src = frame;
+	sv->src_done = false;
+	sv->active = true;
+}
+
+void stream_voice_stop( int voice )
+{
+	stream_voices[voice].gen++;
+	stream_voices[voice].active = false;
+}
+
+void stream_stop_all( void )
+{
+	int j;
+
+	for(j=0; j<SYNTH_MAX_VOICES; j++) stream_voice_stop(j);
+}
+
+bool stream_render( int voice, int32_t *mix, int count, uint32_t step, int32_t gain, int32_t gain_step )
+{
+	//nearest frame like a SAMPLE voice, 16-bit data scaled down to the DAC range; returns
+	//true once the last frame of a one-shot has played
+	struct stream_voice *sv = &stream_voices[voice];
+	const int16_t *ring = stream_ring[voice];
+	uint32_t written = sv->written;
+	uint32_t play = sv->play;
+	uint32_t frac = sv->frac;
+	int32_t s;
+	int i;
+
+	for(i=0; i<count; i++)
+	{
+		if(play == written) break;
+		s = ring[play & STREAM_RING_MASK] >> 4;
+		mix[i] += (s * gain) >> MIX_SHIFT;
+		gain += gain_step;
+		frac += step;
+		play += frac >> PCM_FRAC_BITS;
+		frac &= (1u << PCM_FRAC_BITS) - 1;
+
+		//a step of more than one frame may jump past the landed frames
+		if((int32_t) (written - play) < 0) play = written;
+	}
+
+	sv->play = play;
+	sv->frac = frac;
+
+	if(i == count) return false;
+	if(sv->src_done && (written == sv->requested)) return true;
+
+	//still waiting for the first read is not an underrun
+	if(written != 0) underruns++;
+
+	return false;
+}
+
+void stream_prefetch( void )
+{
+	//one pass over the active voices, the largest contiguous read each one has room for
+	struct stream_voice *sv;
+	struct stream_read *r;
+	const struct pcm_sample *pcm;
+	uint32_t room;
+	uint32_t end;
+	uint32_t n;
+	bool looped;
+	int count = 0;
+	int j;
+
+	if(!stream_batch || stream_reads_left) return;
+
+	for(j=0; j<SYNTH_MAX_VOICES; j++)
+	{
+		sv = &stream_voices[j];
+		if(!sv->active || sv->src_done) continue;
+
+		room = SYNTH_STREAM_RING_FRAMES - (sv->requested - sv->play);
+		if(room < SYNTH_STREAM_READ_MIN) continue;
+
+		//contiguous in the ring and in flash
+		n = SYNTH_STREAM_RING_FRAMES - (sv->requested & STREAM_RING_MASK);
+		if(n > room) n = room;
+		pcm = &sv->sample->pcm;
+		looped = pcm->loop_end > pcm->loop_start;
+		end = looped ? pcm->loop_end : pcm->length;
+		if(n > end - sv->src) n = end - sv->src;
+
+		r = &stream_reads[count++];
+		r->address = sv->sample->address + sv->src * STREAM_FRAME_BYTES;
+		r->buffer = &stream_ring[j][sv->requested & STREAM_RING_MASK];
+		r->length = (uint16_t) (n * STREAM_FRAME_BYTES);
+		r->voice = (uint8_t) j;
+		r->gen = sv->gen;
+		r->end = sv->requested + n;
+
+		sv->requested += n;
+		sv->src += n;
+		if(sv->src >= end)
+		{
+			if(looped) sv->src = pcm->loop_start;
+			else sv->src_done = true;
+		}
+	}
+
+	if(count == 0) return;
+
+	stream_read_next = 0;
+	stream_reads_left = count;
+	stream_batch(stream_reads, count);
+}
+
+uint32_t stream_underruns( void )
+{
+	return underruns;
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+void stream_read_done( void )
+{
+	//called by the backend as each read of the pass completes, in order
+	const struct stream_read *r = &stream_reads[stream_read_next++];
+
+	if(r->gen == stream_voices[r->voice].gen) stream_voices[r->voice].written = r->end;
+	stream_reads_left--;
+}
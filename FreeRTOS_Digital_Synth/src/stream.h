@@ -0,0 +1,87 @@
+/*************************************************************************************************
+                                        --SAMPLE STREAM--
+
+	PCM streaming for the STREAM voice type, for sample libraries that do not fit in the
+	internal flash. The samples live in an external SPI NOR flash, 16-bit signed little
+	endian, behind a directory at address 0 (STREAM_MAGIC, a 32-bit count, then one
+	struct stream_entry per sample); tools/gen_flash_image.py builds the image.
+
+	Every voice slot owns a ring of SYNTH_STREAM_RING_FRAMES frames that is filled ahead of
+	the playhead. The renderer only ever reads frames that have landed and the prefetch
+	scheduler only ever asks for frames the playhead has passed, so the ring needs no lock:
+	the renderer owns the playhead, the scheduler the request counter and the read
+	interrupt the landed counter. stream_prefetch() runs once per rendered block and hands
+	the whole pass, one contiguous read per voice that has room for SYNTH_STREAM_READ_MIN
+	frames or more, to the backend in one go, which chains the reads back to back.
+
+	A note starts playing once its first read has landed, a block later than a SAMPLE voice.
+	When the playhead catches up with the reads later on the voice goes silent until the
+	data is there and stream_underruns() counts it. A restarted voice bumps its generation,
+	reads still in flight for the old note are dropped when they complete.
+
+	Nothing is streamed until stream_attach() has loaded the directory; without a backend
+	(the host build) stream_sample_for_note() finds nothing and STREAM notes are not played.
+
+*************************************************************************************************/
+
+#ifndef STREAM_H_INCLUDED
+#define STREAM_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "samples.h"
+
+/**********  DEFINE  ************/
+#define STREAM_MAGIC			(	0x464E5953ul	) //"SYNF"
+#define STREAM_SAMPLES_MAX		(	32	)
+
+#define STREAM_RING_MASK		(	SYNTH_STREAM_RING_FRAMES - 1	)
+
+/********   TYPE DEFS  **********/
+//directory entry as stored in flash, little endian
+struct stream_entry{
+	uint32_t address;
+	uint32_t length;
+	uint32_t loop_start;
+	uint32_t loop_end;
+	uint32_t rate;
+	uint8_t root_note;
+	uint8_t key_lo;
+	uint8_t key_hi;
+	uint8_t reserved;
+};
+
+//pcm carries the playback parameters like a SAMPLE voice's, with no data pointer
+struct stream_sample{
+	struct pcm_sample pcm;
+	uint32_t address;
+};
+
+//one flash read of the prefetch pass, length in bytes
+struct stream_read{
+	uint32_t address;
+	void *buffer;
+	uint16_t length;
+	uint8_t voice;
+	uint8_t gen;
+	uint32_t end;
+};
+
+//blocking read, used for the directory only
+typedef void (*stream_read_fn_t)(uint32_t address, void *buffer, uint32_t length);
+//starts the reads in order and calls stream_read_done() as each one completes
+typedef void (*stream_batch_fn_t)(const struct stream_read *reads, int count);
+
+/****** FUNCTION PROTOTYPES  ****/
+int stream_attach( stream_read_fn_t read, stream_batch_fn_t batch );
+const struct stream_sample *stream_sample_for_note( uint8_t note );
+void stream_voice_start( int voice, const struct stream_sample *sample, uint32_t frame );
+void stream_voice_stop( int voice );
+void stream_stop_all( void );
+bool stream_render( int voice, int32_t *mix, int count, uint32_t step, int32_t gain, int32_t gain_step );
+void stream_prefetch( void );
+void stream_read_done( void );
+uint32_t stream_underruns( void );
+
+#endif /* STREAM_H_INCLUDED */
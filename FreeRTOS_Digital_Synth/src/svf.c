@@ -0,0 +1,152 @@
+/*************************************************************************************************
+                                    --STATE VARIABLE FILTER--
+
+	low  += f * band
+	high  = in - low - q * band
+	band += f * high
+
+	The coefficients are only recomputed when a parameter changes, at control rate. The
+	frequency coefficient then ramps to its new value across the next call, one add a
+	sample; the damping limit takes the larger of the two ends so the whole ramp is stable.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "svf.h"
+#include "conf_synth.h"
+#include "recip.h"
+#include "ramp.h"
+
+
+/**********  DEFINE  ************/
+#define SVF_STATE_MAX			(	32767	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int32_t svf_clamp( int32_t x );
+static void svf_limit_q( struct svf *filter );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void svf_init( struct svf *filter )
+{
+	filter->low = 0;
+	filter->band = 0;
+	filter->mode = SVF_OFF;
+	filter->f = 0;
+	filter->q_set = SVF_Q_MAX;
+	svf_set_cutoff(filter, SVF_MAX_INC);
+	filter->f = filter->f_to;
+	svf_set_resonance(filter, 0);
+}
+
+bool svf_idle( const struct svf *filter )
+{
+	//a silent block leaves an off or empty filter as it is, and silent
+	return (filter->mode == SVF_OFF) || ((filter->low | filter->band) == 0);
+}
+
+void svf_set_cutoff( struct svf *filter, uint32_t cutoff_inc )
+{
+	//f = 2 sin(pi fc / fs), sine from its third order Taylor series (within 0.1% up to fs/6)
+	int32_t x;
+	int32_t x3;
+
+	if(cutoff_inc > SVF_MAX_INC) cutoff_inc = SVF_MAX_INC;
+
+	x = (int32_t) (((cutoff_inc >> 17) * SVF_PI_Q15) >> 15);
+	x3 = (((x * x) >> 15) * x) >> 15;
+
+	filter->f_to = 2 * (x - recip_div(x3, 6));
+	svf_limit_q(filter);
+}
+
+void svf_set_resonance( struct svf *filter, uint8_t resonance )
+{
+	//MIDI range 0..127 maps damping from 1.414 down to 0.1
+	if(resonance > 127) resonance = 127;
+
+	filter->q_set = SVF_Q_MAX - (((SVF_Q_MAX - SVF_Q_MIN) * resonance) / 127);
+	svf_limit_q(filter);
+}
+
+static void svf_limit_q( struct svf *filter )
+{
+	//the loop is only stable while q < 2 - f, for f anywhere along its ramp
+	int32_t f = (filter->f > filter->f_to) ? filter->f : filter->f_to;
+	int32_t limit = (2l << SVF_Q_SHIFT) - (f >> (SVF_F_SHIFT - SVF_Q_SHIFT)) - 1;
+
+	filter->q = (filter->q_set < limit) ? filter->q_set : limit;
+}
+
+SYNTH_RAM_CODE static int32_t svf_clamp( int32_t x )
+{
+	//branch-free clamp to +-SVF_STATE_MAX, keeps the coefficient products within 32 bits
+	int32_t over = x - SVF_STATE_MAX;
+	int32_t under;
+
+	x -= over & ~(over >> 31);
+	under = x + SVF_STATE_MAX;
+	x -= under & (under >> 31);
+
+	return x;
+}
+
+SYNTH_RAM_CODE void svf_process( struct svf *filter, int32_t *buffer, int count )
+{
+	//filters the buffer in place
+	int i;
+	int32_t low = filter->low;
+	int32_t band = filter->band;
+	int32_t high;
+	int32_t f = filter->f;
+	int32_t f_step;
+	int32_t q = filter->q;
+
+	if(filter->mode == SVF_OFF) return;
+
+	f_step = ramp_begin(&f, filter->f_to);
+	for(i=0; i<count; i++)
+	{
+		low = svf_clamp(low + ((f * band) >> SVF_F_SHIFT));
+		high = svf_clamp(buffer[i] - low - ((q * band) >> SVF_Q_SHIFT));
+		band = svf_clamp(band + ((f * high) >> SVF_F_SHIFT));
+
+		if(filter->mode == SVF_LOWPASS) buffer[i] = low;
+		else if(filter->mode == SVF_BANDPASS) buffer[i] = band;
+		else buffer[i] = high;
+		f += f_step;
+	}
+
+	filter->low = low;
+	filter->band = band;
+	filter->f = f;
+}
+
+SYNTH_RAM_CODE void svf_band_add( struct svf *filter, const int32_t *in, int32_t *out, int32_t gain, int count )
+{
+	//the same step as a bandpass, its output times gain (Q15) added to out and the input left
+	//as it is, for filters in parallel on one signal; the mode is not looked at
+	int i;
+	int32_t low = filter->low;
+	int32_t band = filter->band;
+	int32_t high;
+	int32_t f = filter->f;
+	int32_t f_step;
+	int32_t q = filter->q;
+
+	f_step = ramp_begin(&f, filter->f_to);
+	for(i=0; i<count; i++)
+	{
+		low = svf_clamp(low + ((f * band) >> SVF_F_SHIFT));
+		high = svf_clamp(in[i] - low - ((q * band) >> SVF_Q_SHIFT));
+		band = svf_clamp(band + ((f * high) >> SVF_F_SHIFT));
+
+		out[i] += (band * gain) >> 15;
+		f += f_step;
+	}
+
+	filter->low = low;
+	filter->band = band;
+	filter->f = f;
+}
@@ -0,0 +1,59 @@
+/*************************************************************************************************
+                                    --STATE VARIABLE FILTER--
+
+	Chamberlin state-variable filter in fixed point, one multiply per coefficient and no
+	soft-float. The frequency coefficient is derived from a phase increment, so cutoffs can
+	come straight from the note table. Cutoff is clamped to fs/6 and damping to 2 - f, which
+	keeps the loop stable. A new cutoff is reached over the next control period of samples,
+	see ramp.h.
+	Signals are the 12-bit DAC range around zero, states saturate at the Q15 range which
+	leaves 24 dB for resonance peaks.
+
+*************************************************************************************************/
+
+#ifndef SVF_H_INCLUDED
+#define SVF_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+//frequency coefficient Q15, damping Q14 (1.414 = flat Butterworth response, 0.1 = peaky)
+#define SVF_F_SHIFT				(	15	)
+#define SVF_Q_SHIFT				(	14	)
+#define SVF_Q_MAX				(	23170l	)
+#define SVF_Q_MIN				(	(1l << SVF_Q_SHIFT) / 10	)
+
+//highest usable cutoff as a phase increment, fs/6
+#define SVF_MAX_INC				(	0xFFFFFFFFul / 6	)
+
+//pi in Q15
+#define SVF_PI_Q15				(	102944ul	)
+
+/********   TYPE DEFS  **********/
+enum svf_mode{
+	SVF_OFF,
+	SVF_LOWPASS,
+	SVF_BANDPASS,
+	SVF_HIGHPASS
+};
+
+struct svf{
+	int32_t low;
+	int32_t band;
+	int32_t f;
+	int32_t f_to;			//the last cutoff set, f ramps to it
+	int32_t q;
+	int32_t q_set;
+	uint8_t mode;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void svf_init( struct svf *filter );
+void svf_set_cutoff( struct svf *filter, uint32_t cutoff_inc );
+void svf_set_resonance( struct svf *filter, uint8_t resonance );
+void svf_process( struct svf *filter, int32_t *buffer, int count );
+void svf_band_add( struct svf *filter, const int32_t *in, int32_t *out, int32_t gain, int count );
+bool svf_idle( const struct svf *filter );
+
+#endif /* SVF_H_INCLUDED */
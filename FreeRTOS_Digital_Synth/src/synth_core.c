@@ -0,0 +1,70 @@
+/*************************************************************************************************
+                                         --SYNTH CORE--
+
+	A block is timed from before its input is taken to after the stream's next reads are
+	issued, so the figures and the governor's load cover everything the render task spends
+	on it; the output's submit is inside, its conversion is part of the budget too.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "synth_core.h"
+#include "synth_engine.h"
+#include "stream.h"
+#include "audio_stats.h"
+
+
+/*******   GLOBAL VARS  *********/
+static const struct synth_hal *core_hal;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void synth_core_init( const struct synth_hal *hal )
+{
+	//the engine itself is set up with synth_init(), the stats with audio_stats_init(); set up
+	//first, the core also times synth_init()'s tables
+	core_hal = hal;
+	synth_set_rate_timer(hal->cycles);
+}
+
+const struct synth_hal *synth_core_hal( void )
+{
+	return core_hal;
+}
+
+uint16_t synth_core_block( uint16_t *block, uint16_t *frame )
+{
+	//renders one block into 'block' and submits it as 'frame' when given one; returns the
+	//load in per mille of the block period, 0 untimed
+	uint32_t start = 0;
+	uint32_t cycles;
+	uint16_t load;
+
+	if(core_hal->cycles != NULL) start = core_hal->cycles();
+#if SYNTH_DEADLINE
+	if((core_hal->cycles != NULL) && (core_hal->deadline != NULL))
+	{
+		synth_set_deadline(core_hal->cycles, core_hal->deadline() - (audio_stats_budget() * SYNTH_DEADLINE_RESERVE) / 1000);
+	}
+#endif
+
+#if SYNTH_AUDIO_INPUT
+	if(core_hal->input != NULL) synth_set_input(core_hal->input());
+#endif
+	synth_render_block(block);
+	if((frame != NULL) && (core_hal->submit != NULL)) core_hal->submit(frame, block);
+	stream_prefetch();
+
+	if(core_hal->cycles == NULL) return 0;
+
+#if SYNTH_DEADLINE
+	if(synth_render_late()) audio_stats_late();
+#endif
+	cycles = core_hal->cycles() - start;
+	audio_stats_block(cycles);
+	load = audio_stats_load(cycles);
+	synth_governor_report(load);
+
+	return load;
+}
@@ -0,0 +1,55 @@
+/*************************************************************************************************
+                                         --SYNTH CORE--
+
+	The hardware-independent half of the synth, one block at a time: the engine (voices,
+	oscillators, mixer, the events queued with synth_post_event_at(), synth_engine.h) with
+	the MIDI parser in front of it, and the render accounting behind it. Its sources are the
+	ENGINE_SOURCES of tools/golden_check.py, none of which includes asf.h; whatever runs the
+	core supplies a struct synth_hal for the rest:
+
+		name	for the console
+		cycles	a free-running count for timing a block, at the rate audio_stats_init() was
+				given; NULL leaves blocks untimed and the load governor alone, which keeps a
+				render deterministic
+		input	the next block of input samples for synth_set_input() with SYNTH_AUDIO_INPUT;
+				NULL for no input
+		submit	hands a rendered block to the output as a frame of output words, as
+				struct audio_output's submit; NULL when the caller queues the block itself
+		deadline	the cycles count at which the block about to render starts to play,
+				from where the output is now; NULL, or no cycles, renders every block whole
+
+	main.c fills one from the TC4/TC5 cycle counter, audio_input.c and the audio_output
+	backend; tools/host_render.c and tools/host_bench.c fill theirs from the host.
+
+	With SYNTH_DEADLINE a block's work is in three tiers. The voices, the filter, shaper,
+	delay, DC blocker and limiter always run, they are the sound. The formant, chorus and
+	reverb are deferrable: once the render gets within SYNTH_DEADLINE_RESERVE of the
+	deadline the rest of the block goes without them, a colour effect pausing for a few
+	milliseconds instead of the whole block arriving late. Meters and the voice snapshot
+	come last and skip a late block altogether, their readers see the next one. Late
+	blocks are counted with audio_stats_late(); the governor still sees the load and cuts
+	voices if it stays high.
+
+*************************************************************************************************/
+
+#ifndef SYNTH_CORE_H_INCLUDED
+#define SYNTH_CORE_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/********   TYPE DEFS  **********/
+struct synth_hal{
+	const char *name;
+	uint32_t (*cycles)( void );
+	const int16_t *(*input)( void );
+	void (*submit)( uint16_t *frame, const uint16_t *samples );
+	uint32_t (*deadline)( void );
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void synth_core_init( const struct synth_hal *hal );
+const struct synth_hal *synth_core_hal( void );
+uint16_t synth_core_block( uint16_t *block, uint16_t *frame );
+
+#endif /* SYNTH_CORE_H_INCLUDED */
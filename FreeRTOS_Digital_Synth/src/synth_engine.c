@@ -0,0 +1,4760 @@
+/*************************************************************************************************
+                                       --SYNTH ENGINE--
+
+	Block renderer for the voice bank. Kept free of ASF and FreeRTOS calls so only the
+	output stage knows how frames reach the DAC. A block is split into control periods,
+	each one control tick followed by the audio of that period. Voices are rendered one
+	waveform batch at a time and one voice at a time across the period. Oscillators read
+	band-limited wavetables, the table octave is picked whenever a voice's increment changes.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "synth_engine.h"
+#include "stream.h"
+#include "pluck.h"
+#include "drum.h"
+#include "dac_codes.h"
+#include "simd.h"
+#include "recip.h"
+#include "ramp.h"
+#include "profile.h"
+#if SYNTH_USE_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+#if (BLEP_FRAC_BITS != 15)
+#  error "recip_q30() gives the polyBLEP reciprocal in Q15"
+#endif
+
+
+/********   TYPE DEFS  **********/
+//one voice's oscillator state for a render kernel, copied out of the voice bank per segment
+struct osc_run{
+	uint32_t phase;
+	uint32_t inc;
+	int32_t gain;
+	int32_t step;
+};
+
+
+/*******   GLOBAL VARS  *********/
+//voice state variables
+struct voice_bank voice_bank;
+
+//mix accumulator for one control period, signed around DAC_MIDSCALE
+static int32_t mix_buffer[SYNTH_OUTPUT_CHANNELS * SYNTH_CONTROL_PERIOD];
+#if SYNTH_STEREO
+//one voice before it is panned into the left and right halves of the mix
+static int32_t voice_buffer[SYNTH_CONTROL_PERIOD];
+#endif
+#if SYNTH_STEREO && SYNTH_USE_CMSIS_DSP && !SYNTH_MIX_ASM
+static q15_t mix_codes[SYNTH_CONTROL_PERIOD];
+#endif
+#if SYNTH_AUDIO_INPUT
+//external audio for the block being rendered and the control period's part of it
+static const int16_t *input_block;
+static const int16_t *input_period;
+#endif
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+//19-tap half-band decimator, Q10; the even taps are zero but the centre, which is one half,
+//so these are the odd ones from the centre out. Flat within 0.05 dB up to 0.7 of the output
+//Nyquist frequency, and whatever would fold back below that is down about 48 dB
+#define OS_TAPS					(	19	)
+#define OS_HISTORY				(	OS_TAPS - 1	)
+#define OS_SHIFT				(	10	)
+static const int16_t os_halfband[(OS_TAPS + 1) / 4] = { 319, -89, 37, -14, 3 };
+
+//oversampled voices: one voice at twice the rate, and per output channel the decimator's line,
+//its history followed by the segment; input samples the history still holds from the last
+//oversampled voice, decimated until they have passed through
+static int32_t os_voice[2 * SYNTH_CONTROL_PERIOD];
+static int32_t os_line[SYNTH_OUTPUT_CHANNELS][OS_HISTORY + 2 * SYNTH_CONTROL_PERIOD];
+static uint8_t os_tail;
+static bool os_fresh;
+#endif
+
+//Q8 gain from the mix to the DAC, the applied value follows the target at control rate
+static int32_t master_gain_target = SYNTH_MASTER_GAIN;
+static int32_t master_gain = SYNTH_MASTER_GAIN;
+
+#if SYNTH_DITHER
+//xorshift state of the dither, and the last quantization error of each output channel
+static uint32_t dither_random = 1;
+static int32_t dither_error[SYNTH_OUTPUT_CHANNELS];
+#endif
+
+#if SYNTH_DC_BLOCK
+//running mean of each output channel with DC_FRAC_BITS of fraction, and the shift that sets
+//the blocker's corner at the current rate
+static int32_t dc_level[SYNTH_OUTPUT_CHANNELS];
+static uint8_t dc_block_shift;
+#endif
+
+//MIDI events from the event task, single producer / single consumer, each with the render
+//time it is due at
+static struct midi_event event_queue[SYNTH_EVENT_QUEUE_SIZE];
+static uint32_t event_time[SYNTH_EVENT_QUEUE_SIZE];
+static volatile uint16_t event_head;
+static volatile uint16_t event_tail;
+static volatile uint16_t event_dropped;
+static volatile uint16_t event_peak;
+
+//how late the latest event was applied, in samples after its render time
+static volatile uint32_t event_late_max;
+
+//render time of the event being applied
+static uint32_t event_at;
+
+//MIDI realtime bytes straight from the RX interrupt, single producer / single consumer like
+//the event queue, applied in time order with it
+static uint8_t realtime_queue[SYNTH_REALTIME_QUEUE_SIZE];
+static uint32_t realtime_time[SYNTH_REALTIME_QUEUE_SIZE];
+static volatile uint16_t realtime_head;
+static volatile uint16_t realtime_tail;
+
+#if SYNTH_FAST_NOTE_ON
+//Note Ons straight from the RX interrupt, applied at the next control tick whatever their time
+static struct midi_event fast_queue[SYNTH_FAST_NOTE_QUEUE_SIZE];
+static volatile uint16_t fast_head;
+static volatile uint16_t fast_tail;
+#endif
+
+//tempo: the MIDI clock measuring it, the period in use in Q8 samples per clock, and the
+//internal clock standing in while no MIDI clock comes in, its next clock at render time
+//clock_next plus clock_frac/256; the tempo for other tasks in 1/100 BPM
+static struct midi_clock midi_clock;
+static uint32_t clock_period;
+static uint32_t clock_next;
+static uint8_t clock_frac;
+static uint32_t clock_timeout;
+static bool clock_free;
+static bool clock_running;
+static volatile uint32_t clock_tempo;
+static volatile bool clock_locked;
+
+//the arpeggiator, the flash pattern playing, and the clocks per delay repeat when the delay
+//follows the tempo
+static struct arp arp;
+static struct automation automation;
+static struct pattern_player pattern_player;
+static uint8_t delay_sync;
+
+//note lengths in clocks the tempo controllers step through, 1/4 down to 1/32 triplets for the
+//arpeggiator; free running first for LFO1 and the delay
+static const uint8_t arp_divisions[8] = { 24, 16, 12, 8, 6, 4, 3, 2 };
+static const uint8_t lfo_divisions[8] = { 0, 192, 96, 48, 24, 12, 6, 3 };
+static const uint8_t delay_divisions[8] = { 0, 36, 24, 18, 12, 8, 6, 3 };
+
+//ORGAN partials as multiples of the 16' pitch, in drawbar order, the Q12 gain of each drawbar
+//level, 3 dB a step, and the place of each drawbar's digit in SYNTH_DRAWBARS
+static const uint8_t drawbar_harmonic[ORGAN_DRAWBARS] = { 1, 3, 2, 4, 6, 8, 10, 12, 16 };
+static const int16_t drawbar_level[9] = { 0, 362, 512, 724, 1024, 1448, 2048, 2896, 4096 };
+static const uint32_t organ_digit[ORGAN_DRAWBARS] = { 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+
+//waveforms whose phase runs at the voice's increment, the ones a sub-oscillator can follow
+#define SUB_WAVES				(	~((1ul << SAMPLE) | (1ul << STREAM) | (1ul << PLUCK) | (1ul << ORGAN) | (1ul << DRUM) | (1ul << GRAIN))	)
+
+//waveforms a sounding voice can switch between on a program change, the others need a start
+#define SWAP_WAVES				(	~((1ul << SAMPLE) | (1ul << STREAM) | (1ul << PLUCK) | (1ul << DRUM) | (1ul << GRAIN))	)
+
+//Q12 1/sqrt(n) for the sum of n SUPERSAW oscillators
+static const int16_t unison_level[9] = { 0, 4096, 2896, 2365, 2048, 1832, 1672, 1548, 1448 };
+
+//patch state and voice group of every MIDI channel
+static struct synth_channel channels[SYNTH_MIDI_CHANNELS];
+
+//MPE lower zone: its master channel, and whether a channel is one of its members
+#define MPE_MASTER				(	0	)
+#if SYNTH_MPE_CHANNELS
+#define MPE_MEMBER(c)			(	((c) != MPE_MASTER) && ((c) <= SYNTH_MPE_CHANNELS)	)
+#else
+#define MPE_MEMBER(c)			(	false	)
+#endif
+
+//stamps the pressure messages, so a voice takes the latest of its poly and its channel pressure
+static uint32_t pressure_count;
+
+//voices whose key is up but which their channel's sustain pedal keeps sounding, by channel
+static uint32_t sustain_held[SYNTH_MIDI_CHANNELS][VOICE_MASK_WORDS];
+
+//each channel's notes whose voice is gated, so all notes off walks the channel's notes
+//rather than every voice; a bit can outlive its voice (a steal from another channel, a
+//route change), the allocator's note index is what decides
+static uint32_t held_notes[SYNTH_MIDI_CHANNELS][4];
+
+#if SYNTH_GOVERNOR
+//load governor: releasing voices marked to fade out within the next tick, the draft quality
+//switch and how many blocks the load has been back under the low mark
+static uint32_t voice_shed[VOICE_MASK_WORDS];
+static uint32_t governor_shed_count;
+static uint16_t governor_calm;
+static bool render_draft;
+#endif
+
+#if SYNTH_DEADLINE
+//this block's deadline for deferrable work on the core's cycle count, NULL for none; the
+//block drops that work from the period it is found past it
+static uint32_t (*deadline_cycles)( void );
+static uint32_t deadline_at;
+static bool render_deferring;
+static bool render_was_late;
+#endif
+
+//the core's cycle count that times a rebuild of the rate dependent tables, NULL for none
+static uint32_t (*rate_timer)( void );
+static uint32_t rate_cycles;
+
+#if SYNTH_VOICE_OVERFLOW
+//where the notes without a free voice go, and which of them are sounding there, one bit per
+//note of each channel
+static bool (*overflow_forward)( const struct midi_event *event );
+static uint32_t overflow_notes[SYNTH_MIDI_CHANNELS][4];
+#endif
+
+//copy of the channel patches for other tasks, republished by the renderer between blocks under
+//a sequence count, odd while it writes; the bits mark the channels changed since
+static struct synth_patch patch_published[SYNTH_MIDI_CHANNELS];
+static volatile uint32_t patch_sequence;
+static uint16_t patch_dirty;
+
+#if SYNTH_METERS
+//levels of the block being rendered, the last block's sums and the peaks held since a reader
+//last took them; only the renderer writes them, a reader asks for the holds to start over by
+//bumping level_taken
+static uint32_t output_peak[SYNTH_OUTPUT_CHANNELS];
+static uint32_t output_sum[SYNTH_OUTPUT_CHANNELS];
+static uint32_t voice_sum[SYNTH_MAX_VOICES];
+static uint16_t voice_peak[SYNTH_MAX_VOICES];
+static uint16_t voice_ticks[SYNTH_MAX_VOICES];
+static volatile uint32_t output_last[SYNTH_OUTPUT_CHANNELS];
+static volatile uint16_t output_hold[SYNTH_OUTPUT_CHANNELS];
+static volatile uint32_t voice_last[SYNTH_MAX_VOICES];
+static volatile uint16_t voice_last_ticks[SYNTH_MAX_VOICES];
+static volatile uint16_t voice_hold[SYNTH_MAX_VOICES];
+static volatile uint16_t block_peak;
+static volatile uint8_t level_taken;
+static uint8_t level_seen;
+static uint8_t voice_level_seen;
+#endif
+
+#if SYNTH_VOICE_SNAPSHOT
+//the voice table for other tasks, copied between blocks under a sequence count only when a
+//reader set snapshot_wanted
+static struct synth_snapshot snapshot_published;
+static volatile uint32_t snapshot_sequence;
+static volatile bool snapshot_wanted;
+#endif
+
+//controller map: per channel and controller the slot it drives, slot 0 drives nothing and
+//slot n < SYNTH_PARAM_COUNT is parameter n over its whole range. A request from another task
+//waits in cc_request until the next control tick, a learn in cc_learn for the next controller
+struct cc_slot{
+	uint8_t param;
+	uint8_t low;
+	uint8_t high;
+};
+
+struct cc_request{
+	int8_t channel;
+	uint8_t controller;
+	uint8_t param;
+	uint8_t low;
+	uint8_t high;
+};
+
+//per channel, the last MSB controller 0..31 and its value for the LSB that follows, and the
+//selected NRPN with its data entry MSB; CC_NRPN_NONE after an RPN or the null number
+struct cc_channel{
+	uint8_t msb_controller;
+	uint8_t msb_value;
+	uint16_t nrpn;
+	uint8_t data_msb;
+};
+
+#define CC_SLOTS				(	SYNTH_PARAM_COUNT + SYNTH_CC_SCALED_SLOTS	)
+#define CC_LSB_OFFSET			(	32	)
+#define CC_FINE_FULL			(	127 << 7	)
+#define CC_NRPN_NONE			(	0x3FFF	)
+
+static uint8_t cc_map[SYNTH_MIDI_CHANNELS][128];
+static struct cc_slot cc_slots[CC_SLOTS];
+static uint16_t cc_slot_refs[CC_SLOTS];		//map entries on each scaled slot
+static struct cc_request cc_request;
+static volatile bool cc_request_pending;
+static struct cc_request cc_learn;
+static struct cc_channel cc_channels[SYNTH_MIDI_CHANNELS];
+static uint8_t cc_learned_channel;
+static uint8_t cc_learned_controller;
+static uint8_t cc_learned_param;
+static volatile bool cc_learned_ready;
+
+//the controller number each parameter answers to on every channel after synth_init()
+static const uint8_t param_default_cc[SYNTH_PARAM_COUNT] = {
+	[SYNTH_PARAM_MOD_WHEEL] = MIDI_CC_MOD_WHEEL,
+	[SYNTH_PARAM_PORTAMENTO_TIME] = MIDI_CC_PORTAMENTO_TIME,
+	[SYNTH_PARAM_VOLUME] = MIDI_CC_VOLUME,
+	[SYNTH_PARAM_PAN] = MIDI_CC_PAN,
+	[SYNTH_PARAM_DELAY_TIME] = MIDI_CC_DELAY_TIME,
+	[SYNTH_PARAM_DELAY_FEEDBACK] = MIDI_CC_DELAY_FEEDBACK,
+	[SYNTH_PARAM_SHAPER_DRIVE] = MIDI_CC_SHAPER_DRIVE,
+	[SYNTH_PARAM_SHAPER_CURVE] = MIDI_CC_SHAPER_CURVE,
+	[SYNTH_PARAM_CRUSH_BITS] = MIDI_CC_CRUSH_BITS,
+	[SYNTH_PARAM_CRUSH_HOLD] = MIDI_CC_CRUSH_HOLD,
+	[SYNTH_PARAM_LIMITER] = MIDI_CC_LIMITER,
+	[SYNTH_PARAM_OSC_QUALITY] = MIDI_CC_OSC_QUALITY,
+	[SYNTH_PARAM_POLYPHONY] = MIDI_CC_POLYPHONY,
+	[SYNTH_PARAM_SUSTAIN] = MIDI_CC_SUSTAIN,
+	[SYNTH_PARAM_PORTAMENTO] = MIDI_CC_PORTAMENTO,
+	[SYNTH_PARAM_PULSE_WIDTH] = MIDI_CC_PULSE_WIDTH,
+	[SYNTH_PARAM_RESONANCE] = MIDI_CC_RESONANCE,
+	[SYNTH_PARAM_CUTOFF] = MIDI_CC_CUTOFF,
+	[SYNTH_PARAM_FM_RATIO] = MIDI_CC_FM_RATIO,
+	[SYNTH_PARAM_FM_INDEX] = MIDI_CC_FM_INDEX,
+	[SYNTH_PARAM_NOISE_HOLD] = MIDI_CC_NOISE_HOLD,
+	[SYNTH_PARAM_SAMPLE_START] = MIDI_CC_SAMPLE_START,
+	[SYNTH_PARAM_FILTER_MODE] = MIDI_CC_FILTER_MODE,
+	[SYNTH_PARAM_DELAY_MIX] = MIDI_CC_DELAY_MIX,
+	[SYNTH_PARAM_CHORUS_MIX] = MIDI_CC_CHORUS_MIX,
+	[SYNTH_PARAM_CHORUS_DEPTH] = MIDI_CC_CHORUS_DEPTH,
+	[SYNTH_PARAM_ARP_MODE] = MIDI_CC_ARP_MODE,
+	[SYNTH_PARAM_ARP_RATE] = MIDI_CC_ARP_RATE,
+	[SYNTH_PARAM_ARP_OCTAVES] = MIDI_CC_ARP_OCTAVES,
+	[SYNTH_PARAM_LFO_SYNC] = MIDI_CC_LFO_SYNC,
+	[SYNTH_PARAM_PATTERN] = MIDI_CC_PATTERN,
+	[SYNTH_PARAM_DRAWBAR_1] = MIDI_CC_DRAWBAR_1,
+	[SYNTH_PARAM_DRAWBAR_2] = MIDI_CC_DRAWBAR_1 + 1,
+	[SYNTH_PARAM_DRAWBAR_3] = MIDI_CC_DRAWBAR_1 + 2,
+	[SYNTH_PARAM_DRAWBAR_4] = MIDI_CC_DRAWBAR_1 + 3,
+	[SYNTH_PARAM_DRAWBAR_5] = MIDI_CC_DRAWBAR_1 + 4,
+	[SYNTH_PARAM_DRAWBAR_6] = MIDI_CC_DRAWBAR_1 + 5,
+	[SYNTH_PARAM_DRAWBAR_7] = MIDI_CC_DRAWBAR_1 + 6,
+	[SYNTH_PARAM_DRAWBAR_8] = MIDI_CC_DRAWBAR_1 + 7,
+	[SYNTH_PARAM_DRAWBAR_9] = MIDI_CC_DRAWBAR_1 + 8,
+	[SYNTH_PARAM_UNISON_DETUNE] = MIDI_CC_UNISON_DETUNE,
+	[SYNTH_PARAM_SUB_LEVEL] = MIDI_CC_SUB_LEVEL,
+	[SYNTH_PARAM_SUB_OCTAVE] = MIDI_CC_SUB_OCTAVE,
+	[SYNTH_PARAM_DELAY_SYNC] = MIDI_CC_DELAY_SYNC,
+	[SYNTH_PARAM_VOWEL] = MIDI_CC_VOWEL,
+	[SYNTH_PARAM_FORMANT_MIX] = MIDI_CC_FORMANT_MIX,
+	[SYNTH_PARAM_REVERB_MIX] = MIDI_CC_REVERB_MIX,
+	[SYNTH_PARAM_REVERB_SIZE] = MIDI_CC_REVERB_SIZE,
+	[SYNTH_PARAM_GRAIN_SIZE] = MIDI_CC_GRAIN_SIZE,
+	[SYNTH_PARAM_GRAIN_DENSITY] = MIDI_CC_GRAIN_DENSITY,
+	[SYNTH_PARAM_GRAIN_SPRAY] = MIDI_CC_GRAIN_SPRAY,
+	[SYNTH_PARAM_AUTOMATION] = MIDI_CC_AUTOMATION,
+};
+
+//patches the program changes recall, an entry may be NULL
+static const struct synth_patch *const *preset_table;
+static int preset_count;
+
+//velocity to amplitude table used by note-on
+static const uint16_t *velocity_curve = velocity_curves[SYNTH_VELOCITY_CURVE];
+
+//amplitude envelope shared by all voices
+static struct env_params env_params;
+
+//resonant filter on the master mix, the cutoff is kept as the phase increment it was set with
+//and the modulation offset last applied to it
+static struct svf master_filter;
+#if SYNTH_STEREO
+static struct svf master_filter_right;
+#endif
+static uint32_t filter_cutoff_inc;
+static int32_t filter_cutoff_mod;
+
+//CC 74 glides: the last value it set in 1/256 semitone, -1 after synth_set_filter(), and the offset in 1/256
+//semitone still to go from the old cutoff to the new one
+static int32_t filter_cutoff_cc;
+static int32_t filter_cutoff_glide;
+
+#if SYNTH_DELAY
+//post-mix delay of each output channel, and the settings the CCs change one at a time
+SYNTH_AUDIO_BUFFER static int16_t delay_lines[SYNTH_OUTPUT_CHANNELS][SYNTH_DELAY_FRAMES];
+static struct delay master_delay[SYNTH_OUTPUT_CHANNELS];
+static uint32_t delay_time;
+static uint8_t delay_feedback;
+static uint8_t delay_mix;
+#endif
+
+#if SYNTH_SHAPER
+//waveshaper and crusher of each output channel, the settings the CCs change one at a time
+static struct shaper master_shaper[SYNTH_OUTPUT_CHANNELS];
+static enum shaper_curve shaper_curve;
+static int32_t shaper_drive;
+static uint8_t shaper_bits;
+static uint8_t shaper_hold;
+#endif
+
+#if SYNTH_LIMITER
+static struct limiter master_limiter[SYNTH_OUTPUT_CHANNELS];
+#endif
+
+#if SYNTH_CHORUS
+//chorus of each output channel, the right LFO a quarter period ahead for width; times are
+//kept in us so a sample rate change can re-derive the taps
+SYNTH_AUDIO_BUFFER static int16_t chorus_lines[SYNTH_OUTPUT_CHANNELS][SYNTH_CHORUS_FRAMES];
+static struct chorus master_chorus[SYNTH_OUTPUT_CHANNELS];
+static uint32_t chorus_delay_us;
+static uint32_t chorus_depth_us;
+static uint32_t chorus_rate_chz;
+static uint8_t chorus_feedback;
+static uint8_t chorus_mix;
+#endif
+
+#if SYNTH_FORMANT
+//vowel filter of each output channel; the position glides to the CC's target at control rate
+static struct formant master_formant[SYNTH_OUTPUT_CHANNELS];
+static int32_t formant_position;
+static int32_t formant_target;
+static uint8_t formant_mix;
+#endif
+
+#if SYNTH_REVERB
+//reverb of each output channel, the right one's lines a little shorter so the tails differ
+SYNTH_AUDIO_BUFFER static int16_t reverb_lines[SYNTH_OUTPUT_CHANNELS][SYNTH_REVERB_FRAMES];
+static struct reverb master_reverb[SYNTH_OUTPUT_CHANNELS];
+static uint8_t reverb_size;
+static uint8_t reverb_damp;
+static uint8_t reverb_mix;
+#endif
+
+//envelope times as set, the rates are re-derived from them when the sample rate changes
+static uint32_t env_attack_ms;
+static uint32_t env_decay_ms;
+static uint8_t env_sustain_percent;
+static uint32_t env_release_ms;
+
+//sample rate the tables are derived for, and the one asked for by synth_set_sample_rate()
+static uint32_t sample_rate = SYNTH_SAMPLE_RATE;
+static volatile uint32_t sample_rate_request = SYNTH_SAMPLE_RATE;
+
+//render time of the first sample of the next block, counts samples since synth_init()
+static volatile uint32_t render_time;
+
+//samples left in the current control period while events are applied, a new note gets its
+//first envelope ramp over just that many samples
+static int period_left = SYNTH_CONTROL_PERIOD;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static void voice_activate( int voice );
+static void voice_deactivate( int voice );
+static void voice_batch_add( int voice, enum wave_type type );
+static void voice_batch_remove( int voice );
+static enum wave_type wave_playable( enum wave_type type );
+static void voice_osc2( int voice, const struct synth_channel *ch );
+static void wave_swap_start( uint8_t channel );
+static void voice_wave_swap( int voice );
+static void voice_reset( void );
+static void voice_retune( int voice );
+static uint32_t osc2_increment( enum wave_type type, uint32_t inc, uint8_t ratio );
+static void channels_init( void );
+static void sample_rate_apply( uint32_t rate );
+static void filter_set_cutoff( uint32_t cutoff_inc );
+static void filter_update( void );
+static void formant_update( void );
+static void grain_update( void );
+static void voice_modulate( int voice );
+static void voice_glide_start( int voice, struct synth_channel *ch, uint8_t note );
+static int note_start( uint8_t channel, uint8_t member, uint8_t note, uint8_t velocity );
+static int16_t pressure_level( uint8_t value );
+#if SYNTH_MPE_CHANNELS
+static void mpe_member_event( uint8_t member, const struct midi_event *event );
+static bool mpe_voice_valid( uint8_t member, int voice );
+#endif
+static void control_tick( uint32_t now );
+static void clock_init( void );
+static void clock_event( uint8_t status );
+static void tuning_event( const struct midi_event *event );
+static void clock_watch( uint32_t now );
+static void clock_internal( void );
+static void clock_step( void );
+static void clock_set_period( uint32_t period );
+static void arp_update( enum arp_mode mode, uint8_t division, uint8_t octaves );
+static void pattern_select( int number );
+static void delay_follow( void );
+static void cc_init( void );
+static void cc_service( void );
+static void cc_assign( uint8_t channel, uint8_t controller, enum synth_param param, uint8_t low, uint8_t high );
+static void param_apply( uint8_t channel, enum synth_param param, uint16_t fine );
+static bool cc_fixed( uint8_t channel, uint8_t controller, uint8_t value );
+static int32_t smooth_step( int32_t value, int32_t target );
+static void channels_smooth( void );
+static int32_t sub_target( const struct synth_channel *ch );
+static int16_t morph_position( uint8_t value );
+static void patch_publish( void );
+#if SYNTH_METERS
+static void levels_publish( void );
+static uint16_t level_sqrt( uint32_t x );
+#endif
+#if SYNTH_VOICE_SNAPSHOT
+static void snapshot_publish( void );
+#endif
+static int apply_events( uint32_t now, uint32_t limit );
+static void envelope_control( void );
+static void envelope_ramp( int voice, int count );
+static void drum_hit( int voice );
+static void render_segment( int32_t *mix, int count );
+static void render_sub( int32_t *mix, int count );
+static void mix_clear( int32_t *mix );
+static void mix_output( int32_t *mix, uint16_t *out );
+static void mix_channel_output( int32_t *mix, int channel, struct svf *filter, uint16_t *out, int stride );
+static bool output_idle( void );
+static bool effects_deferred( void );
+static void output_skip( uint16_t *out );
+#if SYNTH_DITHER
+static void mix_dither( int32_t *mix, int channel );
+#endif
+#if SYNTH_DC_BLOCK
+static void mix_dc_block( int32_t *mix, int channel );
+static void dc_block_set_rate( uint32_t rate );
+#endif
+#if SYNTH_AUDIO_INPUT
+static void mix_input( int32_t *mix );
+#endif
+static int32_t *voice_out_begin( int32_t *mix, int count );
+static void voice_out_end( int voice, int32_t *mix, int32_t *out, int count );
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+static int32_t *voice_os_begin( int count );
+static void voice_os_end( int voice, int32_t *out, int count );
+static void os_decimate( int32_t *mix, int count );
+#endif
+static void voice_pan( int voice, uint8_t pan, bool ramp );
+#if SYNTH_STEREO
+static void voice_pan_ramp( int voice );
+#endif
+static void channel_volume( uint8_t channel, uint32_t fine );
+#if SYNTH_WAVETABLES
+static void render_batch( int type, int32_t *mix, int count );
+static void render_morph_batch( int type, int32_t *mix, int count );
+#else
+static void render_tri_batch( int type, int32_t *mix, int count );
+#endif
+static void render_blep_batch( int type, int32_t *mix, int count );
+static void render_fm_batch( int type, int32_t *mix, int count );
+static void render_sine_batch( int type, int32_t *mix, int count );
+static void render_noise_batch( int type, int32_t *mix, int count );
+static void render_sample_batch( int type, int32_t *mix, int count );
+static void render_stream_batch( int type, int32_t *mix, int count );
+static void render_pluck_batch( int type, int32_t *mix, int count );
+static void render_drum_batch( int type, int32_t *mix, int count );
+static void render_grain_batch( int type, int32_t *mix, int count );
+static void render_organ_batch( int type, int32_t *mix, int count );
+static void render_sync_batch( int type, int32_t *mix, int count );
+static void render_ring_batch( int type, int32_t *mix, int count );
+static void render_supersaw_batch( int type, int32_t *mix, int count );
+static void voice_sample_step( int voice );
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_BANDLIMITED
+static int32_t polyblep( uint32_t phase, uint32_t inc, int shift, uint32_t recip );
+#endif
+static uint8_t voice_osc_quality( int voice );
+
+//renders the whole segment of every voice in one waveform's batch
+typedef void (*batch_render_t)( int type, int32_t *mix, int count );
+
+//one renderer per waveform, without the tables SQUARE, SAW and MORPH are never batched,
+//note-on moves them to the PolyBLEP types
+static const batch_render_t batch_render[WAVE_TYPE_COUNT] = {
+#if SYNTH_WAVETABLES
+	[SQUARE] = render_batch,
+	[SAW] = render_batch,
+	[TRI] = render_batch,
+	[MORPH] = render_morph_batch,
+#else
+	[TRI] = render_tri_batch,
+#endif
+	[SQUARE_BLEP] = render_blep_batch,
+	[SAW_BLEP] = render_blep_batch,
+	[FM] = render_fm_batch,
+	[SINE] = render_sine_batch,
+	[NOISE] = render_noise_batch,
+	[SAMPLE] = render_sample_batch,
+	[STREAM] = render_stream_batch,
+	[PLUCK] = render_pluck_batch,
+	[ORGAN] = render_organ_batch,
+	[SYNC] = render_sync_batch,
+	[RING] = render_ring_batch,
+	[SUPERSAW] = render_supersaw_batch,
+	[DRUM] = render_drum_batch,
+	[GRAIN] = render_grain_batch,
+};
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void synth_init( void )
+{
+#if SYNTH_DELAY || SYNTH_CHORUS || SYNTH_SHAPER || SYNTH_LIMITER || SYNTH_FORMANT || SYNTH_REVERB
+	int c;
+#endif
+	uint32_t start;
+
+	voice_reset();
+	channels_init();
+	cc_init();
+
+	sample_rate = sample_rate_request;
+	start = (rate_timer != NULL) ? rate_timer() : 0;
+	note_table_set_rate(sample_rate);
+	drum_set_rate(sample_rate);
+	grain_update();
+#if SYNTH_TUNING
+	note_tuning_reset();
+#endif
+
+	synth_set_envelope(SYNTH_ENV_ATTACK_MS, SYNTH_ENV_DECAY_MS, SYNTH_ENV_SUSTAIN_PERCENT, SYNTH_ENV_RELEASE_MS);
+	if(rate_timer != NULL) rate_cycles = rate_timer() - start;
+
+	mod_init(sample_rate);
+#if SYNTH_MPE_CHANNELS
+	mod_set_route(SYNTH_MOD_ROUTES - 1, MOD_SRC_TIMBRE, MOD_DST_PULSE_WIDTH, SYNTH_MPE_TIMBRE_DEPTH);
+#endif
+#if SYNTH_PRESSURE_AMP_DEPTH
+	mod_set_route(SYNTH_MOD_ROUTES - 2, MOD_SRC_PRESSURE, MOD_DST_AMP, SYNTH_PRESSURE_AMP_DEPTH);
+#endif
+#if SYNTH_PRESSURE_CUTOFF_DEPTH
+	mod_set_route(SYNTH_MOD_ROUTES - 3, MOD_SRC_PRESSURE, MOD_DST_CUTOFF, SYNTH_PRESSURE_CUTOFF_DEPTH);
+#endif
+#if SYNTH_DC_BLOCK
+	dc_block_set_rate(sample_rate);
+#endif
+	filter_cutoff_mod = 0;
+	filter_cutoff_cc = -1;
+	filter_cutoff_glide = 0;
+	svf_init(&master_filter);
+#if SYNTH_STEREO
+	svf_init(&master_filter_right);
+#endif
+	synth_set_filter(SYNTH_FILTER_MODE, SYNTH_FILTER_CUTOFF_HZ, SYNTH_FILTER_RESONANCE);
+
+#if SYNTH_SHAPER
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) shaper_init(&master_shaper[c]);
+#endif
+	synth_set_shaper((enum shaper_curve) SYNTH_SHAPER_CURVE, SYNTH_SHAPER_DRIVE, SYNTH_SHAPER_BITS, SYNTH_SHAPER_HOLD);
+
+#if SYNTH_DELAY
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) delay_init(&master_delay[c], delay_lines[c], SYNTH_DELAY_FRAMES);
+#endif
+	synth_set_delay(SYNTH_DELAY_TIME, SYNTH_DELAY_FEEDBACK, SYNTH_DELAY_MIX);
+
+#if SYNTH_CHORUS
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) chorus_init(&master_chorus[c], chorus_lines[c], SYNTH_CHORUS_FRAMES, (uint32_t) c << 30);
+#endif
+	synth_set_chorus(SYNTH_CHORUS_DELAY_US, SYNTH_CHORUS_DEPTH_US, SYNTH_CHORUS_RATE_CHZ, SYNTH_CHORUS_FEEDBACK, SYNTH_CHORUS_MIX);
+
+#if SYNTH_FORMANT
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) formant_init(&master_formant[c]);
+#endif
+	synth_set_formant(SYNTH_FORMANT_VOWEL, SYNTH_FORMANT_MIX);
+
+#if SYNTH_REVERB
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) reverb_init(&master_reverb[c], reverb_lines[c], SYNTH_REVERB_FRAMES, (uint32_t) c * (SYNTH_REVERB_FRAMES / 64));
+#endif
+	synth_set_reverb(SYNTH_REVERB_SIZE, SYNTH_REVERB_DAMP, SYNTH_REVERB_MIX);
+
+#if SYNTH_LIMITER
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) limiter_init(&master_limiter[c], SYNTH_LIMITER_RELEASE_SHIFT);
+#endif
+	synth_set_limiter(SYNTH_LIMITER_THRESHOLD);
+
+	clock_init();
+}
+
+static void channels_init( void )
+{
+	int c;
+	int d;
+
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++)
+	{
+		channels[c].patch.wave = (c == SYNTH_DRUM_CHANNEL) ? DRUM : SQUARE;
+		channels[c].bend_fine = 0;
+		channels[c].sustain = false;
+		channels[c].group = (int8_t) (c % SYNTH_VOICE_GROUPS);
+		channels[c].patch.portamento = false;
+		channels[c].patch.glide_ms = SYNTH_PORTAMENTO_MS;
+		channels[c].last_note = VOICE_NONE;
+		channels[c].patch.pulse_width = 0;
+		channels[c].patch.fm_ratio = SYNTH_FM_RATIO;
+		channels[c].patch.fm_index = SYNTH_FM_INDEX;
+		channels[c].patch.noise_hold = SYNTH_NOISE_HOLD;
+		channels[c].patch.sample_start = 0;
+		channels[c].patch.pan = PAN_CENTER;
+		channels[c].patch.quality = SYNTH_OSC_QUALITY;
+		channels[c].patch.sub = (SYNTH_SUB_LEVEL & SUB_LEVEL_MASK) | (SYNTH_SUB_TWO_OCTAVES ? SUB_TWO_OCTAVES : 0);
+		channels[c].sub_gain = sub_target(&channels[c]);
+		channels[c].morph_target = morph_position(SYNTH_MORPH_POSITION);
+		channels[c].morph = channels[c].morph_target;
+		channels[c].pulse_width = 0;
+		channels[c].volume = MOD_UNITY;
+		channels[c].volume_target = MOD_UNITY;
+		channels[c].pressure = 0;
+		channels[c].pressure_at = 0;
+		channels[c].timbre = 0;
+		channels[c].voice = VOICE_NONE;
+		for(d=0; d<ORGAN_DRAWBARS; d++)
+		{
+			channels[c].drawbar[d] = 0;
+			synth_set_drawbar(c, d, (uint8_t) ((SYNTH_DRAWBARS / organ_digit[d]) % 10));
+		}
+		for(d=0; d<ORGAN_DRAWBARS; d++) channels[c].drawbar_gain[d] = channels[c].drawbar_target[d];
+		channels[c].unison_spread = SYNTH_UNISON_DETUNE * UNISON_SPREAD_STEP;
+		channels[c].grain_size = SYNTH_GRAIN_SIZE;
+		channels[c].grain_density = SYNTH_GRAIN_DENSITY;
+		channels[c].grain_spray = SYNTH_GRAIN_SPRAY;
+	}
+	patch_dirty = 0xFFFF;
+	patch_publish();
+}
+
+static void voice_reset( void )
+{
+	int j;
+	int c;
+
+	for(j=0; j<SYNTH_MAX_VOICES; j++)
+	{
+		voice_bank.enable[j] = false;
+		voice_bank.gate[j] = false;
+		voice_bank.env_stage[j] = ENV_IDLE;
+		voice_bank.env_level[j] = 0;
+		voice_bank.pulse_width[j] = PHASE_HALF_CYCLE;
+		voice_bank.mod_pitch[j] = 0;
+		voice_bank.mod_amp[j] = MOD_UNITY;
+		voice_bank.mod_amp_next[j] = MOD_UNITY;
+		voice_bank.glide[j] = 0;
+		voice_bank.swap_fade[j] = 0;
+		//a different non-zero seed per slot so voices are not correlated
+		voice_bank.noise[j] = 0x2545F491ul + 0x9E3779B9ul * (uint32_t) j;
+		if(voice_bank.noise[j] == 0) voice_bank.noise[j] = 1;
+	}
+	voice_bank.active_count = 0;
+	for(j=0; j<=WAVE_TYPE_COUNT; j++) voice_bank.batch_start[j] = 0;
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++)
+	{
+		for(j=0; j<VOICE_MASK_WORDS; j++) sustain_held[c][j] = 0;
+		for(j=0; j<4; j++) held_notes[c][j] = 0;
+	}
+#if SYNTH_GOVERNOR
+	for(j=0; j<VOICE_MASK_WORDS; j++) voice_shed[j] = 0;
+#endif
+
+	stream_stop_all();
+	pluck_init();
+	grain_init();
+	voice_alloc_init();
+}
+
+void synth_set_filter( uint8_t mode, uint32_t cutoff_hz, uint8_t resonance )
+{
+	//cutoff is turned into a phase increment, the filter clamps it to its stable range
+	master_filter.mode = (mode > SVF_HIGHPASS) ? SVF_OFF : mode;
+	filter_cutoff_cc = -1;
+	filter_cutoff_glide = 0;
+	filter_set_cutoff((uint32_t) (((uint64_t) cutoff_hz << 32) / sample_rate));
+	svf_set_resonance(&master_filter, resonance);
+}
+
+void synth_set_delay( uint32_t time, uint8_t feedback, uint8_t mix )
+{
+	//time in samples up to SYNTH_DELAY_FRAMES - 1, feedback and mix 0..127 (127 just under unity)
+#if SYNTH_DELAY
+	int c;
+
+	if(feedback > 127) feedback = 127;
+	if(mix > 127) mix = 127;
+	delay_time = time;
+	delay_feedback = feedback;
+	delay_mix = mix;
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) delay_set(&master_delay[c], time, feedback << 1, mix << 1);
+#endif
+}
+
+void synth_set_shaper( enum shaper_curve curve, int32_t drive, uint8_t bits, uint8_t hold )
+{
+	//drive Q8 (256 = unity) up to 16x, bits 1..12, each sample held for hold periods
+#if SYNTH_SHAPER
+	int c;
+
+	shaper_curve = curve;
+	shaper_drive = drive;
+	shaper_bits = bits;
+	shaper_hold = hold;
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) shaper_set(&master_shaper[c], curve, drive, bits, hold);
+#endif
+}
+
+void synth_set_limiter( int32_t threshold )
+{
+	//peak level in DAC codes from the midscale, 0 turns the limiter off
+#if SYNTH_LIMITER
+	int c;
+
+	if(threshold > DAC_MAX_CODE - DAC_MIDSCALE) threshold = DAC_MAX_CODE - DAC_MIDSCALE;
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) limiter_set_threshold(&master_limiter[c], threshold);
+#endif
+}
+
+void synth_set_chorus( uint32_t delay_us, uint32_t depth_us, uint32_t rate_chz, uint8_t feedback, uint8_t mix )
+{
+	//centre delay and sweep depth in us, LFO rate in 1/100 Hz, feedback and mix 0..127; the
+	//taps are clamped to the line, which is SYNTH_CHORUS_FRAMES samples at the current rate
+#if SYNTH_CHORUS
+	uint32_t delay = (uint32_t) (((uint64_t) delay_us * sample_rate << DELAY_FRAC_BITS) / 1000000);
+	uint32_t depth = (uint32_t) (((uint64_t) depth_us * sample_rate << DELAY_FRAC_BITS) / 1000000);
+	uint32_t rate_inc = (uint32_t) (((uint64_t) rate_chz << 32) / (100ull * sample_rate));
+	int c;
+
+	if(feedback > 127) feedback = 127;
+	if(mix > 127) mix = 127;
+	chorus_delay_us = delay_us;
+	chorus_depth_us = depth_us;
+	chorus_rate_chz = rate_chz;
+	chorus_feedback = feedback;
+	chorus_mix = mix;
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) chorus_set(&master_chorus[c], delay, depth, rate_inc, feedback << 1, mix << 1);
+#endif
+}
+
+void synth_set_formant( uint8_t vowel, uint8_t mix )
+{
+	//vowel 0..127 from a to u, glided to at control rate; mix 0..127, 0 is off
+#if SYNTH_FORMANT
+	if(vowel > 127) vowel = 127;
+	if(mix > 127) mix = 127;
+	formant_target = ((int32_t) vowel * FORMANT_POS_MAX + 63) / 127;
+	formant_mix = mix;
+
+	//off, the position jumps so the filter comes back in tune
+	if(mix == 0) formant_position = formant_target;
+	formant_update();
+#endif
+}
+
+void synth_set_reverb( uint8_t size, uint8_t damp, uint8_t mix )
+{
+	//size 0..127 from a short ring to several seconds, damping 0..127 the darker the higher,
+	//mix 0..127 with 0 off
+#if SYNTH_REVERB
+	int c;
+
+	if(size > 127) size = 127;
+	if(damp > 127) damp = 127;
+	if(mix > 127) mix = 127;
+	reverb_size = size;
+	reverb_damp = damp;
+	reverb_mix = mix;
+
+	//feedback 0.70 to 0.98 as Freeverb's room size, damping up to 0.4
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) reverb_set(&master_reverb[c], 179 + (size * 72) / 127, (damp * 102) / 127, mix << 1);
+#endif
+}
+
+static void formant_update( void )
+{
+	//retunes the bands to the current position, at most once per control tick
+#if SYNTH_FORMANT
+	uint32_t inc_per_hz = (uint32_t) (((uint64_t) 1 << 32) / sample_rate);
+	int c;
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++) formant_set(&master_formant[c], formant_position, inc_per_hz, (int32_t) formant_mix << 1);
+#endif
+}
+
+static void grain_update( void )
+{
+	//every channel's grain size, density and spray in samples of the current rate
+	int c;
+
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++) grain_params_set(&channels[c].grain, channels[c].grain_size, channels[c].grain_density, channels[c].grain_spray, sample_rate);
+}
+
+static void filter_set_cutoff( uint32_t cutoff_inc )
+{
+	filter_cutoff_inc = cutoff_inc;
+	filter_update();
+}
+
+static void filter_update( void )
+{
+	//set cutoff moved by the LFO routes and what is left of a CC glide, in 1/256 semitone; the
+	//filter clamps the result
+	uint64_t inc = filter_cutoff_inc;
+	int32_t offset = filter_cutoff_mod + filter_cutoff_glide;
+
+	if(offset) inc = (inc * curve_exp2(offset)) >> CURVE_RATIO_SHIFT;
+	svf_set_cutoff(&master_filter, (inc > 0xFFFFFFFFull) ? 0xFFFFFFFFul : (uint32_t) inc);
+}
+
+void synth_governor_report( uint16_t load )
+{
+	//render task side after each block, load in per mille of the block period. Over the high
+	//mark the quietest releasing voice fades out in the next tick, one per block; with no
+	//tail left to drop the oscillators go to draft quality until the load has stayed under
+	//the low mark for a while. The grain budget goes down one with every block over, and
+	//back up one with every block under
+#if SYNTH_GOVERNOR
+	int n;
+	int j;
+	int quietest = VOICE_NONE;
+	int32_t quietest_gain = 0;
+
+	if(load > SYNTH_GOVERNOR_HIGH)
+	{
+		governor_calm = 0;
+		grain_set_budget(grain_budget() - 1);
+
+		for(n=0; n<voice_bank.active_count; n++)
+		{
+			j = voice_bank.active[n];
+			if((voice_bank.env_stage[j] != ENV_RELEASE) || (voice_shed[j >> 5] & (1ul << (j & 31)))) continue;
+
+			if((quietest == VOICE_NONE) || (voice_bank.gain[j] < quietest_gain))
+			{
+				quietest = j;
+				quietest_gain = voice_bank.gain[j];
+			}
+		}
+
+		if(quietest != VOICE_NONE)
+		{
+			voice_shed[quietest >> 5] |= 1ul << (quietest & 31);
+			governor_shed_count++;
+		}
+		else render_draft = true;
+	}
+	else if(load < SYNTH_GOVERNOR_LOW)
+	{
+		grain_set_budget(grain_budget() + 1);
+		if(governor_calm < SYNTH_GOVERNOR_RECOVER_BLOCKS) governor_calm++;
+		else render_draft = false;
+	}
+#else
+	(void) load;
+#endif
+}
+
+uint32_t synth_governor_shed_count( void )
+{
+#if SYNTH_GOVERNOR
+	return governor_shed_count;
+#else
+	return 0;
+#endif
+}
+
+void synth_set_rate_timer( uint32_t (*cycles)( void ) )
+{
+	//times the tables synth_init() and a rate change build from here on, NULL for none
+	rate_timer = cycles;
+}
+
+uint32_t synth_rate_cycles( void )
+{
+	//of the last build of the rate dependent tables, 0 when untimed
+	return rate_cycles;
+}
+
+void synth_set_deadline( uint32_t (*cycles)( void ), uint32_t deadline )
+{
+	//render task, before the block; 'cycles' is read once a period until it passes 'deadline'
+#if SYNTH_DEADLINE
+	deadline_cycles = cycles;
+	deadline_at = deadline;
+#else
+	(void) cycles;
+	(void) deadline;
+#endif
+}
+
+bool synth_render_late( void )
+{
+	//whether the last block left out deferrable work
+#if SYNTH_DEADLINE
+	return render_was_late;
+#else
+	return false;
+#endif
+}
+
+bool synth_governor_draft( void )
+{
+#if SYNTH_GOVERNOR
+	return render_draft;
+#else
+	return false;
+#endif
+}
+
+void synth_set_velocity_curve( enum velocity_curve curve )
+{
+	//applies from the next note-on, sounding voices keep their amplitude
+	if(curve < VELOCITY_CURVE_COUNT) velocity_curve = velocity_curves[curve];
+}
+
+void synth_set_envelope( uint32_t attack_ms, uint32_t decay_ms, uint8_t sustain_percent, uint32_t release_ms )
+{
+	if(sustain_percent > 100) sustain_percent = 100;
+
+	env_attack_ms = attack_ms;
+	env_decay_ms = decay_ms;
+	env_sustain_percent = sustain_percent;
+	env_release_ms = release_ms;
+
+	env_params.attack_rate = env_rate_from_ms(attack_ms, sample_rate);
+	env_params.decay_rate = env_rate_from_ms(decay_ms, sample_rate);
+	env_params.sustain_level = (ENV_FULL * sustain_percent) / 100;
+	env_params.release_rate = env_rate_from_ms(release_ms, sample_rate);
+	env_params.decay_factor = env_factor_from_ms(decay_ms, sample_rate);
+	env_params.release_factor = env_factor_from_ms(release_ms, sample_rate);
+}
+
+void synth_set_sample_rate( uint32_t rate )
+{
+	//any task, picked up by the renderer at the start of its next block
+	if(rate < SYNTH_SAMPLE_RATE_MIN) rate = SYNTH_SAMPLE_RATE_MIN;
+	if(rate > SYNTH_SAMPLE_RATE_MAX) rate = SYNTH_SAMPLE_RATE_MAX;
+
+	sample_rate_request = rate;
+}
+
+uint32_t synth_sample_rate( void )
+{
+	return sample_rate_request;
+}
+
+#if SYNTH_AUDIO_INPUT
+void synth_set_input( const int16_t *samples )
+{
+	//renderer task, before synth_render_block(): SYNTH_BLOCK_SIZE signed samples in DAC units
+	//joining that block's mix after the master gain, ahead of the shaper, filter and the rest
+	//of the master effects, on both channels; NULL for a block without
+	input_block = samples;
+}
+#endif
+
+static void sample_rate_apply( uint32_t rate )
+{
+	//re-derives every rate dependent table and keeps sounding voices at their pitch
+	int n;
+	uint32_t old_rate = sample_rate;
+	uint32_t start = (rate_timer != NULL) ? rate_timer() : 0;
+
+	sample_rate = rate;
+	note_table_set_rate(rate);
+	drum_set_rate(rate);
+	grain_update();
+
+	synth_set_envelope(env_attack_ms, env_decay_ms, env_sustain_percent, env_release_ms);
+	mod_set_rate(rate);
+#if SYNTH_DC_BLOCK
+	dc_block_set_rate(rate);
+#endif
+	filter_set_cutoff((uint32_t) (((uint64_t) filter_cutoff_inc * old_rate) / rate));
+#if SYNTH_CHORUS
+	synth_set_chorus(chorus_delay_us, chorus_depth_us, chorus_rate_chz, chorus_feedback, chorus_mix);
+#endif
+	formant_update();
+
+	for(n=0; n<voice_bank.active_count; n++) voice_retune(voice_bank.active[n]);
+
+	//the tempo stays, the clock is timed again in samples of the new rate
+	clock_timeout = rate * SYNTH_CLOCK_TIMEOUT_MS / 1000;
+	midi_clock_init(&midi_clock);
+	clock_set_period(midi_clock_period(clock_tempo, rate));
+	clock_next = render_time;
+	clock_frac = 0;
+
+	if(rate_timer != NULL) rate_cycles = rate_timer() - start;
+}
+
+bool synth_post_event( const struct midi_event *event )
+{
+	//event task side, the event is applied at the next control tick
+	return synth_post_event_at(event, render_time);
+}
+
+bool synth_post_event_at( const struct midi_event *event, uint32_t time )
+{
+	//event task side, the event is applied at render time 'time', or as soon as possible
+	//if that has passed; times must not decrease from one event to the next
+	uint16_t head = event_head;
+
+	if((uint16_t) (head - event_tail) >= SYNTH_EVENT_QUEUE_SIZE)
+	{
+		event_dropped++;
+		return false;
+	}
+
+	event_queue[head & (SYNTH_EVENT_QUEUE_SIZE - 1)] = *event;
+	event_time[head & (SYNTH_EVENT_QUEUE_SIZE - 1)] = time;
+	__asm volatile ("" ::: "memory");
+	event_head = head + 1;
+
+	if((uint16_t) (head + 1 - event_tail) > event_peak) event_peak = (uint16_t) (head + 1 - event_tail);
+
+	return true;
+}
+
+bool synth_post_realtime( uint8_t status, uint32_t time )
+{
+	//the RX interrupt side, a realtime byte due at render time 'time'; it skips the event task,
+	//so its time is the byte's own and not the task's wake-up
+	uint16_t head = realtime_head;
+
+	if((uint16_t) (head - realtime_tail) >= SYNTH_REALTIME_QUEUE_SIZE)
+	{
+		event_dropped++;
+		return false;
+	}
+
+	realtime_queue[head & (SYNTH_REALTIME_QUEUE_SIZE - 1)] = status;
+	realtime_time[head & (SYNTH_REALTIME_QUEUE_SIZE - 1)] = time;
+	__asm volatile ("" ::: "memory");
+	realtime_head = head + 1;
+
+	return true;
+}
+
+#if SYNTH_FAST_NOTE_ON
+bool synth_post_note_now( const struct midi_event *event )
+{
+	//the RX interrupt side, single producer like synth_post_realtime(); no render time, the
+	//renderer takes it at its next control tick
+	uint16_t head = fast_head;
+
+	if((uint16_t) (head - fast_tail) >= SYNTH_FAST_NOTE_QUEUE_SIZE)
+	{
+		event_dropped++;
+		return false;
+	}
+
+	fast_queue[head & (SYNTH_FAST_NOTE_QUEUE_SIZE - 1)] = *event;
+	__asm volatile ("" ::: "memory");
+	fast_head = head + 1;
+
+	return true;
+}
+#endif
+
+uint16_t synth_events_dropped( void )
+{
+	return event_dropped;
+}
+
+uint16_t synth_events_peak( void )
+{
+	return event_peak;
+}
+
+uint32_t synth_events_late_max( void )
+{
+	return event_late_max;
+}
+
+uint32_t synth_render_time( void )
+{
+	return render_time;
+}
+
+int synth_voice_count( void )
+{
+	//enabled voices, releasing ones included
+	return voice_bank.active_count;
+}
+
+bool synth_events_pending( void )
+{
+	//posted events the renderer has not applied yet, from any task
+#if SYNTH_FAST_NOTE_ON
+	if(fast_head != fast_tail) return true;
+#endif
+	return (event_head != event_tail) || (realtime_head != realtime_tail);
+}
+
+uint16_t synth_events_queued( void )
+{
+	//posted events not applied yet, may be one behind a concurrent post
+	return (uint16_t) (event_head - event_tail);
+}
+
+static void voice_activate( int voice )
+{
+	uint8_t pos = voice_bank.active_count;
+
+	voice_bank.active[pos] = (uint8_t) voice;
+	voice_bank.active_pos[voice] = pos;
+	voice_bank.active_count = pos + 1;
+	voice_bank.enable[voice] = true;
+}
+
+static void voice_deactivate( int voice )
+{
+	//moves the last active voice into the gap
+	uint8_t pos = voice_bank.active_pos[voice];
+	uint8_t last = voice_bank.active[voice_bank.active_count - 1];
+
+	voice_bank.active[pos] = last;
+	voice_bank.active_pos[last] = pos;
+	voice_bank.active_count--;
+	voice_bank.enable[voice] = false;
+}
+
+static enum wave_type wave_playable( enum wave_type type )
+{
+#if !SYNTH_WAVETABLES
+	//no tables in flash, the band-limited shapes come from PolyBLEP instead
+	if(type == SQUARE) return SQUARE_BLEP;
+	if((type == SAW) || (type == MORPH)) return SAW_BLEP;
+#endif
+	return type;
+}
+
+static void voice_batch_add( int voice, enum wave_type type )
+{
+	//the groups after this one each move up a slot, their first voice to their end, to
+	//open a slot at the end of this one
+	uint8_t hole = voice_bank.batch_start[WAVE_TYPE_COUNT];
+	uint8_t first;
+	uint8_t v;
+	int t;
+
+	type = wave_playable(type);
+	voice_bank.type[voice] = (uint8_t) type;
+#if SYNTH_WAVETABLES
+	if(type <= TRI) voice_bank.table[voice] = wavetable_select(type, voice_bank.inc[voice]);
+	else if(type == MORPH) voice_bank.table[voice] = wavetable_select(SQUARE, voice_bank.inc[voice]);
+#endif
+	for(t=WAVE_TYPE_COUNT - 1; t>(int) type; t--)
+	{
+		first = voice_bank.batch_start[t];
+		if(first != hole)
+		{
+			v = voice_bank.batch[first];
+			voice_bank.batch[hole] = v;
+			voice_bank.batch_pos[v] = hole;
+		}
+		hole = first;
+		voice_bank.batch_start[t + 1]++;
+	}
+	voice_bank.batch_start[type + 1]++;
+
+	voice_bank.batch[hole] = (uint8_t) voice;
+	voice_bank.batch_pos[voice] = hole;
+}
+
+static void voice_batch_remove( int voice )
+{
+	//moves the last voice of the group into the gap, then the groups after it each down a
+	//slot, their last voice to their start
+	uint8_t type = voice_bank.type[voice];
+	uint8_t pos = voice_bank.batch_pos[voice];
+	uint8_t hole = voice_bank.batch_start[type + 1] - 1;
+	uint8_t last = voice_bank.batch[hole];
+	uint8_t end;
+	int t;
+
+	voice_bank.batch[pos] = last;
+	voice_bank.batch_pos[last] = pos;
+	for(t=type + 1; t<WAVE_TYPE_COUNT; t++)
+	{
+		end = voice_bank.batch_start[t + 1] - 1;
+		if(end != hole)
+		{
+			last = voice_bank.batch[end];
+			voice_bank.batch[hole] = last;
+			voice_bank.batch_pos[last] = hole;
+		}
+		hole = end;
+		voice_bank.batch_start[t]--;
+	}
+	voice_bank.batch_start[WAVE_TYPE_COUNT]--;
+
+	if(type == STREAM) stream_voice_stop(voice);
+	if(type == PLUCK) pluck_voice_stop(voice);
+	if(type == GRAIN) grain_voice_stop(voice);
+}
+
+void synth_handle_event( const struct midi_event *event )
+{
+	//applies one parsed MIDI event to the voice state, events of a muted channel are dropped
+	uint8_t channel = event->channel & 0x0F;
+
+	if(event->status >= MIDI_CLOCK)
+	{
+		clock_event(event->status);
+		return;
+	}
+
+	if((event->status == MIDI_TUNING_NOTE) || (event->status == MIDI_TUNING_SCALE))
+	{
+		tuning_event(event);
+		return;
+	}
+
+	//a member channel of the MPE zone plays the master's part
+	if(channels[MPE_MEMBER(channel) ? MPE_MASTER : channel].group == VOICE_NONE) return;
+
+#if SYNTH_VOICE_OVERFLOW
+	//the board behind gets every channel message its spilled notes may need
+	if(overflow_forward && (event->status >= MIDI_POLY_PRESSURE) && (event->status < MIDI_SYSEX_START))
+	{
+		overflow_forward(event);
+	}
+#endif
+
+	//the arpeggiator's keys are held there, it plays them itself; a key pressed before it
+	//was switched on is still released as usual
+	if((channel == SYNTH_ARP_CHANNEL) && (arp.mode != ARP_OFF))
+	{
+		if(event->status == MIDI_NOTE_ON)
+		{
+			arp_note_on(&arp, event->data1, event->data2);
+			return;
+		}
+		if((event->status == MIDI_NOTE_OFF) && arp_note_off(&arp, event->data1)) return;
+	}
+
+#if SYNTH_MPE_CHANNELS
+	if(MPE_MEMBER(channel))
+	{
+		mpe_member_event(channel, event);
+		return;
+	}
+#endif
+
+	switch(event->status)
+	{
+		case MIDI_NOTE_ON:
+		synth_note_on(channel, event->data1, event->data2);
+		break;
+
+		case MIDI_NOTE_OFF:
+		synth_note_off(channel, event->data1);
+		break;
+
+		case MIDI_CONTROL_CHANGE:
+		synth_control_change(channel, event->data1, event->data2);
+		break;
+
+		case MIDI_PROGRAM_CHANGE:
+		synth_program_change(channel, event->data1);
+		break;
+
+		case MIDI_PITCH_BEND:
+		synth_pitch_bend(channel, midi_event_bend(event));
+		break;
+
+		case MIDI_POLY_PRESSURE:
+		synth_poly_pressure(channel, event->data1, event->data2);
+		break;
+
+		case MIDI_CHANNEL_PRESSURE:
+		synth_channel_pressure(channel, event->data1);
+		break;
+
+		default:
+		break;
+	}
+}
+
+#if SYNTH_VOICE_OVERFLOW
+void synth_set_overflow( bool (*forward)( const struct midi_event *event ) )
+{
+	//NULL plays every note here, stealing as usual
+	overflow_forward = forward;
+}
+
+static bool synth_overflow_note_on( uint8_t channel, uint8_t note, uint8_t velocity, bool full )
+{
+	//true when the note went to the board behind: it has no free voice here, or it is already
+	//sounding there
+	struct midi_event event = { MIDI_NOTE_ON, channel & 0x0F, note & 0x7F, velocity & 0x7F };
+	uint32_t bit = 1ul << (note & 31);
+	uint32_t *word = &overflow_notes[channel & 0x0F][(note & 0x7F) >> 5];
+
+	if(!full && !(*word & bit)) return false;
+
+	*word |= bit;
+	overflow_forward(&event);
+	return true;
+}
+
+static bool synth_overflow_note_off( uint8_t channel, uint8_t note )
+{
+	//true when the note was sounding on the board behind, the note off follows it there
+	struct midi_event event = { MIDI_NOTE_OFF, channel & 0x0F, note & 0x7F, 0 };
+	uint32_t bit = 1ul << (note & 31);
+	uint32_t *word = &overflow_notes[channel & 0x0F][(note & 0x7F) >> 5];
+
+	if(!(*word & bit)) return false;
+
+	*word &= ~bit;
+	if(overflow_forward) overflow_forward(&event);
+	return true;
+}
+#endif
+
+#if SYNTH_MPE_CHANNELS
+static void mpe_member_event( uint8_t member, const struct midi_event *event )
+{
+	//a member channel carries one note: its bend, pressure and timbre go to that voice alone,
+	//found through the channel, and are kept for the next note started on it
+	struct synth_channel *mc = &channels[member];
+	int j = mc->voice;
+
+	switch(event->status)
+	{
+		case MIDI_NOTE_ON:
+		note_start(MPE_MASTER, member, event->data1, event->data2);
+		break;
+
+		case MIDI_NOTE_OFF:
+#if SYNTH_VOICE_OVERFLOW
+		if(synth_overflow_note_off(member, event->data1)) break;
+#endif
+		if(!mpe_voice_valid(member, j) || !voice_bank.gate[j] || (voice_bank.note[j] != (event->data1 & 0x7F))) break;
+
+		if(channels[MPE_MASTER].sustain)
+		{
+			sustain_held[MPE_MASTER][j >> 5] |= 1ul << (j & 31);
+			break;
+		}
+		voice_alloc_release(j);
+		held_notes[MPE_MASTER][voice_bank.note[j] >> 5] &= ~(1ul << (voice_bank.note[j] & 31));
+		voice_bank.gate[j] = false;
+		if(voice_bank.env_stage[j] != ENV_IDLE) voice_bank.env_stage[j] = ENV_RELEASE;
+		break;
+
+		case MIDI_PITCH_BEND:
+		mc->bend_fine = (midi_event_bend(event) * SYNTH_MPE_BEND_RANGE) >> 5;
+		if(mpe_voice_valid(member, j))
+		{
+			voice_bank.note_bend[j] = mc->bend_fine;
+			voice_retune(j);
+		}
+		break;
+
+		case MIDI_CHANNEL_PRESSURE:
+		mc->pressure = pressure_level(event->data1);
+		mc->pressure_at = ++pressure_count;
+		mod_set_pressure(mc->pressure);
+		if(mpe_voice_valid(member, j))
+		{
+			voice_bank.pressure[j] = mc->pressure;
+			voice_bank.pressure_at[j] = mc->pressure_at;
+		}
+		break;
+
+		case MIDI_CONTROL_CHANGE:
+		if(event->data1 != MIDI_CC_TIMBRE) break;
+		mc->timbre = (int16_t) (((event->data2 & 0x7F) - 64) << 9);
+		if(mpe_voice_valid(member, j)) voice_bank.timbre[j] = mc->timbre;
+		break;
+
+		default:
+		break;
+	}
+}
+
+static bool mpe_voice_valid( uint8_t member, int voice )
+{
+	//the member's last voice, unless it has been stolen or has finished since
+	return (voice != VOICE_NONE) && voice_bank.enable[voice] && (voice_bank.member[voice] == member) && (voice_bank.channel[voice] == MPE_MASTER);
+}
+#endif
+
+void synth_channel_pressure( uint8_t channel, uint8_t pressure )
+{
+	//aftertouch for every voice of the channel without touching one: a voice compares its
+	//own pressure's stamp with the channel's at the next control tick
+	struct synth_channel *ch = &channels[channel & 0x0F];
+
+	ch->pressure = pressure_level(pressure);
+	ch->pressure_at = ++pressure_count;
+	mod_set_pressure(ch->pressure);
+}
+
+void synth_poly_pressure( uint8_t channel, uint8_t note, uint8_t pressure )
+{
+	//aftertouch for the one voice the allocator's note index holds for the channel's note
+	struct synth_channel *ch = &channels[channel & 0x0F];
+	int j;
+
+	if(ch->group == VOICE_NONE) return;
+
+	j = voice_alloc_find(ch->group, channel & 0x0F, note);
+	if(j == VOICE_NONE) return;
+
+	voice_bank.pressure[j] = pressure_level(pressure);
+	voice_bank.pressure_at[j] = ++pressure_count;
+	mod_set_pressure(voice_bank.pressure[j]);
+}
+
+static int16_t pressure_level( uint8_t value )
+{
+	//Q15 below full pressure, 0 at 127
+	value &= 0x7F;
+	return (value == 127) ? 0 : (int16_t) ((value * 258) - MOD_UNITY);
+}
+
+static void clock_init( void )
+{
+	midi_clock_init(&midi_clock);
+	arp_init(&arp);
+	arp_set(&arp, (enum arp_mode) SYNTH_ARP_MODE, SYNTH_ARP_DIVISION, SYNTH_ARP_OCTAVES);
+	pattern_play(&pattern_player, NULL);
+	pattern_select(SYNTH_PATTERN);
+	automation_init(&automation, SYNTH_AUTOMATION_CLOCKS);
+	mod_set_lfo_sync(0, SYNTH_LFO_SYNC);
+	delay_sync = SYNTH_DELAY_SYNC;
+
+	clock_running = true;
+	clock_free = true;
+	clock_locked = false;
+	clock_timeout = sample_rate * SYNTH_CLOCK_TIMEOUT_MS / 1000;
+	clock_set_period(midi_clock_period(SYNTH_TEMPO, sample_rate));
+	clock_next = render_time;
+	clock_frac = 0;
+}
+
+static void tuning_event( const struct midi_event *event )
+{
+	//a tuning is global, not per channel; the sounding notes move to it at once
+#if SYNTH_TUNING
+	int n;
+
+	if(event->status == MIDI_TUNING_NOTE) note_tuning_set(event->channel, (uint16_t) ((event->data1 << NOTE_PITCH_SHIFT) | event->data2));
+	else if(event->channel == MIDI_TUNING_RESET) note_tuning_reset();
+	else if(event->channel < 12) note_tuning_octave(event->channel, (int) event->data1 - 64);
+
+	for(n=0; n<voice_bank.active_count; n++) voice_retune(voice_bank.active[n]);
+#endif
+}
+
+static void clock_event( uint8_t status )
+{
+	//MIDI clock is timed even while stopped, senders keep it running between songs
+	int16_t note;
+
+	switch(status)
+	{
+		case MIDI_CLOCK:
+		if(midi_clock_tick(&midi_clock, event_at, clock_timeout)) clock_set_period(midi_clock.period);
+		clock_free = false;
+		clock_locked = (midi_clock.period != 0);
+		if(clock_running) clock_step();
+		break;
+
+		case MIDI_START:
+		arp_restart(&arp);
+		pattern_restart(&pattern_player);
+		automation_restart(&automation);
+		mod_restart_synced();
+		clock_running = true;
+		break;
+
+		case MIDI_CONTINUE:
+		clock_running = true;
+		break;
+
+		case MIDI_STOP:
+		clock_running = false;
+		arp_update((enum arp_mode) arp.mode, arp.division, arp.octaves);
+		note = pattern_release(&pattern_player);
+		if(note != PATTERN_NONE) synth_note_off(pattern_player.pattern->channel, (uint8_t) note);
+		break;
+
+		default:
+		break;
+	}
+}
+
+static void clock_watch( uint32_t now )
+{
+	//the internal clock takes over once MIDI clock has been missing for the timeout, a period
+	//after the last one came in
+	uint32_t sum;
+
+	if(clock_free || (midi_clock.timing && ((uint32_t) (now - midi_clock.last) <= clock_timeout))) return;
+
+	clock_free = true;
+	clock_locked = false;
+	midi_clock_restart(&midi_clock);
+
+	sum = clock_period;
+	clock_next = midi_clock.last + (sum >> MIDI_CLOCK_FRAC_BITS);
+	clock_frac = (uint8_t) sum;
+	if((int32_t) (clock_next - now) < 0) clock_next = now;
+}
+
+static void clock_internal( void )
+{
+	//one internal clock, due at clock_next; the fraction carries over so the tempo is exact
+	//over a bar while every clock still lands on a whole sample
+	uint32_t sum = (uint32_t) clock_frac + clock_period;
+
+	clock_next += sum >> MIDI_CLOCK_FRAC_BITS;
+	clock_frac = (uint8_t) sum;
+
+	if(clock_running) clock_step();
+}
+
+static void clock_step( void )
+{
+	struct arp_step step;
+	struct pattern_out out;
+	struct automation_event event;
+
+	if(arp_clock(&arp, &step))
+	{
+		if(step.off != ARP_NONE) synth_note_off(SYNTH_ARP_CHANNEL, (uint8_t) step.off);
+		if(step.on != ARP_NONE) synth_note_on(SYNTH_ARP_CHANNEL, (uint8_t) step.on, step.velocity);
+	}
+
+	if(pattern_clock(&pattern_player, &out))
+	{
+		if(out.off != PATTERN_NONE) synth_note_off(out.channel, (uint8_t) out.off);
+		if(out.on != PATTERN_NONE) synth_note_on(out.channel, (uint8_t) out.on, out.velocity);
+	}
+
+	//a recorded controller goes through the map again, as it did when it was played
+	automation_clock(&automation);
+	while(automation_next(&automation, &event)) synth_control_change(event.channel, event.controller, event.value);
+}
+
+static void clock_set_period( uint32_t period )
+{
+	//everything locked to the tempo follows; the internal clock needs a sample per clock
+	if(period < (1 << MIDI_CLOCK_FRAC_BITS)) period = 1 << MIDI_CLOCK_FRAC_BITS;
+	clock_period = period;
+	clock_tempo = midi_clock_tempo(period, sample_rate);
+	mod_set_clock(period);
+	delay_follow();
+}
+
+static void arp_update( enum arp_mode mode, uint8_t division, uint8_t octaves )
+{
+	//switching it off or stopping the transport releases the note it plays
+	int16_t note;
+
+	if((mode == ARP_OFF) || !clock_running)
+	{
+		note = arp_release(&arp);
+		if(note != ARP_NONE) synth_note_off(SYNTH_ARP_CHANNEL, (uint8_t) note);
+	}
+	arp_set(&arp, mode, division, octaves);
+}
+
+static void pattern_select( int number )
+{
+	//pattern 'number' from its first step at the next clock, 0 or one past the table stops;
+	//the note of the one playing is released first
+	int16_t note = pattern_release(&pattern_player);
+
+	if(note != PATTERN_NONE) synth_note_off(pattern_player.pattern->channel, (uint8_t) note);
+	pattern_play(&pattern_player, ((number > 0) && (number <= pattern_count)) ? &patterns[number - 1] : NULL);
+}
+
+static void delay_follow( void )
+{
+	//the delay time only moves for a change of more than 1/64, the smoothed period still
+	//wanders by a sample or two and every move of the tap is a small click
+#if SYNTH_DELAY
+	uint32_t time;
+
+	if(delay_sync == 0) return;
+
+	time = (uint32_t) (((uint64_t) delay_sync * clock_period) >> MIDI_CLOCK_FRAC_BITS);
+	if(time > SYNTH_DELAY_FRAMES - 1) time = SYNTH_DELAY_FRAMES - 1;
+	if((time > delay_time + (delay_time >> 6)) || (time < delay_time - (delay_time >> 6))) synth_set_delay(time, delay_feedback, delay_mix);
+#endif
+}
+
+uint32_t synth_tempo( void )
+{
+	//1/100 BPM, any task
+	return clock_tempo;
+}
+
+bool synth_clock_locked( void )
+{
+	//true while the tempo comes from MIDI clock
+	return clock_locked;
+}
+
+void synth_note_on( uint8_t channel, uint8_t note, uint8_t velocity )
+{
+	note_start(channel & 0x0F, channel & 0x0F, note, velocity);
+}
+
+static int note_start( uint8_t channel, uint8_t member, uint8_t note, uint8_t velocity )
+{
+	//the allocator always returns a voice of the channel's group, stealing one when all are
+	//busy; an MPE note is played by the zone's master channel and takes its expression from
+	//the member channel it came on. Returns the voice, or VOICE_NONE when none plays it here
+	struct synth_channel *ch = &channels[channel];
+	struct synth_channel *mc = &channels[member];
+	const struct pcm_sample *pcm = 0;
+	const struct stream_sample *stream = 0;
+	int stolen_note;
+	int j;
+	int k;
+
+	if(ch->group == VOICE_NONE) return VOICE_NONE;
+	if((ch->patch.wave == DRUM) && !drum_in_kit(note & 0x7F)) return VOICE_NONE;
+
+	if((ch->patch.wave == SAMPLE) || (ch->patch.wave == GRAIN))
+	{
+		pcm = pcm_sample_for_note(note & 0x7F);
+		if(!pcm) return VOICE_NONE;
+	}
+	else if(ch->patch.wave == STREAM)
+	{
+		stream = stream_sample_for_note(note & 0x7F);
+		if(!stream) return VOICE_NONE;
+		pcm = &stream->pcm;
+	}
+
+#if SYNTH_VOICE_OVERFLOW
+	if(overflow_forward && synth_overflow_note_on(member, note, velocity, voice_alloc_would_steal(ch->group, channel, note))) return VOICE_NONE;
+#endif
+
+	j = voice_alloc_note_on(ch->group, channel, note, velocity, &stolen_note);
+
+	if(voice_bank.enable[j]) voice_batch_remove(j);
+
+	//a struck key takes the voice back from the pedal, and from the load governor; a stolen
+	//voice's note is no longer held on the channel it sounded for
+	sustain_held[voice_bank.channel[j]][j >> 5] &= ~(1ul << (j & 31));
+	if(voice_bank.gate[j]) held_notes[voice_bank.channel[j]][voice_bank.note[j] >> 5] &= ~(1ul << (voice_bank.note[j] & 31));
+#if SYNTH_GOVERNOR
+	voice_shed[j >> 5] &= ~(1ul << (j & 31));
+#endif
+
+	voice_bank.note[j] = note & 0x7F;
+	voice_bank.channel[j] = channel;
+	voice_bank.member[j] = member;
+	voice_bank.velocity[j] = velocity & 0x7F;
+	voice_bank.mod_pitch[j] = 0;
+	voice_bank.note_bend[j] = (member != channel) ? mc->bend_fine : 0;
+	voice_bank.pressure[j] = mc->pressure;
+	voice_bank.pressure_at[j] = mc->pressure_at;
+	voice_bank.timbre[j] = mc->timbre;
+	mc->voice = (int8_t) j;
+	voice_glide_start(j, ch, note & 0x7F);
+	voice_bank.inc[j] = note_tuned_increment_fine(note & 0x7F, ch->bend_fine + voice_bank.note_bend[j]);
+	voice_bank.amp[j] = velocity_curve[velocity & 0x7F];
+	voice_bank.phase[j] = 0;
+	voice_bank.fm_phase[j] = 0;
+	voice_bank.sub_count[j] = 0;
+	for(k=0; k<SYNTH_UNISON - 1; k++) voice_bank.unison_phase[k][j] = (uint32_t) (k + 1) * 0x9E3779B9ul;
+	voice_bank.swap_fade[j] = 0;
+	voice_osc2(j, ch);
+	voice_pan(j, ch->patch.pan, false);
+	voice_bank.quality[j] = ch->patch.quality;
+	if(pcm)
+	{
+		//start offset in 1/128 of the sample
+		voice_bank.pcm[j] = pcm;
+		voice_bank.pcm_pos[j] = (pcm->length * ch->patch.sample_start) >> 7;
+		if((pcm->loop_end > pcm->loop_start) && (voice_bank.pcm_pos[j] >= pcm->loop_end)) voice_bank.pcm_pos[j] = pcm->loop_start;
+		voice_bank.pcm_pos[j] <<= PCM_FRAC_BITS;
+		voice_sample_step(j);
+		if(stream) stream_voice_start(j, stream, voice_bank.pcm_pos[j] >> PCM_FRAC_BITS);
+	}
+	if(ch->patch.wave == PLUCK) pluck_voice_start(j, voice_bank.inc[j], &voice_bank.noise[j]);
+	if(ch->patch.wave == GRAIN) grain_voice_start(j);
+	voice_batch_add(j, ch->patch.wave);
+	voice_bank.gate[j] = true;
+	held_notes[channel][(note & 0x7F) >> 5] |= 1ul << (note & 31);
+	//restarts the attack from the current level, also on a stolen voice
+	voice_bank.env_stage[j] = ENV_ATTACK;
+	if(!voice_bank.enable[j]) voice_activate(j);
+
+	//modulated from the first sample, without a ramp from the slot's old amplitude
+	voice_modulate(j);
+	voice_bank.mod_amp[j] = voice_bank.mod_amp_next[j];
+
+	//a hit starts at full level and only decays, at the channel volume it was struck with
+	if(ch->patch.wave == DRUM) drum_hit(j);
+
+	//the attack starts on this sample, not at the next control tick
+	envelope_ramp(j, period_left);
+	return j;
+}
+
+static void drum_hit( int voice )
+{
+	//full level from the first sample; a piece in a choke group fades out the channel's other
+	//hits in it, the one walk over the voices a hit can take
+	uint8_t choke;
+	int n;
+	int k;
+
+	voice_bank.inc[voice] = drum_voice_start(voice, voice_bank.note[voice]);
+	voice_bank.env_level[voice] = ENV_FULL;
+	voice_bank.env_stage[voice] = ENV_DECAY;
+
+	choke = drum_choke(voice);
+	if(choke == 0) return;
+
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		k = voice_bank.active[n];
+		if((k == voice) || (voice_bank.type[k] != DRUM) || (voice_bank.channel[k] != voice_bank.channel[voice])) continue;
+		if((voice_bank.env_stage[k] != ENV_IDLE) && (drum_choke(k) == choke)) voice_bank.env_stage[k] = ENV_RELEASE;
+	}
+}
+
+void synth_note_off( uint8_t channel, uint8_t note )
+{
+	//the voice keeps sounding through its release and is freed once that has finished; with
+	//the pedal down it only gets marked, the release waits for pedal-up
+	struct synth_channel *ch = &channels[channel & 0x0F];
+	int j;
+
+	if(ch->group == VOICE_NONE) return;
+
+#if SYNTH_VOICE_OVERFLOW
+	if(synth_overflow_note_off(channel, note)) return;
+#endif
+
+	if(ch->sustain)
+	{
+		j = voice_alloc_find(ch->group, channel & 0x0F, note);
+		if(j != VOICE_NONE) sustain_held[voice_bank.channel[j]][j >> 5] |= 1ul << (j & 31);
+		return;
+	}
+
+	j = voice_alloc_note_off(ch->group, channel & 0x0F, note);
+
+	if(j != VOICE_NONE)
+	{
+		held_notes[voice_bank.channel[j]][voice_bank.note[j] >> 5] &= ~(1ul << (voice_bank.note[j] & 31));
+		voice_bank.gate[j] = false;
+		if((voice_bank.env_stage[j] != ENV_IDLE) && (voice_bank.type[j] != DRUM)) voice_bank.env_stage[j] = ENV_RELEASE;
+	}
+}
+
+void synth_sustain( uint8_t channel, bool down )
+{
+	//pedal-up releases only the marked voices of the channel, one pass over its set bits
+	int w;
+	int j;
+	uint32_t bits;
+
+	channel &= 0x0F;
+	channels[channel].sustain = down;
+	if(down) return;
+
+	for(w=0; w<VOICE_MASK_WORDS; w++)
+	{
+		bits = sustain_held[channel][w];
+		sustain_held[channel][w] = 0;
+
+		while(bits)
+		{
+			j = (w << 5) + __builtin_ctz(bits);
+			bits &= bits - 1;
+			synth_note_off(channel, voice_bank.note[j]);
+		}
+	}
+}
+
+void synth_all_notes_off( uint8_t channel )
+{
+	//one pass over the channel's held notes, whatever the polyphony; a note whose voice has
+	//gone without a note off (a one-shot sample that played out) only has its bit dropped
+	const struct synth_channel *ch;
+	uint32_t bits;
+	int note;
+	int w;
+	int j;
+
+	channel &= 0x0F;
+	ch = &channels[channel];
+	for(w=0; w<4; w++)
+	{
+		bits = held_notes[channel][w];
+
+		while(bits)
+		{
+			note = (w << 5) + __builtin_ctz(bits);
+			bits &= bits - 1;
+
+			j = (ch->group == VOICE_NONE) ? VOICE_NONE : voice_alloc_find(ch->group, channel, (uint8_t) note);
+			if(j != VOICE_NONE) synth_note_off(channel, (uint8_t) note);
+			else held_notes[channel][w] &= ~(1ul << (note & 31));
+		}
+	}
+#if SYNTH_VOICE_OVERFLOW
+	//and the notes on the board behind, likewise by their bits
+	for(w=0; w<4; w++)
+	{
+		bits = overflow_notes[channel][w];
+
+		while(bits)
+		{
+			note = (w << 5) + __builtin_ctz(bits);
+			bits &= bits - 1;
+			synth_overflow_note_off(channel, (uint8_t) note);
+		}
+	}
+#endif
+}
+
+void synth_all_sound_off( uint8_t channel )
+{
+	//cuts the channel's voices without release, the next control tick frees them
+	int j;
+	int n;
+
+	channel &= 0x0F;
+#if SYNTH_VOICE_OVERFLOW
+	for(n=0; n<4; n++) overflow_notes[channel][n] = 0;
+#endif
+	for(n=0; n<4; n++) held_notes[channel][n] = 0;
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		j = voice_bank.active[n];
+		if(voice_bank.channel[j] != channel) continue;
+
+		voice_alloc_release(j);
+		sustain_held[channel][j >> 5] &= ~(1ul << (j & 31));
+		voice_bank.gate[j] = false;
+		voice_bank.env_stage[j] = ENV_IDLE;
+		voice_bank.env_level[j] = 0;
+		voice_bank.gain[j] = 0;
+		voice_bank.gain_step[j] = 0;
+	}
+}
+
+void synth_route_channel( uint8_t channel, int group )
+{
+	//moves a channel to another voice group, VOICE_NONE mutes it; its sounding notes are
+	//released first so their note-offs can not miss
+	channel &= 0x0F;
+	if((group != VOICE_NONE) && ((group < 0) || (group >= SYNTH_VOICE_GROUPS))) return;
+
+	synth_sustain(channel, false);
+	synth_all_notes_off(channel);
+	channels[channel].group = (int8_t) group;
+}
+
+void synth_set_pulse_width( uint8_t channel, int32_t width )
+{
+	//offset from 50% duty in Q15 of a half cycle, the LFO routes add to it at the next tick
+	if(width > MOD_PW_LIMIT) width = MOD_PW_LIMIT;
+	if(width < -MOD_PW_LIMIT) width = -MOD_PW_LIMIT;
+
+	channels[channel & 0x0F].patch.pulse_width = width;
+	patch_dirty |= 1u << (channel & 0x0F);
+}
+
+void synth_set_fm( uint8_t channel, uint8_t ratio, uint8_t index )
+{
+	//applies from the next note-on
+	if(ratio < 1) ratio = 1;
+	if(ratio > 16) ratio = 16;
+
+	channels[channel & 0x0F].patch.fm_ratio = ratio;
+	channels[channel & 0x0F].patch.fm_index = (index > 127) ? 127 : index;
+	patch_dirty |= 1u << (channel & 0x0F);
+}
+
+void synth_set_drawbar( uint8_t channel, int bar, uint8_t level )
+{
+	//drawbar 0 is 16', level 0..8; the gains of all nine are scaled down together when
+	//their sum passes unity, the sounding voices follow at control rate
+	struct synth_channel *ch = &channels[channel & 0x0F];
+	int32_t sum = 0;
+	int d;
+
+	if((bar < 0) || (bar >= ORGAN_DRAWBARS)) return;
+	ch->drawbar[bar] = (level > 8) ? 8 : level;
+
+	for(d=0; d<ORGAN_DRAWBARS; d++) sum += drawbar_level[ch->drawbar[d]];
+	for(d=0; d<ORGAN_DRAWBARS; d++)
+	{
+		ch->drawbar_target[d] = (int16_t) ((sum > (1 << ORGAN_GAIN_SHIFT)) ? ((int32_t) drawbar_level[ch->drawbar[d]] << ORGAN_GAIN_SHIFT) / sum : drawbar_level[ch->drawbar[d]]);
+	}
+}
+
+void synth_set_pan( uint8_t channel, uint8_t pan )
+{
+	//0 hard left, 127 hard right, the channel's sounding voices move with it
+	int j;
+	int n;
+
+	channel &= 0x0F;
+	if(pan > 127) pan = 127;
+	channels[channel].patch.pan = pan;
+	patch_dirty |= 1u << (channel & 0x0F);
+
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		j = voice_bank.active[n];
+		if(voice_bank.channel[j] == channel) voice_pan(j, pan, true);
+	}
+}
+
+void synth_set_osc_quality( uint8_t channel, uint8_t quality )
+{
+	//SYNTH_OSC_TRUNCATE..SYNTH_OSC_QUALITY_MAX, the channel's sounding voices switch at the
+	//next segment
+	int j;
+	int n;
+
+	channel &= 0x0F;
+	if(quality > SYNTH_OSC_QUALITY_MAX) quality = SYNTH_OSC_QUALITY_MAX;
+	channels[channel].patch.quality = quality;
+	patch_dirty |= 1u << (channel & 0x0F);
+
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		j = voice_bank.active[n];
+		if(voice_bank.channel[j] == channel) voice_bank.quality[j] = quality;
+	}
+}
+
+void synth_set_sub( uint8_t channel, uint8_t level, bool two_octaves )
+{
+	//level 0..127, the channel's sounding voices fade to it at control rate and the octave
+	//changes at their next sub-oscillator edge
+	if(level > SUB_LEVEL_MASK) level = SUB_LEVEL_MASK;
+	channels[channel & 0x0F].patch.sub = level | (two_octaves ? SUB_TWO_OCTAVES : 0);
+	patch_dirty |= 1u << (channel & 0x0F);
+}
+
+static int16_t morph_position( uint8_t value )
+{
+	//controller 0 is the triangle set, 127 the square's
+	return (int16_t) (((int32_t) (127 - (value & 0x7F)) << (MORPH_SHIFT + 1)) / 127);
+}
+
+static int32_t sub_target( const struct synth_channel *ch )
+{
+	//level 127 is a full-scale square
+	return ((ch->patch.sub & SUB_LEVEL_MASK) * 129) >> 2;
+}
+
+void synth_set_volume( uint8_t channel, uint8_t volume )
+{
+	//square law, 127 is unity; sounding voices follow within a few control ticks
+	if(volume > 127) volume = 127;
+	channel_volume(channel, (uint32_t) volume << 7);
+}
+
+static void channel_volume( uint8_t channel, uint32_t fine )
+{
+	//fine is 14-bit, CC_FINE_FULL and up is unity
+	if(fine > CC_FINE_FULL) fine = CC_FINE_FULL;
+	channels[channel & 0x0F].volume_target = (int32_t) (((uint64_t) fine * fine * MOD_UNITY) / ((uint32_t) CC_FINE_FULL * CC_FINE_FULL));
+}
+
+static void voice_pan( int voice, uint8_t pan, bool ramp )
+{
+	//constant power, cosine and sine of the pan over a quarter cycle; a sounding voice ramps
+	//to them from its next tick, a starting one takes them as they are
+	uint32_t phase = (uint32_t) pan * ((PHASE_HALF_CYCLE / 2) / 127);
+
+	voice_bank.pan_left_to[voice] = (int16_t) (sine_lookup(phase + PHASE_HALF_CYCLE / 2) << 4);
+	voice_bank.pan_right_to[voice] = (int16_t) (sine_lookup(phase) << 4);
+	if(ramp) return;
+
+	voice_bank.pan_left[voice] = voice_bank.pan_left_to[voice];
+	voice_bank.pan_right[voice] = voice_bank.pan_right_to[voice];
+	voice_bank.pan_left_step[voice] = 0;
+	voice_bank.pan_right_step[voice] = 0;
+}
+
+#if SYNTH_STEREO
+static void voice_pan_ramp( int voice )
+{
+	//control rate: the pan gains' steps across the next period, 0 once they are there
+	int32_t left = voice_bank.pan_left[voice];
+	int32_t right = voice_bank.pan_right[voice];
+
+	voice_bank.pan_left_step[voice] = (int16_t) ramp_begin(&left, voice_bank.pan_left_to[voice]);
+	voice_bank.pan_right_step[voice] = (int16_t) ramp_begin(&right, voice_bank.pan_right_to[voice]);
+	voice_bank.pan_left[voice] = (int16_t) left;
+	voice_bank.pan_right[voice] = (int16_t) right;
+}
+#endif
+
+void synth_portamento( uint8_t channel, bool on )
+{
+	//applies from the next note-on, a glide under way runs to its end
+	channels[channel & 0x0F].patch.portamento = on;
+	patch_dirty |= 1u << (channel & 0x0F);
+}
+
+void synth_portamento_time( uint8_t channel, uint32_t ms )
+{
+	channels[channel & 0x0F].patch.glide_ms = ms;
+	patch_dirty |= 1u << (channel & 0x0F);
+}
+
+static void voice_glide_start( int voice, struct synth_channel *ch, uint8_t note )
+{
+	//starts the voice at the channel's previous note, the step covers the distance in the
+	//glide time; the one division is per note-on
+	int32_t distance;
+	int32_t ticks;
+
+	voice_bank.glide[voice] = 0;
+
+	if(ch->patch.portamento && ch->patch.glide_ms && (ch->last_note != VOICE_NONE) && (ch->last_note != note))
+	{
+		distance = ((int32_t) ch->last_note - note) << 8;
+		ticks = (int32_t) (((uint64_t) ch->patch.glide_ms * sample_rate) / (1000ul * SYNTH_CONTROL_PERIOD));
+		if(ticks < 1) ticks = 1;
+
+		voice_bank.glide[voice] = distance;
+		voice_bank.glide_step[voice] = distance / ticks;
+		if(voice_bank.glide_step[voice] == 0) voice_bank.glide_step[voice] = (distance < 0) ? -1 : 1;
+	}
+
+	ch->last_note = (int8_t) note;
+}
+
+void synth_control_change( uint8_t channel, uint8_t controller, uint8_t value )
+{
+	//the channel's map entry names the slot, whose range the value is scaled to
+	struct cc_channel *state = &cc_channels[channel & 0x0F];
+	const struct cc_slot *slot;
+	uint16_t fine = (uint16_t) ((value & 0x7F) << 7);
+	int32_t range;
+
+	channel &= 0x0F;
+	controller &= 0x7F;
+	if(cc_fixed(channel, controller, value & 0x7F)) return;
+
+	if(cc_learn.channel == channel)
+	{
+		cc_assign(channel, controller, (enum synth_param) cc_learn.param, cc_learn.low, cc_learn.high);
+		cc_learn.channel = -1;
+		cc_learned_channel = channel;
+		cc_learned_controller = controller;
+		cc_learned_param = cc_learn.param;
+		__asm volatile ("" ::: "memory");
+		cc_learned_ready = true;
+	}
+
+	slot = &cc_slots[cc_map[channel][controller]];
+	if((slot->param == SYNTH_PARAM_NONE) && (controller >= CC_LSB_OFFSET) && (controller < 2 * CC_LSB_OFFSET)
+		&& (state->msb_controller == controller - CC_LSB_OFFSET))
+	{
+		//LSB of the last MSB, the pair goes to the MSB's slot
+		slot = &cc_slots[cc_map[channel][state->msb_controller]];
+		fine = (uint16_t) ((state->msb_value << 7) | (value & 0x7F));
+	}
+	else if(controller < CC_LSB_OFFSET)
+	{
+		state->msb_controller = controller;
+		state->msb_value = value & 0x7F;
+	}
+	if(slot->param == SYNTH_PARAM_NONE) return;
+	if(slot->param != SYNTH_PARAM_AUTOMATION) automation_record(&automation, channel, controller, value & 0x7F);
+
+	if((slot->low != 0) || (slot->high != 127))
+	{
+		range = (int32_t) slot->high - slot->low;
+		fine = (uint16_t) ((slot->low << 7) + ((range >= 0) ? (range * fine + 63) / 127 : -((-range * fine + 63) / 127)));
+	}
+	param_apply(channel, (enum synth_param) slot->param, fine);
+}
+
+static bool cc_fixed( uint8_t channel, uint8_t controller, uint8_t value )
+{
+	//channel mode messages and the (N)RPN controllers, which the map never sees
+	struct cc_channel *state = &cc_channels[channel];
+
+	switch(controller)
+	{
+		case MIDI_CC_NRPN_MSB:
+		if(state->nrpn == CC_NRPN_NONE) state->nrpn = 0;
+		state->nrpn = (uint16_t) ((value << 7) | (state->nrpn & 0x7F));
+		break;
+
+		case MIDI_CC_NRPN_LSB:
+		if(state->nrpn == CC_NRPN_NONE) state->nrpn = 0;
+		state->nrpn = (uint16_t) ((state->nrpn & 0x3F80) | value);
+		break;
+
+		case MIDI_CC_RPN_MSB:
+		case MIDI_CC_RPN_LSB:
+		state->nrpn = CC_NRPN_NONE;
+		break;
+
+		case MIDI_CC_DATA_ENTRY:
+		case MIDI_CC_DATA_ENTRY + CC_LSB_OFFSET:
+		if(state->nrpn >= SYNTH_PARAM_COUNT) break;
+		if(controller == MIDI_CC_DATA_ENTRY) state->data_msb = value;
+		param_apply(channel, (enum synth_param) state->nrpn, (uint16_t) ((state->data_msb << 7) | ((controller == MIDI_CC_DATA_ENTRY) ? 0 : value)));
+		break;
+
+		case MIDI_CC_ALL_SOUND_OFF:
+		synth_all_sound_off(channel);
+		break;
+
+		case MIDI_CC_ALL_NOTES_OFF:
+		synth_all_notes_off(channel);
+		break;
+
+		default:
+		return controller > MIDI_CC_ALL_SOUND_OFF;
+	}
+	return true;
+}
+
+bool synth_cc_request( uint8_t channel, uint8_t controller, enum synth_param param, uint8_t low, uint8_t high )
+{
+	//any task, one request at a time: false while the last is still waiting for the next
+	//control tick. SYNTH_PARAM_NONE unmaps the controller
+	if(cc_request_pending) return false;
+
+	cc_request.channel = (int8_t) (channel & 0x0F);
+	cc_request.controller = controller;
+	cc_request.param = (uint8_t) ((param < SYNTH_PARAM_COUNT) ? param : SYNTH_PARAM_NONE);
+	cc_request.low = (low > 127) ? 127 : low;
+	cc_request.high = (high > 127) ? 127 : high;
+	__asm volatile ("" ::: "memory");
+	cc_request_pending = true;
+	return true;
+}
+
+bool synth_cc_learned( uint8_t *channel, uint8_t *controller, enum synth_param *param )
+{
+	//any task, true once for each learn that completed
+	if(cc_learned_ready == false) return false;
+
+	*channel = cc_learned_channel;
+	*controller = cc_learned_controller;
+	*param = (enum synth_param) cc_learned_param;
+	__asm volatile ("" ::: "memory");
+	cc_learned_ready = false;
+	return true;
+}
+
+enum synth_param synth_cc_param( uint8_t channel, uint8_t controller, uint8_t *low, uint8_t *high )
+{
+	//for display, a mapping changed meanwhile may show the old range
+	const struct cc_slot *slot = &cc_slots[cc_map[channel & 0x0F][controller & 0x7F]];
+
+	*low = slot->low;
+	*high = slot->high;
+	return (enum synth_param) slot->param;
+}
+
+static void cc_init( void )
+{
+	//slot n is parameter n at full range, every channel gets the default controller numbers
+	int c;
+	int p;
+
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++) for(p=0; p<128; p++) cc_map[c][p] = SYNTH_PARAM_NONE;
+	for(p=0; p<CC_SLOTS; p++)
+	{
+		cc_slots[p].param = SYNTH_PARAM_NONE;
+		cc_slot_refs[p] = 0;
+	}
+	for(p=1; p<SYNTH_PARAM_COUNT; p++)
+	{
+		cc_slots[p].param = (uint8_t) p;
+		cc_slots[p].high = 127;
+		for(c=0; c<SYNTH_MIDI_CHANNELS; c++) cc_map[c][param_default_cc[p]] = (uint8_t) p;
+	}
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++)
+	{
+		cc_channels[c].msb_controller = 0xFF;
+		cc_channels[c].nrpn = CC_NRPN_NONE;
+		cc_channels[c].data_msb = 0;
+	}
+	cc_learn.channel = -1;
+	cc_request_pending = false;
+	cc_learned_ready = false;
+}
+
+static void cc_service( void )
+{
+	//control tick, takes a request posted by another task
+	if(cc_request_pending == false) return;
+
+	if(cc_request.controller == SYNTH_CC_LEARN) cc_learn = cc_request;
+	else cc_assign((uint8_t) cc_request.channel, cc_request.controller & 0x7F, (enum synth_param) cc_request.param, cc_request.low, cc_request.high);
+
+	__asm volatile ("" ::: "memory");
+	cc_request_pending = false;
+}
+
+static void cc_assign( uint8_t channel, uint8_t controller, enum synth_param param, uint8_t low, uint8_t high )
+{
+	//full range uses the parameter's own slot, a scaled one shares an equal slot or takes a
+	//free one; with none free it falls back to full range
+	int slot = param;
+	int old = cc_map[channel][controller];
+	int i;
+
+	if((param != SYNTH_PARAM_NONE) && ((low != 0) || (high != 127)))
+	{
+		for(i=SYNTH_PARAM_COUNT; i<CC_SLOTS; i++)
+		{
+			if((cc_slot_refs[i] != 0) && (cc_slots[i].param == param) && (cc_slots[i].low == low) && (cc_slots[i].high == high)) break;
+		}
+		if(i == CC_SLOTS)
+		{
+			for(i=SYNTH_PARAM_COUNT; i<CC_SLOTS; i++) if(cc_slot_refs[i] == 0) break;
+		}
+		if(i < CC_SLOTS)
+		{
+			slot = i;
+			cc_slots[i].param = (uint8_t) param;
+			cc_slots[i].low = low;
+			cc_slots[i].high = high;
+		}
+	}
+
+	cc_map[channel][controller] = (uint8_t) slot;
+	if(slot >= SYNTH_PARAM_COUNT) cc_slot_refs[slot]++;
+	if(old >= SYNTH_PARAM_COUNT) cc_slot_refs[old]--;
+}
+
+static void param_apply( uint8_t channel, enum synth_param param, uint16_t fine )
+{
+	//one controller move on a parameter, 14 bits already scaled to the slot's range. Most
+	//take the top 7; the continuous ones take all of them, saturating over the last 127 steps
+	//so an MSB alone lands exactly where a 7-bit controller did
+	uint8_t value = (uint8_t) (fine >> 7);
+	uint32_t full = (fine > CC_FINE_FULL) ? CC_FINE_FULL : fine;
+
+	switch(param)
+	{
+		case SYNTH_PARAM_MOD_WHEEL:
+		mod_set_route(0, MOD_SRC_LFO1, MOD_DST_PITCH, (int16_t) ((full * SYNTH_MOD_WHEEL_DEPTH) / CC_FINE_FULL));
+		break;
+
+		case SYNTH_PARAM_PORTAMENTO_TIME:
+		//square law, 0 to 2 s
+		synth_portamento_time(channel, (uint32_t) (((uint64_t) full * full * 2000) / ((uint32_t) CC_FINE_FULL * CC_FINE_FULL)));
+		break;
+
+		case SYNTH_PARAM_PAN:
+		synth_set_pan(channel, value);
+		break;
+
+		case SYNTH_PARAM_OSC_QUALITY:
+		//the levels built in, spread evenly over the controller range
+		synth_set_osc_quality(channel, (value * (SYNTH_OSC_QUALITY_MAX + 1)) >> 7);
+		break;
+
+		case SYNTH_PARAM_POLYPHONY:
+		//voices in use on all channels, 0 for all of them
+		voice_alloc_set_limit(value ? value : SYNTH_MAX_VOICES);
+		break;
+
+		case SYNTH_PARAM_PULSE_WIDTH:
+		//64 is a square, either end 5% or 95% duty
+		synth_set_pulse_width(channel, ((int32_t) full - (64 << 7)) * MOD_PW_LIMIT / (63 << 7));
+		break;
+
+		case SYNTH_PARAM_FM_RATIO:
+		synth_set_fm(channel, (value >> 3) + 1, channels[channel & 0x0F].patch.fm_index);
+		break;
+
+		case SYNTH_PARAM_FM_INDEX:
+		synth_set_fm(channel, channels[channel & 0x0F].patch.fm_ratio, value);
+		break;
+
+		case SYNTH_PARAM_NOISE_HOLD:
+		//applies from the next note-on
+		channels[channel & 0x0F].patch.noise_hold = (value >= 64);
+		patch_dirty |= 1u << (channel & 0x0F);
+		break;
+
+		case SYNTH_PARAM_SAMPLE_START:
+		//applies from the next note-on
+		channels[channel & 0x0F].patch.sample_start = value;
+		patch_dirty |= 1u << (channel & 0x0F);
+		break;
+
+		case SYNTH_PARAM_PORTAMENTO:
+		synth_portamento(channel, value >= 64);
+		break;
+
+		case SYNTH_PARAM_CUTOFF:
+		//one semitone per MSB step, like a note number, and 1/256 semitone per fine step pair;
+		//glides there from the last CC setting
+		if(filter_cutoff_cc >= 0) filter_cutoff_glide += filter_cutoff_cc - (int32_t) (full << 1);
+		filter_cutoff_cc = (int32_t) (full << 1);
+		filter_set_cutoff(note_phase_increment_fine(0, (int) (full << 1)));
+		break;
+
+		case SYNTH_PARAM_VOLUME:
+		channel_volume(channel, full);
+		break;
+
+		case SYNTH_PARAM_RESONANCE:
+		svf_set_resonance(&master_filter, value);
+		break;
+
+		case SYNTH_PARAM_SUSTAIN:
+		synth_sustain(channel, value >= 64);
+		break;
+
+		case SYNTH_PARAM_FILTER_MODE:
+		master_filter.mode = value >> 5;
+		break;
+
+#if SYNTH_DELAY
+		case SYNTH_PARAM_DELAY_TIME:
+		//128 equal steps of the line, the shortest is one step
+		synth_set_delay((((uint32_t) value + 1) * SYNTH_DELAY_FRAMES >> 7) - 1, delay_feedback, delay_mix);
+		break;
+
+		case SYNTH_PARAM_DELAY_FEEDBACK:
+		synth_set_delay(delay_time, value, delay_mix);
+		break;
+
+		case SYNTH_PARAM_DELAY_MIX:
+		synth_set_delay(delay_time, delay_feedback, value);
+		break;
+#endif
+
+#if SYNTH_SHAPER
+		case SYNTH_PARAM_SHAPER_DRIVE:
+		//unity up to about 16x
+		synth_set_shaper(shaper_curve, (1l << SHAPER_DRIVE_SHIFT) + (int32_t) value * 30, shaper_bits, shaper_hold);
+		break;
+
+		case SYNTH_PARAM_SHAPER_CURVE:
+		synth_set_shaper((enum shaper_curve) (value >> 5), shaper_drive, shaper_bits, shaper_hold);
+		break;
+
+		case SYNTH_PARAM_CRUSH_BITS:
+		//0 is the full 12 bits, 127 a single bit
+		synth_set_shaper(shaper_curve, shaper_drive, SHAPER_BITS - (value * (SHAPER_BITS - 1) + 63) / 127, shaper_hold);
+		break;
+
+		case SYNTH_PARAM_CRUSH_HOLD:
+		synth_set_shaper(shaper_curve, shaper_drive, shaper_bits, 1 + (value >> 1));
+		break;
+#endif
+
+#if SYNTH_LIMITER
+		case SYNTH_PARAM_LIMITER:
+		//16 code steps, 0 is off
+		synth_set_limiter((int32_t) (full >> 3));
+		break;
+#endif
+
+#if SYNTH_CHORUS
+		case SYNTH_PARAM_CHORUS_MIX:
+		synth_set_chorus(chorus_delay_us, chorus_depth_us, chorus_rate_chz, chorus_feedback, value);
+		break;
+
+		case SYNTH_PARAM_CHORUS_DEPTH:
+		//50 us steps, up to 6.35 ms of sweep
+		synth_set_chorus(chorus_delay_us, (uint32_t) value * 50, chorus_rate_chz, chorus_feedback, chorus_mix);
+		break;
+#endif
+
+		case SYNTH_PARAM_ARP_MODE:
+		arp_update((enum arp_mode) ((value * ARP_MODE_COUNT) >> 7), arp.division, arp.octaves);
+		break;
+
+		case SYNTH_PARAM_ARP_RATE:
+		arp_update((enum arp_mode) arp.mode, arp_divisions[value >> 4], arp.octaves);
+		break;
+
+		case SYNTH_PARAM_ARP_OCTAVES:
+		arp_update((enum arp_mode) arp.mode, arp.division, 1 + (value >> 5));
+		break;
+
+		case SYNTH_PARAM_DRAWBAR_1:
+		case SYNTH_PARAM_DRAWBAR_2:
+		case SYNTH_PARAM_DRAWBAR_3:
+		case SYNTH_PARAM_DRAWBAR_4:
+		case SYNTH_PARAM_DRAWBAR_5:
+		case SYNTH_PARAM_DRAWBAR_6:
+		case SYNTH_PARAM_DRAWBAR_7:
+		case SYNTH_PARAM_DRAWBAR_8:
+		case SYNTH_PARAM_DRAWBAR_9:
+		synth_set_drawbar(channel, param - SYNTH_PARAM_DRAWBAR_1, (uint8_t) ((value * 9) >> 7));
+		break;
+
+		case SYNTH_PARAM_SUB_LEVEL:
+		synth_set_sub(channel, value, (channels[channel & 0x0F].patch.sub & SUB_TWO_OCTAVES) != 0);
+		break;
+
+		case SYNTH_PARAM_SUB_OCTAVE:
+		synth_set_sub(channel, channels[channel & 0x0F].patch.sub & SUB_LEVEL_MASK, value >= 64);
+		break;
+
+		case SYNTH_PARAM_MORPH:
+		//sounding voices follow at control rate
+		channels[channel & 0x0F].morph_target = morph_position(value);
+		break;
+
+#if SYNTH_FORMANT
+		case SYNTH_PARAM_VOWEL:
+		synth_set_formant(value, formant_mix);
+		break;
+
+		case SYNTH_PARAM_FORMANT_MIX:
+		synth_set_formant((uint8_t) ((formant_target * 127 + FORMANT_POS_MAX / 2) / FORMANT_POS_MAX), value);
+		break;
+#endif
+
+#if SYNTH_REVERB
+		case SYNTH_PARAM_REVERB_MIX:
+		synth_set_reverb(reverb_size, reverb_damp, value);
+		break;
+
+		case SYNTH_PARAM_REVERB_SIZE:
+		synth_set_reverb(value, reverb_damp, reverb_mix);
+		break;
+#endif
+
+		case SYNTH_PARAM_GRAIN_SIZE:
+		//grains already out play at the size they started with
+		channels[channel & 0x0F].grain_size = value;
+		grain_update();
+		break;
+
+		case SYNTH_PARAM_GRAIN_DENSITY:
+		channels[channel & 0x0F].grain_density = value;
+		grain_update();
+		break;
+
+		case SYNTH_PARAM_GRAIN_SPRAY:
+		channels[channel & 0x0F].grain_spray = value;
+		grain_update();
+		break;
+
+		case SYNTH_PARAM_UNISON_DETUNE:
+		//sounding voices follow from their next block
+		channels[channel & 0x0F].unison_spread = (uint16_t) (value * UNISON_SPREAD_STEP);
+		break;
+
+		case SYNTH_PARAM_PATTERN:
+		pattern_select(value);
+		break;
+
+		case SYNTH_PARAM_AUTOMATION:
+		//off, play, or record a new take from this clock
+		automation_set_mode(&automation, (enum automation_mode) ((value * AUTOMATION_MODE_COUNT) >> 7));
+		break;
+
+		case SYNTH_PARAM_LFO_SYNC:
+		mod_set_lfo_sync(0, lfo_divisions[value >> 4]);
+		break;
+
+		case SYNTH_PARAM_DELAY_SYNC:
+		//0 leaves the delay at the time it had last
+		delay_sync = delay_divisions[value >> 4];
+		delay_follow();
+		break;
+
+		default:
+		break;
+	}
+}
+
+void synth_program_change( uint8_t channel, uint8_t program )
+{
+	//a stored preset replaces the channel's whole patch, any other program number only selects
+	//the waveform; either way sounding voices only follow the waveform, through a fade
+	const struct synth_patch *preset = (program < preset_count) ? preset_table[program] : NULL;
+
+	if(preset != NULL) channels[channel & 0x0F].patch = *preset;
+	else channels[channel & 0x0F].patch.wave = (enum wave_type) (program % WAVE_TYPE_COUNT);
+	patch_dirty |= 1u << (channel & 0x0F);
+	wave_swap_start(channel & 0x0F);
+}
+
+static void wave_swap_start( uint8_t channel )
+{
+	//starts the fade of the channel's held voices on another waveform, released notes finish
+	//on the sound they were released with; one fading back in turns round at the same level,
+	//one still fading out just carries on
+	enum wave_type wave = wave_playable(channels[channel].patch.wave);
+	uint8_t type;
+	int n;
+	int j;
+
+	if(!SYNTH_WAVE_SWAP_TICKS || !((1ul << wave) & SWAP_WAVES)) return;
+
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		j = voice_bank.active[n];
+		type = voice_bank.type[j];
+		if((voice_bank.channel[j] != channel) || (voice_bank.env_stage[j] == ENV_RELEASE)) continue;
+		if((type == wave) || !((1ul << type) & SWAP_WAVES)) continue;
+
+		if(voice_bank.swap_fade[j] <= SYNTH_WAVE_SWAP_TICKS) voice_bank.swap_fade[j] = 2 * SYNTH_WAVE_SWAP_TICKS - voice_bank.swap_fade[j];
+	}
+}
+
+static void voice_wave_swap( int voice )
+{
+	//halfway through the fade, while silent: the voice takes its channel's waveform and the
+	//second oscillator that goes with it, the phases carry on
+	const struct synth_channel *ch = &channels[voice_bank.channel[voice]];
+
+	if(!((1ul << ch->patch.wave) & SWAP_WAVES)) return;
+
+	voice_batch_remove(voice);
+	voice_osc2(voice, ch);
+	voice_batch_add(voice, ch->patch.wave);
+}
+
+void synth_set_presets( const struct synth_patch *const *presets, int count )
+{
+	//entry n is program n; entries may be swapped from another task, the engine reads each one
+	//pointer once per program change and the patch behind it must stay put until the next
+	preset_table = presets;
+	preset_count = count;
+}
+
+void synth_get_patch( uint8_t channel, struct synth_patch *patch )
+{
+	//any task; the copy as of the last block boundary, taken again if the renderer republished
+	//meanwhile, so it is never half of one controller move and half of the next
+	uint32_t sequence;
+
+	do{
+		sequence = patch_sequence;
+		__asm volatile ("" ::: "memory");
+		*patch = patch_published[channel & 0x0F];
+		__asm volatile ("" ::: "memory");
+	}while((sequence & 1) || (sequence != patch_sequence));
+}
+
+static void patch_publish( void )
+{
+	//renderer, between blocks; never waits, a reader it interrupted just retries
+	int c;
+
+	if(patch_dirty == 0) return;
+
+	patch_sequence++;
+	__asm volatile ("" ::: "memory");
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++)
+	{
+		if(patch_dirty & (1u << c)) patch_published[c] = channels[c].patch;
+	}
+	__asm volatile ("" ::: "memory");
+	patch_sequence++;
+	patch_dirty = 0;
+}
+
+#if SYNTH_METERS
+void synth_levels( struct synth_levels *levels )
+{
+	//any task; the peaks held since the last call and the last block's rms, the outputs in DAC
+	//units from midscale and the voices as Q15 gain. The holds start over with the next block
+	int i;
+	uint16_t ticks;
+
+	for(i=0; i<SYNTH_OUTPUT_CHANNELS; i++)
+	{
+		levels->output[i].peak = output_hold[i];
+		levels->output[i].rms = level_sqrt(output_last[i] / SYNTH_BLOCK_SIZE);
+	}
+	for(i=0; i<SYNTH_MAX_VOICES; i++)
+	{
+		ticks = voice_last_ticks[i];
+		levels->voice[i].peak = voice_hold[i];
+		levels->voice[i].rms = ticks ? level_sqrt((voice_last[i] / ticks) << 15) : 0;
+	}
+	level_taken++;
+}
+
+uint16_t synth_block_peak( void )
+{
+	//the last block's largest output sample, in DAC units from midscale
+	return block_peak;
+}
+
+SYNTH_RAM_CODE static void levels_publish( void )
+{
+	//renderer, between blocks; one pass over the channels and voices, the square roots are the
+	//reader's. A late block leaves the voices' pass to the next one, their sums carry over
+	//and count their own ticks
+	bool restart = (level_taken != level_seen);
+	uint32_t top = 0;
+	int i;
+
+	level_seen = level_taken;
+	for(i=0; i<SYNTH_OUTPUT_CHANNELS; i++)
+	{
+		if(output_peak[i] > top) top = output_peak[i];
+		if(restart || (output_peak[i] > output_hold[i])) output_hold[i] = (uint16_t) output_peak[i];
+		output_last[i] = output_sum[i];
+		output_peak[i] = 0;
+		output_sum[i] = 0;
+	}
+	block_peak = (uint16_t) top;
+
+	if(effects_deferred()) return;
+	restart = (level_taken != voice_level_seen);
+	voice_level_seen = level_taken;
+	for(i=0; i<SYNTH_MAX_VOICES; i++)
+	{
+		if(restart || (voice_peak[i] > voice_hold[i])) voice_hold[i] = voice_peak[i];
+		voice_last[i] = voice_sum[i];
+		voice_last_ticks[i] = voice_ticks[i];
+		voice_peak[i] = 0;
+		voice_sum[i] = 0;
+		voice_ticks[i] = 0;
+	}
+}
+
+static uint16_t level_sqrt( uint32_t x )
+{
+	//integer square root, one result bit per step from the top; no divide for the M0+
+	uint32_t root = 0;
+	uint32_t bit = 1ul << 30;
+
+	while(bit > x) bit >>= 2;
+	while(bit)
+	{
+		if(x >= root + bit)
+		{
+			x -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else root >>= 1;
+		bit >>= 2;
+	}
+
+	return (uint16_t) root;
+}
+#endif
+
+#if SYNTH_VOICE_SNAPSHOT
+void synth_snapshot_request( void )
+{
+	//any task; the renderer copies the voices at the end of its next block
+	snapshot_wanted = true;
+}
+
+uint32_t synth_snapshot_read( struct synth_snapshot *snapshot )
+{
+	//any task; the latest copy, taken again if the renderer republished meanwhile. Returns its
+	//sequence count, which moves with every copy, 0 while there has been none
+	uint32_t sequence;
+
+	do{
+		sequence = snapshot_sequence;
+		__asm volatile ("" ::: "memory");
+		*snapshot = snapshot_published;
+		__asm volatile ("" ::: "memory");
+	}while((sequence & 1) || (sequence != snapshot_sequence));
+
+	return sequence;
+}
+
+static void snapshot_publish( void )
+{
+	//renderer, between blocks and only when asked
+	struct synth_voice_state *state;
+	int j;
+
+	snapshot_sequence++;
+	__asm volatile ("" ::: "memory");
+	snapshot_published.render_time = render_time;
+	snapshot_published.active_count = voice_bank.active_count;
+	for(j=0; j<SYNTH_MAX_VOICES; j++)
+	{
+		state = &snapshot_published.voice[j];
+		state->enable = voice_bank.enable[j];
+		state->gate = voice_bank.gate[j];
+		state->note = voice_bank.note[j];
+		state->channel = voice_bank.channel[j];
+		state->velocity = voice_bank.velocity[j];
+		state->type = voice_bank.type[j];
+		state->env_stage = voice_bank.env_stage[j];
+		state->swap_fade = voice_bank.swap_fade[j];
+		state->env_level = voice_bank.env_level[j];
+		state->gain = voice_bank.gain[j];
+		state->inc = voice_bank.inc[j];
+		state->glide = voice_bank.glide[j];
+		state->mod_pitch = voice_bank.mod_pitch[j];
+		state->mod_amp = voice_bank.mod_amp[j];
+		state->pressure = voice_bank.pressure[j];
+	}
+	__asm volatile ("" ::: "memory");
+	snapshot_sequence++;
+	snapshot_wanted = false;
+}
+#endif
+
+void synth_pitch_bend( uint8_t channel, int16_t bend )
+{
+	//re-derives the increment of the channel's sounding voices from their note and the bend offset
+	int j;
+	int n;
+
+	channel &= 0x0F;
+	channels[channel].bend_fine = (bend * SYNTH_PITCH_BEND_RANGE) >> 5;
+
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		j = voice_bank.active[n];
+		if(voice_bank.channel[j] == channel) voice_retune(j);
+	}
+}
+
+static void voice_retune( int voice )
+{
+	//increment from the note, its channel's bend offset and its own MPE bend, the table octave
+	//follows the increment; a drum's pitch is its sweep's alone
+	if(voice_bank.type[voice] == DRUM) return;
+
+	voice_bank.inc[voice] = note_tuned_increment_fine(voice_bank.note[voice], channels[voice_bank.channel[voice]].bend_fine + voice_bank.note_bend[voice] + voice_bank.mod_pitch[voice]);
+	voice_bank.fm_inc[voice] = osc2_increment((enum wave_type) voice_bank.type[voice], voice_bank.inc[voice], voice_bank.fm_ratio[voice]);
+	if((voice_bank.type[voice] == SAMPLE) || (voice_bank.type[voice] == STREAM) || (voice_bank.type[voice] == GRAIN)) voice_sample_step(voice);
+#if SYNTH_WAVETABLES
+	if(voice_bank.type[voice] <= TRI) voice_bank.table[voice] = wavetable_select(voice_bank.type[voice], voice_bank.inc[voice]);
+	else if(voice_bank.type[voice] == MORPH) voice_bank.table[voice] = wavetable_select(SQUARE, voice_bank.inc[voice]);
+#endif
+}
+
+static void voice_osc2( int voice, const struct synth_channel *ch )
+{
+	//second oscillator settings from the patch; SYNC and RING keep their ratio as 16 + index
+	voice_bank.fm_ratio[voice] = ((ch->patch.wave == SYNC) || (ch->patch.wave == RING)) ? 16 + ch->patch.fm_index : ch->patch.fm_ratio;
+	voice_bank.fm_inc[voice] = osc2_increment(ch->patch.wave, voice_bank.inc[voice], voice_bank.fm_ratio[voice]);
+	voice_bank.fm_depth[voice] = ch->patch.fm_index * FM_DEPTH_PER_INDEX;
+	voice_bank.noise_hold[voice] = ch->patch.noise_hold;
+}
+
+static uint32_t osc2_increment( enum wave_type type, uint32_t inc, uint8_t ratio )
+{
+	//the FM modulator at 'ratio' times the carrier, the SYNC and RING second oscillator at
+	//'ratio' sixteenths of the note and below half the sample rate
+	uint64_t slave;
+
+	if((type != SYNC) && (type != RING)) return inc * ratio;
+
+	slave = ((uint64_t) inc * ratio) >> 4;
+	return (slave >= PHASE_HALF_CYCLE) ? PHASE_HALF_CYCLE - 1 : (uint32_t) slave;
+}
+
+SYNTH_RAM_CODE static void voice_sample_step( int voice )
+{
+	//step = (f / f_root) * (rate / fs) in Q12 frames, from the voice's increment so bend,
+	//glide and modulation carry over; one 64-bit division whenever the pitch changes
+	const struct pcm_sample *pcm = voice_bank.pcm[voice];
+	uint64_t num = ((uint64_t) voice_bank.inc[voice] * pcm->rate) << PCM_FRAC_BITS;
+	uint64_t den = (uint64_t) note_phase_increment(pcm->root_note) * sample_rate;
+
+	voice_bank.pcm_step[voice] = den ? (uint32_t) (num / den) : 0;
+}
+
+void synth_set_master_gain( uint16_t gain )
+{
+	//bounded so the gain multiply cannot overflow the 32-bit mix
+	master_gain_target = (gain > SYNTH_MASTER_GAIN_MAX) ? SYNTH_MASTER_GAIN_MAX : gain;
+}
+
+SYNTH_RAM_CODE void synth_render_block( uint16_t *frame )
+{
+	//fills one frame with SYNTH_BLOCK_SIZE samples for all enabled voices
+	int period;
+	int pos;
+	int next;
+	uint32_t now = render_time;
+	int32_t *mix = mix_buffer;
+
+	PROFILE_ENTER(PROFILE_BLOCK);
+	if(sample_rate_request != sample_rate) sample_rate_apply(sample_rate_request);
+#if SYNTH_DEADLINE
+	render_deferring = false;
+#endif
+
+	for(period=0; period<SYNTH_BLOCK_SIZE; period+=SYNTH_CONTROL_PERIOD)
+	{
+		PROFILE_ENTER(PROFILE_CONTROL);
+		control_tick(now + period);
+		PROFILE_LEAVE();
+
+		//audio tick, oscillators and mix only; split where a timed event falls inside the
+		//period so it takes effect on its own sample. A period with nothing sounding and no
+		//event to apply is midscale without rendering
+		PROFILE_ENTER(PROFILE_EVENTS);
+		next = apply_events(now + period, SYNTH_CONTROL_PERIOD);
+		PROFILE_LEAVE();
+		if((next == SYNTH_CONTROL_PERIOD) && output_idle())
+		{
+			period_left = SYNTH_CONTROL_PERIOD;
+			output_skip(&frame[period * SYNTH_OUTPUT_CHANNELS]);
+			continue;
+		}
+
+		mix_clear(mix);
+
+		pos = 0;
+		while(pos < SYNTH_CONTROL_PERIOD)
+		{
+			PROFILE_ENTER(PROFILE_EVENTS);
+			next = apply_events(now + period + pos, SYNTH_CONTROL_PERIOD - pos);
+			PROFILE_LEAVE();
+			render_segment(&mix[pos], next);
+			pos += next;
+		}
+		period_left = SYNTH_CONTROL_PERIOD;
+
+#if SYNTH_DEADLINE
+		//the voices are done, the effects only go in while there is time for them
+		if(!render_deferring && (deadline_cycles != NULL)) render_deferring = ((int32_t) (deadline_cycles() - deadline_at) >= 0);
+#endif
+#if SYNTH_AUDIO_INPUT
+		input_period = (input_block != NULL) ? &input_block[period] : NULL;
+#endif
+		PROFILE_ENTER(PROFILE_OUTPUT);
+		mix_output(mix, &frame[period * SYNTH_OUTPUT_CHANNELS]);
+		PROFILE_LEAVE();
+	}
+
+#if SYNTH_AUDIO_INPUT
+	input_block = NULL;
+#endif
+	render_time = now + SYNTH_BLOCK_SIZE;
+#if SYNTH_DEADLINE
+	render_was_late = render_deferring;
+	deadline_cycles = NULL;
+#endif
+#if SYNTH_METERS
+	levels_publish();
+#endif
+#if SYNTH_VOICE_SNAPSHOT
+	//a late block leaves the reader to wait for the next one
+	if(snapshot_wanted && !effects_deferred()) snapshot_publish();
+#endif
+	patch_publish();
+	PROFILE_LEAVE();
+}
+
+SYNTH_RAM_CODE static void render_segment( int32_t *mix, int count )
+{
+	//one indirect call per waveform with voices in it, the kernels then run without any
+	//per-sample dispatch
+	int type;
+
+	PROFILE_ENTER(PROFILE_VOICES);
+	PROFILE_ENTER(PROFILE_SUB);
+	render_sub(mix, count);
+	PROFILE_LEAVE();
+	for(type=0; type<WAVE_TYPE_COUNT; type++)
+	{
+		if(voice_bank.batch_start[type] == voice_bank.batch_start[type + 1]) continue;
+		PROFILE_ENTER(PROFILE_OSC + type);
+		batch_render[type](type, mix, count);
+		PROFILE_LEAVE();
+	}
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+	if(os_fresh || os_tail)
+	{
+		PROFILE_ENTER(PROFILE_DECIMATE);
+		os_decimate(mix, count);
+		PROFILE_LEAVE();
+	}
+#endif
+	PROFILE_LEAVE();
+}
+
+SYNTH_RAM_CODE static void render_sub( int32_t *mix, int count )
+{
+	//runs ahead of the kernels over the same phase they will advance, so the edges fall on the
+	//samples where the voice's own wave wraps; the square is only worked out at an edge
+	const struct synth_channel *ch;
+	int n;
+	int i;
+	int v;
+	int shift;
+	int32_t *out;
+	uint32_t phase;
+	uint32_t inc;
+	uint8_t wraps;
+	int32_t level;
+	int32_t s;
+	int32_t gain;
+	int32_t step;
+
+	for(n=0; n<voice_bank.active_count; n++)
+	{
+		v = voice_bank.active[n];
+		ch = &channels[voice_bank.channel[v]];
+		if(ch->sub_gain == 0) continue;
+		if(!((1ul << voice_bank.type[v]) & SUB_WAVES)) continue;
+
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment, the kernel leaves the phase where it is too
+		if((gain | step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v];
+		wraps = voice_bank.sub_count[v];
+		shift = (ch->patch.sub & SUB_TWO_OCTAVES) ? 1 : 0;
+		level = ch->sub_gain;
+		s = (((wraps >> shift) & 1) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1)) * level >> SUB_GAIN_SHIFT;
+
+		for(i=0; i<count; i++)
+		{
+			out[i] += (s * gain) >> MIX_SHIFT;
+			gain += step;
+			phase += inc;
+			if(phase < inc)
+			{
+				wraps++;
+				s = (((wraps >> shift) & 1) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1)) * level >> SUB_GAIN_SHIFT;
+			}
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.sub_count[v] = wraps;
+	}
+}
+
+static int apply_events( uint32_t now, uint32_t limit )
+{
+	//applies every queued event due at or before 'now', returns the samples until the next
+	//one is due, at most 'limit'; of the two queues and the internal clock the earliest goes
+	//first, so an arpeggio step lands on its own sample whichever clock drives it
+	uint16_t tail = event_tail;
+	uint16_t rt_tail = realtime_tail;
+	struct midi_event realtime = { 0 };
+	bool rt;
+	int32_t until;
+
+	period_left = (int) limit;
+
+#if SYNTH_FAST_NOTE_ON
+	while(fast_tail != fast_head)
+	{
+		event_at = now;
+		synth_handle_event(&fast_queue[fast_tail & (SYNTH_FAST_NOTE_QUEUE_SIZE - 1)]);
+		__asm volatile ("" ::: "memory");
+		fast_tail++;
+	}
+#endif
+
+	while((tail != event_head) || (rt_tail != realtime_head) || clock_free)
+	{
+		rt = (rt_tail != realtime_head) && ((tail == event_head) ||
+			((int32_t) (realtime_time[rt_tail & (SYNTH_REALTIME_QUEUE_SIZE - 1)] - event_time[tail & (SYNTH_EVENT_QUEUE_SIZE - 1)]) < 0));
+
+		if(clock_free && (((tail == event_head) && (rt_tail == realtime_head)) ||
+			((int32_t) (clock_next - (rt ? realtime_time[rt_tail & (SYNTH_REALTIME_QUEUE_SIZE - 1)] : event_time[tail & (SYNTH_EVENT_QUEUE_SIZE - 1)])) < 0)))
+		{
+			until = (int32_t) (clock_next - now);
+			if(until > 0) return (until < (int32_t) limit) ? (int) until : (int) limit;
+
+			event_at = clock_next;
+			clock_internal();
+			continue;
+		}
+
+		event_at = rt ? realtime_time[rt_tail & (SYNTH_REALTIME_QUEUE_SIZE - 1)] : event_time[tail & (SYNTH_EVENT_QUEUE_SIZE - 1)];
+
+		until = (int32_t) (event_at - now);
+		if(until > 0) return (until < (int32_t) limit) ? (int) until : (int) limit;
+		if((uint32_t) -until > event_late_max) event_late_max = (uint32_t) -until;
+
+		if(rt)
+		{
+			realtime.status = realtime_queue[rt_tail & (SYNTH_REALTIME_QUEUE_SIZE - 1)];
+			synth_handle_event(&realtime);
+			__asm volatile ("" ::: "memory");
+			realtime_tail = ++rt_tail;
+		}
+		else
+		{
+			synth_handle_event(&event_queue[tail & (SYNTH_EVENT_QUEUE_SIZE - 1)]);
+			__asm volatile ("" ::: "memory");
+			event_tail = ++tail;
+		}
+	}
+
+	return (int) limit;
+}
+
+#if SYNTH_DITHER
+SYNTH_RAM_CODE static void mix_dither( int32_t *mix, int channel )
+{
+	//master gain at full resolution, then rounded to DAC units with TPDF dither, the
+	//difference of two uniform 12-bit fields of one xorshift step (an LFSR that advances a
+	//whole word per step); the shaped variant subtracts the last error first, so the error
+	//reaches the output differentiated
+	uint32_t r = dither_random;
+	int32_t e = dither_error[channel];
+	int32_t w;
+	int32_t y;
+	int i;
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++)
+	{
+		r ^= r << 13;
+		r ^= r >> 17;
+		r ^= r << 5;
+
+		w = mix[i] * master_gain;
+#if (SYNTH_DITHER == SYNTH_DITHER_SHAPED)
+		w -= e;
+#endif
+		y = (w + (int32_t) (r & DITHER_MASK) - (int32_t) ((r >> 16) & DITHER_MASK) + (1l << (DITHER_SHIFT - 1))) >> DITHER_SHIFT;
+		e = (y << DITHER_SHIFT) - w;
+		mix[i] = y;
+	}
+
+	dither_random = r;
+	dither_error[channel] = e;
+}
+#endif
+
+#if SYNTH_DC_BLOCK
+static void dc_block_set_rate( uint32_t rate )
+{
+	//one-pole corner at rate / (2 pi 2^shift), the smallest shift that puts it at or under
+	//SYNTH_DC_BLOCK_HZ
+	uint8_t shift = 1;
+
+	while(rate > ((uint32_t) (SYNTH_DC_BLOCK_HZ * 628 / 100) << shift)) shift++;
+	dc_block_shift = shift;
+}
+
+SYNTH_RAM_CODE static void mix_dc_block( int32_t *mix, int channel )
+{
+	//output less a one-pole lowpass of itself, a first order highpass with its zero at DC;
+	//adds and shifts only. The mean is rounded, a floored one settles just under zero and
+	//leaves a code of offset on a silent output
+	int32_t level = dc_level[channel];
+	uint8_t shift = dc_block_shift;
+	int i;
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++)
+	{
+		level += ((mix[i] << DC_FRAC_BITS) - level) >> shift;
+		mix[i] -= (level + (1l << (DC_FRAC_BITS - 1))) >> DC_FRAC_BITS;
+	}
+
+	dc_level[channel] = level;
+}
+#endif
+
+static bool output_idle( void )
+{
+	//no voice sounding and every output stage at rest, so a silent period through them would
+	//come out silent and leave them as they are; dither is never silent
+#if SYNTH_DITHER
+	return false;
+#else
+	int c;
+
+#if SYNTH_AUDIO_INPUT
+	if(input_block != NULL) return false;
+#endif
+	if(voice_bank.batch_start[WAVE_TYPE_COUNT]) return false;
+
+	if(!svf_idle(&master_filter)) return false;
+#if SYNTH_STEREO
+	if(!svf_idle(&master_filter_right)) return false;
+#endif
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++)
+	{
+#if SYNTH_SHAPER
+		if(!shaper_idle(&master_shaper[c])) return false;
+#endif
+#if SYNTH_FORMANT
+		if(!formant_idle(&master_formant[c])) return false;
+#endif
+#if SYNTH_CHORUS
+		if(!chorus_idle(&master_chorus[c])) return false;
+#endif
+#if SYNTH_DELAY
+		if(!delay_idle(&master_delay[c])) return false;
+#endif
+#if SYNTH_REVERB
+		if(!reverb_idle(&master_reverb[c])) return false;
+#endif
+#if SYNTH_DC_BLOCK
+		if((dc_level[c] > 0) || (dc_level[c] <= -(1l << dc_block_shift))) return false;
+#endif
+#if SYNTH_LIMITER
+		if(!limiter_idle(&master_limiter[c])) return false;
+#endif
+	}
+
+	return true;
+#endif
+}
+
+static void output_skip( uint16_t *out )
+{
+	//the period's codes are midscale, the stages that keep time move on as if it had been
+	//rendered
+	int i;
+
+	for(i=0; i<SYNTH_OUTPUT_CHANNELS * SYNTH_CONTROL_PERIOD; i++) out[i] = DAC_MIDSCALE;
+
+#if SYNTH_SHAPER || SYNTH_CHORUS
+	for(i=0; i<SYNTH_OUTPUT_CHANNELS; i++)
+	{
+#if SYNTH_SHAPER
+		shaper_skip(&master_shaper[i], SYNTH_CONTROL_PERIOD);
+#endif
+#if SYNTH_CHORUS
+		chorus_skip(&master_chorus[i], SYNTH_CONTROL_PERIOD);
+#endif
+	}
+#endif
+}
+
+#if SYNTH_USE_CMSIS_DSP
+SYNTH_RAM_CODE static void mix_clear( int32_t *mix )
+{
+	arm_fill_q31(0, mix, SYNTH_OUTPUT_CHANNELS * SYNTH_CONTROL_PERIOD);
+}
+
+SYNTH_RAM_CODE static void mix_channel_output( int32_t *mix, int channel, struct svf *filter, uint16_t *out, int stride )
+{
+	//master gain as Q31 fraction gain/1024 shifted by 2 - MIX_FRAC_BITS, which lands in DAC units
+#if !SYNTH_MIX_ASM && !SYNTH_METERS
+	q15_t *codes = (q15_t *) out;
+#if SYNTH_STEREO
+	int i;
+
+	//interleaved, the codes are spread out once they are done
+	if(stride != 1) codes = mix_codes;
+#endif
+#endif
+
+	PROFILE_ENTER(PROFILE_GAIN);
+#if SYNTH_DITHER
+	mix_dither(mix, channel);
+#else
+	arm_scale_q31(mix, master_gain << 21, 2 - MIX_FRAC_BITS, mix, SYNTH_CONTROL_PERIOD);
+#endif
+	PROFILE_LEAVE();
+#if SYNTH_AUDIO_INPUT
+	if(input_period != NULL) mix_input(mix);
+#endif
+
+#if SYNTH_SHAPER
+	PROFILE_ENTER(PROFILE_SHAPER);
+	shaper_process(&master_shaper[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+	PROFILE_ENTER(PROFILE_FILTER);
+	svf_process(filter, mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#if SYNTH_FORMANT
+	PROFILE_ENTER(PROFILE_FORMANT);
+	if(!effects_deferred()) formant_process(&master_formant[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_CHORUS
+	PROFILE_ENTER(PROFILE_CHORUS);
+	if(!effects_deferred()) chorus_process(&master_chorus[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_DELAY
+	PROFILE_ENTER(PROFILE_DELAY);
+	delay_process(&master_delay[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_REVERB
+	PROFILE_ENTER(PROFILE_REVERB);
+	if(!effects_deferred()) reverb_process(&master_reverb[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_DC_BLOCK
+	PROFILE_ENTER(PROFILE_DC_BLOCK);
+	mix_dc_block(mix, channel);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_LIMITER
+	PROFILE_ENTER(PROFILE_LIMITER);
+	limiter_process(&master_limiter[channel], mix);
+	PROFILE_LEAVE();
+#endif
+
+	PROFILE_ENTER(PROFILE_CODES);
+
+#if SYNTH_METERS
+	dac_codes_meter(mix, out, stride, SYNTH_CONTROL_PERIOD, &output_peak[channel], &output_sum[channel]);
+#elif SYNTH_MIX_ASM
+	dac_codes(mix, out, stride, SYNTH_CONTROL_PERIOD);
+#else
+	//saturating shift puts the 12-bit range at the top of the word, then back down to DAC codes
+	arm_shift_q31(mix, 20, mix, SYNTH_CONTROL_PERIOD);
+	arm_q31_to_q15(mix, codes, SYNTH_CONTROL_PERIOD);
+	arm_shift_q15(codes, -4, codes, SYNTH_CONTROL_PERIOD);
+	arm_offset_q15(codes, DAC_MIDSCALE, codes, SYNTH_CONTROL_PERIOD);
+
+#if SYNTH_STEREO
+	if(stride != 1)
+	{
+		for(i=0; i<SYNTH_CONTROL_PERIOD; i++) out[i * stride] = (uint16_t) codes[i];
+	}
+#endif
+#endif
+	PROFILE_LEAVE();
+}
+#else
+SYNTH_RAM_CODE static void mix_clear( int32_t *mix )
+{
+	int i;
+
+	for(i=0; i<SYNTH_OUTPUT_CHANNELS * SYNTH_CONTROL_PERIOD; i++) mix[i] = 0;
+}
+
+SYNTH_RAM_CODE static void mix_channel_output( int32_t *mix, int channel, struct svf *filter, uint16_t *out, int stride )
+{
+	//voices are summed at full resolution, headroom comes from the master gain only
+#if !SYNTH_DITHER
+	int i;
+#endif
+
+	PROFILE_ENTER(PROFILE_GAIN);
+#if SYNTH_DITHER
+	mix_dither(mix, channel);
+#else
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++) mix[i] = (mix[i] * master_gain) >> (MASTER_GAIN_SHIFT + MIX_FRAC_BITS);
+#endif
+	PROFILE_LEAVE();
+#if SYNTH_AUDIO_INPUT
+	if(input_period != NULL) mix_input(mix);
+#endif
+
+#if SYNTH_SHAPER
+	PROFILE_ENTER(PROFILE_SHAPER);
+	shaper_process(&master_shaper[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+	PROFILE_ENTER(PROFILE_FILTER);
+	svf_process(filter, mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#if SYNTH_FORMANT
+	PROFILE_ENTER(PROFILE_FORMANT);
+	if(!effects_deferred()) formant_process(&master_formant[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_CHORUS
+	PROFILE_ENTER(PROFILE_CHORUS);
+	if(!effects_deferred()) chorus_process(&master_chorus[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_DELAY
+	PROFILE_ENTER(PROFILE_DELAY);
+	delay_process(&master_delay[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_REVERB
+	PROFILE_ENTER(PROFILE_REVERB);
+	if(!effects_deferred()) reverb_process(&master_reverb[channel], mix, SYNTH_CONTROL_PERIOD);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_DC_BLOCK
+	PROFILE_ENTER(PROFILE_DC_BLOCK);
+	mix_dc_block(mix, channel);
+	PROFILE_LEAVE();
+#endif
+#if SYNTH_LIMITER
+	PROFILE_ENTER(PROFILE_LIMITER);
+	limiter_process(&master_limiter[channel], mix);
+	PROFILE_LEAVE();
+#endif
+
+	PROFILE_ENTER(PROFILE_CODES);
+
+#if SYNTH_METERS
+	dac_codes_meter(mix, out, stride, SYNTH_CONTROL_PERIOD, &output_peak[channel], &output_sum[channel]);
+#else
+	dac_codes(mix, out, stride, SYNTH_CONTROL_PERIOD);
+#endif
+	PROFILE_LEAVE();
+}
+#endif
+
+#if SYNTH_AUDIO_INPUT
+SYNTH_RAM_CODE static void mix_input( int32_t *mix )
+{
+	//one channel of the period in DAC units, the input at unity
+	int i;
+
+	for(i=0; i<SYNTH_CONTROL_PERIOD; i++) mix[i] += input_period[i];
+}
+#endif
+
+SYNTH_RAM_CODE static inline bool effects_deferred( void )
+{
+	//past this block's deadline, see synth_core.h for what waits
+#if SYNTH_DEADLINE
+	return render_deferring;
+#else
+	return false;
+#endif
+}
+
+SYNTH_RAM_CODE static void mix_output( int32_t *mix, uint16_t *out )
+{
+#if SYNTH_STEREO
+	//the right filter runs on the left one's coefficients, its cutoff ramps alongside
+	master_filter_right.f_to = master_filter.f_to;
+	master_filter_right.q = master_filter.q;
+	master_filter_right.q_set = master_filter.q_set;
+	master_filter_right.mode = master_filter.mode;
+
+	mix_channel_output(mix, 0, &master_filter, out, SYNTH_OUTPUT_CHANNELS);
+	mix_channel_output(&mix[SYNTH_CONTROL_PERIOD], 1, &master_filter_right, &out[1], SYNTH_OUTPUT_CHANNELS);
+#else
+	mix_channel_output(mix, 0, &master_filter, out, 1);
+#endif
+}
+
+#if SYNTH_STEREO
+SYNTH_RAM_CODE static int32_t *voice_out_begin( int32_t *mix, int count )
+{
+	//a voice renders on its own, voice_out_end() pans it into the mix
+	int i;
+
+	for(i=0; i<count; i++) voice_buffer[i] = 0;
+
+	return voice_buffer;
+}
+
+SYNTH_RAM_CODE static void voice_out_end( int voice, int32_t *mix, int32_t *out, int count )
+{
+	//the right half of the mix starts SYNTH_CONTROL_PERIOD after the left, the pan gains
+	//carry on along their ramps from segment to segment
+	int32_t left = voice_bank.pan_left[voice];
+	int32_t right = voice_bank.pan_right[voice];
+	int32_t left_step = voice_bank.pan_left_step[voice];
+	int32_t right_step = voice_bank.pan_right_step[voice];
+	int i;
+
+	PROFILE_ENTER(PROFILE_MIX);
+	for(i=0; i<count; i++)
+	{
+		mix[i] += (out[i] * left) >> PAN_SHIFT;
+		mix[SYNTH_CONTROL_PERIOD + i] += (out[i] * right) >> PAN_SHIFT;
+		left += left_step;
+		right += right_step;
+	}
+
+	voice_bank.pan_left[voice] = (int16_t) left;
+	voice_bank.pan_right[voice] = (int16_t) right;
+	PROFILE_LEAVE();
+}
+#else
+SYNTH_RAM_CODE static int32_t *voice_out_begin( int32_t *mix, int count )
+{
+	//mono voices add straight into the mix
+	return mix;
+}
+
+SYNTH_RAM_CODE static void voice_out_end( int voice, int32_t *mix, int32_t *out, int count )
+{
+}
+#endif
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+SYNTH_RAM_CODE static int32_t *voice_os_begin( int count )
+{
+	//an oversampled voice renders 2 * count samples at half its increments and gain step
+	int i;
+
+	for(i=0; i<2*count; i++) os_voice[i] = 0;
+
+	return os_voice;
+}
+
+SYNTH_RAM_CODE static void voice_os_end( int voice, int32_t *out, int count )
+{
+	//onto the decimator's line after its history, panned like voice_out_end()
+	int i;
+#if SYNTH_STEREO
+	int32_t left = voice_bank.pan_left[voice];
+	int32_t right = voice_bank.pan_right[voice];
+	int32_t left_step = voice_bank.pan_left_step[voice];
+	int32_t right_step = voice_bank.pan_right_step[voice];
+
+	//one step of the pan ramps a pair
+	for(i=0; i<2*count; i+=2)
+	{
+		os_line[0][OS_HISTORY + i] += (out[i] * left) >> PAN_SHIFT;
+		os_line[1][OS_HISTORY + i] += (out[i] * right) >> PAN_SHIFT;
+		os_line[0][OS_HISTORY + i + 1] += (out[i + 1] * left) >> PAN_SHIFT;
+		os_line[1][OS_HISTORY + i + 1] += (out[i + 1] * right) >> PAN_SHIFT;
+		left += left_step;
+		right += right_step;
+	}
+
+	voice_bank.pan_left[voice] = (int16_t) left;
+	voice_bank.pan_right[voice] = (int16_t) right;
+#else
+	(void) voice;
+	for(i=0; i<2*count; i++) os_line[0][OS_HISTORY + i] += out[i];
+#endif
+	os_fresh = true;
+}
+
+SYNTH_RAM_CODE static void os_decimate( int32_t *mix, int count )
+{
+	//one output sample per input pair, the filter centred 9 inputs back; the line drops a bit
+	//on the way in so the 32-bit sum holds 64 full-scale voices. The history then moves to
+	//the front and the segment behind it is cleared for the next voices
+	int c;
+	int k;
+	int j;
+	int32_t *x;
+	int32_t acc;
+
+	if(os_fresh) os_tail = OS_HISTORY;
+	else os_tail = (os_tail > 2 * count) ? os_tail - 2 * count : 0;
+	os_fresh = false;
+
+	for(c=0; c<SYNTH_OUTPUT_CHANNELS; c++)
+	{
+		x = os_line[c];
+		for(k=0; k<count; k++)
+		{
+			acc = (x[2 * k + OS_TAPS / 2 + 1] >> 1) << (OS_SHIFT - 1);
+			for(j=0; j<(OS_TAPS + 1) / 4; j++)
+			{
+				acc += os_halfband[j] * ((x[2 * k + OS_TAPS / 2 - 2 * j] >> 1) + (x[2 * k + OS_TAPS / 2 + 2 + 2 * j] >> 1));
+			}
+			mix[c * SYNTH_CONTROL_PERIOD + k] += acc >> (OS_SHIFT - 1);
+		}
+
+		for(k=0; k<OS_HISTORY; k++) x[k] = x[2 * count + k];
+		for(k=OS_HISTORY; k<OS_HISTORY + 2 * count; k++) x[k] = 0;
+	}
+}
+#endif
+
+
+static void control_tick( uint32_t now )
+{
+	//advances everything that changes slower than the audio, events are applied afterwards
+	//by the audio tick at their own sample
+	clock_watch(now);
+	mod_tick();
+	if((mod_cutoff() != filter_cutoff_mod) || filter_cutoff_glide)
+	{
+		filter_cutoff_mod = mod_cutoff();
+		filter_cutoff_glide = smooth_step(filter_cutoff_glide, 0);
+		filter_update();
+	}
+
+	cc_service();
+	channels_smooth();
+	PROFILE_ENTER(PROFILE_ENVELOPE);
+	envelope_control();
+	PROFILE_LEAVE();
+
+	master_gain = smooth_step(master_gain, master_gain_target);
+#if SYNTH_FORMANT
+	if(formant_position != formant_target)
+	{
+		formant_position = smooth_step(formant_position, formant_target);
+		formant_update();
+	}
+#endif
+}
+
+static int32_t smooth_step( int32_t value, int32_t target )
+{
+	//one-pole step of 1/2^SYNTH_SMOOTH_SHIFT, rounded so it always lands on the target
+	int32_t delta = target - value;
+
+	if(delta > 0) return value + ((delta + (1 << SYNTH_SMOOTH_SHIFT) - 1) >> SYNTH_SMOOTH_SHIFT);
+	return value + (delta >> SYNTH_SMOOTH_SHIFT);
+}
+
+static void channels_smooth( void )
+{
+	//the voices read the smoothed values in voice_modulate(), right after this; the ORGAN
+	//voices read the drawbar gains straight from the channel, the sub-oscillators their gain
+	//and the MORPH voices their position
+	struct synth_channel *ch;
+	int c;
+	int d;
+
+	for(c=0; c<SYNTH_MIDI_CHANNELS; c++)
+	{
+		ch = &channels[c];
+		if(ch->pulse_width != ch->patch.pulse_width) ch->pulse_width = smooth_step(ch->pulse_width, ch->patch.pulse_width);
+		if(ch->volume != ch->volume_target) ch->volume = smooth_step(ch->volume, ch->volume_target);
+		if(ch->sub_gain != sub_target(ch)) ch->sub_gain = (int16_t) smooth_step(ch->sub_gain, sub_target(ch));
+		if(ch->morph != ch->morph_target) ch->morph = (int16_t) smooth_step(ch->morph, ch->morph_target);
+		for(d=0; d<ORGAN_DRAWBARS; d++)
+		{
+			if(ch->drawbar_gain[d] != ch->drawbar_target[d]) ch->drawbar_gain[d] = (int16_t) smooth_step(ch->drawbar_gain[d], ch->drawbar_target[d]);
+		}
+	}
+}
+
+static void envelope_control( void )
+{
+	//advances every envelope, glide and the modulation by one tick, sets up the per-sample
+	//gain ramp and frees finished voices
+	const struct synth_channel *ch;
+	int j;
+	int n;
+	int32_t glide;
+
+	//from the end, so a finished voice is replaced in the list by one already done
+	for(n=voice_bank.active_count-1; n>=0; n--)
+	{
+		j = voice_bank.active[n];
+
+		if(voice_bank.env_stage[j] == ENV_IDLE)
+		{
+			//release has finished, or a one-shot sample played to its end with the key still down
+			voice_alloc_release(j);
+			voice_deactivate(j);
+			voice_batch_remove(j);
+			voice_alloc_free(j);
+			continue;
+		}
+
+#if SYNTH_STEREO
+		voice_pan_ramp(j);
+#endif
+
+		//a drum hit has no glide, modulation or waveform fade, only its sweep and decay
+		if(voice_bank.type[j] == DRUM)
+		{
+			voice_bank.inc[j] = drum_sweep(j);
+			envelope_ramp(j, SYNTH_CONTROL_PERIOD);
+			continue;
+		}
+
+		//glide one step closer to the note, the step that would cross it lands on it
+		if(voice_bank.glide[j])
+		{
+			glide = voice_bank.glide[j] - voice_bank.glide_step[j];
+			voice_bank.glide[j] = ((glide ^ voice_bank.glide[j]) < 0) ? 0 : glide;
+		}
+
+		if(SYNTH_WAVE_SWAP_TICKS && (voice_bank.swap_fade[j] == SYNTH_WAVE_SWAP_TICKS)) voice_wave_swap(j);
+
+		voice_modulate(j);
+
+		//the grains due this period start at the pitch the voice was just retuned to
+		if(voice_bank.type[j] == GRAIN)
+		{
+			ch = &channels[voice_bank.channel[j]];
+			grain_voice_tick(j, voice_bank.pcm[j], (voice_bank.pcm[j]->length * ch->patch.sample_start) >> 7, voice_bank.pcm_step[j], &ch->grain, &voice_bank.noise[j]);
+		}
+
+		envelope_ramp(j, SYNTH_CONTROL_PERIOD);
+	}
+}
+
+static void voice_modulate( int voice )
+{
+	//destination values for the next tick, the voice is only retuned when its pitch offset
+	//(modulation plus glide) moved
+	struct mod_input in;
+	struct mod_voice mod;
+	const struct synth_channel *ch;
+	int32_t pitch;
+	int32_t width;
+
+	ch = &channels[voice_bank.channel[voice]];
+
+	//the newer of the voice's own pressure and its channel's, stamps wrap like the render time
+	in.envelope = voice_bank.env_level[voice];
+	in.velocity = (int32_t) voice_bank.velocity[voice] << 8;
+	in.pressure = ((int32_t) (voice_bank.pressure_at[voice] - ch->pressure_at) >= 0) ? voice_bank.pressure[voice] : ch->pressure;
+	in.timbre = voice_bank.timbre[voice];
+	mod_voice_eval(&in, &mod);
+	voice_bank.mod_amp_next[voice] = (uint16_t) ((ch->volume == MOD_UNITY) ? mod.amp : ((mod.amp * ch->volume) >> MOD_SHIFT));
+	width = mod.pulse_width + ch->pulse_width;
+	if(width > MOD_PW_LIMIT) width = MOD_PW_LIMIT;
+	if(width < -MOD_PW_LIMIT) width = -MOD_PW_LIMIT;
+	voice_bank.pulse_width[voice] = PHASE_HALF_CYCLE + (uint32_t) (width * 65536);
+
+	pitch = mod.pitch + voice_bank.glide[voice];
+	if(pitch != voice_bank.mod_pitch[voice])
+	{
+		voice_bank.mod_pitch[voice] = pitch;
+		voice_retune(voice);
+	}
+}
+
+SYNTH_RAM_CODE static void envelope_ramp( int voice, int count )
+{
+	//one envelope tick, spread as a gain ramp over the next 'count' samples; the amplitude
+	//modulation ramps along from the last tick's factor to the new one
+	uint8_t stage = voice_bank.env_stage[voice];
+	int32_t start = voice_bank.env_level[voice];
+	int32_t end = (voice_bank.type[voice] == DRUM) ? drum_env_advance(voice, &stage, start) : env_advance(&stage, start, &env_params);
+	int32_t amp = voice_bank.amp[voice];
+	int32_t gain_start;
+	int32_t gain_end;
+	int fade;
+
+#if SYNTH_GOVERNOR
+	//shed by the load governor, the whole release is this one tick
+	if(voice_shed[voice >> 5] & (1ul << (voice & 31)))
+	{
+		voice_shed[voice >> 5] &= ~(1ul << (voice & 31));
+		end = 0;
+		stage = ENV_IDLE;
+	}
+#endif
+
+	gain_start = (start * amp) >> VOICE_AMP_SHIFT;
+	gain_end = (end * amp) >> VOICE_AMP_SHIFT;
+	voice_bank.env_level[voice] = end;
+	voice_bank.env_stage[voice] = stage;
+
+	if(voice_bank.mod_amp[voice] != MOD_UNITY) gain_start = (gain_start * voice_bank.mod_amp[voice]) >> MOD_SHIFT;
+	if(voice_bank.mod_amp_next[voice] != MOD_UNITY) gain_end = (gain_end * voice_bank.mod_amp_next[voice]) >> MOD_SHIFT;
+	voice_bank.mod_amp[voice] = voice_bank.mod_amp_next[voice];
+
+	//switching waveform, |fade - SYNTH_WAVE_SWAP_TICKS| ticks from silence
+	if(SYNTH_WAVE_SWAP_TICKS && voice_bank.swap_fade[voice])
+	{
+		fade = voice_bank.swap_fade[voice]-- - SYNTH_WAVE_SWAP_TICKS;
+		gain_start = recip_div(gain_start * ((fade > 0) ? fade : -fade), SYNTH_WAVE_SWAP_TICKS);
+		fade--;
+		gain_end = recip_div(gain_end * ((fade > 0) ? fade : -fade), SYNTH_WAVE_SWAP_TICKS);
+	}
+
+	voice_bank.gain[voice] = gain_start;
+	voice_bank.gain_step[voice] = recip_div(gain_end - gain_start, count);
+
+#if SYNTH_METERS
+	//a voice's level is its gain at each tick, mono voices add straight into the mix
+	if(gain_start > 0x7FFF) gain_start = 0x7FFF;
+	if(gain_start > voice_peak[voice]) voice_peak[voice] = (uint16_t) gain_start;
+	voice_sum[voice] += (uint32_t) (gain_start * gain_start) >> 15;
+	voice_ticks[voice]++;
+#endif
+}
+
+SYNTH_RAM_CODE static uint8_t voice_osc_quality( int voice )
+{
+	//the governor's draft quality overrides every voice
+#if SYNTH_GOVERNOR
+	if(render_draft) return SYNTH_OSC_TRUNCATE;
+#endif
+	return voice_bank.quality[voice];
+}
+
+#if SYNTH_WAVETABLES
+static inline int32_t table_read_linear( const int16_t *table, uint32_t phase )
+{
+	//the entry and its neighbour weighted by the next 8 phase bits, the last wraps to the first
+	uint32_t index = phase >> WAVETABLE_INDEX_SHIFT;
+	int32_t a = table[index];
+	int32_t b = table[(index + 1) & (WAVETABLE_SIZE - 1)];
+
+	return a + (((b - a) * (int32_t) ((phase >> (WAVETABLE_INDEX_SHIFT - 8)) & 0xFF)) >> 8);
+}
+
+#define TABLE_READ_TRUNCATE(table, phase)	((int32_t) (table)[(phase) >> WAVETABLE_INDEX_SHIFT])
+
+//the MORPH step from one set's read to the other's; with SYNTH_OSC_SIMD the weight becomes
+//the pair (1 - w, w) once per run and the step one SMUAD of the two reads, the same values
+#if SYNTH_OSC_SIMD
+#  define MORPH_WEIGHTS(weight)		simd_pack((1 << MORPH_SHIFT) - (weight), weight)
+#  define MORPH_MIX(a, b, weights)	(simd_dual(simd_pack(a, b), weights) >> MORPH_SHIFT)
+#else
+#  define MORPH_WEIGHTS(weight)		(weight)
+#  define MORPH_MIX(a, b, weight)	((a) + ((((b) - (a)) * (weight)) >> MORPH_SHIFT))
+#endif
+
+//one plain and one pulse kernel per table read; the pulse is the difference of two
+//band-limited saws pw apart, the offset puts its levels back at the square's
+#define TABLE_KERNELS(name, READ) \
+SYNTH_RAM_CODE static void table_kernel_##name( int32_t *out, const int16_t *table, struct osc_run *run, int count ) \
+{ \
+	uint32_t phase = run->phase; \
+	uint32_t inc = run->inc; \
+	int32_t gain = run->gain; \
+	int32_t step = run->step; \
+	int i; \
+ \
+	for(i=0; i<count; i++) \
+	{ \
+		out[i] += (READ(table, phase) * gain) >> MIX_SHIFT; \
+		gain += step; \
+		phase += inc; \
+	} \
+ \
+	run->phase = phase; \
+	run->gain = gain; \
+} \
+ \
+SYNTH_RAM_CODE static void pulse_kernel_##name( int32_t *out, const int16_t *table, uint32_t pw, struct osc_run *run, int count ) \
+{ \
+	uint32_t phase = run->phase; \
+	uint32_t inc = run->inc; \
+	int32_t gain = run->gain; \
+	int32_t step = run->step; \
+	int32_t offset = (int32_t) (pw >> 20) - DAC_MIDSCALE; \
+	int i; \
+ \
+	for(i=0; i<count; i++) \
+	{ \
+		out[i] += ((READ(table, phase - pw) - READ(table, phase) + offset) * gain) >> MIX_SHIFT; \
+		gain += step; \
+		phase += inc; \
+	} \
+ \
+	run->phase = phase; \
+	run->gain = gain; \
+} \
+ \
+SYNTH_RAM_CODE static void morph_kernel_##name( int32_t *out, const int16_t *from, const int16_t *to, int32_t weight, struct osc_run *run, int count ) \
+{ \
+	uint32_t phase = run->phase; \
+	uint32_t inc = run->inc; \
+	int32_t gain = run->gain; \
+	int32_t step = run->step; \
+	int i; \
+ \
+	weight = MORPH_WEIGHTS(weight); \
+	for(i=0; i<count; i++) \
+	{ \
+		out[i] += (MORPH_MIX(READ(from, phase), READ(to, phase), weight) * gain) >> MIX_SHIFT; \
+		gain += step; \
+		phase += inc; \
+	} \
+ \
+	run->phase = phase; \
+	run->gain = gain; \
+}
+
+TABLE_KERNELS(truncate, TABLE_READ_TRUNCATE)
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_INTERPOLATED
+TABLE_KERNELS(linear, table_read_linear)
+#endif
+
+SYNTH_RAM_CODE static void render_batch( int type, int32_t *mix, int count )
+{
+	//table lookup by the top bits of the phase accumulator, the same kernels for every
+	//waveform; the voice's quality picks the read
+	int n;
+	int v;
+	int32_t *out;
+	uint32_t pw;
+	const int16_t *table;
+	struct osc_run run;
+
+	for(n=voice_bank.batch_start[type]; n<voice_bank.batch_start[type + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		run.gain = voice_bank.gain[v];
+		run.step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((run.gain | run.step) == 0) continue;
+
+		run.phase = voice_bank.phase[v];
+		run.inc = voice_bank.inc[v];
+		out = voice_out_begin(mix, count);
+
+		table = voice_bank.table[v];
+		pw = voice_bank.pulse_width[v];
+
+		if((type == SQUARE) && (pw != PHASE_HALF_CYCLE))
+		{
+			//same octave of the saw set, which follows the square set
+			table += WAVETABLE_LEVELS * WAVETABLE_SIZE;
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_INTERPOLATED
+			if(voice_osc_quality(v) >= SYNTH_OSC_INTERPOLATED) pulse_kernel_linear(out, table, pw, &run, count);
+			else
+#endif
+			pulse_kernel_truncate(out, table, pw, &run, count);
+		}
+		else
+		{
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_INTERPOLATED
+			if(voice_osc_quality(v) >= SYNTH_OSC_INTERPOLATED) table_kernel_linear(out, table, &run, count);
+			else
+#endif
+			table_kernel_truncate(out, table, &run, count);
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = run.phase;
+		voice_bank.gain[v] = run.gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_morph_batch( int type, int32_t *mix, int count )
+{
+	//the pair of sets and the weight between them come from the channel's position once per
+	//segment, the voice's table is its octave of the square set
+	int n;
+	int v;
+	int32_t *out;
+	int32_t position;
+	int32_t weight;
+	const int16_t *from;
+	struct osc_run run;
+
+	for(n=voice_bank.batch_start[MORPH]; n<voice_bank.batch_start[MORPH + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		run.gain = voice_bank.gain[v];
+		run.step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((run.gain | run.step) == 0) continue;
+
+		run.phase = voice_bank.phase[v];
+		run.inc = voice_bank.inc[v];
+		out = voice_out_begin(mix, count);
+
+		//the last set is reached as the full weight of the pair before it
+		position = channels[voice_bank.channel[v]].morph;
+		if(position > ((WAVETABLE_WAVES - 1) << MORPH_SHIFT)) position = (WAVETABLE_WAVES - 1) << MORPH_SHIFT;
+		weight = position & ((1 << MORPH_SHIFT) - 1);
+		if(position == ((WAVETABLE_WAVES - 1) << MORPH_SHIFT)) weight = 1 << MORPH_SHIFT;
+		from = voice_bank.table[v] + ((position - weight) >> MORPH_SHIFT) * (WAVETABLE_LEVELS * WAVETABLE_SIZE);
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_INTERPOLATED
+		if(voice_osc_quality(v) >= SYNTH_OSC_INTERPOLATED) morph_kernel_linear(out, from, from + WAVETABLE_LEVELS * WAVETABLE_SIZE, weight, &run, count);
+		else
+#endif
+		morph_kernel_truncate(out, from, from + WAVETABLE_LEVELS * WAVETABLE_SIZE, weight, &run, count);
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = run.phase;
+		voice_bank.gain[v] = run.gain;
+	}
+}
+#else
+SYNTH_RAM_CODE static void render_tri_batch( int type, int32_t *mix, int count )
+{
+	//naive triangle, its harmonics fall off fast enough to skip band limiting
+	int n;
+	int i;
+	int v;
+	int32_t *out;
+	uint32_t phase;
+	uint32_t inc;
+	int32_t gain;
+	int32_t step;
+	uint32_t fold;
+
+	for(n=voice_bank.batch_start[TRI]; n<voice_bank.batch_start[TRI + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		for(i=0; i<count; i++)
+		{
+			fold = (phase < PHASE_HALF_CYCLE) ? phase : ~phase;
+			out[i] += (((int32_t) (fold >> 19) - DAC_MIDSCALE) * gain) >> MIX_SHIFT;
+			gain += step;
+			phase += inc;
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase;
+		voice_bank.gain[v] = gain;
+	}
+}
+#endif
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_BANDLIMITED
+SYNTH_RAM_CODE static int32_t polyblep( uint32_t phase, uint32_t inc, int shift, uint32_t recip )
+{
+	//PolyBLEP residual in DAC units for the step at phase 0, zero outside one increment of it
+	uint32_t d;
+	uint32_t before = 0u - phase;
+
+	if(phase < inc)
+	{
+		//just after the step, (1 - t/dt)^2 below the line
+		d = (1ul << BLEP_FRAC_BITS) - (((phase >> shift) * recip) >> BLEP_FRAC_BITS);
+		return -(int32_t) ((d * d) >> (2 * BLEP_FRAC_BITS - 11));
+	}
+
+	if(before < inc)
+	{
+		//just before the step, mirrored above the line
+		d = (1ul << BLEP_FRAC_BITS) - (((before >> shift) * recip) >> BLEP_FRAC_BITS);
+		return (int32_t) ((d * d) >> (2 * BLEP_FRAC_BITS - 11));
+	}
+
+	return 0;
+}
+#endif
+
+#define BLEP_NONE(phase, inc, shift, recip)		(	0	)
+
+//one saw and one pulse kernel per step correction: naive, or with the PolyBLEP residual
+//only within one increment of each step
+#define BLEP_KERNELS(name, CORRECT) \
+SYNTH_RAM_CODE static void saw_kernel_##name( int32_t *out, int shift, uint32_t recip, struct osc_run *run, int count ) \
+{ \
+	uint32_t phase = run->phase; \
+	uint32_t inc = run->inc; \
+	int32_t gain = run->gain; \
+	int32_t step = run->step; \
+	int32_t s; \
+	int i; \
+ \
+	for(i=0; i<count; i++) \
+	{ \
+		/*falling edge at the wrap*/ \
+		s = (int32_t) (phase >> 20) - DAC_MIDSCALE; \
+		s -= CORRECT(phase, inc, shift, recip); \
+		out[i] += (s * gain) >> MIX_SHIFT; \
+		gain += step; \
+		phase += inc; \
+	} \
+ \
+	run->phase = phase; \
+	run->gain = gain; \
+} \
+ \
+SYNTH_RAM_CODE static void square_kernel_##name( int32_t *out, int shift, uint32_t recip, uint32_t pw, struct osc_run *run, int count ) \
+{ \
+	uint32_t phase = run->phase; \
+	uint32_t inc = run->inc; \
+	int32_t gain = run->gain; \
+	int32_t step = run->step; \
+	int32_t s; \
+	int i; \
+ \
+	for(i=0; i<count; i++) \
+	{ \
+		/*rising edge at the wrap, falling edge at the pulse width*/ \
+		s = (phase < pw) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1); \
+		s += CORRECT(phase, inc, shift, recip); \
+		s -= CORRECT(phase - pw, inc, shift, recip); \
+		out[i] += (s * gain) >> MIX_SHIFT; \
+		gain += step; \
+		phase += inc; \
+	} \
+ \
+	run->phase = phase; \
+	run->gain = gain; \
+}
+
+BLEP_KERNELS(naive, BLEP_NONE)
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_BANDLIMITED
+BLEP_KERNELS(polyblep, polyblep)
+#endif
+
+SYNTH_RAM_CODE static void render_blep_batch( int type, int32_t *mix, int count )
+{
+	//naive square/saw, band-limited from SYNTH_OSC_BANDLIMITED up, at twice the rate at
+	//SYNTH_OSC_OVERSAMPLED
+	int n;
+	int v;
+	int32_t *out;
+	int shift = 0;
+	uint32_t recip = 0;
+	uint32_t inc;
+	int length;
+	bool bandlimited;
+	struct osc_run run;
+
+	for(n=voice_bank.batch_start[type]; n<voice_bank.batch_start[type + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		run.gain = voice_bank.gain[v];
+		run.step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((run.gain | run.step) == 0) continue;
+
+		run.phase = voice_bank.phase[v];
+		run.inc = inc = voice_bank.inc[v];
+		length = count;
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+		if(voice_osc_quality(v) >= SYNTH_OSC_OVERSAMPLED)
+		{
+			run.inc = inc = inc >> 1;
+			run.step >>= 1;
+			length = 2 * count;
+			out = voice_os_begin(count);
+		}
+		else
+#endif
+		out = voice_out_begin(mix, count);
+
+		bandlimited = (SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_BANDLIMITED) && (voice_osc_quality(v) >= SYNTH_OSC_BANDLIMITED);
+		if(bandlimited)
+		{
+			//one reciprocal per voice per block: t/dt = (phase >> shift) * recip in Q15
+			shift = 0;
+			while((inc >> shift) >= (1ul << BLEP_FRAC_BITS)) shift++;
+			recip = recip_q30(inc >> shift);
+		}
+
+		if(type == SAW_BLEP)
+		{
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_BANDLIMITED
+			if(bandlimited) saw_kernel_polyblep(out, shift, recip, &run, length);
+			else
+#endif
+			saw_kernel_naive(out, shift, recip, &run, length);
+		}
+		else
+		{
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_BANDLIMITED
+			if(bandlimited) square_kernel_polyblep(out, shift, recip, voice_bank.pulse_width[v], &run, length);
+			else
+#endif
+			square_kernel_naive(out, shift, recip, voice_bank.pulse_width[v], &run, length);
+		}
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+		if(length != count)
+		{
+			//the halves dropped the low bits, the voice ends where count full steps take it
+			voice_os_end(v, out, count);
+			run.phase += (voice_bank.inc[v] & 1) * (uint32_t) count;
+			run.gain = voice_bank.gain[v] + voice_bank.gain_step[v] * count;
+		}
+		else
+#endif
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = run.phase;
+		voice_bank.gain[v] = run.gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_fm_batch( int type, int32_t *mix, int count )
+{
+	//two sine reads per sample; the modulator times the depth is the carrier phase offset,
+	//which wraps modulo 2^32 like the phase itself
+	int n;
+	int i;
+	int v;
+	int32_t *out;
+	uint32_t phase;
+	uint32_t inc;
+	uint32_t fm_phase;
+	uint32_t fm_inc;
+	uint32_t depth;
+	int32_t gain;
+	int32_t step;
+
+	for(n=voice_bank.batch_start[FM]; n<voice_bank.batch_start[FM + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		fm_phase = voice_bank.fm_phase[v];
+		fm_inc = voice_bank.fm_inc[v];
+		depth = voice_bank.fm_depth[v];
+
+		for(i=0; i<count; i++)
+		{
+			out[i] += (sine_lookup(phase + (uint32_t) sine_lookup(fm_phase) * depth) * gain) >> MIX_SHIFT;
+			gain += step;
+			phase += inc;
+			fm_phase += fm_inc;
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase;
+		voice_bank.fm_phase[v] = fm_phase;
+		voice_bank.gain[v] = gain;
+	}
+}
+
+//one kernel per quarter-wave read
+#define SINE_KERNEL(name, READ) \
+SYNTH_RAM_CODE static void sine_kernel_##name( int32_t *out, struct osc_run *run, int count ) \
+{ \
+	uint32_t phase = run->phase; \
+	uint32_t inc = run->inc; \
+	int32_t gain = run->gain; \
+	int32_t step = run->step; \
+	int i; \
+ \
+	for(i=0; i<count; i++) \
+	{ \
+		out[i] += (READ(phase) * gain) >> MIX_SHIFT; \
+		gain += step; \
+		phase += inc; \
+	} \
+ \
+	run->phase = phase; \
+	run->gain = gain; \
+}
+
+SINE_KERNEL(truncate, sine_lookup)
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_INTERPOLATED
+SINE_KERNEL(linear, sine_lookup_interp)
+#endif
+
+SYNTH_RAM_CODE static void render_sine_batch( int type, int32_t *mix, int count )
+{
+	//quarter-wave table read by the top phase bits, folded by the two top bits, and
+	//interpolated between entries at SYNTH_OSC_INTERPOLATED
+	int n;
+	int v;
+	int32_t *out;
+	struct osc_run run;
+
+	for(n=voice_bank.batch_start[SINE]; n<voice_bank.batch_start[SINE + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		run.gain = voice_bank.gain[v];
+		run.step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((run.gain | run.step) == 0) continue;
+
+		run.phase = voice_bank.phase[v];
+		run.inc = voice_bank.inc[v];
+		out = voice_out_begin(mix, count);
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_INTERPOLATED
+		if(voice_osc_quality(v) >= SYNTH_OSC_INTERPOLATED) sine_kernel_linear(out, &run, count);
+		else
+#endif
+		sine_kernel_truncate(out, &run, count);
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = run.phase;
+		voice_bank.gain[v] = run.gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_noise_batch( int type, int32_t *mix, int count )
+{
+	//one shift and a masked XOR per new value, the output is the bit shifted out: successive
+	//states share all other bits, only that one is uncorrelated; held noise only steps the
+	//LFSR when the phase crosses a hold boundary
+	int n;
+	int i;
+	int v;
+	int32_t *out;
+	uint32_t phase;
+	uint32_t inc;
+	uint32_t lfsr;
+	int32_t gain;
+	int32_t step;
+
+	for(n=voice_bank.batch_start[NOISE]; n<voice_bank.batch_start[NOISE + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		lfsr = voice_bank.noise[v];
+
+		if(voice_bank.noise_hold[v])
+		{
+			for(i=0; i<count; i++)
+			{
+				if(((phase + inc) ^ phase) >> NOISE_HOLD_SHIFT) lfsr = (lfsr >> 1) ^ ((0u - (lfsr & 1u)) & NOISE_LFSR_TAPS);
+				out[i] += (((lfsr & 1u) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1)) * gain) >> MIX_SHIFT;
+				gain += step;
+				phase += inc;
+			}
+		}
+		else
+		{
+			for(i=0; i<count; i++)
+			{
+				lfsr = (lfsr >> 1) ^ ((0u - (lfsr & 1u)) & NOISE_LFSR_TAPS);
+				out[i] += (((lfsr & 1u) ? (DAC_MIDSCALE - 1) : -(DAC_MIDSCALE - 1)) * gain) >> MIX_SHIFT;
+				gain += step;
+			}
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase;
+		voice_bank.noise[v] = lfsr;
+		voice_bank.gain[v] = gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_sample_batch( int type, int32_t *mix, int count )
+{
+	//nearest frame at a Q12 position, 8-bit data scaled up to the DAC range; a looped sample
+	//jumps back by the loop length, a one-shot ends the voice at the next control tick
+	int n;
+	int i;
+	int v;
+	int32_t *out;
+	const struct pcm_sample *pcm;
+	const int8_t *data8;
+	const int16_t *data12;
+	uint32_t pos;
+	uint32_t step;
+	uint32_t end;
+	uint32_t loop;
+	int32_t gain;
+	int32_t gain_step;
+	int32_t s;
+
+	for(n=voice_bank.batch_start[SAMPLE]; n<voice_bank.batch_start[SAMPLE + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		gain_step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | gain_step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		pcm = voice_bank.pcm[v];
+		pos = voice_bank.pcm_pos[v];
+		step = voice_bank.pcm_step[v];
+		loop = (pcm->loop_end > pcm->loop_start) ? (pcm->loop_end - pcm->loop_start) << PCM_FRAC_BITS : 0;
+		end = (loop ? pcm->loop_end : pcm->length) << PCM_FRAC_BITS;
+
+		if(pcm->bits == 8)
+		{
+			data8 = (const int8_t *) pcm->data;
+			for(i=0; i<count; i++)
+			{
+				if(pos >= end)
+				{
+					if(!loop) break;
+					pos -= loop;
+				}
+				s = data8[pos >> PCM_FRAC_BITS] << 4;
+				out[i] += (s * gain) >> MIX_SHIFT;
+				gain += gain_step;
+				pos += step;
+			}
+		}
+		else
+		{
+			data12 = (const int16_t *) pcm->data;
+			for(i=0; i<count; i++)
+			{
+				if(pos >= end)
+				{
+					if(!loop) break;
+					pos -= loop;
+				}
+				s = data12[pos >> PCM_FRAC_BITS];
+				out[i] += (s * gain) >> MIX_SHIFT;
+				gain += gain_step;
+				pos += step;
+			}
+		}
+
+		if(i < count)
+		{
+			//one-shot ran out
+			voice_bank.env_stage[v] = ENV_IDLE;
+			gain = 0;
+			gain_step = 0;
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.pcm_pos[v] = pos;
+		voice_bank.gain[v] = gain;
+		voice_bank.gain_step[v] = gain_step;
+	}
+}
+
+SYNTH_RAM_CODE static void render_stream_batch( int type, int32_t *mix, int count )
+{
+	//the ring and playhead live in stream.c, the gain ramp moves on through an underrun
+	int n;
+	int v;
+	int32_t *out;
+	int32_t gain;
+	int32_t gain_step;
+
+	for(n=voice_bank.batch_start[STREAM]; n<voice_bank.batch_start[STREAM + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		gain_step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | gain_step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		if(stream_render(v, out, count, voice_bank.pcm_step[v], gain, gain_step))
+		{
+			//one-shot ran out
+			voice_bank.env_stage[v] = ENV_IDLE;
+			voice_bank.gain[v] = 0;
+			voice_bank.gain_step[v] = 0;
+		}
+		else voice_bank.gain[v] = gain + gain_step * count;
+
+		voice_out_end(v, mix, out, count);
+	}
+}
+
+SYNTH_RAM_CODE static void render_pluck_batch( int type, int32_t *mix, int count )
+{
+	//the line and its position live in pluck.c, like a stream's ring
+	int n;
+	int v;
+	int32_t *out;
+	int32_t gain;
+	int32_t gain_step;
+
+	for(n=voice_bank.batch_start[PLUCK]; n<voice_bank.batch_start[PLUCK + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		gain_step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | gain_step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+		pluck_render(v, out, count, gain, gain_step);
+		voice_bank.gain[v] = gain + gain_step * count;
+		voice_out_end(v, mix, out, count);
+	}
+}
+
+SYNTH_RAM_CODE static void render_drum_batch( int type, int32_t *mix, int count )
+{
+	//the piece and its sweep live in drum.c, the phase and the LFSR are the voice's own
+	int n;
+	int v;
+	int32_t *out;
+	int32_t gain;
+	int32_t gain_step;
+
+	for(n=voice_bank.batch_start[DRUM]; n<voice_bank.batch_start[DRUM + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		gain_step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | gain_step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+		drum_render(v, out, count, &voice_bank.phase[v], voice_bank.inc[v], &voice_bank.noise[v], gain, gain_step);
+		voice_bank.gain[v] = gain + gain_step * count;
+		voice_out_end(v, mix, out, count);
+	}
+}
+
+SYNTH_RAM_CODE static void render_grain_batch( int type, int32_t *mix, int count )
+{
+	//the grains live in grain.c, one list per voice
+	int n;
+	int v;
+	int32_t *out;
+	int32_t gain;
+	int32_t gain_step;
+
+	for(n=voice_bank.batch_start[GRAIN]; n<voice_bank.batch_start[GRAIN + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		gain_step = voice_bank.gain_step[v];
+
+		//silent for this segment, its grains still run down
+		out = voice_out_begin(mix, count);
+		grain_render(v, out, count, gain, gain_step);
+		voice_bank.gain[v] = gain + gain_step * count;
+		voice_out_end(v, mix, out, count);
+	}
+}
+
+SYNTH_RAM_CODE static void render_organ_batch( int type, int32_t *mix, int count )
+{
+	//one phase at half the voice's pitch, the 16' fundamental; every drawbar that is out and
+	//below half the sample rate reads the sine table at its multiple of it
+	int n;
+	int i;
+	int k;
+	int v;
+	int bars;
+	int32_t *out;
+	const struct synth_channel *ch;
+	uint32_t phase;
+	uint32_t inc;
+	uint32_t mult[ORGAN_DRAWBARS];
+	int32_t level[ORGAN_DRAWBARS];
+#if SYNTH_OSC_SIMD
+	int32_t pair[ORGAN_DRAWBARS / 2];
+#endif
+	int32_t gain;
+	int32_t step;
+	int32_t s;
+
+	for(n=voice_bank.batch_start[ORGAN]; n<voice_bank.batch_start[ORGAN + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v] >> 1;
+		ch = &channels[voice_bank.channel[v]];
+
+		bars = 0;
+		for(k=0; k<ORGAN_DRAWBARS; k++)
+		{
+			if((ch->drawbar_gain[k] == 0) || ((uint64_t) inc * drawbar_harmonic[k] >= PHASE_HALF_CYCLE)) continue;
+			mult[bars] = drawbar_harmonic[k];
+			level[bars] = ch->drawbar_gain[k];
+			bars++;
+		}
+#if SYNTH_OSC_SIMD
+		//the levels two to a word for SMLAD, an odd drawbar out is added on its own
+		for(k=0; k+1<bars; k+=2) pair[k >> 1] = simd_pack(level[k], level[k + 1]);
+#endif
+
+		out = voice_out_begin(mix, count);
+
+		for(i=0; i<count; i++)
+		{
+			s = 0;
+#if SYNTH_OSC_SIMD
+			for(k=0; k+1<bars; k+=2) s = simd_dual_acc(simd_pack(sine_lookup(phase * mult[k]), sine_lookup(phase * mult[k + 1])), pair[k >> 1], s);
+			if(k < bars) s += sine_lookup(phase * mult[k]) * level[k];
+#else
+			for(k=0; k<bars; k++) s += sine_lookup(phase * mult[k]) * level[k];
+#endif
+			out[i] += ((s >> ORGAN_GAIN_SHIFT) * gain) >> MIX_SHIFT;
+			gain += step;
+			phase += inc;
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase;
+		voice_bank.gain[v] = gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_sync_batch( int type, int32_t *mix, int count )
+{
+	//the note's phase only keeps time; when adding the increment carries out of it the saw
+	//restarts at the part of a cycle it has run since, the overshoot times its ratio
+	int n;
+	int i;
+	int v;
+	int32_t *out;
+	uint32_t phase;
+	uint32_t inc;
+	uint32_t slave;
+	uint32_t slave_inc;
+	uint32_t ratio;
+	int32_t gain;
+	int32_t step;
+	int length;
+
+	for(n=voice_bank.batch_start[SYNC]; n<voice_bank.batch_start[SYNC + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v];
+		slave = voice_bank.fm_phase[v];
+		slave_inc = voice_bank.fm_inc[v];
+		ratio = voice_bank.fm_ratio[v];
+		length = count;
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+		//the restart works from the phase run since the wrap, so it holds at half the steps
+		if(voice_osc_quality(v) >= SYNTH_OSC_OVERSAMPLED)
+		{
+			inc >>= 1;
+			slave_inc >>= 1;
+			step >>= 1;
+			length = 2 * count;
+			out = voice_os_begin(count);
+		}
+		else
+#endif
+		out = voice_out_begin(mix, count);
+
+		for(i=0; i<length; i++)
+		{
+			out[i] += (((int32_t) (slave >> 20) - DAC_MIDSCALE) * gain) >> MIX_SHIFT;
+			gain += step;
+			slave += slave_inc;
+			phase += inc;
+			if(phase < inc) slave = (phase >> 4) * ratio;
+		}
+
+#if SYNTH_OSC_QUALITY_MAX >= SYNTH_OSC_OVERSAMPLED
+		if(length != count)
+		{
+			voice_os_end(v, out, count);
+			phase += (voice_bank.inc[v] & 1) * (uint32_t) count;
+			gain = voice_bank.gain[v] + voice_bank.gain_step[v] * count;
+		}
+		else
+#endif
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase;
+		voice_bank.fm_phase[v] = slave;
+		voice_bank.gain[v] = gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_ring_batch( int type, int32_t *mix, int count )
+{
+	//two sine reads and one multiply, the product back to DAC range
+	int n;
+	int i;
+	int v;
+	int32_t *out;
+	uint32_t phase;
+	uint32_t inc;
+	uint32_t fm_phase;
+	uint32_t fm_inc;
+	int32_t gain;
+	int32_t step;
+
+	for(n=voice_bank.batch_start[RING]; n<voice_bank.batch_start[RING + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		phase = voice_bank.phase[v];
+		inc = voice_bank.inc[v];
+		fm_phase = voice_bank.fm_phase[v];
+		fm_inc = voice_bank.fm_inc[v];
+
+		for(i=0; i<count; i++)
+		{
+			out[i] += (((sine_lookup(phase) * sine_lookup(fm_phase)) >> 11) * gain) >> MIX_SHIFT;
+			gain += step;
+			phase += inc;
+			fm_phase += fm_inc;
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase;
+		voice_bank.fm_phase[v] = fm_phase;
+		voice_bank.gain[v] = gain;
+	}
+}
+
+SYNTH_RAM_CODE static void render_supersaw_batch( int type, int32_t *mix, int count )
+{
+	//the saws' increments are worked out once per segment, the voice's own phase is the
+	//first of them; per sample only the adds and reads, then one scale for the sum
+	int n;
+	int i;
+	int k;
+	int v;
+	int32_t *out;
+	uint32_t phase[SYNTH_UNISON];
+	uint32_t inc[SYNTH_UNISON];
+	uint32_t center;
+	int32_t delta;
+	int32_t gain;
+	int32_t step;
+	int32_t s;
+
+	for(n=voice_bank.batch_start[SUPERSAW]; n<voice_bank.batch_start[SUPERSAW + 1]; n++)
+	{
+		v = voice_bank.batch[n];
+		gain = voice_bank.gain[v];
+		step = voice_bank.gain_step[v];
+
+		//silent for this segment
+		if((gain | step) == 0) continue;
+
+		out = voice_out_begin(mix, count);
+
+		center = voice_bank.inc[v];
+		delta = (int32_t) (((uint64_t) center * channels[voice_bank.channel[v]].unison_spread) >> 16);
+		phase[0] = voice_bank.phase[v];
+		for(k=1; k<SYNTH_UNISON; k++) phase[k] = voice_bank.unison_phase[k - 1][v];
+		for(k=0; k<SYNTH_UNISON; k++) inc[k] = center + (uint32_t) recip_div(delta * (2 * k - (SYNTH_UNISON - 1)), SYNTH_UNISON - 1);
+
+		for(i=0; i<count; i++)
+		{
+			s = -SYNTH_UNISON * DAC_MIDSCALE;
+			for(k=0; k<SYNTH_UNISON; k++)
+			{
+				s += (int32_t) (phase[k] >> 20);
+				phase[k] += inc[k];
+			}
+			out[i] += (((s * unison_level[SYNTH_UNISON]) >> 12) * gain) >> MIX_SHIFT;
+			gain += step;
+		}
+
+		voice_out_end(v, mix, out, count);
+
+		voice_bank.phase[v] = phase[0];
+		for(k=1; k<SYNTH_UNISON; k++) voice_bank.unison_phase[k - 1][v] = phase[k];
+		voice_bank.gain[v] = gain;
+	}
+}
@@ -0,0 +1,633 @@
+/*************************************************************************************************
+                                       --SYNTH ENGINE--
+
+	Voice bank and block renderer. Renders SYNTH_BLOCK_SIZE samples for all enabled voices
+	per call, so the output stage is handed whole frames instead of single samples.
+
+	The engine runs at two rates. Every SYNTH_CONTROL_PERIOD samples a control tick applies
+	the queued MIDI events, advances the envelopes and smooths parameters. The audio tick in
+	between only runs oscillators and the mix. All voice state is owned by the rendering
+	task, other tasks hand MIDI over with synth_post_event(); the synth_note_on() style
+	calls are for the control context only.
+
+	Events posted with synth_post_event_at() carry a render time, counted in samples from
+	synth_init() like synth_render_time(). The audio tick splits at that sample, so a note
+	starts exactly where it was scheduled instead of at the next control tick.
+
+	Everything that depends on the sample rate (note increments, envelope rates, filter
+	cutoff) is derived from synth_sample_rate(). synth_set_sample_rate() may be called from
+	any task, the renderer re-derives it all before its next block and retunes the sounding
+	voices; pacing the output at the new rate is up to the caller. The tables are built in
+	RAM from seeds in flash, and synth_rate_cycles() is how long the last build took on the
+	cycle count given to synth_set_rate_timer().
+
+	The engine is multi-timbral: waveform, pitch bend and sustain pedal are kept per MIDI
+	channel, and each channel is routed to one voice group (see SYNTH_VOICE_GROUPS) or
+	muted. The envelope and the master filter stay shared by all channels.
+
+	The modulation matrix (modulation.h) is evaluated in the control tick, the mod wheel
+	sets the depth of route slot 0, LFO1 to pitch.
+
+	With portamento on, a new note starts at the channel's previous note and glides to its
+	own pitch in the glide time. The glide is linear in 1/256 semitones, stepped once per
+	control tick, and the increment comes from the note table like every other pitch, so
+	it is exponential in frequency without any floating point.
+
+	The FM voice is two sine operators, the modulator at an integer multiple of the carrier
+	frequency offsetting the carrier phase by the modulation index. It is not band-limited,
+	high ratios and indexes on high notes alias.
+
+	ORGAN voices sum the nine drawbar partials (16', 5 1/3', 8', 4', 2 2/3', 2', 1 3/5',
+	1 1/3', 1') from the sine table, every one read at an integer multiple of a single phase
+	that runs at the 16' pitch. CC 21 to 29 pull the channel's drawbars out, 0 to 8 with 3 dB
+	a step, and the gains follow at control rate, scaled down together once their sum passes
+	a single full drawbar. A partial above half the sample rate is left out.
+
+	SYNC and RING voices run a second oscillator beside the note's, at 1 + n/16 times its
+	pitch for FM index n (CC 76), so up to just under nine times. SYNC plays that one as a
+	saw and resets it every time the note's phase wraps, the reset found from the phase
+	accumulator overflowing and placed at the fraction of a sample past the wrap. RING
+	multiplies two sines, the sum and difference tones without the fundamental. The second
+	oscillator stops below half the sample rate, neither is band-limited.
+
+	A SUPERSAW voice is SYNTH_UNISON saws spread evenly in pitch either side of the note, the
+	outer two CC 30's detune away, started at scattered phases. They share the voice's
+	envelope, gain and pan, so unison costs one phase add and one read per extra saw and
+	nothing else; the sum is scaled by 1/sqrt(SYNTH_UNISON).
+
+	MORPH voices crossfade between two neighbouring band-limited table sets, triangle to saw
+	to square as CC 85 goes up. The position follows at control rate and gives one weight
+	per segment, so a sample costs the two table reads of the voice's octave and a multiply.
+	Without SYNTH_WAVETABLES they play a PolyBLEP saw.
+
+	Under every voice whose waveform runs on the phase accumulator (all but SAMPLE, STREAM,
+	PLUCK and ORGAN) the channel can add a square sub-oscillator one or two octaves down, CC
+	31 for its level and CC 9 below or above 64 for the octave. It is a count of the phase
+	wrapping, bits 33 and 34 of the accumulator in effect, so it stays locked to the voice's
+	own cycle through glide and bend; the level follows at control rate.
+
+	SAMPLE voices play the PCM bank in samples.h, stepping through the sample in Q12 frames
+	at the ratio of the voice's pitch to the sample's root key. CC 78 sets a per-channel
+	start offset into the sample, a key without a sample is not played. STREAM voices play
+	the same way from the external flash through stream.h, with the same start offset.
+
+	NOISE voices run a 32-bit Galois LFSR each, white by default or sample-and-held at 16
+	times the note frequency.
+
+	PLUCK voices are Karplus-Strong strings (pluck.h) excited by that same LFSR, on delay
+	lines from a small pool; the envelope shapes them like any other voice, but the string
+	dies away on its own.
+
+	DRUM voices play a fixed kit on the General MIDI drum notes (drum.h), a swept sine for
+	the kick and toms, sine and noise for the snares, filtered noise for the hats and
+	cymbals. A hit is a one-shot with a decay of its own: the channel's envelope, the
+	modulation, bend and glide, note-off and the sub-oscillator all leave it alone.
+	SYNTH_DRUM_CHANNEL starts on the kit.
+
+	GRAIN voices play the SAMPLE bank as a cloud of short windowed grains (grain.h) around
+	the channel's sample start, at the note's pitch; grain size, density and spray are CCs
+	81 to 83, and the load governor thins the cloud along with shedding voices.
+
+	With SYNTH_STEREO every voice renders into a scratch buffer that is added to both halves
+	of the mix with its own constant-power pan gains, set from the channel's pan (CC 10) at
+	note-on and when the pan moves. Each half has its own filter state, and the frame comes
+	out interleaved left, right. Mono builds keep the pan but never apply it.
+
+	Square voices have a pulse width, the channel's setting (CC 70) plus the modulation,
+	compared against the phase accumulator and updated once per control tick.
+
+	Channel volume (CC 7, square law, 127 is unity and the default), pulse width, cutoff
+	(CC 74), the formant filter's vowel (CC 86) and master gain move to a new setting a share
+	of the way per control tick, see SYNTH_SMOOTH_SHIFT. Volume rides on the per-sample gain ramp every voice already has,
+	the cutoff glides in pitch, so a sweep costs nothing per sample.
+
+	A channel's sound settings are one struct synth_patch. With a preset table handed to
+	synth_set_presets() a program change copies the whole patch from its entry, a few words
+	and no parsing. Voices started after it take the new sound, of the sounding ones only
+	the pulse width follows, as it does for CC 70. Programs without an entry keep the old
+	behaviour and just select the waveform.
+
+	A held voice whose channel gets another waveform is faded out over
+	SYNTH_WAVE_SWAP_TICKS control ticks, switched while silent and faded back in, all on the
+	gain ramp it already has, so the render loops never see a waveform change mid-cycle.
+	Samples, streams and plucked strings need a start of their own and are never switched
+	to or from.
+
+	Control changes go through a map per channel, one byte per controller naming a slot:
+	the parameter it drives and the range the 0..127 of the controller is scaled to. The
+	MIDI_CC_ numbers below are the default map; synth_cc_request() changes an entry from
+	any task, or with SYNTH_CC_LEARN maps whatever controller the channel sends next. The
+	channel mode messages (120 up) are fixed.
+
+	Parameters take 14 bits. A controller 32..63 that is not mapped itself is the LSB of the
+	one 32 below, and refines the value its MSB set last. NRPN 0:n (CC 99 0, CC 98 n) is
+	parameter n in enum synth_param, set straight from data entry (CC 6, and CC 38 for the
+	LSB) at full range; an RPN selection parks data entry. These controllers are fixed too.
+	Filter cutoff gets 1/128 semitone steps that way, volume, pulse width, mod wheel, glide
+	time and limiter their full resolution, the rest use the MSB.
+
+	With SYNTH_MPE_CHANNELS the channels after the first form an MPE lower zone. A note on a
+	member channel is played by the master channel, channel 1, whose patch, volume, sustain,
+	bend and controllers are the zone's; the member channel's own pitch bend (up to
+	SYNTH_MPE_BEND_RANGE), channel pressure and CC 74 go to that one note as its bend and its
+	pressure and timbre modulation sources. Each member channel remembers the voice of its
+	note, so none of these search the voices. A note number already sounding in the zone
+	restarts that voice, as on any channel.
+
+	Aftertouch is the voice's pressure modulation source. Poly pressure finds its voice
+	through the allocator's note index, channel pressure is kept once per channel; each
+	message is stamped and a voice follows whichever of the two came last, so neither
+	walks the voices. The latest pressure of any kind also drives the pressure routes to
+	the master filter cutoff. SYNTH_PRESSURE_AMP_DEPTH and SYNTH_PRESSURE_CUTOFF_DEPTH set
+	the default routes.
+
+	The engine keeps a tempo, measured from MIDI clock (see midi_clock.h) at the render
+	times the receive interrupt stamped the clock bytes with, or SYNTH_TEMPO while none
+	comes in; an internal clock at that tempo then stands in for it. The arpeggiator on
+	SYNTH_ARP_CHANNEL steps on those clocks, LFO1 and the delay time can lock to them (CC
+	102 to 106), and Start restarts the pattern and the locked LFO, Stop holds both. A
+	clock is applied at its own sample like any event, so a step lands where the sender
+	put it, one output latency later; the internal clock's are scheduled the same way, at
+	whole samples with the fraction carried over. The notes of a step are started and
+	released right there, mid-period, like a timed note-on. The flash patterns of
+	pattern.h step on the same clocks, so a board with no MIDI connected plays its loop
+	from the sample clock alone, and so does a loop of controller motion recorded with CC
+	84 (automation.h). The MIDI UART's interrupt hands realtime bytes over
+	with synth_post_realtime() on a queue of their own, so the clock's timing does not wait
+	for the MIDI task to be scheduled; the engine merges both queues by render time.
+	With SYNTH_FAST_NOTE_ON the same interrupt hands whole Note Ons over with
+	synth_post_note_now(); they carry no render time and start at the renderer's next
+	control tick, trading the scheduled latency for at most a block of jitter.
+
+	Parameter writes never cross tasks: controllers and program changes travel the event
+	queue and the renderer applies them itself. What other tasks read back goes through a
+	copy the renderer republishes between blocks under a sequence count, synth_get_patch()
+	retries instead of taking a torn patch, and the audio path never takes a lock.
+
+	With SYNTH_METERS the mixer keeps the level of every output channel as it converts to DAC
+	codes, the largest sample and the sum of squares, and each voice its gain at every
+	control tick; mono voices add straight into the mix, so a voice's meter is its envelope,
+	velocity and volume rather than its waveform. The renderer publishes the figures between
+	blocks, synth_levels() returns the peaks held since its last call and the last block's
+	rms, synth_block_peak() the last block's peak for a meter LED.
+
+	With SYNTH_VOICE_SNAPSHOT any task can see the voice table as the renderer has it, for a
+	stuck note on a running unit: synth_snapshot_request() asks for a copy, the renderer
+	takes it at the end of its next block under a sequence count like the patches, and
+	synth_snapshot_read() returns the latest one without waiting. A renderer that no longer
+	runs leaves the last copy there, which a reader can tell by the count not moving.
+
+*************************************************************************************************/
+
+#ifndef SYNTH_ENGINE_H_INCLUDED
+#define SYNTH_ENGINE_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "sample_format.h"
+#include "note_table.h"
+#include "midi_parser.h"
+#include "voice_alloc.h"
+#include "wavetables.h"
+#include "envelope.h"
+#include "velocity_curves.h"
+#include "svf.h"
+#include "delay.h"
+#include "shaper.h"
+#include "formant.h"
+#include "reverb.h"
+#include "limiter.h"
+#include "modulation.h"
+#include "samples.h"
+#include "grain.h"
+#include "midi_clock.h"
+#include "arpeggiator.h"
+#include "pattern.h"
+#include "automation.h"
+
+/**********  DEFINE  ************/
+//oscillators run on a 32-bit phase accumulator, one full cycle per 2^32
+#define PHASE_FULL_CYCLE		(	0xFFFFFFFFul	)
+#define PHASE_HALF_CYCLE		(	0x80000000ul	)
+
+//voice amplitude comes from the velocity curve, full scale at velocity 127
+#define VOICE_AMP_SHIFT			VELOCITY_CURVE_SHIFT
+
+//per-sample voice gain is Q15, envelope level times amplitude
+#define VOICE_GAIN_SHIFT		(	15	)
+
+//the mix keeps 4 bits below the DAC LSB until the master gain, which holds 32 bits for up to
+//64 full-scale voices at the largest master gain
+#define MIX_FRAC_BITS			(	4	)
+#define MIX_SHIFT				(	VOICE_GAIN_SHIFT - MIX_FRAC_BITS	)
+
+//carrier phase offset per modulator DAC unit and index step of 1/16 radian, 2^32 / (32 pi 2047)
+#define FM_DEPTH_PER_INDEX		(	20870ul	)
+
+//x^32 + x^22 + x^2 + x + 1, maximal length
+#define NOISE_LFSR_TAPS			(	0x80200003ul	)
+
+//phase bits above the hold boundary, a new noise value 2^(32 - NOISE_HOLD_SHIFT) times a cycle
+#define NOISE_HOLD_SHIFT		(	28	)
+
+//drawbars of an ORGAN voice, and the fraction bits of their gains
+#define ORGAN_DRAWBARS			(	9	)
+#define ORGAN_GAIN_SHIFT		(	12	)
+
+//Q16 detune of the outer SUPERSAW oscillators per step of CC 30, about 6% at 127
+#define UNISON_SPREAD_STEP		(	31	)
+
+//the sub-oscillator's level bits in a patch, the rest says how far down it plays, and the
+//fraction bits of its smoothed gain
+#define SUB_LEVEL_MASK			(	0x7F	)
+#define SUB_TWO_OCTAVES			(	0x80	)
+#define SUB_GAIN_SHIFT			(	12	)
+
+//MORPH position, Q8 of a wavetable set from the square's, so the triangle is 2 << 8
+#define MORPH_SHIFT				(	8	)
+
+//PolyBLEP residual is evaluated in Q15 of the phase increment
+#define BLEP_FRAC_BITS			(	15	)
+
+//pan gains are Q15, centre is a quarter cycle of the sine table
+#define PAN_SHIFT				(	15	)
+#define PAN_CENTER				(	64	)
+
+//the master gain brings the mix to SAMPLE_BITS, see sample_format.h
+#define MASTER_GAIN_SHIFT		(	8	)
+
+//the master gain product keeps this many bits below the DAC LSB, which is where the dither
+//stage requantizes
+#define DITHER_SHIFT			(	MASTER_GAIN_SHIFT + MIX_FRAC_BITS	)
+#define DITHER_MASK				(	(1l << DITHER_SHIFT) - 1	)
+
+//fraction bits of the DC blocker's running mean, a DAC code is well under its resolution
+#define DC_FRAC_BITS			(	12	)
+
+#define SYNTH_MIDI_CHANNELS		(	16	)
+
+//controller number for synth_cc_request() that maps the channel's next controller instead
+#define SYNTH_CC_LEARN			(	0xFF	)
+
+#define MIDI_CC_MOD_WHEEL		(	1	)
+#define MIDI_CC_PORTAMENTO_TIME	(	5	)
+#define MIDI_CC_DATA_ENTRY		(	6	)
+#define MIDI_CC_VOLUME			(	7	)
+#define MIDI_CC_SUB_OCTAVE		(	9	)
+#define MIDI_CC_PAN				(	10	)
+#define MIDI_CC_DELAY_TIME		(	12	)
+#define MIDI_CC_DELAY_FEEDBACK	(	13	)
+#define MIDI_CC_SHAPER_DRIVE	(	14	)
+#define MIDI_CC_SHAPER_CURVE	(	15	)
+#define MIDI_CC_CRUSH_BITS		(	16	)
+#define MIDI_CC_CRUSH_HOLD		(	17	)
+#define MIDI_CC_LIMITER			(	18	)
+#define MIDI_CC_OSC_QUALITY		(	19	)
+#define MIDI_CC_POLYPHONY		(	20	)
+#define MIDI_CC_DRAWBAR_1		(	21	)	//to 29, 16' first
+#define MIDI_CC_UNISON_DETUNE	(	30	)
+#define MIDI_CC_SUB_LEVEL		(	31	)
+#define MIDI_CC_SUSTAIN			(	64	)
+#define MIDI_CC_PORTAMENTO		(	65	)
+#define MIDI_CC_PULSE_WIDTH		(	70	)
+#define MIDI_CC_RESONANCE		(	71	)
+#define MIDI_CC_CUTOFF			(	74	)
+#define MIDI_CC_TIMBRE			(	74	)	//on an MPE member channel
+#define MIDI_CC_FM_RATIO		(	75	)
+#define MIDI_CC_FM_INDEX		(	76	)
+#define MIDI_CC_NOISE_HOLD		(	77	)
+#define MIDI_CC_SAMPLE_START	(	78	)
+#define MIDI_CC_FILTER_MODE		(	80	)
+#define MIDI_CC_GRAIN_SIZE		(	81	)
+#define MIDI_CC_GRAIN_DENSITY	(	82	)
+#define MIDI_CC_GRAIN_SPRAY		(	83	)
+#define MIDI_CC_AUTOMATION		(	84	)
+#define MIDI_CC_MORPH			(	85	)
+#define MIDI_CC_VOWEL			(	86	)
+#define MIDI_CC_FORMANT_MIX		(	87	)
+#define MIDI_CC_REVERB_MIX		(	89	)
+#define MIDI_CC_REVERB_SIZE		(	90	)
+#define MIDI_CC_DELAY_MIX		(	91	)
+#define MIDI_CC_CHORUS_MIX		(	93	)
+#define MIDI_CC_CHORUS_DEPTH	(	94	)
+#define MIDI_CC_NRPN_LSB		(	98	)
+#define MIDI_CC_NRPN_MSB		(	99	)
+#define MIDI_CC_RPN_LSB			(	100	)
+#define MIDI_CC_RPN_MSB			(	101	)
+#define MIDI_CC_ARP_MODE		(	102	)
+#define MIDI_CC_ARP_RATE		(	103	)
+#define MIDI_CC_ARP_OCTAVES		(	104	)
+#define MIDI_CC_LFO_SYNC		(	105	)
+#define MIDI_CC_DELAY_SYNC		(	106	)
+#define MIDI_CC_PATTERN			(	107	)
+#define MIDI_CC_ALL_SOUND_OFF	(	120	)
+#define MIDI_CC_ALL_NOTES_OFF	(	123	)
+
+/********   TYPE DEFS  **********/
+//what a controller can drive, in the order of their default MIDI_CC_ numbers
+enum synth_param{
+	SYNTH_PARAM_NONE,
+	SYNTH_PARAM_MOD_WHEEL,
+	SYNTH_PARAM_PORTAMENTO_TIME,
+	SYNTH_PARAM_VOLUME,
+	SYNTH_PARAM_PAN,
+	SYNTH_PARAM_DELAY_TIME,
+	SYNTH_PARAM_DELAY_FEEDBACK,
+	SYNTH_PARAM_SHAPER_DRIVE,
+	SYNTH_PARAM_SHAPER_CURVE,
+	SYNTH_PARAM_CRUSH_BITS,
+	SYNTH_PARAM_CRUSH_HOLD,
+	SYNTH_PARAM_LIMITER,
+	SYNTH_PARAM_OSC_QUALITY,
+	SYNTH_PARAM_POLYPHONY,
+	SYNTH_PARAM_SUSTAIN,
+	SYNTH_PARAM_PORTAMENTO,
+	SYNTH_PARAM_PULSE_WIDTH,
+	SYNTH_PARAM_RESONANCE,
+	SYNTH_PARAM_CUTOFF,
+	SYNTH_PARAM_FM_RATIO,
+	SYNTH_PARAM_FM_INDEX,
+	SYNTH_PARAM_NOISE_HOLD,
+	SYNTH_PARAM_SAMPLE_START,
+	SYNTH_PARAM_FILTER_MODE,
+	SYNTH_PARAM_DELAY_MIX,
+	SYNTH_PARAM_CHORUS_MIX,
+	SYNTH_PARAM_CHORUS_DEPTH,
+	SYNTH_PARAM_ARP_MODE,
+	SYNTH_PARAM_ARP_RATE,
+	SYNTH_PARAM_ARP_OCTAVES,
+	SYNTH_PARAM_LFO_SYNC,
+	SYNTH_PARAM_DELAY_SYNC,
+	SYNTH_PARAM_PATTERN,
+	SYNTH_PARAM_DRAWBAR_1,
+	SYNTH_PARAM_DRAWBAR_2,
+	SYNTH_PARAM_DRAWBAR_3,
+	SYNTH_PARAM_DRAWBAR_4,
+	SYNTH_PARAM_DRAWBAR_5,
+	SYNTH_PARAM_DRAWBAR_6,
+	SYNTH_PARAM_DRAWBAR_7,
+	SYNTH_PARAM_DRAWBAR_8,
+	SYNTH_PARAM_DRAWBAR_9,
+	SYNTH_PARAM_UNISON_DETUNE,
+	SYNTH_PARAM_SUB_LEVEL,
+	SYNTH_PARAM_SUB_OCTAVE,
+	SYNTH_PARAM_MORPH,
+	SYNTH_PARAM_VOWEL,
+	SYNTH_PARAM_FORMANT_MIX,
+	SYNTH_PARAM_REVERB_MIX,
+	SYNTH_PARAM_REVERB_SIZE,
+	SYNTH_PARAM_GRAIN_SIZE,
+	SYNTH_PARAM_GRAIN_DENSITY,
+	SYNTH_PARAM_GRAIN_SPRAY,
+	SYNTH_PARAM_AUTOMATION,
+	SYNTH_PARAM_COUNT
+};
+
+enum wave_type{
+	SQUARE,
+	SAW,
+	TRI,
+	SQUARE_BLEP,
+	SAW_BLEP,
+	FM,
+	SINE,
+	NOISE,
+	SAMPLE,
+	STREAM,
+	PLUCK,
+	ORGAN,
+	SYNC,
+	RING,
+	SUPERSAW,
+	MORPH,
+	DRUM,
+	GRAIN,
+	WAVE_TYPE_COUNT
+};
+
+//the sound of a MIDI channel, what a program change recalls from a preset
+struct synth_patch{
+	enum wave_type wave;
+	int32_t pulse_width;
+	uint32_t glide_ms;
+	bool portamento;
+	uint8_t fm_ratio;
+	uint8_t fm_index;
+	bool noise_hold;
+	uint8_t sample_start;
+	uint8_t pan;
+	uint8_t quality;
+	uint8_t sub;			//sub-oscillator level, SUB_TWO_OCTAVES set for two octaves down
+};
+
+//state of one MIDI channel, group is the voice group it plays on or VOICE_NONE; pulse width
+//and volume (Q15 of MOD_UNITY) are the smoothed values the voices use
+struct synth_channel{
+	struct synth_patch patch;
+	int bend_fine;
+	bool sustain;
+	int8_t group;
+	int8_t last_note;
+	int32_t pulse_width;
+	int32_t volume;
+	int32_t volume_target;
+	int16_t pressure;		//Q15 pressure and timbre sources for the next note
+	uint32_t pressure_at;	//stamp of the pressure message
+	int16_t timbre;
+	int8_t voice;			//its last note's voice, for the MPE member channels
+	uint8_t drawbar[ORGAN_DRAWBARS];			//0..8
+	int16_t drawbar_target[ORGAN_DRAWBARS];	//Q12 partial gains of the ORGAN voices, and
+	int16_t drawbar_gain[ORGAN_DRAWBARS];		//the smoothed ones they play with
+	uint16_t unison_spread;	//Q16 of the pitch, the outer SUPERSAW oscillators' detune
+	int16_t sub_gain;		//smoothed sub-oscillator level
+	int16_t morph;			//MORPH position, smoothed towards the target
+	int16_t morph_target;
+	uint8_t grain_size;		//GRAIN CCs 0..127, and the grains they make at the sample rate
+	uint8_t grain_density;
+	uint8_t grain_spray;
+	struct grain_params grain;
+};
+
+//one bit per voice slot
+#define VOICE_MASK_WORDS		(	(SYNTH_MAX_VOICES + 31) / 32	)
+
+//voice state, laid out as one array per field so the renderer streams through a single
+//field at a time, plus a dense list of the enabled voices for the control rate and channel
+//loops and one grouped by waveform type for the renderer; every field is as narrow as its
+//range, which is what a voice costs in SRAM next to the delay lines
+struct voice_bank{
+	uint32_t phase[SYNTH_MAX_VOICES];
+	uint32_t inc[SYNTH_MAX_VOICES];
+	uint16_t amp[SYNTH_MAX_VOICES];
+	const int16_t *table[SYNTH_MAX_VOICES];
+	uint8_t note[SYNTH_MAX_VOICES];
+	uint8_t channel[SYNTH_MAX_VOICES];
+	uint8_t member[SYNTH_MAX_VOICES];
+	uint8_t velocity[SYNTH_MAX_VOICES];
+	int32_t note_bend[SYNTH_MAX_VOICES];
+	int16_t pressure[SYNTH_MAX_VOICES];
+	uint32_t pressure_at[SYNTH_MAX_VOICES];
+	int16_t timbre[SYNTH_MAX_VOICES];
+	uint32_t pulse_width[SYNTH_MAX_VOICES];
+	int16_t pan_left[SYNTH_MAX_VOICES];
+	int16_t pan_right[SYNTH_MAX_VOICES];
+	int16_t pan_left_to[SYNTH_MAX_VOICES];		//a pan move ramps there over a control period
+	int16_t pan_right_to[SYNTH_MAX_VOICES];
+	int16_t pan_left_step[SYNTH_MAX_VOICES];
+	int16_t pan_right_step[SYNTH_MAX_VOICES];
+	int32_t mod_pitch[SYNTH_MAX_VOICES];
+	uint16_t mod_amp[SYNTH_MAX_VOICES];		//Q15, up to MOD_UNITY
+	uint16_t mod_amp_next[SYNTH_MAX_VOICES];
+	uint32_t fm_phase[SYNTH_MAX_VOICES];
+	uint32_t unison_phase[SYNTH_UNISON - 1][SYNTH_MAX_VOICES];
+	uint32_t fm_inc[SYNTH_MAX_VOICES];
+	uint32_t fm_depth[SYNTH_MAX_VOICES];
+	uint8_t fm_ratio[SYNTH_MAX_VOICES];
+	uint8_t sub_count[SYNTH_MAX_VOICES];	//phase wraps, the accumulator's extra bits for the sub
+	uint8_t quality[SYNTH_MAX_VOICES];
+	uint8_t swap_fade[SYNTH_MAX_VOICES];	//control ticks left of a waveform switch, out then in
+	uint32_t noise[SYNTH_MAX_VOICES];
+	bool noise_hold[SYNTH_MAX_VOICES];
+	const struct pcm_sample *pcm[SYNTH_MAX_VOICES];
+	uint32_t pcm_pos[SYNTH_MAX_VOICES];
+	uint32_t pcm_step[SYNTH_MAX_VOICES];
+	int32_t glide[SYNTH_MAX_VOICES];
+	int32_t glide_step[SYNTH_MAX_VOICES];
+	uint8_t type[SYNTH_MAX_VOICES];
+	bool enable[SYNTH_MAX_VOICES];
+	uint8_t active_pos[SYNTH_MAX_VOICES];
+	uint8_t active[SYNTH_MAX_VOICES];
+	uint8_t active_count;
+	uint8_t batch_pos[SYNTH_MAX_VOICES];
+	uint8_t batch[SYNTH_MAX_VOICES];			//the enabled voices, grouped by type
+	uint8_t batch_start[WAVE_TYPE_COUNT + 1];	//of each type's group, the last one's end after it
+	bool gate[SYNTH_MAX_VOICES];
+	uint8_t env_stage[SYNTH_MAX_VOICES];
+	int32_t env_level[SYNTH_MAX_VOICES];
+	int32_t gain[SYNTH_MAX_VOICES];
+	int32_t gain_step[SYNTH_MAX_VOICES];
+};
+
+#if SYNTH_METERS
+//peak and rms of one output channel or voice, see synth_levels()
+struct synth_level{
+	uint16_t peak;
+	uint16_t rms;
+};
+
+struct synth_levels{
+	struct synth_level output[SYNTH_OUTPUT_CHANNELS];
+	struct synth_level voice[SYNTH_MAX_VOICES];
+};
+#endif
+
+#if SYNTH_VOICE_SNAPSHOT
+//one voice as the renderer left it at the end of a block, see synth_snapshot_read()
+struct synth_voice_state{
+	bool enable;
+	bool gate;
+	uint8_t note;
+	uint8_t channel;
+	uint8_t velocity;
+	uint8_t type;
+	uint8_t env_stage;
+	uint8_t swap_fade;
+	int32_t env_level;
+	int32_t gain;
+	uint32_t inc;
+	int32_t glide;
+	int32_t mod_pitch;
+	uint16_t mod_amp;
+	int16_t pressure;
+};
+
+struct synth_snapshot{
+	uint32_t render_time;	//of the block after the one it ends
+	uint8_t active_count;
+	struct synth_voice_state voice[SYNTH_MAX_VOICES];
+};
+#endif
+
+/*******   GLOBAL VARS  *********/
+extern struct voice_bank voice_bank;
+
+/****** FUNCTION PROTOTYPES  ****/
+void synth_init( void );
+void synth_render_block( uint16_t *frame );
+bool synth_post_event( const struct midi_event *event );
+bool synth_post_event_at( const struct midi_event *event, uint32_t time );
+bool synth_post_realtime( uint8_t status, uint32_t time );
+#if SYNTH_FAST_NOTE_ON
+bool synth_post_note_now( const struct midi_event *event );
+#endif
+uint32_t synth_render_time( void );
+int synth_voice_count( void );
+bool synth_events_pending( void );
+uint16_t synth_events_queued( void );
+void synth_set_sample_rate( uint32_t sample_rate );
+uint32_t synth_sample_rate( void );
+#if SYNTH_AUDIO_INPUT
+void synth_set_input( const int16_t *samples );
+#endif
+uint16_t synth_events_dropped( void );
+uint16_t synth_events_peak( void );
+uint32_t synth_events_late_max( void );
+void synth_handle_event( const struct midi_event *event );
+void synth_note_on( uint8_t channel, uint8_t note, uint8_t velocity );
+void synth_note_off( uint8_t channel, uint8_t note );
+void synth_all_notes_off( uint8_t channel );
+void synth_sustain( uint8_t channel, bool down );
+void synth_program_change( uint8_t channel, uint8_t program );
+void synth_pitch_bend( uint8_t channel, int16_t bend );
+void synth_channel_pressure( uint8_t channel, uint8_t pressure );
+void synth_poly_pressure( uint8_t channel, uint8_t note, uint8_t pressure );
+uint32_t synth_tempo( void );
+bool synth_clock_locked( void );
+void synth_route_channel( uint8_t channel, int group );
+void synth_set_pulse_width( uint8_t channel, int32_t width );
+void synth_set_fm( uint8_t channel, uint8_t ratio, uint8_t index );
+void synth_set_drawbar( uint8_t channel, int bar, uint8_t level );
+void synth_set_pan( uint8_t channel, uint8_t pan );
+void synth_set_volume( uint8_t channel, uint8_t volume );
+void synth_set_osc_quality( uint8_t channel, uint8_t quality );
+void synth_set_sub( uint8_t channel, uint8_t level, bool two_octaves );
+void synth_portamento( uint8_t channel, bool on );
+void synth_portamento_time( uint8_t channel, uint32_t ms );
+void synth_set_master_gain( uint16_t gain );
+void synth_set_envelope( uint32_t attack_ms, uint32_t decay_ms, uint8_t sustain_percent, uint32_t release_ms );
+void synth_all_sound_off( uint8_t channel );
+void synth_control_change( uint8_t channel, uint8_t controller, uint8_t value );
+bool synth_cc_request( uint8_t channel, uint8_t controller, enum synth_param param, uint8_t low, uint8_t high );
+bool synth_cc_learned( uint8_t *channel, uint8_t *controller, enum synth_param *param );
+enum synth_param synth_cc_param( uint8_t channel, uint8_t controller, uint8_t *low, uint8_t *high );
+void synth_set_filter( uint8_t mode, uint32_t cutoff_hz, uint8_t resonance );
+void synth_set_delay( uint32_t time, uint8_t feedback, uint8_t mix );
+void synth_set_chorus( uint32_t delay_us, uint32_t depth_us, uint32_t rate_chz, uint8_t feedback, uint8_t mix );
+void synth_set_shaper( enum shaper_curve curve, int32_t drive, uint8_t bits, uint8_t hold );
+void synth_set_formant( uint8_t vowel, uint8_t mix );
+void synth_set_reverb( uint8_t size, uint8_t damp, uint8_t mix );
+void synth_set_limiter( int32_t threshold );
+void synth_governor_report( uint16_t load );
+uint32_t synth_governor_shed_count( void );
+bool synth_governor_draft( void );
+void synth_set_rate_timer( uint32_t (*cycles)( void ) );
+uint32_t synth_rate_cycles( void );
+void synth_set_deadline( uint32_t (*cycles)( void ), uint32_t deadline );
+bool synth_render_late( void );
+void synth_set_velocity_curve( enum velocity_curve curve );
+void synth_set_presets( const struct synth_patch *const *presets, int count );
+void synth_get_patch( uint8_t channel, struct synth_patch *patch );
+#if SYNTH_METERS
+void synth_levels( struct synth_levels *levels );
+uint16_t synth_block_peak( void );
+#endif
+#if SYNTH_VOICE_SNAPSHOT
+void synth_snapshot_request( void );
+uint32_t synth_snapshot_read( struct synth_snapshot *snapshot );
+#endif
+#if SYNTH_VOICE_OVERFLOW
+void synth_set_overflow( bool (*forward)( const struct midi_event *event ) );
+#endif
+
+#endif /* SYNTH_ENGINE_H_INCLUDED */
@@ -0,0 +1,153 @@
+/*************************************************************************************************
+                                          --TELEMETRY--
+
+	Packing is byte by byte into a frame buffer, so the layout does not depend on struct
+	padding or on the compiler. A status frame is 50 bytes, at the default 10 per second
+	that is 4% of the 115200 baud line, the levels frame adds 24 for the default four mono
+	voices. Packing one takes a few hundred cycles, a formatted status
+	line through newlib's printf tens of thousands. The checksum sums are reduced once at
+	the end, the M0+ has no divider.
+
+	The sync bytes may also turn up inside a payload, the receiver only takes a frame whose
+	checksum matches and otherwise slides on by one byte.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "conf_synth.h"
+#include "telemetry.h"
+#include "debug_uart.h"
+
+#if SYNTH_TELEMETRY
+
+/**********  DEFINE  ************/
+#define TELEMETRY_STATUS_LEN	(	44	)
+#define TELEMETRY_FRAME_LEN		(	TELEMETRY_STATUS_LEN + 6	)
+#define TELEMETRY_LEVELS_LEN	(	6 + 4 * SYNTH_OUTPUT_CHANNELS + 2 * SYNTH_MAX_VOICES	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static uint8_t *telemetry_put16( uint8_t *p, uint16_t value );
+static uint8_t *telemetry_put32( uint8_t *p, uint32_t value );
+static uint8_t telemetry_fill( uint16_t level );
+static bool telemetry_finish( uint8_t *frame, int length );
+
+
+/*******   GLOBAL VARS  *********/
+static bool telemetry_on = SYNTH_TELEMETRY_START;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void telemetry_set_enabled( bool enabled )
+{
+	telemetry_on = enabled;
+}
+
+bool telemetry_enabled( void )
+{
+	return telemetry_on;
+}
+
+static uint8_t *telemetry_put16( uint8_t *p, uint16_t value )
+{
+	*p++ = (uint8_t) value;
+	*p++ = (uint8_t) (value >> 8);
+	return p;
+}
+
+static uint8_t *telemetry_put32( uint8_t *p, uint32_t value )
+{
+	p = telemetry_put16(p, (uint16_t) value);
+	return telemetry_put16(p, (uint16_t) (value >> 16));
+}
+
+static uint8_t telemetry_fill( uint16_t level )
+{
+	return (level > 255) ? 255 : (uint8_t) level;
+}
+
+bool telemetry_send( const struct telemetry_sample *sample )
+{
+	//false when the transmit ring had no room for the frame
+	uint8_t frame[TELEMETRY_FRAME_LEN];
+	uint8_t *p = frame;
+	int i;
+
+	*p++ = TELEMETRY_SYNC_0;
+	*p++ = TELEMETRY_SYNC_1;
+	*p++ = TELEMETRY_STATUS_LEN;
+	*p++ = TELEMETRY_TYPE_STATUS;
+	p = telemetry_put32(p, sample->tick_ms);
+	p = telemetry_put16(p, sample->load_avg);
+	p = telemetry_put16(p, sample->load_peak);
+	*p++ = sample->voices;
+	*p++ = sample->frames_active;
+	p = telemetry_put32(p, sample->blocks);
+	p = telemetry_put32(p, sample->underruns);
+	p = telemetry_put32(p, sample->overruns);
+	for(i=0; i<TELEMETRY_FILLS; i++)
+	{
+		*p++ = telemetry_fill(sample->fills[i]->current);
+		*p++ = telemetry_fill(sample->fills[i]->min);
+		*p++ = telemetry_fill(sample->fills[i]->max);
+	}
+	p = telemetry_put16(p, sample->midi_dropped);
+	p = telemetry_put16(p, sample->events_dropped);
+	p = telemetry_put16(p, sample->midi_framing);
+	p = telemetry_put16(p, sample->midi_overflow);
+	p = telemetry_put16(p, sample->midi_parity);
+
+	return telemetry_finish(frame, TELEMETRY_FRAME_LEN);
+}
+
+#if SYNTH_METERS
+bool telemetry_send_levels( uint32_t tick_ms, const struct synth_levels *levels )
+{
+	//false when the transmit ring had no room for the frame
+	uint8_t frame[TELEMETRY_LEVELS_LEN + 6];
+	uint8_t *p = frame;
+	int i;
+
+	*p++ = TELEMETRY_SYNC_0;
+	*p++ = TELEMETRY_SYNC_1;
+	*p++ = TELEMETRY_LEVELS_LEN;
+	*p++ = TELEMETRY_TYPE_LEVELS;
+	p = telemetry_put32(p, tick_ms);
+	*p++ = SYNTH_OUTPUT_CHANNELS;
+	for(i=0; i<SYNTH_OUTPUT_CHANNELS; i++)
+	{
+		p = telemetry_put16(p, levels->output[i].peak);
+		p = telemetry_put16(p, levels->output[i].rms);
+	}
+	*p++ = SYNTH_MAX_VOICES;
+	for(i=0; i<SYNTH_MAX_VOICES; i++)
+	{
+		*p++ = (uint8_t) (levels->voice[i].peak >> 7);
+		*p++ = (uint8_t) (levels->voice[i].rms >> 7);
+	}
+
+	return telemetry_finish(frame, TELEMETRY_LEVELS_LEN + 6);
+}
+#endif
+
+static bool telemetry_finish( uint8_t *frame, int length )
+{
+	//Fletcher-16 from the length byte on into the last two bytes, then the whole frame out
+	uint32_t sum_a = 0;
+	uint32_t sum_b = 0;
+	int i;
+
+	for(i=2; i<length - 2; i++)
+	{
+		sum_a += frame[i];
+		sum_b += sum_a;
+	}
+	frame[length - 2] = (uint8_t) (sum_a % 255);
+	frame[length - 1] = (uint8_t) (sum_b % 255);
+
+	return debug_uart_write(frame, length);
+}
+
+#endif /* SYNTH_TELEMETRY */
@@ -0,0 +1,74 @@
+/*************************************************************************************************
+                                          --TELEMETRY--
+
+	Framed binary status on the EDBG port, for tools/telemetry.py. Every
+	SYNTH_TELEMETRY_PERIOD_MS the console task packs a struct telemetry_sample into one
+	frame and queues it whole or not at all, so a full transmit ring costs a frame instead
+	of a formatting stall. The 'b' console command switches the stream on and off, it
+	starts as SYNTH_TELEMETRY_START says.
+
+	A frame, multi-byte fields little-endian:
+
+		0xA5 0x5A, payload length, frame type, payload, Fletcher-16 of length, type and payload
+
+	Frame type 1 is the status payload below, in field order; fill levels saturate at 255.
+
+		tick ms (4), load avg and peak per mille (2 + 2), voices (1), output frames (1),
+		blocks, underruns, overruns (4 each), output, free, midi and events fill as now,
+		min and max over the period (1 each), MIDI bytes dropped, events dropped, and the
+		MIDI input's framing, overflow and parity errors (2 each)
+
+	Frame type 2 follows it with SYNTH_METERS, the levels of synth_levels():
+
+		tick ms (4), output channels (1), then each channel's peak and rms in DAC units
+		(2 + 2), voices (1), then each voice's peak and rms as the top byte of the Q15 gain
+		(1 + 1)
+
+*************************************************************************************************/
+
+#ifndef TELEMETRY_H_INCLUDED
+#define TELEMETRY_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fill_stats.h"
+#include "conf_synth.h"
+#if SYNTH_METERS
+#  include "synth_engine.h"
+#endif
+
+/**********  DEFINE  ************/
+#define TELEMETRY_SYNC_0			(	0xA5	)
+#define TELEMETRY_SYNC_1			(	0x5A	)
+#define TELEMETRY_TYPE_STATUS		(	1	)
+#define TELEMETRY_TYPE_LEVELS		(	2	)
+
+#define TELEMETRY_FILLS				(	4	)
+
+/********   TYPE DEFS  **********/
+struct telemetry_sample{
+	uint32_t tick_ms;
+	uint16_t load_avg;
+	uint16_t load_peak;
+	uint8_t voices;
+	uint8_t frames_active;
+	uint32_t blocks;
+	uint32_t underruns;
+	uint32_t overruns;
+	const struct fill_stats *fills[TELEMETRY_FILLS];	//output, free, midi, events
+	uint16_t midi_dropped;
+	uint16_t events_dropped;
+	uint16_t midi_framing;
+	uint16_t midi_overflow;
+	uint16_t midi_parity;
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void telemetry_set_enabled( bool enabled );
+bool telemetry_enabled( void );
+bool telemetry_send( const struct telemetry_sample *sample );
+#if SYNTH_METERS
+bool telemetry_send_levels( uint32_t tick_ms, const struct synth_levels *levels );
+#endif
+
+#endif /* TELEMETRY_H_INCLUDED */
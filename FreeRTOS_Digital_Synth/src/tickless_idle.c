@@ -0,0 +1,121 @@
+/*************************************************************************************************
+                                        --TICKLESS IDLE--
+
+	Follows the SysTick scheme of the FreeRTOS CM3 port. SysTick is stopped, loaded with the
+	remainder of the current tick plus the idle ticks, and restarted around the WFI. After
+	waking, the counter tells how many whole ticks passed: either the long period ran out
+	(the pended SysTick interrupt accounts for the last tick) or another interrupt woke the
+	core part way through. The kernel tick count is stepped forward accordingly.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "tickless_idle.h"
+#include "power_save.h"
+
+
+/**********  DEFINE  ************/
+//cycles SysTick is stopped for while it is reprogrammed
+#define SYSTICK_STOPPED_COMPENSATION	(	45	)
+
+
+/*******   GLOBAL VARS  *********/
+//SysTick counts per kernel tick at the current CPU clock (see tickless_idle_set_clock()), and
+//the longest sleep the 24-bit reload allows, 349 ticks at 48 MHz and 1 kHz
+static uint32_t counts_per_tick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+static uint32_t max_idle_ticks = SysTick_LOAD_RELOAD_Msk / (configCPU_CLOCK_HZ / configTICK_RATE_HZ);
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void tickless_idle_init( void )
+{
+	//IDLE 0 stops only the CPU clock, the AHB and APB buses keep DMA and peripherals alive
+	system_set_sleepmode(SYSTEM_SLEEPMODE_IDLE_0);
+}
+
+void tickless_idle_set_clock( uint32_t cpu_hz )
+{
+	//called in a critical section right after the CPU clock changed, the tick in progress
+	//restarts at the new length
+	counts_per_tick = cpu_hz / configTICK_RATE_HZ;
+	max_idle_ticks = SysTick_LOAD_RELOAD_Msk / counts_per_tick;
+
+	SysTick->LOAD = counts_per_tick - 1;
+	SysTick->VAL = 0;
+}
+
+void tickless_idle_sleep( portTickType expected_idle_ticks )
+{
+	//called by the idle task with the scheduler suspended
+	uint32_t reload;
+	uint32_t ctrl;
+	uint32_t elapsed;
+	uint32_t complete_ticks;
+
+	//':power 0' keeps the core awake, the tick runs as usual
+	if(!power_sleep_enabled()) return;
+
+	if(expected_idle_ticks > max_idle_ticks) expected_idle_ticks = max_idle_ticks;
+
+	//stop SysTick while the reload value is worked out; the time it is stopped is small
+	//and compensated for
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	reload = SysTick->VAL + (counts_per_tick * (expected_idle_ticks - 1));
+	if(reload > SYSTICK_STOPPED_COMPENSATION) reload -= SYSTICK_STOPPED_COMPENSATION;
+
+	//interrupts stay pending through the WFI below and run once they are enabled again
+	cpu_irq_disable();
+
+	if(eTaskConfirmSleepModeStatus() == eAbortSleep)
+	{
+		//a task became ready meanwhile, restart the current tick from where it stopped
+		SysTick->LOAD = SysTick->VAL;
+		SysTick->VAL = 0;
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		SysTick->LOAD = counts_per_tick - 1;
+		cpu_irq_enable();
+		return;
+	}
+
+	SysTick->LOAD = reload;
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	power_sleep();
+
+	//reading CTRL clears COUNTFLAG, so keep the value
+	ctrl = SysTick->CTRL;
+	SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+	cpu_irq_enable();
+
+	if(ctrl & SysTick_CTRL_COUNTFLAG_Msk)
+	{
+		//the idle time ran out, the SysTick interrupt that just ran counted the final tick
+		elapsed = (counts_per_tick - 1) - (reload - SysTick->VAL);
+		if(elapsed < SYSTICK_STOPPED_COMPENSATION || elapsed > counts_per_tick) elapsed = counts_per_tick - 1;
+
+		SysTick->LOAD = elapsed;
+		complete_ticks = expected_idle_ticks - 1;
+	}
+	else
+	{
+		//woken early by another interrupt, count the whole ticks that passed and finish
+		//the partial one with a shortened period
+		elapsed = (expected_idle_ticks * counts_per_tick) - SysTick->VAL;
+		complete_ticks = elapsed / counts_per_tick;
+
+		SysTick->LOAD = ((complete_ticks + 1) * counts_per_tick) - elapsed;
+	}
+
+	//restart with the shortened period, then fall back to the normal tick length
+	SysTick->VAL = 0;
+	portENTER_CRITICAL();
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	vTaskStepTick(complete_ticks);
+	SysTick->LOAD = counts_per_tick - 1;
+	portEXIT_CRITICAL();
+}
@@ -0,0 +1,24 @@
+/*************************************************************************************************
+                                        --TICKLESS IDLE--
+
+	Low-power idle for the FreeRTOS CM0 port, which has no tick suppression of its own. When
+	the kernel expects to idle for several ticks, SysTick is reprogrammed to fire once at the
+	end of that time and the core sleeps until then or until any interrupt. IDLE 0 only
+	gates the CPU clock, so the DMAC, the TC3 sample clock and the SERCOMs keep running and
+	the audio output is unaffected.
+
+	The tick length follows the CPU clock, tickless_idle_set_clock() is told when it changes.
+
+*************************************************************************************************/
+
+#ifndef TICKLESS_IDLE_H_INCLUDED
+#define TICKLESS_IDLE_H_INCLUDED
+
+#include "FreeRTOS.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void tickless_idle_init( void );
+void tickless_idle_set_clock( uint32_t cpu_hz );
+void tickless_idle_sleep( portTickType expected_idle_ticks );
+
+#endif /* TICKLESS_IDLE_H_INCLUDED */
@@ -0,0 +1,191 @@
+/*************************************************************************************************
+                                         --TRACE LOG--
+
+	Producers may be any mix of ISRs and tasks. The only shared step is claiming a slot,
+	which masks interrupts for the few instructions of the index update (the M0+ has no
+	exclusive load/store). The record is filled outside that window and published with a
+	ready flag, so the single consumer never reads a half written entry and never blocks a
+	producer.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <asf.h>
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "trace_log.h"
+
+
+/**********  DEFINE  ************/
+#define trace_log_barrier()		__asm volatile ("" ::: "memory")
+
+
+/********   TYPE DEFS  **********/
+struct trace_record{
+	const char *fmt;
+	uint32_t arg;
+	volatile bool ready;
+};
+
+struct trace_job{
+	trace_job_t run;
+	uint16_t period;	//ticks, 0 runs it on every pass
+	portTickType last;
+};
+
+
+/*******   GLOBAL VARS  *********/
+static struct trace_record trace_records[TRACE_LOG_SIZE];
+static volatile uint16_t trace_head;
+static volatile uint16_t trace_tail;
+static volatile uint16_t trace_dropped;
+static trace_command_t trace_command;
+static struct trace_job trace_jobs[TRACE_LOG_JOBS];
+static uint8_t trace_job_count;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void trace_log( const char *fmt, uint32_t arg )
+{
+	//safe from ISRs and tasks, never blocks, drops the record when the ring is full
+	irqflags_t flags;
+	uint16_t head;
+	struct trace_record *rec;
+
+	flags = cpu_irq_save();
+	head = trace_head;
+	if((uint16_t) (head - trace_tail) >= TRACE_LOG_SIZE)
+	{
+		trace_dropped++;
+		cpu_irq_restore(flags);
+		return;
+	}
+	trace_head = head + 1;
+	cpu_irq_restore(flags);
+
+	rec = &trace_records[head & TRACE_LOG_MASK];
+	rec->fmt = fmt;
+	rec->arg = arg;
+	trace_log_barrier();
+	rec->ready = true;
+}
+
+bool trace_log_pop( const char **fmt, uint32_t *arg )
+{
+	//consumer side, stops at a claimed slot whose producer has not finished yet
+	uint16_t tail = trace_tail;
+	struct trace_record *rec;
+
+	if(tail == trace_head) return false;
+
+	rec = &trace_records[tail & TRACE_LOG_MASK];
+	if(rec->ready == false) return false;
+
+	*fmt = rec->fmt;
+	*arg = rec->arg;
+	rec->ready = false;
+	trace_log_barrier();
+	trace_tail = tail + 1;
+
+	return true;
+}
+
+int trace_log_snapshot( const char **fmt, uint32_t *arg, int max )
+{
+	//copies the records not printed yet without taking them, for a post-mortem from an ISR;
+	//stops like trace_log_pop() at a slot whose producer has not finished
+	uint16_t tail = trace_tail;
+	struct trace_record *rec;
+	int count = 0;
+
+	while((count < max) && (tail != trace_head))
+	{
+		rec = &trace_records[tail & TRACE_LOG_MASK];
+		if(rec->ready == false) break;
+
+		fmt[count] = rec->fmt;
+		arg[count] = rec->arg;
+		count++;
+		tail++;
+	}
+
+	return count;
+}
+
+uint16_t trace_log_dropped( void )
+{
+	return trace_dropped;
+}
+
+
+void trace_log_set_command_handler( trace_command_t handler )
+{
+	trace_command = handler;
+}
+
+bool trace_log_add_job( trace_job_t job, uint16_t period_ticks )
+{
+	//before the scheduler starts; a job runs at most once per pass, so periods round up to
+	//TRACE_LOG_DRAIN_TICKS
+	struct trace_job *j;
+
+	if(trace_job_count >= TRACE_LOG_JOBS) return false;
+
+	j = &trace_jobs[trace_job_count++];
+	j->run = job;
+	j->period = period_ticks;
+	j->last = 0;
+	return true;
+}
+
+static void trace_log_run_jobs( void )
+{
+	portTickType now = xTaskGetTickCount();
+	uint8_t i;
+
+	for(i=0; i<trace_job_count; i++)
+	{
+		if((portTickType) (now - trace_jobs[i].last) < trace_jobs[i].period) continue;
+		trace_jobs[i].last = now;
+		trace_jobs[i].run();
+	}
+}
+
+static void trace_log_poll_console( void )
+{
+	//non-blocking read of whatever arrived on the stdio USART since the last pass
+	uint16_t c;
+
+	if(trace_command == NULL || stdio_base == NULL) return;
+
+	while(usart_read_wait((struct usart_module *) stdio_base, &c) == STATUS_OK) trace_command((char) c);
+}
+
+
+/******  FreeRTOS TASKS   *******/
+void vTraceLogTask( void *pvParameters )
+{
+	const char *fmt;
+	uint32_t arg;
+	uint16_t dropped_reported = 0;
+	uint16_t dropped;
+
+	while(1)
+	{
+		//prints everything logged since the last pass to the EDBG port
+		while(trace_log_pop(&fmt, &arg)) printf(fmt, arg);
+
+		dropped = trace_dropped;
+		if(dropped != dropped_reported)
+		{
+			printf("trace: %u records dropped\r\n", (unsigned int) (uint16_t) (dropped - dropped_reported));
+			dropped_reported = dropped;
+		}
+
+		trace_log_poll_console();
+		trace_log_run_jobs();
+
+		vTaskDelay(TRACE_LOG_DRAIN_TICKS);
+	}
+}
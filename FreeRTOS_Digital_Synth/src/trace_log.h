@@ -0,0 +1,54 @@
+/*************************************************************************************************
+                                         --TRACE LOG--
+
+	Deferred log for ISRs and tasks. A log call only stores a format string pointer and one
+	argument in a fixed ring, formatting and the slow EDBG USART output happen later in the
+	low-priority vTraceLogTask. Format strings must be string literals (they are kept by
+	pointer) and take at most one integer argument.
+
+	The same task polls the EDBG port for console input and passes each received character
+	to the handler set with trace_log_set_command_handler(). It is also the one task for
+	low-rate housekeeping: the jobs added with trace_log_add_job() run on its passes, each at
+	its own period, so telemetry and the like need no task and stack of their own.
+
+*************************************************************************************************/
+
+#ifndef TRACE_LOG_H_INCLUDED
+#define TRACE_LOG_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********  DEFINE  ************/
+#ifndef TRACE_LOG_SIZE
+#  define TRACE_LOG_SIZE		(	32	)
+#endif
+
+#define TRACE_LOG_MASK			(	TRACE_LOG_SIZE - 1	)
+
+#if (TRACE_LOG_SIZE & TRACE_LOG_MASK)
+#  error "TRACE_LOG_SIZE must be a power of two"
+#endif
+
+//period of the drain task in ticks
+#define TRACE_LOG_DRAIN_TICKS	(	20	)
+
+//housekeeping jobs the drain task can run
+#ifndef TRACE_LOG_JOBS
+#  define TRACE_LOG_JOBS		(	8	)
+#endif
+
+/********   TYPE DEFS  **********/
+typedef void (*trace_command_t)(char c);
+typedef void (*trace_job_t)(void);
+
+/****** FUNCTION PROTOTYPES  ****/
+void trace_log( const char *fmt, uint32_t arg );
+bool trace_log_pop( const char **fmt, uint32_t *arg );
+int trace_log_snapshot( const char **fmt, uint32_t *arg, int max );
+uint16_t trace_log_dropped( void );
+void trace_log_set_command_handler( trace_command_t handler );
+bool trace_log_add_job( trace_job_t job, uint16_t period_ticks );
+void vTraceLogTask( void *pvParameters );
+
+#endif /* TRACE_LOG_H_INCLUDED */
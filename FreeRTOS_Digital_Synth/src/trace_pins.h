@@ -0,0 +1,59 @@
+/*************************************************************************************************
+                                         --TRACE PINS--
+
+	Timing markers for a logic analyser. With SYNTH_TRACE_PINS set, four pins on EXT1 go
+	high for the length of something worth timing and low again after it:
+
+		SYNTH_TRACE_PIN_RENDER		a block being rendered and submitted, in the render task
+		SYNTH_TRACE_PIN_DAC			a frame handover in the DMA interrupt, or a CPU-driven
+									DAC write in the sample timer interrupt
+		SYNTH_TRACE_PIN_MIDI_ISR	the MIDI USART receive interrupt
+		SYNTH_TRACE_PIN_MIDI_PARSE	the interpreter parsing and posting one byte
+
+	The edges go through the single-cycle I/O port, fast_gpio.h, so they cost a store each
+	and sit where the code is. Interrupts nest inside the render and parse pulses, the ISR
+	pins show which. With SYNTH_TRACE_PINS clear the markers compile to nothing and the pins
+	are left alone.
+
+*************************************************************************************************/
+
+#ifndef TRACE_PINS_H_INCLUDED
+#define TRACE_PINS_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "fast_gpio.h"
+
+/**********  DEFINE  ************/
+#if SYNTH_TRACE_PINS
+#  define TRACE_PIN_HIGH(pin)		fast_pin_high(pin)
+#  define TRACE_PIN_LOW(pin)		fast_pin_low(pin)
+#else
+#  define TRACE_PIN_HIGH(pin)		((void) 0)
+#  define TRACE_PIN_LOW(pin)		((void) 0)
+#endif
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline void trace_pins_init( void )
+{
+#if SYNTH_TRACE_PINS
+	static const uint8_t pins[] = {
+		SYNTH_TRACE_PIN_RENDER,
+		SYNTH_TRACE_PIN_DAC,
+		SYNTH_TRACE_PIN_MIDI_ISR,
+		SYNTH_TRACE_PIN_MIDI_PARSE
+	};
+	struct port_config pin_conf;
+	uint8_t i;
+
+	port_get_config_defaults(&pin_conf);
+	pin_conf.direction = PORT_PIN_DIR_OUTPUT;
+	for(i=0; i<sizeof(pins); i++)
+	{
+		port_pin_set_config(pins[i], &pin_conf);
+		port_pin_set_output_level(pins[i], false);
+	}
+#endif
+}
+
+#endif /* TRACE_PINS_H_INCLUDED */
@@ -0,0 +1,402 @@
+/*************************************************************************************************
+                                          --USB MIDI--
+
+	Everything runs in the USB interrupt. Control transfers are answered from endpoint 0's
+	two banks: the setup packet lands in the OUT bank, replies go out of the IN bank, whose
+	multi-packet mode splits the 72-byte configuration descriptor by itself. A new address
+	only applies once the status stage of SET_ADDRESS has gone out, so it is held until that
+	IN transfer completes.
+
+	Class requests are stalled, MIDI streaming has none that a host needs. A USB-MIDI event
+	packet carries a cable number and a code index whose low nibble gives how many of its
+	three bytes are MIDI; the cable is ignored, there is only the one jack.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <string.h>
+#include "usb_midi.h"
+
+#if SYNTH_USB_MIDI
+
+/**********  DEFINE  ************/
+#define USB_EP0_SIZE			(	64	)
+#define USB_MIDI_EP				(	1	)
+#define USB_MIDI_EP_SIZE		(	64	)
+#define USB_PCKSIZE_64			(	3	)	//PCKSIZE.SIZE of a 64-byte endpoint
+#define USB_EPTYPE_CONTROL		(	1	)
+#define USB_EPTYPE_BULK			(	3	)
+
+#define USB_CONFIG_LEN			(	72	)
+
+//standard requests
+#define USB_REQ_GET_STATUS		(	0	)
+#define USB_REQ_CLEAR_FEATURE	(	1	)
+#define USB_REQ_SET_FEATURE		(	3	)
+#define USB_REQ_SET_ADDRESS		(	5	)
+#define USB_REQ_GET_DESCRIPTOR	(	6	)
+#define USB_REQ_GET_CONFIG		(	8	)
+#define USB_REQ_SET_CONFIG		(	9	)
+#define USB_REQ_GET_INTERFACE	(	10	)
+#define USB_REQ_SET_INTERFACE	(	11	)
+#define USB_REQ_TYPE_MASK		(	0x60	)
+
+//descriptor types
+#define USB_DESC_DEVICE			(	1	)
+#define USB_DESC_CONFIG			(	2	)
+#define USB_DESC_STRING			(	3	)
+#define USB_DESC_INTERFACE		(	4	)
+#define USB_DESC_ENDPOINT		(	5	)
+#define USB_DESC_CS_INTERFACE	(	0x24	)
+#define USB_DESC_CS_ENDPOINT	(	0x25	)
+
+
+/********   TYPE DEFS  **********/
+struct usb_setup{
+	uint8_t type;
+	uint8_t request;
+	uint16_t value;
+	uint16_t index;
+	uint16_t length;
+};
+
+
+/****** FUNCTION PROTOTYPES  ****/
+void USB_Handler( void );
+static void usb_bus_reset( void );
+static void usb_setup( const struct usb_setup *setup );
+static void usb_ep0_send( const uint8_t *data, uint16_t length, uint16_t requested );
+static void usb_ep0_stall( void );
+static uint16_t usb_string( uint8_t index );
+static void usb_midi_endpoint_init( void );
+static void usb_midi_received( void );
+
+
+/*******   GLOBAL VARS  *********/
+static const uint8_t usb_device_desc[] = {
+	18, USB_DESC_DEVICE, 0x00, 0x02,		//USB 2.0
+	0, 0, 0, USB_EP0_SIZE,					//class in the interfaces
+	SYNTH_USB_VID & 0xFF, SYNTH_USB_VID >> 8, SYNTH_USB_PID & 0xFF, SYNTH_USB_PID >> 8,
+	0x00, 0x01, 0, 1, 0, 1					//release 1.00, product string 1, one configuration
+};
+
+static const uint8_t usb_config_desc[USB_CONFIG_LEN] = {
+	//two interfaces, bus powered, 100 mA
+	9, USB_DESC_CONFIG, USB_CONFIG_LEN, 0, 2, 1, 0, 0x80, 50,
+	//audio control, which the class wants ahead of MIDI streaming; header only
+	9, USB_DESC_INTERFACE, 0, 0, 0, 1, 1, 0, 0,
+	9, USB_DESC_CS_INTERFACE, 1, 0x00, 0x01, 9, 0, 1, 1,
+	//MIDI streaming with one endpoint, class descriptors 36 bytes
+	9, USB_DESC_INTERFACE, 1, 0, 1, 1, 3, 0, 0,
+	7, USB_DESC_CS_INTERFACE, 1, 0x00, 0x01, 36, 0,
+	//embedded IN jack 1, which the endpoint feeds, on to external OUT jack 2, the synth
+	6, USB_DESC_CS_INTERFACE, 2, 1, 1, 0,
+	9, USB_DESC_CS_INTERFACE, 3, 2, 2, 1, 1, 1, 0,
+	//bulk OUT endpoint 1, into jack 1
+	9, USB_DESC_ENDPOINT, USB_MIDI_EP, 2, USB_MIDI_EP_SIZE, 0, 0, 0, 0,
+	5, USB_DESC_CS_ENDPOINT, 1, 1, 1
+};
+
+static const char usb_product[] = SYNTH_USB_PRODUCT;
+
+//MIDI bytes in a packet by code index number; 0 and 1 are reserved
+static const uint8_t usb_cin_length[16] = { 0, 0, 2, 3, 3, 1, 2, 3, 3, 3, 3, 3, 2, 2, 3, 1 };
+
+//endpoint descriptors and buffers, read and written by the USB module itself
+COMPILER_ALIGNED(4)
+static UsbDeviceDescriptor usb_endpoints[USB_MIDI_EP + 1];
+COMPILER_ALIGNED(4)
+static uint8_t usb_ep0_out[USB_EP0_SIZE];
+COMPILER_ALIGNED(4)
+static uint8_t usb_ep0_in[USB_CONFIG_LEN];
+COMPILER_ALIGNED(4)
+static uint8_t usb_midi_out[USB_MIDI_EP_SIZE];
+
+static struct midi_ring *usb_ring;
+static uint32_t (*usb_now)( void );
+static void (*usb_wake)( void );
+
+static uint8_t usb_address;			//from SET_ADDRESS, waiting for its status stage
+static volatile uint8_t usb_config;
+static volatile uint32_t usb_packets;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void usb_midi_init( struct midi_ring *ring, uint32_t (*now)( void ), void (*wake)( void ) )
+{
+	//brings up the USB module and attaches to the bus
+	struct system_pinmux_config pin_conf;
+	struct system_gclk_chan_config gclk_conf;
+	uint32_t transn;
+	uint32_t transp;
+	uint32_t trim;
+
+	usb_ring = ring;
+	usb_now = now;
+	usb_wake = wake;
+
+	PM->APBBMASK.reg |= PM_APBBMASK_USB;
+	PM->AHBMASK.reg |= PM_AHBMASK_USB;
+
+	system_pinmux_get_config_defaults(&pin_conf);
+	pin_conf.mux_position = MUX_PA24G_USB_DM;
+	system_pinmux_pin_set_config(PIN_PA24G_USB_DM, &pin_conf);
+	pin_conf.mux_position = MUX_PA25G_USB_DP;
+	system_pinmux_pin_set_config(PIN_PA25G_USB_DP, &pin_conf);
+
+	system_gclk_chan_get_config_defaults(&gclk_conf);
+	gclk_conf.source_generator = SYNTH_FIXED_GCLK;
+	system_gclk_chan_set_config(USB_GCLK_ID, &gclk_conf);
+	system_gclk_chan_enable(USB_GCLK_ID);
+
+	USB->DEVICE.CTRLA.reg = USB_CTRLA_SWRST;
+	while(USB->DEVICE.SYNCBUSY.reg & USB_SYNCBUSY_SWRST);
+
+	//pad calibration from the NVM calibration row, an erased field gets the datasheet default
+	transn = (*((uint32_t *) USB_FUSES_TRANSN_ADDR) & USB_FUSES_TRANSN_Msk) >> USB_FUSES_TRANSN_Pos;
+	transp = (*((uint32_t *) USB_FUSES_TRANSP_ADDR) & USB_FUSES_TRANSP_Msk) >> USB_FUSES_TRANSP_Pos;
+	trim = (*((uint32_t *) USB_FUSES_TRIM_ADDR) & USB_FUSES_TRIM_Msk) >> USB_FUSES_TRIM_Pos;
+	if(transn == 0x1F) transn = 5;
+	if(transp == 0x1F) transp = 29;
+	if(trim == 0x7) trim = 3;
+	USB->DEVICE.PADCAL.reg = USB_PADCAL_TRANSN(transn) | USB_PADCAL_TRANSP(transp) | USB_PADCAL_TRIM(trim);
+
+	USB->DEVICE.DESCADD.reg = (uint32_t) usb_endpoints;
+	USB->DEVICE.CTRLA.reg = USB_CTRLA_MODE_DEVICE | USB_CTRLA_ENABLE;
+	while(USB->DEVICE.SYNCBUSY.reg & USB_SYNCBUSY_ENABLE);
+
+	USB->DEVICE.INTENSET.reg = USB_DEVICE_INTENSET_EORST;
+	NVIC_EnableIRQ(USB_IRQn);
+
+	//full speed with DETACH clear, the D+ pull-up tells the host a device is there
+	USB->DEVICE.CTRLB.reg = USB_DEVICE_CTRLB_SPDCONF_FS;
+}
+
+bool usb_midi_configured( void )
+{
+	return usb_config != 0;
+}
+
+uint32_t usb_midi_packets( void )
+{
+	return usb_packets;
+}
+
+static void usb_bus_reset( void )
+{
+	//back to address 0 with only the control endpoint
+	UsbDeviceEndpoint *ep0 = &USB->DEVICE.DeviceEndpoint[0];
+
+	usb_config = 0;
+	usb_address = 0;
+	USB->DEVICE.DADD.reg = 0;
+	USB->DEVICE.DeviceEndpoint[USB_MIDI_EP].EPCFG.reg = 0;
+
+	usb_endpoints[0].DeviceDescBank[0].ADDR.reg = (uint32_t) usb_ep0_out;
+	usb_endpoints[0].DeviceDescBank[0].PCKSIZE.reg = USB_DEVICE_PCKSIZE_SIZE(USB_PCKSIZE_64) |
+		USB_DEVICE_PCKSIZE_MULTI_PACKET_SIZE(USB_EP0_SIZE);
+	usb_endpoints[0].DeviceDescBank[1].ADDR.reg = (uint32_t) usb_ep0_in;
+	usb_endpoints[0].DeviceDescBank[1].PCKSIZE.reg = USB_DEVICE_PCKSIZE_SIZE(USB_PCKSIZE_64);
+
+	ep0->EPCFG.reg = USB_DEVICE_EPCFG_EPTYPE0(USB_EPTYPE_CONTROL) | USB_DEVICE_EPCFG_EPTYPE1(USB_EPTYPE_CONTROL);
+	ep0->EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_BK0RDY;
+	ep0->EPINTENSET.reg = USB_DEVICE_EPINTENSET_RXSTP | USB_DEVICE_EPINTENSET_TRCPT1;
+}
+
+static void usb_ep0_send( const uint8_t *data, uint16_t length, uint16_t requested )
+{
+	//IN data stage, or the status stage of a request without data when length is 0
+	uint32_t pcksize = USB_DEVICE_PCKSIZE_SIZE(USB_PCKSIZE_64);
+
+	if(length > requested) length = requested;
+	if((length != 0) && (data != usb_ep0_in)) memcpy(usb_ep0_in, data, length);
+
+	//a reply shorter than asked for that ends on a packet boundary needs a zero length packet
+	if((length != 0) && (length < requested) && (length % USB_EP0_SIZE == 0)) pcksize |= USB_DEVICE_PCKSIZE_AUTO_ZLP;
+
+	usb_endpoints[0].DeviceDescBank[1].PCKSIZE.reg = pcksize | USB_DEVICE_PCKSIZE_BYTE_COUNT(length);
+	USB->DEVICE.DeviceEndpoint[0].EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_BK1RDY;
+}
+
+static void usb_ep0_stall( void )
+{
+	//both directions, lifted by the next setup packet
+	USB->DEVICE.DeviceEndpoint[0].EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_STALLRQ(3);
+}
+
+static uint16_t usb_string( uint8_t index )
+{
+	//builds string descriptor index in the IN buffer, 0 when there is no such string
+	uint16_t length;
+	int i;
+
+	if(index == 0)
+	{
+		//language list: US English
+		usb_ep0_in[2] = 0x09;
+		usb_ep0_in[3] = 0x04;
+		length = 4;
+	}
+	else if(index == 1)
+	{
+		length = 2;
+		for(i=0; (usb_product[i] != '\0') && (length + 2 <= USB_CONFIG_LEN); i++)
+		{
+			usb_ep0_in[length++] = (uint8_t) usb_product[i];
+			usb_ep0_in[length++] = 0;
+		}
+	}
+	else return 0;
+
+	usb_ep0_in[0] = (uint8_t) length;
+	usb_ep0_in[1] = USB_DESC_STRING;
+	return length;
+}
+
+static void usb_setup( const struct usb_setup *setup )
+{
+	//standard requests, anything else stalls
+	static const uint8_t zero[2] = { 0, 0 };
+	uint16_t length;
+
+	if((setup->type & USB_REQ_TYPE_MASK) != 0)
+	{
+		usb_ep0_stall();
+		return;
+	}
+
+	switch(setup->request)
+	{
+		case USB_REQ_GET_DESCRIPTOR:
+			switch(setup->value >> 8)
+			{
+				case USB_DESC_DEVICE:
+					usb_ep0_send(usb_device_desc, sizeof(usb_device_desc), setup->length);
+					return;
+				case USB_DESC_CONFIG:
+					usb_ep0_send(usb_config_desc, sizeof(usb_config_desc), setup->length);
+					return;
+				case USB_DESC_STRING:
+					length = usb_string((uint8_t) setup->value);
+					if(length == 0) break;
+					usb_ep0_send(usb_ep0_in, length, setup->length);
+					return;
+				default:
+					break;
+			}
+			break;
+		case USB_REQ_SET_ADDRESS:
+			usb_address = (uint8_t) (setup->value & 0x7F);
+			usb_ep0_send(NULL, 0, 0);
+			return;
+		case USB_REQ_SET_CONFIG:
+			if(setup->value > 1) break;
+			usb_config = (uint8_t) setup->value;
+			if(usb_config) usb_midi_endpoint_init();
+			else USB->DEVICE.DeviceEndpoint[USB_MIDI_EP].EPCFG.reg = 0;
+			usb_ep0_send(NULL, 0, 0);
+			return;
+		case USB_REQ_GET_CONFIG:
+			usb_ep0_in[0] = usb_config;
+			usb_ep0_send(usb_ep0_in, 1, setup->length);
+			return;
+		case USB_REQ_GET_STATUS:
+			usb_ep0_send(zero, 2, setup->length);
+			return;
+		case USB_REQ_GET_INTERFACE:
+			usb_ep0_send(zero, 1, setup->length);
+			return;
+		case USB_REQ_SET_INTERFACE:
+			if(setup->value != 0) break;
+			usb_ep0_send(NULL, 0, 0);
+			return;
+		case USB_REQ_CLEAR_FEATURE:
+		case USB_REQ_SET_FEATURE:
+			//remote wake-up and halt are acknowledged and not kept
+			usb_ep0_send(NULL, 0, 0);
+			return;
+		default:
+			break;
+	}
+
+	usb_ep0_stall();
+}
+
+static void usb_midi_endpoint_init( void )
+{
+	//bulk OUT, one packet per transfer
+	UsbDeviceEndpoint *ep = &USB->DEVICE.DeviceEndpoint[USB_MIDI_EP];
+
+	usb_endpoints[USB_MIDI_EP].DeviceDescBank[0].ADDR.reg = (uint32_t) usb_midi_out;
+	usb_endpoints[USB_MIDI_EP].DeviceDescBank[0].PCKSIZE.reg = USB_DEVICE_PCKSIZE_SIZE(USB_PCKSIZE_64) |
+		USB_DEVICE_PCKSIZE_MULTI_PACKET_SIZE(USB_MIDI_EP_SIZE);
+
+	ep->EPCFG.reg = USB_DEVICE_EPCFG_EPTYPE0(USB_EPTYPE_BULK);
+	ep->EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_DTGLOUT | USB_DEVICE_EPSTATUSCLR_BK0RDY;
+	ep->EPINTENSET.reg = USB_DEVICE_EPINTENSET_TRCPT0;
+}
+
+static void usb_midi_received( void )
+{
+	//unpacks the event packets into the ring and frees the bank for the next transfer
+	UsbDeviceDescBank *bank = &usb_endpoints[USB_MIDI_EP].DeviceDescBank[0];
+	uint16_t count = bank->PCKSIZE.bit.BYTE_COUNT;
+	uint32_t time = usb_now();
+	uint16_t i;
+	uint8_t n;
+	uint8_t k;
+
+	for(i=0; i+4<=count; i+=4)
+	{
+		n = usb_cin_length[usb_midi_out[i] & 0x0F];
+		for(k=0; k<n; k++) midi_ring_push(usb_ring, usb_midi_out[i + 1 + k], time);
+	}
+	usb_packets++;
+
+	bank->PCKSIZE.reg = USB_DEVICE_PCKSIZE_SIZE(USB_PCKSIZE_64) | USB_DEVICE_PCKSIZE_MULTI_PACKET_SIZE(USB_MIDI_EP_SIZE);
+	USB->DEVICE.DeviceEndpoint[USB_MIDI_EP].EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_BK0RDY;
+
+	usb_wake();
+}
+
+
+/*****  INTERRUPT HANDLERS  *****/
+void USB_Handler( void )
+{
+	UsbDeviceEndpoint *ep0 = &USB->DEVICE.DeviceEndpoint[0];
+	UsbDeviceEndpoint *ep = &USB->DEVICE.DeviceEndpoint[USB_MIDI_EP];
+	uint8_t flags;
+
+	if(USB->DEVICE.INTFLAG.reg & USB_DEVICE_INTFLAG_EORST)
+	{
+		USB->DEVICE.INTFLAG.reg = USB_DEVICE_INTFLAG_EORST;
+		usb_bus_reset();
+	}
+
+	flags = ep0->EPINTFLAG.reg;
+	if(flags & USB_DEVICE_EPINTFLAG_RXSTP)
+	{
+		ep0->EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_RXSTP;
+		ep0->EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_STALLRQ(3);
+		usb_setup((const struct usb_setup *) usb_ep0_out);
+		ep0->EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_BK0RDY;
+	}
+	if(flags & USB_DEVICE_EPINTFLAG_TRCPT1)
+	{
+		//IN done; after SET_ADDRESS that was the status stage, the address applies now
+		ep0->EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRCPT1;
+		if(usb_address != 0)
+		{
+			USB->DEVICE.DADD.reg = USB_DEVICE_DADD_ADDEN | usb_address;
+			usb_address = 0;
+		}
+	}
+
+	if(ep->EPINTFLAG.reg & USB_DEVICE_EPINTFLAG_TRCPT0)
+	{
+		ep->EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRCPT0;
+		usb_midi_received();
+	}
+}
+
+#endif /* SYNTH_USB_MIDI */
@@ -0,0 +1,31 @@
+/*************************************************************************************************
+                                          --USB MIDI--
+
+	USB-MIDI class device on the SAMD21's full-speed USB port, the TARGET USB connector on
+	the Xplained Pro (PA24/PA25). The host sees a MIDI interface with one output port; the
+	bytes it sends arrive as 4-byte event packets on a bulk OUT endpoint, and the USB
+	interrupt unpacks each into the MIDI ring handed to usb_midi_init(), stamped with the
+	clock it was given, then calls the wake function once per packet. The ring is a second
+	input next to the UART's, with its own parser in the MIDI task, so running status on
+	one never completes a message on the other.
+
+	A driver of its own on the registers rather than the ASF device stack, which this tree
+	does not carry: enumeration, the standard requests and the one endpoint are all MIDI
+	needs. The USB clock is SYNTH_FIXED_GCLK, the DFLL, which must be locked to the 32 kHz
+	crystal: 47.97 MHz is within full speed's 0.25%, open loop is not.
+
+*************************************************************************************************/
+
+#ifndef USB_MIDI_H_INCLUDED
+#define USB_MIDI_H_INCLUDED
+
+#include <asf.h>
+#include "conf_synth.h"
+#include "midi_ring.h"
+
+/****** FUNCTION PROTOTYPES  ****/
+void usb_midi_init( struct midi_ring *ring, uint32_t (*now)( void ), void (*wake)( void ) );
+bool usb_midi_configured( void );
+uint32_t usb_midi_packets( void );
+
+#endif /* USB_MIDI_H_INCLUDED */
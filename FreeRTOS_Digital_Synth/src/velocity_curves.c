@@ -0,0 +1,36 @@
+/*************************************************************************************************
+                                     --VELOCITY CURVES--
+
+	Generated by tools/gen_velocity_curves.py, do not edit by hand.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "velocity_curves.h"
+
+
+/*******   GLOBAL VARS  *********/
+const uint16_t velocity_curves[VELOCITY_CURVE_COUNT][VELOCITY_CURVE_SIZE] = {
+	//LINEAR
+	{
+		32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 480, 512,
+		544, 576, 608, 640, 672, 704, 736, 768, 800, 832, 864, 896, 928, 960, 992, 1024,
+		1056, 1088, 1120, 1152, 1184, 1216, 1248, 1280, 1312, 1344, 1376, 1408, 1440, 1472, 1504, 1536,
+		1568, 1600, 1632, 1664, 1696, 1728, 1760, 1792, 1824, 1856, 1888, 1920, 1952, 1984, 2016, 2048,
+		2080, 2112, 2144, 2176, 2208, 2240, 2272, 2304, 2336, 2368, 2400, 2432, 2464, 2496, 2528, 2560,
+		2592, 2624, 2656, 2688, 2720, 2752, 2784, 2816, 2848, 2880, 2912, 2944, 2976, 3008, 3040, 3072,
+		3104, 3136, 3168, 3200, 3232, 3264, 3296, 3328, 3360, 3392, 3424, 3456, 3488, 3520, 3552, 3584,
+		3616, 3648, 3680, 3712, 3744, 3776, 3808, 3840, 3872, 3904, 3936, 3968, 4000, 4032, 4064, 4096,
+	},
+	//EXPONENTIAL
+	{
+		0, 42, 44, 46, 47, 49, 51, 53, 55, 57, 59, 61, 63, 66, 68, 71,
+		73, 76, 79, 82, 85, 88, 91, 94, 98, 101, 105, 109, 113, 117, 122, 126,
+		131, 136, 141, 146, 151, 157, 162, 168, 175, 181, 188, 195, 202, 209, 217, 225,
+		233, 242, 251, 260, 270, 280, 290, 301, 312, 324, 336, 348, 361, 374, 388, 402,
+		417, 432, 448, 465, 482, 500, 518, 538, 557, 578, 599, 622, 644, 668, 693, 719,
+		745, 773, 801, 831, 861, 893, 926, 960, 996, 1033, 1071, 1110, 1151, 1194, 1238, 1284,
+		1331, 1380, 1431, 1484, 1539, 1596, 1654, 1716, 1779, 1845, 1913, 1983, 2057, 2133, 2211, 2293,
+		2378, 2465, 2556, 2651, 2749, 2850, 2955, 3065, 3178, 3295, 3417, 3543, 3674, 3809, 3950, 4096,
+	},
+};
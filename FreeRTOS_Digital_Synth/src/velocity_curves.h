@@ -0,0 +1,33 @@
+/*************************************************************************************************
+                                     --VELOCITY CURVES--
+
+	Note-on velocity to voice amplitude, one const table per curve so they stay in flash.
+	The amplitude is looked up once per note-on and multiplied into the envelope gain at
+	control rate, the per-sample loops never see it. Regenerate velocity_curves.c with
+	tools/gen_velocity_curves.py.
+
+*************************************************************************************************/
+
+#ifndef VELOCITY_CURVES_H_INCLUDED
+#define VELOCITY_CURVES_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define VELOCITY_CURVE_SIZE		(	128	)
+
+//amplitudes are Q12, full scale 4096 at velocity 127
+#define VELOCITY_CURVE_SHIFT	(	12	)
+
+/********   TYPE DEFS  **********/
+enum velocity_curve{
+	VELOCITY_LINEAR,
+	VELOCITY_EXPONENTIAL,
+	VELOCITY_CURVE_COUNT
+};
+
+/*******   GLOBAL VARS  *********/
+extern const uint16_t velocity_curves[VELOCITY_CURVE_COUNT][VELOCITY_CURVE_SIZE];
+
+#endif /* VELOCITY_CURVES_H_INCLUDED */
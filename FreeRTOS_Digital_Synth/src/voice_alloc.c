@@ -0,0 +1,260 @@
+/*************************************************************************************************
+                                      --VOICE ALLOCATOR--
+
+	Each busy voice carries a priority made of its velocity and an age stamp. Stealing only
+	scans the busy voices when the free stack is empty, normal note on/off never loops.
+
+	The voices of one note in a group are chained through voice_next[], newest first, and
+	each carries its channel; a lookup follows the chain to the channel's voice. The chain
+	is longer than one only while channels sharing the group hold the same note.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "voice_alloc.h"
+
+
+/**********  DEFINE  ************/
+//slots per group, the first groups take one more when the split is uneven
+#define GROUP_SIZE(g)			(	(SYNTH_MAX_VOICES / SYNTH_VOICE_GROUPS) + (((g) < (SYNTH_MAX_VOICES % SYNTH_VOICE_GROUPS)) ? 1 : 0)	)
+
+
+/*******   GLOBAL VARS  *********/
+//note -> first voice of the note's chain per group, VOICE_NONE when the note has no voice; a
+//released note stays in the chain until the slot is freed or stolen, so striking it again on
+//its channel takes the same voice
+static int8_t note_voice[SYNTH_VOICE_GROUPS][128];
+
+//next voice of the same note and group, and the channel each voice plays for
+static int8_t voice_next[SYNTH_MAX_VOICES];
+static uint8_t voice_channel[SYNTH_MAX_VOICES];
+
+//voice -> note, VOICE_NONE when the slot is free or has been stolen from its note
+static int8_t voice_note[SYNTH_MAX_VOICES];
+
+//slot is held by a released note that is still fading out
+static bool voice_released[SYNTH_MAX_VOICES];
+
+//steal priority of each busy voice
+static uint8_t voice_velocity[SYNTH_MAX_VOICES];
+static uint32_t voice_age[SYNTH_MAX_VOICES];
+static uint32_t age_counter;
+
+//group of every slot, and where each group's slots start
+static uint8_t voice_group[SYNTH_MAX_VOICES];
+static uint8_t group_first[SYNTH_VOICE_GROUPS + 1];
+
+//free slot stack per group, stored in the group's own range of free_voices[]
+static int8_t free_voices[SYNTH_MAX_VOICES];
+static int free_count[SYNTH_VOICE_GROUPS];
+
+//slots off the free stack per group, and how many a group may have at once
+static int busy_count[SYNTH_VOICE_GROUPS];
+static int group_limit[SYNTH_VOICE_GROUPS];
+static int voice_limit;
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int voice_alloc_victim( int group );
+static int voice_lookup( int group, uint8_t channel, uint8_t note );
+static void voice_unlink( int voice );
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void voice_alloc_init( void )
+{
+	int g;
+	int i;
+	int n;
+
+	group_first[0] = 0;
+	for(g=0; g<SYNTH_VOICE_GROUPS; g++)
+	{
+		group_first[g + 1] = (uint8_t) (group_first[g] + GROUP_SIZE(g));
+
+		for(n=0; n<128; n++) note_voice[g][n] = VOICE_NONE;
+
+		for(i=group_first[g]; i<group_first[g + 1]; i++)
+		{
+			voice_group[i] = (uint8_t) g;
+			voice_note[i] = VOICE_NONE;
+			voice_released[i] = false;
+			//lowest slot on top so voices fill in ascending order
+			free_voices[i] = (int8_t) (group_first[g] + group_first[g + 1] - 1 - i);
+		}
+
+		free_count[g] = GROUP_SIZE(g);
+		busy_count[g] = 0;
+	}
+
+	age_counter = 0;
+	voice_alloc_set_limit(SYNTH_MAX_VOICES);
+}
+
+void voice_alloc_set_limit( int voices )
+{
+	//1..SYNTH_MAX_VOICES, every group keeps at least one voice
+	int g;
+
+	if(voices < 1) voices = 1;
+	if(voices > SYNTH_MAX_VOICES) voices = SYNTH_MAX_VOICES;
+	voice_limit = voices;
+
+	for(g=0; g<SYNTH_VOICE_GROUPS; g++)
+	{
+		group_limit[g] = (voices * GROUP_SIZE(g) + SYNTH_MAX_VOICES / 2) / SYNTH_MAX_VOICES;
+		if(group_limit[g] < 1) group_limit[g] = 1;
+	}
+}
+
+int voice_alloc_limit( void )
+{
+	return voice_limit;
+}
+
+static int voice_alloc_victim( int group )
+{
+	//picks the oldest released voice of the group, else its busy voice with the lowest steal priority
+	int i;
+	int victim = VOICE_NONE;
+
+	for(i=group_first[group]; i<group_first[group + 1]; i++)
+	{
+		if(voice_released[i] && ((victim == VOICE_NONE) || ((int32_t) (voice_age[i] - voice_age[victim]) < 0))) victim = i;
+	}
+
+	if(victim != VOICE_NONE) return victim;
+
+	//under a limit some slots may be free, only sounding notes are candidates
+	for(i=group_first[group]; i<group_first[group + 1]; i++)
+	{
+		if((voice_note[i] == VOICE_NONE) || voice_released[i]) continue;
+		if(victim == VOICE_NONE) victim = i;
+#if (SYNTH_VOICE_STEAL == VOICE_STEAL_QUIETEST)
+		if(voice_velocity[i] < voice_velocity[victim]) victim = i;
+		else if((voice_velocity[i] == voice_velocity[victim]) && ((int32_t) (voice_age[i] - voice_age[victim]) < 0)) victim = i;
+#else
+		if((int32_t) (voice_age[i] - voice_age[victim]) < 0) victim = i;
+#endif
+	}
+
+	return victim;
+}
+
+static int voice_lookup( int group, uint8_t channel, uint8_t note )
+{
+	//the channel's voice in the note's chain, VOICE_NONE when it has none
+	int voice = note_voice[group][note];
+
+	while((voice != VOICE_NONE) && (voice_channel[voice] != channel)) voice = voice_next[voice];
+
+	return voice;
+}
+
+static void voice_unlink( int voice )
+{
+	//takes a voice out of its note's chain
+	int8_t *link = &note_voice[voice_group[voice]][voice_note[voice]];
+
+	while(*link != voice) link = &voice_next[*link];
+	*link = voice_next[voice];
+}
+
+int voice_alloc_note_on( int group, uint8_t channel, uint8_t note, uint8_t velocity, int *stolen_note )
+{
+	//returns the voice to start the note on, *stolen_note is the note it cut off or VOICE_NONE
+	int voice;
+
+	note &= 0x7F;
+	*stolen_note = VOICE_NONE;
+
+	voice = voice_lookup(group, channel, note);
+	if(voice == VOICE_NONE)
+	{
+		if((free_count[group] > 0) && (busy_count[group] < group_limit[group]))
+		{
+			voice = free_voices[group_first[group] + --free_count[group]];
+			busy_count[group]++;
+		}
+		else
+		{
+			//a released victim's note is over already, only a sounding one is cut off
+			voice = voice_alloc_victim(group);
+			if(!voice_released[voice]) *stolen_note = voice_note[voice];
+			if(voice_note[voice] != VOICE_NONE) voice_unlink(voice);
+		}
+
+		voice_note[voice] = (int8_t) note;
+		voice_channel[voice] = channel;
+		voice_next[voice] = note_voice[group][note];
+		note_voice[group][note] = (int8_t) voice;
+	}
+
+	//a note retriggered on its channel keeps its voice, sounding or still releasing, but
+	//becomes the newest; it takes no free slot and never steals
+	voice_released[voice] = false;
+	voice_velocity[voice] = velocity;
+	voice_age[voice] = age_counter++;
+
+	return voice;
+}
+
+bool voice_alloc_would_steal( int group, uint8_t channel, uint8_t note )
+{
+	//true when a note on would cut off a sounding note of the group
+	int i;
+
+	if(voice_lookup(group, channel, note & 0x7F) != VOICE_NONE) return false;
+	if((free_count[group] > 0) && (busy_count[group] < group_limit[group])) return false;
+
+	for(i=group_first[group]; i<group_first[group + 1]; i++)
+	{
+		if(voice_released[i]) return false;
+	}
+
+	return true;
+}
+
+int voice_alloc_note_off( int group, uint8_t channel, uint8_t note )
+{
+	//returns the voice released by the note or VOICE_NONE, the slot stays held until freed
+	int voice;
+
+	note &= 0x7F;
+	voice = voice_lookup(group, channel, note);
+
+	//a second note off finds the voice released already
+	if((voice == VOICE_NONE) || voice_released[voice]) return VOICE_NONE;
+	voice_released[voice] = true;
+
+	return voice;
+}
+
+void voice_alloc_release( int voice )
+{
+	//releases a voice by slot, for cutting voices without knowing their note
+	if(voice_note[voice] != VOICE_NONE) voice_released[voice] = true;
+}
+
+void voice_alloc_free( int voice )
+{
+	//returns a released slot to the free stack, its note no longer finds it
+	int group = voice_group[voice];
+
+	if(voice_released[voice])
+	{
+		voice_unlink(voice);
+		voice_note[voice] = VOICE_NONE;
+		voice_released[voice] = false;
+		free_voices[group_first[group] + free_count[group]++] = (int8_t) voice;
+		busy_count[group]--;
+	}
+}
+
+int voice_alloc_find( int group, uint8_t channel, uint8_t note )
+{
+	//the voice of a note the channel holds, VOICE_NONE once it is released
+	int voice = voice_lookup(group, channel, note & 0x7F);
+
+	return ((voice == VOICE_NONE) || voice_released[voice]) ? VOICE_NONE : voice;
+}
@@ -0,0 +1,44 @@
+/*************************************************************************************************
+                                      --VOICE ALLOCATOR--
+
+	Maps MIDI notes onto the SYNTH_MAX_VOICES voice slots. Free slots are kept on a stack
+	and every note has a direct note->voice entry, so note on with a free slot and note off
+	are both O(1). Notes are looked up by channel as well: two channels can hold the same
+	note, each on its own voice, and one channel's note off leaves the other's alone. A
+	released note keeps its slot until voice_alloc_free() is called for it (its envelope
+	has finished), and its note entry with it: the same note struck again on its channel
+	while it fades takes that voice back instead of another slot, so a fast repeated note
+	costs no polyphony. Another channel striking the note gets a voice of its own. When all slots are busy a released voice is stolen first,
+	otherwise a sounding one according to SYNTH_VOICE_STEAL instead of dropping the note.
+
+	The slots are split into SYNTH_VOICE_GROUPS consecutive groups, each with its own free
+	stack and note map, so parts routed to different groups never steal from each other.
+
+	voice_alloc_set_limit() caps the voices in use below SYNTH_MAX_VOICES at run time, split
+	over the groups like the slots. Past the cap a note on steals as if the group were full;
+	lowering it cuts nothing, the group shrinks as its voices finish.
+
+*************************************************************************************************/
+
+#ifndef VOICE_ALLOC_H_INCLUDED
+#define VOICE_ALLOC_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+#define VOICE_NONE				(	-1	)
+
+/****** FUNCTION PROTOTYPES  ****/
+void voice_alloc_init( void );
+int voice_alloc_note_on( int group, uint8_t channel, uint8_t note, uint8_t velocity, int *stolen_note );
+bool voice_alloc_would_steal( int group, uint8_t channel, uint8_t note );
+int voice_alloc_note_off( int group, uint8_t channel, uint8_t note );
+int voice_alloc_find( int group, uint8_t channel, uint8_t note );
+void voice_alloc_release( int voice );
+void voice_alloc_free( int voice );
+void voice_alloc_set_limit( int voices );
+int voice_alloc_limit( void );
+
+#endif /* VOICE_ALLOC_H_INCLUDED */
@@ -0,0 +1,324 @@
+/*************************************************************************************************
+                                          --VOICE LINK--
+
+	The master keeps each card's notes in a row of SYNTH_MAX_VOICES slots, as many as the
+	card can sound, with the order they were struck in: a card whose row is full steals its
+	oldest note itself, so that slot can be reused. Forwarding runs in the synth task, from
+	the engine's event handler, and the table is touched nowhere else.
+
+	A card's report is written by the return line's interrupt and taken up by the synth task
+	at the next note it places. The report's fresh flag tells that task to restart the
+	card's count of notes sent since. The poll job counts the polls gone unanswered and a
+	report clears the count. Each of those is a byte with a single writer at a time.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stddef.h>
+#include "voice_link.h"
+#include "midi_out.h"
+
+#if SYNTH_VOICE_LINK
+
+/**********  DEFINE  ************/
+#define LINK_SLOT_FREE				(	0xFF	)
+
+//load in per mille, and what a voice is taken to cost without a report to go by
+#define LINK_LOAD_SHIFT				(	3	)
+#define LINK_VOICE_LOAD				(	1000 / SYNTH_MAX_VOICES	)
+
+
+/********   TYPE DEFS  **********/
+struct link_slot{
+	uint8_t channel;
+	uint8_t note;			//LINK_SLOT_FREE for an empty slot
+	uint16_t age;
+};
+
+
+/****** FUNCTION PROTOTYPES  ****/
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+static bool voice_link_send( int card, const struct midi_event *event );
+static struct link_slot *voice_link_find( uint8_t channel, uint8_t note, int *card );
+static struct link_slot *voice_link_assign( int *card );
+static int32_t voice_link_score( int card, uint16_t notes );
+#endif
+static bool voice_link_packet( struct voice_link_parser *parser, uint8_t byte );
+
+
+/*******   GLOBAL VARS  *********/
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+static struct link_slot link_slots[SYNTH_VOICE_LINK_CARDS][SYNTH_MAX_VOICES];
+static uint16_t link_age;
+
+//each card's last report and how it has changed since, see above
+static volatile uint16_t card_load[SYNTH_VOICE_LINK_CARDS];
+static volatile uint8_t card_voices[SYNTH_VOICE_LINK_CARDS];
+static volatile bool card_fresh[SYNTH_VOICE_LINK_CARDS];
+static volatile uint8_t card_missed[SYNTH_VOICE_LINK_CARDS];
+static int16_t card_sent[SYNTH_VOICE_LINK_CARDS];
+static uint8_t poll_card;
+#endif
+
+
+/***  APPLICATION FUNCTIONS  ****/
+void voice_link_init( void )
+{
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+	int c;
+	int s;
+
+	for(c=0; c<SYNTH_VOICE_LINK_CARDS; c++)
+	{
+		for(s=0; s<SYNTH_MAX_VOICES; s++) link_slots[c][s].note = LINK_SLOT_FREE;
+		card_load[c] = 0;
+		card_voices[c] = 0;
+		card_fresh[c] = false;
+		card_missed[c] = VOICE_LINK_MISSED;
+		card_sent[c] = 0;
+	}
+	link_age = 0;
+	poll_card = 0;
+#endif
+}
+
+#if (SYNTH_VOICE_LINK == SYNTH_VOICE_LINK_MASTER)
+bool voice_link_forward( const struct midi_event *event )
+{
+	//false when the transmitter had no room for the packet
+	struct link_slot *slot;
+	int card;
+
+	if(event->status == MIDI_NOTE_ON)
+	{
+		//a retriggered note stays on its card
+		slot = voice_link_find(event->channel, event->data1, &card);
+		if(slot == NULL)
+		{
+			//a stolen slot leaves the card's voices as many as they were
+			slot = voice_link_assign(&card);
+			if(slot->note == LINK_SLOT_FREE) card_sent[card]++;
+		}
+
+		slot->channel = event->channel;
+		slot->note = event->data1;
+		slot->age = link_age++;
+		return voice_link_send(card, event);
+	}
+
+	if(event->status == MIDI_NOTE_OFF)
+	{
+		//a note the master lost track of is released on all of them
+		slot = voice_link_find(event->channel, event->data1, &card);
+		if(slot == NULL) return voice_link_send(VOICE_LINK_BROADCAST, event);
+
+		slot->note = LINK_SLOT_FREE;
+		card_sent[card]--;
+		return voice_link_send(card, event);
+	}
+
+	return voice_link_send(VOICE_LINK_BROADCAST, event);
+}
+
+uint16_t voice_link_card_notes( int card )
+{
+	//notes the master has sounding on a card
+	uint16_t count = 0;
+	int s;
+
+	for(s=0; s<SYNTH_MAX_VOICES; s++)
+	{
+		if(link_slots[card][s].note != LINK_SLOT_FREE) count++;
+	}
+
+	return count;
+}
+
+uint16_t voice_link_card_load( int card )
+{
+	//the card's last reported load in per mille, 0xFFFF when it has not answered lately
+	return (card_missed[card] < VOICE_LINK_MISSED) ? card_load[card] : 0xFFFF;
+}
+
+void voice_link_poll( void )
+{
+	//console task job, every SYNTH_VOICE_LINK_POLL_MS: the next card is asked for its load
+	uint8_t packet[VOICE_LINK_PACKET_LEN];
+
+	if(card_missed[poll_card] < VOICE_LINK_MISSED) card_missed[poll_card]++;
+
+	packet[0] = 0x80 | poll_card;
+	packet[1] = VOICE_LINK_POLL;
+	packet[2] = 0;
+	packet[3] = 0;
+	midi_out_write(packet, VOICE_LINK_PACKET_LEN);
+
+	if(++poll_card == SYNTH_VOICE_LINK_CARDS) poll_card = 0;
+}
+
+void voice_link_report_feed( struct voice_link_parser *parser, uint8_t byte )
+{
+	//return line receive interrupt
+	uint8_t card;
+
+	if(!voice_link_packet(parser, byte)) return;
+
+	card = parser->packet[0] & 0x0F;
+	if((card >= SYNTH_VOICE_LINK_CARDS) || (parser->packet[1] != VOICE_LINK_REPORT)) return;
+
+	card_load[card] = (uint16_t) parser->packet[2] << LINK_LOAD_SHIFT;
+	card_voices[card] = parser->packet[3];
+	card_fresh[card] = true;
+	card_missed[card] = 0;
+}
+
+static int32_t voice_link_score( int card, uint16_t notes )
+{
+	//the card's load as it is likely to be now, in per mille
+	int32_t voice;
+
+	if(card_fresh[card])
+	{
+		card_fresh[card] = false;
+		card_sent[card] = 0;
+	}
+
+	if(card_missed[card] >= VOICE_LINK_MISSED) return (int32_t) notes * LINK_VOICE_LOAD;
+
+	voice = card_voices[card] ? (int32_t) card_load[card] / card_voices[card] : LINK_VOICE_LOAD;
+	return (int32_t) card_load[card] + card_sent[card] * voice;
+}
+
+static bool voice_link_send( int card, const struct midi_event *event )
+{
+	uint8_t packet[VOICE_LINK_PACKET_LEN];
+
+	packet[0] = 0x80 | (uint8_t) card;
+	packet[1] = (uint8_t) (((event->status >> 4) & 0x07) << 4) | (event->channel & 0x0F);
+	packet[2] = event->data1 & 0x7F;
+	packet[3] = event->data2 & 0x7F;
+
+	return midi_out_write(packet, VOICE_LINK_PACKET_LEN);
+}
+
+static struct link_slot *voice_link_find( uint8_t channel, uint8_t note, int *card )
+{
+	int c;
+	int s;
+
+	for(c=0; c<SYNTH_VOICE_LINK_CARDS; c++)
+	{
+		for(s=0; s<SYNTH_MAX_VOICES; s++)
+		{
+			if((link_slots[c][s].note == note) && (link_slots[c][s].channel == channel))
+			{
+				*card = c;
+				return &link_slots[c][s];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static struct link_slot *voice_link_assign( int *card )
+{
+	//a free slot on the least loaded card with one; with every card full, the slot of the
+	//oldest note on any of them, which its card steals as well
+	struct link_slot *free_slot = NULL;
+	struct link_slot *oldest = NULL;
+	uint16_t count;
+	int32_t score;
+	int32_t lowest = INT32_MAX;
+	int oldest_card = 0;
+	int c;
+	int s;
+
+	for(c=0; c<SYNTH_VOICE_LINK_CARDS; c++)
+	{
+		count = 0;
+		for(s=0; s<SYNTH_MAX_VOICES; s++)
+		{
+			if(link_slots[c][s].note != LINK_SLOT_FREE)
+			{
+				count++;
+				if((oldest == NULL) || ((int16_t) (link_slots[c][s].age - oldest->age) < 0))
+				{
+					oldest = &link_slots[c][s];
+					oldest_card = c;
+				}
+			}
+		}
+		if(count == SYNTH_MAX_VOICES) continue;
+
+		score = voice_link_score(c, count);
+		if(score >= lowest) continue;
+
+		for(s=0; link_slots[c][s].note != LINK_SLOT_FREE; s++);
+		lowest = score;
+		free_slot = &link_slots[c][s];
+		*card = c;
+	}
+
+	if(free_slot) return free_slot;
+
+	*card = oldest_card;
+	return oldest;
+}
+#endif
+
+void voice_link_parser_init( struct voice_link_parser *parser )
+{
+	parser->count = 0;
+	parser->polled = false;
+}
+
+static bool voice_link_packet( struct voice_link_parser *parser, uint8_t byte )
+{
+	//true when byte completes a packet, whoever it is for
+	if(byte & 0x80) parser->count = 0;
+	else if(parser->count == 0) return false;
+
+	parser->packet[parser->count++] = byte;
+	if(parser->count < VOICE_LINK_PACKET_LEN) return false;
+
+	parser->count = 0;
+	return true;
+}
+
+bool voice_link_feed( struct voice_link_parser *parser, uint8_t byte, struct midi_event *event )
+{
+	//returns true when byte completes a packet for this card
+	uint8_t card;
+
+	if(!voice_link_packet(parser, byte)) return false;
+
+	card = parser->packet[0] & 0x0F;
+	if((card != SYNTH_VOICE_CARD_ID) && (card != VOICE_LINK_BROADCAST)) return false;
+
+	//status 0xF0 and up is the link's own
+	if((parser->packet[1] & 0x70) == 0x70)
+	{
+		if((parser->packet[1] == VOICE_LINK_POLL) && (card == SYNTH_VOICE_CARD_ID)) parser->polled = true;
+		return false;
+	}
+
+	event->status = 0x80 | (parser->packet[1] & 0x70);
+	event->channel = parser->packet[1] & 0x0F;
+	event->data1 = parser->packet[2];
+	event->data2 = parser->packet[3];
+	return true;
+}
+
+void voice_link_report( uint8_t *packet, uint16_t load, int voices )
+{
+	//this card's answer to a poll, load in per mille
+	load >>= LINK_LOAD_SHIFT;
+
+	packet[0] = 0x80 | SYNTH_VOICE_CARD_ID;
+	packet[1] = VOICE_LINK_REPORT;
+	packet[2] = (uint8_t) ((load > 0x7F) ? 0x7F : load);
+	packet[3] = (uint8_t) ((voices > 0x7F) ? 0x7F : voices);
+}
+
+#endif /* SYNTH_VOICE_LINK */
@@ -0,0 +1,84 @@
+/*************************************************************************************************
+                                          --VOICE LINK--
+
+	Polyphony past one chip: a master board plays what its own voices allow and hands the
+	notes it has no free voice for to expander boards, voice cards running this same
+	firmware, over a one-way serial link at SYNTH_VOICE_LINK_BAUD. The master's TX pin drives
+	the RX pin of every card (EXT2 pin 7 to pin 8, PB12 to PB13, and a common ground), so a card sees all the
+	traffic and keeps what is addressed to it or broadcast.
+
+	A packet is 4 bytes, only the first with its top bit set, so a receiver that joins in the
+	middle of one resynchronizes on the next:
+
+		1000 cccc	card, 15 for all of them
+		0sss nnnn	channel message status (0x80 + 16 * s), MIDI channel n
+		0ddd dddd	first data byte
+		0ddd dddd	second data byte, 0 for a one-byte message
+
+	The master spreads new notes over the cards, to the least loaded one with a slot free,
+	and sends a note's note off to the card that has it. A card with all its voices busy
+	steals as usual, the master forgets that card's oldest note then. Controllers, program
+	and bend go to all cards, so every one plays its notes with the same patch.
+
+	Load comes back on a return line: every card's TX pin (PB12) through a diode, cathode at
+	the card, to the master's RX pin (PB13), which its pull-up holds high. A card only drives
+	it to answer a poll. Every SYNTH_VOICE_LINK_POLL_MS the master polls the next card in
+	turn, and that card answers with its telemetry's average load and sounding voices:
+
+		1000 cccc	card, 15 for all of them
+		0111 0000	poll, master to card; 0111 0001 is the card's report
+		0lll llll	load in per mille / 8, 0 in a poll
+		0vvv vvvv	sounding voices, 0 in a poll
+
+	Between reports, each note sent to a card or released on it since that card's last report
+	adds or takes off the load of one of its voices at that report. A chord therefore spreads
+	even though it lands between two polls. A card that missed VOICE_LINK_MISSED polls in a row,
+	or has not answered yet, is rated by its notes alone, as if each voice were
+	1 / SYNTH_MAX_VOICES of the CPU. With the poll off, that is how every card is rated.
+
+	voice_link_forward() is the engine's overflow handler on the master, voice_link_feed()
+	the byte parser for the link input on a card. A card's own MIDI inputs stay live. On the
+	master, voice_link_poll() is the periodic job. voice_link_report_feed() parses the return
+	line from its receive interrupt. voice_link_report() builds a card's answer once
+	voice_link_feed() has flagged a poll.
+
+*************************************************************************************************/
+
+#ifndef VOICE_LINK_H_INCLUDED
+#define VOICE_LINK_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_synth.h"
+#include "midi_parser.h"
+
+/**********  DEFINE  ************/
+#define VOICE_LINK_PACKET_LEN		(	4	)
+#define VOICE_LINK_BROADCAST		(	15	)
+
+//second byte of the link's own packets, in the status 0xF0 channel messages never use
+#define VOICE_LINK_POLL				(	0x70	)
+#define VOICE_LINK_REPORT			(	0x71	)
+
+//polls a card may miss before its last report no longer counts
+#define VOICE_LINK_MISSED			(	3	)
+
+/********   TYPE DEFS  **********/
+struct voice_link_parser{
+	uint8_t packet[VOICE_LINK_PACKET_LEN];
+	uint8_t count;
+	bool polled;			//a poll for this card came in, cleared by whoever answers it
+};
+
+/****** FUNCTION PROTOTYPES  ****/
+void voice_link_init( void );
+bool voice_link_forward( const struct midi_event *event );
+void voice_link_parser_init( struct voice_link_parser *parser );
+bool voice_link_feed( struct voice_link_parser *parser, uint8_t byte, struct midi_event *event );
+uint16_t voice_link_card_notes( int card );
+void voice_link_poll( void );
+void voice_link_report_feed( struct voice_link_parser *parser, uint8_t byte );
+uint16_t voice_link_card_load( int card );
+void voice_link_report( uint8_t *packet, uint16_t load, int voices );
+
+#endif /* VOICE_LINK_H_INCLUDED */
@@ -0,0 +1,503 @@
+/*************************************************************************************************
+                                       --WAVETABLES--
+
+	Generated by tools/gen_wavetables.py, do not edit by hand.
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include "wavetables.h"
+
+#if SYNTH_WAVETABLES
+
+/*******   GLOBAL VARS  *********/
+const int16_t wavetables[WAVETABLE_WAVES][WAVETABLE_LEVELS][WAVETABLE_SIZE] = {
+	//SQUARE
+	{
+		//level 0, 127 harmonics
+		{
+			0, 1830, 2047, 2021, 2030, 2026, 2028, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027,
+			2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2027, 2028, 2026, 2030, 2021, 2047, 1830,
+			0, -1830, -2047, -2021, -2030, -2026, -2028, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027,
+			-2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2027, -2028, -2026, -2030, -2021, -2047, -1830,
+		},
+		//level 1, 64 harmonics
+		{
+			0, 1117, 1824, 2047, 2021, 1986, 2001, 2015, 2005, 1998, 2004, 2009, 2004, 2001, 2005, 2007,
+			2004, 2003, 2005, 2006, 2004, 2003, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005,
+			2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005,
+			2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2004,
+			2004, 2004, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004,
+			2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004,
+			2004, 2005, 2005, 2004, 2004, 2005, 2005, 2004, 2004, 2005, 2005, 2003, 2004, 2006, 2005, 2003,
+			2004, 2007, 2005, 2001, 2004, 2009, 2004, 1998, 2005, 2015, 2001, 1986, 2021, 2047, 1824, 1117,
+			0, -1117, -1824, -2047, -2021, -1986, -2001, -2015, -2005, -1998, -2004, -2009, -2004, -2001, -2005, -2007,
+			-2004, -2003, -2005, -2006, -2004, -2003, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005,
+			-2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005,
+			-2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2004,
+			-2004, -2004, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004,
+			-2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004,
+			-2004, -2005, -2005, -2004, -2004, -2005, -2005, -2004, -2004, -2005, -2005, -2003, -2004, -2006, -2005, -2003,
+			-2004, -2007, -2005, -2001, -2004, -2009, -2004, -1998, -2005, -2015, -2001, -1986, -2021, -2047, -1824, -1117,
+		},
+		//level 2, 32 harmonics
+		{
+			0, 597, 1130, 1550, 1835, 1991, 2047, 2042, 2015, 1991, 1983, 1989, 2001, 2010, 2013, 2008,
+			2001, 1997, 1996, 1999, 2004, 2007, 2006, 2004, 2001, 1999, 1999, 2001, 2004, 2005, 2004, 2003,
+			2001, 2000, 2001, 2002, 2004, 2004, 2003, 2002, 2001, 2001, 2001, 2003, 2004, 2004, 2003, 2002,
+			2001, 2001, 2002, 2003, 2003, 2003, 2003, 2002, 2001, 2001, 2002, 2003, 2003, 2003, 2002, 2001,
+			2001, 2001, 2002, 2003, 2003, 2003, 2002, 2001, 2001, 2002, 2003, 2003, 2003, 2003, 2002, 2001,
+			2001, 2002, 2003, 2004, 2004, 2003, 2001, 2001, 2001, 2002, 2003, 2004, 2004, 2002, 2001, 2000,
+			2001, 2003, 2004, 2005, 2004, 2001, 1999, 1999, 2001, 2004, 2006, 2007, 2004, 1999, 1996, 1997,
+			2001, 2008, 2013, 2010, 2001, 1989, 1983, 1991, 2015, 2042, 2047, 1991, 1835, 1550, 1130, 597,
+			0, -597, -1130, -1550, -1835, -1991, -2047, -2042, -2015, -1991, -1983, -1989, -2001, -2010, -2013, -2008,
+			-2001, -1997, -1996, -1999, -2004, -2007, -2006, -2004, -2001, -1999, -1999, -2001, -2004, -2005, -2004, -2003,
+			-2001, -2000, -2001, -2002, -2004, -2004, -2003, -2002, -2001, -2001, -2001, -2003, -2004, -2004, -2003, -2002,
+			-2001, -2001, -2002, -2003, -2003, -2003, -2003, -2002, -2001, -2001, -2002, -2003, -2003, -2003, -2002, -2001,
+			-2001, -2001, -2002, -2003, -2003, -2003, -2002, -2001, -2001, -2002, -2003, -2003, -2003, -2003, -2002, -2001,
+			-2001, -2002, -2003, -2004, -2004, -2003, -2001, -2001, -2001, -2002, -2003, -2004, -2004, -2002, -2001, -2000,
+			-2001, -2003, -2004, -2005, -2004, -2001, -1999, -1999, -2001, -2004, -2006, -2007, -2004, -1999, -1996, -1997,
+			-2001, -2008, -2013, -2010, -2001, -1989, -1983, -1991, -2015, -2042, -2047, -1991, -1835, -1550, -1130, -597,
+		},
+		//level 3, 16 harmonics
+		{
+			0, 311, 613, 897, 1156, 1384, 1578, 1736, 1857, 1945, 2003, 2035, 2047, 2045, 2034, 2019,
+			2004, 1991, 1983, 1979, 1979, 1983, 1989, 1996, 2002, 2007, 2010, 2010, 2009, 2006, 2002, 1998,
+			1994, 1992, 1991, 1991, 1993, 1996, 1999, 2001, 2003, 2005, 2005, 2004, 2002, 2000, 1998, 1996,
+			1994, 1994, 1994, 1995, 1997, 1999, 2001, 2002, 2003, 2003, 2003, 2001, 1999, 1998, 1996, 1995,
+			1994, 1995, 1996, 1998, 1999, 2001, 2003, 2003, 2003, 2002, 2001, 1999, 1997, 1995, 1994, 1994,
+			1994, 1996, 1998, 2000, 2002, 2004, 2005, 2005, 2003, 2001, 1999, 1996, 1993, 1991, 1991, 1992,
+			1994, 1998, 2002, 2006, 2009, 2010, 2010, 2007, 2002, 1996, 1989, 1983, 1979, 1979, 1983, 1991,
+			2004, 2019, 2034, 2045, 2047, 2035, 2003, 1945, 1857, 1736, 1578, 1384, 1156, 897, 613, 311,
+			0, -311, -613, -897, -1156, -1384, -1578, -1736, -1857, -1945, -2003, -2035, -2047, -2045, -2034, -2019,
+			-2004, -1991, -1983, -1979, -1979, -1983, -1989, -1996, -2002, -2007, -2010, -2010, -2009, -2006, -2002, -1998,
+			-1994, -1992, -1991, -1991, -1993, -1996, -1999, -2001, -2003, -2005, -2005, -2004, -2002, -2000, -1998, -1996,
+			-1994, -1994, -1994, -1995, -1997, -1999, -2001, -2002, -2003, -2003, -2003, -2001, -1999, -1998, -1996, -1995,
+			-1994, -1995, -1996, -1998, -1999, -2001, -2003, -2003, -2003, -2002, -2001, -1999, -1997, -1995, -1994, -1994,
+			-1994, -1996, -1998, -2000, -2002, -2004, -2005, -2005, -2003, -2001, -1999, -1996, -1993, -1991, -1991, -1992,
+			-1994, -1998, -2002, -2006, -2009, -2010, -2010, -2007, -2002, -1996, -1989, -1983, -1979, -1979, -1983, -1991,
+			-2004, -2019, -2034, -2045, -2047, -2035, -2003, -1945, -1857, -1736, -1578, -1384, -1156, -897, -613, -311,
+		},
+		//level 4, 8 harmonics
+		{
+			0, 164, 327, 487, 643, 794, 939, 1077, 1206, 1327, 1439, 1541, 1633, 1715, 1786, 1848,
+			1900, 1944, 1978, 2005, 2024, 2037, 2044, 2047, 2046, 2042, 2035, 2027, 2018, 2009, 2000, 1992,
+			1985, 1979, 1974, 1971, 1970, 1970, 1972, 1974, 1978, 1982, 1986, 1991, 1996, 2000, 2004, 2007,
+			2010, 2011, 2012, 2011, 2010, 2008, 2006, 2003, 1999, 1996, 1992, 1989, 1986, 1983, 1981, 1980,
+			1980, 1980, 1981, 1983, 1986, 1989, 1992, 1996, 1999, 2003, 2006, 2008, 2010, 2011, 2012, 2011,
+			2010, 2007, 2004, 2000, 1996, 1991, 1986, 1982, 1978, 1974, 1972, 1970, 1970, 1971, 1974, 1979,
+			1985, 1992, 2000, 2009, 2018, 2027, 2035, 2042, 2046, 2047, 2044, 2037, 2024, 2005, 1978, 1944,
+			1900, 1848, 1786, 1715, 1633, 1541, 1439, 1327, 1206, 1077, 939, 794, 643, 487, 327, 164,
+			0, -164, -327, -487, -643, -794, -939, -1077, -1206, -1327, -1439, -1541, -1633, -1715, -1786, -1848,
+			-1900, -1944, -1978, -2005, -2024, -2037, -2044, -2047, -2046, -2042, -2035, -2027, -2018, -2009, -2000, -1992,
+			-1985, -1979, -1974, -1971, -1970, -1970, -1972, -1974, -1978, -1982, -1986, -1991, -1996, -2000, -2004, -2007,
+			-2010, -2011, -2012, -2011, -2010, -2008, -2006, -2003, -1999, -1996, -1992, -1989, -1986, -1983, -1981, -1980,
+			-1980, -1980, -1981, -1983, -1986, -1989, -1992, -1996, -1999, -2003, -2006, -2008, -2010, -2011, -2012, -2011,
+			-2010, -2007, -2004, -2000, -1996, -1991, -1986, -1982, -1978, -1974, -1972, -1970, -1970, -1971, -1974, -1979,
+			-1985, -1992, -2000, -2009, -2018, -2027, -2035, -2042, -2046, -2047, -2044, -2037, -2024, -2005, -1978, -1944,
+			-1900, -1848, -1786, -1715, -1633, -1541, -1439, -1327, -1206, -1077, -939, -794, -643, -487, -327, -164,
+		},
+		//level 5, 4 harmonics
+		{
+			0, 89, 178, 267, 355, 442, 528, 613, 697, 779, 859, 937, 1014, 1088, 1160, 1229,
+			1296, 1360, 1421, 1480, 1536, 1588, 1638, 1685, 1728, 1769, 1806, 1841, 1872, 1901, 1927, 1950,
+			1970, 1988, 2003, 2015, 2026, 2034, 2040, 2044, 2046, 2047, 2046, 2044, 2041, 2037, 2032, 2026,
+			2019, 2012, 2005, 1998, 1990, 1983, 1976, 1969, 1963, 1957, 1952, 1948, 1944, 1941, 1939, 1937,
+			1937, 1937, 1939, 1941, 1944, 1948, 1952, 1957, 1963, 1969, 1976, 1983, 1990, 1998, 2005, 2012,
+			2019, 2026, 2032, 2037, 2041, 2044, 2046, 2047, 2046, 2044, 2040, 2034, 2026, 2015, 2003, 1988,
+			1970, 1950, 1927, 1901, 1872, 1841, 1806, 1769, 1728, 1685, 1638, 1588, 1536, 1480, 1421, 1360,
+			1296, 1229, 1160, 1088, 1014, 937, 859, 779, 697, 613, 528, 442, 355, 267, 178, 89,
+			0, -89, -178, -267, -355, -442, -528, -613, -697, -779, -859, -937, -1014, -1088, -1160, -1229,
+			-1296, -1360, -1421, -1480, -1536, -1588, -1638, -1685, -1728, -1769, -1806, -1841, -1872, -1901, -1927, -1950,
+			-1970, -1988, -2003, -2015, -2026, -2034, -2040, -2044, -2046, -2047, -2046, -2044, -2041, -2037, -2032, -2026,
+			-2019, -2012, -2005, -1998, -1990, -1983, -1976, -1969, -1963, -1957, -1952, -1948, -1944, -1941, -1939, -1937,
+			-1937, -1937, -1939, -1941, -1944, -1948, -1952, -1957, -1963, -1969, -1976, -1983, -1990, -1998, -2005, -2012,
+			-2019, -2026, -2032, -2037, -2041, -2044, -2046, -2047, -2046, -2044, -2040, -2034, -2026, -2015, -2003, -1988,
+			-1970, -1950, -1927, -1901, -1872, -1841, -1806, -1769, -1728, -1685, -1638, -1588, -1536, -1480, -1421, -1360,
+			-1296, -1229, -1160, -1088, -1014, -937, -859, -779, -697, -613, -528, -442, -355, -267, -178, -89,
+		},
+		//level 6, 2 harmonics
+		{
+			0, 50, 100, 151, 201, 251, 300, 350, 399, 449, 497, 546, 594, 642, 690, 737,
+			783, 830, 875, 920, 965, 1009, 1052, 1095, 1137, 1179, 1219, 1259, 1299, 1337, 1375, 1411,
+			1447, 1483, 1517, 1550, 1582, 1614, 1644, 1674, 1702, 1729, 1756, 1781, 1805, 1828, 1850, 1871,
+			1891, 1910, 1927, 1944, 1959, 1973, 1986, 1997, 2008, 2017, 2025, 2032, 2037, 2041, 2045, 2046,
+			2047, 2046, 2045, 2041, 2037, 2032, 2025, 2017, 2008, 1997, 1986, 1973, 1959, 1944, 1927, 1910,
+			1891, 1871, 1850, 1828, 1805, 1781, 1756, 1729, 1702, 1674, 1644, 1614, 1582, 1550, 1517, 1483,
+			1447, 1411, 1375, 1337, 1299, 1259, 1219, 1179, 1137, 1095, 1052, 1009, 965, 920, 875, 830,
+			783, 737, 690, 642, 594, 546, 497, 449, 399, 350, 300, 251, 201, 151, 100, 50,
+			0, -50, -100, -151, -201, -251, -300, -350, -399, -449, -497, -546, -594, -642, -690, -737,
+			-783, -830, -875, -920, -965, -1009, -1052, -1095, -1137, -1179, -1219, -1259, -1299, -1337, -1375, -1411,
+			-1447, -1483, -1517, -1550, -1582, -1614, -1644, -1674, -1702, -1729, -1756, -1781, -1805, -1828, -1850, -1871,
+			-1891, -1910, -1927, -1944, -1959, -1973, -1986, -1997, -2008, -2017, -2025, -2032, -2037, -2041, -2045, -2046,
+			-2047, -2046, -2045, -2041, -2037, -2032, -2025, -2017, -2008, -1997, -1986, -1973, -1959, -1944, -1927, -1910,
+			-1891, -1871, -1850, -1828, -1805, -1781, -1756, -1729, -1702, -1674, -1644, -1614, -1582, -1550, -1517, -1483,
+			-1447, -1411, -1375, -1337, -1299, -1259, -1219, -1179, -1137, -1095, -1052, -1009, -965, -920, -875, -830,
+			-783, -737, -690, -642, -594, -546, -497, -449, -399, -350, -300, -251, -201, -151, -100, -50,
+		},
+		//level 7, 1 harmonics
+		{
+			0, 50, 100, 151, 201, 251, 300, 350, 399, 449, 497, 546, 594, 642, 690, 737,
+			783, 830, 875, 920, 965, 1009, 1052, 1095, 1137, 1179, 1219, 1259, 1299, 1337, 1375, 1411,
+			1447, 1483, 1517, 1550, 1582, 1614, 1644, 1674, 1702, 1729, 1756, 1781, 1805, 1828, 1850, 1871,
+			1891, 1910, 1927, 1944, 1959, 1973, 1986, 1997, 2008, 2017, 2025, 2032, 2037, 2041, 2045, 2046,
+			2047, 2046, 2045, 2041, 2037, 2032, 2025, 2017, 2008, 1997, 1986, 1973, 1959, 1944, 1927, 1910,
+			1891, 1871, 1850, 1828, 1805, 1781, 1756, 1729, 1702, 1674, 1644, 1614, 1582, 1550, 1517, 1483,
+			1447, 1411, 1375, 1337, 1299, 1259, 1219, 1179, 1137, 1095, 1052, 1009, 965, 920, 875, 830,
+			783, 737, 690, 642, 594, 546, 497, 449, 399, 350, 300, 251, 201, 151, 100, 50,
+			0, -50, -100, -151, -201, -251, -300, -350, -399, -449, -497, -546, -594, -642, -690, -737,
+			-783, -830, -875, -920, -965, -1009, -1052, -1095, -1137, -1179, -1219, -1259, -1299, -1337, -1375, -1411,
+			-1447, -1483, -1517, -1550, -1582, -1614, -1644, -1674, -1702, -1729, -1756, -1781, -1805, -1828, -1850, -1871,
+			-1891, -1910, -1927, -1944, -1959, -1973, -1986, -1997, -2008, -2017, -2025, -2032, -2037, -2041, -2045, -2046,
+			-2047, -2046, -2045, -2041, -2037, -2032, -2025, -2017, -2008, -1997, -1986, -1973, -1959, -1944, -1927, -1910,
+			-1891, -1871, -1850, -1828, -1805, -1781, -1756, -1729, -1702, -1674, -1644, -1614, -1582, -1550, -1517, -1483,
+			-1447, -1411, -1375, -1337, -1299, -1259, -1219, -1179, -1137, -1095, -1052, -1009, -965, -920, -875, -830,
+			-783, -737, -690, -642, -594, -546, -497, -449, -399, -350, -300, -251, -201, -151, -100, -50,
+		},
+	},
+	//SAW
+	{
+		//level 0, 127 harmonics
+		{
+			0, -1843, -2047, -2005, -1997, -1977, -1963, -1946, -1931, -1914, -1898, -1882, -1866, -1850, -1834, -1818,
+			-1802, -1786, -1769, -1753, -1737, -1721, -1705, -1689, -1673, -1657, -1641, -1625, -1609, -1593, -1576, -1560,
+			-1544, -1528, -1512, -1496, -1480, -1464, -1448, -1432, -1416, -1399, -1383, -1367, -1351, -1335, -1319, -1303,
+			-1287, -1271, -1255, -1239, -1223, -1206, -1190, -1174, -1158, -1142, -1126, -1110, -1094, -1078, -1062, -1046,
+			-1030, -1013, -997, -981, -965, -949, -933, -917, -901, -885, -869, -853, -836, -820, -804, -788,
+			-772, -756, -740, -724, -708, -692, -676, -660, -643, -627, -611, -595, -579, -563, -547, -531,
+			-515, -499, -483, -466, -450, -434, -418, -402, -386, -370, -354, -338, -322, -306, -290, -273,
+			-257, -241, -225, -209, -193, -177, -161, -145, -129, -113, -97, -80, -64, -48, -32, -16,
+			0, 16, 32, 48, 64, 80, 97, 113, 129, 145, 161, 177, 193, 209, 225, 241,
+			257, 273, 290, 306, 322, 338, 354, 370, 386, 402, 418, 434, 450, 466, 483, 499,
+			515, 531, 547, 563, 579, 595, 611, 627, 643, 660, 676, 692, 708, 724, 740, 756,
+			772, 788, 804, 820, 836, 853, 869, 885, 901, 917, 933, 949, 965, 981, 997, 1013,
+			1030, 1046, 1062, 1078, 1094, 1110, 1126, 1142, 1158, 1174, 1190, 1206, 1223, 1239, 1255, 1271,
+			1287, 1303, 1319, 1335, 1351, 1367, 1383, 1399, 1416, 1432, 1448, 1464, 1480, 1496, 1512, 1528,
+			1544, 1560, 1576, 1593, 1609, 1625, 1641, 1657, 1673, 1689, 1705, 1721, 1737, 1753, 1769, 1786,
+			1802, 1818, 1834, 1850, 1866, 1882, 1898, 1914, 1931, 1946, 1963, 1977, 1997, 2005, 2047, 1843,
+		},
+		//level 1, 64 harmonics
+		{
+			0, -1127, -1834, -2047, -2004, -1952, -1952, -1950, -1924, -1901, -1891, -1880, -1859, -1840, -1828, -1813,
+			-1795, -1777, -1764, -1748, -1731, -1714, -1699, -1684, -1667, -1650, -1635, -1619, -1602, -1586, -1571, -1555,
+			-1538, -1522, -1507, -1491, -1474, -1458, -1443, -1427, -1410, -1394, -1379, -1363, -1346, -1330, -1315, -1298,
+			-1282, -1266, -1250, -1234, -1218, -1202, -1186, -1170, -1154, -1138, -1122, -1106, -1090, -1074, -1058, -1042,
+			-1026, -1010, -994, -978, -962, -946, -930, -914, -897, -882, -866, -849, -833, -817, -802, -785,
+			-769, -753, -737, -721, -705, -689, -673, -657, -641, -625, -609, -593, -577, -561, -545, -529,
+			-513, -497, -481, -465, -449, -433, -417, -401, -385, -369, -353, -337, -321, -305, -289, -272,
+			-256, -240, -224, -208, -192, -176, -160, -144, -128, -112, -96, -80, -64, -48, -32, -16,
+			0, 16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240,
+			256, 272, 289, 305, 321, 337, 353, 369, 385, 401, 417, 433, 449, 465, 481, 497,
+			513, 529, 545, 561, 577, 593, 609, 625, 641, 657, 673, 689, 705, 721, 737, 753,
+			769, 785, 802, 817, 833, 849, 866, 882, 897, 914, 930, 946, 962, 978, 994, 1010,
+			1026, 1042, 1058, 1074, 1090, 1106, 1122, 1138, 1154, 1170, 1186, 1202, 1218, 1234, 1250, 1266,
+			1282, 1298, 1315, 1330, 1346, 1363, 1379, 1394, 1410, 1427, 1443, 1458, 1474, 1491, 1507, 1522,
+			1538, 1555, 1571, 1586, 1602, 1619, 1635, 1650, 1667, 1684, 1699, 1714, 1731, 1748, 1764, 1777,
+			1795, 1813, 1828, 1840, 1859, 1880, 1891, 1901, 1924, 1950, 1952, 1952, 2004, 2047, 1834, 1127,
+		},
+		//level 2, 32 harmonics
+		{
+			0, -610, -1152, -1576, -1858, -2005, -2047, -2026, -1981, -1940, -1915, -1904, -1900, -1894, -1880, -1859,
+			-1836, -1814, -1797, -1784, -1772, -1759, -1742, -1723, -1704, -1686, -1670, -1655, -1641, -1626, -1609, -1591,
+			-1573, -1556, -1540, -1525, -1510, -1494, -1477, -1459, -1442, -1425, -1409, -1394, -1378, -1362, -1345, -1328,
+			-1311, -1294, -1279, -1263, -1247, -1231, -1214, -1197, -1180, -1164, -1148, -1132, -1116, -1099, -1082, -1065,
+			-1049, -1033, -1017, -1001, -984, -968, -951, -934, -918, -902, -886, -869, -853, -836, -820, -803,
+			-787, -770, -754, -738, -722, -705, -688, -672, -656, -639, -623, -607, -591, -574, -557, -541,
+			-524, -508, -492, -476, -459, -443, -426, -410, -393, -377, -361, -345, -328, -311, -295, -278,
+			-262, -246, -230, -213, -197, -180, -164, -147, -131, -115, -99, -82, -66, -49, -32, -16,
+			0, 16, 32, 49, 66, 82, 99, 115, 131, 147, 164, 180, 197, 213, 230, 246,
+			262, 278, 295, 311, 328, 345, 361, 377, 393, 410, 426, 443, 459, 476, 492, 508,
+			524, 541, 557, 574, 591, 607, 623, 639, 656, 672, 688, 705, 722, 738, 754, 770,
+			787, 803, 820, 836, 853, 869, 886, 902, 918, 934, 951, 968, 984, 1001, 1017, 1033,
+			1049, 1065, 1082, 1099, 1116, 1132, 1148, 1164, 1180, 1197, 1214, 1231, 1247, 1263, 1279, 1294,
+			1311, 1328, 1345, 1362, 1378, 1394, 1409, 1425, 1442, 1459, 1477, 1494, 1510, 1525, 1540, 1556,
+			1573, 1591, 1609, 1626, 1641, 1655, 1670, 1686, 1704, 1723, 1742, 1759, 1772, 1784, 1797, 1814,
+			1836, 1859, 1880, 1894, 1900, 1904, 1915, 1940, 1981, 2026, 2047, 2005, 1858, 1576, 1152, 610,
+		},
+		//level 3, 16 harmonics
+		{
+			0, -325, -640, -935, -1203, -1437, -1633, -1789, -1905, -1983, -2029, -2047, -2043, -2024, -1996, -1963,
+			-1929, -1898, -1872, -1851, -1834, -1820, -1809, -1799, -1788, -1776, -1762, -1745, -1727, -1707, -1686, -1665,
+			-1644, -1625, -1607, -1590, -1574, -1559, -1545, -1530, -1515, -1498, -1481, -1464, -1445, -1426, -1407, -1388,
+			-1370, -1353, -1336, -1319, -1303, -1288, -1272, -1256, -1239, -1222, -1204, -1186, -1168, -1150, -1132, -1114,
+			-1096, -1079, -1063, -1046, -1030, -1014, -997, -981, -963, -946, -928, -910, -892, -875, -857, -840,
+			-822, -806, -789, -773, -756, -739, -723, -705, -688, -670, -653, -635, -617, -600, -582, -565,
+			-548, -532, -515, -498, -482, -465, -448, -430, -413, -395, -377, -360, -342, -325, -308, -291,
+			-274, -258, -241, -224, -207, -190, -173, -155, -138, -120, -102, -85, -67, -50, -33, -17,
+			0, 17, 33, 50, 67, 85, 102, 120, 138, 155, 173, 190, 207, 224, 241, 258,
+			274, 291, 308, 325, 342, 360, 377, 395, 413, 430, 448, 465, 482, 498, 515, 532,
+			548, 565, 582, 600, 617, 635, 653, 670, 688, 705, 723, 739, 756, 773, 789, 806,
+			822, 840, 857, 875, 892, 910, 928, 946, 963, 981, 997, 1014, 1030, 1046, 1063, 1079,
+			1096, 1114, 1132, 1150, 1168, 1186, 1204, 1222, 1239, 1256, 1272, 1288, 1303, 1319, 1336, 1353,
+			1370, 1388, 1407, 1426, 1445, 1464, 1481, 1498, 1515, 1530, 1545, 1559, 1574, 1590, 1607, 1625,
+			1644, 1665, 1686, 1707, 1727, 1745, 1762, 1776, 1788, 1799, 1809, 1820, 1834, 1851, 1872, 1898,
+			1929, 1963, 1996, 2024, 2043, 2047, 2029, 1983, 1905, 1789, 1633, 1437, 1203, 935, 640, 325,
+		},
+		//level 4, 8 harmonics
+		{
+			0, -179, -356, -530, -699, -862, -1018, -1164, -1301, -1427, -1541, -1644, -1735, -1813, -1879, -1934,
+			-1976, -2008, -2030, -2043, -2047, -2044, -2034, -2019, -1999, -1976, -1951, -1923, -1895, -1867, -1838, -1811,
+			-1785, -1760, -1736, -1714, -1694, -1675, -1658, -1641, -1626, -1611, -1596, -1582, -1567, -1553, -1537, -1522,
+			-1505, -1488, -1470, -1452, -1432, -1412, -1392, -1371, -1350, -1329, -1307, -1286, -1265, -1245, -1225, -1205,
+			-1186, -1167, -1149, -1131, -1114, -1097, -1080, -1063, -1046, -1029, -1012, -994, -977, -959, -941, -922,
+			-903, -884, -864, -844, -824, -804, -784, -764, -744, -725, -705, -686, -667, -648, -630, -611,
+			-593, -576, -558, -540, -523, -505, -488, -470, -452, -434, -416, -397, -378, -359, -340, -320,
+			-301, -281, -261, -242, -222, -202, -183, -164, -145, -126, -107, -89, -71, -53, -35, -18,
+			0, 18, 35, 53, 71, 89, 107, 126, 145, 164, 183, 202, 222, 242, 261, 281,
+			301, 320, 340, 359, 378, 397, 416, 434, 452, 470, 488, 505, 523, 540, 558, 576,
+			593, 611, 630, 648, 667, 686, 705, 725, 744, 764, 784, 804, 824, 844, 864, 884,
+			903, 922, 941, 959, 977, 994, 1012, 1029, 1046, 1063, 1080, 1097, 1114, 1131, 1149, 1167,
+			1186, 1205, 1225, 1245, 1265, 1286, 1307, 1329, 1350, 1371, 1392, 1412, 1432, 1452, 1470, 1488,
+			1505, 1522, 1537, 1553, 1567, 1582, 1596, 1611, 1626, 1641, 1658, 1675, 1694, 1714, 1736, 1760,
+			1785, 1811, 1838, 1867, 1895, 1923, 1951, 1976, 1999, 2019, 2034, 2044, 2047, 2043, 2030, 2008,
+			1976, 1934, 1879, 1813, 1735, 1644, 1541, 1427, 1301, 1164, 1018, 862, 699, 530, 356, 179,
+		},
+		//level 5, 4 harmonics
+		{
+			0, -105, -210, -315, -418, -520, -620, -719, -816, -910, -1001, -1090, -1175, -1257, -1336, -1411,
+			-1482, -1549, -1612, -1670, -1725, -1775, -1820, -1862, -1899, -1931, -1960, -1984, -2004, -2020, -2032, -2041,
+			-2046, -2047, -2045, -2040, -2032, -2021, -2008, -1993, -1975, -1956, -1934, -1911, -1887, -1862, -1836, -1809,
+			-1781, -1753, -1725, -1696, -1668, -1639, -1611, -1583, -1555, -1528, -1502, -1476, -1450, -1425, -1401, -1377,
+			-1354, -1332, -1310, -1289, -1269, -1248, -1229, -1209, -1190, -1171, -1153, -1134, -1116, -1098, -1080, -1061,
+			-1043, -1024, -1006, -987, -967, -948, -928, -907, -887, -866, -845, -823, -801, -778, -756, -733,
+			-710, -686, -663, -639, -615, -591, -567, -543, -519, -494, -471, -447, -423, -400, -376, -353,
+			-331, -308, -286, -264, -242, -221, -200, -179, -158, -138, -118, -98, -78, -59, -39, -19,
+			0, 19, 39, 59, 78, 98, 118, 138, 158, 179, 200, 221, 242, 264, 286, 308,
+			331, 353, 376, 400, 423, 447, 471, 494, 519, 543, 567, 591, 615, 639, 663, 686,
+			710, 733, 756, 778, 801, 823, 845, 866, 887, 907, 928, 948, 967, 987, 1006, 1024,
+			1043, 1061, 1080, 1098, 1116, 1134, 1153, 1171, 1190, 1209, 1229, 1248, 1269, 1289, 1310, 1332,
+			1354, 1377, 1401, 1425, 1450, 1476, 1502, 1528, 1555, 1583, 1611, 1639, 1668, 1696, 1725, 1753,
+			1781, 1809, 1836, 1862, 1887, 1911, 1934, 1956, 1975, 1993, 2008, 2021, 2032, 2040, 2045, 2047,
+			2046, 2041, 2032, 2020, 2004, 1984, 1960, 1931, 1899, 1862, 1820, 1775, 1725, 1670, 1612, 1549,
+			1482, 1411, 1336, 1257, 1175, 1090, 1001, 910, 816, 719, 620, 520, 418, 315, 210, 105,
+		},
+		//level 6, 2 harmonics
+		{
+			0, -68, -137, -205, -273, -341, -408, -474, -541, -606, -671, -735, -798, -860, -921, -981,
+			-1040, -1098, -1154, -1209, -1263, -1315, -1366, -1415, -1463, -1508, -1552, -1595, -1636, -1674, -1711, -1746,
+			-1780, -1811, -1840, -1868, -1893, -1917, -1938, -1958, -1976, -1991, -2005, -2017, -2026, -2034, -2040, -2044,
+			-2047, -2047, -2046, -2042, -2038, -2031, -2023, -2013, -2002, -1989, -1974, -1958, -1941, -1923, -1903, -1882,
+			-1859, -1836, -1812, -1786, -1760, -1732, -1704, -1675, -1646, -1615, -1585, -1553, -1521, -1489, -1456, -1423,
+			-1389, -1355, -1322, -1288, -1253, -1219, -1185, -1151, -1117, -1083, -1049, -1015, -981, -948, -915, -882,
+			-850, -818, -786, -755, -724, -693, -663, -633, -604, -575, -546, -518, -490, -463, -436, -409,
+			-383, -357, -332, -306, -282, -257, -233, -209, -185, -161, -138, -115, -92, -69, -46, -23,
+			0, 23, 46, 69, 92, 115, 138, 161, 185, 209, 233, 257, 282, 306, 332, 357,
+			383, 409, 436, 463, 490, 518, 546, 575, 604, 633, 663, 693, 724, 755, 786, 818,
+			850, 882, 915, 948, 981, 1015, 1049, 1083, 1117, 1151, 1185, 1219, 1253, 1288, 1322, 1355,
+			1389, 1423, 1456, 1489, 1521, 1553, 1585, 1615, 1646, 1675, 1704, 1732, 1760, 1786, 1812, 1836,
+			1859, 1882, 1903, 1923, 1941, 1958, 1974, 1989, 2002, 2013, 2023, 2031, 2038, 2042, 2046, 2047,
+			2047, 2044, 2040, 2034, 2026, 2017, 2005, 1991, 1976, 1958, 1938, 1917, 1893, 1868, 1840, 1811,
+			1780, 1746, 1711, 1674, 1636, 1595, 1552, 1508, 1463, 1415, 1366, 1315, 1263, 1209, 1154, 1098,
+			1040, 981, 921, 860, 798, 735, 671, 606, 541, 474, 408, 341, 273, 205, 137, 68,
+		},
+		//level 7, 1 harmonics
+		{
+			0, -50, -100, -151, -201, -251, -300, -350, -399, -449, -497, -546, -594, -642, -690, -737,
+			-783, -830, -875, -920, -965, -1009, -1052, -1095, -1137, -1179, -1219, -1259, -1299, -1337, -1375, -1411,
+			-1447, -1483, -1517, -1550, -1582, -1614, -1644, -1674, -1702, -1729, -1756, -1781, -1805, -1828, -1850, -1871,
+			-1891, -1910, -1927, -1944, -1959, -1973, -1986, -1997, -2008, -2017, -2025, -2032, -2037, -2041, -2045, -2046,
+			-2047, -2046, -2045, -2041, -2037, -2032, -2025, -2017, -2008, -1997, -1986, -1973, -1959, -1944, -1927, -1910,
+			-1891, -1871, -1850, -1828, -1805, -1781, -1756, -1729, -1702, -1674, -1644, -1614, -1582, -1550, -1517, -1483,
+			-1447, -1411, -1375, -1337, -1299, -1259, -1219, -1179, -1137, -1095, -1052, -1009, -965, -920, -875, -830,
+			-783, -737, -690, -642, -594, -546, -497, -449, -399, -350, -300, -251, -201, -151, -100, -50,
+			0, 50, 100, 151, 201, 251, 300, 350, 399, 449, 497, 546, 594, 642, 690, 737,
+			783, 830, 875, 920, 965, 1009, 1052, 1095, 1137, 1179, 1219, 1259, 1299, 1337, 1375, 1411,
+			1447, 1483, 1517, 1550, 1582, 1614, 1644, 1674, 1702, 1729, 1756, 1781, 1805, 1828, 1850, 1871,
+			1891, 1910, 1927, 1944, 1959, 1973, 1986, 1997, 2008, 2017, 2025, 2032, 2037, 2041, 2045, 2046,
+			2047, 2046, 2045, 2041, 2037, 2032, 2025, 2017, 2008, 1997, 1986, 1973, 1959, 1944, 1927, 1910,
+			1891, 1871, 1850, 1828, 1805, 1781, 1756, 1729, 1702, 1674, 1644, 1614, 1582, 1550, 1517, 1483,
+			1447, 1411, 1375, 1337, 1299, 1259, 1219, 1179, 1137, 1095, 1052, 1009, 965, 920, 875, 830,
+			783, 737, 690, 642, 594, 546, 497, 449, 399, 350, 300, 251, 201, 151, 100, 50,
+		},
+	},
+	//TRI
+	{
+		//level 0, 127 harmonics
+		{
+			0, 32, 64, 97, 129, 161, 193, 226, 258, 290, 322, 355, 387, 419, 451, 483,
+			516, 548, 580, 612, 645, 677, 709, 741, 774, 806, 838, 870, 902, 935, 967, 999,
+			1031, 1064, 1096, 1128, 1160, 1193, 1225, 1257, 1289, 1321, 1354, 1386, 1418, 1450, 1483, 1515,
+			1547, 1579, 1612, 1644, 1676, 1708, 1740, 1773, 1805, 1837, 1869, 1902, 1934, 1966, 1998, 2030,
+			2047, 2030, 1998, 1966, 1934, 1902, 1869, 1837, 1805, 1773, 1740, 1708, 1676, 1644, 1612, 1579,
+			1547, 1515, 1483, 1450, 1418, 1386, 1354, 1321, 1289, 1257, 1225, 1193, 1160, 1128, 1096, 1064,
+			1031, 999, 967, 935, 902, 870, 838, 806, 774, 741, 709, 677, 645, 612, 580, 548,
+			516, 483, 451, 419, 387, 355, 322, 290, 258, 226, 193, 161, 129, 97, 64, 32,
+			0, -32, -64, -97, -129, -161, -193, -226, -258, -290, -322, -355, -387, -419, -451, -483,
+			-516, -548, -580, -612, -645, -677, -709, -741, -774, -806, -838, -870, -902, -935, -967, -999,
+			-1031, -1064, -1096, -1128, -1160, -1193, -1225, -1257, -1289, -1321, -1354, -1386, -1418, -1450, -1483, -1515,
+			-1547, -1579, -1612, -1644, -1676, -1708, -1740, -1773, -1805, -1837, -1869, -1902, -1934, -1966, -1998, -2030,
+			-2047, -2030, -1998, -1966, -1934, -1902, -1869, -1837, -1805, -1773, -1740, -1708, -1676, -1644, -1612, -1579,
+			-1547, -1515, -1483, -1450, -1418, -1386, -1354, -1321, -1289, -1257, -1225, -1193, -1160, -1128, -1096, -1064,
+			-1031, -999, -967, -935, -902, -870, -838, -806, -774, -741, -709, -677, -645, -612, -580, -548,
+			-516, -483, -451, -419, -387, -355, -322, -290, -258, -226, -193, -161, -129, -97, -64, -32,
+		},
+		//level 1, 64 harmonics
+		{
+			0, 32, 65, 97, 130, 162, 195, 227, 260, 292, 325, 357, 390, 422, 455, 487,
+			520, 552, 585, 617, 649, 682, 714, 747, 779, 812, 844, 877, 909, 942, 974, 1007,
+			1039, 1072, 1104, 1137, 1169, 1201, 1234, 1266, 1299, 1331, 1364, 1396, 1429, 1461, 1494, 1526,
+			1559, 1591, 1624, 1656, 1689, 1721, 1754, 1786, 1818, 1851, 1884, 1916, 1948, 1981, 2013, 2038,
+			2047, 2038, 2013, 1981, 1948, 1916, 1884, 1851, 1818, 1786, 1754, 1721, 1689, 1656, 1624, 1591,
+			1559, 1526, 1494, 1461, 1429, 1396, 1364, 1331, 1299, 1266, 1234, 1201, 1169, 1137, 1104, 1072,
+			1039, 1007, 974, 942, 909, 877, 844, 812, 779, 747, 714, 682, 649, 617, 585, 552,
+			520, 487, 455, 422, 390, 357, 325, 292, 260, 227, 195, 162, 130, 97, 65, 32,
+			0, -32, -65, -97, -130, -162, -195, -227, -260, -292, -325, -357, -390, -422, -455, -487,
+			-520, -552, -585, -617, -649, -682, -714, -747, -779, -812, -844, -877, -909, -942, -974, -1007,
+			-1039, -1072, -1104, -1137, -1169, -1201, -1234, -1266, -1299, -1331, -1364, -1396, -1429, -1461, -1494, -1526,
+			-1559, -1591, -1624, -1656, -1689, -1721, -1754, -1786, -1818, -1851, -1884, -1916, -1948, -1981, -2013, -2038,
+			-2047, -2038, -2013, -1981, -1948, -1916, -1884, -1851, -1818, -1786, -1754, -1721, -1689, -1656, -1624, -1591,
+			-1559, -1526, -1494, -1461, -1429, -1396, -1364, -1331, -1299, -1266, -1234, -1201, -1169, -1137, -1104, -1072,
+			-1039, -1007, -974, -942, -909, -877, -844, -812, -779, -747, -714, -682, -649, -617, -585, -552,
+			-520, -487, -455, -422, -390, -357, -325, -292, -260, -227, -195, -162, -130, -97, -65, -32,
+		},
+		//level 2, 32 harmonics
+		{
+			0, 33, 66, 99, 132, 165, 198, 231, 264, 297, 330, 363, 396, 428, 461, 494,
+			527, 560, 593, 626, 659, 692, 725, 758, 791, 824, 857, 890, 923, 956, 989, 1022,
+			1055, 1088, 1121, 1154, 1187, 1220, 1252, 1285, 1318, 1351, 1384, 1417, 1450, 1483, 1516, 1549,
+			1582, 1615, 1648, 1681, 1714, 1747, 1780, 1812, 1845, 1879, 1912, 1946, 1977, 2005, 2028, 2042,
+			2047, 2042, 2028, 2005, 1977, 1946, 1912, 1879, 1845, 1812, 1780, 1747, 1714, 1681, 1648, 1615,
+			1582, 1549, 1516, 1483, 1450, 1417, 1384, 1351, 1318, 1285, 1252, 1220, 1187, 1154, 1121, 1088,
+			1055, 1022, 989, 956, 923, 890, 857, 824, 791, 758, 725, 692, 659, 626, 593, 560,
+			527, 494, 461, 428, 396, 363, 330, 297, 264, 231, 198, 165, 132, 99, 66, 33,
+			0, -33, -66, -99, -132, -165, -198, -231, -264, -297, -330, -363, -396, -428, -461, -494,
+			-527, -560, -593, -626, -659, -692, -725, -758, -791, -824, -857, -890, -923, -956, -989, -1022,
+			-1055, -1088, -1121, -1154, -1187, -1220, -1252, -1285, -1318, -1351, -1384, -1417, -1450, -1483, -1516, -1549,
+			-1582, -1615, -1648, -1681, -1714, -1747, -1780, -1812, -1845, -1879, -1912, -1946, -1977, -2005, -2028, -2042,
+			-2047, -2042, -2028, -2005, -1977, -1946, -1912, -1879, -1845, -1812, -1780, -1747, -1714, -1681, -1648, -1615,
+			-1582, -1549, -1516, -1483, -1450, -1417, -1384, -1351, -1318, -1285, -1252, -1220, -1187, -1154, -1121, -1088,
+			-1055, -1022, -989, -956, -923, -890, -857, -824, -791, -758, -725, -692, -659, -626, -593, -560,
+			-527, -494, -461, -428, -396, -363, -330, -297, -264, -231, -198, -165, -132, -99, -66, -33,
+		},
+		//level 3, 16 harmonics
+		{
+			0, 34, 68, 102, 136, 170, 204, 238, 272, 306, 340, 373, 407, 441, 475, 509,
+			543, 577, 611, 645, 679, 713, 747, 781, 815, 849, 883, 916, 950, 984, 1018, 1052,
+			1086, 1119, 1153, 1187, 1222, 1256, 1290, 1324, 1358, 1392, 1426, 1459, 1493, 1527, 1560, 1594,
+			1628, 1662, 1696, 1731, 1766, 1800, 1835, 1868, 1901, 1931, 1959, 1985, 2006, 2024, 2036, 2044,
+			2047, 2044, 2036, 2024, 2006, 1985, 1959, 1931, 1901, 1868, 1835, 1800, 1766, 1731, 1696, 1662,
+			1628, 1594, 1560, 1527, 1493, 1459, 1426, 1392, 1358, 1324, 1290, 1256, 1222, 1187, 1153, 1119,
+			1086, 1052, 1018, 984, 950, 916, 883, 849, 815, 781, 747, 713, 679, 645, 611, 577,
+			543, 509, 475, 441, 407, 373, 340, 306, 272, 238, 204, 170, 136, 102, 68, 34,
+			0, -34, -68, -102, -136, -170, -204, -238, -272, -306, -340, -373, -407, -441, -475, -509,
+			-543, -577, -611, -645, -679, -713, -747, -781, -815, -849, -883, -916, -950, -984, -1018, -1052,
+			-1086, -1119, -1153, -1187, -1222, -1256, -1290, -1324, -1358, -1392, -1426, -1459, -1493, -1527, -1560, -1594,
+			-1628, -1662, -1696, -1731, -1766, -1800, -1835, -1868, -1901, -1931, -1959, -1985, -2006, -2024, -2036, -2044,
+			-2047, -2044, -2036, -2024, -2006, -1985, -1959, -1931, -1901, -1868, -1835, -1800, -1766, -1731, -1696, -1662,
+			-1628, -1594, -1560, -1527, -1493, -1459, -1426, -1392, -1358, -1324, -1290, -1256, -1222, -1187, -1153, -1119,
+			-1086, -1052, -1018, -984, -950, -916, -883, -849, -815, -781, -747, -713, -679, -645, -611, -577,
+			-543, -509, -475, -441, -407, -373, -340, -306, -272, -238, -204, -170, -136, -102, -68, -34,
+		},
+		//level 4, 8 harmonics
+		{
+			0, 36, 71, 107, 143, 178, 214, 250, 286, 322, 358, 394, 430, 466, 503, 539,
+			575, 611, 647, 683, 719, 755, 791, 826, 862, 898, 933, 969, 1004, 1039, 1075, 1110,
+			1146, 1182, 1218, 1254, 1290, 1326, 1363, 1400, 1436, 1473, 1510, 1547, 1583, 1620, 1655, 1691,
+			1725, 1759, 1792, 1823, 1853, 1882, 1909, 1934, 1956, 1977, 1995, 2011, 2024, 2034, 2041, 2046,
+			2047, 2046, 2041, 2034, 2024, 2011, 1995, 1977, 1956, 1934, 1909, 1882, 1853, 1823, 1792, 1759,
+			1725, 1691, 1655, 1620, 1583, 1547, 1510, 1473, 1436, 1400, 1363, 1326, 1290, 1254, 1218, 1182,
+			1146, 1110, 1075, 1039, 1004, 969, 933, 898, 862, 826, 791, 755, 719, 683, 647, 611,
+			575, 539, 503, 466, 430, 394, 358, 322, 286, 250, 214, 178, 143, 107, 71, 36,
+			0, -36, -71, -107, -143, -178, -214, -250, -286, -322, -358, -394, -430, -466, -503, -539,
+			-575, -611, -647, -683, -719, -755, -791, -826, -862, -898, -933, -969, -1004, -1039, -1075, -1110,
+			-1146, -1182, -1218, -1254, -1290, -1326, -1363, -1400, -1436, -1473, -1510, -1547, -1583, -1620, -1655, -1691,
+			-1725, -1759, -1792, -1823, -1853, -1882, -1909, -1934, -1956, -1977, -1995, -2011, -2024, -2034, -2041, -2046,
+			-2047, -2046, -2041, -2034, -2024, -2011, -1995, -1977, -1956, -1934, -1909, -1882, -1853, -1823, -1792, -1759,
+			-1725, -1691, -1655, -1620, -1583, -1547, -1510, -1473, -1436, -1400, -1363, -1326, -1290, -1254, -1218, -1182,
+			-1146, -1110, -1075, -1039, -1004, -969, -933, -898, -862, -826, -791, -755, -719, -683, -647, -611,
+			-575, -539, -503, -466, -430, -394, -358, -322, -286, -250, -214, -178, -143, -107, -71, -36,
+		},
+		//level 5, 4 harmonics
+		{
+			0, 39, 78, 117, 156, 195, 234, 273, 312, 352, 392, 431, 471, 511, 551, 592,
+			632, 673, 713, 754, 795, 836, 877, 918, 959, 1000, 1041, 1082, 1123, 1164, 1204, 1244,
+			1284, 1323, 1362, 1400, 1438, 1476, 1512, 1548, 1583, 1617, 1651, 1683, 1715, 1745, 1774, 1802,
+			1829, 1854, 1878, 1900, 1922, 1941, 1959, 1976, 1990, 2004, 2015, 2025, 2033, 2039, 2043, 2046,
+			2047, 2046, 2043, 2039, 2033, 2025, 2015, 2004, 1990, 1976, 1959, 1941, 1922, 1900, 1878, 1854,
+			1829, 1802, 1774, 1745, 1715, 1683, 1651, 1617, 1583, 1548, 1512, 1476, 1438, 1400, 1362, 1323,
+			1284, 1244, 1204, 1164, 1123, 1082, 1041, 1000, 959, 918, 877, 836, 795, 754, 713, 673,
+			632, 592, 551, 511, 471, 431, 392, 352, 312, 273, 234, 195, 156, 117, 78, 39,
+			0, -39, -78, -117, -156, -195, -234, -273, -312, -352, -392, -431, -471, -511, -551, -592,
+			-632, -673, -713, -754, -795, -836, -877, -918, -959, -1000, -1041, -1082, -1123, -1164, -1204, -1244,
+			-1284, -1323, -1362, -1400, -1438, -1476, -1512, -1548, -1583, -1617, -1651, -1683, -1715, -1745, -1774, -1802,
+			-1829, -1854, -1878, -1900, -1922, -1941, -1959, -1976, -1990, -2004, -2015, -2025, -2033, -2039, -2043, -2046,
+			-2047, -2046, -2043, -2039, -2033, -2025, -2015, -2004, -1990, -1976, -1959, -1941, -1922, -1900, -1878, -1854,
+			-1829, -1802, -1774, -1745, -1715, -1683, -1651, -1617, -1583, -1548, -1512, -1476, -1438, -1400, -1362, -1323,
+			-1284, -1244, -1204, -1164, -1123, -1082, -1041, -1000, -959, -918, -877, -836, -795, -754, -713, -673,
+			-632, -592, -551, -511, -471, -431, -392, -352, -312, -273, -234, -195, -156, -117, -78, -39,
+		},
+		//level 6, 2 harmonics
+		{
+			0, 50, 100, 151, 201, 251, 300, 350, 399, 449, 497, 546, 594, 642, 690, 737,
+			783, 830, 875, 920, 965, 1009, 1052, 1095, 1137, 1179, 1219, 1259, 1299, 1337, 1375, 1411,
+			1447, 1483, 1517, 1550, 1582, 1614, 1644, 1674, 1702, 1729, 1756, 1781, 1805, 1828, 1850, 1871,
+			1891, 1910, 1927, 1944, 1959, 1973, 1986, 1997, 2008, 2017, 2025, 2032, 2037, 2041, 2045, 2046,
+			2047, 2046, 2045, 2041, 2037, 2032, 2025, 2017, 2008, 1997, 1986, 1973, 1959, 1944, 1927, 1910,
+			1891, 1871, 1850, 1828, 1805, 1781, 1756, 1729, 1702, 1674, 1644, 1614, 1582, 1550, 1517, 1483,
+			1447, 1411, 1375, 1337, 1299, 1259, 1219, 1179, 1137, 1095, 1052, 1009, 965, 920, 875, 830,
+			783, 737, 690, 642, 594, 546, 497, 449, 399, 350, 300, 251, 201, 151, 100, 50,
+			0, -50, -100, -151, -201, -251, -300, -350, -399, -449, -497, -546, -594, -642, -690, -737,
+			-783, -830, -875, -920, -965, -1009, -1052, -1095, -1137, -1179, -1219, -1259, -1299, -1337, -1375, -1411,
+			-1447, -1483, -1517, -1550, -1582, -1614, -1644, -1674, -1702, -1729, -1756, -1781, -1805, -1828, -1850, -1871,
+			-1891, -1910, -1927, -1944, -1959, -1973, -1986, -1997, -2008, -2017, -2025, -2032, -2037, -2041, -2045, -2046,
+			-2047, -2046, -2045, -2041, -2037, -2032, -2025, -2017, -2008, -1997, -1986, -1973, -1959, -1944, -1927, -1910,
+			-1891, -1871, -1850, -1828, -1805, -1781, -1756, -1729, -1702, -1674, -1644, -1614, -1582, -1550, -1517, -1483,
+			-1447, -1411, -1375, -1337, -1299, -1259, -1219, -1179, -1137, -1095, -1052, -1009, -965, -920, -875, -830,
+			-783, -737, -690, -642, -594, -546, -497, -449, -399, -350, -300, -251, -201, -151, -100, -50,
+		},
+		//level 7, 1 harmonics
+		{
+			0, 50, 100, 151, 201, 251, 300, 350, 399, 449, 497, 546, 594, 642, 690, 737,
+			783, 830, 875, 920, 965, 1009, 1052, 1095, 1137, 1179, 1219, 1259, 1299, 1337, 1375, 1411,
+			1447, 1483, 1517, 1550, 1582, 1614, 1644, 1674, 1702, 1729, 1756, 1781, 1805, 1828, 1850, 1871,
+			1891, 1910, 1927, 1944, 1959, 1973, 1986, 1997, 2008, 2017, 2025, 2032, 2037, 2041, 2045, 2046,
+			2047, 2046, 2045, 2041, 2037, 2032, 2025, 2017, 2008, 1997, 1986, 1973, 1959, 1944, 1927, 1910,
+			1891, 1871, 1850, 1828, 1805, 1781, 1756, 1729, 1702, 1674, 1644, 1614, 1582, 1550, 1517, 1483,
+			1447, 1411, 1375, 1337, 1299, 1259, 1219, 1179, 1137, 1095, 1052, 1009, 965, 920, 875, 830,
+			783, 737, 690, 642, 594, 546, 497, 449, 399, 350, 300, 251, 201, 151, 100, 50,
+			0, -50, -100, -151, -201, -251, -300, -350, -399, -449, -497, -546, -594, -642, -690, -737,
+			-783, -830, -875, -920, -965, -1009, -1052, -1095, -1137, -1179, -1219, -1259, -1299, -1337, -1375, -1411,
+			-1447, -1483, -1517, -1550, -1582, -1614, -1644, -1674, -1702, -1729, -1756, -1781, -1805, -1828, -1850, -1871,
+			-1891, -1910, -1927, -1944, -1959, -1973, -1986, -1997, -2008, -2017, -2025, -2032, -2037, -2041, -2045, -2046,
+			-2047, -2046, -2045, -2041, -2037, -2032, -2025, -2017, -2008, -1997, -1986, -1973, -1959, -1944, -1927, -1910,
+			-1891, -1871, -1850, -1828, -1805, -1781, -1756, -1729, -1702, -1674, -1644, -1614, -1582, -1550, -1517, -1483,
+			-1447, -1411, -1375, -1337, -1299, -1259, -1219, -1179, -1137, -1095, -1052, -1009, -965, -920, -875, -830,
+			-783, -737, -690, -642, -594, -546, -497, -449, -399, -350, -300, -251, -201, -151, -100, -50,
+		},
+	},
+};
+
+#endif /* SYNTH_WAVETABLES */
+
+//first quarter of a sine cycle, both ends included
+const int16_t sine_quarter[SINE_QUARTER_SIZE + 1] = {
+	0, 13, 25, 38, 50, 63, 75, 88, 100, 113, 126, 138, 151, 163, 176, 188,
+	201, 213, 226, 238, 251, 263, 275, 288, 300, 313, 325, 338, 350, 362, 375, 387,
+	399, 412, 424, 436, 449, 461, 473, 485, 497, 510, 522, 534, 546, 558, 570, 582,
+	594, 606, 618, 630, 642, 654, 666, 678, 690, 701, 713, 725, 737, 748, 760, 772,
+	783, 795, 807, 818, 830, 841, 852, 864, 875, 887, 898, 909, 920, 932, 943, 954,
+	965, 976, 987, 998, 1009, 1020, 1031, 1042, 1052, 1063, 1074, 1085, 1095, 1106, 1116, 1127,
+	1137, 1148, 1158, 1168, 1179, 1189, 1199, 1209, 1219, 1229, 1239, 1249, 1259, 1269, 1279, 1289,
+	1299, 1308, 1318, 1328, 1337, 1347, 1356, 1365, 1375, 1384, 1393, 1402, 1411, 1421, 1430, 1439,
+	1447, 1456, 1465, 1474, 1483, 1491, 1500, 1508, 1517, 1525, 1533, 1542, 1550, 1558, 1566, 1574,
+	1582, 1590, 1598, 1606, 1614, 1621, 1629, 1637, 1644, 1652, 1659, 1666, 1674, 1681, 1688, 1695,
+	1702, 1709, 1716, 1723, 1729, 1736, 1743, 1749, 1756, 1762, 1769, 1775, 1781, 1787, 1793, 1799,
+	1805, 1811, 1817, 1823, 1828, 1834, 1840, 1845, 1850, 1856, 1861, 1866, 1871, 1876, 1881, 1886,
+	1891, 1896, 1901, 1905, 1910, 1914, 1919, 1923, 1927, 1932, 1936, 1940, 1944, 1948, 1951, 1955,
+	1959, 1962, 1966, 1969, 1973, 1976, 1979, 1983, 1986, 1989, 1992, 1994, 1997, 2000, 2003, 2005,
+	2008, 2010, 2012, 2015, 2017, 2019, 2021, 2023, 2025, 2027, 2028, 2030, 2032, 2033, 2035, 2036,
+	2037, 2038, 2039, 2040, 2041, 2042, 2043, 2044, 2045, 2045, 2046, 2046, 2046, 2047, 2047, 2047,
+	2047,
+};
@@ -0,0 +1,91 @@
+/*************************************************************************************************
+                                       --WAVETABLES--
+
+	Band-limited single-cycle tables for the oscillators, one set per waveform with one
+	table per octave of phase increment. The tables are const so they stay in flash, and the
+	top bits of the phase accumulator index them directly. Regenerate wavetables.c with
+	tools/gen_wavetables.py.
+
+	A quarter-wave sine is kept for the sine and FM oscillators and the LFOs, also when
+	SYNTH_WAVETABLES is off. sine_lookup() unfolds it to a full cycle of 4 * SINE_QUARTER_SIZE
+	points, sine_lookup_interp() interpolates linearly between them.
+
+*************************************************************************************************/
+
+#ifndef WAVETABLES_H_INCLUDED
+#define WAVETABLES_H_INCLUDED
+
+#include <stdint.h>
+#include "conf_synth.h"
+
+/**********  DEFINE  ************/
+//same order as enum wave_type
+#define WAVETABLE_WAVES			(	3	)
+#define WAVETABLE_LEVELS		(	8	)
+#define WAVETABLE_SIZE			(	256	)
+
+//phase accumulator bits above the table index
+#define WAVETABLE_INDEX_SHIFT	(	24	)
+
+#define SINE_QUARTER_SIZE		(	256	)
+#define SINE_INDEX_SHIFT		(	22	)
+
+/*******   GLOBAL VARS  *********/
+extern const int16_t wavetables[WAVETABLE_WAVES][WAVETABLE_LEVELS][WAVETABLE_SIZE];
+extern const int16_t sine_quarter[SINE_QUARTER_SIZE + 1];
+
+/***  APPLICATION FUNCTIONS  ****/
+static inline const int16_t *wavetable_select( int wave, uint32_t phase_inc )
+{
+	//level 0 below 2^24, then one level per octave of increment, so no harmonic passes Nyquist
+	int level = 0;
+	uint32_t octave = phase_inc >> WAVETABLE_INDEX_SHIFT;
+
+	while(octave)
+	{
+		level++;
+		octave >>= 1;
+	}
+
+	if(level >= WAVETABLE_LEVELS) level = WAVETABLE_LEVELS - 1;
+
+	return wavetables[wave][level];
+}
+
+static inline int32_t sine_lookup( uint32_t phase )
+{
+	//one table read, the second quarter reads the table backwards and the second half negates
+	uint32_t index = (phase >> SINE_INDEX_SHIFT) & (SINE_QUARTER_SIZE - 1);
+	int32_t value;
+
+	if(phase & 0x40000000ul) index = SINE_QUARTER_SIZE - index;
+	value = sine_quarter[index];
+
+	return (phase & 0x80000000ul) ? -value : value;
+}
+
+static inline int32_t sine_lookup_interp( uint32_t phase )
+{
+	//folds the phase into the first quarter first, so the neighbour is always the next entry
+	uint32_t x = phase & 0x3FFFFFFFul;
+	uint32_t index;
+	int32_t lo;
+	int32_t value;
+
+	if(phase & 0x40000000ul) x = 0x40000000ul - x;
+	index = x >> SINE_INDEX_SHIFT;
+
+	if(index >= SINE_QUARTER_SIZE)
+	{
+		value = sine_quarter[SINE_QUARTER_SIZE];
+	}
+	else
+	{
+		lo = sine_quarter[index];
+		value = lo + (((sine_quarter[index + 1] - lo) * (int32_t) ((x >> (SINE_INDEX_SHIFT - 8)) & 0xFF)) >> 8);
+	}
+
+	return (phase & 0x80000000ul) ? -value : value;
+}
+
+#endif /* WAVETABLES_H_INCLUDED */
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Decoder for the audio tap dump (src/audio_tap.h).
+
+Build with SYNTH_AUDIO_TAP set, arm a capture with ":tap 1" on the console, play, then
+capture the EDBG port while pressing 'a'; console text around the dump is skipped:
+    stty -F /dev/ttyACM0 115200 raw -echo
+    cat /dev/ttyACM0 > tap.bin          (press 'a', then stop cat once the dump is through)
+    python3 tools/audio_tap.py tap.bin -o tap.wav
+
+Writes the blocks as a 16-bit WAV at the capture's sample rate, DAC codes scaled around
+the 2048 midscale, and prints the peak, RMS, DC offset and clipped samples per channel.
+A capture of every n-th block is written block after block, --gaps puts the blocks it
+skipped back in as silence so the timing matches the original.
+
+Usage: python3 tools/audio_tap.py [--gaps] [-o OUT.wav] CAPTURE
+"""
+
+import argparse
+import math
+import struct
+import sys
+import wave
+
+MAGIC = b"ATAP"
+VERSION = 1
+HEAD = struct.Struct("<BBHIHH")
+DAC_MIDSCALE = 2048
+DAC_MAX_CODE = 4095
+
+
+def parse(data):
+    """Returns (channels, block_size, rate, decimation, codes) of the last complete dump."""
+    start = data.rfind(MAGIC)
+    while start >= 0:
+        try:
+            return parse_at(data, start + len(MAGIC))
+        except ValueError as err:
+            print("audio_tap: dump at byte %d skipped, %s" % (start, err), file=sys.stderr)
+        start = data.rfind(MAGIC, 0, start)
+    raise ValueError("no complete dump in the capture")
+
+
+def parse_at(data, pos):
+    head = data[pos:pos + HEAD.size]
+    if len(head) < HEAD.size:
+        raise ValueError("truncated header")
+    version, channels, block_size, rate, decimation, blocks = HEAD.unpack(head)
+    if version != VERSION or channels not in (1, 2):
+        raise ValueError("unknown version %d or %d channels" % (version, channels))
+
+    words = blocks * block_size * channels
+    end = pos + HEAD.size + words * 2
+    if len(data) < end + 2:
+        raise ValueError("truncated, %d of %d bytes" % (len(data) - pos, end + 2 - pos))
+    (check,) = struct.unpack_from("<H", data, end)
+    if sum(data[pos:end]) & 0xFFFF != check:
+        raise ValueError("checksum mismatch")
+
+    codes = struct.unpack_from("<%dH" % words, data, pos + HEAD.size)
+    return channels, block_size, rate, decimation, codes
+
+
+def channel_stats(codes):
+    samples = [c - DAC_MIDSCALE for c in codes]
+    peak = max(abs(s) for s in samples)
+    mean = sum(samples) / len(samples)
+    rms = math.sqrt(sum(s * s for s in samples) / len(samples))
+    clipped = sum(1 for c in codes if c == 0 or c >= DAC_MAX_CODE)
+    return peak, rms, mean, clipped
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Turn an audio tap dump from an EDBG capture into a WAV.")
+    parser.add_argument("capture", help="captured bytes from the EDBG port")
+    parser.add_argument("-o", "--output", help="WAV file to write, statistics only without it")
+    parser.add_argument("--gaps", action="store_true", help="silence in place of the blocks not captured")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    try:
+        channels, block_size, rate, decimation, codes = parse(data)
+    except ValueError as err:
+        print("audio_tap: %s" % err, file=sys.stderr)
+        return 1
+
+    block_words = block_size * channels
+    blocks = len(codes) // block_words
+    print("%d blocks of %d, %d channel(s), %d Hz, every %d block(s)"
+          % (blocks, block_size, channels, rate, decimation))
+    if not codes:
+        return 0
+
+    for ch in range(channels):
+        peak, rms, mean, clipped = channel_stats(codes[ch::channels])
+        print("  channel %d: peak %d codes (%.1f dBFS), rms %.1f, dc %+.1f, %d clipped"
+              % (ch, peak, 20 * math.log10(peak / DAC_MIDSCALE) if peak else -math.inf, rms, mean, clipped))
+
+    if args.output:
+        samples = [max(-32768, min(32767, (c - DAC_MIDSCALE) * 16)) for c in codes]
+        silence = struct.pack("<%dh" % block_words, *([0] * block_words))
+        with wave.open(args.output, "wb") as out:
+            out.setnchannels(channels)
+            out.setsampwidth(2)
+            out.setframerate(rate)
+            for b in range(blocks):
+                out.writeframes(struct.pack("<%dh" % block_words, *samples[b * block_words:(b + 1) * block_words]))
+                if args.gaps and b != blocks - 1:
+                    for _ in range(decimation - 1):
+                        out.writeframes(silence)
+        print("wrote %s" % args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
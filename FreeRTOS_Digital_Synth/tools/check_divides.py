@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Looks for software divides called from the render path (src/recip.h).
+
+The M0+ has no divider, a '/' or '%' the compiler cannot turn into shifts is a call to
+libgcc's __aeabi_idiv and the like, a bit at a time. The render loop, the kernels and the
+output stages are SYNTH_RAM_CODE, linked into .relocate, so the check disassembles that
+section of the firmware and lists every call it makes to a divide, directly or through a
+linker veneer, with the function it is in. Exits 1 when there are any.
+
+    python3 tools/check_divides.py Debug/FreeRTOS_Digital_Synth.elf
+
+--section checks other sections instead, e.g. .text for a build without SYNTH_RAMFUNC, where
+every function is listed. --objdump names the disassembler, arm-none-eabi-objdump by default;
+llvm-objdump reads the same output.
+
+Usage: python3 tools/check_divides.py [--objdump TOOL] [--section NAME]... ELF
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+DIVIDES = re.compile(r"^(__aeabi_(u?idiv(mod)?|u?ldivmod|[fd]div|[fd]rdiv)|__u?(div|mod)[sd]i3|__udivmoddi4"
+                     r"|__div[sd]f3)(_veneer)?$")
+FUNCTION = re.compile(r"^[0-9a-fA-F]+ <([^>]+)>:$")
+CALL = re.compile(r"\sblx?\s+(0x)?[0-9a-fA-F]+\s+<([^>+]+)(\+0x[0-9a-fA-F]+)?>")
+
+
+def divide_calls(lines):
+    """Yields (function, address, callee) for each call to a divide in objdump -d output."""
+    function = "?"
+    for line in lines:
+        match = FUNCTION.match(line.strip())
+        if match:
+            function = match.group(1)
+            continue
+        match = CALL.search(line)
+        if match and DIVIDES.match(match.group(2)):
+            yield function, line.split(":")[0].strip(), match.group(2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="list software divides called from the hot sections")
+    parser.add_argument("elf")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump", help="disassembler to run")
+    parser.add_argument("--section", action="append", help="section to check, .relocate by default")
+    args = parser.parse_args()
+
+    command = [args.objdump, "-d"]
+    for section in args.section or [".relocate"]:
+        command += ["-j", section]
+    command.append(args.elf)
+
+    try:
+        listing = subprocess.run(command, stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError) as err:
+        print("check_divides: %s" % err, file=sys.stderr)
+        return 2
+
+    found = list(divide_calls(listing.splitlines()))
+    for function, address, callee in found:
+        print("%-32s %10s  %s" % (function, address, callee))
+    print("%d divide call%s in %s" % (len(found), "" if len(found) == 1 else "s", ", ".join(args.section or [".relocate"])))
+    return 1 if found else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Fails the build when soft-float can be reached from the render path.
+
+The M0+ has no FPU, a float or double anywhere is a call to libgcc's __aeabi_fmul,
+__aeabi_f2iz and the like at some tens of cycles each. The Debug configuration runs this
+after the link on the two listings it already writes:
+
+  - the .map, whose archive member list says which float helpers were linked and which
+    object asked for them. With none linked there is nothing more to check.
+  - the .lss, objdump -h -S of the firmware. Every call and tail call in it makes a call
+    graph, walked from the roots: all the SYNTH_RAM_CODE functions in .relocate (render
+    loop, kernels, output stages), every *_Handler, and the render task. A root that
+    reaches a float helper is listed with the chain of calls that gets there.
+
+Calls through pointers, as from the DMA and sample clock interrupts to their callbacks,
+are not followed; the callbacks are SYNTH_RAM_CODE and roots of their own. --root adds a
+function to the roots. Exits 1 when a root reaches a float helper, 2 when a listing cannot
+be read.
+
+Usage: python3 tools/check_float.py [--map MAP] [--root NAME]... LSS
+"""
+
+import argparse
+import collections
+import os
+import re
+import sys
+
+# the AEABI and the GCC names of the single and double precision helpers
+FLOAT = re.compile(r"^(__aeabi_(f|d|cf|cd)\w+|__aeabi_u?[il]2[fd]"
+                   r"|__(add|sub|mul|div|neg)[sd]f3|__fix(uns)?[sd]f[sd]i|__float(un)?[sd]i[sd]f"
+                   r"|__extendsfdf2|__truncdfsf2|__(eq|ne|lt|le|gt|ge|un|cmp)[sd]f2)$")
+SECTION = re.compile(r"^Disassembly of section (\S+):$")
+FUNCTION = re.compile(r"^[0-9a-fA-F]+ <([^>]+)>:$")
+# bl, blx and plain or conditional branches to the start of another function
+BRANCH = re.compile(r"\tb[a-z]*(\.[nw])?\s+(0x)?[0-9a-fA-F]+ <([^>+]+)>")
+VENEER = re.compile(r"^__(.+)_veneer$")
+HOT_SECTIONS = (".relocate",)
+ROOTS = ("vSampleCalcTask",)
+
+
+def linked_floats(lines):
+    """Yields (member, referrer, symbol) for the float helpers in the map's archive list."""
+    member = None
+    for line in lines:
+        if line.startswith(("Discarded input sections", "Allocating common symbols", "Memory Configuration")):
+            return
+        if not line.strip() or line.startswith("Archive member"):
+            continue
+        if not line[0].isspace():
+            member = line.strip()
+            continue
+        match = re.match(r"^\s+(.*) \((\S+)\)$", line)
+        if match and member and FLOAT.match(match.group(2)):
+            yield member, match.group(1), match.group(2)
+
+
+def call_graph(lines):
+    """Returns ({function: set of callees}, {function: section}) from objdump -d or -S output."""
+    calls = collections.defaultdict(set)
+    sections = {}
+    section = None
+    function = None
+    for line in lines:
+        match = SECTION.match(line)
+        if match:
+            section = match.group(1)
+            continue
+        match = FUNCTION.match(line)
+        if match:
+            function = match.group(1)
+            sections[function] = section
+            continue
+        match = BRANCH.search(line)
+        if match and function and match.group(3) != function:
+            calls[function].add(match.group(3))
+
+    # a veneer, for a call between flash and SRAM, only loads its target's address
+    for function in list(sections):
+        match = VENEER.match(function)
+        if match:
+            calls[function].add(match.group(1))
+    return calls, sections
+
+
+def float_paths(calls, roots):
+    """Yields the call chain from a root to each float helper it reaches, one per helper."""
+    for root in sorted(roots):
+        parent = {root: None}
+        queue = collections.deque([root])
+        while queue:
+            function = queue.popleft()
+            if FLOAT.match(function):
+                chain = []
+                while function is not None:
+                    chain.append(function)
+                    function = parent[function]
+                yield list(reversed(chain))
+                continue
+            for callee in sorted(calls.get(function, ())):
+                if callee not in parent:
+                    parent[callee] = function
+                    queue.append(callee)
+
+
+def short(path):
+    """The archive or object file name without the toolchain's directories."""
+    return re.split(r"[\\/]", path)[-1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="fail when soft-float is reachable from the render path")
+    parser.add_argument("lss")
+    parser.add_argument("--map", help="linker map, the .lss with .map by default")
+    parser.add_argument("--root", action="append", default=[], help="another function to walk from")
+    args = parser.parse_args()
+
+    map_path = args.map or os.path.splitext(args.lss)[0] + ".map"
+    try:
+        with open(map_path) as f:
+            linked = list(linked_floats(f))
+    except OSError as err:
+        print("check_float: %s" % err, file=sys.stderr)
+        return 2
+
+    if not linked:
+        print("check_float: no soft-float helpers linked")
+        return 0
+    for member, referrer, symbol in linked:
+        print("linked: %s for %s (%s)" % (short(member), short(referrer), symbol))
+
+    try:
+        with open(args.lss) as f:
+            calls, sections = call_graph(f)
+    except OSError as err:
+        print("check_float: %s" % err, file=sys.stderr)
+        return 2
+
+    roots = {name for name, section in sections.items() if section in HOT_SECTIONS and not VENEER.match(name)}
+    roots |= {name for name in sections if name.endswith("_Handler")}
+    roots |= {name for name in list(ROOTS) + args.root if name in sections}
+
+    found = list(float_paths(calls, roots))
+    for chain in found:
+        print("reached: %s" % " -> ".join(chain))
+    if found:
+        print("check_float: soft-float reachable from %d path%s" % (len(found), "" if len(found) == 1 else "s"))
+        return 1
+
+    print("check_float: soft-float linked, none of it reachable from %d roots" % len(roots))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
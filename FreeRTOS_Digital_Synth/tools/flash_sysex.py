@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Turns an SPI flash image into the SysEx upload of src/flash_upload.h.
+
+The image, usually from tools/gen_flash_image.py, is written at the address,
+0 unless given, which must be on a 4 KB sector. The .syx file holds the BEGIN
+message, one DATA message per 256-byte page and the END message with the
+image's CRC-32; send it with any SysEx librarian, leaving 30 ms between
+messages over USB-MIDI. The board reports the result on its console.
+
+Usage: python3 tools/flash_sysex.py image.bin out.syx [address]
+"""
+
+import sys
+import zlib
+
+ID = 0x7D
+DEVICE = 0x01
+BEGIN = 0x01
+DATA = 0x02
+END = 0x03
+PAGE = 256
+SECTOR = 4096
+FLASH_MAX = 0x1000000  # SYNTH_FLASH_UPLOAD_MAX
+
+
+def septets(value, count):
+    return [(value >> (7 * (count - 1 - i))) & 0x7F for i in range(count)]
+
+
+def pack(data):
+    # a byte of the top bits ahead of each 7, bit n the top bit of the nth byte
+    out = []
+    for i in range(0, len(data), 7):
+        group = data[i:i + 7]
+        out.append(sum(((b >> 7) & 1) << n for n, b in enumerate(group)))
+        out.extend(b & 0x7F for b in group)
+    return out
+
+
+def message(op, payload):
+    checksum = -(op + sum(payload)) & 0x7F
+    return bytes([0xF0, ID, DEVICE, op] + payload + [checksum, 0xF7])
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__.strip().splitlines()[-1], file=sys.stderr)
+        return 1
+
+    with open(sys.argv[1], "rb") as f:
+        image = f.read()
+    address = int(sys.argv[3], 0) if len(sys.argv) > 3 else 0
+    assert address % SECTOR == 0, "the address must be on a 4 KB sector"
+    assert 0 < len(image) <= FLASH_MAX - address, "the image does not fit the flash"
+
+    out = message(BEGIN, septets(address, 4) + septets(len(image), 4))
+    for offset in range(0, len(image), PAGE):
+        out += message(DATA, septets(offset, 4) + pack(image[offset:offset + PAGE]))
+    out += message(END, septets(zlib.crc32(image) & 0xFFFFFFFF, 5))
+
+    with open(sys.argv[2], "wb") as f:
+        f.write(out)
+
+    print("%s: %d bytes at 0x%06x, %d messages" % (sys.argv[2], len(image), address, (len(image) + PAGE - 1) // PAGE + 2))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
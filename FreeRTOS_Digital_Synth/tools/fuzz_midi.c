@@ -0,0 +1,363 @@
+/*************************************************************************************************
+                                         --MIDI FUZZER--
+
+	Host fuzz target for the MIDI parser, the framer and the engine's event handling, built
+	from the same sources as tools/host_render.c. Every run feeds a byte stream to a parser
+	and a framer side by side and the events into the engine, rendering as it goes, and
+	checks that:
+		- every event is in range for its type
+		- the framer marks the end of every message the parser completes, tuning events
+		  inside a SysEx aside, and gives each Note On the same as the parser
+		- the voice bank's active list and wave type groups, voice indexes and notes stay
+		  in range, and the allocator never returns a voice outside the slots
+		- the output stays within the DAC codes
+		- nothing locks up: a run that takes over RUN_TIMEOUT_S seconds is a failure
+	A run's stream comes from its seed alone; a failure prints the seed and the stream, and
+	-s with that seed and -n 1 replays it.
+
+	Half the runs are random bytes. The other half are messages with the faults a cable or
+	a sender produces: running status, realtime bytes inside messages, messages cut short
+	by a new status, stray data bytes, tuning SysEx cut at any byte and unterminated ones,
+	and system common messages with their data missing.
+
+	Build from FreeRTOS_Digital_Synth/:
+		gcc -O2 -Wall -Isrc -Isrc/config -o fuzz_midi tools/fuzz_midi.c src/synth_engine.c \
+			src/voice_alloc.c src/note_table.c src/midi_parser.c src/wavetables.c src/svf.c \
+			src/velocity_curves.c src/modulation.c src/samples.c src/stream.c src/delay.c \
+			src/shaper.c src/shaper_curves.c src/limiter.c src/midi_clock.c src/arpeggiator.c \
+			src/pattern.c src/patterns.c src/pluck.c src/curves.c src/block_pool.c \
+			src/dac_codes.c src/recip.c src/audio_stats.c src/synth_core.c \
+			src/drum.c src/formant.c src/reverb.c src/grain.c src/grain_windows.c src/automation.c \
+			src/profile.c
+
+	Usage: fuzz_midi [-n runs] [-s first_seed] [-l max_bytes]
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include "synth_engine.h"
+#include "voice_alloc.h"
+
+
+/**********  DEFINE  ************/
+#define DEFAULT_RUNS		(	1000	)
+#define DEFAULT_BYTES		(	4096	)
+#define RUN_TIMEOUT_S		(	10	)
+#define BYTE_GAP_MAX		(	64	)	//samples between bytes, at most
+#define TAIL_BLOCKS			(	64	)
+
+
+/*******   GLOBAL VARS  *********/
+static uint32_t fuzz_state;
+static uint32_t fuzz_seed;
+static uint8_t *fuzz_stream;
+static size_t fuzz_length;
+static size_t fuzz_pos;
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint32_t fuzz_random( void )
+{
+	//xorshift32, the state is never 0
+	fuzz_state ^= fuzz_state << 13;
+	fuzz_state ^= fuzz_state >> 17;
+	fuzz_state ^= fuzz_state << 5;
+
+	return fuzz_state;
+}
+
+static uint32_t fuzz_below( uint32_t n )
+{
+	return fuzz_random() % n;
+}
+
+static void fuzz_dump( void )
+{
+	size_t i;
+
+	fprintf(stderr, "seed %lu, byte %lu of %lu:", (unsigned long) fuzz_seed, (unsigned long) fuzz_pos,
+		(unsigned long) fuzz_length);
+	for(i=0; i<fuzz_length; i++) fprintf(stderr, "%s%02X", (i % 32) ? " " : "\n", fuzz_stream[i]);
+	fprintf(stderr, "\n");
+}
+
+static void fuzz_fail( const char *what )
+{
+	fprintf(stderr, "fuzz_midi: %s\n", what);
+	fuzz_dump();
+	exit(1);
+}
+
+static void fuzz_timeout( int signal )
+{
+	//a lockup: only async-signal-safe calls from here
+	static const char message[] = "fuzz_midi: run timed out, rerun its seed under a debugger\n";
+
+	(void) signal;
+	if(write(STDERR_FILENO, message, sizeof(message) - 1) < 0) _exit(1);
+	_exit(1);
+}
+
+static void fuzz_put( size_t *length, size_t max, uint8_t byte )
+{
+	if(*length < max) fuzz_stream[(*length)++] = byte;
+}
+
+static size_t fuzz_messages( size_t max )
+{
+	//messages with faults, see the header
+	static const uint8_t lengths[8] = { 2, 2, 2, 2, 1, 1, 2, 0 };
+	size_t length = 0;
+	uint8_t status = 0;
+	int count;
+	int i;
+
+	while(length < max)
+	{
+		switch(fuzz_below(8))
+		{
+			case 0:
+			case 1:
+			case 2:
+			//a channel message, with running status half the time; note messages most often
+			if((status == 0) || fuzz_below(2))
+			{
+				status = (uint8_t) ((fuzz_below(4) ? 0x80 + 0x10 * fuzz_below(2) : 0x80 + 0x10 * fuzz_below(7)) | fuzz_below(16));
+				fuzz_put(&length, max, status);
+			}
+			count = lengths[(status >> 4) & 7];
+			for(i=0; i<count; i++)
+			{
+				//a realtime byte may come between any two
+				if(fuzz_below(16) == 0) fuzz_put(&length, max, (uint8_t) (0xF8 + fuzz_below(8)));
+				fuzz_put(&length, max, (uint8_t) fuzz_below(128));
+			}
+			break;
+
+			case 3:
+			//cut short by the next status
+			if(status != 0) fuzz_put(&length, max, status);
+			if(fuzz_below(2)) fuzz_put(&length, max, (uint8_t) fuzz_below(128));
+			status = 0;
+			break;
+
+			case 4:
+			//a stray data byte
+			fuzz_put(&length, max, (uint8_t) fuzz_below(128));
+			break;
+
+			case 5:
+			//tuning SysEx, real-time or not, cut anywhere and often unterminated
+			fuzz_put(&length, max, MIDI_SYSEX_START);
+			fuzz_put(&length, max, fuzz_below(2) ? 0x7F : 0x7E);
+			fuzz_put(&length, max, (uint8_t) fuzz_below(128));
+			fuzz_put(&length, max, 0x08);
+			fuzz_put(&length, max, (uint8_t) (fuzz_below(2) ? 0x02 : fuzz_below(16)));
+			count = (int) fuzz_below(48);
+			for(i=0; i<count; i++) fuzz_put(&length, max, (uint8_t) fuzz_below(128));
+			if(fuzz_below(4)) fuzz_put(&length, max, MIDI_SYSEX_END);
+			status = 0;
+			break;
+
+			case 6:
+			//system common, its data there or not
+			fuzz_put(&length, max, (uint8_t) (0xF1 + fuzz_below(7)));
+			count = (int) fuzz_below(3);
+			for(i=0; i<count; i++) fuzz_put(&length, max, (uint8_t) fuzz_below(128));
+			status = 0;
+			break;
+
+			default:
+			//a realtime byte on its own
+			fuzz_put(&length, max, (uint8_t) (0xF8 + fuzz_below(8)));
+			break;
+		}
+	}
+
+	return length;
+}
+
+static void check_event( const struct midi_event *event )
+{
+	if(event->status < MIDI_SYSEX_START)
+	{
+		if((event->status & 0x0F) || (event->status < MIDI_NOTE_OFF)) fuzz_fail("channel message status with its channel");
+		if(event->channel > 15) fuzz_fail("channel out of range");
+		if((event->data1 > 127) || (event->data2 > 127)) fuzz_fail("data byte out of range");
+		if((event->status == MIDI_NOTE_ON) && (event->data2 == 0)) fuzz_fail("Note On with velocity 0");
+	}
+	else if(event->status == MIDI_TUNING_NOTE)
+	{
+		if((event->channel > 127) || (event->data1 > 127) || (event->data2 > 127)) fuzz_fail("tuning note out of range");
+	}
+	else if(event->status == MIDI_TUNING_SCALE)
+	{
+		if(((event->channel > 11) && (event->channel != MIDI_TUNING_RESET)) || (event->data1 > 127)) fuzz_fail("tuning scale out of range");
+	}
+	else if(event->status < MIDI_CLOCK)
+	{
+		fuzz_fail("system common message out of the parser");
+	}
+}
+
+static void check_voices( void )
+{
+	int count = 0;
+	int group;
+	int channel;
+	int voice;
+	int note;
+	int i;
+
+	if(voice_bank.active_count > SYNTH_MAX_VOICES) fuzz_fail("active count over the voices");
+
+	for(i=0; i<voice_bank.active_count; i++)
+	{
+		voice = voice_bank.active[i];
+		if(voice >= SYNTH_MAX_VOICES) fuzz_fail("active voice index out of range");
+		if(!voice_bank.enable[voice]) fuzz_fail("active voice not enabled");
+		if(voice_bank.active_pos[voice] != i) fuzz_fail("active list position out of step");
+	}
+
+	for(voice=0; voice<SYNTH_MAX_VOICES; voice++)
+	{
+		if(!voice_bank.enable[voice]) continue;
+		count++;
+		if(voice_bank.note[voice] > 127) fuzz_fail("voice note out of range");
+		if(voice_bank.channel[voice] > 15) fuzz_fail("voice channel out of range");
+		if(voice_bank.type[voice] >= WAVE_TYPE_COUNT) fuzz_fail("voice wave type out of range");
+	}
+	if(count != voice_bank.active_count) fuzz_fail("enabled voices and the active count differ");
+
+	for(i=0; i<WAVE_TYPE_COUNT; i++)
+	{
+		if(voice_bank.batch_start[i] > voice_bank.batch_start[i + 1]) fuzz_fail("wave type groups out of order");
+	}
+	if(voice_bank.batch_start[WAVE_TYPE_COUNT] != count) fuzz_fail("enabled voices and the wave type groups differ");
+	for(i=0; i<count; i++)
+	{
+		voice = voice_bank.batch[i];
+		if(voice >= SYNTH_MAX_VOICES) fuzz_fail("grouped voice index out of range");
+		if(voice_bank.batch_pos[voice] != i) fuzz_fail("wave type group position out of step");
+		if((i < voice_bank.batch_start[voice_bank.type[voice]]) || (i >= voice_bank.batch_start[voice_bank.type[voice] + 1]))
+			fuzz_fail("voice in another wave type's group");
+	}
+
+	for(group=0; group<SYNTH_VOICE_GROUPS; group++)
+	{
+		for(channel=0; channel<SYNTH_MIDI_CHANNELS; channel++)
+		{
+			for(note=0; note<128; note++)
+			{
+				voice = voice_alloc_find(group, (uint8_t) channel, (uint8_t) note);
+				if(voice == VOICE_NONE) continue;
+				if((voice < 0) || (voice >= SYNTH_MAX_VOICES)) fuzz_fail("allocator voice out of range");
+				if(voice_bank.channel[voice] != channel) fuzz_fail("allocator voice on another channel");
+			}
+		}
+	}
+}
+
+static void render( uint16_t *frame )
+{
+	int i;
+
+	synth_render_block(frame);
+	for(i=0; i<SYNTH_FRAME_WORDS; i++) if(frame[i] > DAC_MAX_CODE) fuzz_fail("output beyond the DAC codes");
+	check_voices();
+}
+
+static void fuzz_run( size_t max )
+{
+	struct midi_parser parser;
+	struct midi_framer framer;
+	struct midi_event event;
+	struct midi_event note;
+	uint16_t frame[SYNTH_FRAME_WORDS];
+	uint32_t time;
+	bool end;
+	bool parsed;
+	int i;
+
+	fuzz_state = fuzz_seed ? fuzz_seed : 1;
+	fuzz_length = (size_t) fuzz_below((uint32_t) max) + 1;
+	if(fuzz_below(2))
+	{
+		for(fuzz_pos=0; fuzz_pos<fuzz_length; fuzz_pos++) fuzz_stream[fuzz_pos] = (uint8_t) fuzz_random();
+	}
+	else fuzz_length = fuzz_messages(fuzz_length);
+
+	synth_init();
+	midi_parser_init(&parser);
+	midi_framer_init(&framer);
+	time = synth_render_time();
+
+	alarm(RUN_TIMEOUT_S);
+	for(fuzz_pos=0; fuzz_pos<fuzz_length; fuzz_pos++)
+	{
+		end = midi_framer_feed(&framer, fuzz_stream[fuzz_pos]);
+		parsed = midi_parser_feed(&parser, fuzz_stream[fuzz_pos], &event);
+
+		if(parsed)
+		{
+			check_event(&event);
+			if(!end && (event.status != MIDI_TUNING_NOTE) && (event.status != MIDI_TUNING_SCALE)) fuzz_fail("framer missed the end of a message");
+			if(end && (event.status == MIDI_NOTE_ON))
+			{
+				if(!midi_framer_note_on(&framer, fuzz_stream[fuzz_pos], &note)) fuzz_fail("framer missed a Note On");
+				if(memcmp(&note, &event, sizeof(note))) fuzz_fail("framer Note On differs from the parser's");
+			}
+
+			//a full queue waits for the renderer, like the MIDI task's
+			while(!synth_post_event_at(&event, time)) render(frame);
+		}
+
+		time += fuzz_below(BYTE_GAP_MAX);
+		while((int32_t) (time - synth_render_time()) >= SYNTH_BLOCK_SIZE) render(frame);
+	}
+
+	for(i=0; i<TAIL_BLOCKS; i++) render(frame);
+	alarm(0);
+}
+
+int main( int argc, char **argv )
+{
+	unsigned long runs = DEFAULT_RUNS;
+	unsigned long first = 1;
+	unsigned long run;
+	size_t max = DEFAULT_BYTES;
+	int i;
+
+	for(i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && (i + 1 < argc)) runs = strtoul(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-s") && (i + 1 < argc)) first = strtoul(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-l") && (i + 1 < argc)) max = (size_t) strtoul(argv[++i], NULL, 10);
+		else
+		{
+			fprintf(stderr, "usage: %s [-n runs] [-s first_seed] [-l max_bytes]\n", argv[0]);
+			return 2;
+		}
+	}
+	if(max == 0) max = 1;
+
+	fuzz_stream = malloc(max);
+	if(fuzz_stream == NULL) return 1;
+	signal(SIGALRM, fuzz_timeout);
+
+	for(run=0; run<runs; run++)
+	{
+		fuzz_seed = (uint32_t) (first + run);
+		fuzz_run(max);
+	}
+
+	printf("%lu runs from seed %lu, no faults\n", runs, first);
+	free(fuzz_stream);
+
+	return 0;
+}
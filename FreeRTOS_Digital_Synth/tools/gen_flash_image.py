@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Builds the SPI flash image of the STREAM voice type, see src/stream.h.
+
+The image is the directory at address 0, "SYNF", a 32-bit count and one
+24-byte entry per sample (address, length, loop start, loop end, rate, root
+note, low key, high key, pad), then the sample data as 16-bit signed little
+endian frames, each sample starting on a 256-byte flash page. Samples come
+from mono 16-bit WAV files given as
+    file.wav:root:lo-hi[:loop_start-loop_end]
+with the loop in frames; without any, the image holds the built-in bank of
+tools/gen_samples.py at full resolution, for a quick test of the hardware.
+
+A standard MIDI file given as file.mid goes at SMF_ADDRESS, where the song
+player of src/smf_player.h looks for it, the gap padded as erased flash.
+
+Program the image with any SPI flash programmer, or over MIDI with
+tools/flash_sysex.py.
+
+Usage: python3 tools/gen_flash_image.py out.bin [file.mid] [file.wav:root:lo-hi[:start-end] ...]
+"""
+
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import gen_samples
+
+MAGIC = b"SYNF"
+SAMPLES_MAX = 32
+PAGE = 256
+ENTRY = struct.Struct("<5I4B")
+SMF_ADDRESS = 0x100000  # SYNTH_SMF_ADDRESS
+
+
+def parse(spec):
+    fields = spec.split(":")
+    values, rate = gen_samples.read_wav(fields[0])
+    lo, hi = (int(v) for v in fields[2].split("-"))
+    loop = tuple(int(v) for v in fields[3].split("-")) if len(fields) > 3 else None
+    return values, rate, int(fields[1]), (lo, hi), loop
+
+
+def builtin():
+    bank = []
+    for name, values, rate, bits, root, keys_range, loop in gen_samples.samples():
+        bank.append((values, rate, root, keys_range, loop))
+    return bank
+
+
+def pcm16(values):
+    peak = max(max(abs(v) for v in values), 1e-9)
+    return struct.pack("<%dh" % len(values), *(int(round(v * 32767 / peak)) for v in values))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip().splitlines()[-1], file=sys.stderr)
+        return 1
+
+    songs = [spec for spec in sys.argv[2:] if spec.lower().endswith(".mid")]
+    assert len(songs) <= 1, "one MIDI file at most"
+    bank = [parse(spec) for spec in sys.argv[2:] if spec not in songs] or builtin()
+    assert len(bank) <= SAMPLES_MAX, "at most %d samples" % SAMPLES_MAX
+
+    offset = 8 + ENTRY.size * len(bank)
+    entries = b""
+    data = b""
+    for values, rate, root, keys_range, loop in bank:
+        address = (offset + len(data) + PAGE - 1) // PAGE * PAGE
+        data += b"\xff" * (address - offset - len(data))
+        start, end = loop if loop else (0, 0)
+        entries += ENTRY.pack(address, len(values), start, end, rate, root, keys_range[0], keys_range[1], 0)
+        data += pcm16(values)
+
+    image = MAGIC + struct.pack("<I", len(bank)) + entries + data
+    if songs:
+        assert len(image) <= SMF_ADDRESS, "the samples run into the song"
+        with open(songs[0], "rb") as f:
+            song = f.read()
+        assert song[:4] == b"MThd", "%s is not a standard MIDI file" % songs[0]
+        image += b"\xff" * (SMF_ADDRESS - len(image)) + song
+
+    with open(sys.argv[1], "wb") as f:
+        f.write(image)
+
+    print("%s: %d samples, %d bytes" % (sys.argv[1], len(bank), len(image)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Generates src/grain_windows.c, the envelopes of the GRAIN voices' grains.
+
+Each window is GRAIN_WINDOW_SIZE steps over a grain's length in Q15, the extra last entry
+the grain's end, which is silent:
+    hann   raised cosine, the smoothest sum when grains overlap several deep
+    tukey  flat top with raised cosine ends a quarter of the length each, keeps a sparse
+           cloud's grains near full level for most of their length
+
+Usage: python3 tools/gen_grain_windows.py > src/grain_windows.c
+"""
+
+import math
+
+SIZE = 256
+FULL = 32767
+TUKEY_ALPHA = 0.5
+
+
+def hann(x):
+    return 0.5 - 0.5 * math.cos(2.0 * math.pi * x)
+
+
+def tukey(x):
+    edge = TUKEY_ALPHA / 2.0
+    if x < edge:
+        return 0.5 - 0.5 * math.cos(math.pi * x / edge)
+    if x > 1.0 - edge:
+        return 0.5 - 0.5 * math.cos(math.pi * (1.0 - x) / edge)
+    return 1.0
+
+
+WINDOWS = [("HANN", hann), ("TUKEY", tukey)]
+
+
+def main():
+    print("/*************************************************************************************************")
+    print("                                    --GRAIN WINDOWS--")
+    print("")
+    print("\tGenerated by tools/gen_grain_windows.py, do not edit by hand.")
+    print("")
+    print("*************************************************************************************************/")
+    print("")
+    print("/******* HEADER INCLUDES ********/")
+    print('#include "grain.h"')
+    print("")
+    print("")
+    print("/*******   GLOBAL VARS  *********/")
+    print("const int16_t grain_windows[GRAIN_WINDOW_COUNT][GRAIN_WINDOW_SIZE + 1] = {")
+    for name, fn in WINDOWS:
+        print("\t//%s" % name)
+        print("\t{")
+        values = [max(0, min(FULL, int(round(FULL * fn(i / SIZE))))) for i in range(SIZE + 1)]
+        for row in range(0, SIZE + 1, 16):
+            print("\t\t" + ", ".join("%d" % x for x in values[row:row + 16]) + ",")
+        print("\t},")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Generates src/samples.c, the PCM sample bank of the SAMPLE voice type.
+
+Every entry of SAMPLES is either synthesised here (so the firmware has a kit
+without any recordings) or read from a mono 16-bit WAV file:
+    name, source, bits, root note, key range, loop (start, end) in frames or None
+The built-in bank is a GM-style kick, snare and closed hat on keys 36, 38 and
+42 and a looped keyboard tone over keys 48..108.
+
+Usage: python3 tools/gen_samples.py > src/samples.c
+"""
+
+import math
+import random
+import struct
+import wave
+
+RATE = 22050
+
+
+def kick():
+    # sine dropping from 150 Hz to 50 Hz with a fast decay
+    out = []
+    phase = 0.0
+    for i in range(int(RATE * 0.25)):
+        t = i / RATE
+        freq = 50.0 + 100.0 * math.exp(-t * 30.0)
+        phase += 2.0 * math.pi * freq / RATE
+        out.append(math.sin(phase) * math.exp(-t * 12.0))
+    return out
+
+
+def snare(rng):
+    # noise burst over a 190 Hz body
+    out = []
+    for i in range(int(RATE * 0.18)):
+        t = i / RATE
+        body = 0.5 * math.sin(2.0 * math.pi * 190.0 * t) * math.exp(-t * 30.0)
+        out.append(body + 0.6 * rng.uniform(-1.0, 1.0) * math.exp(-t * 22.0))
+    return out
+
+
+def hat(rng):
+    # first difference of noise tilts it towards the top octave
+    out = []
+    last = 0.0
+    for i in range(int(RATE * 0.08)):
+        t = i / RATE
+        x = rng.uniform(-1.0, 1.0)
+        out.append(0.5 * (x - last) * math.exp(-t * 60.0))
+        last = x
+    return out
+
+
+def keys():
+    # 261.6 Hz (C4) electric piano style tone, a 200 ms attack then whole cycles of the
+    # sustained spectrum to loop over
+    freq = 440.0 * 2.0 ** ((60 - 69) / 12.0)
+    period = RATE / freq
+    attack = int(RATE * 0.2)
+    cycles = 20
+    loop = int(round(period * cycles))
+    out = []
+    for i in range(attack + loop):
+        t = i / RATE
+        ph = 2.0 * math.pi * freq * t
+        bright = math.exp(-min(t, attack / RATE) * 15.0)
+        out.append(0.7 * math.sin(ph) + 0.25 * bright * math.sin(2 * ph) + 0.15 * bright * math.sin(3 * ph))
+    # one loop length is exactly 'cycles' periods of the base, close enough to hide the seam
+    return out, (attack, attack + loop)
+
+
+def read_wav(path):
+    with wave.open(path) as w:
+        assert w.getnchannels() == 1 and w.getsampwidth() == 2, "mono 16-bit WAV only"
+        frames = w.readframes(w.getnframes())
+        rate = w.getframerate()
+    values = struct.unpack("<%dh" % (len(frames) // 2), frames)
+    return [v / 32768.0 for v in values], rate
+
+
+def quantise(values, bits):
+    peak = max(max(abs(v) for v in values), 1e-9)
+    full = 127 if bits == 8 else 2047
+    return [int(round(v * full / peak)) for v in values]
+
+
+def samples():
+    rng = random.Random(44)
+    tone, tone_loop = keys()
+    return [
+        ("kick", kick(), RATE, 8, 36, (36, 36), None),
+        ("snare", snare(rng), RATE, 8, 38, (38, 38), None),
+        ("hat", hat(rng), RATE, 8, 42, (42, 42), None),
+        ("keys", tone, RATE, 12, 60, (48, 108), tone_loop),
+        # ("piano", *read_wav("piano_c4.wav"), 12, 60, (21, 108), None),
+    ]
+
+
+def main():
+    bank = samples()
+
+    print("/*************************************************************************************************")
+    print("                                         --SAMPLES--")
+    print("")
+    print("\tGenerated by tools/gen_samples.py, do not edit by hand.")
+    print("")
+    print("*************************************************************************************************/")
+    print("")
+    print("/******* HEADER INCLUDES ********/")
+    print('#include "samples.h"')
+    print("")
+    print("")
+    print("/*******   GLOBAL VARS  *********/")
+    for name, values, rate, bits, root, keys_range, loop in bank:
+        data = quantise(values, bits)
+        print("static const %s pcm_%s[%d] = {" % ("int8_t" if bits == 8 else "int16_t", name, len(data)))
+        for row in range(0, len(data), 16):
+            print("\t" + ", ".join("%d" % v for v in data[row:row + 16]) + ",")
+        print("};")
+        print("")
+    print("const struct pcm_sample pcm_samples[] = {")
+    for name, values, rate, bits, root, keys_range, loop in bank:
+        start, end = loop if loop else (0, 0)
+        print("\t{ pcm_%s, %d, %d, %d, %d, %d, %d, %d, %d }," % (name, bits, root, keys_range[0], keys_range[1],
+                                                             rate, len(values), start, end))
+    print("};")
+    print("")
+    print("const int pcm_sample_count = sizeof(pcm_samples) / sizeof(pcm_samples[0]);")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Generates src/shaper_curves.c, the waveshaper transfer tables.
+
+Each curve maps the signed 12-bit mix, -2048..2048 in SHAPER_TABLE_SIZE steps, to the
+same range; the extra last entry is the interpolation end point. Curves are normalised to
+hit full scale at the input limit:
+    soft  tanh saturation, odd harmonics that grow smoothly with level
+    asym  tanh with a bias, even harmonics as well, like a single-ended stage
+    fold  sine wavefolder, the output turns back over DRIVE_FOLD times
+
+Usage: python3 tools/gen_shaper_curves.py > src/shaper_curves.c
+"""
+
+import math
+
+SIZE = 256
+FULL = 2047
+DRIVE_SOFT = 2.5
+DRIVE_ASYM = 2.0
+BIAS_ASYM = 0.3
+DRIVE_FOLD = 2.5
+
+
+def soft(x):
+    return math.tanh(DRIVE_SOFT * x) / math.tanh(DRIVE_SOFT)
+
+
+def asym(x):
+    # the bias is taken back out so silence stays at zero
+    y = math.tanh(DRIVE_ASYM * x + BIAS_ASYM) - math.tanh(BIAS_ASYM)
+    return y / (math.tanh(DRIVE_ASYM + BIAS_ASYM) - math.tanh(BIAS_ASYM))
+
+
+def fold(x):
+    return math.sin(0.5 * math.pi * DRIVE_FOLD * x)
+
+
+CURVES = [("SOFT", soft), ("ASYM", asym), ("FOLD", fold)]
+
+
+def main():
+    print("/*************************************************************************************************")
+    print("                                    --SHAPER CURVES--")
+    print("")
+    print("\tGenerated by tools/gen_shaper_curves.py, do not edit by hand.")
+    print("")
+    print("*************************************************************************************************/")
+    print("")
+    print("/******* HEADER INCLUDES ********/")
+    print('#include "shaper.h"')
+    print("")
+    print("")
+    print("/*******   GLOBAL VARS  *********/")
+    print("const int16_t shaper_curves[SHAPER_CURVE_COUNT - 1][SHAPER_TABLE_SIZE + 1] = {")
+    for name, fn in CURVES:
+        print("\t//%s" % name)
+        print("\t{")
+        values = [max(-FULL, min(FULL, int(round(FULL * fn(2.0 * i / SIZE - 1.0))))) for i in range(SIZE + 1)]
+        for row in range(0, SIZE + 1, 16):
+            print("\t\t" + ", ".join("%d" % x for x in values[row:row + 16]) + ",")
+        print("\t},")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Generates src/velocity_curves.c, the note-on velocity to voice amplitude tables.
+
+Amplitudes are Q12 (4096 = full level at velocity 127):
+    linear       (v + 1) / 128, the original velocity + 1 scaling
+    exponential  RANGE_DB of dynamic range spread evenly in dB over 1..127
+
+Usage: python3 tools/gen_velocity_curves.py > src/velocity_curves.c
+"""
+
+FULL = 4096
+RANGE_DB = 40.0
+
+
+def linear(v):
+    return (v + 1) * FULL // 128
+
+
+def exponential(v):
+    if v == 0:
+        return 0
+    return int(round(FULL * 10.0 ** (-RANGE_DB * (127 - v) / (127.0 * 20.0))))
+
+
+CURVES = [("LINEAR", linear), ("EXPONENTIAL", exponential)]
+
+
+def main():
+    print("/*************************************************************************************************")
+    print("                                     --VELOCITY CURVES--")
+    print("")
+    print("\tGenerated by tools/gen_velocity_curves.py, do not edit by hand.")
+    print("")
+    print("*************************************************************************************************/")
+    print("")
+    print("/******* HEADER INCLUDES ********/")
+    print('#include "velocity_curves.h"')
+    print("")
+    print("")
+    print("/*******   GLOBAL VARS  *********/")
+    print("const uint16_t velocity_curves[VELOCITY_CURVE_COUNT][VELOCITY_CURVE_SIZE] = {")
+    for name, fn in CURVES:
+        print("\t//%s" % name)
+        print("\t{")
+        values = [fn(v) for v in range(128)]
+        for row in range(0, 128, 16):
+            print("\t\t" + ", ".join("%d" % x for x in values[row:row + 16]) + ",")
+        print("\t},")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
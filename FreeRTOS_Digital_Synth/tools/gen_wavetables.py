@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Generates src/wavetables.c, the band-limited oscillator tables.
+
+Level l is played for phase increments whose top set bit is 23 + l, so its
+highest harmonic stays below Nyquist at any sample rate:
+    level 0 -> 127 harmonics, level l >= 1 -> 2^(7 - l) harmonics.
+
+The quarter-wave sine for the sine and FM oscillators and the LFOs follows,
+outside the SYNTH_WAVETABLES gate since they need it either way.
+
+Usage: python3 tools/gen_wavetables.py > src/wavetables.c
+"""
+
+import math
+
+TABLE_SIZE = 256
+LEVELS = 8
+PEAK = 2047
+SINE_QUARTER = 256
+
+
+def harmonics(level):
+    return 127 if level == 0 else 2 ** (7 - level)
+
+
+def square(k):
+    return 1.0 / k if k % 2 else 0.0
+
+
+def saw(k):
+    return 1.0 / k
+
+
+def tri(k):
+    if k % 2 == 0:
+        return 0.0
+    return (1.0 if (k // 2) % 2 == 0 else -1.0) / (k * k)
+
+
+def sigma(k, n):
+    # Lanczos sigma factor, tames the Gibbs ringing of the truncated series
+    x = math.pi * k / (n + 1)
+    return math.sin(x) / x
+
+
+def table(coef, phase_fn, level):
+    n = harmonics(level)
+    raw = []
+    for i in range(TABLE_SIZE):
+        x = 2.0 * math.pi * i / TABLE_SIZE
+        raw.append(sum(coef(k) * sigma(k, n) * phase_fn(k * x) for k in range(1, n + 1)))
+    peak = max(abs(v) for v in raw)
+    return [int(round(v * PEAK / peak)) for v in raw]
+
+
+# phases match the naive shapes: square high then low, saw rising, tri rising from 0
+WAVES = [
+    ("SQUARE", square, math.sin),
+    ("SAW", saw, lambda x: -math.sin(x)),
+    ("TRI", tri, math.sin),
+]
+
+
+def main():
+    print("/*************************************************************************************************")
+    print("                                       --WAVETABLES--")
+    print("")
+    print("\tGenerated by tools/gen_wavetables.py, do not edit by hand.")
+    print("")
+    print("*************************************************************************************************/")
+    print("")
+    print("/******* HEADER INCLUDES ********/")
+    print('#include "wavetables.h"')
+    print("")
+    print("#if SYNTH_WAVETABLES")
+    print("")
+    print("/*******   GLOBAL VARS  *********/")
+    print("const int16_t wavetables[WAVETABLE_WAVES][WAVETABLE_LEVELS][WAVETABLE_SIZE] = {")
+    for name, coef, fn in WAVES:
+        print("\t//%s" % name)
+        print("\t{")
+        for level in range(LEVELS):
+            values = table(coef, fn, level)
+            print("\t\t//level %d, %d harmonics" % (level, harmonics(level)))
+            print("\t\t{")
+            for row in range(0, TABLE_SIZE, 16):
+                print("\t\t\t" + ", ".join("%d" % v for v in values[row:row + 16]) + ",")
+            print("\t\t},")
+        print("\t},")
+    print("};")
+    print("")
+    print("#endif /* SYNTH_WAVETABLES */")
+    print("")
+    print("//first quarter of a sine cycle, both ends included")
+    print("const int16_t sine_quarter[SINE_QUARTER_SIZE + 1] = {")
+    values = [int(round(PEAK * math.sin(0.5 * math.pi * i / SINE_QUARTER))) for i in range(SINE_QUARTER + 1)]
+    for row in range(0, SINE_QUARTER + 1, 16):
+        print("\t" + ", ".join("%d" % v for v in values[row:row + 16]) + ",")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
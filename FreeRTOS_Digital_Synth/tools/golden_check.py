@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Golden-output regression check for the synth engine.
+
+Builds tools/host_render.c with the host compiler, renders every scenario in
+tools/golden/ and compares the DAC codes against tools/golden/expected.txt,
+one "scenario rate sha256" line each. A hash mismatch means the output is no
+longer bit-exact.
+
+Changes that are allowed to move the output a little (fixed-point rework,
+coefficient rounding) are checked against PCM saved from the commit before
+them instead, within a tolerance in DAC codes:
+    python3 tools/golden_check.py --save /tmp/ref      (on the old commit)
+    python3 tools/golden_check.py --ref /tmp/ref --tolerance 2
+
+Usage: python3 tools/golden_check.py [--update] [--save DIR] [--ref DIR [--tolerance N]]
+Run from FreeRTOS_Digital_Synth/; CC and CFLAGS are taken from the environment.
+"""
+
+import argparse
+import array
+import hashlib
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+GOLDEN = os.path.join(ROOT, "tools", "golden")
+EXPECTED = os.path.join(GOLDEN, "expected.txt")
+
+ENGINE_SOURCES = ["synth_engine.c", "voice_alloc.c", "note_table.c", "midi_parser.c", "wavetables.c", "svf.c",
+                  "velocity_curves.c", "modulation.c", "samples.c", "stream.c", "delay.c",
+                  "shaper.c", "shaper_curves.c", "limiter.c", "midi_clock.c", "arpeggiator.c",
+                  "pattern.c", "patterns.c", "pluck.c", "curves.c", "block_pool.c",
+                  "dac_codes.c", "recip.c", "audio_stats.c", "synth_core.c", "drum.c", "formant.c", "reverb.c",
+                  "grain.c", "grain_windows.c", "automation.c", "profile.c"]
+
+# release rendered after the last event of a scenario, in ms
+TAIL_MS = 300
+
+
+def build(out_dir):
+    exe = os.path.join(out_dir, "host_render")
+    cc = os.environ.get("CC", "gcc")
+    cflags = shlex.split(os.environ.get("CFLAGS", "-O2"))
+    cmd = [cc] + cflags + ["-Wall", "-I" + os.path.join(ROOT, "src"), "-I" + os.path.join(ROOT, "src", "config"),
+                           "-o", exe, os.path.join(ROOT, "tools", "host_render.c")]
+    cmd += [os.path.join(ROOT, "src", f) for f in ENGINE_SOURCES]
+    subprocess.run(cmd + ["-lm"], check=True)
+    return exe
+
+
+def render(exe, out_dir, name, rate):
+    raw = os.path.join(out_dir, "%s_%d.raw" % (name, rate))
+    subprocess.run([exe, "-r", str(rate), "-t", str(TAIL_MS), "-o", raw, os.path.join(GOLDEN, name + ".txt")],
+                   check=True, stdout=subprocess.DEVNULL)
+    with open(raw, "rb") as f:
+        return f.read()
+
+
+def read_expected():
+    entries = []
+    with open(EXPECTED) as f:
+        for line in f:
+            line = line.split("#")[0].split()
+            if line:
+                entries.append((line[0], int(line[1]), line[2] if len(line) > 2 else None))
+    return entries
+
+
+def codes(data):
+    values = array.array("H")
+    values.frombytes(data)
+    if sys.byteorder != "little":
+        values.byteswap()
+    return values
+
+
+def compare(name, rate, data, ref_path, tolerance):
+    # largest per-sample difference against the saved PCM, in DAC codes
+    with open(ref_path, "rb") as f:
+        ref = f.read()
+    if len(ref) != len(data):
+        print("FAIL %s @ %d Hz: %d samples, reference has %d" % (name, rate, len(data) // 2, len(ref) // 2))
+        return False
+    worst = max((abs(a - b) for a, b in zip(codes(data), codes(ref))), default=0)
+    ok = worst <= tolerance
+    print("%s %s @ %d Hz: max difference %d codes" % ("ok  " if ok else "FAIL", name, rate, worst))
+    return ok
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--update", action="store_true", help="rewrite expected.txt from the current output")
+    parser.add_argument("--save", metavar="DIR", help="save the rendered PCM as a reference")
+    parser.add_argument("--ref", metavar="DIR", help="compare against saved PCM instead of the hashes")
+    parser.add_argument("--tolerance", type=int, default=0, help="allowed difference in DAC codes with --ref")
+    args = parser.parse_args()
+
+    entries = read_expected()
+    failed = 0
+
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = build(tmp)
+        lines = []
+        for name, rate, digest in entries:
+            data = render(exe, tmp, name, rate)
+            actual = hashlib.sha256(data).hexdigest()
+            lines.append("%s\t%d\t%s\n" % (name, rate, actual))
+
+            if args.save:
+                os.makedirs(args.save, exist_ok=True)
+                with open(os.path.join(args.save, "%s_%d.raw" % (name, rate)), "wb") as f:
+                    f.write(data)
+
+            if args.update or args.save:
+                continue
+            if args.ref:
+                ok = compare(name, rate, data, os.path.join(args.ref, "%s_%d.raw" % (name, rate)), args.tolerance)
+            else:
+                ok = actual == digest
+                print("%s %s @ %d Hz" % ("ok  " if ok else "FAIL", name, rate))
+            failed += 0 if ok else 1
+
+    if args.update:
+        with open(EXPECTED, "w") as f:
+            f.write("# scenario\trate\tsha256 of the DAC codes, regenerate with tools/golden_check.py --update\n")
+            f.writelines(lines)
+        print("updated %s" % os.path.relpath(EXPECTED, ROOT))
+    elif not args.save:
+        print("%d of %d scenarios match" % (len(entries) - failed, len(entries)))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
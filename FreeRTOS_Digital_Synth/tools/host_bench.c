@@ -0,0 +1,164 @@
+/*************************************************************************************************
+                                        --HOST BENCHMARK--
+
+	The figures of src/bench.c on the desktop: the mixer on its own, then every waveform
+	with all SYNTH_MAX_VOICES sounding, less the mixer. The core runs them through the same
+	synth_core_block() as the firmware, with a host HAL whose cycle count is the monotonic
+	clock in nanoseconds, so audio_stats and the governor see the blocks as the board would,
+	with a budget of the block period in ns. Useful for comparing two versions of a kernel
+	before flashing either; the host's figures say nothing about the M0+'s.
+
+	Build from FreeRTOS_Digital_Synth/:
+		gcc -O2 -Wall -Isrc -Isrc/config -o host_bench tools/host_bench.c src/synth_engine.c \
+			src/voice_alloc.c src/note_table.c src/midi_parser.c src/wavetables.c src/svf.c \
+			src/velocity_curves.c src/modulation.c src/samples.c src/stream.c src/delay.c \
+			src/shaper.c src/shaper_curves.c src/limiter.c src/midi_clock.c src/arpeggiator.c \
+			src/pattern.c src/patterns.c src/pluck.c src/curves.c src/block_pool.c \
+			src/dac_codes.c src/recip.c src/audio_stats.c src/synth_core.c \
+			src/drum.c src/formant.c src/reverb.c src/grain.c src/grain_windows.c src/automation.c \
+			src/profile.c
+
+	Usage: host_bench [-r rate] [-b blocks]
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "synth_engine.h"
+#include "synth_core.h"
+#include "audio_stats.h"
+
+
+/**********  DEFINE  ************/
+#define NS_PER_SECOND		(	1000000000u	)
+
+//blocks rendered per measurement, more than the firmware's for the host's timer
+#define DEFAULT_BLOCKS		(	4096	)
+
+//sustain at full level, so the voices never go quiet and skip their loop
+#define BENCH_NOTE			(	60	)
+#define BENCH_VELOCITY		(	127	)
+
+//DRUM voices only play the kit: kick, snare, crash and ride, then the toms; the hits die
+//away within the default figure, which then averages them over their decay and the silence
+#define BENCH_DRUMS			(	8	)
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static uint32_t host_cycles( void );
+
+
+/*******   GLOBAL VARS  *********/
+static const struct synth_hal host_hal = { "host", host_cycles, NULL, NULL, NULL };
+
+static uint16_t bench_frame[SYNTH_FRAME_WORDS];
+
+static const char *const wave_names[WAVE_TYPE_COUNT] = { "square", "saw", "tri", "square blep", "saw blep", "fm", "sine", "noise", "sample", "stream", "pluck", "organ", "sync", "ring", "supersaw", "morph", "drum", "grain" };
+static const uint8_t bench_drums[BENCH_DRUMS] = { 36, 38, 49, 51, 41, 45, 48, 50 };
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static uint32_t host_cycles( void )
+{
+	//nanoseconds, wrapping every four seconds or so; a block's difference is still right
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint32_t) ((uint64_t) now.tv_sec * NS_PER_SECOND + (uint64_t) now.tv_nsec);
+}
+
+static void bench_setup( int voices, enum wave_type wave )
+{
+	int j;
+
+	synth_init();
+	synth_set_envelope(0, 0, 100, 0);
+	synth_set_filter(SVF_OFF, SYNTH_FILTER_CUTOFF_HZ, SYNTH_FILTER_RESONANCE);
+	synth_program_change(0, (uint8_t) wave);
+
+	for(j=0; j<voices; j++) synth_note_on(0, (wave == DRUM) ? bench_drums[j % BENCH_DRUMS] : (uint8_t) (BENCH_NOTE + 4 * j), BENCH_VELOCITY);
+
+	//one block to get through the attack, then the figures start over
+	synth_core_block(bench_frame, NULL);
+	audio_stats_init(NS_PER_SECOND, synth_sample_rate());
+}
+
+static double bench_blocks( uint32_t blocks, struct audio_stats *stats )
+{
+	//ns for 'blocks' blocks, each timed by the core
+	uint64_t total = 0;
+	uint32_t n;
+
+	for(n=0; n<blocks; n++)
+	{
+		synth_core_block(bench_frame, NULL);
+		audio_stats_get(stats);
+		total += stats->last_cycles;
+	}
+
+	return (double) total;
+}
+
+static void bench_print( const char *name, double ns, uint32_t blocks, const struct audio_stats *stats, int voices )
+{
+	//the load is the whole block's, mixer included
+	double samples = (double) blocks * SYNTH_BLOCK_SIZE;
+
+	printf("%-12s %8.2f ns/sample", name, ns / samples);
+	if(voices > 1) printf("  %8.2f ns/sample/voice", ns / samples / voices);
+	else printf("  %24s", "");
+	printf("  load avg %4u peak %4u per mille\n", (unsigned) audio_stats_load(stats->avg_cycles),
+		(unsigned) audio_stats_load(stats->peak_cycles));
+}
+
+int main( int argc, char **argv )
+{
+	struct audio_stats stats;
+	uint32_t sample_rate = SYNTH_SAMPLE_RATE;
+	uint32_t blocks = DEFAULT_BLOCKS;
+	double baseline;
+	double ns;
+	int wave;
+	int i;
+
+	for(i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-r") && (i + 1 < argc)) sample_rate = (uint32_t) strtoul(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-b") && (i + 1 < argc)) blocks = (uint32_t) strtoul(argv[++i], NULL, 10);
+		else
+		{
+			fprintf(stderr, "usage: %s [-r rate] [-b blocks]\n", argv[0]);
+			return 2;
+		}
+	}
+	if(blocks == 0) blocks = 1;
+
+	synth_set_sample_rate(sample_rate);
+	synth_init();
+	synth_core_init(&host_hal);
+	sample_rate = synth_sample_rate();
+
+	printf("bench: %s core, %lu Hz audio (%.1f ns/sample budget)\n", synth_core_hal()->name,
+		(unsigned long) sample_rate, (double) NS_PER_SECOND / sample_rate);
+	printf("bench: %lu blocks per figure, %d voices, block %d, control period %d\n",
+		(unsigned long) blocks, SYNTH_MAX_VOICES, SYNTH_BLOCK_SIZE, SYNTH_CONTROL_PERIOD);
+
+	bench_setup(0, SQUARE);
+	baseline = bench_blocks(blocks, &stats);
+	bench_print("mixer", baseline, blocks, &stats, 1);
+
+	for(wave=SQUARE; wave<WAVE_TYPE_COUNT; wave++)
+	{
+		bench_setup(SYNTH_MAX_VOICES, (enum wave_type) wave);
+		ns = bench_blocks(blocks, &stats);
+		bench_print(wave_names[wave], (ns > baseline) ? ns - baseline : 0, blocks, &stats, SYNTH_MAX_VOICES);
+	}
+
+	printf("bench: done\n");
+
+	return 0;
+}
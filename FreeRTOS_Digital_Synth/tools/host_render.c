@@ -0,0 +1,436 @@
+/*************************************************************************************************
+                                        --HOST RENDERER--
+
+	Offline renderer for the desktop, built from the same engine sources as the firmware.
+	Reads a MIDI event list, renders it as fast as the host allows and writes the DAC codes
+	as a 16-bit WAV (or raw 12-bit codes), then reports the render speed. Engine options
+	(voices, block size, wavetables) are the conf_synth.h ones and can be set with -D.
+
+	Build from FreeRTOS_Digital_Synth/:
+		gcc -O2 -Wall -Isrc -Isrc/config -o host_render tools/host_render.c src/synth_engine.c \
+			src/voice_alloc.c src/note_table.c src/midi_parser.c src/wavetables.c src/svf.c \
+			src/velocity_curves.c src/modulation.c src/samples.c src/stream.c src/delay.c \
+			src/shaper.c src/shaper_curves.c src/limiter.c src/midi_clock.c src/arpeggiator.c \
+			src/pattern.c src/patterns.c src/pluck.c src/curves.c src/block_pool.c \
+			src/dac_codes.c src/recip.c src/audio_stats.c src/synth_core.c \
+			src/drum.c src/formant.c src/reverb.c src/grain.c src/grain_windows.c src/automation.c \
+			src/profile.c
+
+	Usage: host_render [-r rate] [-t tail_ms] [-p stacks.txt] [-o out.wav | -o out.raw | -n] events.txt
+
+	The profiling build adds -DSYNTH_PROFILE=1 to the line above; the renders are the same.
+	It prints each render stage's calls and cycles a block, see src/profile.h, timed by the
+	processor's time stamp counter where there is one and by the clock in nanoseconds
+	elsewhere. The figures are the host's and only rank the stages, the board's are
+	src/bench.c's. -p writes the stages' own cycles as folded stacks, one path a line,
+	for flamegraph.pl or speedscope:
+		block;voices;saw;mix 1234567
+
+	The event list has one MIDI message per line, a time in milliseconds followed by the
+	message bytes in hex; running status is allowed and '#' starts a comment:
+		0		90 3C 64	#C4 on
+		500		80 3C 00
+		500		C0 01		#saw
+
+*************************************************************************************************/
+
+/******* HEADER INCLUDES ********/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "synth_engine.h"
+#include "synth_core.h"
+#include "profile.h"
+#if SYNTH_PROFILE && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+
+/**********  DEFINE  ************/
+#define EVENT_LINE_LEN		(	256	)
+#define EVENT_LIST_GROW		(	256	)
+
+//release time rendered after the last event
+#define DEFAULT_TAIL_MS		(	1000	)
+
+
+/********   TYPE DEFS  **********/
+struct timed_event{
+	uint32_t time;
+	struct midi_event event;
+};
+
+struct event_list{
+	struct timed_event *events;
+	size_t count;
+	size_t size;
+};
+
+
+/****** FUNCTION PROTOTYPES  ****/
+static int read_events( const char *path, uint32_t sample_rate, struct event_list *list );
+static void write_wav_header( FILE *out, uint32_t sample_rate, uint32_t samples );
+static double seconds_now( void );
+#if SYNTH_PROFILE
+static uint32_t profile_cycles( void );
+static int profile_report( const char *stacks_path, uint32_t blocks );
+#endif
+
+
+/*******   GLOBAL VARS  *********/
+//untimed and without input or output, so a render is the same on every run
+static const struct synth_hal host_hal = { "host", NULL, NULL, NULL, NULL };
+
+
+/***  APPLICATION FUNCTIONS  ****/
+static int add_event( struct event_list *list, uint32_t time, const struct midi_event *event )
+{
+	struct timed_event *grown;
+
+	if(list->count == list->size)
+	{
+		grown = realloc(list->events, (list->size + EVENT_LIST_GROW) * sizeof(*grown));
+		if(grown == NULL) return -1;
+
+		list->events = grown;
+		list->size += EVENT_LIST_GROW;
+	}
+
+	list->events[list->count].time = time;
+	list->events[list->count].event = *event;
+	list->count++;
+
+	return 0;
+}
+
+static int read_events( const char *path, uint32_t sample_rate, struct event_list *list )
+{
+	//parses the text event list through the firmware MIDI parser, times become samples
+	FILE *in = fopen(path, "r");
+	char line[EVENT_LINE_LEN];
+	char *p;
+	char *end;
+	double ms;
+	unsigned long byte;
+	uint32_t time;
+	uint32_t last_time = 0;
+	int line_no = 0;
+	struct midi_parser parser;
+	struct midi_event event;
+
+	if(in == NULL)
+	{
+		perror(path);
+		return -1;
+	}
+
+	midi_parser_init(&parser);
+
+	while(fgets(line, sizeof(line), in) != NULL)
+	{
+		line_no++;
+
+		p = strchr(line, '#');
+		if(p != NULL) *p = '\0';
+
+		ms = strtod(line, &end);
+		if(end == line) continue;
+
+		time = (uint32_t) ((ms * sample_rate) / 1000.0 + 0.5);
+		if(time < last_time)
+		{
+			fprintf(stderr, "%s:%d: events must be in time order\n", path, line_no);
+			fclose(in);
+			return -1;
+		}
+		last_time = time;
+
+		for(p=end; ; p=end)
+		{
+			byte = strtoul(p, &end, 16);
+			if(end == p) break;
+
+			if(byte > 0xFF)
+			{
+				fprintf(stderr, "%s:%d: bad MIDI byte\n", path, line_no);
+				fclose(in);
+				return -1;
+			}
+
+			if(midi_parser_feed(&parser, (uint8_t) byte, &event) && (add_event(list, time, &event) != 0))
+			{
+				fclose(in);
+				return -1;
+			}
+		}
+	}
+
+	fclose(in);
+
+	return 0;
+}
+
+static void put_u32( FILE *out, uint32_t value )
+{
+	fputc(value & 0xFF, out);
+	fputc((value >> 8) & 0xFF, out);
+	fputc((value >> 16) & 0xFF, out);
+	fputc((value >> 24) & 0xFF, out);
+}
+
+static void put_u16( FILE *out, uint16_t value )
+{
+	fputc(value & 0xFF, out);
+	fputc((value >> 8) & 0xFF, out);
+}
+
+static void write_wav_header( FILE *out, uint32_t sample_rate, uint32_t samples )
+{
+	//16-bit PCM, stereo when the engine is built with SYNTH_STEREO
+	uint32_t frame_bytes = 2 * SYNTH_OUTPUT_CHANNELS;
+
+	fwrite("RIFF", 1, 4, out);
+	put_u32(out, 36 + samples * frame_bytes);
+	fwrite("WAVEfmt ", 1, 8, out);
+	put_u32(out, 16);
+	put_u16(out, 1);
+	put_u16(out, SYNTH_OUTPUT_CHANNELS);
+	put_u32(out, sample_rate);
+	put_u32(out, sample_rate * frame_bytes);
+	put_u16(out, (uint16_t) frame_bytes);
+	put_u16(out, 16);
+	fwrite("data", 1, 4, out);
+	put_u32(out, samples * frame_bytes);
+}
+
+static double seconds_now( void )
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+#if SYNTH_PROFILE
+static uint32_t profile_cycles( void )
+{
+	//the time stamp counter runs at about the nominal clock; the differences are what count
+#if defined(__x86_64__) || defined(__i386__)
+	return (uint32_t) __rdtsc();
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint32_t) ((uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec);
+#endif
+}
+
+static void profile_path( FILE *out, const struct profile_node *nodes, int n )
+{
+	//the stage names from the block down, ';' between them
+	if(nodes[n].parent != 0)
+	{
+		profile_path(out, nodes, nodes[n].parent);
+		fputc(';', out);
+	}
+	fputs(profile_stage_name((enum profile_stage) nodes[n].stage), out);
+}
+
+static int profile_depth( const struct profile_node *nodes, int n )
+{
+	int depth = 0;
+
+	for(; nodes[n].parent != 0; n=nodes[n].parent) depth++;
+
+	return depth;
+}
+
+static void profile_table( const struct profile_node *nodes, int count, int n, uint64_t block_cycles, uint32_t blocks )
+{
+	//the node and then its children, in the order they were first entered
+	int depth = profile_depth(nodes, n);
+	int c;
+
+	printf("%*s%-*s %10.1f %12.1f %12.1f %6.1f%%\n", 2 * depth, "", 20 - 2 * depth, profile_stage_name((enum profile_stage) nodes[n].stage),
+		(double) nodes[n].calls / blocks, (double) nodes[n].cycles / blocks, (double) (nodes[n].cycles - nodes[n].inner) / blocks,
+		block_cycles ? (100.0 * nodes[n].cycles) / block_cycles : 0.0);
+
+	for(c=n + 1; c<count; c++)
+	{
+		if(nodes[c].parent == n) profile_table(nodes, count, c, block_cycles, blocks);
+	}
+}
+
+static int profile_report( const char *stacks_path, uint32_t blocks )
+{
+	const struct profile_node *nodes;
+	FILE *out;
+	int count;
+	int n;
+
+	nodes = profile_nodes(&count);
+	if((count < 2) || (blocks == 0)) return 0;
+
+	printf("%-20s %10s %12s %12s %7s\n", "stage", "calls", "cycles", "own cycles", "share");
+	printf("%-20s %10s %12s %12s %7s\n", "", "a block", "a block", "a block", "");
+	profile_table(nodes, count, 1, nodes[1].cycles, blocks);
+
+	if(stacks_path == NULL) return 0;
+
+	out = fopen(stacks_path, "w");
+	if(out == NULL)
+	{
+		perror(stacks_path);
+		return -1;
+	}
+
+	for(n=1; n<count; n++)
+	{
+		if(nodes[n].cycles == nodes[n].inner) continue;
+		profile_path(out, nodes, n);
+		fprintf(out, " %llu\n", (unsigned long long) (nodes[n].cycles - nodes[n].inner));
+	}
+	fclose(out);
+
+	return 0;
+}
+#endif
+
+static int active_voices( void )
+{
+	int j;
+	int count = 0;
+
+	for(j=0; j<SYNTH_MAX_VOICES; j++)
+	{
+		if(voice_bank.enable[j]) count++;
+	}
+
+	return count;
+}
+
+int main( int argc, char **argv )
+{
+	struct event_list list = { NULL, 0, 0 };
+	const char *in_path = NULL;
+	const char *out_path = NULL;
+#if SYNTH_PROFILE
+	const char *stacks_path = NULL;
+#endif
+	bool raw = false;
+	bool discard = false;
+	uint32_t sample_rate = SYNTH_SAMPLE_RATE;
+	uint32_t tail_ms = DEFAULT_TAIL_MS;
+	uint32_t end_time;
+	uint32_t blocks;
+	uint32_t block;
+	uint64_t voice_blocks = 0;
+	size_t next = 0;
+	uint16_t frame[SYNTH_FRAME_WORDS];
+	int16_t pcm[SYNTH_FRAME_WORDS];
+	FILE *out = NULL;
+	double start;
+	double elapsed;
+	double samples;
+	int i;
+
+	for(i=1; i<argc; i++)
+	{
+		if(!strcmp(argv[i], "-r") && (i + 1 < argc)) sample_rate = (uint32_t) strtoul(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-t") && (i + 1 < argc)) tail_ms = (uint32_t) strtoul(argv[++i], NULL, 10);
+		else if(!strcmp(argv[i], "-o") && (i + 1 < argc)) out_path = argv[++i];
+		else if(!strcmp(argv[i], "-n")) discard = true;
+#if SYNTH_PROFILE
+		else if(!strcmp(argv[i], "-p") && (i + 1 < argc)) stacks_path = argv[++i];
+#endif
+		else if(argv[i][0] != '-') in_path = argv[i];
+		else
+		{
+			in_path = NULL;
+			break;
+		}
+	}
+
+	if((in_path == NULL) || ((out_path == NULL) && !discard))
+	{
+		fprintf(stderr, "usage: %s [-r rate] [-t tail_ms]%s [-o out.wav | -o out.raw | -n] events.txt\n", argv[0],
+			SYNTH_PROFILE ? " [-p stacks.txt]" : "");
+		return 2;
+	}
+
+	synth_set_sample_rate(sample_rate);
+	synth_init();
+	synth_core_init(&host_hal);
+	sample_rate = synth_sample_rate();
+
+	if(read_events(in_path, sample_rate, &list) != 0) return 1;
+
+	end_time = ((list.count > 0) ? list.events[list.count - 1].time : 0) + (tail_ms * sample_rate) / 1000;
+	blocks = (end_time + SYNTH_BLOCK_SIZE - 1) / SYNTH_BLOCK_SIZE;
+
+	if(!discard)
+	{
+		out = fopen(out_path, "wb");
+		if(out == NULL)
+		{
+			perror(out_path);
+			return 1;
+		}
+
+		raw = (strlen(out_path) > 4) && !strcmp(out_path + strlen(out_path) - 4, ".raw");
+		if(!raw) write_wav_header(out, sample_rate, blocks * SYNTH_BLOCK_SIZE);
+	}
+
+#if SYNTH_PROFILE
+	profile_set_timer(profile_cycles);
+	profile_reset();
+#endif
+	start = seconds_now();
+
+	for(block=0; block<blocks; block++)
+	{
+		//hands the engine every event due within this block, it splits at their samples;
+		//a full event queue just leaves the rest for the next block
+		while((next < list.count) && (list.events[next].time < synth_render_time() + SYNTH_BLOCK_SIZE))
+		{
+			if(!synth_post_event_at(&list.events[next].event, list.events[next].time)) break;
+			next++;
+		}
+
+		synth_core_block(frame, NULL);
+		voice_blocks += active_voices();
+
+		if(out == NULL) continue;
+
+		if(raw)
+		{
+			fwrite(frame, sizeof(frame[0]), SYNTH_FRAME_WORDS, out);
+		}
+		else
+		{
+			for(i=0; i<SYNTH_FRAME_WORDS; i++) pcm[i] = (int16_t) ((frame[i] - DAC_MIDSCALE) << 4);
+			for(i=0; i<SYNTH_FRAME_WORDS; i++) put_u16(out, (uint16_t) pcm[i]);
+		}
+	}
+
+	elapsed = seconds_now() - start;
+	if(out != NULL) fclose(out);
+
+	samples = (double) blocks * SYNTH_BLOCK_SIZE;
+	printf("%u events, %.0f samples at %u Hz, %d voices max, %.2f sounding on average\n", (unsigned) list.count,
+		samples, (unsigned) sample_rate, SYNTH_MAX_VOICES, blocks ? (double) voice_blocks / blocks : 0.0);
+	printf("rendered in %.3f s: %.0f samples/s, %.1f x real time, %.1f ns/sample\n", elapsed,
+		(elapsed > 0) ? samples / elapsed : 0.0, (elapsed > 0) ? (samples / sample_rate) / elapsed : 0.0,
+		(samples > 0) ? (elapsed * 1e9) / samples : 0.0);
+	if(synth_events_dropped()) printf("%u events dropped\n", (unsigned) synth_events_dropped());
+#if SYNTH_PROFILE
+	if(profile_report(stacks_path, blocks) != 0) return 1;
+#endif
+
+	free(list.events);
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Decoder for the kernel trace dump (src/kernel_trace.h).
+
+Build with SYNTH_KERNEL_TRACE set, capture the EDBG port while pressing 'k' on the
+console, and decode the capture; console text around the dump is skipped:
+    stty -F /dev/ttyACM0 115200 raw -echo
+    cat /dev/ttyACM0 > trace.bin        (press 'k', then stop cat)
+    python3 tools/kernel_trace.py trace.bin
+
+Prints one line per record, time in us from the first record, then the switches per
+task and the busiest switch window. --window sets that window in us (default 1000),
+--summary leaves out the record lines.
+
+Usage: python3 tools/kernel_trace.py [--summary] [--window US] CAPTURE
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"KTRC"
+VERSION = 1
+NAME_LEN = 8
+
+EVENTS = {1: "switch", 2: "send", 3: "send isr", 4: "receive", 5: "receive isr", 6: "block",
+          7: "notify", 8: "notify isr", 9: "take", 10: "take block"}
+SWITCH = 1
+# events whose object is a task, a notification's argument is the task's count
+NOTIFY = (7, 8, 9, 10)
+
+
+def parse(data):
+    """Returns (rate, lost, tasks, queues, records) of the last complete dump in data."""
+    start = data.rfind(MAGIC)
+    while start >= 0:
+        try:
+            return parse_at(data, start + len(MAGIC))
+        except ValueError as err:
+            print("kernel_trace: dump at byte %d skipped, %s" % (start, err), file=sys.stderr)
+        start = data.rfind(MAGIC, 0, start)
+    raise ValueError("no complete dump in the capture")
+
+
+def parse_at(data, pos):
+    head = data[pos:pos + 14]
+    if len(head) < 14:
+        raise ValueError("truncated header")
+    version, task_count, queue_count, record_size, rate, count, lost = struct.unpack("<BBBBIHI", head)
+    if version != VERSION or record_size != 8:
+        raise ValueError("unknown version %d or record size %d" % (version, record_size))
+
+    end = pos + 14 + (task_count + queue_count) * (1 + NAME_LEN) + count * record_size
+    if len(data) < end + 2:
+        raise ValueError("truncated, %d of %d bytes" % (len(data) - pos, end + 2 - pos))
+    (check,) = struct.unpack_from("<H", data, end)
+    if sum(data[pos:end]) & 0xFFFF != check:
+        raise ValueError("checksum mismatch")
+
+    pos += 14
+    names = []
+    for _ in range(task_count + queue_count):
+        number = data[pos]
+        name = data[pos + 1:pos + 1 + NAME_LEN].split(b"\0")[0].decode("ascii", "replace")
+        names.append((number, name))
+        pos += 1 + NAME_LEN
+    tasks = dict(names[:task_count])
+    queues = dict(names[task_count:])
+
+    records = [struct.unpack_from("<IBBH", data, pos + i * record_size) for i in range(count)]
+    return rate, lost, tasks, queues, records
+
+
+def busiest_window(times, window):
+    """Most switches inside any window of the given length, and where it starts."""
+    best = 0
+    best_start = 0
+    first = 0
+    for last, t in enumerate(times):
+        while t - times[first] >= window:
+            first += 1
+        if last - first + 1 > best:
+            best = last - first + 1
+            best_start = times[first]
+    return best, best_start
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a kernel trace dump from an EDBG capture.")
+    parser.add_argument("capture", help="captured bytes from the EDBG port")
+    parser.add_argument("--summary", action="store_true", help="totals only, no record lines")
+    parser.add_argument("--window", type=float, default=1000.0, help="switch rate window in us")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    try:
+        rate, lost, tasks, queues, records = parse(data)
+    except ValueError as err:
+        print("kernel_trace: %s" % err, file=sys.stderr)
+        return 1
+
+    if not records:
+        print("no records")
+        return 0
+
+    # the counter is 32 bits and wraps after ~95 minutes, unwrap it from the first record
+    base = records[0][0]
+    times = [((t - base) & 0xFFFFFFFF) * 1e6 / rate for t, _, _, _ in records]
+
+    if not args.summary:
+        previous = 0.0
+        for t, (_, event, obj, arg) in zip(times, records):
+            if event == SWITCH:
+                what = "%-11s %-8s prio %d" % (EVENTS[event], tasks.get(obj, "task %d" % obj), arg)
+            elif event in NOTIFY:
+                what = "%-11s %-8s count %d" % (EVENTS[event], tasks.get(obj, "task %d" % obj), arg)
+            else:
+                what = "%-11s %-8s waiting %d" % (EVENTS.get(event, "event %d" % event),
+                                                 queues.get(obj, "queue %d" % obj), arg)
+            print("%12.1f %+10.1f  %s" % (t, t - previous, what))
+            previous = t
+
+    span = times[-1]
+    switches = [(t, obj) for t, (_, event, obj, _) in zip(times, records) if event == SWITCH]
+    print("%d records over %.1f ms, %d overwritten before the dump, timer %d Hz"
+          % (len(records), span / 1000, lost, rate))
+    if switches:
+        print("%d switches, %.0f per second" % (len(switches), len(switches) * 1e6 / span if span else 0))
+        for number in sorted(set(obj for _, obj in switches)):
+            count = sum(1 for _, obj in switches if obj == number)
+            print("  %-8s %d" % (tasks.get(number, "task %d" % number), count))
+        best, best_start = busiest_window([t for t, _ in switches], args.window)
+        print("busiest %.0f us: %d switches from %.1f us" % (args.window, best, best_start))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
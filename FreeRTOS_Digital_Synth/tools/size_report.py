@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Flash and RAM use of a firmware image, and the change from another.
+
+Reads the text, data and bss totals that size prints for each ELF: flash is text and the
+initial values of data (.relocate, the SRAM code included), RAM is data and bss (the
+stack, the DMA descriptors and the audio buffers included). With a second ELF, the
+Debug build for release.mk, each figure is followed by the change from it.
+
+    python3 tools/size_report.py Release/FreeRTOS_Digital_Synth.elf Debug/FreeRTOS_Digital_Synth.elf
+
+--size names the tool, arm-none-eabi-size by default; llvm-size prints the same.
+
+Usage: python3 tools/size_report.py [--size TOOL] ELF [REFERENCE_ELF]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+# ATSAMD21J18A
+FLASH_BYTES = 256 * 1024
+RAM_BYTES = 32 * 1024
+
+
+def sizes(tool, elf):
+    """Returns (flash, ram) in bytes from size's Berkeley output."""
+    output = subprocess.run([tool, elf], stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    text, data, bss = (int(field) for field in output.splitlines()[1].split()[:3])
+    return text + data, data + bss
+
+
+def main():
+    parser = argparse.ArgumentParser(description="flash and RAM use, and the change from a reference build")
+    parser.add_argument("elf")
+    parser.add_argument("reference", nargs="?")
+    parser.add_argument("--size", default="arm-none-eabi-size", help="size tool to run")
+    args = parser.parse_args()
+
+    try:
+        flash, ram = sizes(args.size, args.elf)
+        reference = sizes(args.size, args.reference) if args.reference and os.path.exists(args.reference) else None
+    except (OSError, subprocess.CalledProcessError, IndexError, ValueError) as err:
+        print("size_report: %s" % err, file=sys.stderr)
+        return 2
+
+    for name, used, total, index in (("flash", flash, FLASH_BYTES, 0), ("RAM", ram, RAM_BYTES, 1)):
+        line = "%-6s %7d bytes  %5.1f%%" % (name, used, 100.0 * used / total)
+        if reference:
+            line += "  %+7d from %s" % (used - reference[index], args.reference)
+        print(line)
+    if args.reference and not reference:
+        print("size_report: no %s to compare with" % args.reference)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Live display of the binary telemetry stream (src/telemetry.h).
+
+Reads the EDBG port, or a capture of it, and prints one line per status frame, and one
+per levels frame when the firmware is built with SYNTH_METERS. Console
+text and damaged frames are skipped: a frame is only taken when its checksum matches.
+Press 'b' on the console to start the stream, or build with SYNTH_TELEMETRY_START 1:
+    stty -F /dev/ttyACM0 115200 raw -echo
+    python3 tools/telemetry.py /dev/ttyACM0
+
+--csv prints the status fields comma separated instead, for logging to a file.
+
+Usage: python3 tools/telemetry.py [--csv] PORT_OR_CAPTURE
+"""
+
+import argparse
+import math
+import os
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+TYPE_STATUS = 1
+TYPE_LEVELS = 2
+STATUS = struct.Struct("<IHHBBIII12BHHHHH")
+FILLS = ("output", "free", "midi", "events")
+
+# DAC units from midscale at full scale, and the Q15 voice gain sent as its top byte
+OUTPUT_FULL = 2048
+VOICE_FULL = 256
+
+FIELDS = (["tick_ms", "load_avg", "load_peak", "voices", "frames", "blocks", "underruns", "overruns"]
+          + ["%s_%s" % (f, k) for f in FILLS for k in ("now", "min", "max")]
+          + ["midi_dropped", "events_dropped", "midi_framing", "midi_overflow", "midi_parity"])
+
+
+def fletcher16(data):
+    a = 0
+    b = 0
+    for byte in data:
+        a = (a + byte) % 255
+        b = (b + a) % 255
+    return a, b
+
+
+def frames(read):
+    """Yields (type, payload) for every frame with a good checksum in the byte stream."""
+    buf = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            return
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                del buf[:-1]
+                break
+            if len(buf) < start + 4:
+                del buf[:start]
+                break
+            length = buf[start + 2]
+            end = start + 4 + length + 2
+            if len(buf) < end:
+                del buf[:start]
+                break
+            body = bytes(buf[start + 2:end - 2])
+            if fletcher16(body) == (buf[end - 2], buf[end - 1]):
+                yield body[1], body[2:]
+                del buf[:end]
+            else:
+                del buf[:start + 1]
+
+
+def show(values):
+    v = dict(zip(FIELDS, values))
+    fills = "  ".join("%s %d/%d..%d" % (f, v[f + "_now"], v[f + "_min"], v[f + "_max"]) for f in FILLS)
+    return ("%9.1f s  load %3d.%d%% peak %3d.%d%%  voices %2d  frames %d  blocks %d  under %d  over %d  %s"
+            "  midi drop %d  ev drop %d  rx err %d/%d/%d"
+            % (v["tick_ms"] / 1000.0, v["load_avg"] // 10, v["load_avg"] % 10, v["load_peak"] // 10,
+               v["load_peak"] % 10, v["voices"], v["frames"], v["blocks"], v["underruns"], v["overruns"],
+               fills, v["midi_dropped"], v["events_dropped"], v["midi_framing"], v["midi_overflow"], v["midi_parity"]))
+
+
+def levels(payload):
+    """(tick_ms, [(peak, rms)] per output channel, [(peak, rms)] per voice) of a levels frame."""
+    tick_ms, channels = struct.unpack_from("<IB", payload)
+    pos = 5
+    outputs = [struct.unpack_from("<HH", payload, pos + 4 * i) for i in range(channels)]
+    pos += 4 * channels
+    voices = payload[pos]
+    pos += 1
+    voice = [(payload[pos + 2 * i], payload[pos + 2 * i + 1]) for i in range(voices)]
+    return tick_ms, outputs, voice
+
+
+def dbfs(level, full):
+    return "%5.1f" % (20 * math.log10(level / full)) if level else " -inf"
+
+
+def show_levels(tick_ms, outputs, voices):
+    out = "  ".join("out%d peak %s rms %s dBFS" % (i, dbfs(p, OUTPUT_FULL), dbfs(r, OUTPUT_FULL))
+                    for i, (p, r) in enumerate(outputs))
+    voice = " ".join("%3d/%3d" % (p * 100 // VOICE_FULL, r * 100 // VOICE_FULL) for p, r in voices)
+    return "%9.1f s  %s  voices %% peak/rms %s" % (tick_ms / 1000.0, out, voice)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Display the synth's binary telemetry.")
+    parser.add_argument("source", help="serial device set up with stty raw, or a capture file")
+    parser.add_argument("--csv", action="store_true", help="comma separated fields, one frame per line")
+    args = parser.parse_args()
+
+    fd = os.open(args.source, os.O_RDONLY | getattr(os, "O_NOCTTY", 0))
+    if args.csv:
+        print(",".join(FIELDS))
+    try:
+        for frame_type, payload in frames(lambda: os.read(fd, 256)):
+            if frame_type == TYPE_LEVELS and not args.csv and len(payload) >= 6:
+                print(show_levels(*levels(payload)), flush=True)
+                continue
+            if frame_type != TYPE_STATUS or len(payload) != STATUS.size:
+                continue
+            values = STATUS.unpack(payload)
+            print(",".join(str(x) for x in values) if args.csv else show(values), flush=True)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())